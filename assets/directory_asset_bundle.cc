@@ -4,24 +4,32 @@
 
 #include "flutter/assets/directory_asset_bundle.h"
 
-#include <fcntl.h>
-#include <unistd.h>
-
 #include <utility>
 
-#include "lib/ftl/files/eintr_wrapper.h"
-#include "lib/ftl/files/file.h"
 #include "lib/ftl/files/path.h"
-#include "lib/ftl/files/unique_fd.h"
+#include "lib/ftl/logging.h"
 
 namespace blink {
 
 bool DirectoryAssetBundle::GetAsBuffer(const std::string& asset_name,
                                        std::vector<uint8_t>* data) {
+  std::unique_ptr<fml::Mapping> mapping = GetAsMapping(asset_name);
+  if (!mapping)
+    return false;
+  const uint8_t* bytes = mapping->GetMapping();
+  data->assign(bytes, bytes + mapping->GetSize());
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
+    const std::string& asset_name) {
   std::string asset_path = GetPathForAsset(asset_name);
   if (asset_path.empty())
-    return false;
-  return files::ReadFileToVector(asset_path, data);
+    return nullptr;
+  auto mapping = std::make_unique<fml::FileMapping>(asset_path);
+  if (mapping->GetMapping() == nullptr)
+    return nullptr;
+  return std::move(mapping);
 }
 
 DirectoryAssetBundle::~DirectoryAssetBundle() {}
@@ -5,9 +5,11 @@
 #ifndef FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 #define FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "lib/ftl/macros.h"
 
 namespace blink {
@@ -19,6 +21,12 @@ class DirectoryAssetBundle {
 
   bool GetAsBuffer(const std::string& asset_name, std::vector<uint8_t>* data);
 
+  // Returns the asset as a memory-mapped view of the file, or null if the
+  // asset does not exist. The pages come from the shared page cache, so
+  // repeated loads do not re-read the file and clean pages can be evicted
+  // under memory pressure instead of counting against the heap.
+  std::unique_ptr<fml::Mapping> GetAsMapping(const std::string& asset_name);
+
  private:
   std::string GetPathForAsset(const std::string& asset_name);
 
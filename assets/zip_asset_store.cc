@@ -7,66 +7,187 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <string>
 #include <utility>
 
+#include "flutter/fml/thread_pool.h"
+#include "flutter/glue/trace_event.h"
 #include "lib/ftl/files/eintr_wrapper.h"
 #include "lib/ftl/files/unique_fd.h"
-#include "flutter/glue/trace_event.h"
+#include "lib/ftl/synchronization/waitable_event.h"
 #include "lib/zip/unique_unzipper.h"
 
 namespace blink {
 
-ZipAssetStore::ZipAssetStore(UnzipperProvider unzipper_provider)
-    : unzipper_provider_(std::move(unzipper_provider)) {
+namespace {
+
+// Compression method of entries written without compression.
+const int kCompressionMethodStored = 0;
+
+}  // namespace
+
+ZipAssetStore::ZipAssetStore(UnzipperProvider unzipper_provider,
+                             std::string zip_path)
+    : unzipper_provider_(std::move(unzipper_provider)),
+      zip_path_(std::move(zip_path)) {
   BuildStatCache();
 }
 
 ZipAssetStore::~ZipAssetStore() = default;
 
+ZipAssetStore::EntryStream::EntryStream(zip::UniqueUnzipper unzipper,
+                                        size_t size)
+    : unzipper_(std::move(unzipper)), size_(size) {}
+
+ZipAssetStore::EntryStream::~EntryStream() {
+  if (unzipper_.is_valid()) {
+    unzCloseCurrentFile(unzipper_.get());
+  }
+}
+
+int64_t ZipAssetStore::EntryStream::Read(uint8_t* buffer, size_t count) {
+  return unzReadCurrentFile(unzipper_.get(), buffer, count);
+}
+
 bool ZipAssetStore::GetAsBuffer(const std::string& asset_name,
                                 std::vector<uint8_t>* data) {
   TRACE_EVENT0("flutter", "ZipAssetStore::GetAsBuffer");
+  std::unique_ptr<EntryStream> stream = OpenStream(asset_name);
+
+  if (!stream) {
+    return false;
+  }
+
+  data->resize(stream->size());
+  size_t total_read = 0;
+  while (total_read < data->size()) {
+    int64_t bytes_read =
+        stream->Read(data->data() + total_read, data->size() - total_read);
+    if (bytes_read <= 0) {
+      return false;
+    }
+    total_read += bytes_read;
+  }
+
+  return true;
+}
+
+std::unique_ptr<ZipAssetStore::EntryStream> ZipAssetStore::OpenStream(
+    const std::string& asset_name) {
   auto found = stat_cache_.find(asset_name);
 
   if (found == stat_cache_.end()) {
-    return false;
+    return nullptr;
   }
 
   auto unzipper = unzipper_provider_();
 
   if (!unzipper.is_valid()) {
-    return false;
+    return nullptr;
   }
 
-  int result = UNZ_OK;
-
-  result = unzGoToFilePos(unzipper.get(), &(found->second.file_pos));
+  int result = unzGoToFilePos(unzipper.get(), &(found->second.file_pos));
   if (result != UNZ_OK) {
-    FTL_LOG(WARNING) << "unzGetCurrentFileInfo failed, error=" << result;
-    return false;
+    FTL_LOG(WARNING) << "unzGoToFilePos failed, error=" << result;
+    return nullptr;
   }
 
   result = unzOpenCurrentFile(unzipper.get());
   if (result != UNZ_OK) {
     FTL_LOG(WARNING) << "unzOpenCurrentFile failed, error=" << result;
-    return false;
+    return nullptr;
   }
 
-  data->resize(found->second.uncompressed_size);
-  int total_read = 0;
-  while (total_read < static_cast<int>(data->size())) {
-    int bytes_read = unzReadCurrentFile(
-        unzipper.get(), data->data() + total_read, data->size() - total_read);
-    if (bytes_read <= 0) {
-      return false;
+  return std::unique_ptr<EntryStream>(new EntryStream(
+      std::move(unzipper), found->second.uncompressed_size));
+}
+
+std::unique_ptr<fml::Mapping> ZipAssetStore::GetAsMapping(
+    const std::string& asset_name) {
+  if (zip_path_.empty()) {
+    return nullptr;
+  }
+
+  auto found = stat_cache_.find(asset_name);
+  if (found == stat_cache_.end() || !found->second.is_stored) {
+    return nullptr;
+  }
+
+  auto mapping = std::make_unique<fml::FileMapping>(
+      zip_path_, fml::FileMapping::Protection::ReadOnly,
+      found->second.raw_data_offset, found->second.uncompressed_size);
+  if (mapping->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  return std::move(mapping);
+}
+
+bool ZipAssetStore::GetAsBuffers(const std::vector<std::string>& asset_names,
+                                 std::vector<std::vector<uint8_t>>* data) {
+  TRACE_EVENT0("flutter", "ZipAssetStore::GetAsBuffers");
+  data->clear();
+  data->resize(asset_names.size());
+
+  if (asset_names.size() <= 1) {
+    bool success = true;
+    for (size_t i = 0; i < asset_names.size(); ++i) {
+      success = GetAsBuffer(asset_names[i], &(*data)[i]) && success;
     }
-    total_read += bytes_read;
+    return success;
   }
 
+  // Each task opens its own unzipper through the provider and the stat cache
+  // is read-only after construction, so the tasks share no mutable state.
+  std::atomic<size_t> remaining(asset_names.size());
+  std::atomic<bool> success(true);
+  ftl::AutoResetWaitableEvent latch;
+  for (size_t i = 0; i < asset_names.size(); ++i) {
+    fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+        [this, i, &asset_names, data, &remaining, &success, &latch]() {
+          if (!GetAsBuffer(asset_names[i], &(*data)[i])) {
+            success = false;
+          }
+          if (remaining.fetch_sub(1) == 1) {
+            latch.Signal();
+          }
+        });
+  }
+  latch.Wait();
+  return success;
+}
+
+bool ZipAssetStore::GetEntryFingerprint(const std::string& asset_name,
+                                        uint64_t* fingerprint) const {
+  auto found = stat_cache_.find(asset_name);
+  if (found == stat_cache_.end()) {
+    return false;
+  }
+  *fingerprint = (static_cast<uint64_t>(found->second.crc32) << 32) |
+                 (found->second.uncompressed_size & 0xffffffffu);
   return true;
 }
 
+std::vector<std::string> ZipAssetStore::GetUpdatedAssets(
+    const ZipAssetStore& previous) const {
+  TRACE_EVENT0("flutter", "ZipAssetStore::GetUpdatedAssets");
+  std::vector<std::string> updated;
+  for (const auto& entry : stat_cache_) {
+    auto found = previous.stat_cache_.find(entry.first);
+    if (found == previous.stat_cache_.end() ||
+        found->second.crc32 != entry.second.crc32 ||
+        found->second.uncompressed_size != entry.second.uncompressed_size) {
+      updated.push_back(entry.first);
+    }
+  }
+  for (const auto& entry : previous.stat_cache_) {
+    if (stat_cache_.find(entry.first) == stat_cache_.end()) {
+      updated.push_back(entry.first);
+    }
+  }
+  return updated;
+}
+
 void ZipAssetStore::BuildStatCache() {
   TRACE_EVENT0("flutter", "ZipAssetStore::BuildStatCache");
   auto unzipper = unzipper_provider_();
@@ -104,6 +225,20 @@ void ZipAssetStore::BuildStatCache() {
 
     std::string file_name_key(file_name, file_info.size_filename);
     CacheEntry entry(file_pos, file_info.uncompressed_size);
+    entry.crc32 = file_info.crc;
+
+    // Stored entries can be served as mmap windows later; resolve the
+    // offset of their raw bytes now while the local header is at hand.
+    // Opening the current file does not disturb the central directory walk.
+    if (!zip_path_.empty() &&
+        file_info.compression_method == kCompressionMethodStored &&
+        unzOpenCurrentFile(unzipper.get()) == UNZ_OK) {
+      entry.raw_data_offset = static_cast<size_t>(
+          unzGetCurrentFileZStreamPos64(unzipper.get()));
+      entry.is_stored = entry.raw_data_offset != 0;
+      unzCloseCurrentFile(unzipper.get());
+    }
+
     stat_cache_.emplace(std::move(file_name_key), std::move(entry));
 
   } while (unzGoToNextFile(unzipper.get()) == UNZ_OK);
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_ASSETS_ZIP_ASSET_STORE_H_
 #define FLUTTER_ASSETS_ZIP_ASSET_STORE_H_
 
-#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/assets/unzipper_provider.h"
+#include "flutter/fml/mapping.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/ref_counted.h"
 #include "third_party/zlib/contrib/minizip/unzip.h"
@@ -17,21 +20,92 @@ namespace blink {
 
 class ZipAssetStore : public ftl::RefCountedThreadSafe<ZipAssetStore> {
  public:
-  explicit ZipAssetStore(UnzipperProvider unzipper_provider);
+  // |zip_path|, when given, names the zip file on disk and enables serving
+  // stored (uncompressed) entries as direct memory-mapped windows.
+  explicit ZipAssetStore(UnzipperProvider unzipper_provider,
+                         std::string zip_path = std::string());
   ~ZipAssetStore();
 
+  // An open zip entry from which decompressed bytes are pulled on demand.
+  // Each stream owns its own unzipper, so multiple streams may be open at
+  // once; an individual stream must be read from one thread at a time.
+  class EntryStream {
+   public:
+    ~EntryStream();
+
+    // Total uncompressed size of the entry.
+    size_t size() const { return size_; }
+
+    // Reads up to |count| decompressed bytes into |buffer|. Returns the
+    // number of bytes read, 0 at the end of the entry, or a negative zlib
+    // error code.
+    int64_t Read(uint8_t* buffer, size_t count);
+
+   private:
+    friend class ZipAssetStore;
+
+    EntryStream(zip::UniqueUnzipper unzipper, size_t size);
+
+    zip::UniqueUnzipper unzipper_;
+    size_t size_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(EntryStream);
+  };
+
   bool GetAsBuffer(const std::string& asset_name, std::vector<uint8_t>* data);
 
+  // Opens the asset for incremental decompression so large entries can be
+  // consumed chunk by chunk with peak memory equal to one chunk instead of
+  // the whole inflated file. Returns null if the asset is absent or cannot
+  // be opened.
+  std::unique_ptr<EntryStream> OpenStream(const std::string& asset_name);
+
+  // Returns a stored (uncompressed) asset as a memory-mapped window into the
+  // zip file, or null if the entry is compressed, absent, or the store was
+  // not created from a file on disk. The pages come from the shared page
+  // cache, so repeated loads do not re-read the file.
+  std::unique_ptr<fml::Mapping> GetAsMapping(const std::string& asset_name);
+
+  // Inflates several assets concurrently on the shared worker pool, each
+  // task with its own unzipper. |data| is resized to match |asset_names|;
+  // entries that could not be read are left empty. Blocks until every entry
+  // is done and returns true only if all assets were read.
+  bool GetAsBuffers(const std::vector<std::string>& asset_names,
+                    std::vector<std::vector<uint8_t>>* data);
+
+  // Returns the content fingerprint of an asset, or false if the asset is
+  // absent. The fingerprint combines the CRC32 the bundle tool recorded in
+  // the central directory at build time with the uncompressed size, so it
+  // identifies the entry's content without reading its bytes.
+  bool GetEntryFingerprint(const std::string& asset_name,
+                           uint64_t* fingerprint) const;
+
+  // Diffs this store's manifest against |previous| and returns the names of
+  // assets that are new, have different content, or were removed. Callers
+  // holding caches keyed by asset name use this on hot restart to invalidate
+  // only the delta instead of everything.
+  std::vector<std::string> GetUpdatedAssets(const ZipAssetStore& previous) const;
+
  private:
   struct CacheEntry {
     unz_file_pos file_pos;
     size_t uncompressed_size;
+    // Absolute offset of the entry's raw bytes in the zip file. Only valid
+    // when |is_stored| is set; such entries can be mapped directly.
+    size_t raw_data_offset = 0;
+    bool is_stored = false;
+    // CRC32 of the uncompressed content, as recorded by the bundle tool in
+    // the central directory when the zip was written.
+    uint32_t crc32 = 0;
     CacheEntry(unz_file_pos p_file_pos, size_t p_uncompressed_size)
         : file_pos(p_file_pos), uncompressed_size(p_uncompressed_size) {}
   };
 
   UnzipperProvider unzipper_provider_;
-  std::map<std::string, CacheEntry> stat_cache_;
+  const std::string zip_path_;
+  // Read-only after construction, so lookups need no locking even when
+  // extraction fans out across workers.
+  std::unordered_map<std::string, CacheEntry> stat_cache_;
 
   void BuildStatCache();
 
@@ -0,0 +1,56 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/buffer_transfer_service.h"
+
+#include <utility>
+
+#include "lib/ftl/logging.h"
+
+namespace blink {
+
+HeapBufferMapping::HeapBufferMapping(std::unique_ptr<uint8_t[]> buffer,
+                                     size_t size)
+    : buffer_(std::move(buffer)), size_(size) {}
+
+HeapBufferMapping::~HeapBufferMapping() = default;
+
+size_t HeapBufferMapping::GetSize() const {
+  return size_;
+}
+
+const uint8_t* HeapBufferMapping::GetMapping() const {
+  return buffer_.get();
+}
+
+BufferTransferService& BufferTransferService::Shared() {
+  // Deliberately leaked: handles may be in flight at shutdown.
+  static BufferTransferService* service = new BufferTransferService();
+  return *service;
+}
+
+BufferTransferService::BufferTransferService() : next_handle_(1) {}
+
+BufferTransferService::~BufferTransferService() = default;
+
+int64_t BufferTransferService::Register(std::unique_ptr<fml::Mapping> buffer) {
+  FTL_DCHECK(buffer != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t handle = next_handle_++;
+  buffers_[handle] = std::move(buffer);
+  return handle;
+}
+
+std::unique_ptr<fml::Mapping> BufferTransferService::Take(int64_t handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = buffers_.find(handle);
+  if (found == buffers_.end()) {
+    return nullptr;
+  }
+  auto buffer = std::move(found->second);
+  buffers_.erase(found);
+  return buffer;
+}
+
+}  // namespace blink
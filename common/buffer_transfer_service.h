@@ -0,0 +1,77 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_BUFFER_TRANSFER_SERVICE_H_
+#define FLUTTER_COMMON_BUFFER_TRANSFER_SERVICE_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/fml/mapping.h"
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+// A heap-allocated buffer behind the fml::Mapping interface, for transfer
+// payloads that do not originate from a file or resource mapping.
+class HeapBufferMapping : public fml::Mapping {
+ public:
+  // Takes ownership of |buffer|, which must have been allocated with
+  // new uint8_t[size].
+  HeapBufferMapping(std::unique_ptr<uint8_t[]> buffer, size_t size);
+
+  ~HeapBufferMapping() override;
+
+  size_t GetSize() const override;
+
+  const uint8_t* GetMapping() const override;
+
+ private:
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t size_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(HeapBufferMapping);
+};
+
+// Process-wide escrow for buffers moving between isolates. A sender
+// registers an fml::Mapping-backed buffer and receives an integer handle
+// small enough to travel through a SendPort; the receiver redeems the
+// handle and takes sole ownership of the buffer, which the bindings then
+// materialize as external typed data. The bytes themselves are never
+// copied through the VM.
+//
+// Each handle can be redeemed exactly once. A handle whose receiving
+// isolate dies before redeeming it leaks its buffer until process exit;
+// senders should only register buffers they have a live receiver for.
+//
+// All methods are safe to call from any thread.
+class BufferTransferService {
+ public:
+  static BufferTransferService& Shared();
+
+  // Takes ownership of |buffer| and returns the handle the receiver redeems
+  // it with. |buffer| must not be null.
+  int64_t Register(std::unique_ptr<fml::Mapping> buffer);
+
+  // Redeems |handle|, transferring sole ownership of its buffer to the
+  // caller. Returns null for a handle that was never registered or has
+  // already been redeemed.
+  std::unique_ptr<fml::Mapping> Take(int64_t handle);
+
+ private:
+  BufferTransferService();
+
+  ~BufferTransferService();
+
+  std::mutex mutex_;
+  int64_t next_handle_;
+  std::unordered_map<int64_t, std::unique_ptr<fml::Mapping>> buffers_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(BufferTransferService);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_COMMON_BUFFER_TRANSFER_SERVICE_H_
@@ -0,0 +1,84 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/memory_pressure_listener.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace blink {
+namespace {
+
+struct Registration {
+  size_t id;
+  ftl::RefPtr<ftl::TaskRunner> runner;
+  MemoryPressureListenerRegistry::Listener listener;
+};
+
+std::mutex g_registry_mutex;
+size_t g_next_listener_id = 1;
+
+std::vector<Registration>& Registrations() {
+  static std::vector<Registration>* registrations =
+      new std::vector<Registration>();
+  return *registrations;
+}
+
+// Runs on the listener's own runner. The listener is looked up by id so that
+// a removal that raced the posted task simply finds nothing; the copy is
+// invoked outside the lock because removal happens on this same thread.
+void RunListener(size_t id, MemoryPressureLevel level) {
+  MemoryPressureListenerRegistry::Listener listener;
+  {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for (const auto& registration : Registrations()) {
+      if (registration.id == id) {
+        listener = registration.listener;
+        break;
+      }
+    }
+  }
+  if (listener) {
+    listener(level);
+  }
+}
+
+}  // namespace
+
+size_t MemoryPressureListenerRegistry::AddListener(
+    ftl::RefPtr<ftl::TaskRunner> runner,
+    Listener listener) {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  size_t id = g_next_listener_id++;
+  Registrations().push_back({id, std::move(runner), std::move(listener)});
+  return id;
+}
+
+void MemoryPressureListenerRegistry::RemoveListener(size_t id) {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  auto& registrations = Registrations();
+  for (auto it = registrations.begin(); it != registrations.end(); ++it) {
+    if (it->id == id) {
+      registrations.erase(it);
+      return;
+    }
+  }
+}
+
+void MemoryPressureListenerRegistry::Notify(MemoryPressureLevel level) {
+  std::vector<std::pair<size_t, ftl::RefPtr<ftl::TaskRunner>>> targets;
+  {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for (const auto& registration : Registrations()) {
+      targets.emplace_back(registration.id, registration.runner);
+    }
+  }
+  for (auto& target : targets) {
+    size_t id = target.first;
+    target.second->PostTask([id, level]() { RunListener(id, level); });
+  }
+}
+
+}  // namespace blink
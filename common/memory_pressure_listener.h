@@ -0,0 +1,53 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_MEMORY_PRESSURE_LISTENER_H_
+#define FLUTTER_COMMON_MEMORY_PRESSURE_LISTENER_H_
+
+#include <functional>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_ptr.h"
+#include "lib/ftl/tasks/task_runner.h"
+
+namespace blink {
+
+enum class MemoryPressureLevel {
+  // Free memory that is cheap to recreate; cache budgets are unchanged and
+  // refill with use.
+  kModerate,
+  // Shed everything that can be shed; the OS is about to start killing
+  // processes. Caches that drop their budget to zero restore it themselves
+  // on resume.
+  kCritical,
+};
+
+// A process-wide registry of engine caches that can shed memory. Each cache
+// registers a trim callback along with the task runner of the thread that
+// owns it; Notify posts the pressure level to every listener on its own
+// runner, so one platform signal trims every cache without any cache having
+// to be thread-safe.
+class MemoryPressureListenerRegistry {
+ public:
+  using Listener = std::function<void(MemoryPressureLevel)>;
+
+  // Registers |listener| to be invoked on |runner| for each notification.
+  // Returns an id for RemoveListener. May be called from any thread.
+  static size_t AddListener(ftl::RefPtr<ftl::TaskRunner> runner,
+                            Listener listener);
+
+  // Must be called on the listener's own runner thread so that a
+  // notification already posted there cannot run after removal returns.
+  static void RemoveListener(size_t id);
+
+  // May be called from any thread.
+  static void Notify(MemoryPressureLevel level);
+
+ private:
+  FTL_DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryPressureListenerRegistry);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_COMMON_MEMORY_PRESSURE_LISTENER_H_
@@ -0,0 +1,112 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/performance_profile.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace blink {
+namespace {
+
+struct Registration {
+  size_t id;
+  ftl::RefPtr<ftl::TaskRunner> runner;
+  PerformanceProfileObserverRegistry::Observer observer;
+};
+
+std::mutex g_registry_mutex;
+size_t g_next_observer_id = 1;
+PerformanceProfile g_current_profile;
+
+std::vector<Registration>& Registrations() {
+  static std::vector<Registration>* registrations =
+      new std::vector<Registration>();
+  return *registrations;
+}
+
+// Runs on the observer's own runner. The observer is looked up by id so
+// that a removal that raced the posted task simply finds nothing; the copy
+// is invoked outside the lock because removal happens on this same thread.
+void RunObserver(size_t id, PerformanceProfile profile) {
+  PerformanceProfileObserverRegistry::Observer observer;
+  {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for (const auto& registration : Registrations()) {
+      if (registration.id == id) {
+        observer = registration.observer;
+        break;
+      }
+    }
+  }
+  if (observer) {
+    observer(profile);
+  }
+}
+
+}  // namespace
+
+PerformanceProfile PerformanceProfile::ForMode(PerformanceProfileMode mode) {
+  PerformanceProfile profile;
+  switch (mode) {
+    case PerformanceProfileMode::kPerformance:
+      break;
+    case PerformanceProfileMode::kBatterySaver:
+      profile.frame_rate_divisor = 2;
+      profile.raster_cache_byte_budget = 16 * (1 << 20);
+      profile.max_concurrent_decodes = 1;
+      break;
+  }
+  return profile;
+}
+
+size_t PerformanceProfileObserverRegistry::AddObserver(
+    ftl::RefPtr<ftl::TaskRunner> runner,
+    Observer observer) {
+  size_t id;
+  PerformanceProfile profile;
+  {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    id = g_next_observer_id++;
+    profile = g_current_profile;
+    Registrations().push_back({id, runner, std::move(observer)});
+  }
+  runner->PostTask([id, profile]() { RunObserver(id, profile); });
+  return id;
+}
+
+void PerformanceProfileObserverRegistry::RemoveObserver(size_t id) {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  auto& registrations = Registrations();
+  for (auto it = registrations.begin(); it != registrations.end(); ++it) {
+    if (it->id == id) {
+      registrations.erase(it);
+      return;
+    }
+  }
+}
+
+void PerformanceProfileObserverRegistry::SetProfile(
+    const PerformanceProfile& profile) {
+  std::vector<std::pair<size_t, ftl::RefPtr<ftl::TaskRunner>>> targets;
+  {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    g_current_profile = profile;
+    for (const auto& registration : Registrations()) {
+      targets.emplace_back(registration.id, registration.runner);
+    }
+  }
+  for (auto& target : targets) {
+    size_t id = target.first;
+    target.second->PostTask([id, profile]() { RunObserver(id, profile); });
+  }
+}
+
+PerformanceProfile PerformanceProfileObserverRegistry::GetProfile() {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  return g_current_profile;
+}
+
+}  // namespace blink
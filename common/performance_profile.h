@@ -0,0 +1,73 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_PERFORMANCE_PROFILE_H_
+#define FLUTTER_COMMON_PERFORMANCE_PROFILE_H_
+
+#include <functional>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_ptr.h"
+#include "lib/ftl/tasks/task_runner.h"
+
+namespace blink {
+
+enum class PerformanceProfileMode {
+  // Full frame rate and full cache budgets. The default.
+  kPerformance,
+  // Half frame rate and reduced budgets to cut power draw.
+  kBatterySaver,
+};
+
+// The runtime-tunable counterpart of blink::Settings: the handful of knobs
+// that are worth flipping while the engine is running. Unlike Settings this
+// may change at any time; consumers subscribe through the observer registry
+// below instead of reading a frozen copy.
+struct PerformanceProfile {
+  // Produce a frame every Nth vsync; 1 renders at the display rate, 2
+  // halves it.
+  int frame_rate_divisor = 1;
+
+  // Byte budget for the GPU-thread raster cache. Zero disables byte-based
+  // eviction.
+  size_t raster_cache_byte_budget = 64 * (1 << 20);
+
+  // Image decodes allowed in flight on the shared worker pool.
+  size_t max_concurrent_decodes = 2;
+
+  static PerformanceProfile ForMode(PerformanceProfileMode mode);
+};
+
+// A process-wide registry of consumers of the active PerformanceProfile.
+// Consumers register an observer along with the task runner of the thread
+// that owns the state they tune; SetProfile posts the new profile to every
+// observer on its own runner.
+class PerformanceProfileObserverRegistry {
+ public:
+  using Observer = std::function<void(const PerformanceProfile&)>;
+
+  // Registers |observer| to be invoked on |runner| whenever the profile
+  // changes. The observer is also immediately posted the current profile so
+  // late registrants converge on it. Returns an id for RemoveObserver. May
+  // be called from any thread.
+  static size_t AddObserver(ftl::RefPtr<ftl::TaskRunner> runner,
+                            Observer observer);
+
+  // Must be called on the observer's own runner thread so that a
+  // notification already posted there cannot run after removal returns.
+  static void RemoveObserver(size_t id);
+
+  // Makes |profile| current and notifies every observer. May be called from
+  // any thread.
+  static void SetProfile(const PerformanceProfile& profile);
+
+  static PerformanceProfile GetProfile();
+
+ private:
+  FTL_DISALLOW_IMPLICIT_CONSTRUCTORS(PerformanceProfileObserverRegistry);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_COMMON_PERFORMANCE_PROFILE_H_
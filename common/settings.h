@@ -26,6 +26,11 @@ struct Settings {
   bool enable_dart_profiling = false;
   bool use_test_fonts = false;
   bool dart_non_checked_mode = false;
+  // When enabled, the rasterizer drops to 0.9x or 0.8x render resolution
+  // (upscaled at present) while GPU frame times trend over budget, and
+  // restores full resolution when headroom returns. See
+  // flutter/shell/common/resolution_scale_policy.h.
+  bool enable_dynamic_resolution = false;
   std::string aot_snapshot_path;
   std::string aot_vm_snapshot_data_filename;
   std::string aot_vm_snapshot_instr_filename;
@@ -33,8 +38,37 @@ struct Settings {
   std::string aot_isolate_snapshot_instr_filename;
   std::string application_library_path;
   std::string temp_directory_path;
+  // When set, a JSON object of startup milestone timestamps is written here
+  // after the first frame is presented. See flutter/runtime/start_up.h.
+  std::string startup_metrics_path;
+  // When set, vsync timestamps and pointer packets are appended to an event
+  // log at this path as they pass through the engine. See
+  // flutter/shell/common/event_replay.h.
+  std::string record_events_path;
+  // When set, the engine is driven by the event log at this path instead of
+  // the display and real input, making runs reproducible to the frame.
+  std::string replay_events_path;
+  // When set, the last presented layer tree is serialized to this path when
+  // the application is paused, and presented as a stopgap first frame on
+  // the next launch before the Dart isolate starts. See
+  // flutter/shell/common/layer_tree_snapshot.h.
+  std::string scene_snapshot_path;
+  // When set, raster cache admission decisions learned during the session
+  // are saved to this path keyed by route name and preloaded on the next
+  // launch, so each screen's cache warms on its first frame. See
+  // flutter/flow/raster_cache_hints.h.
+  std::string raster_cache_hints_path;
   std::vector<std::string> dart_flags;
   std::string log_tag = "flutter";
+  // Quiet time, in milliseconds, before a burst of viewport metrics changes
+  // (an Android rotation reports several intermediate sizes) is considered
+  // settled and its final metrics are dispatched to Dart. Zero dispatches
+  // every change immediately.
+  uint32_t metrics_settle_window_ms = 0;
+  // During a coalesced metrics burst, dispatch the predicted final size
+  // (the pre-burst dimensions swapped) once up front, so layout at the new
+  // orientation runs while the transition animation plays.
+  bool speculative_rotation_layout = false;
 
   static const Settings& Get();
   static void Set(const Settings& settings);
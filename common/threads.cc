@@ -6,6 +6,8 @@
 
 #include <utility>
 
+#include "flutter/fml/thread.h"
+
 namespace blink {
 namespace {
 
@@ -53,4 +55,18 @@ void Threads::Set(const Threads& threads) {
   *g_threads = threads;
 }
 
+void Threads::ApplyThreadPriorities() {
+  const auto apply = [](const ftl::RefPtr<ftl::TaskRunner>& runner,
+                        fml::Thread::PriorityClass priority_class) {
+    if (runner) {
+      runner->PostTask([priority_class]() {
+        fml::Thread::SetCurrentThreadPriorityClass(priority_class);
+      });
+    }
+  };
+  apply(Gpu(), fml::Thread::PriorityClass::Performance);
+  apply(UI(), fml::Thread::PriorityClass::Performance);
+  apply(IO(), fml::Thread::PriorityClass::Background);
+}
+
 }  // namespace blink
@@ -25,6 +25,12 @@ class Threads {
 
   static void Set(const Threads& settings);
 
+  // Applies the standard engine scheduling policy to the engine threads:
+  // GPU and UI become frame-critical, IO becomes background work, and the
+  // embedder-owned platform thread is left alone. Must be called after
+  // Set().
+  static void ApplyThreadPriorities();
+
  private:
   static const Threads& Get();
 
@@ -48,8 +48,11 @@ constexpr char kTextInputChannel[] = "flutter/textinput";
 constexpr int kMaxPipelineDepth = 3;
 
 // When the max pipeline depth is exceeded, drain to this number of frames
-// to recover before acknowleding the invalidation and scheduling more frames.
-constexpr int kRecoveryPipelineDepth = 1;
+// before acknowledging the invalidation and scheduling more frames. Resuming
+// as soon as a single slot frees keeps the pipeline full under sustained
+// load; draining further would open a bubble and pay the invalidation
+// round-trip again on every frame of the refill.
+constexpr int kRecoveryPipelineDepth = kMaxPipelineDepth - 1;
 
 blink::PointerData::Change GetChangeFromPointerEventPhase(
     mozart::PointerEvent::Phase phase) {
@@ -271,8 +274,13 @@ void RuntimeHolder::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
     self = GetWeakPtr()
   ]() mutable {
     rasterizer->Draw(std::move(layer_tree), [self]() {
-      if (self)
-        self->OnFrameComplete();
+      // The rasterizer invokes this on the GPU thread. Pipeline accounting
+      // (and the FIDL calls that acknowledging an invalidation can make)
+      // belongs to the platform thread the rest of this object runs on.
+      blink::Threads::Platform()->PostTask([self]() {
+        if (self)
+          self->OnFrameComplete();
+      });
     });
   }));
 }
@@ -461,6 +469,7 @@ void RuntimeHolder::OnEvent(mozart::InputEventPtr event,
   if (event->is_pointer()) {
     const mozart::PointerEventPtr& pointer = event->get_pointer();
     blink::PointerData pointer_data;
+    pointer_data.Clear();
     pointer_data.time_stamp = pointer->event_time;
     pointer_data.change = GetChangeFromPointerEventPhase(pointer->phase);
     pointer_data.kind = GetKindFromPointerType(pointer->type);
@@ -30,6 +30,8 @@ SoftwareRasterizer::~SoftwareRasterizer() = default;
 void SoftwareRasterizer::SetScene(fidl::InterfaceHandle<mozart::Scene> scene) {
   scene_.Bind(std::move(scene));
   surface_producer_.reset(new RasterSurfaceProducer());
+  // The new scene has no knowledge of resources exported to the old one.
+  resource_cache_.Reset();
 }
 
 void SoftwareRasterizer::Draw(std::unique_ptr<flow::LayerTree> layer_tree,
@@ -43,8 +45,10 @@ void SoftwareRasterizer::Draw(std::unique_ptr<flow::LayerTree> layer_tree,
   const SkISize& frame_size = layer_tree->frame_size();
 
   auto update = mozart::SceneUpdate::New();
-  // TODO(abarth): Support incremental updates.
-  update->clear_resources = true;
+  // Nodes are re-sent every frame, but resources are retained across frames
+  // and updated incrementally through the resource cache.
+  // TODO(abarth): Support incremental node updates too.
+  update->clear_resources = false;
   update->clear_nodes = true;
 
   if (frame_size.isEmpty()) {
@@ -64,7 +68,8 @@ void SoftwareRasterizer::Draw(std::unique_ptr<flow::LayerTree> layer_tree,
 
   layer_tree->Preroll(frame);
 
-  flow::SceneUpdateContext context(update.get(), surface_producer_.get());
+  flow::SceneUpdateContext context(update.get(), surface_producer_.get(),
+                                   &resource_cache_);
   auto root_node = mozart::Node::New();
   root_node->hit_test_behavior = mozart::HitTestBehavior::New();
   layer_tree->UpdateScene(context, root_node.get());
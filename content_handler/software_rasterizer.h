@@ -41,6 +41,7 @@ class SoftwareRasterizer : public Rasterizer {
   mozart::ScenePtr scene_;
   std::unique_ptr<RasterSurfaceProducer> surface_producer_;
   flow::CompositorContext compositor_context_;
+  flow::SceneUpdateContext::ResourceCache resource_cache_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(SoftwareRasterizer);
 };
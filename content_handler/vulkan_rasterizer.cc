@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "lib/ftl/files/unique_fd.h"
+#include "lib/ftl/time/time_delta.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkTypes.h"
 #include "third_party/skia/src/gpu/vk/GrVkUtil.h"
@@ -22,6 +23,11 @@ namespace {
 
 constexpr char kDisplayDriverClass[] = "/dev/class/display";
 
+// How long after the last frame the recycled surface pool is dropped
+// entirely. Tick-based trimming only runs while frames are being drawn, so
+// without this an idle app would pin the last frames' buffers forever.
+constexpr int64_t kIdleSurfaceTrimDelayMs = 500;
+
 void WaitForFirstDisplayDriver() {
   ftl::UniqueFD fd(open(kDisplayDriverClass, O_DIRECTORY | O_RDONLY));
   if (fd.get() < 0) {
@@ -46,7 +52,8 @@ void WaitForFirstDisplayDriver() {
 
 }  // namespace
 
-VulkanRasterizer::VulkanSurfaceProducer::VulkanSurfaceProducer() {
+VulkanRasterizer::VulkanSurfaceProducer::VulkanSurfaceProducer()
+    : weak_factory_(this) {
   valid_ = Initialize();
   if (!valid_)
     FTL_LOG(ERROR) << "VulkanSurfaceProducer failed to initialize";
@@ -196,7 +203,7 @@ sk_sp<SkSurface> VulkanRasterizer::VulkanSurfaceProducer::ProduceSurface(
     } else {
       surface = std::move(swapchain.queue.front());
       swapchain.queue.pop();
-      swapchain.tick_count = 0;
+      swapchain.last_used_generation = frame_generation_;
 
       // Need to do some skia foo here to clear all the canvas state from the
       // last frame
@@ -287,14 +294,31 @@ bool VulkanRasterizer::VulkanSurfaceProducer::FinishFrame() {
 }
 
 void VulkanRasterizer::VulkanSurfaceProducer::Tick() {
+  frame_generation_++;
+  TrimStaleSurfaces();
+
+  // Arm the idle trim. Each frame supersedes the previous arm: when the task
+  // runs and another frame has advanced the generation since it was posted,
+  // it does nothing.
+  mtl::MessageLoop::GetCurrent()->task_runner()->PostDelayedTask(
+      [ weak = weak_factory_.GetWeakPtr(), generation = frame_generation_ ]() {
+        if (weak && weak->frame_generation_ == generation) {
+          weak->available_surfaces_.clear();
+        }
+      },
+      ftl::TimeDelta::FromMilliseconds(kIdleSurfaceTrimDelayMs));
+}
+
+void VulkanRasterizer::VulkanSurfaceProducer::TrimStaleSurfaces() {
   for (auto it = available_surfaces_.begin();
        it != available_surfaces_.end();) {
-    auto& swapchain = it->second;
-    swapchain.tick_count++;
-    if (swapchain.tick_count > Swapchain::kMaxTickBeforeDiscard)
+    const auto& swapchain = it->second;
+    if (frame_generation_ - swapchain.last_used_generation >
+        Swapchain::kMaxUnusedGenerations) {
       it = available_surfaces_.erase(it);
-    else
+    } else {
       it++;
+    }
   }
 }
 
@@ -317,12 +341,14 @@ void VulkanRasterizer::VulkanSurfaceProducer::OnHandleReady(
   if (swapchain_it == available_surfaces_.end()) {
     // No matching Swapchain exists, create one
     Swapchain swapchain;
+    swapchain.last_used_generation = frame_generation_;
     if (swapchain.queue.size() + 1 <= Swapchain::kMaxSurfaces) {
       swapchain.queue.push(std::move(info.surface));
     }
     available_surfaces_.insert(std::make_pair(key, std::move(swapchain)));
   } else {
     auto& swapchain = swapchain_it->second;
+    swapchain.last_used_generation = frame_generation_;
     if (swapchain.queue.size() + 1 <= Swapchain::kMaxSurfaces) {
       swapchain.queue.push(std::move(info.surface));
     }
@@ -417,6 +443,8 @@ bool VulkanRasterizer::IsValid() const {
 
 void VulkanRasterizer::SetScene(fidl::InterfaceHandle<mozart::Scene> scene) {
   scene_.Bind(std::move(scene));
+  // The new scene has no knowledge of resources exported to the old one.
+  resource_cache_.Reset();
 }
 
 void VulkanRasterizer::Draw(std::unique_ptr<flow::LayerTree> layer_tree,
@@ -439,8 +467,10 @@ bool VulkanRasterizer::Draw(std::unique_ptr<flow::LayerTree> layer_tree) {
   const SkISize& frame_size = layer_tree->frame_size();
 
   auto update = mozart::SceneUpdate::New();
-  // TODO(abarth): Support incremental updates.
-  update->clear_resources = true;
+  // Nodes are re-sent every frame, but resources are retained across frames
+  // and updated incrementally through the resource cache.
+  // TODO(abarth): Support incremental node updates too.
+  update->clear_resources = false;
   update->clear_nodes = true;
 
   if (frame_size.isEmpty()) {
@@ -461,7 +491,8 @@ bool VulkanRasterizer::Draw(std::unique_ptr<flow::LayerTree> layer_tree) {
 
   layer_tree->Preroll(frame);
 
-  flow::SceneUpdateContext context(update.get(), surface_producer_.get());
+  flow::SceneUpdateContext context(update.get(), surface_producer_.get(),
+                                   &resource_cache_);
   auto root_node = mozart::Node::New();
   root_node->hit_test_behavior = mozart::HitTestBehavior::New();
   layer_tree->UpdateScene(context, root_node.get());
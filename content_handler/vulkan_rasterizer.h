@@ -16,6 +16,7 @@
 #include "flutter/vulkan/vulkan_application.h"
 #include "flutter/vulkan/vulkan_device.h"
 #include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
 #include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
 
 namespace flutter_runner {
@@ -85,9 +86,11 @@ class VulkanRasterizer : public Rasterizer {
 
     struct Swapchain {
       std::queue<std::unique_ptr<Surface>> queue;
-      uint32_t tick_count = 0;
+      // The frame generation this size was last produced from or returned
+      // to, so stale sizes age out after a resize.
+      uint64_t last_used_generation = 0;
       static constexpr uint32_t kMaxSurfaces = 3;
-      static constexpr uint32_t kMaxTickBeforeDiscard = 3;
+      static constexpr uint64_t kMaxUnusedGenerations = 3;
     };
 
     using size_key_t = uint64_t;
@@ -110,15 +113,18 @@ class VulkanRasterizer : public Rasterizer {
 
     // These three containers hold surfaces in various stages of recycling
 
-    // Buffers exist in available_surfaces_ when they are ready to be recycled
-    // ProduceSurface will look here for an appropriately sized surface before
-    // creating a new one
-    // The Swapchain's tick_count is incremented in Tick and decremented when
-    // a surface is taken from the queue, when the tick count goes above
-    // kMaxTickBeforeDiscard the Swapchain is discarded. Newly surfaces are
-    // added to the queue iff there aar less than kMaxSurfaces already in the
-    // queue
+    // Buffers exist in available_surfaces_ when they are ready to be recycled.
+    // ProduceSurface looks here for an exact size match before creating a new
+    // surface, so a steady-state frame allocates nothing. Tick advances
+    // frame_generation_ once per frame; any Swapchain whose
+    // last_used_generation falls more than kMaxUnusedGenerations behind (its
+    // size is no longer being produced, e.g. after a resize) is discarded.
+    // Returning surfaces are added to their size's queue iff fewer than
+    // kMaxSurfaces are already queued.
     std::unordered_map<size_key_t, Swapchain> available_surfaces_;
+    uint64_t frame_generation_ = 0;
+
+    void TrimStaleSurfaces();
 
     struct PendingSurfaceInfo {
       mtl::MessageLoop::HandlerKey handler_key;
@@ -132,6 +138,7 @@ class VulkanRasterizer : public Rasterizer {
     // consumer
     std::unordered_map<mx_handle_t, PendingSurfaceInfo> pending_surfaces_;
     bool valid_;
+    ftl::WeakPtrFactory<VulkanSurfaceProducer> weak_factory_;
 
     bool Initialize();
   };
@@ -139,6 +146,7 @@ class VulkanRasterizer : public Rasterizer {
   flow::CompositorContext compositor_context_;
   mozart::ScenePtr scene_;
   std::unique_ptr<VulkanSurfaceProducer> surface_producer_;
+  flow::SceneUpdateContext::ResourceCache resource_cache_;
 
   bool Draw(std::unique_ptr<flow::LayerTree> layer_tree);
 
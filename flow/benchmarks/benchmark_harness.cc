@@ -0,0 +1,59 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/benchmarks/benchmark_harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace flow {
+namespace benchmarking {
+
+SampleStats Summarize(const std::vector<double>& samples_ms) {
+  SampleStats stats;
+  stats.count = samples_ms.size();
+  if (samples_ms.empty()) {
+    return stats;
+  }
+
+  double sum = 0.0;
+  stats.min = samples_ms.front();
+  stats.max = samples_ms.front();
+  for (double sample : samples_ms) {
+    sum += sample;
+    stats.min = std::min(stats.min, sample);
+    stats.max = std::max(stats.max, sample);
+  }
+  stats.mean = sum / samples_ms.size();
+
+  if (samples_ms.size() > 1) {
+    double sum_squared_deviation = 0.0;
+    for (double sample : samples_ms) {
+      double deviation = sample - stats.mean;
+      sum_squared_deviation += deviation * deviation;
+    }
+    // Sample (not population) standard deviation: these iterations are a
+    // sample of the machine's behavior, not an exhaustive enumeration.
+    stats.stddev = std::sqrt(sum_squared_deviation / (samples_ms.size() - 1));
+    // Normal approximation is fine at the iteration counts used here; the
+    // t-correction below ~30 samples would change the interval by a few
+    // percent at most.
+    stats.ci95_half_width =
+        1.96 * stats.stddev / std::sqrt(static_cast<double>(samples_ms.size()));
+  }
+
+  return stats;
+}
+
+void ReportStage(const std::string& benchmark,
+                 const std::string& stage,
+                 const SampleStats& stats) {
+  std::printf("%s/%s: %8.3f ± %6.3f ms  [%8.3f .. %8.3f]  (%zu samples)\n",
+              benchmark.c_str(), stage.c_str(), stats.mean,
+              stats.ci95_half_width, stats.min, stats.max, stats.count);
+}
+
+}  // namespace benchmarking
+}  // namespace flow
@@ -0,0 +1,40 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_BENCHMARKS_BENCHMARK_HARNESS_H_
+#define FLUTTER_FLOW_BENCHMARKS_BENCHMARK_HARNESS_H_
+
+#include <string>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+
+namespace flow {
+namespace benchmarking {
+
+// Summary statistics over one benchmarked stage. Times are in milliseconds.
+struct SampleStats {
+  double mean = 0.0;
+  double stddev = 0.0;
+  // Half-width of the 95% confidence interval around the mean, so a stage
+  // reports as "mean ± ci95_half_width ms". Two runs whose intervals do not
+  // overlap almost certainly differ for real.
+  double ci95_half_width = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+  size_t count = 0;
+};
+
+SampleStats Summarize(const std::vector<double>& samples_ms);
+
+// Prints one result line in the fixed-width format the lab scripts scrape:
+//   <benchmark>/<stage>: mean ± ci (ms) [min .. max] (N samples)
+void ReportStage(const std::string& benchmark,
+                 const std::string& stage,
+                 const SampleStats& stats);
+
+}  // namespace benchmarking
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_BENCHMARKS_BENCHMARK_HARNESS_H_
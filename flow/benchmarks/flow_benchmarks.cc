@@ -0,0 +1,164 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays serialized SkPictures captured from real sessions (written with
+// shell/common/picture_serializer.h) through the real compositor, headless,
+// and reports per-stage raster times. This makes it possible to bisect
+// raster regressions on a workstation with recorded scenes instead of a
+// device.
+//
+// Usage: flow_benchmarks [--iterations=N] frame1.skp [frame2.skp ...]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/flow/benchmarks/benchmark_harness.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flow {
+namespace benchmarking {
+namespace {
+
+constexpr size_t kDefaultIterations = 100;
+constexpr size_t kWarmUpIterations = 5;
+
+// The benchmark name is the picture's file name without directories, so
+// results stay comparable when the corpus moves between machines.
+std::string BenchmarkName(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+double ElapsedMilliseconds(ftl::TimePoint start) {
+  return (ftl::TimePoint::Now() - start).ToMicroseconds() / 1000.0;
+}
+
+bool BenchmarkPicture(const std::string& path, size_t iterations) {
+  sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+  if (data == nullptr) {
+    std::fprintf(stderr, "Could not read '%s'.\n", path.c_str());
+    return false;
+  }
+
+  sk_sp<SkPicture> picture = SkPicture::MakeFromData(data.get());
+  if (picture == nullptr) {
+    std::fprintf(stderr, "'%s' is not a serialized SkPicture.\n", path.c_str());
+    return false;
+  }
+
+  const SkRect cull = picture->cullRect();
+  const SkISize frame_size = SkISize::Make(
+      std::max(1, static_cast<int>(cull.width())),
+      std::max(1, static_cast<int>(cull.height())));
+
+  // Wrap the recorded frame the way the engine would ship it: a PictureLayer
+  // inside a LayerTree, rastered through CompositorContext::AcquireFrame.
+  // The tree is reused across iterations like a static scene would be.
+  LayerTree tree;
+  {
+    std::unique_ptr<PictureLayer> layer(new PictureLayer());
+    layer->set_offset(SkPoint::Make(cull.left(), cull.top()));
+    layer->set_picture(picture);
+    tree.set_root_layer(std::move(layer));
+  }
+  tree.set_frame_size(frame_size);
+
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(
+      frame_size.width(), frame_size.height());
+  if (surface == nullptr) {
+    std::fprintf(stderr, "Could not allocate a %dx%d raster target for '%s'.\n",
+                 frame_size.width(), frame_size.height(), path.c_str());
+    return false;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+
+  // No GrContext and no process info: stages are timed here directly, the
+  // compositor's own instrumentation stays out of the measurement.
+  CompositorContext compositor_context(nullptr);
+
+  std::vector<double> preroll_ms;
+  std::vector<double> paint_ms;
+  preroll_ms.reserve(iterations);
+  paint_ms.reserve(iterations);
+
+  for (size_t i = 0; i < kWarmUpIterations + iterations; i++) {
+    canvas->clear(SK_ColorBLACK);
+    auto frame = compositor_context.AcquireFrame(nullptr, canvas,
+                                                 false /* instrumentation */);
+
+    // The raster cache is bypassed so every iteration measures the full
+    // paint cost; with the cache on, a static scene converges to a single
+    // cached blit after a few frames and the numbers stop describing the
+    // picture.
+    ftl::TimePoint preroll_start = ftl::TimePoint::Now();
+    tree.Preroll(frame, true /* ignore_raster_cache */);
+    double preroll = ElapsedMilliseconds(preroll_start);
+
+    ftl::TimePoint paint_start = ftl::TimePoint::Now();
+    tree.Paint(frame);
+    canvas->flush();
+    double paint = ElapsedMilliseconds(paint_start);
+
+    if (i >= kWarmUpIterations) {
+      preroll_ms.push_back(preroll);
+      paint_ms.push_back(paint);
+    }
+  }
+
+  const std::string name = BenchmarkName(path);
+  ReportStage(name, "preroll", Summarize(preroll_ms));
+  ReportStage(name, "paint", Summarize(paint_ms));
+  return true;
+}
+
+int BenchmarksMain(int argc, const char** argv) {
+  size_t iterations = kDefaultIterations;
+  std::vector<std::string> paths;
+
+  static const char kIterationsFlag[] = "--iterations=";
+  for (int i = 1; i < argc; i++) {
+    if (std::strncmp(argv[i], kIterationsFlag, sizeof(kIterationsFlag) - 1) ==
+        0) {
+      int parsed = std::atoi(argv[i] + sizeof(kIterationsFlag) - 1);
+      if (parsed > 0) {
+        iterations = static_cast<size_t>(parsed);
+      }
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+
+  if (paths.empty()) {
+    std::fprintf(stderr,
+                 "Usage: flow_benchmarks [--iterations=N] frame1.skp ...\n"
+                 "Frames are serialized SkPictures as written by\n"
+                 "shell::SerializePicture.\n");
+    return 1;
+  }
+
+  bool all_ok = true;
+  for (const auto& path : paths) {
+    all_ok = BenchmarkPicture(path, iterations) && all_ok;
+  }
+  return all_ok ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace flow
+
+int main(int argc, const char** argv) {
+  return flow::benchmarking::BenchmarksMain(argc, argv);
+}
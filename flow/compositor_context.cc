@@ -29,8 +29,18 @@ void CompositorContext::EndFrame(ScopedFrame& frame,
                                  bool enable_instrumentation) {
   raster_cache_.SweepAfterFrame();
   if (enable_instrumentation) {
+    const RasterCache::FrameStatistics& cache_statistics =
+        raster_cache_.frame_statistics();
+    raster_cache_hits_.Add(cache_statistics.hits);
+    raster_cache_misses_.Add(cache_statistics.misses);
+    raster_cache_evictions_.Add(cache_statistics.evictions);
+    raster_cache_bytes_.Add(raster_cache_.GetCachedBytes());
+    raster_cache_rasterization_time_.Add(
+        cache_statistics.rasterization_microseconds);
     frame_time_.Stop();
+    budget_monitor_.AddFrame(frame_time_.LastLap(), cache_statistics);
   }
+  raster_cache_.ResetFrameStatistics();
 }
 
 CompositorContext::ScopedFrame CompositorContext::AcquireFrame(
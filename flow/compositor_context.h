@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "flutter/flow/frame_budget_monitor.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/process_info.h"
 #include "flutter/flow/raster_cache.h"
@@ -61,19 +62,59 @@ class CompositorContext {
 
   const Counter& frame_count() const { return frame_count_; }
 
+  // Frames the rasterizer skipped to catch up after falling behind.
+  Counter& frames_dropped() { return frames_dropped_; }
+
   const Stopwatch& frame_time() const { return frame_time_; }
 
   Stopwatch& engine_time() { return engine_time_; }
 
+  // GPU-side frame time measured with timer queries where the surface
+  // supports them. Results arrive a few frames after submission, so a lap
+  // here describes a recently presented frame rather than the current one.
+  Stopwatch& gpu_time() { return gpu_time_; }
+
   const CounterValues& memory_usage() const { return memory_usage_; }
 
+  // Per-frame raster cache behavior, sampled at the end of each frame.
+  // Rasterization time is reported in microseconds.
+  const CounterValues& raster_cache_hits() const { return raster_cache_hits_; }
+
+  const CounterValues& raster_cache_misses() const {
+    return raster_cache_misses_;
+  }
+
+  const CounterValues& raster_cache_evictions() const {
+    return raster_cache_evictions_;
+  }
+
+  const CounterValues& raster_cache_bytes() const {
+    return raster_cache_bytes_;
+  }
+
+  const CounterValues& raster_cache_rasterization_time() const {
+    return raster_cache_rasterization_time_;
+  }
+
+  // Self-escalating jank diagnostics; fed at the end of each instrumented
+  // frame.
+  FrameBudgetMonitor& budget_monitor() { return budget_monitor_; }
+
  private:
   RasterCache raster_cache_;
+  FrameBudgetMonitor budget_monitor_;
   std::unique_ptr<ProcessInfo> process_info_;
   Counter frame_count_;
+  Counter frames_dropped_;
   Stopwatch frame_time_;
   Stopwatch engine_time_;
+  Stopwatch gpu_time_;
   CounterValues memory_usage_;
+  CounterValues raster_cache_hits_;
+  CounterValues raster_cache_misses_;
+  CounterValues raster_cache_evictions_;
+  CounterValues raster_cache_bytes_;
+  CounterValues raster_cache_rasterization_time_;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
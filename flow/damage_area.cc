@@ -0,0 +1,109 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_area.h"
+
+namespace flow {
+
+namespace {
+
+double RectArea(const SkRect& rect) {
+  return static_cast<double>(rect.width()) * rect.height();
+}
+
+}  // namespace
+
+DamageArea::DamageArea() = default;
+
+DamageArea::~DamageArea() = default;
+
+void DamageArea::AddRect(const SkRect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+
+  // Absorb every existing rect the new one overlaps or touches. Each merge
+  // grows the pending rect, which may bring it into contact with rects that
+  // were checked before, so restart the scan after a merge.
+  SkRect pending = rect;
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < rects_.size(); i++) {
+      SkRect reach = rects_[i];
+      reach.outset(1, 1);
+      if (SkRect::Intersects(reach, pending)) {
+        pending.join(rects_[i]);
+        rects_[i] = rects_.back();
+        rects_.pop_back();
+        merged = true;
+        break;
+      }
+    }
+  }
+  rects_.push_back(pending);
+
+  if (rects_.size() <= kMaxRects) {
+    return;
+  }
+
+  // Over the cap. Merge the pair whose union covers the least area that
+  // neither rect covered on its own.
+  size_t best_a = 0;
+  size_t best_b = 1;
+  double best_waste = 0;
+  bool have_best = false;
+  for (size_t a = 0; a < rects_.size(); a++) {
+    for (size_t b = a + 1; b < rects_.size(); b++) {
+      SkRect joined = rects_[a];
+      joined.join(rects_[b]);
+      double waste = RectArea(joined) - RectArea(rects_[a]) - RectArea(rects_[b]);
+      if (!have_best || waste < best_waste) {
+        best_a = a;
+        best_b = b;
+        best_waste = waste;
+        have_best = true;
+      }
+    }
+  }
+  SkRect joined = rects_[best_a];
+  joined.join(rects_[best_b]);
+  rects_[best_b] = rects_.back();
+  rects_.pop_back();
+  rects_[best_a] = rects_.back();
+  rects_.pop_back();
+  // The merged rect may now overlap survivors; adding it back re-coalesces.
+  AddRect(joined);
+}
+
+void DamageArea::Join(const DamageArea& other) {
+  for (const SkRect& rect : other.rects_) {
+    AddRect(rect);
+  }
+}
+
+void DamageArea::Intersect(const SkRect& bounds) {
+  for (size_t i = rects_.size(); i > 0; i--) {
+    if (!rects_[i - 1].intersect(bounds)) {
+      rects_[i - 1] = rects_.back();
+      rects_.pop_back();
+    }
+  }
+}
+
+void DamageArea::Transform(const SkMatrix& matrix) {
+  for (SkRect& rect : rects_) {
+    matrix.mapRect(&rect);
+  }
+}
+
+SkRect DamageArea::Bounds() const {
+  SkRect bounds = SkRect::MakeEmpty();
+  for (const SkRect& rect : rects_) {
+    bounds.join(rect);
+  }
+  return bounds;
+}
+
+}  // namespace flow
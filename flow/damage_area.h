@@ -0,0 +1,61 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DAMAGE_AREA_H_
+#define FLUTTER_FLOW_DAMAGE_AREA_H_
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flow {
+
+// The damaged region of a frame, kept as a small set of disjoint rects
+// instead of one bounding box. A dashboard updating hundreds of scattered
+// cells damages very little area, but the bounding box of those cells is
+// nearly the whole frame; keeping the rects separate lets the partial
+// repaint pass skip everything between them. Rects that overlap or touch
+// are coalesced as they are added, and the set is capped at kMaxRects by
+// merging the pair whose union wastes the least area, so the region never
+// degenerates into per-cell bookkeeping.
+class DamageArea {
+ public:
+  // Past this many rects the per-rect clipping and clearing overhead
+  // outweighs the pixels saved.
+  static const size_t kMaxRects = 8;
+
+  DamageArea();
+  ~DamageArea();
+
+  // Adds |rect| to the region, coalescing it with any rects it overlaps or
+  // touches. Empty rects are ignored.
+  void AddRect(const SkRect& rect);
+
+  // Adds every rect of |other| to this region.
+  void Join(const DamageArea& other);
+
+  // Clips the region to |bounds|, dropping rects that fall entirely outside.
+  void Intersect(const SkRect& bounds);
+
+  // Maps every rect through |matrix|. The result is each rect's bounding
+  // box in the new space, matching SkMatrix::mapRect.
+  void Transform(const SkMatrix& matrix);
+
+  // The bounding box of the region; empty when the region is empty.
+  SkRect Bounds() const;
+
+  bool IsEmpty() const { return rects_.empty(); }
+
+  void Clear() { rects_.clear(); }
+
+  const std::vector<SkRect>& rects() const { return rects_; }
+
+ private:
+  std::vector<SkRect> rects_;
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_DAMAGE_AREA_H_
@@ -0,0 +1,171 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_budget_monitor.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "flutter/flow/instrumentation.h"
+#include "lib/ftl/logging.h"
+
+namespace flow {
+namespace {
+
+const size_t kLayerTypeCount = static_cast<size_t>(Layer::Type::kChildScene) + 1;
+
+const char* LayerTypeName(Layer::Type type) {
+  switch (type) {
+    case Layer::Type::kContainer:
+      return "Container";
+    case Layer::Type::kPicture:
+      return "Picture";
+    case Layer::Type::kTiledPicture:
+      return "TiledPicture";
+    case Layer::Type::kTransform:
+      return "Transform";
+    case Layer::Type::kOpacity:
+      return "Opacity";
+    case Layer::Type::kClipRect:
+      return "ClipRect";
+    case Layer::Type::kClipRRect:
+      return "ClipRRect";
+    case Layer::Type::kClipPath:
+      return "ClipPath";
+    case Layer::Type::kColorFilter:
+      return "ColorFilter";
+    case Layer::Type::kShaderMask:
+      return "ShaderMask";
+    case Layer::Type::kBackdropFilter:
+      return "BackdropFilter";
+    case Layer::Type::kPhysicalModel:
+      return "PhysicalModel";
+    case Layer::Type::kPerformanceOverlay:
+      return "PerformanceOverlay";
+    case Layer::Type::kChildScene:
+      return "ChildScene";
+  }
+  return "Unknown";
+}
+
+}  // namespace
+
+FrameBudgetMonitor::FrameBudgetMonitor()
+    : rolling_ms_(kRollingWindowFrames, 0.0),
+      layer_totals_(kLayerTypeCount) {}
+
+FrameBudgetMonitor::~FrameBudgetMonitor() = default;
+
+void FrameBudgetMonitor::AddFrame(
+    const ftl::TimeDelta& frame_time,
+    const RasterCache::FrameStatistics& cache_statistics) {
+  const double frame_ms = frame_time.ToMillisecondsF();
+
+  if (capture_active()) {
+    captured_frames_++;
+    captured_frame_time_total_ = captured_frame_time_total_ + frame_time;
+    if (frame_time > captured_frame_time_max_) {
+      captured_frame_time_max_ = frame_time;
+    }
+    if (frame_ms > kOneFrameMS) {
+      frames_over_budget_++;
+    }
+    cache_hits_ += cache_statistics.hits;
+    cache_misses_ += cache_statistics.misses;
+    cache_evictions_ += cache_statistics.evictions;
+
+    capture_frames_remaining_--;
+    if (capture_frames_remaining_ == 0) {
+      EmitReport();
+    }
+    return;
+  }
+
+  rolling_ms_[next_rolling_sample_] = frame_ms;
+  next_rolling_sample_ = (next_rolling_sample_ + 1) % kRollingWindowFrames;
+  if (next_rolling_sample_ == 0) {
+    rolling_full_ = true;
+  }
+
+  if (!rolling_full_) {
+    return;
+  }
+
+  const double p95_ms = RollingPercentileMS(95.0);
+  if (p95_ms > kOneFrameMS) {
+    BeginCapture(p95_ms);
+  }
+}
+
+void FrameBudgetMonitor::AddLayerPaint(const Layer& layer,
+                                       const ftl::TimeDelta& duration) {
+  if (!capture_active()) {
+    return;
+  }
+  LayerPaintTotals& totals = layer_totals_[static_cast<size_t>(layer.type())];
+  totals.paints++;
+  totals.total_time = totals.total_time + duration;
+}
+
+double FrameBudgetMonitor::RollingPercentileMS(double percentile) const {
+  std::vector<double> sorted(rolling_ms_);
+  std::sort(sorted.begin(), sorted.end());
+  size_t index = static_cast<size_t>((percentile / 100.0) * sorted.size());
+  if (index >= sorted.size()) {
+    index = sorted.size() - 1;
+  }
+  return sorted[index];
+}
+
+void FrameBudgetMonitor::BeginCapture(double trigger_p95_ms) {
+  trigger_p95_ms_ = trigger_p95_ms;
+  capture_frames_remaining_ = kCaptureFrames;
+  captured_frames_ = 0;
+  frames_over_budget_ = 0;
+  captured_frame_time_total_ = ftl::TimeDelta::Zero();
+  captured_frame_time_max_ = ftl::TimeDelta::Zero();
+  cache_hits_ = 0;
+  cache_misses_ = 0;
+  cache_evictions_ = 0;
+  std::fill(layer_totals_.begin(), layer_totals_.end(), LayerPaintTotals());
+
+  FTL_LOG(INFO) << "FrameBudgetMonitor: rolling p95 " << trigger_p95_ms
+                << "ms exceeds the " << kOneFrameMS
+                << "ms budget; capturing verbose diagnostics for "
+                << kCaptureFrames << " frames.";
+}
+
+void FrameBudgetMonitor::EmitReport() {
+  std::ostringstream report;
+  report << "FrameBudgetMonitor report (trigger p95 " << trigger_p95_ms_
+         << "ms, budget " << kOneFrameMS << "ms): " << captured_frames_
+         << " frames captured, " << frames_over_budget_ << " over budget, avg "
+         << (captured_frames_ > 0
+                 ? captured_frame_time_total_.ToMillisecondsF() / captured_frames_
+                 : 0.0)
+         << "ms, worst " << captured_frame_time_max_.ToMillisecondsF()
+         << "ms; raster cache " << cache_hits_ << " hits / " << cache_misses_
+         << " misses / " << cache_evictions_ << " evictions";
+
+  // Per-layer paint totals, inclusive of each layer's subtree, so container
+  // totals overlap their descendants'.
+  for (size_t i = 0; i < layer_totals_.size(); i++) {
+    const LayerPaintTotals& totals = layer_totals_[i];
+    if (totals.paints == 0) {
+      continue;
+    }
+    report << "; " << LayerTypeName(static_cast<Layer::Type>(i)) << " "
+           << totals.total_time.ToMillisecondsF() << "ms over " << totals.paints
+           << " paints";
+  }
+
+  FTL_LOG(INFO) << report.str();
+
+  // Refill the window from scratch so the capture's own tail cannot
+  // immediately re-arm the trigger.
+  rolling_full_ = false;
+  next_rolling_sample_ = 0;
+}
+
+}  // namespace flow
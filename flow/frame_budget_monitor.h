@@ -0,0 +1,88 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_BUDGET_MONITOR_H_
+#define FLUTTER_FLOW_FRAME_BUDGET_MONITOR_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+
+namespace flow {
+
+// A flight recorder for rasterizer frame budget overruns. The monitor
+// watches a rolling window of frame times; when the window's p95 exceeds
+// the frame budget it escalates to a verbose capture level for a fixed
+// number of frames — per-layer paint timings and raster cache events are
+// recorded — then emits a one-shot summary report to the log and drops
+// back to passive watching. Diagnosing a jank report from the field thus
+// no longer requires an engineer to be attached when it happens.
+class FrameBudgetMonitor {
+ public:
+  // The window whose p95 arms the capture, and the number of frames a
+  // capture records before reporting.
+  static const size_t kRollingWindowFrames = 30;
+  static const size_t kCaptureFrames = 120;
+
+  FrameBudgetMonitor();
+
+  ~FrameBudgetMonitor();
+
+  // True while an escalated capture is running; ContainerLayer::PaintChildren
+  // records per-layer paint timings only in this state, so the verbose level
+  // costs nothing when frames are healthy.
+  bool capture_active() const { return capture_frames_remaining_ > 0; }
+
+  // Feeds one instrumented frame: the rasterizer lap just recorded and the
+  // raster cache's statistics for that frame. Decides escalation, and emits
+  // the summary report when a capture window completes.
+  void AddFrame(const ftl::TimeDelta& frame_time,
+                const RasterCache::FrameStatistics& cache_statistics);
+
+  // Records one layer's paint duration, inclusive of its subtree, while a
+  // capture is active.
+  void AddLayerPaint(const Layer& layer, const ftl::TimeDelta& duration);
+
+ private:
+  struct LayerPaintTotals {
+    uint64_t paints = 0;
+    ftl::TimeDelta total_time;
+  };
+
+  double RollingPercentileMS(double percentile) const;
+
+  void BeginCapture(double trigger_p95_ms);
+
+  void EmitReport();
+
+  // Rolling frame-time window, in milliseconds; refills from scratch after
+  // a capture so a report cannot immediately re-trigger on its own tail.
+  std::vector<double> rolling_ms_;
+  size_t next_rolling_sample_ = 0;
+  bool rolling_full_ = false;
+
+  // Capture state.
+  size_t capture_frames_remaining_ = 0;
+  double trigger_p95_ms_ = 0.0;
+  uint64_t captured_frames_ = 0;
+  uint64_t frames_over_budget_ = 0;
+  ftl::TimeDelta captured_frame_time_total_;
+  ftl::TimeDelta captured_frame_time_max_;
+  uint64_t cache_hits_ = 0;
+  uint64_t cache_misses_ = 0;
+  uint64_t cache_evictions_ = 0;
+  // Indexed by Layer::Type.
+  std::vector<LayerPaintTotals> layer_totals_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(FrameBudgetMonitor);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_FRAME_BUDGET_MONITOR_H_
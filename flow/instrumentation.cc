@@ -14,9 +14,13 @@ namespace flow {
 static const size_t kMaxSamples = 120;
 static const size_t kMaxFrameMarkers = 8;
 
-Stopwatch::Stopwatch() : start_(ftl::TimePoint::Now()), current_sample_(0) {
+Stopwatch::Stopwatch()
+    : start_(ftl::TimePoint::Now()),
+      current_sample_(0),
+      histogram_lap_count_(0) {
   const ftl::TimeDelta delta = ftl::TimeDelta::Zero();
   laps_.resize(kMaxSamples, delta);
+  histogram_.resize(kHistogramBuckets, 0);
 }
 
 Stopwatch::~Stopwatch() = default;
@@ -28,11 +32,63 @@ void Stopwatch::Start() {
 
 void Stopwatch::Stop() {
   laps_[current_sample_] = ftl::TimePoint::Now() - start_;
+  AddLapToHistogram(laps_[current_sample_]);
 }
 
 void Stopwatch::SetLapTime(const ftl::TimeDelta& delta) {
   current_sample_ = (current_sample_ + 1) % kMaxSamples;
   laps_[current_sample_] = delta;
+  AddLapToHistogram(delta);
+}
+
+// Maps |delta| to a bucket whose width grows with the magnitude of the lap
+// time: each power of two of microseconds is split into kHistogramSubBuckets
+// linear sub-buckets.
+static size_t HistogramBucketFor(int64_t microseconds) {
+  if (microseconds < 1) {
+    return 0;
+  }
+  size_t octave = 0;
+  int64_t value = microseconds;
+  while (value >>= 1) {
+    octave++;
+  }
+  const int64_t lower_bound = INT64_C(1) << octave;
+  const size_t sub_bucket =
+      octave == 0 ? 0 : static_cast<size_t>((microseconds - lower_bound) *
+                                            Stopwatch::kHistogramSubBuckets /
+                                            lower_bound);
+  return octave * Stopwatch::kHistogramSubBuckets + sub_bucket;
+}
+
+void Stopwatch::AddLapToHistogram(const ftl::TimeDelta& delta) {
+  size_t bucket = HistogramBucketFor(delta.ToMicroseconds());
+  if (bucket >= kHistogramBuckets) {
+    bucket = kHistogramBuckets - 1;
+  }
+  histogram_[bucket]++;
+  histogram_lap_count_++;
+}
+
+double Stopwatch::GetLapPercentileMS(double percentile) const {
+  if (histogram_lap_count_ == 0) {
+    return 0.0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(
+      (percentile / 100.0) * static_cast<double>(histogram_lap_count_ - 1));
+  uint64_t cumulative = 0;
+  for (size_t bucket = 0; bucket < kHistogramBuckets; bucket++) {
+    cumulative += histogram_[bucket];
+    if (cumulative > rank) {
+      const size_t octave = bucket / kHistogramSubBuckets;
+      const size_t sub_bucket = bucket % kHistogramSubBuckets;
+      const double lower_bound = static_cast<double>(INT64_C(1) << octave);
+      const double bucket_width = lower_bound / kHistogramSubBuckets;
+      // Representative value: middle of the bucket, in milliseconds.
+      return (lower_bound + (sub_bucket + 0.5) * bucket_width) * 1e-3;
+    }
+  }
+  return 0.0;
 }
 
 const ftl::TimeDelta& Stopwatch::LastLap() const {
@@ -36,10 +36,27 @@ class Stopwatch {
 
   void SetLapTime(const ftl::TimeDelta& delta);
 
+  // Percentile lap time (e.g. 95.0 for p95) computed from a log-bucketed
+  // histogram that accumulates every lap over the session, unlike the
+  // fixed-size sample ring used for the overlay graph. Returns zero until
+  // at least one lap has been recorded.
+  double GetLapPercentileMS(double percentile) const;
+
+  uint64_t lap_count() const { return histogram_lap_count_; }
+
+  // Four sub-buckets per power of two of microseconds gives ~19% relative
+  // error, plenty for tail-latency monitoring.
+  static const size_t kHistogramSubBuckets = 4;
+  static const size_t kHistogramBuckets = 32 * kHistogramSubBuckets;
+
  private:
+  void AddLapToHistogram(const ftl::TimeDelta& delta);
+
   ftl::TimePoint start_;
   std::vector<ftl::TimeDelta> laps_;
   size_t current_sample_;
+  std::vector<uint64_t> histogram_;
+  uint64_t histogram_lap_count_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(Stopwatch);
 };
@@ -0,0 +1,90 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_arena.h"
+
+#include <stdlib.h>
+
+#include "flutter/fml/thread_local.h"
+#include "lib/ftl/logging.h"
+
+namespace flow {
+
+namespace {
+
+// Each block comfortably holds the layers of a complex frame; trees that
+// overflow simply chain additional blocks.
+const size_t kBlockSize = 64 * 1024;
+
+// Allocation header, sized to preserve the strictest alignment for the
+// layer object that follows it.
+const size_t kHeaderSize = alignof(max_align_t);
+
+const uint64_t kArenaAllocation = 0xA53Au;
+const uint64_t kHeapAllocation = 0x4EA7u;
+
+FML_THREAD_LOCAL fml::ThreadLocal tls_current_arena;
+
+}  // namespace
+
+LayerArena::LayerArena()
+    : cursor_(nullptr), remaining_(0), bytes_allocated_(0) {}
+
+LayerArena::~LayerArena() {
+  FTL_DCHECK(GetCurrent() != this);
+}
+
+LayerArena* LayerArena::GetCurrent() {
+  return reinterpret_cast<LayerArena*>(tls_current_arena.Get());
+}
+
+void LayerArena::SetCurrent(LayerArena* arena) {
+  tls_current_arena.Set(reinterpret_cast<intptr_t>(arena));
+}
+
+void* LayerArena::Allocate(size_t size) {
+  // Keep successive allocations aligned for the next header.
+  size = (size + kHeaderSize - 1) & ~(kHeaderSize - 1);
+  if (size > remaining_) {
+    size_t block_size = size > kBlockSize ? size : kBlockSize;
+    blocks_.emplace_back(std::make_unique<uint8_t[]>(block_size));
+    cursor_ = blocks_.back().get();
+    remaining_ = block_size;
+  }
+  uint8_t* allocation = cursor_;
+  cursor_ += size;
+  remaining_ -= size;
+  bytes_allocated_ += size;
+  return allocation;
+}
+
+void* LayerArena::AllocateLayer(size_t size) {
+  LayerArena* arena = GetCurrent();
+  uint8_t* base;
+  if (arena != nullptr) {
+    base = static_cast<uint8_t*>(arena->Allocate(size + kHeaderSize));
+    *reinterpret_cast<uint64_t*>(base) = kArenaAllocation;
+  } else {
+    base = static_cast<uint8_t*>(malloc(size + kHeaderSize));
+    FTL_CHECK(base != nullptr);
+    *reinterpret_cast<uint64_t*>(base) = kHeapAllocation;
+  }
+  return base + kHeaderSize;
+}
+
+void LayerArena::FreeLayer(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  uint8_t* base = static_cast<uint8_t*>(ptr) - kHeaderSize;
+  uint64_t tag = *reinterpret_cast<uint64_t*>(base);
+  if (tag == kHeapAllocation) {
+    free(base);
+    return;
+  }
+  FTL_DCHECK(tag == kArenaAllocation);
+  // Arena storage is released wholesale when the arena is destroyed.
+}
+
+}  // namespace flow
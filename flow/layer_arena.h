@@ -0,0 +1,55 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYER_ARENA_H_
+
+#include <memory>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+
+namespace flow {
+
+// Frame-scoped bump allocator for Layer instances. While an arena is
+// installed as the current arena for the UI thread, Layer::operator new
+// draws from it instead of the general-purpose heap; the per-layer operator
+// delete becomes a no-op for arena allocations so the entire frame's layer
+// storage is released wholesale when the arena (owned by the LayerTree)
+// retires with its tree.
+class LayerArena {
+ public:
+  LayerArena();
+
+  ~LayerArena();
+
+  // The arena used by Layer::operator new on the calling thread, or null if
+  // layers should be heap-allocated.
+  static LayerArena* GetCurrent();
+
+  static void SetCurrent(LayerArena* arena);
+
+  // Allocation entry points for Layer::operator new/delete. Each allocation
+  // carries a small header recording its origin so delete can route heap
+  // allocations back to the heap and ignore arena allocations.
+  static void* AllocateLayer(size_t size);
+
+  static void FreeLayer(void* ptr);
+
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
+ private:
+  void* Allocate(size_t size);
+
+  std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+  uint8_t* cursor_;
+  size_t remaining_;
+  size_t bytes_allocated_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_LAYER_ARENA_H_
@@ -4,20 +4,188 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include <vector>
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
 namespace flow {
 
-BackdropFilterLayer::BackdropFilterLayer() {}
+namespace {
+
+// Cache of filtered backdrop snapshots, keyed by the device-space region a
+// backdrop filter reads. A frosted-glass bar over a static scene re-filters
+// identical pixels every frame; when the frame's damage region (computed by
+// the tree diff against the previous frame) does not touch the filter's
+// region, last frame's filtered output is still exact and is replayed as an
+// image. Any damage touching the region — content behind changing, the
+// filter itself changing (a property change damages the layer's bounds) —
+// drops the entry and the next paint recaptures it.
+//
+// Only touched from the GPU thread during Paint.
+class BackdropSnapshotCache {
+ public:
+  struct Entry {
+    SkIRect device_bounds;
+    SkMatrix ctm;
+    sk_sp<SkImage> image;
+    SkIPoint image_offset;
+  };
+
+  const Entry* Get(const SkIRect& device_bounds, const SkMatrix& ctm) const {
+    for (const Entry& entry : entries_) {
+      if (entry.device_bounds == device_bounds && entry.ctm == ctm)
+        return &entry;
+    }
+    return nullptr;
+  }
+
+  void Put(Entry entry) {
+    if (entries_.size() >= kMaxEntries)
+      entries_.erase(entries_.begin());
+    entries_.push_back(std::move(entry));
+  }
+
+  // Drops entries whose region intersects |device_damage|, or every entry
+  // when the frame's damage is unknown.
+  void Invalidate(bool damage_known, const SkRect& device_damage) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (!damage_known ||
+          SkRect::Intersects(SkRect::Make(it->device_bounds), device_damage)) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+ private:
+  static const size_t kMaxEntries = 4;
+
+  std::vector<Entry> entries_;
+};
+
+BackdropSnapshotCache& SharedBackdropCache() {
+  static BackdropSnapshotCache* cache = new BackdropSnapshotCache();
+  return *cache;
+}
+
+}  // namespace
+
+BackdropFilterLayer::BackdropFilterLayer() : ContainerLayer(Type::kBackdropFilter) {}
 
 BackdropFilterLayer::~BackdropFilterLayer() {}
 
+bool BackdropFilterLayer::PropertiesEqual(
+    const ContainerLayer& old_layer) const {
+  return filter_ ==
+         static_cast<const BackdropFilterLayer&>(old_layer).filter_;
+}
+
+void BackdropFilterLayer::PrerollOcclusion(OcclusionContext* context,
+                                           const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // The filtered backdrop is composited under the children with unknown
+  // alpha, and the children themselves pass through a saveLayer; neither
+  // may claim opacity. Content in front of this layer can still occlude
+  // the children, so visit them before touching the accumulator.
+  PrerollOcclusionChildrenWithoutContribution(context, matrix);
+  // The filter samples whatever has been painted behind this layer, so
+  // layers behind it must be rastered even when opaque content in front
+  // would otherwise cover them. Drop the accumulated region; behind-layers
+  // can still occlude each other from here on.
+  context->opaque_rects.clear();
+}
+
 void BackdropFilterLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
-  Layer::AutoSaveLayer(
+  if (PaintWithCachedBackdrop(context))
+    return;
+  Layer::AutoSaveLayer save(
       context,
       SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::PaintWithCachedBackdrop(PaintContext& context) {
+  if (!filter_)
+    return false;
+
+  SkCanvas& canvas = context.canvas;
+  const SkMatrix& ctm = canvas.getTotalMatrix();
+  if (!ctm.rectStaysRect())
+    return false;
+
+  SkRect device_rect;
+  ctm.mapRect(&device_rect, paint_bounds());
+  SkIRect device_bounds = device_rect.roundOut();
+  if (device_bounds.isEmpty())
+    return false;
+
+  BackdropSnapshotCache& cache = SharedBackdropCache();
+  cache.Invalidate(context.frame_damage_known, context.frame_damage);
+
+  const BackdropSnapshotCache::Entry* entry =
+      cache.Get(device_bounds, ctm);
+  if (entry == nullptr) {
+    if (!context.frame_damage_known) {
+      // Without damage information a snapshot could never be proven fresh,
+      // so capturing one would only add cost.
+      return false;
+    }
+    if (SkRect::Intersects(SkRect::Make(device_bounds),
+                           context.frame_damage)) {
+      // The backdrop is changing this frame. Capturing now would pay the
+      // readback stall every animated frame; wait until the region goes
+      // quiet and snapshot it then.
+      return false;
+    }
+    // Read the backdrop pixels back once and filter them on the CPU side.
+    // The readback stalls the pipeline, but it happens only when the region
+    // is first seen or actually changed; every static frame afterwards is a
+    // plain image draw.
+    TRACE_EVENT0("flutter", "BackdropFilterLayer::SnapshotBackdrop");
+    SkBitmap backdrop;
+    if (!backdrop.tryAllocN32Pixels(device_bounds.width(),
+                                    device_bounds.height()))
+      return false;
+    if (!canvas.readPixels(&backdrop, device_bounds.left(),
+                           device_bounds.top()))
+      return false;
+    sk_sp<SkImage> unfiltered = SkImage::MakeFromBitmap(backdrop);
+    if (!unfiltered)
+      return false;
+    SkIRect subset = SkIRect::MakeWH(device_bounds.width(),
+                                     device_bounds.height());
+    SkIRect out_subset;
+    SkIPoint offset;
+    sk_sp<SkImage> filtered = unfiltered->makeWithFilter(
+        filter_.get(), subset, subset, &out_subset, &offset);
+    if (!filtered)
+      return false;
+    cache.Put({device_bounds, ctm, std::move(filtered),
+               SkIPoint::Make(device_bounds.left() + offset.x(),
+                              device_bounds.top() + offset.y())});
+    entry = cache.Get(device_bounds, ctm);
+    if (entry == nullptr)
+      return false;
+  }
+
+  // Replay the filtered backdrop in device space, then paint the children
+  // directly; with no layer paint this composes identically to the
+  // backdrop-initialized saveLayer.
+  {
+    SkAutoCanvasRestore save(&canvas, true);
+    canvas.resetMatrix();
+    canvas.clipRect(SkRect::Make(entry->device_bounds));
+    canvas.drawImage(entry->image.get(), entry->image_offset.x(),
+                     entry->image_offset.y());
+  }
+  PaintChildren(context);
+  return true;
+}
+
 }  // namespace flow
@@ -17,9 +17,18 @@ class BackdropFilterLayer : public ContainerLayer {
   void set_filter(sk_sp<SkImageFilter> filter) { filter_ = std::move(filter); }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
  private:
+  // Paints from the shared backdrop snapshot cache when the frame's damage
+  // proves the pixels behind this layer are unchanged. Returns false when
+  // the regular backdrop saveLayer must run instead.
+  bool PaintWithCachedBackdrop(PaintContext& context);
+
   sk_sp<SkImageFilter> filter_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
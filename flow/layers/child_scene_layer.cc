@@ -9,7 +9,7 @@
 
 namespace flow {
 
-ChildSceneLayer::ChildSceneLayer() = default;
+ChildSceneLayer::ChildSceneLayer() : Layer(Type::kChildScene) {}
 
 ChildSceneLayer::~ChildSceneLayer() = default;
 
@@ -36,11 +36,6 @@ void ChildSceneLayer::UpdateScene(SceneUpdateContext& context,
                                   mozart::Node* container) {
   FTL_DCHECK(needs_system_composite());
 
-  auto resource = mozart::Resource::New();
-  resource->set_scene(mozart::SceneResource::New());
-  resource->get_scene()->scene_token = mozart::SceneToken::New();
-  resource->get_scene()->scene_token->value = scene_token_;
-
   auto node = mozart::Node::New();
   if (!hit_testable_) {
     node->hit_test_behavior = mozart::HitTestBehavior::New();
@@ -50,8 +45,10 @@ void ChildSceneLayer::UpdateScene(SceneUpdateContext& context,
   }
   node->op = mozart::NodeOp::New();
   node->op->set_scene(mozart::SceneNodeOp::New());
+  // The scene resource is stable across frames; the context re-exports it
+  // only if it is not already cached.
   node->op->get_scene()->scene_resource_id =
-      context.AddResource(std::move(resource));
+      context.AddSceneResource(scene_token_);
   node->content_clip = mozart::RectF::New();
   node->content_clip->width = physical_size_.width();
   node->content_clip->height = physical_size_.height();
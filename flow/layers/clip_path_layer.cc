@@ -11,17 +11,31 @@
 
 namespace flow {
 
-ClipPathLayer::ClipPathLayer() {}
+ClipPathLayer::ClipPathLayer() : ContainerLayer(Type::kClipPath) {}
 
 ClipPathLayer::~ClipPathLayer() {}
 
 void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  const SkRect previous_cull_rect = context->cull_rect;
+  if (!context->cull_rect.intersect(clip_path_.getBounds()))
+    context->cull_rect.setEmpty();
   PrerollChildren(context, matrix);
+  context->cull_rect = previous_cull_rect;
   if (!context->child_paint_bounds.intersect(clip_path_.getBounds()))
     context->child_paint_bounds.setEmpty();
   set_paint_bounds(context->child_paint_bounds);
 }
 
+void ClipPathLayer::PrerollOcclusion(OcclusionContext* context,
+                                     const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // An arbitrary path clip offers no cheap guarantee about which pixels
+  // survive, so the children may not claim opacity.
+  PrerollOcclusionChildrenWithoutContribution(context, matrix);
+}
+
 #if defined(OS_FUCHSIA)
 
 void ClipPathLayer::UpdateScene(SceneUpdateContext& context,
@@ -33,10 +47,18 @@ void ClipPathLayer::UpdateScene(SceneUpdateContext& context,
 
 #endif  // defined(OS_FUCHSIA)
 
+bool ClipPathLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  return clip_path_ == static_cast<const ClipPathLayer&>(old_layer).clip_path_;
+}
+
 void ClipPathLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ClipPathLayer::Paint");
   FTL_DCHECK(!needs_system_composite());
 
+  // The subtree was fully clipped away during preroll.
+  if (paint_bounds().isEmpty())
+    return;
+
   Layer::AutoSaveLayer save(context, paint_bounds(), nullptr);
   context.canvas.clipPath(clip_path_, true);
   PaintChildren(context);
@@ -17,7 +17,11 @@ class ClipPathLayer : public ContainerLayer {
   void set_clip_path(const SkPath& clip_path) { clip_path_ = clip_path; }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
 #if defined(OS_FUCHSIA)
@@ -11,17 +11,40 @@
 
 namespace flow {
 
-ClipRectLayer::ClipRectLayer() {}
+ClipRectLayer::ClipRectLayer() : ContainerLayer(Type::kClipRect) {}
 
 ClipRectLayer::~ClipRectLayer() {}
 
 void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  const SkRect previous_cull_rect = context->cull_rect;
+  if (!context->cull_rect.intersect(clip_rect_))
+    context->cull_rect.setEmpty();
   PrerollChildren(context, matrix);
+  context->cull_rect = previous_cull_rect;
   if (!context->child_paint_bounds.intersect(clip_rect_))
     context->child_paint_bounds.setEmpty();
   set_paint_bounds(context->child_paint_bounds);
 }
 
+void ClipRectLayer::PrerollOcclusion(OcclusionContext* context,
+                                     const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // Children may only claim opacity within the clip, and only when the clip
+  // remains an axis-aligned device-space rectangle under the CTM.
+  SkRect saved_clip = context->contribution_clip;
+  SkRect device_clip = SkRect::MakeEmpty();
+  if (matrix.rectStaysRect()) {
+    matrix.mapRect(&device_clip, clip_rect_);
+    if (!device_clip.intersect(saved_clip))
+      device_clip.setEmpty();
+  }
+  context->contribution_clip = device_clip;
+  PrerollOcclusionChildren(context, matrix);
+  context->contribution_clip = saved_clip;
+}
+
 #if defined(OS_FUCHSIA)
 
 void ClipRectLayer::UpdateScene(SceneUpdateContext& context,
@@ -33,10 +56,18 @@ void ClipRectLayer::UpdateScene(SceneUpdateContext& context,
 
 #endif  // defined(OS_FUCHSIA)
 
+bool ClipRectLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  return clip_rect_ == static_cast<const ClipRectLayer&>(old_layer).clip_rect_;
+}
+
 void ClipRectLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ClipRectLayer::Paint");
   FTL_DCHECK(!needs_system_composite());
 
+  // The subtree was fully clipped away during preroll.
+  if (paint_bounds().isEmpty())
+    return;
+
   SkAutoCanvasRestore save(&context.canvas, true);
   context.canvas.clipRect(paint_bounds());
   PaintChildren(context);
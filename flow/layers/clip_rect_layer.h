@@ -17,7 +17,11 @@ class ClipRectLayer : public ContainerLayer {
   void set_clip_rect(const SkRect& clip_rect) { clip_rect_ = clip_rect; }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
 #if defined(OS_FUCHSIA)
@@ -11,17 +11,31 @@
 
 namespace flow {
 
-ClipRRectLayer::ClipRRectLayer() {}
+ClipRRectLayer::ClipRRectLayer() : ContainerLayer(Type::kClipRRect) {}
 
 ClipRRectLayer::~ClipRRectLayer() {}
 
 void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  const SkRect previous_cull_rect = context->cull_rect;
+  if (!context->cull_rect.intersect(clip_rrect_.getBounds()))
+    context->cull_rect.setEmpty();
   PrerollChildren(context, matrix);
+  context->cull_rect = previous_cull_rect;
   if (!context->child_paint_bounds.intersect(clip_rrect_.getBounds()))
     context->child_paint_bounds.setEmpty();
   set_paint_bounds(context->child_paint_bounds);
 }
 
+void ClipRRectLayer::PrerollOcclusion(OcclusionContext* context,
+                                      const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // The rounded corners carve pixels out of anything the children draw, so
+  // they may not claim opacity.
+  PrerollOcclusionChildrenWithoutContribution(context, matrix);
+}
+
 #if defined(OS_FUCHSIA)
 
 void ClipRRectLayer::UpdateScene(SceneUpdateContext& context,
@@ -33,10 +47,19 @@ void ClipRRectLayer::UpdateScene(SceneUpdateContext& context,
 
 #endif  // defined(OS_FUCHSIA)
 
+bool ClipRRectLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  return clip_rrect_ ==
+         static_cast<const ClipRRectLayer&>(old_layer).clip_rrect_;
+}
+
 void ClipRRectLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ClipRRectLayer::Paint");
   FTL_DCHECK(!needs_system_composite());
 
+  // The subtree was fully clipped away during preroll.
+  if (paint_bounds().isEmpty())
+    return;
+
   Layer::AutoSaveLayer save(context, paint_bounds(), nullptr);
   context.canvas.clipRRect(clip_rrect_, true);
   PaintChildren(context);
@@ -17,7 +17,11 @@ class ClipRRectLayer : public ContainerLayer {
   void set_clip_rrect(const SkRRect& clip_rrect) { clip_rrect_ = clip_rrect; }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
 #if defined(OS_FUCHSIA)
@@ -6,19 +6,53 @@
 
 namespace flow {
 
-ColorFilterLayer::ColorFilterLayer() {}
+ColorFilterLayer::ColorFilterLayer() : ContainerLayer(Type::kColorFilter) {}
 
 ColorFilterLayer::~ColorFilterLayer() {}
 
+bool ColorFilterLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  const ColorFilterLayer& old_filter =
+      static_cast<const ColorFilterLayer&>(old_layer);
+  return color_ == old_filter.color_ && blend_mode_ == old_filter.blend_mode_;
+}
+
+void ColorFilterLayer::PrerollOcclusion(OcclusionContext* context,
+                                        const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // Depending on the blend mode the filter can reduce the children's alpha.
+  PrerollOcclusionChildrenWithoutContribution(context, matrix);
+}
+
 void ColorFilterLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ColorFilterLayer::Paint");
   sk_sp<SkColorFilter> color_filter =
       SkColorFilter::MakeModeFilter(color_, blend_mode_);
+
+  // Fuse a chain of nested color filters into one composed filter so the
+  // whole chain costs a single saveLayer instead of one per link. A link is
+  // fusable when the filter is this container's only child: the composed
+  // filter then applies to exactly the content the chain would have
+  // produced.
+  const ColorFilterLayer* innermost = this;
+  while (innermost->layers().size() == 1 &&
+         innermost->layers().front()->type() == Type::kColorFilter) {
+    const ColorFilterLayer* child =
+        static_cast<const ColorFilterLayer*>(innermost->layers().front().get());
+    color_filter = SkColorFilter::MakeComposeFilter(
+        std::move(color_filter),
+        SkColorFilter::MakeModeFilter(child->color_, child->blend_mode_));
+    innermost = child;
+  }
+  if (innermost != this && innermost->is_occluded())
+    return;
+
   SkPaint paint;
   paint.setColorFilter(std::move(color_filter));
 
-  Layer::AutoSaveLayer(context, paint_bounds(), nullptr);
-  PaintChildren(context);
+  Layer::AutoSaveLayer save(context, paint_bounds(), &paint);
+  innermost->PaintChildren(context);
 }
 
 }  // namespace flow
@@ -19,6 +19,10 @@ class ColorFilterLayer : public ContainerLayer {
   void set_blend_mode(SkBlendMode blend_mode) { blend_mode_ = blend_mode; }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
  private:
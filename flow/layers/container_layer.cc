@@ -4,14 +4,102 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
+
+#include "flutter/flow/damage_area.h"
+#include "flutter/flow/frame_budget_monitor.h"
+#include "flutter/fml/thread.h"
+#include "lib/ftl/synchronization/waitable_event.h"
+#include "lib/ftl/time/time_point.h"
+
 namespace flow {
 
-ContainerLayer::ContainerLayer() {
+namespace {
+
+// Sibling subtrees are only fanned out to the workers when there are enough
+// of them to amortize the posting and join overhead.
+const size_t kMinLayersForParallelPreroll = 4;
+
+const size_t kPrerollWorkerCount = 2;
+
+fml::Thread* PrerollWorker(size_t index) {
+  static std::vector<std::unique_ptr<fml::Thread>>* workers = []() {
+    auto* threads = new std::vector<std::unique_ptr<fml::Thread>>();
+    for (size_t i = 0; i < kPrerollWorkerCount; i++) {
+      threads->emplace_back(std::make_unique<fml::Thread>(
+          "io.flutter.preroll_worker." + std::to_string(i + 1)));
+    }
+    return threads;
+  }();
+  return (*workers)[index % kPrerollWorkerCount].get();
+}
+
+}  // namespace
+
+ContainerLayer::ContainerLayer(Type type) : Layer(type) {
   ctm_.setIdentity();
 }
 
 ContainerLayer::~ContainerLayer() {}
 
+bool ContainerLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  return true;
+}
+
+void ContainerLayer::ComputeChildrenDamage(const ContainerLayer& old_layer,
+                                           DamageArea& damage) const {
+  const auto& old_layers = old_layer.layers();
+  size_t common = std::min(layers_.size(), old_layers.size());
+  for (size_t i = 0; i < common; i++) {
+    layers_[i]->ComputeDamage(old_layers[i].get(), damage);
+  }
+  // Children present in only one of the trees are damage in their entirety.
+  for (size_t i = common; i < layers_.size(); i++) {
+    damage.AddRect(layers_[i]->paint_bounds());
+  }
+  for (size_t i = common; i < old_layers.size(); i++) {
+    if (old_layers[i]->has_paint_bounds()) {
+      damage.AddRect(old_layers[i]->paint_bounds());
+    }
+  }
+}
+
+bool ContainerLayer::Compare(const Layer& old_layer) const {
+  if (old_layer.type() != type()) {
+    return false;
+  }
+  const ContainerLayer& old_container =
+      static_cast<const ContainerLayer&>(old_layer);
+  if (!PropertiesEqual(old_container)) {
+    return false;
+  }
+  const auto& old_layers = old_container.layers();
+  if (layers_.size() != old_layers.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < layers_.size(); i++) {
+    if (!layers_[i]->Compare(*old_layers[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ContainerLayer::ComputeDamage(const Layer* old_layer,
+                                   DamageArea& damage) const {
+  if (old_layer == nullptr || old_layer->type() != type()) {
+    Layer::ComputeDamage(old_layer, damage);
+    return;
+  }
+  const ContainerLayer& old_container =
+      static_cast<const ContainerLayer&>(*old_layer);
+  if (!PropertiesEqual(old_container)) {
+    Layer::ComputeDamage(old_layer, damage);
+    return;
+  }
+  ComputeChildrenDamage(old_container, damage);
+}
+
 void ContainerLayer::Add(std::unique_ptr<Layer> layer) {
   layer->set_parent(this);
   layers_.push_back(std::move(layer));
@@ -25,6 +113,11 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      const SkMatrix& matrix) {
+  if (context->parallel_mode && context->allow_parallel_fan_out &&
+      layers_.size() >= kMinLayersForParallelPreroll) {
+    PrerollChildrenInParallel(context, matrix);
+    return;
+  }
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   for (auto& layer : layers_) {
     PrerollContext child_context = *context;
@@ -40,12 +133,99 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     ctm_ = matrix;
 }
 
+void ContainerLayer::PrerollChildrenInParallel(PrerollContext* context,
+                                               const SkMatrix& matrix) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenInParallel");
+
+  struct PrerollTask {
+    PrerollContext context;
+    std::vector<Layer*> raster_cache_candidates;
+    ftl::AutoResetWaitableEvent done;
+  };
+
+  std::vector<PrerollTask> tasks(layers_.size());
+  for (size_t i = 0; i < layers_.size(); i++) {
+    PrerollTask& task = tasks[i];
+    task.context = {context->raster_cache, context->gr_context,
+                    SkRect::MakeEmpty(),  context->cull_rect,
+                    true,                 false,
+                    &task.raster_cache_candidates};
+    Layer* layer = layers_[i].get();
+    PrerollWorker(i)->GetTaskRunner()->PostTask([&task, layer, matrix]() {
+      layer->Preroll(&task.context, matrix);
+      task.done.Signal();
+    });
+  }
+
+  SkRect child_paint_bounds = SkRect::MakeEmpty();
+  for (size_t i = 0; i < layers_.size(); i++) {
+    PrerollTask& task = tasks[i];
+    task.done.Wait();
+    child_paint_bounds.join(task.context.child_paint_bounds);
+    if (layers_[i]->needs_system_composite()) {
+      set_needs_system_composite(true);
+    }
+    if (context->raster_cache_candidates) {
+      context->raster_cache_candidates->insert(
+          context->raster_cache_candidates->end(),
+          task.raster_cache_candidates.begin(),
+          task.raster_cache_candidates.end());
+    }
+  }
+  context->child_paint_bounds = child_paint_bounds;
+
+  if (needs_system_composite()) {
+    ctm_ = matrix;
+  }
+}
+
+void ContainerLayer::PrerollOcclusion(OcclusionContext* context,
+                                      const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded()) {
+    // The subtree is skipped wholesale at paint time; no need to visit it.
+    return;
+  }
+  PrerollOcclusionChildren(context, matrix);
+}
+
+void ContainerLayer::PrerollOcclusionChildren(OcclusionContext* context,
+                                              const SkMatrix& matrix) {
+  // Paint order is back to front, so the occlusion pass walks the children
+  // in reverse: a child only ever tests against opaque content that will be
+  // drawn on top of it.
+  for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+    (*it)->PrerollOcclusion(context, matrix);
+  }
+}
+
+void ContainerLayer::PrerollOcclusionChildrenWithoutContribution(
+    OcclusionContext* context,
+    const SkMatrix& matrix) {
+  SkRect saved_clip = context->contribution_clip;
+  context->contribution_clip = SkRect::MakeEmpty();
+  PrerollOcclusionChildren(context, matrix);
+  context->contribution_clip = saved_clip;
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   FTL_DCHECK(!needs_system_composite());
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
-  for (auto& layer : layers_)
-    layer->Paint(context);
+  const bool capture_timings =
+      context.budget_monitor && context.budget_monitor->capture_active();
+  for (auto& layer : layers_) {
+    if (layer->is_occluded())
+      continue;
+    if (capture_timings) {
+      const ftl::TimePoint paint_start = ftl::TimePoint::Now();
+      layer->Paint(context);
+      context.budget_monitor->AddLayerPaint(*layer,
+                                            ftl::TimePoint::Now() - paint_start);
+    } else {
+      layer->Paint(context);
+    }
+  }
 }
 
 #if defined(OS_FUCHSIA)
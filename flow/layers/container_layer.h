@@ -12,13 +12,26 @@ namespace flow {
 
 class ContainerLayer : public Layer {
  public:
-  ContainerLayer();
+  explicit ContainerLayer(Type type = Type::kContainer);
   ~ContainerLayer() override;
 
   void Add(std::unique_ptr<Layer> layer);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void PrerollChildren(PrerollContext* context, const SkMatrix& matrix);
+  void PrerollChildrenInParallel(PrerollContext* context,
+                                 const SkMatrix& matrix);
+
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
+  void PrerollOcclusionChildren(OcclusionContext* context,
+                                const SkMatrix& matrix);
+  // Like PrerollOcclusionChildren() but prevents the children from adding to
+  // the opaque accumulator, for containers that alter their children's
+  // pixels (opacity, filters, masks) or clip them to a non-rectangular
+  // shape. The children are still visited so they can be marked occluded.
+  void PrerollOcclusionChildrenWithoutContribution(OcclusionContext* context,
+                                                   const SkMatrix& matrix);
 
   void PaintChildren(PaintContext& context) const;
 
@@ -34,6 +47,21 @@ class ContainerLayer : public Layer {
 
   const std::vector<std::unique_ptr<Layer>>& layers() const { return layers_; }
 
+  void ComputeDamage(const Layer* old_layer, DamageArea& damage) const override;
+
+  bool Compare(const Layer& old_layer) const override;
+
+ protected:
+  // Returns true if this layer's own properties (not its children) would
+  // produce the same output as |old_layer|'s. Subclasses with paint-affecting
+  // state must override this for damage tracking to consider that state.
+  virtual bool PropertiesEqual(const ContainerLayer& old_layer) const;
+
+  // Pairwise damage of this layer's children against |old_layer|'s children,
+  // in the children's coordinate space.
+  void ComputeChildrenDamage(const ContainerLayer& old_layer,
+                             DamageArea& damage) const;
+
  protected:
   // Valid only after preroll when needs_system_composite() is true.
   const SkMatrix& ctm() const { return ctm_; }
@@ -0,0 +1,71 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/container_layer.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flow {
+namespace {
+
+// A leaf with fixed paint bounds and no rasterization.
+class TestLayer : public Layer {
+ public:
+  explicit TestLayer(const SkRect& bounds)
+      : Layer(Type::kContainer), bounds_(bounds) {}
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override {
+    set_paint_bounds(bounds_);
+    context->child_paint_bounds = bounds_;
+  }
+
+  void Paint(PaintContext& context) override {}
+
+ private:
+  SkRect bounds_;
+};
+
+class TestContainerLayer : public ContainerLayer {
+ public:
+  void Paint(PaintContext& context) override { PaintChildren(context); }
+};
+
+TEST(ContainerLayerTest, NestedParallelPrerollDoesNotDeadlock) {
+  // Regression test: a wide container prerolled on one of the two preroll
+  // workers used to fan its own children back out onto the same fixed pool —
+  // including a task posted to the loop it was running on — and then block
+  // joining it, deadlocking on a plain 4x4 tree.
+  auto root = std::make_unique<TestContainerLayer>();
+  for (int i = 0; i < 4; i++) {
+    auto inner = std::make_unique<TestContainerLayer>();
+    for (int j = 0; j < 4; j++) {
+      inner->Add(std::make_unique<TestLayer>(
+          SkRect::MakeXYWH(i * 100, j * 100, 50, 50)));
+    }
+    root->Add(std::move(inner));
+  }
+
+  std::vector<Layer*> raster_cache_candidates;
+  Layer::PrerollContext context = {
+      nullptr,
+      nullptr,
+      SkRect::MakeEmpty(),
+      SkRect::MakeLargest(),
+      true,
+      true,
+      &raster_cache_candidates,
+  };
+  root->Preroll(&context, SkMatrix::I());
+
+  EXPECT_EQ(SkRect::MakeLTRB(0, 0, 350, 350), root->paint_bounds());
+  EXPECT_TRUE(raster_cache_candidates.empty());
+}
+
+}  // namespace
+}  // namespace flow
@@ -4,14 +4,34 @@
 
 #include "flutter/flow/layers/layer.h"
 
+#include <atomic>
+
+#include "flutter/flow/damage_area.h"
+#include "flutter/flow/layer_arena.h"
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 
 namespace flow {
 
-Layer::Layer()
-    : parent_(nullptr),
+void* Layer::operator new(size_t size) {
+  return LayerArena::AllocateLayer(size);
+}
+
+void Layer::operator delete(void* ptr) {
+  LayerArena::FreeLayer(ptr);
+}
+
+uint64_t Layer::NextUniqueID() {
+  static std::atomic<uint64_t> next_id(1);
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+Layer::Layer(Type type)
+    : type_(type),
+      unique_id_(NextUniqueID()),
+      parent_(nullptr),
       needs_system_composite_(false),
+      occluded_(false),
       has_paint_bounds_(false),
       paint_bounds_() {}
 
@@ -23,6 +43,62 @@ void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   }
 }
 
+void Layer::UpdateRasterCache(RasterCache* cache, GrContext* gr_context) {}
+
+bool Layer::OcclusionContext::Occludes(const SkRect& device_bounds) const {
+  for (const SkRect& rect : opaque_rects) {
+    if (rect.contains(device_bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Layer::OcclusionContext::AddOpaqueRect(SkRect device_rect) {
+  if (!device_rect.intersect(contribution_clip)) {
+    return;
+  }
+  for (SkRect& rect : opaque_rects) {
+    if (device_rect.contains(rect)) {
+      rect = device_rect;
+      return;
+    }
+    if (rect.contains(device_rect)) {
+      return;
+    }
+  }
+  if (opaque_rects.size() < kMaxOpaqueRects) {
+    opaque_rects.push_back(device_rect);
+  }
+}
+
+void Layer::PrerollOcclusion(OcclusionContext* context, const SkMatrix& matrix) {
+  occluded_ = false;
+  if (!has_paint_bounds_ || paint_bounds_.isEmpty()) {
+    return;
+  }
+  SkRect device_bounds;
+  matrix.mapRect(&device_bounds, paint_bounds_);
+  if (context->Occludes(device_bounds)) {
+    occluded_ = true;
+    context->layers_culled++;
+  }
+}
+
+bool Layer::Compare(const Layer& old_layer) const {
+  return false;
+}
+
+void Layer::ComputeDamage(const Layer* old_layer, DamageArea& damage) const {
+  // Without more specific knowledge, assume everything either layer might
+  // have drawn needs repainting.
+  SkRect bounds = paint_bounds();
+  if (old_layer != nullptr && old_layer->has_paint_bounds()) {
+    bounds.join(old_layer->paint_bounds());
+  }
+  damage.AddRect(bounds);
+}
+
 #if defined(OS_FUCHSIA)
 void Layer::UpdateScene(SceneUpdateContext& context, mozart::Node* container) {}
 #endif
@@ -26,26 +26,111 @@
 
 namespace flow {
 class ContainerLayer;
+class DamageArea;
+class FrameBudgetMonitor;
 
 class Layer {
  public:
-  Layer();
+  // Identifies the concrete layer class so frame-to-frame comparisons can
+  // avoid RTTI.
+  enum class Type {
+    kContainer,
+    kPicture,
+    kTiledPicture,
+    kTransform,
+    kOpacity,
+    kClipRect,
+    kClipRRect,
+    kClipPath,
+    kColorFilter,
+    kShaderMask,
+    kBackdropFilter,
+    kPhysicalModel,
+    kPerformanceOverlay,
+    kChildScene,
+  };
+
+  explicit Layer(Type type);
   virtual ~Layer();
 
+  // Layers are bump-allocated from the current LayerArena when one is
+  // installed on the constructing thread; deletion of arena-backed layers
+  // only runs the destructor.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   struct PrerollContext {
     RasterCache* raster_cache;
     GrContext* gr_context;
     SkRect child_paint_bounds;
+    // Running intersection of ancestor clips, in the current layer's
+    // coordinate space. Subtrees whose bounds fall entirely outside of it
+    // are culled: they skip raster cache admission and their clip ancestors
+    // skip painting them altogether.
+    SkRect cull_rect = SkRect::MakeLargest();
+    // True while sibling subtrees are being prerolled on worker threads.
+    // Layers must not touch shared mutable state (such as the raster cache)
+    // in this mode; instead they record themselves in
+    // |raster_cache_candidates| for a serial pass once the workers join.
+    bool parallel_mode = false;
+    // Whether a wide container may fan its children out to the preroll
+    // workers. Cleared in the contexts handed to the workers themselves: the
+    // pool is fixed-size and a worker that fanned out again could post a
+    // task to its own loop and then block joining it, which deadlocks.
+    bool allow_parallel_fan_out = true;
+    std::vector<Layer*>* raster_cache_candidates = nullptr;
   };
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
+  // Serial follow-up pass for layers that recorded themselves in
+  // PrerollContext::raster_cache_candidates during a parallel preroll.
+  virtual void UpdateRasterCache(RasterCache* cache, GrContext* gr_context);
+
+  // State threaded through the front-to-back occlusion pass that runs after
+  // preroll. |opaque_rects| holds device-space rects known to be fully
+  // covered by opaque content drawn in front of the layer currently being
+  // visited; a layer whose device-space paint bounds fall entirely inside
+  // any one of them is marked occluded and skipped at paint time.
+  struct OcclusionContext {
+    // Capped so the containment test stays a handful of comparisons.
+    static const size_t kMaxOpaqueRects = 4;
+
+    std::vector<SkRect> opaque_rects;
+    // Running device-space region within which descendants may contribute
+    // opaque rects. Clip layers shrink it; layers that modify their
+    // children's pixels (opacity, color filters, masks) empty it.
+    SkRect contribution_clip = SkRect::MakeLargest();
+    int layers_culled = 0;
+
+    bool Occludes(const SkRect& device_bounds) const;
+    void AddOpaqueRect(SkRect device_rect);
+  };
+
+  // Visits this layer during the occlusion pass. Layers are visited in
+  // reverse paint order (front to back) with |matrix| holding the same CTM
+  // their Preroll() received. The default implementation only tests this
+  // layer's bounds for occlusion; subclasses that draw opaque content
+  // contribute to the accumulator instead of relying on the default.
+  virtual void PrerollOcclusion(OcclusionContext* context,
+                                const SkMatrix& matrix);
+
   struct PaintContext {
     SkCanvas& canvas;
     const Stopwatch& frame_time;
     const Stopwatch& engine_time;
+    const Stopwatch& gpu_time;
     const CounterValues& memory_usage;
     const bool checkerboard_offscreen_layers;
+    // The tree's damage against the previous frame (in root space), when the
+    // embedder computed it. Layers may use it to reuse work whose inputs lie
+    // outside the damaged region; when |frame_damage_known| is false they
+    // must assume everything changed.
+    const bool frame_damage_known = false;
+    const SkRect frame_damage = SkRect::MakeEmpty();
+    // When set and its capture is active, ContainerLayer::PaintChildren
+    // records per-layer paint timings into it. See FrameBudgetMonitor.
+    FrameBudgetMonitor* budget_monitor = nullptr;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -68,15 +153,41 @@ class Layer {
 
   virtual void Paint(PaintContext& context) = 0;
 
+  // Adds to |damage| a conservative estimate of the region this layer draws
+  // differently from |old_layer|, the corresponding layer in the previous
+  // frame's tree (which may be null). Both trees must have been prerolled.
+  // The rects are in the same coordinate space as paint_bounds(). Keeping
+  // the damage as a set of rects rather than one bounding box lets widely
+  // separated changes stay separate all the way to the repaint clip.
+  virtual void ComputeDamage(const Layer* old_layer, DamageArea& damage) const;
+
+  // Returns true if this layer (and its subtree, if any) is guaranteed to
+  // draw identical content to |old_layer| from the previous frame's tree.
+  // Unlike ComputeDamage(), this does not require prerolled bounds and may
+  // be used to skip rasterization of an unchanged scene entirely. The
+  // default is conservatively false.
+  virtual bool Compare(const Layer& old_layer) const;
+
 #if defined(OS_FUCHSIA)
   virtual void UpdateScene(SceneUpdateContext& context,
                            mozart::Node* container);
 #endif
 
+  Type type() const { return type_; }
+
+  // Process-unique, stable identity for this layer instance, for use by
+  // retained-rendering bookkeeping and tracing.
+  uint64_t unique_id() const { return unique_id_; }
+
   ContainerLayer* parent() const { return parent_; }
 
   void set_parent(ContainerLayer* parent) { parent_ = parent; }
 
+  // True if the occlusion pass determined that this layer (and therefore its
+  // subtree) is entirely covered by opaque content drawn in front of it.
+  // Valid between PrerollOcclusion() and Paint().
+  bool is_occluded() const { return occluded_; }
+
   bool needs_system_composite() const { return needs_system_composite_; }
   void set_needs_system_composite(bool value) {
     needs_system_composite_ = value;
@@ -96,8 +207,13 @@ class Layer {
   }
 
  private:
+  static uint64_t NextUniqueID();
+
+  const Type type_;
+  const uint64_t unique_id_;
   ContainerLayer* parent_;
   bool needs_system_composite_;
+  bool occluded_;
   bool has_paint_bounds_;  // if false, paint_bounds_ is not valid
   SkRect paint_bounds_;
 
@@ -5,16 +5,21 @@
 #include "flutter/flow/layers/layer_tree.h"
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/sampling_profiler.h"
 #include "flutter/glue/trace_event.h"
+#include "third_party/skia/include/core/SkRegion.h"
 
 namespace flow {
 
 LayerTree::LayerTree()
     : frame_size_{},
       scene_version_(0),
+      has_damage_(false),
+      damage_(SkRect::MakeEmpty()),
       rasterizer_tracing_threshold_(0),
       checkerboard_raster_cache_images_(false),
-      checkerboard_offscreen_layers_(false) {}
+      checkerboard_offscreen_layers_(false),
+      parallel_preroll_(false) {}
 
 LayerTree::~LayerTree() {}
 
@@ -27,13 +32,38 @@ void LayerTree::Raster(CompositorContext::ScopedFrame& frame,
 void LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache) {
   TRACE_EVENT0("flutter", "LayerTree::Preroll");
+  FML_PROFILER_HOT_FUNCTION("LayerTree::Preroll");
   frame.context().raster_cache().SetCheckboardCacheImages(
       checkerboard_raster_cache_images_);
+  RasterCache* raster_cache =
+      ignore_raster_cache ? nullptr : &frame.context().raster_cache();
+  std::vector<Layer*> raster_cache_candidates;
   Layer::PrerollContext context = {
-      ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
-      frame.gr_context(), SkRect::MakeEmpty(),
+      raster_cache,
+      frame.gr_context(),
+      SkRect::MakeEmpty(),
+      SkRect::MakeIWH(frame_size_.width(), frame_size_.height()),
+      parallel_preroll_,
+      true,
+      &raster_cache_candidates,
   };
   root_layer_->Preroll(&context, SkMatrix::I());
+
+  if (raster_cache != nullptr) {
+    for (Layer* layer : raster_cache_candidates) {
+      layer->UpdateRasterCache(raster_cache, frame.gr_context());
+    }
+  }
+
+  // Front-to-back companion pass: mark layers wholly covered by opaque
+  // content (a full-screen video surface, a modal panel) so that Paint()
+  // skips rasterizing them.
+  Layer::OcclusionContext occlusion_context;
+  root_layer_->PrerollOcclusion(&occlusion_context, SkMatrix::I());
+  // A zero-length event whose argument surfaces the per-frame cull count in
+  // the timeline.
+  TRACE_EVENT1("flutter", "LayerTree::OcclusionCull", "culled_layers",
+               occlusion_context.layers_culled);
 }
 
 #if defined(OS_FUCHSIA)
@@ -50,12 +80,56 @@ void LayerTree::UpdateScene(SceneUpdateContext& context,
 }
 #endif
 
+bool LayerTree::Compare(const LayerTree& old_tree) const {
+  if (frame_size_ != old_tree.frame_size_ || root_layer_ == nullptr ||
+      old_tree.root_layer_ == nullptr) {
+    return false;
+  }
+  return root_layer_->Compare(*old_tree.root_layer_);
+}
+
+DamageArea LayerTree::ComputeDamage(const LayerTree& old_tree) const {
+  SkRect full_frame =
+      SkRect::MakeIWH(frame_size_.width(), frame_size_.height());
+  DamageArea damage;
+  if (frame_size_ != old_tree.frame_size_ || root_layer_ == nullptr ||
+      old_tree.root_layer_ == nullptr) {
+    damage.AddRect(full_frame);
+    return damage;
+  }
+  root_layer_->ComputeDamage(old_tree.root_layer_.get(), damage);
+  damage.Intersect(full_frame);
+  return damage;
+}
+
 void LayerTree::Paint(CompositorContext::ScopedFrame& frame) {
+  FML_PROFILER_HOT_FUNCTION("LayerTree::Paint");
   Layer::PaintContext context = {frame.canvas(), frame.context().frame_time(),
                                  frame.context().engine_time(),
+                                 frame.context().gpu_time(),
                                  frame.context().memory_usage(),
-                                 checkerboard_offscreen_layers_};
+                                 checkerboard_offscreen_layers_,
+                                 has_damage_,
+                                 damage_,
+                                 &frame.context().budget_monitor()};
   TRACE_EVENT0("flutter", "LayerTree::Paint");
+  SkAutoCanvasRestore save(&frame.canvas(), true);
+  if (has_damage_) {
+    if (damage_area_.rects().size() > 1) {
+      // clipRegion works in integer device space, which is the coordinate
+      // space of a root-level clip anyway; the rects are rounded outward so
+      // no damaged pixel is clipped away.
+      SkRegion clip;
+      for (const SkRect& rect : damage_area_.rects()) {
+        SkIRect device_rect;
+        rect.roundOut(&device_rect);
+        clip.op(device_rect, SkRegion::kUnion_Op);
+      }
+      frame.canvas().clipRegion(clip);
+    } else {
+      frame.canvas().clipRect(damage_);
+    }
+  }
   root_layer_->Paint(context);
 }
 
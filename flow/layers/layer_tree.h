@@ -10,9 +10,12 @@
 #include <memory>
 
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/damage_area.h"
+#include "flutter/flow/layer_arena.h"
 #include "flutter/flow/layers/layer.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flow {
@@ -39,12 +42,54 @@ class LayerTree {
 
   void Paint(CompositorContext::ScopedFrame& frame);
 
+  // Returns true if rasterizing this tree is guaranteed to produce the same
+  // pixels as |old_tree|, in which case the rasterizer may reuse the
+  // previously presented frame and skip paint entirely.
+  bool Compare(const LayerTree& old_tree) const;
+
+  // Computes a conservative estimate of the region that differs from
+  // |old_tree|, the tree rasterized for the previous frame. Both trees must
+  // have been prerolled. Returns the full frame when the trees cannot be
+  // meaningfully compared (e.g. on resize). The region keeps widely
+  // separated changes as separate rects, so scattered small updates do not
+  // collapse into a near-full-frame bounding box.
+  DamageArea ComputeDamage(const LayerTree& old_tree) const;
+
+  // Restricts the next Paint() to |damage|. Painting is clipped to the
+  // region's rects and the caller may forward its bounds to the surface as
+  // a swap-with-damage hint.
+  void set_damage(const DamageArea& damage) {
+    has_damage_ = true;
+    damage_area_ = damage;
+    damage_ = damage.Bounds();
+  }
+
+  void set_damage(const SkRect& damage) {
+    has_damage_ = true;
+    damage_area_.Clear();
+    damage_area_.AddRect(damage);
+    damage_ = damage;
+  }
+
+  bool has_damage() const { return has_damage_; }
+
+  // The bounding box of the damage region.
+  const SkRect& damage() const { return damage_; }
+
+  const DamageArea& damage_area() const { return damage_area_; }
+
   Layer* root_layer() const { return root_layer_.get(); }
 
   void set_root_layer(std::unique_ptr<Layer> root_layer) {
     root_layer_ = std::move(root_layer);
   }
 
+  // Takes ownership of the arena backing this tree's layers. The arena must
+  // outlive the layers, so it is destroyed after |root_layer_|.
+  void set_arena(std::unique_ptr<LayerArena> arena) {
+    arena_ = std::move(arena);
+  }
+
   const SkISize& frame_size() const { return frame_size_; }
 
   void set_frame_size(const SkISize& frame_size) { frame_size_ = frame_size; }
@@ -61,6 +106,21 @@ class LayerTree {
 
   const ftl::TimeDelta& construction_time() const { return construction_time_; }
 
+  // Timestamps for the frame timing stream surfaced to the framework: the
+  // vsync this frame targeted and when its build began on the UI thread. The
+  // build end is |frame_build_start() + construction_time()|.
+  void set_frame_target_time(ftl::TimePoint time) {
+    frame_target_time_ = time;
+  }
+
+  ftl::TimePoint frame_target_time() const { return frame_target_time_; }
+
+  void set_frame_build_start(ftl::TimePoint time) {
+    frame_build_start_ = time;
+  }
+
+  ftl::TimePoint frame_build_start() const { return frame_build_start_; }
+
   // The number of frame intervals missed after which the compositor must
   // trace the rasterized picture to a trace file. Specify 0 to disable all
   // tracing
@@ -80,14 +140,28 @@ class LayerTree {
     checkerboard_offscreen_layers_ = checkerboard;
   }
 
+  // When enabled, Preroll fans independent sibling subtrees out to a small
+  // worker pool and performs raster cache lookups in a serial pass after the
+  // workers join.
+  void set_parallel_preroll(bool parallel) { parallel_preroll_ = parallel; }
+
  private:
   SkISize frame_size_;  // Physical pixels.
   uint32_t scene_version_;
+  bool has_damage_;
+  SkRect damage_;
+  DamageArea damage_area_;
+  // Declared before |root_layer_| so layer destructors run while their
+  // storage is still alive.
+  std::unique_ptr<LayerArena> arena_;
   std::unique_ptr<Layer> root_layer_;
   ftl::TimeDelta construction_time_;
+  ftl::TimePoint frame_target_time_;
+  ftl::TimePoint frame_build_start_;
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
+  bool parallel_preroll_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
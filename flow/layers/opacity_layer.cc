@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include "flutter/flow/layers/picture_layer.h"
+
 #if defined(OS_FUCHSIA)
 #include "apps/mozart/lib/skia/type_converters.h"
 #include "apps/mozart/services/composition/nodes.fidl.h"
@@ -11,7 +13,7 @@
 
 namespace flow {
 
-OpacityLayer::OpacityLayer() {}
+OpacityLayer::OpacityLayer() : ContainerLayer(Type::kOpacity) {}
 
 OpacityLayer::~OpacityLayer() {}
 
@@ -30,10 +32,64 @@ void OpacityLayer::UpdateScene(SceneUpdateContext& context,
 
 #endif  // defined(OS_FUCHSIA)
 
+void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  // Encourage the raster cache to admit a lone picture child: drawing the
+  // cached image with modulated alpha in Paint() is what lets us skip the
+  // saveLayer.
+  if (layers().size() == 1 && layers()[0]->type() == Type::kPicture) {
+    static_cast<PictureLayer*>(layers()[0].get())->set_is_complex(true);
+  }
+  ContainerLayer::Preroll(context, matrix);
+}
+
+void OpacityLayer::PrerollOcclusion(OcclusionContext* context,
+                                    const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // A fully opaque layer adds nothing to its children; anything less makes
+  // every descendant translucent.
+  if (alpha_ == 255) {
+    PrerollOcclusionChildren(context, matrix);
+  } else {
+    PrerollOcclusionChildrenWithoutContribution(context, matrix);
+  }
+}
+
+bool OpacityLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  return alpha_ == static_cast<const OpacityLayer&>(old_layer).alpha_;
+}
+
 void OpacityLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "OpacityLayer::Paint");
   FTL_DCHECK(!needs_system_composite());
 
+  // A fully opaque layer adds nothing to its children.
+  if (alpha_ == 255) {
+    PaintChildren(context);
+    return;
+  }
+
+  // When the only child is a picture whose rasterization is already in the
+  // raster cache, the cached image can be drawn directly with the alpha
+  // folded into the image paint, avoiding an offscreen saveLayer round trip
+  // entirely. This is the common case for fades of static content.
+  if (layers().size() == 1 && layers()[0]->type() == Type::kPicture) {
+    const PictureLayer& picture_layer =
+        static_cast<const PictureLayer&>(*layers()[0]);
+    if (SkImage* image = picture_layer.raster_cache_image()) {
+      TRACE_EVENT0("flutter", "OpacityLayer::Paint (cached image)");
+      SkPaint paint;
+      paint.setAlpha(alpha_);
+      SkAutoCanvasRestore save(&context.canvas, true);
+      const SkPoint& offset = picture_layer.offset();
+      context.canvas.translate(offset.x(), offset.y());
+      context.canvas.drawImageRect(image, picture_layer.picture()->cullRect(),
+                                   &paint, SkCanvas::kFast_SrcRectConstraint);
+      return;
+    }
+  }
+
   SkPaint paint;
   paint.setAlpha(alpha_);
 
@@ -17,6 +17,12 @@ class OpacityLayer : public ContainerLayer {
   void set_alpha(int alpha) { alpha_ = alpha; }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
 #if defined(OS_FUCHSIA)
@@ -52,7 +52,8 @@ void VisualizeStopWatch(SkCanvas& canvas,
     stream.setf(std::ios::fixed | std::ios::showpoint);
     stream << std::setprecision(1);
     stream << label_prefix << "  " << fps << " fps  " << ms_per_frame
-           << "ms/frame";
+           << "ms/frame  p95: " << stopwatch.GetLapPercentileMS(95.0)
+           << "ms  p99: " << stopwatch.GetLapPercentileMS(99.0) << "ms";
     DrawStatisticsText(canvas, stream.str(), x + label_x, y + height + label_y);
   }
 }
@@ -88,7 +89,7 @@ void VisualizeCounterValuesBytes(SkCanvas& canvas,
 }  // namespace
 
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options)
-    : options_(options) {}
+    : Layer(Type::kPerformanceOverlay), options_(options) {}
 
 void PerformanceOverlayLayer::Paint(PaintContext& context) {
   if (!options_)
@@ -101,16 +102,29 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) {
   SkScalar height = paint_bounds().height() / 2;
   SkAutoCanvasRestore save(&context.canvas, true);
 
-  VisualizeStopWatch(context.canvas, context.frame_time, x, y, width, height,
+  SkScalar row = y;
+
+  VisualizeStopWatch(context.canvas, context.frame_time, x, row, width, height,
                      options_ & kVisualizeRasterizerStatistics,
                      options_ & kDisplayRasterizerStatistics, "Rasterizer");
+  row += height;
+
+  // The GPU row only takes up space when requested so that existing overlay
+  // layouts are unaffected.
+  if (options_ & (kVisualizeGpuStatistics | kDisplayGpuStatistics)) {
+    VisualizeStopWatch(context.canvas, context.gpu_time, x, row, width, height,
+                       options_ & kVisualizeGpuStatistics,
+                       options_ & kDisplayGpuStatistics, "GPU");
+    row += height;
+  }
 
-  VisualizeStopWatch(context.canvas, context.engine_time, x, y + height, width,
-                     height, options_ & kVisualizeEngineStatistics,
+  VisualizeStopWatch(context.canvas, context.engine_time, x, row, width, height,
+                     options_ & kVisualizeEngineStatistics,
                      options_ & kDisplayEngineStatistics, "Engine");
+  row += height;
 
   VisualizeCounterValuesBytes(
-      context.canvas, context.memory_usage, x, y + (2 * height), width, height,
+      context.canvas, context.memory_usage, x, row, width, height,
       options_ & kVisualizeMemoryStatistics,
       options_ & kDisplayMemoryStatistics, "Memory (Resident)");
 }
@@ -16,6 +16,8 @@ const int kDisplayEngineStatistics = 1 << 2;
 const int kVisualizeEngineStatistics = 1 << 3;
 const int kDisplayMemoryStatistics = 1 << 4;
 const int kVisualizeMemoryStatistics = 1 << 5;
+const int kDisplayGpuStatistics = 1 << 6;
+const int kVisualizeGpuStatistics = 1 << 7;
 
 class PerformanceOverlayLayer : public Layer {
  public:
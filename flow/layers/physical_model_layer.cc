@@ -4,7 +4,13 @@
 
 #include "flutter/flow/layers/physical_model_layer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "flutter/flow/paint_utils.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
 #if defined(OS_FUCHSIA)
@@ -14,8 +20,87 @@
 
 namespace flow {
 
+namespace {
+
+// Margin Preroll reserves around the rrect for the shadow; a cached shadow
+// image covers the rrect bounds outset by this much.
+const SkScalar kShadowMargin = 20.0f;
+
+// The shadow a physical model casts is a pure function of its shape, its
+// elevation, its color, and the device scale it is drawn at: the light in
+// DrawShadow() is positioned relative to the path's bounds, so translating
+// the model does not change its shadow. Scrolling lists redraw the same
+// shadows at new offsets every frame, which made elevation shadows one of
+// the largest recurring GPU costs; this cache rasterizes each distinct
+// shadow once and replays it as an image afterwards.
+struct ShadowDescription {
+  // The model's rrect translated so its bounds start at the origin, making
+  // the key position-independent.
+  SkRRect rrect;
+  SkColor color;
+  float elevation;
+  bool transparent_occluder;
+  SkScalar scale_x;
+  SkScalar scale_y;
+
+  bool operator==(const ShadowDescription& other) const {
+    return rrect == other.rrect && color == other.color &&
+           elevation == other.elevation &&
+           transparent_occluder == other.transparent_occluder &&
+           scale_x == other.scale_x && scale_y == other.scale_y;
+  }
+};
+
+// Only touched from the GPU thread during Paint, so no locking. Bounded by
+// least-recently-used eviction; a frame's worth of distinct shadows is
+// small (list items share one description).
+class ShadowRasterCache {
+ public:
+  sk_sp<SkImage> Get(const ShadowDescription& description) {
+    access_generation_++;
+    for (Entry& entry : entries_) {
+      if (entry.description == description) {
+        entry.last_used = access_generation_;
+        return entry.image;
+      }
+    }
+    return nullptr;
+  }
+
+  void Put(const ShadowDescription& description, sk_sp<SkImage> image) {
+    if (entries_.size() >= kMaxEntries) {
+      auto oldest = entries_.begin();
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->last_used < oldest->last_used)
+          oldest = it;
+      }
+      entries_.erase(oldest);
+    }
+    entries_.push_back({description, std::move(image), access_generation_});
+  }
+
+ private:
+  static const size_t kMaxEntries = 16;
+
+  struct Entry {
+    ShadowDescription description;
+    sk_sp<SkImage> image;
+    uint64_t last_used;
+  };
+
+  uint64_t access_generation_ = 0;
+  std::vector<Entry> entries_;
+};
+
+ShadowRasterCache& SharedShadowCache() {
+  static ShadowRasterCache* cache = new ShadowRasterCache();
+  return *cache;
+}
+
+}  // namespace
+
 PhysicalModelLayer::PhysicalModelLayer()
-    : rrect_(SkRRect::MakeEmpty()) {}
+    : ContainerLayer(Type::kPhysicalModel), rrect_(SkRRect::MakeEmpty()) {}
 
 PhysicalModelLayer::~PhysicalModelLayer() {}
 
@@ -32,6 +117,49 @@ void PhysicalModelLayer::Preroll(PrerollContext* context, const SkMatrix& matrix
   context->child_paint_bounds = bounds;
 }
 
+void PhysicalModelLayer::PrerollOcclusion(OcclusionContext* context,
+                                          const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+
+  // The largest axis-aligned rectangle that avoids every rounded corner and
+  // is therefore fully inside the rrect.
+  SkRect inner_rect = rrect_.rect();
+  if (!rrect_.isRect()) {
+    SkScalar inset_x = 0, inset_y = 0;
+    for (auto corner : {SkRRect::kUpperLeft_Corner, SkRRect::kUpperRight_Corner,
+                        SkRRect::kLowerRight_Corner,
+                        SkRRect::kLowerLeft_Corner}) {
+      const SkVector& radii = rrect_.radii(corner);
+      inset_x = std::max(inset_x, radii.fX);
+      inset_y = std::max(inset_y, radii.fY);
+    }
+    inner_rect.inset(inset_x, inset_y);
+  }
+
+  // The children paint on top of the color fill, clipped to the rrect; they
+  // may only claim opacity within the guaranteed-inside rectangle.
+  if (matrix.rectStaysRect() && !inner_rect.isEmpty()) {
+    SkRect device_inner_rect;
+    matrix.mapRect(&device_inner_rect, inner_rect);
+
+    SkRect saved_clip = context->contribution_clip;
+    SkRect child_clip = device_inner_rect;
+    if (!child_clip.intersect(saved_clip))
+      child_clip.setEmpty();
+    context->contribution_clip = child_clip;
+    PrerollOcclusionChildren(context, matrix);
+    context->contribution_clip = saved_clip;
+
+    // This layer's own fill occludes whatever lies behind it.
+    if (SkColorGetA(color_) == 0xff && !needs_system_composite())
+      context->AddOpaqueRect(device_inner_rect);
+  } else {
+    PrerollOcclusionChildrenWithoutContribution(context, matrix);
+  }
+}
+
 #if defined(OS_FUCHSIA)
 
 void PhysicalModelLayer::UpdateScene(SceneUpdateContext& context,
@@ -44,6 +172,14 @@ void PhysicalModelLayer::UpdateScene(SceneUpdateContext& context,
 
 #endif  // defined(OS_FUCHSIA)
 
+bool PhysicalModelLayer::PropertiesEqual(
+    const ContainerLayer& old_layer) const {
+  const PhysicalModelLayer& old_model =
+      static_cast<const PhysicalModelLayer&>(old_layer);
+  return rrect_ == old_model.rrect_ && elevation_ == old_model.elevation_ &&
+         color_ == old_model.color_;
+}
+
 void PhysicalModelLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "PhysicalModelLayer::Paint");
 
@@ -51,8 +187,10 @@ void PhysicalModelLayer::Paint(PaintContext& context) {
   path.addRRect(rrect_);
 
   if (elevation_ != 0) {
-    DrawShadow(&context.canvas, path, SK_ColorBLACK, elevation_,
-               SkColorGetA(color_) != 0xff);
+    if (!DrawCachedShadow(&context.canvas)) {
+      DrawShadow(&context.canvas, path, SK_ColorBLACK, elevation_,
+                 SkColorGetA(color_) != 0xff);
+    }
   }
 
   if (needs_system_composite())
@@ -74,6 +212,63 @@ void PhysicalModelLayer::Paint(PaintContext& context) {
     DrawCheckerboard(&context.canvas, rrect_.getBounds());
 }
 
+bool PhysicalModelLayer::DrawCachedShadow(SkCanvas* canvas) {
+  const SkMatrix& ctm = canvas->getTotalMatrix();
+  // Under rotation or perspective the cached axis-aligned image cannot be
+  // replayed faithfully; fall back to a direct draw.
+  if (!ctm.rectStaysRect())
+    return false;
+
+  SkScalar scale_x = SkScalarAbs(ctm.getScaleX());
+  SkScalar scale_y = SkScalarAbs(ctm.getScaleY());
+  if (scale_x <= 0 || scale_y <= 0)
+    return false;
+
+  const bool transparent_occluder = SkColorGetA(color_) != 0xff;
+  const SkRect bounds = rrect_.getBounds();
+
+  SkRRect normalized_rrect = rrect_;
+  normalized_rrect.offset(-bounds.left(), -bounds.top());
+  ShadowDescription description = {normalized_rrect, SK_ColorBLACK,
+                                   static_cast<float>(elevation_),
+                                   transparent_occluder, scale_x, scale_y};
+
+  ShadowRasterCache& cache = SharedShadowCache();
+  sk_sp<SkImage> image = cache.Get(description);
+  if (!image) {
+    TRACE_EVENT0("flutter", "PhysicalModelLayer::RasterizeShadow");
+    SkRect local_bounds = normalized_rrect.getBounds();
+    local_bounds.outset(kShadowMargin, kShadowMargin);
+    const int width = static_cast<int>(std::ceil(local_bounds.width() * scale_x));
+    const int height =
+        static_cast<int>(std::ceil(local_bounds.height() * scale_y));
+    if (width <= 0 || height <= 0)
+      return false;
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(width, height);
+    if (!surface)
+      return false;
+    SkCanvas* shadow_canvas = surface->getCanvas();
+    shadow_canvas->clear(SK_ColorTRANSPARENT);
+    shadow_canvas->scale(scale_x, scale_y);
+    shadow_canvas->translate(-local_bounds.left(), -local_bounds.top());
+    SkPath normalized_path;
+    normalized_path.addRRect(normalized_rrect);
+    DrawShadow(shadow_canvas, normalized_path, SK_ColorBLACK, elevation_,
+               transparent_occluder);
+    image = surface->makeImageSnapshot();
+    if (!image)
+      return false;
+    cache.Put(description, image);
+  }
+
+  // The image was rasterized at the device scale, so mapping it back onto
+  // the outset layer bounds reproduces the shadow pixel for pixel.
+  SkRect dst = bounds;
+  dst.outset(kShadowMargin, kShadowMargin);
+  canvas->drawImageRect(image.get(), dst, nullptr);
+  return true;
+}
+
 void PhysicalModelLayer::DrawShadow(SkCanvas* canvas, const SkPath& path,
                                     SkColor color, double elevation,
                                     bool transparentOccluder) {
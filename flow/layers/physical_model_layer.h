@@ -22,7 +22,11 @@ class PhysicalModelLayer : public ContainerLayer {
                          SkColor color, double elevation, bool transparentOccluder);
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
 #if defined(OS_FUCHSIA)
@@ -31,6 +35,11 @@ class PhysicalModelLayer : public ContainerLayer {
 #endif  // defined(OS_FUCHSIA)
 
  private:
+  // Draws the shadow from the process-wide shadow raster cache, rasterizing
+  // it first on a miss. Returns false when the current transform cannot be
+  // served from the cache and the caller should draw the shadow directly.
+  bool DrawCachedShadow(SkCanvas* canvas);
+
   SkRRect rrect_;
   double elevation_;
   SkColor color_;
@@ -5,12 +5,13 @@
 #include "flutter/flow/layers/picture_layer.h"
 
 #include "flutter/common/threads.h"
+#include "flutter/flow/damage_area.h"
 #include "flutter/flow/raster_cache.h"
 #include "lib/ftl/logging.h"
 
 namespace flow {
 
-PictureLayer::PictureLayer() {}
+PictureLayer::PictureLayer() : Layer(Type::kPicture) {}
 
 PictureLayer::~PictureLayer() {
   // The picture may contain references to textures that are associated
@@ -22,16 +23,68 @@ PictureLayer::~PictureLayer() {
 }
 
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  preroll_matrix_ = matrix;
+
+  SkRect bounds = picture_->cullRect().makeOffset(offset_.x(), offset_.y());
+
+  // Fully clipped pictures should not occupy raster cache space.
+  if (!SkRect::Intersects(bounds, context->cull_rect)) {
+    image_ = nullptr;
+    set_paint_bounds(bounds);
+    context->child_paint_bounds = bounds;
+    return;
+  }
+
   if (auto cache = context->raster_cache) {
-    image_ = cache->GetPrerolledImage(context->gr_context, picture_.get(),
-                                      matrix, is_complex_, will_change_);
+    if (context->parallel_mode && context->raster_cache_candidates) {
+      // The cache is not thread-safe; defer the lookup to the serial pass
+      // that runs once the preroll workers join.
+      context->raster_cache_candidates->push_back(this);
+    } else {
+      image_ = cache->GetPrerolledImage(context->gr_context, picture_.get(),
+                                        matrix, is_complex_, will_change_,
+                                        has_metadata_ ? &metadata_ : nullptr);
+    }
   }
 
-  SkRect bounds = picture_->cullRect().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
   context->child_paint_bounds = bounds;
 }
 
+void PictureLayer::UpdateRasterCache(RasterCache* cache,
+                                     GrContext* gr_context) {
+  image_ = cache->GetPrerolledImage(gr_context, picture_.get(),
+                                    preroll_matrix_, is_complex_, will_change_,
+                                    has_metadata_ ? &metadata_ : nullptr);
+}
+
+bool PictureLayer::Compare(const Layer& old_layer) const {
+  if (old_layer.type() != Type::kPicture) {
+    return false;
+  }
+  const PictureLayer& old_picture =
+      static_cast<const PictureLayer&>(old_layer);
+  return picture_ && old_picture.picture_ &&
+         picture_->uniqueID() == old_picture.picture_->uniqueID() &&
+         offset_ == old_picture.offset_;
+}
+
+void PictureLayer::ComputeDamage(const Layer* old_layer,
+                                 DamageArea& damage) const {
+  if (old_layer != nullptr && old_layer->type() == Type::kPicture) {
+    const PictureLayer& old_picture =
+        static_cast<const PictureLayer&>(*old_layer);
+    // A picture's uniqueID is stable for the picture's lifetime, so an
+    // unchanged id at an unchanged offset draws identical content.
+    if (picture_ && old_picture.picture_ &&
+        picture_->uniqueID() == old_picture.picture_->uniqueID() &&
+        offset_ == old_picture.offset_) {
+      return;
+    }
+  }
+  Layer::ComputeDamage(old_layer, damage);
+}
+
 void PictureLayer::Paint(PaintContext& context) {
   FTL_DCHECK(picture_);
 
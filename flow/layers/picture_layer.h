@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_PICTURE_LAYER_H_
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/picture_raster_cost.h"
 
 namespace flow {
 
@@ -20,20 +21,45 @@ class PictureLayer : public Layer {
   void set_is_complex(bool value) { is_complex_ = value; }
   void set_will_change(bool value) { will_change_ = value; }
 
+  // Metadata computed when the picture was recorded, if available; lets the
+  // raster cache make admission decisions without replaying the picture for
+  // analysis.
+  void set_metadata(const PictureMetadata& metadata) {
+    metadata_ = metadata;
+    has_metadata_ = true;
+  }
+
   SkPicture* picture() const { return picture_.get(); }
 
+  const SkPoint& offset() const { return offset_; }
+
+  // The raster cache image produced during preroll, if any.
+  SkImage* raster_cache_image() const { return image_.get(); }
+
   void Preroll(PrerollContext* frame, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
+  void UpdateRasterCache(RasterCache* cache, GrContext* gr_context) override;
+
+  void ComputeDamage(const Layer* old_layer, DamageArea& damage) const override;
+
+  bool Compare(const Layer& old_layer) const override;
+
  private:
   SkPoint offset_;
   sk_sp<SkPicture> picture_;
   bool is_complex_ = false;
   bool will_change_ = false;
+  PictureMetadata metadata_;
+  bool has_metadata_ = false;
 
   // If we rasterized the picture separately, image_ holds the pixels.
   sk_sp<SkImage> image_;
 
+  // Matrix this layer was last prerolled with, for deferred raster cache
+  // lookups after a parallel preroll.
+  SkMatrix preroll_matrix_;
+
   FTL_DISALLOW_COPY_AND_ASSIGN(PictureLayer);
 };
 
@@ -6,10 +6,26 @@
 
 namespace flow {
 
-ShaderMaskLayer::ShaderMaskLayer() {}
+ShaderMaskLayer::ShaderMaskLayer() : ContainerLayer(Type::kShaderMask) {}
 
 ShaderMaskLayer::~ShaderMaskLayer() {}
 
+bool ShaderMaskLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  const ShaderMaskLayer& old_mask =
+      static_cast<const ShaderMaskLayer&>(old_layer);
+  return shader_ == old_mask.shader_ && mask_rect_ == old_mask.mask_rect_ &&
+         blend_mode_ == old_mask.blend_mode_;
+}
+
+void ShaderMaskLayer::PrerollOcclusion(OcclusionContext* context,
+                                       const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  // The mask's blend can knock alpha out of anything the children drew.
+  PrerollOcclusionChildrenWithoutContribution(context, matrix);
+}
+
 void ShaderMaskLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ShaderMaskLayer::Paint");
   Layer::AutoSaveLayer(context, paint_bounds(), nullptr);
@@ -25,6 +25,10 @@ class ShaderMaskLayer : public ContainerLayer {
   }
 
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
  private:
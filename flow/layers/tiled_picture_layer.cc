@@ -0,0 +1,204 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/tiled_picture_layer.h"
+
+#include <cmath>
+
+#include "flutter/common/threads.h"
+#include "flutter/flow/damage_area.h"
+#include "flutter/flow/raster_cache.h"
+#include "lib/ftl/logging.h"
+
+namespace flow {
+
+TiledPictureLayer::TiledPictureLayer()
+    : Layer(Type::kTiledPicture), tile_size_(SkSize::Make(0, 0)) {}
+
+TiledPictureLayer::~TiledPictureLayer() {
+  // The pictures may contain references to textures that are associated
+  // with the IO thread's context.
+  for (auto& entry : tiles_) {
+    SkPicture* picture = entry.second.picture.release();
+    if (picture) {
+      blink::Threads::IO()->PostTask([picture]() { picture->unref(); });
+    }
+  }
+}
+
+void TiledPictureLayer::SetTile(int32_t column,
+                                int32_t row,
+                                sk_sp<SkPicture> picture) {
+  TileKey key(column, row);
+  if (!picture) {
+    tiles_.erase(key);
+    return;
+  }
+  Tile& tile = tiles_[key];
+  tile.picture = std::move(picture);
+  tile.image = nullptr;
+}
+
+SkRect TiledPictureLayer::TileRect(const TileKey& key) const {
+  return SkRect::MakeXYWH(key.first * tile_size_.width(),
+                          key.second * tile_size_.height(),
+                          tile_size_.width(), tile_size_.height());
+}
+
+void TiledPictureLayer::Preroll(PrerollContext* context,
+                                const SkMatrix& matrix) {
+  preroll_matrix_ = matrix;
+  visible_tiles_.clear();
+
+  FTL_DCHECK(!tile_size_.isEmpty());
+
+  // The cull rect in tile-grid space.
+  const SkRect cull =
+      context->cull_rect.makeOffset(-offset_.x(), -offset_.y());
+
+  SkRect bounds = SkRect::MakeEmpty();
+  if (!cull.isEmpty()) {
+    // Walk the cells in the culled range when that range is small, and the
+    // (sparse) tile map itself when the cull rect is effectively unbounded.
+    const double first_column = std::floor(cull.left() / tile_size_.width());
+    const double last_column = std::ceil(cull.right() / tile_size_.width());
+    const double first_row = std::floor(cull.top() / tile_size_.height());
+    const double last_row = std::ceil(cull.bottom() / tile_size_.height());
+    const double cell_count =
+        (last_column - first_column) * (last_row - first_row);
+
+    if (cell_count < static_cast<double>(tiles_.size())) {
+      for (int32_t row = static_cast<int32_t>(first_row);
+           row < static_cast<int32_t>(last_row); row++) {
+        for (int32_t column = static_cast<int32_t>(first_column);
+             column < static_cast<int32_t>(last_column); column++) {
+          auto it = tiles_.find(TileKey(column, row));
+          if (it == tiles_.end()) {
+            continue;
+          }
+          visible_tiles_.push_back(&it->second);
+          bounds.join(TileRect(it->first));
+        }
+      }
+    } else {
+      for (auto& entry : tiles_) {
+        const SkRect tile_rect = TileRect(entry.first);
+        if (!SkRect::Intersects(tile_rect, cull)) {
+          entry.second.image = nullptr;
+          continue;
+        }
+        visible_tiles_.push_back(&entry.second);
+        bounds.join(tile_rect);
+      }
+    }
+  }
+
+  if (!bounds.isEmpty()) {
+    bounds.offset(offset_.x(), offset_.y());
+  }
+
+  if (auto cache = context->raster_cache) {
+    if (context->parallel_mode && context->raster_cache_candidates) {
+      // The cache is not thread-safe; defer the lookups to the serial pass
+      // that runs once the preroll workers join.
+      context->raster_cache_candidates->push_back(this);
+    } else {
+      UpdateRasterCache(cache, context->gr_context);
+    }
+  }
+
+  set_paint_bounds(bounds);
+  context->child_paint_bounds = bounds;
+}
+
+void TiledPictureLayer::UpdateRasterCache(RasterCache* cache,
+                                          GrContext* gr_context) {
+  for (Tile* tile : visible_tiles_) {
+    tile->image =
+        cache->GetPrerolledImage(gr_context, tile->picture.get(),
+                                 preroll_matrix_, is_complex_, will_change_,
+                                 nullptr /* metadata */);
+  }
+}
+
+bool TiledPictureLayer::Compare(const Layer& old_layer) const {
+  if (old_layer.type() != Type::kTiledPicture) {
+    return false;
+  }
+  const TiledPictureLayer& old_tiled =
+      static_cast<const TiledPictureLayer&>(old_layer);
+  if (offset_ != old_tiled.offset_ || tile_size_ != old_tiled.tile_size_ ||
+      tiles_.size() != old_tiled.tiles_.size()) {
+    return false;
+  }
+  auto old_it = old_tiled.tiles_.begin();
+  for (auto it = tiles_.begin(); it != tiles_.end(); ++it, ++old_it) {
+    if (it->first != old_it->first ||
+        it->second.picture->uniqueID() != old_it->second.picture->uniqueID()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TiledPictureLayer::ComputeDamage(const Layer* old_layer,
+                                      DamageArea& damage) const {
+  if (old_layer == nullptr || old_layer->type() != Type::kTiledPicture) {
+    Layer::ComputeDamage(old_layer, damage);
+    return;
+  }
+  const TiledPictureLayer& old_tiled =
+      static_cast<const TiledPictureLayer&>(*old_layer);
+  if (offset_ != old_tiled.offset_ || tile_size_ != old_tiled.tile_size_) {
+    Layer::ComputeDamage(old_layer, damage);
+    return;
+  }
+
+  // Tile ids are stable for a picture's lifetime, so damage is exactly the
+  // cells whose picture changed or that exist in only one of the trees.
+  // Adjacent damaged cells coalesce into runs inside the area.
+  auto add_tile = [&](const TileKey& key) {
+    SkRect rect = TileRect(key);
+    rect.offset(offset_.x(), offset_.y());
+    damage.AddRect(rect);
+  };
+  auto it = tiles_.begin();
+  auto old_it = old_tiled.tiles_.begin();
+  while (it != tiles_.end() || old_it != old_tiled.tiles_.end()) {
+    if (old_it == old_tiled.tiles_.end() ||
+        (it != tiles_.end() && it->first < old_it->first)) {
+      add_tile(it->first);
+      ++it;
+    } else if (it == tiles_.end() || old_it->first < it->first) {
+      add_tile(old_it->first);
+      ++old_it;
+    } else {
+      if (it->second.picture->uniqueID() != old_it->second.picture->uniqueID()) {
+        add_tile(it->first);
+      }
+      ++it;
+      ++old_it;
+    }
+  }
+}
+
+void TiledPictureLayer::Paint(PaintContext& context) {
+  TRACE_EVENT1("flutter", "TiledPictureLayer::Paint", "visible_tiles",
+               static_cast<int>(visible_tiles_.size()));
+
+  SkAutoCanvasRestore save(&context.canvas, true);
+  context.canvas.translate(offset_.x(), offset_.y());
+
+  for (Tile* tile : visible_tiles_) {
+    if (tile->image) {
+      context.canvas.drawImageRect(tile->image.get(),
+                                   tile->picture->cullRect(), nullptr,
+                                   SkCanvas::kFast_SrcRectConstraint);
+    } else {
+      context.canvas.drawPicture(tile->picture.get());
+    }
+  }
+}
+
+}  // namespace flow
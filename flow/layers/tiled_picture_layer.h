@@ -0,0 +1,79 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_TILED_PICTURE_LAYER_H_
+#define FLUTTER_FLOW_LAYERS_TILED_PICTURE_LAYER_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "flutter/flow/layers/layer.h"
+
+namespace flow {
+
+// A picture layer for canvases too large to hold in one SkPicture: content
+// is recorded as a sparse 2D grid of sub-pictures, each covering one
+// tile-sized cell. Preroll selects only the tiles intersecting the current
+// cull rect, so per-frame cost tracks the viewport, not the canvas extent,
+// and each tile gets its own raster cache entry.
+//
+// Tile (column, row) covers the cell from (column * width, row * height) to
+// ((column + 1) * width, (row + 1) * height) in the layer's coordinate
+// space, before |offset| is applied; a tile's picture is expected to stay
+// within its cell. Cells with no content simply have no tile.
+class TiledPictureLayer : public Layer {
+ public:
+  TiledPictureLayer();
+  ~TiledPictureLayer() override;
+
+  void set_offset(const SkPoint& offset) { offset_ = offset; }
+  void set_tile_size(const SkSize& tile_size) { tile_size_ = tile_size; }
+
+  void set_is_complex(bool value) { is_complex_ = value; }
+  void set_will_change(bool value) { will_change_ = value; }
+
+  // Installs (or, with a null picture, removes) the tile at a grid cell.
+  void SetTile(int32_t column, int32_t row, sk_sp<SkPicture> picture);
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void Paint(PaintContext& context) override;
+
+  void UpdateRasterCache(RasterCache* cache, GrContext* gr_context) override;
+
+  void ComputeDamage(const Layer* old_layer, DamageArea& damage) const override;
+
+  bool Compare(const Layer& old_layer) const override;
+
+ private:
+  using TileKey = std::pair<int32_t, int32_t>;  // (column, row)
+
+  struct Tile {
+    sk_sp<SkPicture> picture;
+    // Per-tile raster cache image produced during preroll, if any.
+    sk_sp<SkImage> image;
+  };
+
+  // The cell's rect in the layer's coordinate space, before |offset_|.
+  SkRect TileRect(const TileKey& key) const;
+
+  SkPoint offset_;
+  SkSize tile_size_;
+  bool is_complex_ = false;
+  bool will_change_ = false;
+  std::map<TileKey, Tile> tiles_;
+
+  // Tiles intersecting the cull rect of the last preroll, in key order.
+  std::vector<Tile*> visible_tiles_;
+
+  // Matrix this layer was last prerolled with, for deferred raster cache
+  // lookups after a parallel preroll.
+  SkMatrix preroll_matrix_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(TiledPictureLayer);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_LAYERS_TILED_PICTURE_LAYER_H_
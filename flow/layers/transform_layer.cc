@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/transform_layer.h"
 
+#include "flutter/flow/damage_area.h"
+
 #if defined(OS_FUCHSIA)
 #include "apps/mozart/lib/skia/type_converters.h"
 #include "apps/mozart/services/composition/nodes.fidl.h"
@@ -11,18 +13,36 @@
 
 namespace flow {
 
-TransformLayer::TransformLayer() {}
+TransformLayer::TransformLayer() : ContainerLayer(Type::kTransform) {}
 
 TransformLayer::~TransformLayer() {}
 
 void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkMatrix childMatrix;
   childMatrix.setConcat(matrix, transform_);
+  const SkRect previous_cull_rect = context->cull_rect;
+  SkMatrix inverse_transform;
+  if (transform_.invert(&inverse_transform)) {
+    inverse_transform.mapRect(&context->cull_rect);
+  } else {
+    context->cull_rect = SkRect::MakeLargest();
+  }
   PrerollChildren(context, childMatrix);
+  context->cull_rect = previous_cull_rect;
   transform_.mapRect(&context->child_paint_bounds);
   set_paint_bounds(context->child_paint_bounds);
 }
 
+void TransformLayer::PrerollOcclusion(OcclusionContext* context,
+                                      const SkMatrix& matrix) {
+  Layer::PrerollOcclusion(context, matrix);
+  if (is_occluded())
+    return;
+  SkMatrix childMatrix;
+  childMatrix.setConcat(matrix, transform_);
+  PrerollOcclusionChildren(context, childMatrix);
+}
+
 #if defined(OS_FUCHSIA)
 
 void TransformLayer::UpdateScene(SceneUpdateContext& context,
@@ -34,6 +54,26 @@ void TransformLayer::UpdateScene(SceneUpdateContext& context,
 
 #endif  // defined(OS_FUCHSIA)
 
+bool TransformLayer::PropertiesEqual(const ContainerLayer& old_layer) const {
+  return transform_ == static_cast<const TransformLayer&>(old_layer).transform_;
+}
+
+void TransformLayer::ComputeDamage(const Layer* old_layer,
+                                   DamageArea& damage) const {
+  if (old_layer == nullptr || old_layer->type() != type() ||
+      !PropertiesEqual(static_cast<const ContainerLayer&>(*old_layer))) {
+    Layer::ComputeDamage(old_layer, damage);
+    return;
+  }
+  // Children damage is in the transformed space; map it back to this layer's
+  // coordinate space.
+  DamageArea children_damage;
+  ComputeChildrenDamage(static_cast<const ContainerLayer&>(*old_layer),
+                        children_damage);
+  children_damage.Transform(transform_);
+  damage.Join(children_damage);
+}
+
 void TransformLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "TransformLayer::Paint");
   FTL_DCHECK(!needs_system_composite());
@@ -16,8 +16,15 @@ class TransformLayer : public ContainerLayer {
 
   void set_transform(const SkMatrix& transform) { transform_ = transform; }
 
+ public:
+  void ComputeDamage(const Layer* old_layer, DamageArea& damage) const override;
+
  protected:
+  bool PropertiesEqual(const ContainerLayer& old_layer) const override;
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void PrerollOcclusion(OcclusionContext* context,
+                        const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
 
 #if defined(OS_FUCHSIA)
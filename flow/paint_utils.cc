@@ -6,15 +6,14 @@
 
 #include <stdlib.h>
 
+#include "third_party/skia/include/core/SkColorFilter.h"
 #include "third_party/skia/include/core/SkShader.h"
 
 namespace flow {
 
 namespace {
 
-sk_sp<SkShader> CreateCheckerboardShader(SkColor c1,
-                                                SkColor c2,
-                                                int size) {
+sk_sp<SkShader> CreateCheckerboardShader(SkColor c1, SkColor c2, int size) {
   SkBitmap bm;
   bm.allocN32Pixels(2 * size, 2 * size);
   bm.eraseColor(c1);
@@ -24,14 +23,30 @@ sk_sp<SkShader> CreateCheckerboardShader(SkColor c1,
                                     SkShader::kRepeat_TileMode);
 }
 
+// A single white-on-transparent checkerboard tile shader, built once and
+// recolored per call with a color filter. This keeps the debug overlay from
+// re-rasterizing a tile bitmap every time a cached image is drawn, so
+// enabling checkerboarding barely perturbs the frame times it is meant to
+// diagnose.
+SkShader* CachedCheckerboardShader(int size) {
+  static sk_sp<SkShader> shader =
+      CreateCheckerboardShader(SK_ColorWHITE, SK_ColorTRANSPARENT, size);
+  return shader.get();
+}
+
+const int kCheckerboardTileSize = 12;
+
 }  // anonymous namespace
 
-void DrawCheckerboard(SkCanvas* canvas,
-                             SkColor c1,
-                             SkColor c2,
-                             int size) {
+void DrawCheckerboard(SkCanvas* canvas, SkColor c1, SkColor c2, int size) {
   SkPaint paint;
-  paint.setShader(CreateCheckerboardShader(c1, c2, size));
+  if (c2 == SK_ColorTRANSPARENT && size == kCheckerboardTileSize) {
+    paint.setShader(sk_ref_sp(CachedCheckerboardShader(size)));
+    paint.setColorFilter(
+        SkColorFilter::MakeModeFilter(c1, SkBlendMode::kSrcIn));
+  } else {
+    paint.setShader(CreateCheckerboardShader(c1, c2, size));
+  }
   canvas->drawPaint(paint);
 }
 
@@ -43,7 +58,8 @@ void DrawCheckerboard(SkCanvas* canvas, const SkRect& rect) {
   auto checkerboard_color =
       SkColorSetARGBInline(64, rand() % 256, rand() % 256, rand() % 256);
 
-  DrawCheckerboard(canvas, checkerboard_color, 0x00000000, 12);
+  DrawCheckerboard(canvas, checkerboard_color, 0x00000000,
+                   kCheckerboardTileSize);
   canvas->restore();
 
   // Stroke the drawn area
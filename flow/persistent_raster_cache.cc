@@ -0,0 +1,104 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/persistent_raster_cache.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <utility>
+
+#include "flutter/common/threads.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/glue/trace_event.h"
+#include "lib/ftl/logging.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flow {
+
+namespace {
+
+// 64-bit FNV-1a over |data|, seeded with |seed| so the CTM scale can be
+// folded into the picture content hash.
+uint64_t FoldBytes(uint64_t seed, const uint8_t* data, size_t size) {
+  uint64_t hash = seed;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211u;
+  }
+  return hash;
+}
+
+const uint64_t kFNVOffsetBasis = 14695981039346656037u;
+
+}  // namespace
+
+PersistentRasterCache::PersistentRasterCache(std::string cache_directory)
+    : cache_directory_(std::move(cache_directory)) {}
+
+PersistentRasterCache::~PersistentRasterCache() = default;
+
+uint64_t PersistentRasterCache::ComputePictureKey(SkPicture* picture,
+                                                 SkScalar scale_x,
+                                                 SkScalar scale_y) {
+  TRACE_EVENT0("flutter", "PersistentRasterCache::ComputePictureKey");
+  sk_sp<SkData> serialized = picture->serialize();
+  if (serialized == nullptr) {
+    return 0;
+  }
+  uint64_t hash =
+      FoldBytes(kFNVOffsetBasis, serialized->bytes(), serialized->size());
+  hash = FoldBytes(hash, reinterpret_cast<const uint8_t*>(&scale_x),
+                   sizeof(scale_x));
+  hash = FoldBytes(hash, reinterpret_cast<const uint8_t*>(&scale_y),
+                   sizeof(scale_y));
+  return hash;
+}
+
+std::string PersistentRasterCache::PathForKey(uint64_t key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.skimg",
+           static_cast<unsigned long long>(key));
+  return cache_directory_ + "/" + name;
+}
+
+sk_sp<SkImage> PersistentRasterCache::Load(uint64_t key) const {
+  if (key == 0) {
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", "PersistentRasterCache::Load");
+  fml::FileMapping mapping(PathForKey(key));
+  if (mapping.GetSize() == 0) {
+    return nullptr;
+  }
+  // The mapping does not outlive this call, so hand Skia its own copy of the
+  // encoded bytes.
+  sk_sp<SkData> encoded =
+      SkData::MakeWithCopy(mapping.GetMapping(), mapping.GetSize());
+  return SkImage::MakeFromEncoded(std::move(encoded));
+}
+
+void PersistentRasterCache::Store(uint64_t key, sk_sp<SkImage> image) const {
+  if (key == 0 || image == nullptr) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PersistentRasterCache::Store");
+  sk_sp<SkData> encoded(image->encode());
+  if (encoded == nullptr) {
+    return;
+  }
+  std::string path = PathForKey(key);
+  blink::Threads::IO()->PostTask([path, encoded]() {
+    TRACE_EVENT0("flutter", "PersistentRasterCache::Store (write)");
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+      FTL_DLOG(INFO) << "Could not write raster cache entry: " << path;
+      return;
+    }
+    fwrite(encoded->bytes(), encoded->size(), 1, file);
+    fclose(file);
+  });
+}
+
+}  // namespace flow
@@ -0,0 +1,52 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
+#define FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
+
+#include <string>
+
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flow {
+
+// Optional disk-backed tier for the raster cache. Entries are keyed on a
+// stable content hash of the serialized picture plus the CTM scale, so
+// rasterizations of static content survive process restarts. Encoded images
+// are written under a caller-supplied cache directory and memory-mapped back
+// on subsequent launches.
+class PersistentRasterCache {
+ public:
+  explicit PersistentRasterCache(std::string cache_directory);
+
+  ~PersistentRasterCache();
+
+  // Computes the stable cache key for |picture| rasterized at the given
+  // scale. This serializes the picture and is therefore not cheap; callers
+  // should memoize the result per entry.
+  static uint64_t ComputePictureKey(SkPicture* picture,
+                                    SkScalar scale_x,
+                                    SkScalar scale_y);
+
+  // Memory-maps and decodes the cached rasterization for |key|, or returns
+  // nullptr if no entry exists on disk.
+  sk_sp<SkImage> Load(uint64_t key) const;
+
+  // Encodes |image| and schedules a write to the cache directory on the IO
+  // thread.
+  void Store(uint64_t key, sk_sp<SkImage> image) const;
+
+ private:
+  std::string PathForKey(uint64_t key) const;
+
+  const std::string cache_directory_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PersistentRasterCache);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
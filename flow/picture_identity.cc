@@ -0,0 +1,90 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_identity.h"
+
+namespace flow {
+
+namespace {
+
+// Upper bound on retained canonical pictures. The table only needs to span
+// the couple of frames between a picture being recorded and its identical
+// successor being recorded, so this is sized to a busy scene, not a
+// session.
+const size_t kMaxEntries = 256;
+
+bool MetadataMatches(const PictureMetadata& a, const PictureMetadata& b) {
+  return a.op_count == b.op_count &&
+         a.save_layer_count == b.save_layer_count &&
+         a.text_blob_count == b.text_blob_count &&
+         a.approximate_pixel_cost == b.approximate_pixel_cost &&
+         a.estimated_raster_cost_us == b.estimated_raster_cost_us;
+}
+
+}  // namespace
+
+PictureIdentityTable& PictureIdentityTable::Shared() {
+  static PictureIdentityTable* table = new PictureIdentityTable();
+  return *table;
+}
+
+PictureIdentityTable::PictureIdentityTable() = default;
+
+PictureIdentityTable::~PictureIdentityTable() = default;
+
+sk_sp<SkPicture> PictureIdentityTable::Canonicalize(
+    sk_sp<SkPicture> picture,
+    const PictureMetadata& metadata) {
+  if (picture == nullptr || metadata.content_hash == 0) {
+    return picture;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  use_generation_++;
+
+  auto it = table_.find(metadata.content_hash);
+  if (it != table_.end()) {
+    Entry& entry = it->second;
+    if (entry.picture->cullRect() == picture->cullRect() &&
+        MetadataMatches(entry.metadata, metadata)) {
+      entry.last_used = use_generation_;
+      return entry.picture;
+    }
+    // Hash collision with different content. Keep the established
+    // canonical; the candidate stays distinct.
+    return picture;
+  }
+
+  table_.emplace(metadata.content_hash,
+                 Entry{picture, metadata, use_generation_});
+  if (table_.size() > kMaxEntries) {
+    SweepLocked();
+  }
+  return picture;
+}
+
+void PictureIdentityTable::SweepLocked() {
+  // First drop entries nothing else references: content that stopped being
+  // recorded has no identical successor to dedup against.
+  for (auto it = table_.begin(); it != table_.end();) {
+    if (it->second.picture->unique()) {
+      it = table_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // Still-referenced entries beyond the bound: evict least recently
+  // matched until back under it.
+  while (table_.size() > kMaxEntries) {
+    auto victim = table_.begin();
+    for (auto it = table_.begin(); it != table_.end(); ++it) {
+      if (it->second.last_used < victim->second.last_used) {
+        victim = it;
+      }
+    }
+    table_.erase(victim);
+  }
+}
+
+}  // namespace flow
@@ -0,0 +1,62 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_IDENTITY_H_
+#define FLUTTER_FLOW_PICTURE_IDENTITY_H_
+
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/flow/picture_raster_cost.h"
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flow {
+
+// Process-wide table mapping op-stream content hashes to canonical
+// pictures. The framework re-records byte-identical pictures for unchanged
+// widgets every frame, and each recording gets a fresh uniqueID, which
+// defeats every consumer keyed on picture identity — the raster cache,
+// scene comparison, and damage tracking. Routing freshly recorded pictures
+// through this table makes unchanged content keep a stable uniqueID.
+//
+// A candidate is adopted only when, besides the hash, its cull rect and
+// every content statistic from the metadata pass match the canonical
+// entry, so a hash collision degrades to a missed dedup rather than wrong
+// content. Entries are dropped once nothing outside the table references
+// them, and the table is bounded, evicting the least recently matched
+// entries beyond that.
+class PictureIdentityTable {
+ public:
+  static PictureIdentityTable& Shared();
+
+  // Returns the canonical picture with the same content as |picture|, or
+  // |picture| itself — now registered as the canonical — if none is known.
+  // |metadata| must be the result of analyzing |picture|. Safe to call from
+  // any thread.
+  sk_sp<SkPicture> Canonicalize(sk_sp<SkPicture> picture,
+                                const PictureMetadata& metadata);
+
+ private:
+  struct Entry {
+    sk_sp<SkPicture> picture;
+    PictureMetadata metadata;
+    uint64_t last_used;
+  };
+
+  PictureIdentityTable();
+  ~PictureIdentityTable();
+
+  void SweepLocked();
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Entry> table_;
+  uint64_t use_generation_ = 0;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PictureIdentityTable);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_PICTURE_IDENTITY_H_
@@ -0,0 +1,330 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_raster_cost.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flow {
+
+namespace {
+
+// Rough per-op weights in microseconds on a mid-range GPU at unit scale.
+// These only need to rank pictures relative to each other; absolute
+// accuracy is not required for admission decisions.
+const uint64_t kSimpleShapeCost = 1;
+const uint64_t kRRectCost = 3;
+const uint64_t kPathCost = 8;
+const uint64_t kTextBlobCost = 4;
+const uint64_t kImageCost = 4;
+const uint64_t kSaveLayerCost = 40;
+// Paints carrying mask or image filters trigger offscreen passes or blurs.
+const uint64_t kFilteredPaintCost = 30;
+
+// FNV-1a parameters for the rolling content hash.
+const uint64_t kHashOffsetBasis = 14695981039346656037ull;
+const uint64_t kHashPrime = 1099511628211ull;
+
+// Tags folded into the content hash so equal parameters of different op
+// kinds cannot collide.
+enum OpTag : uint64_t {
+  kTagSaveLayer = 1,
+  kTagDrawPaint,
+  kTagDrawRect,
+  kTagDrawOval,
+  kTagDrawRRect,
+  kTagDrawDRRect,
+  kTagDrawPath,
+  kTagDrawPoints,
+  kTagDrawTextBlob,
+  kTagDrawImage,
+  kTagDrawImageRect,
+  kTagClipRect,
+  kTagClipRRect,
+  kTagClipPath,
+};
+
+class RasterCostCanvas : public SkCanvas {
+ public:
+  RasterCostCanvas(int width, int height) : SkCanvas(width, height) {}
+
+  PictureMetadata metadata() const {
+    PictureMetadata metadata = metadata_;
+    metadata.content_hash = ops_hashed_ == 0 ? 0 : hash_;
+    return metadata;
+  }
+
+ protected:
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+    metadata_.save_layer_count++;
+    metadata_.estimated_raster_cost_us += kSaveLayerCost;
+    Mix(kTagSaveLayer);
+    if (rec.fBounds != nullptr)
+      MixRect(*rec.fBounds);
+    if (rec.fPaint != nullptr)
+      MixPaint(*rec.fPaint);
+    return kNoLayer_SaveLayerStrategy;
+  }
+
+  void onDrawPaint(const SkPaint& paint) override {
+    AddOp(kTagDrawPaint, kSimpleShapeCost, paint);
+    // Covers the whole device.
+    metadata_.approximate_pixel_cost +=
+        static_cast<double>(imageInfo().width()) * imageInfo().height();
+  }
+
+  void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+    AddOp(kTagDrawRect, kSimpleShapeCost, paint);
+    MixRect(rect);
+    AddBounds(rect);
+  }
+
+  void onDrawOval(const SkRect& oval, const SkPaint& paint) override {
+    AddOp(kTagDrawOval, kSimpleShapeCost, paint);
+    MixRect(oval);
+    AddBounds(oval);
+  }
+
+  void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override {
+    AddOp(kTagDrawRRect, kRRectCost, paint);
+    MixRRect(rrect);
+    AddBounds(rrect.getBounds());
+  }
+
+  void onDrawDRRect(const SkRRect& outer,
+                    const SkRRect& inner,
+                    const SkPaint& paint) override {
+    AddOp(kTagDrawDRRect, kRRectCost, paint);
+    MixRRect(outer);
+    MixRRect(inner);
+    AddBounds(outer.getBounds());
+  }
+
+  void onDrawPath(const SkPath& path, const SkPaint& paint) override {
+    AddOp(kTagDrawPath, kPathCost, paint);
+    MixPath(path);
+    AddBounds(path.getBounds());
+  }
+
+  void onDrawPoints(PointMode mode,
+                    size_t count,
+                    const SkPoint pts[],
+                    const SkPaint& paint) override {
+    AddOp(kTagDrawPoints, kSimpleShapeCost, paint);
+    Mix(static_cast<uint64_t>(mode));
+    Mix(count);
+    for (size_t i = 0; i < count; i++) {
+      MixScalar(pts[i].x());
+      MixScalar(pts[i].y());
+    }
+    SkRect bounds;
+    if (bounds.setBoundsCheck(pts, count))
+      AddBounds(bounds);
+  }
+
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override {
+    metadata_.text_blob_count++;
+    AddOp(kTagDrawTextBlob, kTextBlobCost, paint);
+    // Blobs are immutable and the layout caches reuse them for unchanged
+    // text, so the unique id identifies the content; freshly laid-out but
+    // equal blobs merely miss, they never falsely match.
+    Mix(blob->uniqueID());
+    MixScalar(x);
+    MixScalar(y);
+    AddBounds(blob->bounds().makeOffset(x, y));
+  }
+
+  void onDrawImage(const SkImage* image,
+                   SkScalar dx,
+                   SkScalar dy,
+                   const SkPaint* paint) override {
+    AddImageOp(kTagDrawImage, paint);
+    Mix(image->uniqueID());
+    MixScalar(dx);
+    MixScalar(dy);
+    AddBounds(SkRect::MakeXYWH(dx, dy, image->width(), image->height()));
+  }
+
+  void onDrawImageRect(const SkImage* image,
+                       const SkRect* src,
+                       const SkRect& dst,
+                       const SkPaint* paint,
+                       SrcRectConstraint constraint) override {
+    AddImageOp(kTagDrawImageRect, paint);
+    Mix(image->uniqueID());
+    if (src != nullptr)
+      MixRect(*src);
+    MixRect(dst);
+    Mix(static_cast<uint64_t>(constraint));
+    AddBounds(dst);
+  }
+
+  void onClipRect(const SkRect& rect,
+                  SkClipOp op,
+                  ClipEdgeStyle edge_style) override {
+    Mix(kTagClipRect);
+    MixRect(rect);
+    Mix(static_cast<uint64_t>(op));
+    Mix(static_cast<uint64_t>(edge_style));
+    SkCanvas::onClipRect(rect, op, edge_style);
+  }
+
+  void onClipRRect(const SkRRect& rrect,
+                   SkClipOp op,
+                   ClipEdgeStyle edge_style) override {
+    Mix(kTagClipRRect);
+    MixRRect(rrect);
+    Mix(static_cast<uint64_t>(op));
+    Mix(static_cast<uint64_t>(edge_style));
+    SkCanvas::onClipRRect(rrect, op, edge_style);
+  }
+
+  void onClipPath(const SkPath& path,
+                  SkClipOp op,
+                  ClipEdgeStyle edge_style) override {
+    Mix(kTagClipPath);
+    MixPath(path);
+    Mix(static_cast<uint64_t>(op));
+    Mix(static_cast<uint64_t>(edge_style));
+    SkCanvas::onClipPath(path, op, edge_style);
+  }
+
+  void onDrawPicture(const SkPicture* picture,
+                     const SkMatrix* matrix,
+                     const SkPaint* paint) override {
+    // Replay nested pictures so their ops are weighed too.
+    SkCanvas::onDrawPicture(picture, matrix, paint);
+  }
+
+ private:
+  void AddOp(uint64_t tag, uint64_t base_cost, const SkPaint& paint) {
+    metadata_.op_count++;
+    metadata_.estimated_raster_cost_us += base_cost;
+    if (paint.getMaskFilter() != nullptr || paint.getImageFilter() != nullptr) {
+      metadata_.estimated_raster_cost_us += kFilteredPaintCost;
+    }
+    ops_hashed_++;
+    Mix(tag);
+    MixMatrix(getTotalMatrix());
+    MixPaint(paint);
+  }
+
+  void AddImageOp(uint64_t tag, const SkPaint* paint) {
+    metadata_.op_count++;
+    metadata_.estimated_raster_cost_us += kImageCost;
+    if (paint != nullptr && (paint->getMaskFilter() != nullptr ||
+                             paint->getImageFilter() != nullptr)) {
+      metadata_.estimated_raster_cost_us += kFilteredPaintCost;
+    }
+    ops_hashed_++;
+    Mix(tag);
+    MixMatrix(getTotalMatrix());
+    if (paint != nullptr)
+      MixPaint(*paint);
+  }
+
+  void AddBounds(const SkRect& local_bounds) {
+    SkRect device_bounds;
+    getTotalMatrix().mapRect(&device_bounds, local_bounds);
+    metadata_.approximate_pixel_cost +=
+        static_cast<double>(device_bounds.width()) * device_bounds.height();
+  }
+
+  void Mix(uint64_t value) { hash_ = (hash_ ^ value) * kHashPrime; }
+
+  void MixScalar(SkScalar value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    Mix(bits);
+  }
+
+  void MixRect(const SkRect& rect) {
+    MixScalar(rect.left());
+    MixScalar(rect.top());
+    MixScalar(rect.right());
+    MixScalar(rect.bottom());
+  }
+
+  void MixRRect(const SkRRect& rrect) {
+    MixRect(rrect.rect());
+    for (int corner = 0; corner < 4; corner++) {
+      SkVector radii =
+          rrect.radii(static_cast<SkRRect::Corner>(corner));
+      MixScalar(radii.x());
+      MixScalar(radii.y());
+    }
+  }
+
+  void MixMatrix(const SkMatrix& matrix) {
+    for (int i = 0; i < 9; i++)
+      MixScalar(matrix[i]);
+  }
+
+  // Paths are hashed by their full serialized content: recordings rebuilt
+  // from scratch produce equal paths with fresh generation ids, so the id
+  // cannot stand in for the content the way an image unique id can.
+  void MixPath(const SkPath& path) {
+    path_scratch_.resize(path.writeToMemory(nullptr));
+    path.writeToMemory(path_scratch_.data());
+    for (uint8_t byte : path_scratch_)
+      hash_ = (hash_ ^ byte) * kHashPrime;
+  }
+
+  // Effects are hashed by pointer. That is sound for matching against a
+  // canonical picture because the canonical keeps its effects alive, so an
+  // equal pointer in a live paint must be the very same object; distinct
+  // but equal effects simply miss.
+  void MixPaint(const SkPaint& paint) {
+    Mix(paint.getColor());
+    Mix(paint.getFlags());
+    Mix(static_cast<uint64_t>(paint.getStyle()));
+    Mix(static_cast<uint64_t>(paint.getBlendMode()));
+    MixScalar(paint.getStrokeWidth());
+    MixScalar(paint.getStrokeMiter());
+    Mix(static_cast<uint64_t>(paint.getStrokeCap()));
+    Mix(static_cast<uint64_t>(paint.getStrokeJoin()));
+    Mix(reinterpret_cast<uintptr_t>(paint.getShader()));
+    Mix(reinterpret_cast<uintptr_t>(paint.getColorFilter()));
+    Mix(reinterpret_cast<uintptr_t>(paint.getMaskFilter()));
+    Mix(reinterpret_cast<uintptr_t>(paint.getImageFilter()));
+    Mix(reinterpret_cast<uintptr_t>(paint.getPathEffect()));
+  }
+
+  PictureMetadata metadata_;
+  uint64_t hash_ = kHashOffsetBasis;
+  // Ops folded into |hash_|; zero means the hash carries no content.
+  int ops_hashed_ = 0;
+  std::vector<uint8_t> path_scratch_;
+};
+
+}  // namespace
+
+PictureMetadata AnalyzePicture(SkPicture* picture) {
+  if (picture == nullptr) {
+    return PictureMetadata();
+  }
+  const SkRect cull = picture->cullRect();
+  RasterCostCanvas canvas(cull.width(), cull.height());
+  picture->playback(&canvas);
+  return canvas.metadata();
+}
+
+uint64_t EstimatePictureRasterCost(SkPicture* picture) {
+  return AnalyzePicture(picture).estimated_raster_cost_us;
+}
+
+}  // namespace flow
@@ -0,0 +1,48 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_RASTER_COST_H_
+#define FLUTTER_FLOW_PICTURE_RASTER_COST_H_
+
+#include <stdint.h>
+
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flow {
+
+// Statistics describing the content of a recorded picture. Computed by
+// replaying the picture into an analysis canvas that touches no pixels;
+// the pass is linear in the op count. Best computed once at recording time
+// and carried alongside the picture, so consumers like raster cache
+// admission do not have to re-derive it per frame.
+struct PictureMetadata {
+  // Number of draw ops, including those of nested pictures.
+  int op_count = 0;
+  int save_layer_count = 0;
+  int text_blob_count = 0;
+  // Sum of the device-space bounds areas of the draw ops, in pixels at unit
+  // scale. Unlike the cull rect area, this counts overdraw.
+  double approximate_pixel_cost = 0;
+  // Estimated unit-scale rasterization cost in microseconds, from per-op-kind
+  // weights. Only needs to rank pictures relative to each other.
+  uint64_t estimated_raster_cost_us = 0;
+  // Rolling hash of the op stream: op kinds, geometry, transforms, clips,
+  // paint state, and the identities of referenced immutable objects (images
+  // and text blobs by unique id, effects by pointer). Byte-identical
+  // re-recordings of the same widget hash equal even though each recording
+  // gets a fresh uniqueID. Zero when no ops were seen.
+  uint64_t content_hash = 0;
+};
+
+// Replays |picture| into the analysis canvas and returns its metadata.
+PictureMetadata AnalyzePicture(SkPicture* picture);
+
+// Estimates the cost, in microseconds, of rasterizing |picture| at unit
+// scale. Shorthand for AnalyzePicture when only the cost is needed; callers
+// should memoize the result per SkPicture::uniqueID().
+uint64_t EstimatePictureRasterCost(SkPicture* picture);
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_PICTURE_RASTER_COST_H_
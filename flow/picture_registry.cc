@@ -0,0 +1,64 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_registry.h"
+
+#include <algorithm>
+
+#include "flutter/common/threads.h"
+#include "flutter/flow/raster_cache.h"
+
+namespace flow {
+
+PictureRegistry& PictureRegistry::Shared() {
+  // Deliberately leaked: caches and wrappers unregister from every thread
+  // up to process exit.
+  static auto* registry = new PictureRegistry();
+  return *registry;
+}
+
+PictureRegistry::PictureRegistry() {}
+
+PictureRegistry::~PictureRegistry() {}
+
+void PictureRegistry::AddCache(RasterCache* cache) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  caches_.push_back(cache);
+}
+
+void PictureRegistry::RemoveCache(RasterCache* cache) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  caches_.erase(std::remove(caches_.begin(), caches_.end(), cache),
+                caches_.end());
+}
+
+void PictureRegistry::AddPictureRef(uint32_t picture_unique_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  live_counts_[picture_unique_id]++;
+}
+
+void PictureRegistry::ReleasePictureRef(uint32_t picture_unique_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = live_counts_.find(picture_unique_id);
+    if (found == live_counts_.end() || --found->second > 0) {
+      return;
+    }
+    live_counts_.erase(found);
+  }
+
+  // The last wrapper is gone; the framework can never put this picture in a
+  // scene again. Release its cache entries on the GPU thread, where the
+  // caches live. A tree already in the pipeline that still draws the
+  // picture merely re-misses.
+  blink::Threads::Gpu()->PostTask([picture_unique_id]() {
+    PictureRegistry& registry = Shared();
+    std::lock_guard<std::mutex> lock(registry.mutex_);
+    for (RasterCache* cache : registry.caches_) {
+      cache->OnPictureDisposed(picture_unique_id);
+    }
+  });
+}
+
+}  // namespace flow
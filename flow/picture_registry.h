@@ -0,0 +1,54 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_REGISTRY_H_
+#define FLUTTER_FLOW_PICTURE_REGISTRY_H_
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+
+namespace flow {
+
+class RasterCache;
+
+// Process-wide registry of live engine-side picture wrappers, keyed by
+// SkPicture uniqueID. When the last wrapper of an id dies, every registered
+// raster cache is told on the GPU thread to drop that picture's entry
+// immediately, instead of the entry lingering until LRU pressure or a sweep
+// evicts it. The count is per id rather than per wrapper because the
+// picture identity table hands the same canonical SkPicture to every
+// wrapper recording identical content. Safe to call from any thread.
+class PictureRegistry {
+ public:
+  static PictureRegistry& Shared();
+
+  // Caches register for disposal notifications, which are delivered on the
+  // GPU thread.
+  void AddCache(RasterCache* cache);
+
+  void RemoveCache(RasterCache* cache);
+
+  // Called when a wrapper adopts or releases the picture with the given id.
+  // The final release of an id triggers the cache notifications.
+  void AddPictureRef(uint32_t picture_unique_id);
+
+  void ReleasePictureRef(uint32_t picture_unique_id);
+
+ private:
+  PictureRegistry();
+  ~PictureRegistry();
+
+  std::mutex mutex_;
+  std::vector<RasterCache*> caches_;
+  std::unordered_map<uint32_t, int> live_counts_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PictureRegistry);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_PICTURE_REGISTRY_H_
@@ -4,12 +4,18 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "flutter/common/threads.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/picture_raster_cost.h"
+#include "flutter/flow/picture_registry.h"
+#include "flutter/flow/raster_cache_hints.h"
+#include "flutter/fml/sampling_profiler.h"
 #include "flutter/glue/trace_event.h"
 #include "lib/ftl/logging.h"
+#include "lib/ftl/time/time_point.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -19,15 +25,50 @@ namespace flow {
 
 static const int kRasterThreshold = 3;
 
-static bool isWorthRasterizing(SkPicture* picture) {
-  // TODO(abarth): We should find a better heuristic here that lets us avoid
-  // wasting memory on trivial layers that are easy to re-rasterize every frame.
-  return picture->approximateOpCount() > 10;
+// Default byte budget for cached images. Entries beyond this budget are
+// evicted in least-recently-used order at the end of each frame.
+static const size_t kDefaultCacheByteBudget = 64 * (1 << 20);  // 64 MB
+
+// Number of software rasterization workers used when async rasterization is
+// enabled. Kept small so background raster work does not starve the decoder
+// and IO threads on low-core devices.
+static const size_t kRasterWorkerCount = 2;
+
+// Pictures estimated to rasterize faster than this are cheaper to replay
+// every frame than to hold as cache textures.
+static const uint64_t kRasterCostAdmissionThresholdMicroseconds = 100;
+
+// The cost estimate is computed at unit scale; fill-bound cost grows with
+// the rasterized area.
+static int64_t ScaledRasterCost(uint64_t estimated_cost_us,
+                                SkScalar scale_x,
+                                SkScalar scale_y) {
+  const double scale_area = std::max<double>(scale_x * scale_y, 1.0 / 16.0);
+  return static_cast<int64_t>(estimated_cost_us * scale_area);
 }
 
-RasterCache::RasterCache() : checkerboard_images_(false), weak_factory_(this) {}
+static bool IsWorthRasterizing(SkPicture* picture,
+                               uint64_t estimated_cost_us,
+                               SkScalar scale_x,
+                               SkScalar scale_y) {
+  return ScaledRasterCost(estimated_cost_us, scale_x, scale_y) >=
+         static_cast<int64_t>(kRasterCostAdmissionThresholdMicroseconds);
+}
 
-RasterCache::~RasterCache() {}
+RasterCache::RasterCache()
+    : max_bytes_(kDefaultCacheByteBudget),
+      current_bytes_(0),
+      frame_fill_budget_micros_(0),
+      checkerboard_images_(false),
+      async_rasterization_(false),
+      next_raster_worker_(0),
+      weak_factory_(this) {
+  PictureRegistry::Shared().AddCache(this);
+}
+
+RasterCache::~RasterCache() {
+  PictureRegistry::Shared().RemoveCache(this);
+}
 
 RasterCache::Entry::Entry() {
   physical_size.setEmpty();
@@ -35,11 +76,30 @@ RasterCache::Entry::Entry() {
 
 RasterCache::Entry::~Entry() {}
 
+void RasterCache::MarkUsed(uint32_t picture_id, Entry& entry) {
+  entry.last_used_frame = frame_number_;
+  if (entry.lru_position != lru_.begin()) {
+    lru_.splice(lru_.begin(), lru_, entry.lru_position);
+  }
+}
+
+void RasterCache::SetEntryImage(Entry& entry, sk_sp<SkImage> image) {
+  current_bytes_ -= entry.image_bytes;
+  entry.image = std::move(image);
+  entry.image_bytes =
+      entry.image ? entry.physical_size.width() * entry.physical_size.height() *
+                        static_cast<size_t>(4)
+                  : 0;
+  current_bytes_ += entry.image_bytes;
+}
+
 sk_sp<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
                                               SkPicture* picture,
                                               const SkMatrix& ctm,
                                               bool is_complex,
-                                              bool will_change) {
+                                              bool will_change,
+                                              const PictureMetadata* metadata) {
+  FML_PROFILER_HOT_FUNCTION("RasterCache::GetPrerolledImage");
   SkScalar scaleX = ctm.getScaleX();
   SkScalar scaleY = ctm.getScaleY();
 
@@ -51,30 +111,96 @@ sk_sp<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
   if (physical_size.isEmpty())
     return nullptr;
 
-  Entry& entry = cache_[picture->uniqueID()];
+  auto insertion = cache_.emplace(picture->uniqueID(), Entry());
+  Entry& entry = insertion.first->second;
+  if (insertion.second) {
+    entry.lru_position = lru_.insert(lru_.begin(), picture->uniqueID());
+  }
 
   const bool size_matched = entry.physical_size == physical_size;
 
-  entry.used_this_frame = true;
+  MarkUsed(picture->uniqueID(), entry);
   entry.physical_size = physical_size;
 
+  // A previous session already proved this content cache-worthy on the
+  // current route; skip the access-count warmup so the cache warms on the
+  // first frame of the screen instead of the third.
+  const bool hinted = hints_ != nullptr && metadata != nullptr &&
+                      hints_->ShouldPrecache(metadata->content_hash);
+
   if (!size_matched) {
     entry.access_count = 1;
-    entry.image = nullptr;
-    return nullptr;
+    SetEntryImage(entry, nullptr);
+    if (!hinted) {
+      frame_statistics_.misses++;
+      return nullptr;
+    }
+  } else {
+    entry.access_count++;
   }
 
-  entry.access_count++;
+  if (hinted) {
+    entry.access_count = kRasterThreshold;
+  }
 
   if (entry.access_count >= kRasterThreshold) {
     // Saturate at the threshhold.
     entry.access_count = kRasterThreshold;
 
+    if (!entry.cost_estimated) {
+      entry.estimated_cost_us = metadata != nullptr
+                                    ? metadata->estimated_raster_cost_us
+                                    : EstimatePictureRasterCost(picture);
+      entry.cost_estimated = true;
+    }
+
     if (!entry.image && !will_change &&
-        (is_complex || isWorthRasterizing(picture))) {
+        (is_complex ||
+         IsWorthRasterizing(picture, entry.estimated_cost_us, scaleX,
+                            scaleY))) {
+      // The admission decision is made; remember it for the next session
+      // regardless of which fill path (sync, async, or deferred) runs it.
+      if (hints_ != nullptr && metadata != nullptr) {
+        hints_->RecordCached(metadata->content_hash, scaleX, scaleY);
+      }
+      if (persistent_cache_) {
+        if (entry.persistent_key == 0) {
+          entry.persistent_key = PersistentRasterCache::ComputePictureKey(
+              picture, scaleX, scaleY);
+        }
+        sk_sp<SkImage> persisted =
+            persistent_cache_->Load(entry.persistent_key);
+        if (persisted && persisted->dimensions() == physical_size) {
+          SetEntryImage(entry, std::move(persisted));
+          frame_statistics_.hits++;
+          return entry.image;
+        }
+      }
+      if (async_rasterization_) {
+        if (!entry.rasterization_pending) {
+          EnqueueRasterJob(picture, entry, scaleX, scaleY);
+        }
+        // Miss for this frame; the worker result is installed on the GPU
+        // thread and will be served from the cache on a subsequent frame.
+        frame_statistics_.misses++;
+        return nullptr;
+      }
+      if (frame_fill_budget_micros_ > 0 &&
+          frame_statistics_.rasterization_microseconds > 0 &&
+          frame_statistics_.rasterization_microseconds +
+                  ScaledRasterCost(entry.estimated_cost_us, scaleX, scaleY) >
+              frame_fill_budget_micros_) {
+        // This frame's fill budget is spent. Replay the picture directly
+        // now and fill its entry on a later frame once budget is available.
+        TRACE_EVENT_INSTANT0("flutter", "RasterCacheFillDeferred");
+        frame_statistics_.deferred_fills++;
+        frame_statistics_.misses++;
+        return nullptr;
+      }
       TRACE_EVENT2("flutter", "Rasterize picture layer", "width",
                    std::to_string(physical_size.width()).c_str(), "height",
                    std::to_string(physical_size.height()).c_str());
+      ftl::TimePoint rasterization_start = ftl::TimePoint::Now();
       SkImageInfo info = SkImageInfo::MakeN32Premul(physical_size);
       sk_sp<SkSurface> surface =
           SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, info);
@@ -87,30 +213,170 @@ sk_sp<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
         if (checkerboard_images_) {
           DrawCheckerboard(canvas, rect);
         }
-        entry.image = surface->makeImageSnapshot();
+        SetEntryImage(entry, surface->makeImageSnapshot());
+        frame_statistics_.rasterization_microseconds +=
+            (ftl::TimePoint::Now() - rasterization_start).ToMicroseconds();
+        if (persistent_cache_) {
+          persistent_cache_->Store(entry.persistent_key, entry.image);
+        }
       }
     }
   }
 
+  if (entry.image) {
+    frame_statistics_.hits++;
+  } else {
+    frame_statistics_.misses++;
+  }
+
   return entry.image;
 }
 
+void RasterCache::EnqueueRasterJob(SkPicture* picture,
+                                   Entry& entry,
+                                   SkScalar scale_x,
+                                   SkScalar scale_y) {
+  if (raster_workers_.empty()) {
+    for (size_t i = 0; i < kRasterWorkerCount; i++) {
+      raster_workers_.emplace_back(std::make_unique<fml::Thread>(
+          "io.flutter.raster_worker." + std::to_string(i + 1)));
+    }
+  }
+
+  entry.rasterization_pending = true;
+
+  sk_sp<SkPicture> job_picture = sk_ref_sp(picture);
+  const uint32_t picture_id = picture->uniqueID();
+  const SkRect rect = picture->cullRect();
+  const SkISize physical_size = entry.physical_size;
+  const bool checkerboard = checkerboard_images_;
+  ftl::WeakPtr<RasterCache> weak_cache = weak_factory_.GetWeakPtr();
+
+  raster_workers_[next_raster_worker_]->GetTaskRunner()->PostTask([
+    weak_cache, job_picture, picture_id, rect, physical_size, scale_x, scale_y,
+    checkerboard
+  ]() {
+    TRACE_EVENT2("flutter", "Rasterize picture layer (async)", "width",
+                 std::to_string(physical_size.width()).c_str(), "height",
+                 std::to_string(physical_size.height()).c_str());
+    ftl::TimePoint rasterization_start = ftl::TimePoint::Now();
+    SkImageInfo info = SkImageInfo::MakeN32Premul(physical_size);
+    sk_sp<SkSurface> surface = SkSurface::MakeRaster(info);
+    sk_sp<SkImage> image;
+    if (surface) {
+      SkCanvas* canvas = surface->getCanvas();
+      canvas->clear(SK_ColorTRANSPARENT);
+      canvas->scale(scale_x, scale_y);
+      canvas->translate(-rect.left(), -rect.top());
+      canvas->drawPicture(job_picture.get());
+      if (checkerboard) {
+        DrawCheckerboard(canvas, rect);
+      }
+      image = surface->makeImageSnapshot();
+    }
+    const int64_t rasterization_microseconds =
+        (ftl::TimePoint::Now() - rasterization_start).ToMicroseconds();
+    blink::Threads::Gpu()->PostTask([
+      weak_cache, picture_id, physical_size, image, rasterization_microseconds
+    ]() {
+      if (weak_cache) {
+        weak_cache->OnRasterJobComplete(picture_id, physical_size, image,
+                                        rasterization_microseconds);
+      }
+    });
+  });
+  next_raster_worker_ = (next_raster_worker_ + 1) % raster_workers_.size();
+}
+
+void RasterCache::OnRasterJobComplete(uint32_t picture_id,
+                                      SkISize physical_size,
+                                      sk_sp<SkImage> image,
+                                      int64_t rasterization_microseconds) {
+  frame_statistics_.rasterization_microseconds += rasterization_microseconds;
+  auto found = cache_.find(picture_id);
+  if (found == cache_.end()) {
+    // The entry was evicted while its job was in flight. Drop the result.
+    return;
+  }
+  Entry& entry = found->second;
+  entry.rasterization_pending = false;
+  if (entry.physical_size != physical_size) {
+    // The picture was prerolled at a different scale since the job was
+    // enqueued. A fresh job will be issued on the next preroll.
+    return;
+  }
+  SetEntryImage(entry, std::move(image));
+  if (persistent_cache_ && entry.image) {
+    persistent_cache_->Store(entry.persistent_key, entry.image);
+  }
+}
+
+void RasterCache::SetAsyncRasterization(bool enabled) {
+  async_rasterization_ = enabled;
+}
+
+void RasterCache::SetFrameFillBudget(int64_t budget_microseconds) {
+  frame_fill_budget_micros_ = budget_microseconds > 0 ? budget_microseconds : 0;
+}
+
+void RasterCache::EvictUntilWithinBudget() {
+  while (current_bytes_ > max_bytes_ && !lru_.empty()) {
+    auto found = cache_.find(lru_.back());
+    FTL_DCHECK(found != cache_.end());
+    // Entries touched this frame are at the front of the list. Never evict
+    // them, even if the budget cannot be met, since callers hold references
+    // to their images for the current frame.
+    if (found->second.last_used_frame == frame_number_)
+      break;
+    current_bytes_ -= found->second.image_bytes;
+    cache_.erase(found);
+    lru_.pop_back();
+    frame_statistics_.evictions++;
+  }
+}
+
 void RasterCache::SweepAfterFrame() {
-  std::vector<Cache::iterator> dead;
+  if (max_bytes_ == 0) {
+    // Legacy behavior: evict everything that was not used this frame.
+    std::vector<Cache::iterator> dead;
 
-  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
-    Entry& entry = it->second;
-    if (!entry.used_this_frame)
-      dead.push_back(it);
-    entry.used_this_frame = false;
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+      if (it->second.last_used_frame != frame_number_)
+        dead.push_back(it);
+    }
+
+    for (auto it : dead) {
+      current_bytes_ -= it->second.image_bytes;
+      lru_.erase(it->second.lru_position);
+      cache_.erase(it);
+      frame_statistics_.evictions++;
+    }
+    frame_number_++;
+    return;
   }
 
-  for (auto it : dead)
-    cache_.erase(it);
+  EvictUntilWithinBudget();
+
+  // Entries record the frame number they were last used on, so opening a
+  // new frame makes every entry "unused" without walking the map.
+  frame_number_++;
+}
+
+void RasterCache::OnPictureDisposed(uint32_t picture_id) {
+  auto found = cache_.find(picture_id);
+  if (found == cache_.end()) {
+    return;
+  }
+  current_bytes_ -= found->second.image_bytes;
+  lru_.erase(found->second.lru_position);
+  cache_.erase(found);
+  frame_statistics_.evictions++;
 }
 
 void RasterCache::Clear() {
   cache_.clear();
+  lru_.clear();
+  current_bytes_ = 0;
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
@@ -125,4 +391,23 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetPersistentCacheDirectory(const std::string& directory) {
+  if (directory.empty()) {
+    persistent_cache_.reset();
+    return;
+  }
+  persistent_cache_ = std::make_unique<PersistentRasterCache>(directory);
+}
+
+void RasterCache::SetHints(RasterCacheHints* hints) {
+  hints_ = hints;
+}
+
+void RasterCache::SetCacheByteBudget(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  if (max_bytes_ > 0)
+    EvictUntilWithinBudget();
+}
+
 }  // namespace flow
+
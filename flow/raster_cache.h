@@ -5,10 +5,15 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/persistent_raster_cache.h"
+#include "flutter/flow/picture_raster_cost.h"
+#include "flutter/fml/thread.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -16,37 +21,145 @@
 
 namespace flow {
 
+class RasterCacheHints;
+
 class RasterCache {
  public:
   RasterCache();
   ~RasterCache();
 
+  // |metadata| is the recording-time analysis of |picture| when the caller
+  // has one, or nullptr to let the cache analyze the picture itself on first
+  // consideration.
   sk_sp<SkImage> GetPrerolledImage(GrContext* context,
                                    SkPicture* picture,
                                    const SkMatrix& ctm,
                                    bool is_complex,
-                                   bool will_change);
+                                   bool will_change,
+                                   const PictureMetadata* metadata);
   void SweepAfterFrame();
 
+  // Invoked on the GPU thread by the picture registry when the last live
+  // wrapper of a picture dies. Releases the picture's entry immediately so
+  // an aborted animation's images do not linger until eviction.
+  void OnPictureDisposed(uint32_t picture_id);
+
   void Clear();
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  // Sets the maximum number of bytes of rasterized images this cache may
+  // keep resident. Entries are evicted in least-recently-used order once the
+  // budget is exceeded. A budget of zero disables byte-based eviction and
+  // restores the legacy sweep behavior of evicting everything not used in
+  // the current frame.
+  void SetCacheByteBudget(size_t max_bytes);
+
+  size_t GetCacheByteBudget() const { return max_bytes_; }
+
+  size_t GetCachedBytes() const { return current_bytes_; }
+
+  // When enabled, newly cacheable pictures are rasterized in software on a
+  // small worker pool instead of synchronously on the GPU thread during
+  // preroll. GetPrerolledImage() reports a miss for the frame in which the
+  // job is enqueued and starts returning the cached image once the worker
+  // result has been delivered back to the GPU thread.
+  void SetAsyncRasterization(bool enabled);
+
+  // Limits the synchronous cache-fill time spent per frame on the GPU
+  // thread. Once the budget is exhausted, remaining cacheable pictures are
+  // replayed directly for the frame and their cache entries are filled
+  // progressively on later frames, most of the frame committing on time
+  // instead of stalling behind a burst of fills. At least one fill is
+  // allowed per frame so arbitrarily expensive pictures still converge. A
+  // budget of zero (the default) fills eagerly as before.
+  void SetFrameFillBudget(int64_t budget_microseconds);
+
+  int64_t GetFrameFillBudget() const { return frame_fill_budget_micros_; }
+
+  // Enables the optional disk-backed cache tier, layered under the in-memory
+  // cache. Entries are keyed by picture content hash so rasterizations of
+  // static content survive process restarts. The directory must already
+  // exist.
+  void SetPersistentCacheDirectory(const std::string& directory);
+
+  // Attaches the per-route hint store (not owned; may be null). Pictures
+  // whose content hash the store remembers as cache-worthy skip the
+  // access-count warmup and are rasterized the first frame they appear;
+  // admissions are reported back so the next session learns from this one.
+  void SetHints(RasterCacheHints* hints);
+
+  // Counts accumulated over the current frame. Sampled and reset by the
+  // compositor context at the end of each frame so cache behavior can be
+  // graphed by the performance overlay and exported to telemetry.
+  struct FrameStatistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    // Fills pushed to a later frame by the frame fill budget.
+    size_t deferred_fills = 0;
+    int64_t rasterization_microseconds = 0;
+  };
+
+  const FrameStatistics& frame_statistics() const { return frame_statistics_; }
+
+  void ResetFrameStatistics() { frame_statistics_ = FrameStatistics(); }
+
  private:
   struct Entry {
     Entry();
     ~Entry();
 
-    bool used_this_frame = false;
+    // Frame number this entry was last prerolled on; compared against the
+    // cache's current frame number so opening a new frame needs no
+    // per-entry flag reset.
+    uint64_t last_used_frame = 0;
+    bool rasterization_pending = false;
     int access_count = 0;
+    size_t image_bytes = 0;
+    // Memoized content-hash key for the persistent tier; zero when unknown.
+    uint64_t persistent_key = 0;
+    // Memoized unit-scale rasterization cost estimate in microseconds.
+    uint64_t estimated_cost_us = 0;
+    bool cost_estimated = false;
     SkISize physical_size;
     sk_sp<SkImage> image;
+    // Position of this entry within |lru_|. Most recently used entries are
+    // at the front of the list.
+    std::list<uint32_t>::iterator lru_position;
   };
 
   using Cache = std::unordered_map<uint32_t, Entry>;
 
+  void MarkUsed(uint32_t picture_id, Entry& entry);
+  void SetEntryImage(Entry& entry, sk_sp<SkImage> image);
+  void EvictUntilWithinBudget();
+  void EnqueueRasterJob(SkPicture* picture,
+                        Entry& entry,
+                        SkScalar scale_x,
+                        SkScalar scale_y);
+  void OnRasterJobComplete(uint32_t picture_id,
+                           SkISize physical_size,
+                           sk_sp<SkImage> image,
+                           int64_t rasterization_microseconds);
+
   Cache cache_;
+  uint64_t frame_number_ = 1;
+  // Access-ordered list of picture ids. The front of the list holds the most
+  // recently used entry and the back holds the eviction candidate.
+  std::list<uint32_t> lru_;
+  size_t max_bytes_;
+  size_t current_bytes_;
+  int64_t frame_fill_budget_micros_;
   bool checkerboard_images_;
+  bool async_rasterization_;
+  FrameStatistics frame_statistics_;
+  std::unique_ptr<PersistentRasterCache> persistent_cache_;
+  RasterCacheHints* hints_ = nullptr;
+  // Lazily created software rasterization workers. Jobs are dispatched
+  // round-robin and results are posted back to the GPU thread.
+  std::vector<std::unique_ptr<fml::Thread>> raster_workers_;
+  size_t next_raster_worker_;
   ftl::WeakPtrFactory<RasterCache> weak_factory_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(RasterCache);
@@ -0,0 +1,149 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_hints.h"
+
+#include <stdio.h>
+
+#include <vector>
+
+namespace flow {
+
+namespace {
+
+// File layout: header, then per route a name and its hint entries. All
+// integers are little-endian host format; the file never travels between
+// machines.
+const uint32_t kHintFileMagic = 0x464C5248;  // 'FLRH'
+const uint32_t kHintFileVersion = 1;
+
+bool ReadExact(FILE* file, void* buffer, size_t size) {
+  return fread(buffer, size, 1, file) == 1;
+}
+
+bool WriteExact(FILE* file, const void* buffer, size_t size) {
+  return fwrite(buffer, size, 1, file) == 1;
+}
+
+}  // namespace
+
+RasterCacheHints::RasterCacheHints() {}
+
+RasterCacheHints::~RasterCacheHints() {}
+
+bool RasterCacheHints::Load(const std::string& path) {
+  routes_.clear();
+
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t route_count = 0;
+  bool ok = ReadExact(file, &magic, sizeof(magic)) &&
+            ReadExact(file, &version, sizeof(version)) &&
+            ReadExact(file, &route_count, sizeof(route_count)) &&
+            magic == kHintFileMagic && version == kHintFileVersion;
+
+  for (uint32_t i = 0; ok && i < route_count; i++) {
+    uint32_t name_length = 0;
+    ok = ReadExact(file, &name_length, sizeof(name_length));
+    std::vector<char> name(name_length);
+    if (ok && name_length > 0) {
+      ok = ReadExact(file, name.data(), name_length);
+    }
+    uint32_t entry_count = 0;
+    ok = ok && ReadExact(file, &entry_count, sizeof(entry_count));
+    if (!ok) {
+      break;
+    }
+    RouteHints& hints = routes_[std::string(name.data(), name_length)];
+    for (uint32_t j = 0; ok && j < entry_count; j++) {
+      uint64_t content_hash = 0;
+      Hint hint;
+      ok = ReadExact(file, &content_hash, sizeof(content_hash)) &&
+           ReadExact(file, &hint.scale_x, sizeof(hint.scale_x)) &&
+           ReadExact(file, &hint.scale_y, sizeof(hint.scale_y));
+      if (ok) {
+        hints[content_hash] = hint;
+      }
+    }
+  }
+
+  fclose(file);
+  if (!ok) {
+    routes_.clear();
+  }
+  return ok;
+}
+
+bool RasterCacheHints::Save(const std::string& path) const {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  uint32_t route_count = routes_.size();
+  bool ok = WriteExact(file, &kHintFileMagic, sizeof(kHintFileMagic)) &&
+            WriteExact(file, &kHintFileVersion, sizeof(kHintFileVersion)) &&
+            WriteExact(file, &route_count, sizeof(route_count));
+
+  for (auto it = routes_.begin(); ok && it != routes_.end(); ++it) {
+    uint32_t name_length = it->first.size();
+    ok = WriteExact(file, &name_length, sizeof(name_length)) &&
+         (name_length == 0 ||
+          WriteExact(file, it->first.data(), name_length));
+    uint32_t entry_count = it->second.size();
+    ok = ok && WriteExact(file, &entry_count, sizeof(entry_count));
+    for (auto entry = it->second.begin(); ok && entry != it->second.end();
+         ++entry) {
+      ok = WriteExact(file, &entry->first, sizeof(entry->first)) &&
+           WriteExact(file, &entry->second.scale_x,
+                      sizeof(entry->second.scale_x)) &&
+           WriteExact(file, &entry->second.scale_y,
+                      sizeof(entry->second.scale_y));
+    }
+  }
+
+  fclose(file);
+  return ok;
+}
+
+void RasterCacheHints::SetCurrentRoute(const std::string& route) {
+  current_route_ = route;
+}
+
+bool RasterCacheHints::ShouldPrecache(uint64_t content_hash) const {
+  if (content_hash == 0) {
+    return false;
+  }
+  auto route = routes_.find(current_route_);
+  if (route != routes_.end() && route->second.count(content_hash) > 0) {
+    return true;
+  }
+  if (!current_route_.empty()) {
+    // Pictures cached before any route was pushed (e.g. on the launch
+    // screen) live under the empty name.
+    route = routes_.find(std::string());
+    if (route != routes_.end() && route->second.count(content_hash) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RasterCacheHints::RecordCached(uint64_t content_hash,
+                                    SkScalar scale_x,
+                                    SkScalar scale_y) {
+  if (content_hash == 0) {
+    return;
+  }
+  Hint& hint = routes_[current_route_][content_hash];
+  hint.scale_x = scale_x;
+  hint.scale_y = scale_y;
+}
+
+}  // namespace flow
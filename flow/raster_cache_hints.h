@@ -0,0 +1,72 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_HINTS_H_
+#define FLUTTER_FLOW_RASTER_CACHE_HINTS_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkScalar.h"
+
+namespace flow {
+
+// Raster cache admission decisions learned in one session and replayed in
+// the next. The cache normally waits for a picture to survive three frames
+// before rasterizing it, so every screen pays a warmup on first entry. The
+// hint store remembers which picture content hashes earned a cache entry
+// (and at what scale), keyed by the route name the embedder supplies, and
+// the cache skips the warmup for hinted pictures on the next launch.
+//
+// Content hashes come from the recording-time picture analysis and are
+// stable across sessions for byte-identical recordings, unlike picture
+// uniqueIDs. Owned by the rasterizer and used only on the GPU thread.
+class RasterCacheHints {
+ public:
+  RasterCacheHints();
+
+  ~RasterCacheHints();
+
+  // Replaces the store's contents with the hints previously saved at
+  // |path|. Returns false (leaving the store empty) if the file is missing
+  // or malformed, which is the expected first-launch case.
+  bool Load(const std::string& path);
+
+  // Writes the store to |path|, replacing any previous file.
+  bool Save(const std::string& path) const;
+
+  // Sets the route whose hints subsequent lookups and recordings apply to.
+  // Hints recorded before any route is pushed live under the empty route
+  // name, which is also consulted as a fallback by ShouldPrecache().
+  void SetCurrentRoute(const std::string& route);
+
+  // True if |content_hash| earned a cache entry on the current route (or
+  // outside any route) in a previous session.
+  bool ShouldPrecache(uint64_t content_hash) const;
+
+  // Records that |content_hash| was admitted to the cache at the given
+  // scale on the current route. The scale of the most recent admission is
+  // kept as the picture's typical scale.
+  void RecordCached(uint64_t content_hash, SkScalar scale_x, SkScalar scale_y);
+
+ private:
+  struct Hint {
+    SkScalar scale_x = 1.0f;
+    SkScalar scale_y = 1.0f;
+  };
+
+  using RouteHints = std::unordered_map<uint64_t, Hint>;
+
+  std::string current_route_;
+  std::unordered_map<std::string, RouteHints> routes_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(RasterCacheHints);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_HINTS_H_
@@ -10,7 +10,9 @@
 #include "apps/mozart/lib/skia/type_converters.h"
 #include "apps/mozart/services/composition/scenes.fidl.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/tiled_raster.h"
 #include "flutter/glue/trace_event.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flow {
 
@@ -22,9 +24,40 @@ void SceneUpdateContext::CurrentPaintTask::Clear() {
   layers.clear();
 }
 
+void SceneUpdateContext::ResourceCache::Reset() {
+  scenes_.clear();
+  transient_ids_.clear();
+  next_resource_id_ = 1;
+}
+
 SceneUpdateContext::SceneUpdateContext(mozart::SceneUpdate* update,
-                                       SurfaceProducer* surface_producer)
-    : update_(update), surface_producer_(surface_producer) {}
+                                       SurfaceProducer* surface_producer,
+                                       ResourceCache* resource_cache)
+    : update_(update),
+      surface_producer_(surface_producer),
+      resource_cache_(resource_cache) {
+  if (!resource_cache_)
+    return;
+
+  // Open this frame's delta: retire the previous frame's single-frame
+  // resources, and evict cached resources the previous frame stopped
+  // referencing. A null map entry removes the resource on the compositor
+  // side.
+  for (uint32_t id : resource_cache_->transient_ids_)
+    update_->resources.insert(id, nullptr);
+  resource_cache_->transient_ids_.clear();
+
+  for (auto it = resource_cache_->scenes_.begin();
+       it != resource_cache_->scenes_.end();) {
+    if (!it->second.used_this_frame) {
+      update_->resources.insert(it->second.resource_id, nullptr);
+      it = resource_cache_->scenes_.erase(it);
+    } else {
+      it->second.used_this_frame = false;
+      ++it;
+    }
+  }
+}
 
 SceneUpdateContext::~SceneUpdateContext() = default;
 
@@ -87,9 +120,42 @@ mozart::NodePtr SceneUpdateContext::FinalizeCurrentPaintTask(
   return node;
 }
 
+uint32_t SceneUpdateContext::AllocateResourceId() {
+  return resource_cache_ ? resource_cache_->next_resource_id_++
+                         : next_resource_id_++;
+}
+
 uint32_t SceneUpdateContext::AddResource(mozart::ResourcePtr resource) {
-  uint32_t resource_id = next_resource_id_++;
+  uint32_t resource_id = AllocateResourceId();
+  update_->resources.insert(resource_id, std::move(resource));
+  // Plain resources are only valid for this frame; schedule their removal in
+  // the next frame's delta.
+  if (resource_cache_)
+    resource_cache_->transient_ids_.push_back(resource_id);
+  return resource_id;
+}
+
+uint32_t SceneUpdateContext::AddSceneResource(uint32_t scene_token_value) {
+  if (resource_cache_) {
+    auto it = resource_cache_->scenes_.find(scene_token_value);
+    if (it != resource_cache_->scenes_.end()) {
+      // Already exported by an earlier frame; reference it without re-sending.
+      it->second.used_this_frame = true;
+      return it->second.resource_id;
+    }
+  }
+
+  auto resource = mozart::Resource::New();
+  resource->set_scene(mozart::SceneResource::New());
+  resource->get_scene()->scene_token = mozart::SceneToken::New();
+  resource->get_scene()->scene_token->value = scene_token_value;
+
+  if (!resource_cache_)
+    return AddResource(std::move(resource));
+
+  uint32_t resource_id = AllocateResourceId();
   update_->resources.insert(resource_id, std::move(resource));
+  resource_cache_->scenes_[scene_token_value] = {resource_id, true};
   return resource_id;
 }
 
@@ -100,6 +166,22 @@ void SceneUpdateContext::AddChildNode(mozart::Node* container,
   container->child_node_ids.push_back(node_id);
 }
 
+void SceneUpdateContext::PaintTaskLayers(const PaintTask& task,
+                                         CompositorContext::ScopedFrame& frame,
+                                         SkCanvas* canvas) {
+  Layer::PaintContext context = {*canvas, frame.context().frame_time(),
+                                 frame.context().engine_time(),
+                                 frame.context().gpu_time(),
+                                 frame.context().memory_usage(),
+                                 false};
+
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->scale(task.scaleX, task.scaleY);
+  canvas->translate(-task.left, -task.top);
+  for (Layer* layer : task.layers)
+    layer->Paint(context);
+}
+
 void SceneUpdateContext::ExecutePaintTasks(
     CompositorContext::ScopedFrame& frame) {
   TRACE_EVENT0("flutter", "SceneUpdateContext::ExecutePaintTasks");
@@ -107,16 +189,25 @@ void SceneUpdateContext::ExecutePaintTasks(
   for (auto& task : paint_tasks_) {
     FTL_DCHECK(task.surface);
     SkCanvas* canvas = task.surface->getCanvas();
-    Layer::PaintContext context = {*canvas, frame.context().frame_time(),
-                                   frame.context().engine_time(),
-                                   frame.context().memory_usage(),
-                                   false};
-
-    canvas->clear(SK_ColorTRANSPARENT);
-    canvas->scale(task.scaleX, task.scaleY);
-    canvas->translate(-task.left, -task.top);
-    for (Layer* layer : task.layers)
-      layer->Paint(context);
+
+    SkPixmap pixmap;
+    if (canvas->peekPixels(&pixmap)) {
+      // Software surface. Record the layers once and replay the picture in
+      // tiles across the worker pool so raster scales with cores.
+      SkPictureRecorder recorder;
+      PaintTaskLayers(task, frame,
+                      recorder.beginRecording(SkRect::MakeIWH(
+                          task.surface->width(), task.surface->height())));
+      sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+      if (!RasterPictureTiled(picture.get(), task.surface.get())) {
+        // Frame too small to tile or only one core; replay in place.
+        picture->playback(canvas);
+      }
+      canvas->flush();
+      continue;
+    }
+
+    PaintTaskLayers(task, frame, canvas);
     canvas->flush();
   }
 
@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_MOZART_SCENE_UPDATE_CONTEXT_H_
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/flow/compositor_context.h"
@@ -42,8 +43,38 @@ class SceneUpdateContext {
                                             mozart::ImagePtr* out_image) = 0;
   };
 
+  // Retains exported resource ids across frames so a stable UI re-sends only
+  // deltas. Owned by the rasterizer and handed to each frame's
+  // SceneUpdateContext; the update must then be published with
+  // |clear_resources| unset. Resources whose content is stable across frames
+  // (currently child scene resources, keyed by scene token) are referenced by
+  // their existing id without being re-exported; resources the previous frame
+  // stopped referencing are removed by inserting a null entry.
+  class ResourceCache {
+   public:
+    // Forgets all exported ids, e.g. after binding a new scene that has no
+    // knowledge of them.
+    void Reset();
+
+   private:
+    friend class SceneUpdateContext;
+
+    struct SceneEntry {
+      uint32_t resource_id;
+      bool used_this_frame;
+    };
+
+    // Child scene resources keyed by scene token value.
+    std::unordered_map<uint32_t, SceneEntry> scenes_;
+    // Ids whose resources are valid for a single frame (e.g. images backed by
+    // that frame's buffers); retired in the next frame's update.
+    std::vector<uint32_t> transient_ids_;
+    uint32_t next_resource_id_ = 1;
+  };
+
   SceneUpdateContext(mozart::SceneUpdate* update,
-                     SurfaceProducer* surface_producer);
+                     SurfaceProducer* surface_producer,
+                     ResourceCache* resource_cache = nullptr);
   ~SceneUpdateContext();
 
   mozart::SceneUpdate* update() const { return update_; }
@@ -53,6 +84,10 @@ class SceneUpdateContext {
                                         const SkMatrix& ctm);
 
   uint32_t AddResource(mozart::ResourcePtr resource);
+
+  // Returns the resource id of a scene resource for |scene_token_value|,
+  // exporting it only if it is not already cached from an earlier frame.
+  uint32_t AddSceneResource(uint32_t scene_token_value);
   void AddChildNode(mozart::Node* container, mozart::NodePtr child);
 
   void ExecutePaintTasks(CompositorContext::ScopedFrame& frame);
@@ -60,6 +95,16 @@ class SceneUpdateContext {
  private:
   mozart::NodePtr FinalizeCurrentPaintTask(const SkMatrix& ctm);
 
+  uint32_t AllocateResourceId();
+
+  struct PaintTask;
+
+  // Paints |task|'s layers into |canvas|, which is either the task surface's
+  // own canvas or a recording canvas when the paint is replayed in tiles.
+  void PaintTaskLayers(const PaintTask& task,
+                       CompositorContext::ScopedFrame& frame,
+                       SkCanvas* canvas);
+
   struct CurrentPaintTask {
     CurrentPaintTask();
     void Clear();
@@ -79,6 +124,7 @@ class SceneUpdateContext {
 
   mozart::SceneUpdate* update_;
   SurfaceProducer* surface_producer_;
+  ResourceCache* resource_cache_;
 
   CurrentPaintTask current_paint_task_;
   std::vector<PaintTask> paint_tasks_;
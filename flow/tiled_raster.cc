@@ -0,0 +1,92 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/tiled_raster.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "flutter/fml/thread_pool.h"
+#include "flutter/glue/trace_event.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flow {
+namespace {
+
+// Tile edge in pixels. Small enough that typical frames produce several tiles
+// per core, large enough that the per-tile replay overhead stays negligible.
+constexpr int kTileSize = 256;
+
+}  // namespace
+
+bool RasterPictureTiled(SkPicture* picture, SkSurface* surface) {
+  fml::ThreadPool& pool = fml::ThreadPool::GetSharedWorkerPool();
+  const size_t worker_count = pool.GetWorkerCount();
+  if (worker_count < 2)
+    return false;
+
+  SkImageInfo info;
+  size_t row_bytes = 0;
+  void* pixels = surface->getCanvas()->accessTopLayerPixels(&info, &row_bytes);
+  if (pixels == nullptr)
+    return false;
+
+  const int width = info.width();
+  const int height = info.height();
+  const int columns = (width + kTileSize - 1) / kTileSize;
+  const int rows = (height + kTileSize - 1) / kTileSize;
+  const int tile_count = columns * rows;
+  if (tile_count < 2)
+    return false;
+
+  TRACE_EVENT0("flutter", "RasterPictureTiled");
+
+  // Workers (and the calling thread) claim tiles off a shared counter. Each
+  // tile is replayed through a canvas wrapping just that tile's pixels, so
+  // the tile bounds act as the clip and no two tiles touch the same memory.
+  // Pictures are immutable and safe to play back concurrently.
+  std::atomic<int> next_tile(0);
+  auto raster_tiles = [picture, pixels, row_bytes, &info, width, height,
+                       columns, tile_count, &next_tile]() {
+    int tile;
+    while ((tile = next_tile.fetch_add(1)) < tile_count) {
+      const int left = (tile % columns) * kTileSize;
+      const int top = (tile / columns) * kTileSize;
+      SkImageInfo tile_info = info.makeWH(std::min(kTileSize, width - left),
+                                          std::min(kTileSize, height - top));
+      void* tile_pixels = static_cast<char*>(pixels) + top * row_bytes +
+                          left * info.bytesPerPixel();
+      SkBitmap tile_bitmap;
+      tile_bitmap.installPixels(tile_info, tile_pixels, row_bytes);
+      SkCanvas tile_canvas(tile_bitmap);
+      tile_canvas.translate(-left, -top);
+      picture->playback(&tile_canvas);
+    }
+  };
+
+  // Captures by reference are safe: this thread does not return until every
+  // posted task has run.
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t busy_workers = worker_count - 1;
+  for (size_t i = 0; i < worker_count - 1; i++) {
+    pool.PostWorkerTask([&raster_tiles, &mutex, &done, &busy_workers]() {
+      raster_tiles();
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--busy_workers == 0)
+        done.notify_one();
+    });
+  }
+
+  raster_tiles();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&busy_workers]() { return busy_workers == 0; });
+  return true;
+}
+
+}  // namespace flow
@@ -0,0 +1,24 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_TILED_RASTER_H_
+#define FLUTTER_FLOW_TILED_RASTER_H_
+
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flow {
+
+// Rasterizes |picture| into |surface| by splitting the surface into tiles and
+// replaying the picture into every tile in parallel on the shared worker
+// pool, each replay clipped to its tile. Blocks until all tiles are painted.
+// Returns false without touching the surface when the parallel path does not
+// apply - the surface does not expose its pixels (it is GPU backed), only one
+// worker is available, or the frame is too small to yield more than one tile
+// - in which case the caller should paint single-threaded as usual.
+bool RasterPictureTiled(SkPicture* picture, SkSurface* surface);
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_TILED_RASTER_H_
@@ -13,11 +13,20 @@
 #include "lib/ftl/logging.h"
 #include "third_party/icu/source/common/unicode/udata.h"
 
+#if !defined(OS_WIN)
+#include <sys/resource.h>
+#endif  // !defined(OS_WIN)
+
 namespace fml {
 namespace icu {
 
 static constexpr char kIcuDataFileName[] = "icudtl.dat";
 
+// A trimmed data slice carrying only the locales the application declared,
+// produced at build time by sky/tools/trim_icu_data.py. Preferred over the
+// full data file when present (e.g. single-locale kiosk builds).
+static constexpr char kIcuMinimalDataFileName[] = "icudtl_minimal.dat";
+
 class ICUContext {
  public:
   ICUContext(const std::string& icu_data_path) : valid_(false) {
@@ -34,12 +43,16 @@ class ICUContext {
       return true;
     }
 
-    // Check to see if the mapping is in the resources bundle.
+    // Check to see if the mapping is in the resources bundle, preferring the
+    // trimmed slice over the full data file.
     if (PlatformHasResourcesBundle()) {
-      auto resource = GetResourceMapping(kIcuDataFileName);
-      if (resource != nullptr && resource->GetSize() != 0) {
-        mapping_ = std::move(resource);
-        return true;
+      for (const char* file_name :
+           {kIcuMinimalDataFileName, kIcuDataFileName}) {
+        auto resource = GetResourceMapping(file_name);
+        if (resource != nullptr && resource->GetSize() != 0) {
+          mapping_ = std::move(resource);
+          return true;
+        }
       }
     }
 
@@ -51,13 +64,15 @@ class ICUContext {
       return false;
     }
 
-    // FIXME(chinmaygarde): There is no Path::Join in FTL. So a non-portable
-    // version is used here. Patch FTL and update.
-    auto file = std::make_unique<FileMapping>(directory.second + "/" +
-                                              kIcuDataFileName);
-    if (file->GetSize() != 0) {
-      mapping_ = std::move(file);
-      return true;
+    for (const char* file_name : {kIcuMinimalDataFileName, kIcuDataFileName}) {
+      // FIXME(chinmaygarde): There is no Path::Join in FTL. So a non-portable
+      // version is used here. Patch FTL and update.
+      auto file =
+          std::make_unique<FileMapping>(directory.second + "/" + file_name);
+      if (file->GetSize() != 0) {
+        mapping_ = std::move(file);
+        return true;
+      }
     }
 
     return false;
@@ -68,6 +83,10 @@ class ICUContext {
       return false;
     }
 
+    // ICU touches the data sparsely (a few tables per locale), so fault in
+    // single pages on demand instead of reading ahead around every access.
+    mapping_->HintRandomAccess();
+
     UErrorCode err_code = U_ZERO_ERROR;
     udata_setCommonData(GetMapping(), &err_code);
     return (err_code == U_ZERO_ERROR);
@@ -89,8 +108,24 @@ class ICUContext {
 };
 
 void InitializeICUOnce(const std::string& icu_data_path) {
+#if !defined(OS_WIN)
+  struct rusage usage_before = {};
+  ::getrusage(RUSAGE_SELF, &usage_before);
+#endif  // !defined(OS_WIN)
+
   static ICUContext* context = new ICUContext(icu_data_path);
   FTL_CHECK(context->IsValid()) << "Must be able to initialize the ICU context";
+
+#if !defined(OS_WIN)
+  struct rusage usage_after = {};
+  ::getrusage(RUSAGE_SELF, &usage_after);
+  FTL_DLOG(INFO) << "ICU data initialized: " << context->GetSize()
+                 << " bytes mapped, "
+                 << (usage_after.ru_minflt - usage_before.ru_minflt)
+                 << " minor / "
+                 << (usage_after.ru_majflt - usage_before.ru_majflt)
+                 << " major page faults";
+#endif  // !defined(OS_WIN)
 }
 
 std::once_flag g_icu_init_flag;
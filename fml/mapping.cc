@@ -40,11 +40,32 @@ std::unique_ptr<Mapping> GetResourceMapping(const std::string& resource_name) {
 }
 
 FileMapping::FileMapping(const std::string& path)
-    : FileMapping(ftl::UniqueFD{HANDLE_EINTR(::open(path.c_str(), O_RDONLY))}) {
-}
+    : FileMapping(path, Protection::ReadOnly) {}
 
 FileMapping::FileMapping(const ftl::UniqueFD& handle)
-    : size_(0), mapping_(nullptr) {
+    : FileMapping(handle, Protection::ReadOnly) {}
+
+FileMapping::FileMapping(const std::string& path,
+                         Protection protection,
+                         size_t offset,
+                         size_t length)
+    : FileMapping(
+          ftl::UniqueFD{HANDLE_EINTR(::open(
+              path.c_str(),
+              protection == Protection::ReadWrite ? O_RDWR : O_RDONLY))},
+          protection,
+          offset,
+          length) {}
+
+FileMapping::FileMapping(const ftl::UniqueFD& handle,
+                         Protection protection,
+                         size_t offset,
+                         size_t length)
+    : size_(0),
+      mapping_(nullptr),
+      map_size_(0),
+      map_base_(nullptr),
+      writable_(protection != Protection::ReadOnly) {
   if (!handle.is_valid()) {
     return;
   }
@@ -55,24 +76,46 @@ FileMapping::FileMapping(const ftl::UniqueFD& handle)
     return;
   }
 
-  if (stat_buffer.st_size <= 0) {
+  const size_t file_size = stat_buffer.st_size;
+
+  if (file_size == 0 || offset >= file_size) {
+    return;
+  }
+
+  if (length == 0) {
+    length = file_size - offset;
+  }
+
+  if (offset + length > file_size) {
     return;
   }
 
-  auto mapping = ::mmap(nullptr, stat_buffer.st_size, PROT_READ, MAP_PRIVATE,
-                        handle.get(), 0);
+  // The mapped extent must be page aligned; unaligned windows map from the
+  // enclosing page boundary and expose a view into the extent.
+  const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  const size_t aligned_offset = offset & ~(page_size - 1);
+  const size_t alignment_slop = offset - aligned_offset;
+
+  const int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+  const int flags =
+      protection == Protection::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+
+  auto mapping = ::mmap(nullptr, length + alignment_slop, prot, flags,
+                        handle.get(), aligned_offset);
 
   if (mapping == MAP_FAILED) {
     return;
   }
 
-  mapping_ = static_cast<uint8_t*>(mapping);
-  size_ = stat_buffer.st_size;
+  map_base_ = static_cast<uint8_t*>(mapping);
+  map_size_ = length + alignment_slop;
+  mapping_ = map_base_ + alignment_slop;
+  size_ = length;
 }
 
 FileMapping::~FileMapping() {
-  if (mapping_ != nullptr) {
-    ::munmap(mapping_, size_);
+  if (map_base_ != nullptr) {
+    ::munmap(map_base_, map_size_);
   }
 }
 
@@ -84,4 +127,26 @@ const uint8_t* FileMapping::GetMapping() const {
   return mapping_;
 }
 
+uint8_t* FileMapping::GetMutableMapping() {
+  return writable_ ? mapping_ : nullptr;
+}
+
+void FileMapping::HintWillNeed() const {
+  if (map_base_ != nullptr) {
+    ::madvise(map_base_, map_size_, MADV_WILLNEED);
+  }
+}
+
+void FileMapping::HintDontNeed() const {
+  if (map_base_ != nullptr) {
+    ::madvise(map_base_, map_size_, MADV_DONTNEED);
+  }
+}
+
+void FileMapping::HintRandomAccess() const {
+  if (map_base_ != nullptr) {
+    ::madvise(map_base_, map_size_, MADV_RANDOM);
+  }
+}
+
 }  // namespace fml
@@ -22,6 +22,20 @@ class Mapping {
 
   virtual const uint8_t* GetMapping() const = 0;
 
+  // Advises the kernel that the mapped pages will be needed soon, so it may
+  // start faulting them in. A hint; mappings that cannot forward it to the
+  // kernel ignore it.
+  virtual void HintWillNeed() const {}
+
+  // Advises the kernel that the mapped pages are no longer needed and may
+  // be dropped from the page cache.
+  virtual void HintDontNeed() const {}
+
+  // Advises the kernel that accesses will be sparse and random, so it should
+  // fault in single pages on demand instead of reading ahead around every
+  // access.
+  virtual void HintRandomAccess() const {}
+
  private:
   FTL_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -32,19 +46,55 @@ std::unique_ptr<Mapping> GetResourceMapping(const std::string& resource_name);
 
 class FileMapping : public Mapping {
  public:
+  enum class Protection {
+    // A private read-only view of the file.
+    ReadOnly,
+    // A shared writable view; stores are carried through to the file.
+    ReadWrite,
+    // A private writable view; stores dirty anonymous copies of the
+    // affected pages and never reach the file.
+    CopyOnWrite,
+  };
+
   FileMapping(const std::string& path);
 
   FileMapping(const ftl::UniqueFD& fd);
 
+  // Maps a window of the file starting at |offset| (any alignment) spanning
+  // |length| bytes, or the remainder of the file if |length| is zero.
+  FileMapping(const std::string& path,
+              Protection protection,
+              size_t offset = 0,
+              size_t length = 0);
+
+  FileMapping(const ftl::UniqueFD& fd,
+              Protection protection,
+              size_t offset = 0,
+              size_t length = 0);
+
   ~FileMapping() override;
 
   size_t GetSize() const override;
 
   const uint8_t* GetMapping() const override;
 
+  // The same view as GetMapping, or null if the mapping is read-only.
+  uint8_t* GetMutableMapping();
+
+  void HintWillNeed() const override;
+
+  void HintDontNeed() const override;
+
+  void HintRandomAccess() const override;
+
  private:
   size_t size_;
   uint8_t* mapping_;
+  // The page-aligned extent handed back by mmap; the view above may start
+  // within its first page when the requested offset is unaligned.
+  size_t map_size_;
+  uint8_t* map_base_;
+  bool writable_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(FileMapping);
 };
@@ -63,6 +63,10 @@ ftl::RefPtr<MessageLoopImpl> MessageLoop::GetLoopImpl() const {
   return loop_;
 }
 
+void MessageLoop::SetFramePending(bool pending) {
+  loop_->SetFramePending(pending);
+}
+
 void MessageLoop::AddTaskObserver(TaskObserver* observer) {
   loop_->AddTaskObserver(observer);
 }
@@ -71,4 +75,13 @@ void MessageLoop::RemoveTaskObserver(TaskObserver* observer) {
   loop_->RemoveTaskObserver(observer);
 }
 
+void MessageLoop::SetSlowTaskThreshold(ftl::TimeDelta threshold) {
+  loop_->SetSlowTaskThreshold(threshold);
+}
+
+void MessageLoop::SetSlowTaskCallback(
+    std::function<void(ftl::TimeDelta)> callback) {
+  loop_->SetSlowTaskCallback(std::move(callback));
+}
+
 }  // namespace fml
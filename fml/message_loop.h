@@ -5,9 +5,12 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_H_
 #define FLUTTER_FML_MESSAGE_LOOP_H_
 
+#include <functional>
+
 #include "flutter/fml/task_observer.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/tasks/task_runner.h"
+#include "lib/ftl/time/time_delta.h"
 
 namespace fml {
 
@@ -24,10 +27,22 @@ class MessageLoop {
 
   void Terminate();
 
+  // Marks the start or end of a pending frame. While a frame is pending,
+  // idle-lane tasks (TaskRunner::PostIdleTask) are held back so background
+  // work cannot lengthen the frame. May be called from any thread.
+  void SetFramePending(bool pending);
+
   void AddTaskObserver(TaskObserver* observer);
 
   void RemoveTaskObserver(TaskObserver* observer);
 
+  // Configures the slow task detector: tasks that run longer than
+  // |threshold| emit an instant trace event and invoke the callback, if one
+  // is set. Must be called on the loop's own thread.
+  void SetSlowTaskThreshold(ftl::TimeDelta threshold);
+
+  void SetSlowTaskCallback(std::function<void(ftl::TimeDelta)> callback);
+
   ftl::RefPtr<ftl::TaskRunner> GetTaskRunner() const;
 
   static void EnsureInitializedForCurrentThread();
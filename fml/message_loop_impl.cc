@@ -5,6 +5,7 @@
 #include "flutter/fml/message_loop_impl.h"
 
 #include <algorithm>
+#include <new>
 #include <vector>
 
 #include "flutter/fml/trace_event.h"
@@ -42,13 +43,110 @@ ftl::RefPtr<MessageLoopImpl> MessageLoopImpl::Create() {
   return ftl::MakeRefCounted<::PlatformMessageLoopImpl>();
 }
 
-MessageLoopImpl::MessageLoopImpl() : order_(0), terminated_(false) {}
+namespace {
+
+// Each wheel slot spans this interval; with kWheelSlotCount slots the wheel
+// covers a quarter second per revolution, which comfortably holds the
+// frame-scale timers that dominate in practice.
+const int64_t kWheelSlotIntervalMicros = 4000;
+
+// Tasks that keep the loop busy past one 60Hz frame interval are worth
+// flagging by default.
+const int64_t kDefaultSlowTaskThresholdMicros = 16667;
+
+size_t WheelSlotFor(ftl::TimePoint target_time) {
+  return (target_time.ToEpochDelta().ToMicroseconds() /
+          kWheelSlotIntervalMicros) %
+         MessageLoopImpl::kWheelSlotCount;
+}
+
+ftl::TimeDelta WheelHorizon() {
+  return ftl::TimeDelta::FromMicroseconds(kWheelSlotIntervalMicros *
+                                          MessageLoopImpl::kWheelSlotCount);
+}
+
+}  // namespace
+
+MessageLoopImpl::TaskNodeSlab::TaskNodeSlab()
+    : storage_(new char[kSlotCount * sizeof(DelayedTask)]),
+      free_ring_(new void*[kSlotCount]),
+      free_head_(0),
+      free_count_(kSlotCount) {
+  for (size_t i = 0; i < kSlotCount; i++) {
+    free_ring_[i] = storage_.get() + i * sizeof(DelayedTask);
+  }
+}
+
+MessageLoopImpl::TaskNodeSlab::~TaskNodeSlab() {
+  // All nodes must have been freed; the loop drains its queues before
+  // destruction.
+  FTL_DCHECK(free_count_ == kSlotCount);
+}
+
+void* MessageLoopImpl::TaskNodeSlab::Allocate() {
+  if (free_count_ == 0) {
+    return ::operator new(sizeof(DelayedTask));
+  }
+  void* slot = free_ring_[free_head_];
+  free_head_ = (free_head_ + 1) % kSlotCount;
+  free_count_--;
+  return slot;
+}
+
+void MessageLoopImpl::TaskNodeSlab::Free(DelayedTask* node) {
+  node->~DelayedTask();
+  char* address = reinterpret_cast<char*>(node);
+  if (address >= storage_.get() &&
+      address < storage_.get() + kSlotCount * sizeof(DelayedTask)) {
+    free_ring_[(free_head_ + free_count_) % kSlotCount] = address;
+    free_count_++;
+  } else {
+    ::operator delete(address);
+  }
+}
+
+MessageLoopImpl::MessageLoopImpl()
+    : slow_task_threshold_(
+          ftl::TimeDelta::FromMicroseconds(kDefaultSlowTaskThresholdMicros)),
+      wheel_task_count_(0),
+      order_(0),
+      terminated_(false),
+      frame_pending_(false) {}
 
 MessageLoopImpl::~MessageLoopImpl() = default;
 
-void MessageLoopImpl::PostTask(ftl::Closure task, ftl::TimePoint target_time) {
+void MessageLoopImpl::PostTask(ftl::Closure task,
+                               ftl::TimePoint target_time,
+                               TaskPriority priority) {
   FTL_DCHECK(task != nullptr);
-  RegisterTask(task, target_time);
+  RegisterTask(std::move(task), target_time, priority);
+}
+
+void MessageLoopImpl::SetFramePending(bool pending) {
+  frame_pending_ = pending;
+  if (!pending) {
+    // Idle tasks held back during the frame may already be due; recompute
+    // the wake-up with the idle lane eligible again.
+    ftl::MutexLocker lock(&delayed_tasks_mutex_);
+    WakeUp(NextTaskTimeLocked());
+  }
+}
+
+void MessageLoopImpl::PostTasks(std::vector<ftl::Closure> tasks,
+                                ftl::TimePoint target_time) {
+  if (tasks.empty() || terminated_) {
+    // If the message loop has already been terminated, PostTasks should
+    // destruct |tasks| synchronously within this function.
+    return;
+  }
+  ftl::MutexLocker lock(&delayed_tasks_mutex_);
+  auto now = ftl::TimePoint::Now();
+  for (auto& task : tasks) {
+    FTL_DCHECK(task != nullptr);
+    ScheduleTaskLocked(std::move(task), target_time, TaskPriority::kDefault,
+                       now);
+  }
+  WakeUp(NextTaskTimeLocked());
 }
 
 void MessageLoopImpl::RunExpiredTasksNow() {
@@ -71,6 +169,20 @@ void MessageLoopImpl::RemoveTaskObserver(TaskObserver* observer) {
   task_observers_.erase(observer);
 }
 
+void MessageLoopImpl::SetSlowTaskThreshold(ftl::TimeDelta threshold) {
+  FTL_DCHECK(MessageLoop::GetCurrent().GetLoopImpl().get() == this)
+      << "The slow task threshold must be set on the same thread as the "
+         "loop.";
+  slow_task_threshold_ = threshold;
+}
+
+void MessageLoopImpl::SetSlowTaskCallback(SlowTaskCallback callback) {
+  FTL_DCHECK(MessageLoop::GetCurrent().GetLoopImpl().get() == this)
+      << "The slow task callback must be set on the same thread as the "
+         "loop.";
+  slow_task_callback_ = callback;
+}
+
 void MessageLoopImpl::DoRun() {
   if (terminated_) {
     // Message loops may be run only once.
@@ -95,7 +207,21 @@ void MessageLoopImpl::DoRun() {
   // from the implementations |Run| method which we know is on the correct
   // thread. Drop all pending tasks on the floor.
   ftl::MutexLocker lock(&delayed_tasks_mutex_);
-  delayed_tasks_ = {};
+  for (auto& slot : wheel_slots_) {
+    DelayedTask* task = slot.head;
+    while (task != nullptr) {
+      DelayedTask* next = task->next;
+      task_slab_.Free(task);
+      task = next;
+    }
+    slot.head = slot.tail = nullptr;
+  }
+  wheel_task_count_ = 0;
+  while (!overflow_tasks_.empty()) {
+    DelayedTask* task = overflow_tasks_.top();
+    overflow_tasks_.pop();
+    task_slab_.Free(task);
+  }
 }
 
 void MessageLoopImpl::DoTerminate() {
@@ -104,7 +230,8 @@ void MessageLoopImpl::DoTerminate() {
 }
 
 void MessageLoopImpl::RegisterTask(ftl::Closure task,
-                                   ftl::TimePoint target_time) {
+                                   ftl::TimePoint target_time,
+                                   TaskPriority priority) {
   FTL_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
@@ -112,8 +239,57 @@ void MessageLoopImpl::RegisterTask(ftl::Closure task,
     return;
   }
   ftl::MutexLocker lock(&delayed_tasks_mutex_);
-  delayed_tasks_.push({++order_, std::move(task), target_time});
-  WakeUp(delayed_tasks_.top().target_time);
+  ScheduleTaskLocked(std::move(task), target_time, priority,
+                     ftl::TimePoint::Now());
+  WakeUp(NextTaskTimeLocked());
+}
+
+void MessageLoopImpl::ScheduleTaskLocked(ftl::Closure task,
+                                         ftl::TimePoint target_time,
+                                         TaskPriority priority,
+                                         ftl::TimePoint now) {
+  DelayedTask* node =
+      new (task_slab_.Allocate()) DelayedTask(++order_, std::move(task),
+                                              target_time, priority);
+  if (node->target_time >= now + WheelHorizon()) {
+    overflow_tasks_.push(node);
+    return;
+  }
+  AppendToWheelLocked(node);
+}
+
+void MessageLoopImpl::AppendToWheelLocked(DelayedTask* task) {
+  WheelSlot& slot = wheel_slots_[WheelSlotFor(task->target_time)];
+  task->next = nullptr;
+  if (slot.tail != nullptr) {
+    slot.tail->next = task;
+  } else {
+    slot.head = task;
+  }
+  slot.tail = task;
+  wheel_task_count_++;
+}
+
+ftl::TimePoint MessageLoopImpl::NextTaskTimeLocked() const {
+  // While a frame is pending, idle tasks are ineligible and must not drive
+  // the wake-up: waking for a held-back idle task would spin the loop.
+  // SetFramePending(false) recomputes the wake-up when they become eligible.
+  const bool skip_idle = frame_pending_;
+  auto next = ftl::TimePoint::Max();
+  for (const auto& slot : wheel_slots_) {
+    for (const DelayedTask* task = slot.head; task != nullptr;
+         task = task->next) {
+      if (skip_idle && task->priority == TaskPriority::kIdle) {
+        continue;
+      }
+      next = std::min(next, task->target_time);
+    }
+  }
+  if (!overflow_tasks_.empty() &&
+      !(skip_idle && overflow_tasks_.top()->priority == TaskPriority::kIdle)) {
+    next = std::min(next, overflow_tasks_.top()->target_time);
+  }
+  return next;
 }
 
 void MessageLoopImpl::RunExpiredTasks() {
@@ -123,26 +299,79 @@ void MessageLoopImpl::RunExpiredTasks() {
   {
     ftl::MutexLocker lock(&delayed_tasks_mutex_);
 
-    if (delayed_tasks_.empty()) {
+    if (wheel_task_count_ == 0 && overflow_tasks_.empty()) {
       return;
     }
 
     auto now = ftl::TimePoint::Now();
-    while (!delayed_tasks_.empty()) {
-      const auto& top = delayed_tasks_.top();
-      if (top.target_time > now) {
-        break;
+
+    // Cascade overflow tasks whose deadlines have come within the wheel's
+    // horizon into their slots.
+    while (!overflow_tasks_.empty() &&
+           overflow_tasks_.top()->target_time < now + WheelHorizon()) {
+      DelayedTask* task = overflow_tasks_.top();
+      overflow_tasks_.pop();
+      AppendToWheelLocked(task);
+    }
+
+    // Collect due tasks from the wheel. Tasks from a future revolution hash
+    // into the same slots and simply stay put, as do due idle tasks while a
+    // frame is pending.
+    const bool hold_idle = frame_pending_;
+    std::vector<DelayedTask*> expired;
+    for (auto& slot : wheel_slots_) {
+      DelayedTask* task = slot.head;
+      slot.head = slot.tail = nullptr;
+      while (task != nullptr) {
+        DelayedTask* next = task->next;
+        if (task->target_time <= now &&
+            !(hold_idle && task->priority == TaskPriority::kIdle)) {
+          expired.push_back(task);
+          wheel_task_count_--;
+        } else {
+          // Not due yet; relink at the tail. Relative order within the slot
+          // is preserved because the walk is in order.
+          task->next = nullptr;
+          if (slot.tail != nullptr) {
+            slot.tail->next = task;
+          } else {
+            slot.head = task;
+          }
+          slot.tail = task;
+        }
+        task = next;
       }
-      invocations.emplace_back(std::move(top.task));
-      delayed_tasks_.pop();
     }
 
-    WakeUp(delayed_tasks_.empty() ? ftl::TimePoint::Max()
-                                  : delayed_tasks_.top().target_time);
+    // The wheel does not keep tasks heap-ordered; restore dispatch order:
+    // higher priority lanes first, then target time and posting order within
+    // a lane.
+    std::sort(expired.begin(), expired.end(),
+              [](const DelayedTask* a, const DelayedTask* b) {
+                if (a->priority != b->priority)
+                  return a->priority < b->priority;
+                return a->target_time == b->target_time
+                           ? a->order < b->order
+                           : a->target_time < b->target_time;
+              });
+    for (DelayedTask* task : expired) {
+      invocations.emplace_back(std::move(task->task));
+      task_slab_.Free(task);
+    }
+
+    WakeUp(NextTaskTimeLocked());
   }
 
   for (const auto& invocation : invocations) {
+    auto task_start = ftl::TimePoint::Now();
     invocation();
+    auto task_duration = ftl::TimePoint::Now() - task_start;
+    if (task_duration >= slow_task_threshold_) {
+      TRACE_EVENT_INSTANT0("fml", "SlowTask");
+      if (slow_task_callback_) {
+        slow_task_callback_(task_duration);
+      }
+    }
     for (const auto& observer : task_observers_) {
       observer->DidProcessTask();
     }
@@ -6,12 +6,16 @@
 #define FLUTTER_FML_MESSAGE_LOOP_IMPL_H_
 
 #include <atomic>
-#include <deque>
+#include <memory>
 #include <queue>
 #include <set>
 #include <utility>
+#include <vector>
+
+#include <functional>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/task_priority.h"
 #include "lib/ftl/functional/closure.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/ref_counted.h"
@@ -33,16 +37,48 @@ class MessageLoopImpl : public ftl::RefCountedThreadSafe<MessageLoopImpl> {
 
   virtual void WakeUp(ftl::TimePoint time_point) = 0;
 
-  void PostTask(ftl::Closure task, ftl::TimePoint target_time);
+  void PostTask(ftl::Closure task,
+                ftl::TimePoint target_time,
+                TaskPriority priority = TaskPriority::kDefault);
+
+  // Registers a batch of tasks for the same target time under a single lock
+  // acquisition and a single wake-up of the loop. Paths that post many tasks
+  // per frame should prefer this to repeated PostTask calls.
+  void PostTasks(std::vector<ftl::Closure> tasks, ftl::TimePoint target_time);
+
+  // While a frame is pending, due tasks in the idle lane stay queued; they
+  // are reconsidered once the pending flag clears. Set and cleared by the
+  // animator around frame production; may be called from any thread.
+  void SetFramePending(bool pending);
 
   void AddTaskObserver(TaskObserver* observer);
 
   void RemoveTaskObserver(TaskObserver* observer);
 
+  // Invoked on the loop's thread with the wall time a task took whenever
+  // that time exceeds the slow task threshold.
+  using SlowTaskCallback = std::function<void(ftl::TimeDelta duration)>;
+
+  // Configures the slow task detector. Tasks that run longer than
+  // |threshold| emit an instant trace event and invoke the callback, if one
+  // is set. The default threshold is one 60Hz frame interval. Like task
+  // observers, these must be configured on the loop's own thread.
+  void SetSlowTaskThreshold(ftl::TimeDelta threshold);
+
+  void SetSlowTaskCallback(SlowTaskCallback callback);
+
   void DoRun();
 
   void DoTerminate();
 
+  // Pending tasks live in a hashed timer wheel: each slot covers a fixed
+  // interval and holds the tasks whose target times hash into it, so the
+  // near-deadline timers that dominate in practice are registered and
+  // retired in constant time instead of churning a heap-ordered priority
+  // queue. Tasks beyond the wheel's horizon wait in |overflow_tasks_| and
+  // cascade into the wheel as it turns.
+  static const size_t kWheelSlotCount = 64;
+
  protected:
   MessageLoopImpl();
 
@@ -53,30 +89,94 @@ class MessageLoopImpl : public ftl::RefCountedThreadSafe<MessageLoopImpl> {
     size_t order;
     ftl::Closure task;
     ftl::TimePoint target_time;
+    TaskPriority priority;
+    // Links tasks within a wheel slot, in posting order.
+    DelayedTask* next;
 
     DelayedTask(size_t p_order,
                 ftl::Closure p_task,
-                ftl::TimePoint p_target_time)
-        : order(p_order), task(std::move(p_task)), target_time(p_target_time) {}
+                ftl::TimePoint p_target_time,
+                TaskPriority p_priority)
+        : order(p_order),
+          task(std::move(p_task)),
+          target_time(p_target_time),
+          priority(p_priority),
+          next(nullptr) {}
+  };
+
+  // Backing store for DelayedTask nodes: a fixed slab of slots recycled
+  // FIFO, with overflow to the heap when the loop has more pending tasks
+  // than slots. At steady state posting a task costs a slot pop and a list
+  // append instead of a heap allocation per post. Always used under
+  // |delayed_tasks_mutex_|, so it needs no locking of its own.
+  class TaskNodeSlab {
+   public:
+    TaskNodeSlab();
+
+    ~TaskNodeSlab();
+
+    // Returns uninitialized storage for one DelayedTask; the caller
+    // constructs in place.
+    void* Allocate();
+
+    // Destroys |node| and recycles (or, for overflow nodes, frees) its
+    // storage.
+    void Free(DelayedTask* node);
+
+   private:
+    static const size_t kSlotCount = 256;
+
+    std::unique_ptr<char[]> storage_;
+    // Ring of free slots, recycled in FIFO order.
+    std::unique_ptr<void* []> free_ring_;
+    size_t free_head_;
+    size_t free_count_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(TaskNodeSlab);
   };
 
   struct DelayedTaskCompare {
-    bool operator()(const DelayedTask& a, const DelayedTask& b) {
-      return a.target_time == b.target_time ? a.order > b.order
-                                            : a.target_time > b.target_time;
+    bool operator()(const DelayedTask* a, const DelayedTask* b) {
+      return a->target_time == b->target_time
+                 ? a->order > b->order
+                 : a->target_time > b->target_time;
     }
   };
 
-  using DelayedTaskQueue = std::
-      priority_queue<DelayedTask, std::deque<DelayedTask>, DelayedTaskCompare>;
+  using DelayedTaskQueue = std::priority_queue<DelayedTask*,
+                                               std::vector<DelayedTask*>,
+                                               DelayedTaskCompare>;
+
+  // FIFO list of the tasks hashed into one wheel slot.
+  struct WheelSlot {
+    DelayedTask* head = nullptr;
+    DelayedTask* tail = nullptr;
+  };
 
   std::set<TaskObserver*> task_observers_;
+  ftl::TimeDelta slow_task_threshold_;
+  SlowTaskCallback slow_task_callback_;
   ftl::Mutex delayed_tasks_mutex_;
-  DelayedTaskQueue delayed_tasks_ FTL_GUARDED_BY(delayed_tasks_mutex_);
+  TaskNodeSlab task_slab_ FTL_GUARDED_BY(delayed_tasks_mutex_);
+  WheelSlot wheel_slots_[kWheelSlotCount] FTL_GUARDED_BY(delayed_tasks_mutex_);
+  size_t wheel_task_count_ FTL_GUARDED_BY(delayed_tasks_mutex_);
+  DelayedTaskQueue overflow_tasks_ FTL_GUARDED_BY(delayed_tasks_mutex_);
   size_t order_ FTL_GUARDED_BY(delayed_tasks_mutex_);
   std::atomic_bool terminated_;
+  std::atomic_bool frame_pending_;
+
+  void RegisterTask(ftl::Closure task,
+                    ftl::TimePoint target_time,
+                    TaskPriority priority);
+
+  void ScheduleTaskLocked(ftl::Closure task,
+                          ftl::TimePoint target_time,
+                          TaskPriority priority,
+                          ftl::TimePoint now);
+
+  void AppendToWheelLocked(DelayedTask* task);
 
-  void RegisterTask(ftl::Closure task, ftl::TimePoint target_time);
+  ftl::TimePoint NextTaskTimeLocked() const;
 
   void RunExpiredTasks();
 
@@ -2,9 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <chrono>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/task_runner.h"
 #include "gtest/gtest.h"
 #include "lib/ftl/synchronization/waitable_event.h"
 
@@ -93,6 +96,36 @@ TEST(MessageLoop, NonDelayedTasksAreRunInOrder) {
   ASSERT_TRUE(terminated);
 }
 
+TEST(MessageLoop, TasksPostedInBatchAreRunInOrder) {
+  const size_t count = 100;
+  bool started = false;
+  bool terminated = false;
+  std::thread thread([&started, &terminated, count]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    size_t current = 0;
+    std::vector<ftl::Closure> tasks;
+    for (size_t i = 0; i < count; i++) {
+      tasks.emplace_back([&terminated, i, &current]() {
+        ASSERT_EQ(current, i);
+        current++;
+        if (count == i + 1) {
+          fml::MessageLoop::GetCurrent().Terminate();
+          terminated = true;
+        }
+      });
+    }
+    static_cast<fml::TaskRunner*>(loop.GetTaskRunner().get())
+        ->PostTasks(std::move(tasks));
+    loop.Run();
+    ASSERT_EQ(current, count);
+    started = true;
+  });
+  thread.join();
+  ASSERT_TRUE(started);
+  ASSERT_TRUE(terminated);
+}
+
 TEST(MessageLoop, DelayedTasksAtSameTimeAreRunInOrder) {
   const size_t count = 100;
   bool started = false;
@@ -124,6 +157,26 @@ TEST(MessageLoop, DelayedTasksAtSameTimeAreRunInOrder) {
   ASSERT_TRUE(terminated);
 }
 
+TEST(MessageLoop, TIME_SENSITIVE(SlowTasksInvokeCallback)) {
+  bool slow_task_reported = false;
+  std::thread thread([&slow_task_reported]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    loop.SetSlowTaskThreshold(ftl::TimeDelta::FromMilliseconds(5));
+    loop.SetSlowTaskCallback([&slow_task_reported](ftl::TimeDelta duration) {
+      ASSERT_GE(duration, ftl::TimeDelta::FromMilliseconds(5));
+      slow_task_reported = true;
+    });
+    loop.GetTaskRunner()->PostTask([]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      fml::MessageLoop::GetCurrent().Terminate();
+    });
+    loop.Run();
+  });
+  thread.join();
+  ASSERT_TRUE(slow_task_reported);
+}
+
 TEST(MessageLoop, CheckRunsTaskOnCurrentThread) {
   ftl::RefPtr<ftl::TaskRunner> runner;
   ftl::AutoResetWaitableEvent latch;
@@ -238,6 +291,52 @@ TEST(MessageLoop, TIME_SENSITIVE(MultipleDelayedTasksWithDecreasingDeltas)) {
   ASSERT_EQ(checked, count);
 }
 
+TEST(MessageLoop, HigherPriorityTasksRunFirstWhenDueTogether) {
+  std::vector<int> run_order;
+  std::thread thread([&run_order]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    auto runner = static_cast<fml::TaskRunner*>(loop.GetTaskRunner().get());
+    runner->PostTask([&run_order]() { run_order.push_back(2); });
+    runner->PostTaskWithPriority([&run_order]() { run_order.push_back(0); },
+                                 fml::TaskPriority::kInput);
+    runner->PostTaskWithPriority(
+        [&run_order]() {
+          run_order.push_back(1);
+          fml::MessageLoop::GetCurrent().Terminate();
+        },
+        fml::TaskPriority::kFrame);
+    loop.Run();
+  });
+  thread.join();
+  ASSERT_EQ(run_order, std::vector<int>({0, 1, 2}));
+}
+
+TEST(MessageLoop, IdleTasksAreHeldWhileFramePending) {
+  bool idle_ran = false;
+  bool checked_before_release = false;
+  std::thread thread([&idle_ran, &checked_before_release]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    auto runner = static_cast<fml::TaskRunner*>(loop.GetTaskRunner().get());
+    loop.SetFramePending(true);
+    runner->PostIdleTask([&idle_ran]() {
+      idle_ran = true;
+      fml::MessageLoop::GetCurrent().Terminate();
+    });
+    runner->PostTask([&idle_ran, &checked_before_release]() {
+      // The idle task was posted first but must still be queued.
+      ASSERT_FALSE(idle_ran);
+      checked_before_release = true;
+      fml::MessageLoop::GetCurrent().SetFramePending(false);
+    });
+    loop.Run();
+  });
+  thread.join();
+  ASSERT_TRUE(checked_before_release);
+  ASSERT_TRUE(idle_ran);
+}
+
 class CustomTaskObserver : public fml::TaskObserver {
  public:
   CustomTaskObserver(std::function<void()> lambda) : lambda_(lambda){};
@@ -0,0 +1,179 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/sampling_profiler.h"
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_recorder.h"
+#include "lib/ftl/build_config.h"
+#include "lib/ftl/time/time_delta.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+
+namespace fml {
+
+namespace {
+
+// SIGPROF fires per this much consumed process CPU time. 1ms keeps the
+// sampling overhead well under a percent while still collecting several
+// hundred samples over a single janky second.
+const long kSampleIntervalMicros = 1000;
+
+// How often the drain thread converts raw program counters into flight
+// recorder events. Sample records carry drain-time timestamps, so this
+// bounds their timestamp error.
+const int64_t kDrainIntervalMs = 100;
+
+// Samples whose distance from the nearest registered address exceeds this
+// are attributed to no hot function. Registered addresses sit near function
+// entry, so the span only needs to cover one large function body.
+const uintptr_t kMaxAttributionSpanBytes = 1 << 16;
+
+// The sample ring shared by the signal handler and the drain thread. The
+// handler only performs lock-free atomic stores, which is all that is
+// async-signal-safe; the drain owns the read cursor and drops samples the
+// writer has lapped.
+const size_t kSampleRingSize = 4096;
+std::atomic<uintptr_t> g_sample_ring[kSampleRingSize];
+std::atomic<size_t> g_sample_cursor(0);
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+void ProfilerSignalHandler(int /* signal */, siginfo_t* /* info */,
+                           void* context) {
+  ucontext_t* ucontext = static_cast<ucontext_t*>(context);
+#if defined(__aarch64__)
+  uintptr_t pc = static_cast<uintptr_t>(ucontext->uc_mcontext.pc);
+#elif defined(__arm__)
+  uintptr_t pc = static_cast<uintptr_t>(ucontext->uc_mcontext.arm_pc);
+#elif defined(__x86_64__)
+  uintptr_t pc = static_cast<uintptr_t>(ucontext->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__i386__)
+  uintptr_t pc = static_cast<uintptr_t>(ucontext->uc_mcontext.gregs[REG_EIP]);
+#else
+  uintptr_t pc = 0;
+#endif
+  size_t cursor = g_sample_cursor.fetch_add(1, std::memory_order_relaxed);
+  g_sample_ring[cursor % kSampleRingSize].store(pc, std::memory_order_release);
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+}  // namespace
+
+SamplingProfiler& SamplingProfiler::GetProcessProfiler() {
+  static SamplingProfiler* profiler = new SamplingProfiler();
+  return *profiler;
+}
+
+SamplingProfiler::SamplingProfiler() : running_(false) {}
+
+SamplingProfiler::~SamplingProfiler() = default;
+
+bool SamplingProfiler::RegisterHotFunction(const char* name, uintptr_t pc) {
+  if (pc == 0 || name == nullptr) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(symbols_mutex_);
+  symbols_[pc] = name;
+  return true;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline)) uintptr_t SamplingProfiler::CurrentPC() {
+  // The return address of this (never inlined) call is an instruction
+  // inside the caller.
+  return reinterpret_cast<uintptr_t>(__builtin_return_address(0));
+}
+#else
+uintptr_t SamplingProfiler::CurrentPC() {
+  return 0;
+}
+#endif
+
+void SamplingProfiler::Start() {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  if (running_.exchange(true)) {
+    return;
+  }
+
+  if (!drain_thread_) {
+    drain_thread_.reset(new Thread("profiler_drain"));
+  }
+  drained_cursor_ = g_sample_cursor.load(std::memory_order_acquire);
+
+  struct sigaction action = {};
+  action.sa_sigaction = &ProfilerSignalHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  ::sigaction(SIGPROF, &action, nullptr);
+
+  // ITIMER_PROF counts process CPU time and delivers SIGPROF on whichever
+  // thread is running, which is exactly the sampling bias we want.
+  struct itimerval timer = {};
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = kSampleIntervalMicros;
+  timer.it_value = timer.it_interval;
+  ::setitimer(ITIMER_PROF, &timer, nullptr);
+
+  ScheduleDrain();
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+}
+
+void SamplingProfiler::Stop() {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  if (!running_.exchange(false)) {
+    return;
+  }
+  // A zeroed interval disarms the timer. The handler stays installed; it is
+  // inert without the timer.
+  struct itimerval timer = {};
+  ::setitimer(ITIMER_PROF, &timer, nullptr);
+  // One final drain picks up the tail of the ring.
+  drain_thread_->GetTaskRunner()->PostTask([this]() { Drain(); });
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+}
+
+void SamplingProfiler::ScheduleDrain() {
+  drain_thread_->GetTaskRunner()->PostDelayedTask(
+      [this]() {
+        Drain();
+        if (is_running()) {
+          ScheduleDrain();
+        }
+      },
+      ftl::TimeDelta::FromMilliseconds(kDrainIntervalMs));
+}
+
+void SamplingProfiler::Drain() {
+  size_t cursor = g_sample_cursor.load(std::memory_order_acquire);
+  if (cursor - drained_cursor_ > kSampleRingSize) {
+    // The handler lapped us; the overwritten samples are gone.
+    drained_cursor_ = cursor - kSampleRingSize;
+  }
+
+  std::lock_guard<std::mutex> lock(symbols_mutex_);
+  for (; drained_cursor_ < cursor; drained_cursor_++) {
+    uintptr_t pc = g_sample_ring[drained_cursor_ % kSampleRingSize].load(
+        std::memory_order_relaxed);
+    // Unattributed samples are recorded under a fixed label so gaps in hot
+    // function coverage show up instead of vanishing.
+    const char* label = "ProfilerSampleUnattributed";
+    auto it = symbols_.upper_bound(pc);
+    if (it != symbols_.begin()) {
+      --it;
+      if (pc - it->first <= kMaxAttributionSpanBytes) {
+        label = it->second;
+      }
+    }
+    tracing::TraceRecorder::GetProcessRecorder().Record(
+        label, tracing::TraceRecorder::EventType::kInstant, 0);
+  }
+}
+
+}  // namespace fml
@@ -0,0 +1,91 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SAMPLING_PROFILER_H_
+#define FLUTTER_FML_SAMPLING_PROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "lib/ftl/macros.h"
+
+namespace fml {
+
+class Thread;
+
+// A "poor man's perf" for locked-down retail devices: a SIGPROF-driven
+// program counter sampler whose samples are attributed against a table of
+// pre-registered engine hot functions and recorded into the always-on
+// flight recorder (see trace_recorder.h). A trace pulled from the field
+// then shows roughly where CPU time went without attaching a profiler the
+// device would refuse.
+//
+// Functions opt in by placing FML_PROFILER_HOT_FUNCTION("Name") at the top
+// of their bodies; the macro registers an instruction address inside the
+// function the first time it executes. A sample is attributed to the
+// nearest registered address at or below the sampled program counter, so
+// attribution is approximate — good enough to rank preroll against paint
+// against shaping, not to reconstruct a call graph.
+//
+// Sampling requires SIGPROF and setitimer and is implemented on Linux and
+// Android; Start() is a no-op elsewhere. Registration is always cheap (one
+// function-local static check per call after the first).
+class SamplingProfiler {
+ public:
+  static SamplingProfiler& GetProcessProfiler();
+
+  // Adds |pc| to the symbol table under |name|. The name must outlive the
+  // process (the macro passes string literals). Returns true so the macro
+  // can seed a function-local static and register exactly once.
+  bool RegisterHotFunction(const char* name, uintptr_t pc);
+
+  // Returns an instruction address inside the calling function, or 0 where
+  // the toolchain offers no way to obtain one.
+  static uintptr_t CurrentPC();
+
+  // Arms the sampling timer and the drain that turns raw program counters
+  // into flight recorder events. Safe to call redundantly.
+  void Start();
+
+  // Disarms the timer. Samples taken so far remain in the flight recorder.
+  void Stop();
+
+  bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+ private:
+  SamplingProfiler();
+
+  ~SamplingProfiler();
+
+  void ScheduleDrain();
+
+  void Drain();
+
+  std::atomic<bool> running_;
+  std::mutex symbols_mutex_;
+  // Registered instruction address to hot function name.
+  std::map<uintptr_t, const char*> symbols_;
+  std::unique_ptr<Thread> drain_thread_;
+  // Only touched from the drain thread.
+  size_t drained_cursor_ = 0;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(SamplingProfiler);
+};
+
+}  // namespace fml
+
+// Registers the enclosing function with the sampling profiler on first
+// execution. |name| must be a string literal.
+#define FML_PROFILER_HOT_FUNCTION(name)                                     \
+  do {                                                                      \
+    static const bool __fml_profiler_registered =                           \
+        ::fml::SamplingProfiler::GetProcessProfiler().RegisterHotFunction(  \
+            name, ::fml::SamplingProfiler::CurrentPC());                    \
+    (void)__fml_profiler_registered;                                        \
+  } while (0)
+
+#endif  // FLUTTER_FML_SAMPLING_PROFILER_H_
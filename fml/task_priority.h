@@ -0,0 +1,24 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_PRIORITY_H_
+#define FLUTTER_FML_TASK_PRIORITY_H_
+
+namespace fml {
+
+// Dispatch lanes for message loop tasks. When several tasks are due at the
+// same time, higher lanes (lower values) run first regardless of posting
+// order; within a lane posting order is preserved. The idle lane is special:
+// its tasks only run while the loop has no frame pending (see
+// MessageLoop::SetFramePending), so background work cannot lengthen a frame.
+enum class TaskPriority : int {
+  kInput = 0,
+  kFrame = 1,
+  kDefault = 2,
+  kIdle = 3,
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_PRIORITY_H_
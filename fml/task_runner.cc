@@ -22,6 +22,19 @@ void TaskRunner::PostTask(ftl::Closure task) {
   loop_->PostTask(std::move(task), ftl::TimePoint::Now());
 }
 
+void TaskRunner::PostTasks(std::vector<ftl::Closure> tasks) {
+  loop_->PostTasks(std::move(tasks), ftl::TimePoint::Now());
+}
+
+void TaskRunner::PostTaskWithPriority(ftl::Closure task,
+                                      TaskPriority priority) {
+  loop_->PostTask(std::move(task), ftl::TimePoint::Now(), priority);
+}
+
+void TaskRunner::PostIdleTask(ftl::Closure task) {
+  loop_->PostTask(std::move(task), ftl::TimePoint::Now(), TaskPriority::kIdle);
+}
+
 void TaskRunner::PostTaskForTime(ftl::Closure task,
                                  ftl::TimePoint target_time) {
   loop_->PostTask(std::move(task), target_time);
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_FML_TASK_RUNNER_H_
 #define FLUTTER_FML_TASK_RUNNER_H_
 
+#include <vector>
+
+#include "flutter/fml/task_priority.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/ref_counted.h"
 #include "lib/ftl/tasks/task_runner.h"
@@ -17,6 +20,18 @@ class TaskRunner : public ftl::TaskRunner {
  public:
   void PostTask(ftl::Closure task) override;
 
+  // Posts a batch of tasks with a single lock acquisition and a single
+  // wake-up of the underlying message loop.
+  void PostTasks(std::vector<ftl::Closure> tasks);
+
+  // Posts a task into the given dispatch lane. Plain PostTask is equivalent
+  // to TaskPriority::kDefault.
+  void PostTaskWithPriority(ftl::Closure task, TaskPriority priority);
+
+  // Posts a task into the idle lane: it runs only while the loop has no
+  // frame pending (see MessageLoop::SetFramePending).
+  void PostIdleTask(ftl::Closure task);
+
   void PostTaskForTime(ftl::Closure task, ftl::TimePoint target_time) override;
 
   void PostDelayedTask(ftl::Closure task, ftl::TimeDelta delay) override;
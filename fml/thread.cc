@@ -12,8 +12,19 @@
 #include <pthread.h>
 #endif
 
+#if OS_LINUX || OS_ANDROID
+#include <sched.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#endif
+
+#if OS_MACOSX
+#include <pthread/qos.h>
+#endif
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/message_loop.h"
 #include "lib/ftl/synchronization/waitable_event.h"
@@ -52,6 +63,143 @@ void Thread::Join() {
   thread_->join();
 }
 
+void Thread::SetPriorityClass(PriorityClass priority_class) {
+  task_runner_->PostTask([priority_class]() {
+    SetCurrentThreadPriorityClass(priority_class);
+  });
+}
+
+#if OS_LINUX || OS_ANDROID
+
+namespace {
+
+long ReadCoreMaxFrequency(int core) {
+  char path[128] = {};
+  snprintf(path, sizeof(path),
+           "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", core);
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    return -1;
+  }
+  long frequency = -1;
+  if (fscanf(file, "%ld", &frequency) != 1) {
+    frequency = -1;
+  }
+  fclose(file);
+  return frequency;
+}
+
+// Pins the calling thread to the fastest (or slowest) cluster of an
+// asymmetric multicore processor. On symmetric processors, or when the
+// cluster topology cannot be determined, the affinity is left alone.
+bool PinCurrentThreadToCluster(bool fastest) {
+  const int core_count = sysconf(_SC_NPROCESSORS_CONF);
+  if (core_count <= 1 || core_count > CPU_SETSIZE) {
+    return false;
+  }
+  std::vector<long> frequencies(core_count);
+  long best = -1;
+  for (int i = 0; i < core_count; i++) {
+    frequencies[i] = ReadCoreMaxFrequency(i);
+    if (frequencies[i] < 0) {
+      return false;
+    }
+    if (best < 0 || (fastest ? frequencies[i] > best : frequencies[i] < best)) {
+      best = frequencies[i];
+    }
+  }
+  cpu_set_t cores;
+  CPU_ZERO(&cores);
+  size_t matching = 0;
+  for (int i = 0; i < core_count; i++) {
+    if (frequencies[i] == best) {
+      CPU_SET(i, &cores);
+      matching++;
+    }
+  }
+  if (matching == static_cast<size_t>(core_count)) {
+    // Symmetric processor; nothing to pin to.
+    return false;
+  }
+  return sched_setaffinity(0, sizeof(cores), &cores) == 0;
+}
+
+}  // namespace
+
+bool Thread::SetCurrentThreadPriorityClass(PriorityClass priority_class) {
+  bool applied = false;
+  switch (priority_class) {
+    case PriorityClass::Background:
+      applied |= setpriority(PRIO_PROCESS, 0, 10) == 0;
+      applied |= PinCurrentThreadToCluster(false);
+      break;
+    case PriorityClass::Normal:
+      applied = setpriority(PRIO_PROCESS, 0, 0) == 0;
+      break;
+    case PriorityClass::RealTime: {
+      struct sched_param param = {};
+      param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+      // Typically denied to unprivileged processes; the Performance
+      // treatment below still applies if so.
+      applied |= pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+    // Fall through.
+    case PriorityClass::Performance:
+      applied |= setpriority(PRIO_PROCESS, 0, -8) == 0;
+      applied |= PinCurrentThreadToCluster(true);
+      break;
+  }
+  return applied;
+}
+
+#elif OS_MACOSX
+
+bool Thread::SetCurrentThreadPriorityClass(PriorityClass priority_class) {
+  qos_class_t qos_class = QOS_CLASS_DEFAULT;
+  switch (priority_class) {
+    case PriorityClass::Background:
+      qos_class = QOS_CLASS_UTILITY;
+      break;
+    case PriorityClass::Normal:
+      qos_class = QOS_CLASS_DEFAULT;
+      break;
+    case PriorityClass::Performance:
+    case PriorityClass::RealTime:
+      qos_class = QOS_CLASS_USER_INTERACTIVE;
+      break;
+  }
+  return pthread_set_qos_class_self_np(qos_class, 0) == 0;
+}
+
+#elif OS_WIN
+
+bool Thread::SetCurrentThreadPriorityClass(PriorityClass priority_class) {
+  int priority = THREAD_PRIORITY_NORMAL;
+  switch (priority_class) {
+    case PriorityClass::Background:
+      priority = THREAD_PRIORITY_BELOW_NORMAL;
+      break;
+    case PriorityClass::Normal:
+      priority = THREAD_PRIORITY_NORMAL;
+      break;
+    case PriorityClass::Performance:
+      priority = THREAD_PRIORITY_ABOVE_NORMAL;
+      break;
+    case PriorityClass::RealTime:
+      priority = THREAD_PRIORITY_HIGHEST;
+      break;
+  }
+  return ::SetThreadPriority(::GetCurrentThread(), priority) != 0;
+}
+
+#else
+
+bool Thread::SetCurrentThreadPriorityClass(PriorityClass priority_class) {
+  return false;
+}
+
+#endif
+
 #if defined(OS_WIN)
 // The information on how to set the thread name comes from
 // a MSDN article: http://msdn2.microsoft.com/en-us/library/xcb2z8hs.aspx
@@ -16,6 +16,22 @@ namespace fml {
 
 class Thread {
  public:
+  // Scheduling classes for engine threads, mapped to the closest facility
+  // each platform offers: nice values and performance-core affinity on
+  // Linux and Android, QoS classes on Darwin, and thread priorities on
+  // Windows.
+  enum class PriorityClass {
+    // Latency-tolerant work; may run on efficiency cores.
+    Background,
+    Normal,
+    // Frame-critical work; prefers performance cores and an elevated
+    // priority.
+    Performance,
+    // Performance, plus real-time scheduling where the platform permits
+    // it.
+    RealTime,
+  };
+
   explicit Thread(const std::string& name = "");
 
   ~Thread();
@@ -24,13 +40,20 @@ class Thread {
 
   void Join();
 
+  // Asynchronously applies |priority_class| on this thread.
+  void SetPriorityClass(PriorityClass priority_class);
+
+  // Applies |priority_class| to the calling thread. Returns false if no
+  // part of the request could be applied.
+  static bool SetCurrentThreadPriorityClass(PriorityClass priority_class);
+
+  static void SetCurrentThreadName(const std::string& name);
+
  private:
   std::unique_ptr<std::thread> thread_;
   ftl::RefPtr<ftl::TaskRunner> task_runner_;
   std::atomic_bool joined_;
 
-  static void SetCurrentThreadName(const std::string& name);
-
   FTL_DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
@@ -0,0 +1,246 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/thread_local.h"
+#include "lib/ftl/logging.h"
+
+namespace fml {
+
+namespace {
+
+// Initial per-worker deque capacity in tasks; doubled on demand.
+const int64_t kInitialDequeCapacity = 256;
+
+struct CurrentWorker {
+  ThreadPool* pool;
+  size_t index;
+};
+
+// Identifies the worker (if any) the calling thread belongs to so tasks
+// posted from workers can go to their own deque.
+FML_THREAD_LOCAL fml::ThreadLocal tls_current_worker;
+
+}  // namespace
+
+// A Chase-Lev work-stealing deque of heap-allocated closures. The owning
+// worker pushes and pops at the bottom without contention; thieves race
+// each other (and the owner's pop of the final task) at the top with a
+// single compare-exchange. Follows the C11 formulation by Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models".
+class ThreadPool::WorkStealingDeque {
+ public:
+  WorkStealingDeque()
+      : top_(0), bottom_(0), ring_(new Ring(kInitialDequeCapacity)) {}
+
+  ~WorkStealingDeque() {
+    // Drop tasks that never ran. Workers are joined by now, so plain loads
+    // suffice.
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    for (int64_t i = top_.load(std::memory_order_relaxed); i < bottom; i++) {
+      delete ring->Load(i);
+    }
+    delete ring;
+  }
+
+  // Owner only.
+  void Push(ftl::Closure* task) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (bottom - top > ring->capacity - 1) {
+      ring = Grow(ring, top, bottom);
+    }
+    ring->Store(bottom, task);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  // Owner only.
+  ftl::Closure* Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      // Empty; restore the canonical state.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    ftl::Closure* task = ring->Load(bottom);
+    if (top == bottom) {
+      // Last task: race thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        task = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  // Any thread.
+  ftl::Closure* Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    ftl::Closure* task = ring->Load(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      // Lost the race to another thief or the owner.
+      return nullptr;
+    }
+    return task;
+  }
+
+ private:
+  struct Ring {
+    explicit Ring(int64_t p_capacity)
+        : capacity(p_capacity),
+          tasks(new std::atomic<ftl::Closure*>[p_capacity]) {}
+
+    ftl::Closure* Load(int64_t index) const {
+      return tasks[index & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void Store(int64_t index, ftl::Closure* task) {
+      tasks[index & (capacity - 1)].store(task, std::memory_order_relaxed);
+    }
+
+    const int64_t capacity;  // Always a power of two.
+    std::unique_ptr<std::atomic<ftl::Closure*>[]> tasks;
+  };
+
+  Ring* Grow(Ring* ring, int64_t top, int64_t bottom) {
+    Ring* grown = new Ring(ring->capacity * 2);
+    for (int64_t i = top; i < bottom; i++) {
+      grown->Store(i, ring->Load(i));
+    }
+    // Thieves may still be reading the old ring; retire it until the deque
+    // itself is destroyed rather than reclaiming it here.
+    retired_rings_.emplace_back(ring);
+    ring_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  std::atomic<int64_t> top_;
+  std::atomic<int64_t> bottom_;
+  std::atomic<Ring*> ring_;
+  std::vector<std::unique_ptr<Ring>> retired_rings_;  // Owner only.
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+ThreadPool& ThreadPool::GetSharedWorkerPool() {
+  // Deliberately leaked: workers may outlive static destruction order.
+  static ThreadPool* shared_pool =
+      new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+  return *shared_pool;
+}
+
+ThreadPool::ThreadPool(size_t worker_count, const std::string& name_prefix)
+    : shutdown_(false) {
+  FTL_DCHECK(worker_count > 0);
+  for (size_t i = 0; i < worker_count; i++) {
+    deques_.emplace_back(std::make_unique<WorkStealingDeque>());
+  }
+  for (size_t i = 0; i < worker_count; i++) {
+    std::stringstream name;
+    name << name_prefix << "." << i;
+    workers_.emplace_back(
+        [this, i, thread_name = name.str()]() { WorkerMain(i, thread_name); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(injection_mutex_);
+    shutdown_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  for (auto* task : injected_tasks_) {
+    delete task;
+  }
+}
+
+void ThreadPool::PostWorkerTask(ftl::Closure task) {
+  FTL_DCHECK(task != nullptr);
+  auto* closure = new ftl::Closure(std::move(task));
+  auto* worker = reinterpret_cast<CurrentWorker*>(tls_current_worker.Get());
+  if (worker != nullptr && worker->pool == this) {
+    deques_[worker->index]->Push(closure);
+    // Taking the mutex (even empty) orders this push against a peer that is
+    // between its failed scan and its wait, so the notify cannot be lost.
+    { std::lock_guard<std::mutex> lock(injection_mutex_); }
+  } else {
+    std::lock_guard<std::mutex> lock(injection_mutex_);
+    injected_tasks_.push_back(closure);
+  }
+  work_available_.notify_one();
+}
+
+void ThreadPool::WorkerMain(size_t index, const std::string& name) {
+  Thread::SetCurrentThreadName(name);
+  CurrentWorker worker = {this, index};
+  tls_current_worker.Set(reinterpret_cast<intptr_t>(&worker));
+
+  for (;;) {
+    ftl::Closure* task = TakeTask(index);
+    if (task != nullptr) {
+      (*task)();
+      delete task;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(injection_mutex_);
+    if (shutdown_) {
+      break;
+    }
+    if (!injected_tasks_.empty()) {
+      continue;
+    }
+    // Peers' deques may still hold work another worker is racing us for;
+    // wake periodically to re-run the steal sweep.
+    work_available_.wait_for(lock, std::chrono::milliseconds(100));
+  }
+
+  tls_current_worker.Set(0);
+}
+
+ftl::Closure* ThreadPool::TakeTask(size_t index) {
+  if (ftl::Closure* task = deques_[index]->Pop()) {
+    return task;
+  }
+  {
+    std::lock_guard<std::mutex> lock(injection_mutex_);
+    if (!injected_tasks_.empty()) {
+      ftl::Closure* task = injected_tasks_.front();
+      injected_tasks_.pop_front();
+      return task;
+    }
+  }
+  for (size_t i = 1; i < deques_.size(); i++) {
+    if (ftl::Closure* task = deques_[(index + i) % deques_.size()]->Steal()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace fml
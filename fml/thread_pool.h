@@ -0,0 +1,71 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_THREAD_POOL_H_
+#define FLUTTER_FML_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lib/ftl/functional/closure.h"
+#include "lib/ftl/macros.h"
+
+namespace fml {
+
+// A shared pool of worker threads for CPU-bound tasks. Each worker owns a
+// Chase-Lev deque: tasks posted from a worker go to the bottom of its own
+// deque and are popped LIFO without synchronization against other workers,
+// while idle workers steal from the top of their peers' deques. Tasks posted
+// from threads outside the pool land in a shared injection queue that
+// workers drain between steals. Subsystems should prefer GetSharedWorkerPool
+// over spawning their own threads so parallel work across the engine does
+// not oversubscribe the cores.
+class ThreadPool {
+ public:
+  // A process-wide pool with one worker per core, created on first use.
+  static ThreadPool& GetSharedWorkerPool();
+
+  explicit ThreadPool(size_t worker_count,
+                      const std::string& name_prefix = "fml.worker");
+
+  // Blocks until workers have drained or abandoned their queues and joined.
+  ~ThreadPool();
+
+  // Schedules |task| to run on some worker. May be called from any thread,
+  // including pool workers (in which case the task goes to the calling
+  // worker's own deque and typically runs before stolen work).
+  void PostWorkerTask(ftl::Closure task);
+
+  size_t GetWorkerCount() const { return workers_.size(); }
+
+ private:
+  class WorkStealingDeque;
+
+  void WorkerMain(size_t index, const std::string& name);
+
+  // Returns the next task for |index| to run: its own deque first, then the
+  // injection queue, then a steal sweep over its peers. Null if the pool has
+  // no runnable work.
+  ftl::Closure* TakeTask(size_t index);
+
+  std::vector<std::unique_ptr<WorkStealingDeque>> deques_;
+  std::vector<std::thread> workers_;
+
+  std::mutex injection_mutex_;
+  std::condition_variable work_available_;
+  std::deque<ftl::Closure*> injected_tasks_;
+  bool shutdown_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_THREAD_POOL_H_
@@ -0,0 +1,60 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "flutter/fml/thread_pool.h"
+#include "lib/ftl/synchronization/waitable_event.h"
+
+TEST(ThreadPool, CanStartAndEnd) {
+  fml::ThreadPool pool(2);
+  ASSERT_EQ(pool.GetWorkerCount(), 2u);
+}
+
+TEST(ThreadPool, RunsPostedTasks) {
+  const size_t count = 1000;
+  std::atomic_size_t executed(0);
+  ftl::AutoResetWaitableEvent latch;
+  {
+    fml::ThreadPool pool(4);
+    for (size_t i = 0; i < count; i++) {
+      pool.PostWorkerTask([&executed, &latch, count]() {
+        if (++executed == count) {
+          latch.Signal();
+        }
+      });
+    }
+    latch.Wait();
+  }
+  ASSERT_EQ(executed.load(), count);
+}
+
+TEST(ThreadPool, TasksPostedFromWorkersRun) {
+  const size_t count = 100;
+  std::atomic_size_t executed(0);
+  ftl::AutoResetWaitableEvent latch;
+  fml::ThreadPool pool(4);
+  for (size_t i = 0; i < count; i++) {
+    pool.PostWorkerTask([&pool, &executed, &latch, count]() {
+      // Nested tasks land in the posting worker's own deque.
+      pool.PostWorkerTask([&executed, &latch, count]() {
+        if (++executed == count) {
+          latch.Signal();
+        }
+      });
+    });
+  }
+  latch.Wait();
+  ASSERT_EQ(executed.load(), count);
+}
+
+TEST(ThreadPool, HasASharedWorkerPool) {
+  auto& pool = fml::ThreadPool::GetSharedWorkerPool();
+  ASSERT_GE(pool.GetWorkerCount(), 1u);
+  ftl::AutoResetWaitableEvent latch;
+  pool.PostWorkerTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
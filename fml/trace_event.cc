@@ -5,10 +5,55 @@
 #include "flutter/fml/trace_event.h"
 
 #include "dart/runtime/include/dart_tools_api.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 namespace tracing {
 
+std::atomic<bool> g_timeline_enabled{false};
+
+void TraceSetTimelineEnabled(bool enabled) {
+  g_timeline_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Everything on by default so captures are complete unless an embedder
+// narrows them; the Skia GPU stream additionally defaults to sampling.
+std::atomic<uint32_t> g_enabled_categories{
+    kTraceCategorySkia | kTraceCategorySkiaGpu | kTraceCategorySkiaObjects};
+
+void TraceSetEnabledCategories(uint32_t categories) {
+  g_enabled_categories.store(categories, std::memory_order_relaxed);
+}
+
+uint32_t TraceGetEnabledCategories() {
+  return g_enabled_categories.load(std::memory_order_relaxed);
+}
+
+void TraceEventRecordBegin(TraceArg name) {
+  TraceRecorder::GetProcessRecorder().Record(
+      name, TraceRecorder::EventType::kBegin, 0);
+}
+
+void TraceEventRecordEnd(TraceArg name) {
+  TraceRecorder::GetProcessRecorder().Record(
+      name, TraceRecorder::EventType::kEnd, 0);
+}
+
+void TraceEventRecordInstant(TraceArg name) {
+  TraceRecorder::GetProcessRecorder().Record(
+      name, TraceRecorder::EventType::kInstant, 0);
+}
+
+void TraceEventRecordAsyncBegin(TraceArg name, TraceIDArg id) {
+  TraceRecorder::GetProcessRecorder().Record(
+      name, TraceRecorder::EventType::kAsyncBegin, id);
+}
+
+void TraceEventRecordAsyncEnd(TraceArg name, TraceIDArg id) {
+  TraceRecorder::GetProcessRecorder().Record(
+      name, TraceRecorder::EventType::kAsyncEnd, id);
+}
+
 void TraceEvent0(TraceArg category_group, TraceArg name) {
   Dart_TimelineEvent(name,                       // label
                      Dart_TimelineGetMicros(),   // timestamp0
@@ -18,6 +63,7 @@ void TraceEvent0(TraceArg category_group, TraceArg name) {
                      nullptr,                    // argument_names
                      nullptr                     // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kBegin, 0);
 }
 
 void TraceEvent1(TraceArg category_group,
@@ -34,6 +80,7 @@ void TraceEvent1(TraceArg category_group,
                      arg_names,                  // argument_names
                      arg_values                  // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kBegin, 0);
 }
 
 void TraceEvent2(TraceArg category_group,
@@ -52,6 +99,7 @@ void TraceEvent2(TraceArg category_group,
                      arg_names,                  // argument_names
                      arg_values                  // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kBegin, 0);
 }
 
 void TraceEventEnd(TraceArg name) {
@@ -63,6 +111,7 @@ void TraceEventEnd(TraceArg name) {
                      nullptr,                   // argument_names
                      nullptr                    // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kEnd, 0);
 }
 
 void TraceEventAsyncBegin0(TraceArg category_group,
@@ -76,6 +125,7 @@ void TraceEventAsyncBegin0(TraceArg category_group,
                      nullptr,                          // argument_names
                      nullptr                           // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kAsyncBegin, id);
 }
 
 void TraceEventAsyncEnd0(TraceArg category_group,
@@ -89,6 +139,7 @@ void TraceEventAsyncEnd0(TraceArg category_group,
                      nullptr,                        // argument_names
                      nullptr                         // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kAsyncEnd, id);
 }
 
 void TraceEventAsyncBegin1(TraceArg category_group,
@@ -106,6 +157,7 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                      arg_names,                        // argument_names
                      arg_values                        // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kAsyncBegin, id);
 }
 
 void TraceEventAsyncEnd1(TraceArg category_group,
@@ -123,6 +175,7 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                      arg_names,                      // argument_names
                      arg_values                      // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kAsyncEnd, id);
 }
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name) {
@@ -134,6 +187,24 @@ void TraceEventInstant0(TraceArg category_group, TraceArg name) {
                      nullptr,                      // argument_names
                      nullptr                       // argument_values
                      );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kInstant, 0);
+}
+
+void TraceEventInstant1(TraceArg category_group,
+                        TraceArg name,
+                        TraceArg arg1_name,
+                        TraceArg arg1_val) {
+  const char* arg_names[] = {arg1_name};
+  const char* arg_values[] = {arg1_val};
+  Dart_TimelineEvent(name,                         // label
+                     Dart_TimelineGetMicros(),     // timestamp0
+                     0,                            // timestamp1_or_async_id
+                     Dart_Timeline_Event_Instant,  // event type
+                     1,                            // argument_count
+                     arg_names,                    // argument_names
+                     arg_values                    // argument_values
+                     );
+  TraceRecorder::GetProcessRecorder().Record(name, TraceRecorder::EventType::kInstant, 0);
 }
 
 }  // namespace tracing
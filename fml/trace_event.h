@@ -5,45 +5,75 @@
 #ifndef FLUTTER_FML_TRACE_EVENT_H_
 #define FLUTTER_FML_TRACE_EVENT_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <string>
 
 #include "lib/ftl/macros.h"
 
 #ifndef TRACE_EVENT_HIDE_MACROS
 
-#define TRACE_EVENT0(category_group, name)           \
-  ::fml::tracing::TraceEvent0(category_group, name); \
+// Each macro gates on a single relaxed atomic load. When the Dart timeline is
+// not recording, the ternary takes the record-only branch: the argument value
+// expressions are never evaluated and the only work left per site is the
+// always-on flight recorder write. The ternary (rather than an if) keeps each
+// expansion a single expression statement, so the macros stay safe inside
+// unbraced control flow.
+
+#define TRACE_EVENT0(category_group, name)                \
+  ::fml::tracing::TraceTimelineEnabled()                  \
+      ? ::fml::tracing::TraceEvent0(category_group, name) \
+      : ::fml::tracing::TraceEventRecordBegin(name);      \
   ::fml::tracing::ScopedInstantEnd __trace_end0_##__LINE__(name);
 
 #define TRACE_EVENT1(category_group, name, arg1_name, arg1_val)           \
-  ::fml::tracing::TraceEvent1(category_group, name, arg1_name, arg1_val); \
+  ::fml::tracing::TraceTimelineEnabled()                                  \
+      ? ::fml::tracing::TraceEvent1(category_group, name, arg1_name,      \
+                                    arg1_val)                             \
+      : ::fml::tracing::TraceEventRecordBegin(name);                      \
   ::fml::tracing::ScopedInstantEnd __trace_end1_##__LINE__(name);
 
 #define TRACE_EVENT2(category_group, name, arg1_name, arg1_val, arg2_name, \
                      arg2_val)                                             \
-  ::fml::tracing::TraceEvent2(category_group, name, arg1_name, arg1_val,   \
-                              arg2_name, arg2_val);                        \
+  ::fml::tracing::TraceTimelineEnabled()                                   \
+      ? ::fml::tracing::TraceEvent2(category_group, name, arg1_name,       \
+                                    arg1_val, arg2_name, arg2_val)         \
+      : ::fml::tracing::TraceEventRecordBegin(name);                       \
   ::fml::tracing::ScopedInstantEnd __trace_end2_##__LINE__(name);
 
-#define TRACE_EVENT_ASYNC_BEGIN0(category_group, name, id) \
-  ::fml::tracing::TraceEventAsyncBegin0(category_group, name, id);
+#define TRACE_EVENT_ASYNC_BEGIN0(category_group, name, id)                \
+  ::fml::tracing::TraceTimelineEnabled()                                  \
+      ? ::fml::tracing::TraceEventAsyncBegin0(category_group, name, id)   \
+      : ::fml::tracing::TraceEventRecordAsyncBegin(name, id);
 
-#define TRACE_EVENT_ASYNC_END0(category_group, name, id) \
-  ::fml::tracing::TraceEventAsyncEnd0(category_group, name, id);
+#define TRACE_EVENT_ASYNC_END0(category_group, name, id)                  \
+  ::fml::tracing::TraceTimelineEnabled()                                  \
+      ? ::fml::tracing::TraceEventAsyncEnd0(category_group, name, id)     \
+      : ::fml::tracing::TraceEventRecordAsyncEnd(name, id);
 
-#define TRACE_EVENT_ASYNC_BEGIN1(category_group, name, id, arg1_name,        \
-                                 arg1_val)                                   \
-  ::fml::tracing::TraceEventAsyncBegin1(category_group, name, id, arg1_name, \
-                                        arg1_val);
+#define TRACE_EVENT_ASYNC_BEGIN1(category_group, name, id, arg1_name,       \
+                                 arg1_val)                                  \
+  ::fml::tracing::TraceTimelineEnabled()                                    \
+      ? ::fml::tracing::TraceEventAsyncBegin1(category_group, name, id,     \
+                                              arg1_name, arg1_val)          \
+      : ::fml::tracing::TraceEventRecordAsyncBegin(name, id);
 
 #define TRACE_EVENT_ASYNC_END1(category_group, name, id, arg1_name, arg1_val) \
-  ::fml::tracing::TraceEventAsyncEnd1(category_group, name, id, arg1_name,    \
-                                      arg1_val);
-
-#define TRACE_EVENT_INSTANT0(category_group, name) \
-  ::fml::tracing::TraceEventInstant0(category_group, name);
+  ::fml::tracing::TraceTimelineEnabled()                                      \
+      ? ::fml::tracing::TraceEventAsyncEnd1(category_group, name, id,         \
+                                            arg1_name, arg1_val)              \
+      : ::fml::tracing::TraceEventRecordAsyncEnd(name, id);
+
+#define TRACE_EVENT_INSTANT0(category_group, name)                \
+  ::fml::tracing::TraceTimelineEnabled()                          \
+      ? ::fml::tracing::TraceEventInstant0(category_group, name)  \
+      : ::fml::tracing::TraceEventRecordInstant(name);
+
+#define TRACE_EVENT_INSTANT1(category_group, name, arg1_name, arg1_val)     \
+  ::fml::tracing::TraceTimelineEnabled()                                    \
+      ? ::fml::tracing::TraceEventInstant1(category_group, name, arg1_name, \
+                                           arg1_val)                        \
+      : ::fml::tracing::TraceEventRecordInstant(name);
 
 #endif  // TRACE_EVENT_HIDE_MACROS
 
@@ -53,6 +83,50 @@ namespace tracing {
 using TraceArg = const char*;
 using TraceIDArg = int64_t;
 
+// Set from the VM's embedder timeline callbacks when recording of the
+// embedder stream starts and stops.
+void TraceSetTimelineEnabled(bool enabled);
+
+extern std::atomic<bool> g_timeline_enabled;
+
+// A relaxed load is sufficient: sites racing an enablement transition merely
+// trace or skip one event under the old setting.
+inline bool TraceTimelineEnabled() {
+  return g_timeline_enabled.load(std::memory_order_relaxed);
+}
+
+// Category bits for trace streams whose forwarding can be toggled at
+// runtime. The mask lives here so that bridges into the tracing system gate
+// on shared state; the Skia event tracer
+// (shell/common/skia_event_tracer_impl.cc) is the main consumer.
+enum TraceCategory : uint32_t {
+  kTraceCategorySkia = 1 << 0,
+  // GrContext and other GPU-side events; by far the noisiest stream.
+  kTraceCategorySkiaGpu = 1 << 1,
+  kTraceCategorySkiaObjects = 1 << 2,
+};
+
+void TraceSetEnabledCategories(uint32_t categories);
+
+uint32_t TraceGetEnabledCategories();
+
+extern std::atomic<uint32_t> g_enabled_categories;
+
+// Same memory-order reasoning as TraceTimelineEnabled().
+inline bool TraceCategoryEnabled(uint32_t category) {
+  return (g_enabled_categories.load(std::memory_order_relaxed) & category) !=
+         0u;
+}
+
+// Record-only variants taken when the timeline is off: they append to the
+// always-on flight recorder (see trace_recorder.h) and skip the Dart
+// timeline entirely.
+void TraceEventRecordBegin(TraceArg name);
+void TraceEventRecordEnd(TraceArg name);
+void TraceEventRecordInstant(TraceArg name);
+void TraceEventRecordAsyncBegin(TraceArg name, TraceIDArg id);
+void TraceEventRecordAsyncEnd(TraceArg name, TraceIDArg id);
+
 void TraceEvent0(TraceArg category_group, TraceArg name);
 
 void TraceEvent1(TraceArg category_group,
@@ -89,14 +163,25 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name);
 
+void TraceEventInstant1(TraceArg category_group,
+                        TraceArg name,
+                        TraceArg arg1_name,
+                        TraceArg arg1_val);
+
 class ScopedInstantEnd {
  public:
-  ScopedInstantEnd(std::string str) : label_(std::move(str)) {}
+  // The label always comes from the TRACE_EVENT macros, which take string
+  // literals, so borrowing the pointer avoids the allocation a copy would
+  // make at every site.
+  ScopedInstantEnd(const char* label) : label_(label) {}
 
-  ~ScopedInstantEnd() { TraceEventEnd(label_.c_str()); }
+  ~ScopedInstantEnd() {
+    TraceTimelineEnabled() ? TraceEventEnd(label_)
+                           : TraceEventRecordEnd(label_);
+  }
 
  private:
-  const std::string label_;
+  const char* const label_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(ScopedInstantEnd);
 };
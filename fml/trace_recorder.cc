@@ -0,0 +1,147 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include "flutter/fml/thread_local.h"
+#include "lib/ftl/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// Records retained per thread. At a few thousand events per second this
+// covers several seconds of history in 256KB per thread.
+const size_t kRecordsPerThread = 4096;
+
+// Labels longer than this are truncated when recorded.
+const size_t kMaxLabelLength = 47;
+
+// The ring of the calling thread, registered with the process recorder on
+// first use. Rings are owned by the recorder and outlive their threads.
+FML_THREAD_LOCAL fml::ThreadLocal tls_thread_ring;
+
+const char* PhaseForEventType(TraceRecorder::EventType type) {
+  switch (type) {
+    case TraceRecorder::EventType::kBegin:
+      return "B";
+    case TraceRecorder::EventType::kEnd:
+      return "E";
+    case TraceRecorder::EventType::kInstant:
+      return "i";
+    case TraceRecorder::EventType::kAsyncBegin:
+      return "b";
+    case TraceRecorder::EventType::kAsyncEnd:
+      return "e";
+  }
+  return "i";
+}
+
+}  // namespace
+
+class TraceRecorder::ThreadRing {
+ public:
+  explicit ThreadRing(size_t thread_id)
+      : thread_id_(thread_id), cursor_(0), records_(kRecordsPerThread) {}
+
+  void Record(const char* label, EventType type, int64_t async_id) {
+    size_t cursor = cursor_.load(std::memory_order_relaxed);
+    Entry& entry = records_[cursor % kRecordsPerThread];
+    entry.timestamp_micros =
+        ftl::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+    entry.async_id = async_id;
+    strncpy(entry.label, label != nullptr ? label : "", kMaxLabelLength);
+    entry.label[kMaxLabelLength] = '\0';
+    entry.type = type;
+    cursor_.store(cursor + 1, std::memory_order_release);
+  }
+
+  void AppendRetainedEvents(std::stringstream* stream, bool* first) const {
+    size_t cursor = cursor_.load(std::memory_order_acquire);
+    size_t count = std::min(cursor, kRecordsPerThread);
+    for (size_t i = cursor - count; i < cursor; i++) {
+      const Entry& entry = records_[i % kRecordsPerThread];
+      if (!*first) {
+        *stream << ",";
+      }
+      *first = false;
+      *stream << "{\"name\":\"" << entry.label << "\","
+              << "\"cat\":\"flutter\","
+              << "\"ph\":\"" << PhaseForEventType(entry.type) << "\","
+              << "\"ts\":" << entry.timestamp_micros << ","
+              << "\"pid\":1,"
+              << "\"tid\":" << thread_id_;
+      if (entry.type == EventType::kAsyncBegin ||
+          entry.type == EventType::kAsyncEnd) {
+        *stream << ",\"id\":" << entry.async_id;
+      }
+      *stream << "}";
+    }
+  }
+
+ private:
+  struct Entry {
+    int64_t timestamp_micros = 0;
+    int64_t async_id = 0;
+    char label[kMaxLabelLength + 1] = {};
+    EventType type = EventType::kInstant;
+  };
+
+  const size_t thread_id_;
+  std::atomic<size_t> cursor_;
+  std::vector<Entry> records_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ThreadRing);
+};
+
+TraceRecorder& TraceRecorder::GetProcessRecorder() {
+  // Deliberately leaked: threads may record during static destruction.
+  static TraceRecorder* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+TraceRecorder::TraceRecorder() = default;
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder::ThreadRing* TraceRecorder::RingForCurrentThread() {
+  auto* ring = reinterpret_cast<ThreadRing*>(tls_thread_ring.Get());
+  if (ring == nullptr) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.emplace_back(std::make_unique<ThreadRing>(rings_.size() + 1));
+    ring = rings_.back().get();
+    tls_thread_ring.Set(reinterpret_cast<intptr_t>(ring));
+  }
+  return ring;
+}
+
+void TraceRecorder::Record(const char* label,
+                           EventType type,
+                           int64_t async_id) {
+  RingForCurrentThread()->Record(label, type, async_id);
+}
+
+std::string TraceRecorder::DumpAsChromeTraceJSON() const {
+  std::stringstream stream;
+  stream << "[";
+  bool first = true;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto& ring : rings_) {
+      ring->AppendRetainedEvents(&stream, &first);
+    }
+  }
+  stream << "]";
+  return stream.str();
+}
+
+}  // namespace tracing
+}  // namespace fml
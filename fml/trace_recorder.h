@@ -0,0 +1,65 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+
+namespace fml {
+namespace tracing {
+
+// An always-on, constant-size recorder of the most recent trace events.
+// Each thread writes into its own overwrite-oldest ring without locks or
+// allocation, so recording stays cheap enough to leave enabled in
+// production; the retained window (the last few seconds of activity at
+// typical event rates) can be dumped as Chrome trace JSON after a jank
+// report from the field.
+class TraceRecorder {
+ public:
+  enum class EventType : uint8_t {
+    kBegin,
+    kEnd,
+    kInstant,
+    kAsyncBegin,
+    kAsyncEnd,
+  };
+
+  static TraceRecorder& GetProcessRecorder();
+
+  // Appends an event to the calling thread's ring. The label is copied (it
+  // may not be a literal), truncating to the record's fixed label storage.
+  void Record(const char* label, EventType type, int64_t async_id);
+
+  // Serializes the retained events of all threads as a JSON array in Chrome
+  // trace format. Threads keep recording while the dump walks their rings;
+  // records overwritten mid-dump may be dropped, which is acceptable for a
+  // best-effort post-hoc capture.
+  std::string DumpAsChromeTraceJSON() const;
+
+ private:
+  class ThreadRing;
+
+  TraceRecorder();
+
+  ~TraceRecorder();
+
+  ThreadRing* RingForCurrentThread();
+
+  mutable std::mutex rings_mutex_;
+  std::vector<std::unique_ptr<ThreadRing>> rings_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(TraceRecorder);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
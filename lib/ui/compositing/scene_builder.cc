@@ -65,14 +65,20 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
 }
 
 SceneBuilder::SceneBuilder()
-    : m_currentLayer(nullptr),
+    : m_arena(new flow::LayerArena()),
+      m_currentLayer(nullptr),
       m_currentRasterizerTracingThreshold(0),
       m_checkerboardRasterCacheImages(false),
       m_checkerboardOffscreenLayers(false) {
   m_cullRects.push(SkRect::MakeLargest());
+  flow::LayerArena::SetCurrent(m_arena.get());
 }
 
-SceneBuilder::~SceneBuilder() {}
+SceneBuilder::~SceneBuilder() {
+  if (flow::LayerArena::GetCurrent() == m_arena.get()) {
+    flow::LayerArena::SetCurrent(nullptr);
+  }
+}
 
 void SceneBuilder::pushTransform(const tonic::Float64List& matrix4) {
   SkMatrix sk_matrix = ToSkMatrix(matrix4);
@@ -213,6 +219,7 @@ void SceneBuilder::addPicture(double dx,
   layer->set_picture(picture->picture());
   layer->set_is_complex(!!(hints & 1));
   layer->set_will_change(!!(hints & 2));
+  layer->set_metadata(picture->metadata());
   m_currentLayer->Add(std::move(layer));
 }
 
@@ -271,9 +278,12 @@ ftl::RefPtr<Scene> SceneBuilder::build() {
   m_currentLayer = nullptr;
   int32_t threshold = m_currentRasterizerTracingThreshold;
   m_currentRasterizerTracingThreshold = 0;
-  ftl::RefPtr<Scene> scene = Scene::create(std::move(m_rootLayer), threshold,
-                                           m_checkerboardRasterCacheImages,
-                                           m_checkerboardOffscreenLayers);
+  if (flow::LayerArena::GetCurrent() == m_arena.get()) {
+    flow::LayerArena::SetCurrent(nullptr);
+  }
+  ftl::RefPtr<Scene> scene = Scene::create(
+      std::move(m_rootLayer), std::move(m_arena), threshold,
+      m_checkerboardRasterCacheImages, m_checkerboardOffscreenLayers);
   ClearDartWrapper();
   return scene;
 }
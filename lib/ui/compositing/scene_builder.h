@@ -9,6 +9,7 @@
 #include <memory>
 #include <stack>
 
+#include "flutter/flow/layer_arena.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/painting/image_filter.h"
@@ -79,6 +80,9 @@ class SceneBuilder : public ftl::RefCountedThreadSafe<SceneBuilder>,
   void addLayer(std::unique_ptr<flow::ContainerLayer> layer,
                 const SkRect& cullRect);
 
+  // Backs all layers this builder creates; declared before the layers so it
+  // is destroyed last if the scene is never built.
+  std::unique_ptr<flow::LayerArena> m_arena;
   std::unique_ptr<flow::ContainerLayer> m_rootLayer;
   flow::ContainerLayer* m_currentLayer;
   int32_t m_currentRasterizerTracingThreshold;
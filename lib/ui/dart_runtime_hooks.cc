@@ -8,10 +8,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+#include <mutex>
+
 #include "dart/runtime/bin/embedded_dart_io.h"
 #include "dart/runtime/include/dart_api.h"
 #include "dart/runtime/include/dart_tools_api.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "lib/ftl/build_config.h"
 #include "lib/ftl/logging.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -45,7 +50,11 @@ namespace blink {
 
 #define BUILTIN_NATIVE_LIST(V) \
   V(Logger_PrintString, 1)     \
-  V(ScheduleMicrotask, 1)
+  V(ScheduleMicrotask, 1)      \
+  V(Timeline_internLabel, 1)   \
+  V(Timeline_beginMark, 1)     \
+  V(Timeline_endMark, 1)       \
+  V(Timeline_instantMark, 1)
 
 BUILTIN_NATIVE_LIST(DECLARE_FUNCTION);
 
@@ -168,10 +177,108 @@ void Logger_PrintString(Dart_NativeArguments args) {
   }
 }
 
+// Labels for the dart:ui TimelineLabel markers, interned once into a fixed
+// table of copied strings. A marker then carries only an index, so recording
+// it is a bounds check, a pointer load, and the trace write - no allocation
+// and no isolate-heap string walk per event.
+static const int64_t kMaxTimelineLabels = 256;
+static const char* g_timeline_labels[kMaxTimelineLabels];
+static std::atomic<int64_t> g_timeline_label_count{0};
+static std::mutex g_timeline_label_mutex;  // Serializes interning only.
+
+static const char* TimelineLabelForId(int64_t label_id) {
+  if (label_id < 0 ||
+      label_id >= g_timeline_label_count.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return g_timeline_labels[label_id];
+}
+
+void Timeline_internLabel(Dart_NativeArguments args) {
+  Dart_Handle label = Dart_GetNativeArgument(args, 0);
+  uint8_t* chars = nullptr;
+  intptr_t length = 0;
+  Dart_Handle result = Dart_StringToUTF8(label, &chars, &length);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(g_timeline_label_mutex);
+  int64_t count = g_timeline_label_count.load(std::memory_order_relaxed);
+  for (int64_t i = 0; i < count; i++) {
+    if (strlen(g_timeline_labels[i]) == static_cast<size_t>(length) &&
+        memcmp(g_timeline_labels[i], chars, length) == 0) {
+      Dart_SetIntegerReturnValue(args, i);
+      return;
+    }
+  }
+  if (count == kMaxTimelineLabels) {
+    // Out of slots; markers with this handle become no-ops.
+    Dart_SetIntegerReturnValue(args, -1);
+    return;
+  }
+  char* copy = static_cast<char*>(malloc(length + 1));
+  memcpy(copy, chars, length);
+  copy[length] = '\0';
+  g_timeline_labels[count] = copy;
+  // Publish after the slot is filled so markers never read a null entry.
+  g_timeline_label_count.store(count + 1, std::memory_order_release);
+  Dart_SetIntegerReturnValue(args, count);
+}
+
+void Timeline_beginMark(Dart_NativeArguments args) {
+  int64_t label_id = 0;
+  Dart_GetNativeIntegerArgument(args, 0, &label_id);
+  const char* label = TimelineLabelForId(label_id);
+  if (label == nullptr) {
+    return;
+  }
+  if (fml::tracing::TraceTimelineEnabled()) {
+    fml::tracing::TraceEvent0("dart", label);
+  } else {
+    fml::tracing::TraceEventRecordBegin(label);
+  }
+}
+
+void Timeline_endMark(Dart_NativeArguments args) {
+  int64_t label_id = 0;
+  Dart_GetNativeIntegerArgument(args, 0, &label_id);
+  const char* label = TimelineLabelForId(label_id);
+  if (label == nullptr) {
+    return;
+  }
+  if (fml::tracing::TraceTimelineEnabled()) {
+    fml::tracing::TraceEventEnd(label);
+  } else {
+    fml::tracing::TraceEventRecordEnd(label);
+  }
+}
+
+void Timeline_instantMark(Dart_NativeArguments args) {
+  int64_t label_id = 0;
+  Dart_GetNativeIntegerArgument(args, 0, &label_id);
+  const char* label = TimelineLabelForId(label_id);
+  if (label == nullptr) {
+    return;
+  }
+  if (fml::tracing::TraceTimelineEnabled()) {
+    fml::tracing::TraceEventInstant0("dart", label);
+  } else {
+    fml::tracing::TraceEventRecordInstant(label);
+  }
+}
+
 void ScheduleMicrotask(Dart_NativeArguments args) {
   Dart_Handle closure = Dart_GetNativeArgument(args, 0);
   if (LogIfError(closure) || !Dart_IsClosure(closure))
     return;
+  // While a frame is being produced, microtasks are deferred so the frame
+  // drain can be budgeted. See Window::BeginFrame.
+  if (UIDartState* state = UIDartState::CurrentIfCapturingMicrotasks()) {
+    state->CaptureMicrotask(closure);
+    return;
+  }
   tonic::DartMicrotaskQueue::GetForCurrentThread()->ScheduleMicrotask(closure);
 }
 
@@ -22,6 +22,7 @@
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
 #include "flutter/lib/ui/text/paragraph.h"
 #include "flutter/lib/ui/text/paragraph_builder.h"
+#include "flutter/lib/ui/transfer_buffer.h"
 #include "flutter/lib/ui/window/window.h"
 #include "lib/ftl/build_config.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -66,6 +67,7 @@ void DartUI::InitForGlobal() {
     SceneBuilder::RegisterNatives(g_natives);
     SemanticsUpdate::RegisterNatives(g_natives);
     SemanticsUpdateBuilder::RegisterNatives(g_natives);
+    TransferBuffer::RegisterNatives(g_natives);
     Vertices::RegisterNatives(g_natives);
     Window::RegisterNatives(g_natives);
   }
@@ -88,21 +88,53 @@ void _drawFrame() {
     window.onDrawFrame();
 }
 
-// If this value changes, update the encoding code in the following files:
+// If this value changes, update the record layout in rasterizer.h.
+const int _kFrameTimingFieldCount = 5;
+
+void _reportFrameTimings(Int64List timings) {
+  if (window.onFrameTimings == null)
+    return;
+  final List<FrameTiming> frames = <FrameTiming>[];
+  for (int i = 0; i + _kFrameTimingFieldCount <= timings.length; i += _kFrameTimingFieldCount) {
+    frames.add(new FrameTiming._(
+      vsyncTarget: new Duration(microseconds: timings[i]),
+      buildStart: new Duration(microseconds: timings[i + 1]),
+      buildEnd: new Duration(microseconds: timings[i + 2]),
+      rasterStart: new Duration(microseconds: timings[i + 3]),
+      rasterEnd: new Duration(microseconds: timings[i + 4])
+    ));
+  }
+  window.onFrameTimings(frames);
+}
+
+// If these values change, update the encoding code in the following files:
 //
 //  * pointer_data.cc
 //  * FlutterView.java
-const int _kPointerDataFieldCount = 19;
+const int _kPointerDataFieldCount = 20;
+const int _kPointerDataHistoryFieldCount = 4;
 
 PointerDataPacket _unpackPointerDataPacket(ByteData packet) {
   const int kStride = Int64List.BYTES_PER_ELEMENT;
-  const int kBytesPerPointerData = _kPointerDataFieldCount * kStride;
-  final int length = packet.lengthInBytes ~/ kBytesPerPointerData;
-  assert(length * kBytesPerPointerData == packet.lengthInBytes);
-  List<PointerData> data = new List<PointerData>(length);
-  for (int i = 0; i < length; ++i) {
-    int offset = i * _kPointerDataFieldCount;
-    data[i] = new PointerData(
+  List<PointerData> data = <PointerData>[];
+  int offset = 0;
+  while (kStride * offset < packet.lengthInBytes) {
+    // The history samples, if any, trail the fixed fields of the record.
+    final int historyCount = packet.getInt64(kStride * (offset + _kPointerDataFieldCount - 1), _kFakeHostEndian);
+    List<PointerDataHistorySample> history = const <PointerDataHistorySample>[];
+    if (historyCount > 0) {
+      history = new List<PointerDataHistorySample>(historyCount);
+      int historyOffset = offset + _kPointerDataFieldCount;
+      for (int h = 0; h < historyCount; ++h) {
+        history[h] = new PointerDataHistorySample(
+          timeStamp: new Duration(microseconds: packet.getInt64(kStride * historyOffset++, _kFakeHostEndian)),
+          physicalX: packet.getFloat64(kStride * historyOffset++, _kFakeHostEndian),
+          physicalY: packet.getFloat64(kStride * historyOffset++, _kFakeHostEndian),
+          pressure: packet.getFloat64(kStride * historyOffset++, _kFakeHostEndian)
+        );
+      }
+    }
+    data.add(new PointerData(
       timeStamp: new Duration(microseconds: packet.getInt64(kStride * offset++, _kFakeHostEndian)),
       change: PointerChange.values[packet.getInt64(kStride * offset++, _kFakeHostEndian)],
       kind: PointerDeviceKind.values[packet.getInt64(kStride * offset++, _kFakeHostEndian)],
@@ -121,9 +153,12 @@ PointerDataPacket _unpackPointerDataPacket(ByteData packet) {
       radiusMin: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
       radiusMax: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
       orientation: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-      tilt: packet.getFloat64(kStride * offset++, _kFakeHostEndian)
-    );
-    assert(offset == (i + 1) * _kPointerDataFieldCount);
+      tilt: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
+      history: history
+    ));
+    // Skip the history_count field (read above) and the history samples.
+    offset += 1 + historyCount * _kPointerDataHistoryFieldCount;
   }
+  assert(kStride * offset == packet.lengthInBytes);
   return new PointerDataPacket(data: data);
 }
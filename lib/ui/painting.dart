@@ -599,14 +599,63 @@ abstract class Image extends NativeFieldWrapperClass2 {
   /// The number of image pixels along the image's vertical axis.
   int get height native "Image_height";
 
+  /// Uploads this image to the GPU eagerly and keeps it resident until
+  /// [unpin] is called.
+  ///
+  /// Images are normally uploaded lazily the first time they are drawn,
+  /// which can hitch the frame that first shows a large image. Pinning
+  /// known-hot images (for example, an emoji or sticker atlas) moves that
+  /// upload off the frame-critical path and prevents the texture from being
+  /// dropped while the pin is held.
+  ///
+  /// Calling [pin] when no GPU is available (for example, with a software
+  /// renderer) has no effect. Pins are released automatically when the
+  /// image is garbage collected, but holders of known-hot images should
+  /// call [unpin] explicitly when the image stops being hot.
+  void pin() native "Image_pin";
+
+  /// Releases the GPU residency requested by [pin].
+  ///
+  /// The texture remains usable and is released once nothing else
+  /// references it.
+  void unpin() native "Image_unpin";
+
+  /// Releases this image's decoded pixels immediately.
+  ///
+  /// Unlike [dispose], the object itself stays valid, but drawing it is a
+  /// no-op and [width] and [height] report zero. Use this when an image
+  /// leaves the working set for good (a dismissed page's photos, for
+  /// example) so its memory is returned now instead of when the garbage
+  /// collector finalizes the object.
+  void evict() native "Image_evict";
+
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
+  ///
+  /// The decoded pixels are released immediately, without waiting for the
+  /// garbage collector.
   void dispose() native "Image_dispose";
 
+  /// Configures automatic eviction of decoded image pixels.
+  ///
+  /// When [maxBytes] is nonzero, the engine keeps the total decoded bytes of
+  /// unpinned images at or below it by evicting the least recently painted
+  /// images at the start of each frame. When [maxIdleFrames] is nonzero,
+  /// images not painted for that many frames are evicted regardless of the
+  /// byte total. An evicted image behaves as if [evict] had been called on
+  /// it, so only enable these limits if re-showing old images re-decodes
+  /// them from their source. Both limits default to zero, which disables
+  /// them.
+  static void setEvictionPolicy({int maxBytes: 0, int maxIdleFrames: 0}) =>
+      _setImageEvictionPolicy(maxBytes, maxIdleFrames);
+
   @override
   String toString() => '[$width\u00D7$height]';
 }
 
+void _setImageEvictionPolicy(int maxBytes, int maxIdleFrames)
+    native "Image_setEvictionPolicy";
+
 /// Callback signature for [decodeImageFromList].
 typedef void ImageDecoderCallback(Image result);
 
@@ -614,6 +663,63 @@ typedef void ImageDecoderCallback(Image result);
 void decodeImageFromList(Uint8List list, ImageDecoderCallback callback)
     native "decodeImageFromList";
 
+/// The urgency of a decode scheduled with [decodeImageFromListAtPriority],
+/// relative to other pending decodes.
+enum ImageDecodePriority {
+  /// The image is on screen right now. Decodes at this priority run before
+  /// anything queued at the lower priorities.
+  visible,
+
+  /// The image is expected to scroll into view shortly.
+  nearViewport,
+
+  /// The image is being decoded ahead of need and can wait for quieter
+  /// moments.
+  prefetch,
+}
+
+/// Convert an image file from a byte array into an [Image] object, scheduled
+/// against other pending decodes according to [priority].
+///
+/// [decodeImageFromList] is equivalent to calling this with
+/// [ImageDecodePriority.visible].
+void decodeImageFromListAtPriority(Uint8List list,
+                                   ImageDecodePriority priority,
+                                   ImageDecoderCallback callback) {
+  _decodeImageFromListAtPriority(list, priority.index, callback);
+}
+void _decodeImageFromListAtPriority(Uint8List list,
+                                    int priority,
+                                    ImageDecoderCallback callback)
+    native "decodeImageFromListAtPriority";
+
+/// Convert an image file from a byte array into an [Image] object that is no
+/// larger than it needs to be for a [targetWidth] by [targetHeight] display
+/// box.
+///
+/// The codec decodes at the smallest of its supported sizes that still
+/// covers the target dimensions, preserving the image's aspect ratio, so a
+/// large photo shown as a thumbnail never materializes at full resolution.
+/// Images already no larger than the target decode at their native size.
+void decodeImageFromListWithTargetSize(Uint8List list,
+                                       int targetWidth,
+                                       int targetHeight,
+                                       ImageDecoderCallback callback)
+    native "decodeImageFromListWithTargetSize";
+
+/// Convert an image whose encoded bytes were registered on the platform side
+/// into an [Image] object.
+///
+/// The platform side registers the bytes it already holds (for example a
+/// network response body) and sends only the returned identifier across its
+/// platform channel. The decoder adopts the registered bytes directly, so
+/// the image data is never copied into or out of a Dart list.
+///
+/// Each identifier is single use; passing an unknown or already used
+/// identifier throws.
+void decodeImageFromHostBuffer(int bufferId, ImageDecoderCallback callback)
+    native "decodeImageFromHostBuffer";
+
 /// Determines the winding rule that decides how the interior of a [Path] is
 /// calculated.
 ///
@@ -720,6 +826,33 @@ class Path extends NativeFieldWrapperClass2 {
   /// is less than 1, it is an ellipse.
   void relativeConicTo(double x1, double y1, double x2, double y2, double w) native "Path_relativeConicTo";
 
+  /// Adds a sequence of segments encoded as a flat list of numbers,
+  /// crossing into the engine only once for the whole sequence.
+  ///
+  /// The list is a series of commands, each consisting of an op code
+  /// followed by that op code's arguments. The op codes, and the
+  /// methods whose arguments they take, are:
+  ///
+  ///  *  0: [moveTo]
+  ///  *  1: [relativeMoveTo]
+  ///  *  2: [lineTo]
+  ///  *  3: [relativeLineTo]
+  ///  *  4: [quadraticBezierTo]
+  ///  *  5: [relativeQuadraticBezierTo]
+  ///  *  6: [cubicTo]
+  ///  *  7: [relativeCubicTo]
+  ///  *  8: [conicTo]
+  ///  *  9: [relativeConicTo]
+  ///  * 10: [close] (no arguments)
+  ///
+  /// Callers that build long paths every frame (e.g. when animating a
+  /// shape) should prefer this over issuing the segments one method
+  /// call at a time.
+  ///
+  /// If the list is malformed, the commands before the malformed entry
+  /// are applied and the remainder of the list is ignored.
+  void addCommands(Float32List commands) native "Path_addCommands";
+
   /// If the [forceMoveTo] argument is false, adds a straight line
   /// segment and an arc segment.
   ///
@@ -1183,6 +1316,55 @@ class Vertices extends NativeFieldWrapperClass2 {
     _init(mode.index, encodedPositions, encodedTexs, encodedColors, encodedIndices);
   }
 
+  /// Creates a set of vertex data from already-encoded typed data buffers,
+  /// passed to the engine without per-element conversion.
+  ///
+  /// The [positions] list (and [textureCoordinates], if provided) holds two
+  /// floats per vertex, x then y. The [colors] list holds one 32-bit ARGB
+  /// color per vertex. The [indices] values must be valid indices into the
+  /// vertex list; unlike the default constructor, this is not checked.
+  ///
+  /// Callers that regenerate geometry every frame should fill the same
+  /// buffers each frame and use [update] instead of constructing a new
+  /// object.
+  Vertices.raw(
+    VertexMode mode,
+    Float32List positions, {
+    Float32List textureCoordinates,
+    Int32List colors,
+    Int32List indices,
+  }) {
+    if (textureCoordinates != null && textureCoordinates.length != positions.length)
+      throw new ArgumentError("[positions] and [textureCoordinates] lengths must match");
+    if (colors != null && colors.length * 2 != positions.length)
+      throw new ArgumentError("[colors] length must be half the [positions] length");
+
+    _constructor();
+    _init(mode.index, positions, textureCoordinates, colors, indices);
+  }
+
+  /// Replaces the vertex data of this object in place, with the same
+  /// encoding as [new Vertices.raw].
+  ///
+  /// Draws recorded before the update keep the data they were recorded
+  /// with; only subsequent [Canvas.drawVertices] calls see the new data.
+  /// Rewriting an existing object avoids allocating a [Vertices] wrapper
+  /// per frame for dynamic geometry such as particle systems.
+  void update(
+    VertexMode mode,
+    Float32List positions, {
+    Float32List textureCoordinates,
+    Int32List colors,
+    Int32List indices,
+  }) {
+    if (textureCoordinates != null && textureCoordinates.length != positions.length)
+      throw new ArgumentError("[positions] and [textureCoordinates] lengths must match");
+    if (colors != null && colors.length * 2 != positions.length)
+      throw new ArgumentError("[colors] length must be half the [positions] length");
+
+    _init(mode.index, positions, textureCoordinates, colors, indices);
+  }
+
   void _constructor() native "Vertices_constructor";
 
   void _init(int mode,
@@ -1681,6 +1863,86 @@ class Canvas extends NativeFieldWrapperClass2 {
                    int color,
                    double elevation,
                    bool transparentOccluder) native "Canvas_drawShadow";
+
+  /// Replays a buffer of recorded canvas commands in a single call,
+  /// instead of one call per command.
+  ///
+  /// Callers that issue many commands per frame can record them into `ops`
+  /// (and `objects`) as they are produced and submit the whole batch here,
+  /// amortizing the engine call overhead across the batch. Commands recorded
+  /// this way behave exactly as if the corresponding methods had been called
+  /// in sequence, and batches can be freely interleaved with regular method
+  /// calls on the same canvas.
+  ///
+  /// The `ops` buffer is a sequence of commands. Each command is a 32-bit
+  /// integer op code followed by that command's arguments, each 32 bits wide:
+  /// integers and booleans (0 or 1) are encoded with [ByteData.setInt32],
+  /// coordinates and angles with [ByteData.setFloat32], both in
+  /// [Endianness.HOST_ENDIAN] byte order. Rounded rectangles are encoded as
+  /// 12 floats: left, top, right, bottom, then the x and y radii of the
+  /// top-left, top-right, bottom-right, and bottom-left corners. Angles are
+  /// in radians, as in the corresponding methods.
+  ///
+  /// The op codes, and the arguments each op reads, are:
+  ///
+  ///  *  0: [save] (no arguments)
+  ///  *  1: [restore] (no arguments)
+  ///  *  2: [translate] (dx, dy)
+  ///  *  3: [scale] (sx, sy)
+  ///  *  4: [rotate] (radians)
+  ///  *  5: [skew] (sx, sy)
+  ///  *  6: [transform] (16 floats in column-major order)
+  ///  *  7: [clipRect] (left, top, right, bottom)
+  ///  *  8: [clipRRect] (rounded rectangle)
+  ///  *  9: [clipPath] (objects: [Path])
+  ///  * 10: [drawColor] (color value, blend mode index)
+  ///  * 11: [drawLine] (objects: [Paint]; x1, y1, x2, y2)
+  ///  * 12: [drawPaint] (objects: [Paint])
+  ///  * 13: [drawRect] (objects: [Paint]; left, top, right, bottom)
+  ///  * 14: [drawRRect] (objects: [Paint]; rounded rectangle)
+  ///  * 15: [drawDRRect] (objects: [Paint]; outer then inner rounded
+  ///    rectangle)
+  ///  * 16: [drawOval] (objects: [Paint]; left, top, right, bottom)
+  ///  * 17: [drawCircle] (objects: [Paint]; x, y, radius)
+  ///  * 18: [drawArc] (objects: [Paint]; left, top, right, bottom,
+  ///    startAngle, sweepAngle, useCenter)
+  ///  * 19: [drawPath] (objects: [Paint], [Path])
+  ///  * 20: [drawImage] (objects: [Paint], [Image]; x, y)
+  ///  * 21: [drawImageRect] (objects: [Paint], [Image]; src left, top,
+  ///    right, bottom, then dst left, top, right, bottom)
+  ///  * 22: [drawPicture] (objects: [Picture])
+  ///  * 23: [saveLayer] (objects: [Paint]; left, top, right, bottom)
+  ///  * 24: [saveLayer] with null bounds (objects: [Paint])
+  ///  * 25: [drawShadow] (objects: [Path]; color value, elevation,
+  ///    transparentOccluder)
+  ///
+  /// Commands that take objects consume them from the `objects` list in
+  /// recording order, paint first. Commands whose arguments cannot be
+  /// encoded this way ([drawPoints], [drawVertices], [drawAtlas],
+  /// [drawImageNine]) have no op code; call them directly between batches.
+  ///
+  /// If the buffer is malformed, the commands before the malformed entry
+  /// are applied and the remainder of the buffer is ignored.
+  void drawOps(ByteData ops, List<dynamic> objects) {
+    if (ops == null)
+      throw new ArgumentError('The ops buffer was null.');
+    List<dynamic> flattened;
+    if (objects != null) {
+      // Each Paint is passed to the engine as its two encoded halves, the
+      // same way the individual draw methods pass them.
+      flattened = new List<dynamic>();
+      for (dynamic object in objects) {
+        if (object is Paint) {
+          flattened.add(object._objects);
+          flattened.add(object._data);
+        } else {
+          flattened.add(object);
+        }
+      }
+    }
+    _drawOps(ops, flattened);
+  }
+  void _drawOps(ByteData ops, List<dynamic> objects) native "Canvas_drawOps";
 }
 
 /// An object representing a sequence of recorded graphical operations.
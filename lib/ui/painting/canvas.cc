@@ -6,6 +6,8 @@
 
 #include <math.h>
 
+#include <vector>
+
 #include "flutter/flow/layers/physical_model_layer.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
@@ -13,6 +15,7 @@
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/dart_library_natives.h"
+#include "lib/tonic/typed_data/dart_byte_data.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
@@ -55,7 +58,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawPoints)             \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
-  V(Canvas, drawShadow)
+  V(Canvas, drawShadow)             \
+  V(Canvas, drawOps)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
@@ -389,6 +393,333 @@ void Canvas::drawShadow(const CanvasPath* path,
                                        transparentOccluder);
 }
 
+namespace {
+
+// Op codes for Canvas::drawOps. Must match the values documented on
+// Canvas.drawOps in painting.dart.
+enum CanvasOp {
+  kSaveOp = 0,
+  kRestoreOp = 1,
+  kTranslateOp = 2,
+  kScaleOp = 3,
+  kRotateOp = 4,
+  kSkewOp = 5,
+  kTransformOp = 6,
+  kClipRectOp = 7,
+  kClipRRectOp = 8,
+  kClipPathOp = 9,
+  kDrawColorOp = 10,
+  kDrawLineOp = 11,
+  kDrawPaintOp = 12,
+  kDrawRectOp = 13,
+  kDrawRRectOp = 14,
+  kDrawDRRectOp = 15,
+  kDrawOvalOp = 16,
+  kDrawCircleOp = 17,
+  kDrawArcOp = 18,
+  kDrawPathOp = 19,
+  kDrawImageOp = 20,
+  kDrawImageRectOp = 21,
+  kDrawPictureOp = 22,
+  kSaveLayerOp = 23,
+  kSaveLayerWithoutBoundsOp = 24,
+  kDrawShadowOp = 25,
+};
+
+// Reads the 12-float encoding used by RRect._value in painting.dart.
+SkRRect ReadRRect(const float* f) {
+  SkVector radii[4] = {
+      {f[4], f[5]}, {f[6], f[7]}, {f[8], f[9]}, {f[10], f[11]}};
+  SkRRect rrect;
+  rrect.setRectRadii(SkRect::MakeLTRB(f[0], f[1], f[2], f[3]), radii);
+  return rrect;
+}
+
+}  // namespace
+
+void Canvas::drawOps(Dart_Handle ops_data, Dart_Handle objects) {
+  if (!canvas_)
+    return;
+
+  // Copy the op buffer out before decoding: unwrapping the paint, path and
+  // image objects below re-enters the VM, which is not allowed while typed
+  // data is acquired. The copy is cheap next to the per-op native calls the
+  // buffer replaces.
+  std::vector<uint8_t> buffer;
+  {
+    tonic::DartByteData ops(ops_data);
+    const uint8_t* bytes = static_cast<const uint8_t*>(ops.data());
+    if (bytes)
+      buffer.assign(bytes, bytes + ops.length_in_bytes());
+  }
+
+  std::vector<Dart_Handle> handles;
+  if (!Dart_IsNull(objects)) {
+    intptr_t length = 0;
+    Dart_ListLength(objects, &length);
+    if (length > 0) {
+      handles.resize(length);
+      if (Dart_IsError(Dart_ListGetRange(objects, 0, length, handles.data())))
+        return;
+    }
+  }
+
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(buffer.data());
+  const float* floats = reinterpret_cast<const float*>(buffer.data());
+  const size_t word_count = buffer.size() / sizeof(uint32_t);
+  size_t i = 0;
+  size_t object_index = 0;
+
+  auto take_object = [&]() -> Dart_Handle {
+    if (object_index < handles.size())
+      return handles[object_index++];
+    return Dart_Null();
+  };
+  auto take_paint = [&](Paint* paint) -> bool {
+    Dart_Handle paint_objects = take_object();
+    Dart_Handle paint_data = take_object();
+    if (Dart_IsNull(paint_data))
+      return false;
+    *paint = DecodePaint(paint_objects, paint_data);
+    return true;
+  };
+  auto has_args = [&](size_t count) { return word_count - i >= count; };
+
+  while (i < word_count) {
+    const uint32_t op = words[i++];
+    switch (op) {
+      case kSaveOp:
+        canvas_->save();
+        break;
+      case kRestoreOp:
+        canvas_->restore();
+        break;
+      case kTranslateOp:
+        if (!has_args(2))
+          return;
+        canvas_->translate(floats[i], floats[i + 1]);
+        i += 2;
+        break;
+      case kScaleOp:
+        if (!has_args(2))
+          return;
+        canvas_->scale(floats[i], floats[i + 1]);
+        i += 2;
+        break;
+      case kRotateOp:
+        if (!has_args(1))
+          return;
+        canvas_->rotate(floats[i] * 180.0 / M_PI);
+        i += 1;
+        break;
+      case kSkewOp:
+        if (!has_args(2))
+          return;
+        canvas_->skew(floats[i], floats[i + 1]);
+        i += 2;
+        break;
+      case kTransformOp: {
+        if (!has_args(16))
+          return;
+        // Column-major 4x4, flattened to an SkMatrix with the same index
+        // mapping as ToSkMatrix in matrix.cc.
+        const float* m = &floats[i];
+        SkMatrix matrix;
+        matrix.setAll(m[0], m[4], m[12],  //
+                      m[1], m[5], m[13],  //
+                      m[3], m[7], m[15]);
+        canvas_->concat(matrix);
+        i += 16;
+        break;
+      }
+      case kClipRectOp:
+        if (!has_args(4))
+          return;
+        canvas_->clipRect(
+            SkRect::MakeLTRB(floats[i], floats[i + 1], floats[i + 2],
+                             floats[i + 3]));
+        i += 4;
+        break;
+      case kClipRRectOp:
+        if (!has_args(12))
+          return;
+        canvas_->clipRRect(ReadRRect(&floats[i]), true);
+        i += 12;
+        break;
+      case kClipPathOp: {
+        CanvasPath* path =
+            tonic::DartConverter<CanvasPath*>::FromDart(take_object());
+        if (!path)
+          return;
+        canvas_->clipPath(path->path(), true);
+        break;
+      }
+      case kDrawColorOp:
+        if (!has_args(2))
+          return;
+        canvas_->drawColor(static_cast<SkColor>(words[i]),
+                           static_cast<SkBlendMode>(words[i + 1]));
+        i += 2;
+        break;
+      case kDrawLineOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(4))
+          return;
+        canvas_->drawLine(floats[i], floats[i + 1], floats[i + 2],
+                          floats[i + 3], *paint.paint());
+        i += 4;
+        break;
+      }
+      case kDrawPaintOp: {
+        Paint paint;
+        if (!take_paint(&paint))
+          return;
+        canvas_->drawPaint(*paint.paint());
+        break;
+      }
+      case kDrawRectOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(4))
+          return;
+        canvas_->drawRect(SkRect::MakeLTRB(floats[i], floats[i + 1],
+                                           floats[i + 2], floats[i + 3]),
+                          *paint.paint());
+        i += 4;
+        break;
+      }
+      case kDrawRRectOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(12))
+          return;
+        canvas_->drawRRect(ReadRRect(&floats[i]), *paint.paint());
+        i += 12;
+        break;
+      }
+      case kDrawDRRectOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(24))
+          return;
+        canvas_->drawDRRect(ReadRRect(&floats[i]), ReadRRect(&floats[i + 12]),
+                            *paint.paint());
+        i += 24;
+        break;
+      }
+      case kDrawOvalOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(4))
+          return;
+        canvas_->drawOval(SkRect::MakeLTRB(floats[i], floats[i + 1],
+                                           floats[i + 2], floats[i + 3]),
+                          *paint.paint());
+        i += 4;
+        break;
+      }
+      case kDrawCircleOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(3))
+          return;
+        canvas_->drawCircle(floats[i], floats[i + 1], floats[i + 2],
+                            *paint.paint());
+        i += 3;
+        break;
+      }
+      case kDrawArcOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(7))
+          return;
+        canvas_->drawArc(SkRect::MakeLTRB(floats[i], floats[i + 1],
+                                          floats[i + 2], floats[i + 3]),
+                         floats[i + 4] * 180.0 / M_PI,
+                         floats[i + 5] * 180.0 / M_PI, words[i + 6],
+                         *paint.paint());
+        i += 7;
+        break;
+      }
+      case kDrawPathOp: {
+        Paint paint;
+        if (!take_paint(&paint))
+          return;
+        CanvasPath* path =
+            tonic::DartConverter<CanvasPath*>::FromDart(take_object());
+        if (!path)
+          return;
+        canvas_->drawPath(path->path(), *paint.paint());
+        break;
+      }
+      case kDrawImageOp: {
+        Paint paint;
+        if (!take_paint(&paint))
+          return;
+        CanvasImage* image =
+            tonic::DartConverter<CanvasImage*>::FromDart(take_object());
+        if (!image || !has_args(2))
+          return;
+        canvas_->drawImage(image->image(), floats[i], floats[i + 1],
+                           paint.paint());
+        i += 2;
+        break;
+      }
+      case kDrawImageRectOp: {
+        Paint paint;
+        if (!take_paint(&paint))
+          return;
+        CanvasImage* image =
+            tonic::DartConverter<CanvasImage*>::FromDart(take_object());
+        if (!image || !has_args(8))
+          return;
+        SkRect src = SkRect::MakeLTRB(floats[i], floats[i + 1], floats[i + 2],
+                                      floats[i + 3]);
+        SkRect dst = SkRect::MakeLTRB(floats[i + 4], floats[i + 5],
+                                      floats[i + 6], floats[i + 7]);
+        canvas_->drawImageRect(image->image(), src, dst, paint.paint(),
+                               SkCanvas::kFast_SrcRectConstraint);
+        i += 8;
+        break;
+      }
+      case kDrawPictureOp: {
+        Picture* picture =
+            tonic::DartConverter<Picture*>::FromDart(take_object());
+        if (!picture)
+          return;
+        canvas_->drawPicture(picture->picture().get());
+        break;
+      }
+      case kSaveLayerOp: {
+        Paint paint;
+        if (!take_paint(&paint) || !has_args(4))
+          return;
+        SkRect bounds = SkRect::MakeLTRB(floats[i], floats[i + 1],
+                                         floats[i + 2], floats[i + 3]);
+        canvas_->saveLayer(&bounds, paint.paint());
+        i += 4;
+        break;
+      }
+      case kSaveLayerWithoutBoundsOp: {
+        Paint paint;
+        if (!take_paint(&paint))
+          return;
+        canvas_->saveLayer(nullptr, paint.paint());
+        break;
+      }
+      case kDrawShadowOp: {
+        CanvasPath* path =
+            tonic::DartConverter<CanvasPath*>::FromDart(take_object());
+        if (!path || !has_args(3))
+          return;
+        flow::PhysicalModelLayer::DrawShadow(
+            canvas_, path->path(), static_cast<SkColor>(words[i]),
+            floats[i + 1], words[i + 2]);
+        i += 3;
+        break;
+      }
+      default:
+        // An unknown op makes the rest of the buffer unparseable; stop
+        // rather than misinterpret arguments as ops.
+        return;
+    }
+  }
+}
+
 void Canvas::Clear() {
   canvas_ = nullptr;
 }
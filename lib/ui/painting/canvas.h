@@ -162,6 +162,10 @@ class Canvas : public ftl::RefCountedThreadSafe<Canvas>,
                   double elevation,
                   bool transparentOccluder);
 
+  // Replays a buffer of ops recorded on the Dart side in a single native
+  // call. The binary format is documented on Canvas.drawOps in painting.dart.
+  void drawOps(Dart_Handle ops_data, Dart_Handle objects);
+
   SkCanvas* canvas() const { return canvas_; }
   void Clear();
   bool IsRecording() const;
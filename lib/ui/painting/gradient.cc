@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/gradient.h"
 
+#include "flutter/lib/ui/painting/shader_cache.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -48,10 +49,24 @@ void CanvasGradient::initLinear(const tonic::Float32List& end_points,
   static_assert(sizeof(SkColor) == sizeof(int32_t),
                 "SkColor doesn't use int32_t.");
 
-  set_shader(SkGradientShader::MakeLinear(
-      reinterpret_cast<const SkPoint*>(end_points.data()),
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode));
+  std::vector<uint8_t> key;
+  AppendShaderKeyValue(&key, ShaderKeyTag::kLinearGradient);
+  AppendShaderKeyBytes(&key, end_points.data(), 4 * sizeof(float));
+  AppendShaderKeyValue(&key, colors.num_elements());
+  AppendShaderKeyBytes(&key, colors.data(),
+                       colors.num_elements() * sizeof(int32_t));
+  if (color_stops.data()) {
+    AppendShaderKeyBytes(&key, color_stops.data(),
+                         color_stops.num_elements() * sizeof(float));
+  }
+  AppendShaderKeyValue(&key, tile_mode);
+
+  set_shader(ShaderCache::GetInstance().GetOrCreate(std::move(key), [&]() {
+    return SkGradientShader::MakeLinear(
+        reinterpret_cast<const SkPoint*>(end_points.data()),
+        reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
+        colors.num_elements(), tile_mode);
+  }));
 }
 
 void CanvasGradient::initRadial(double center_x,
@@ -66,10 +81,26 @@ void CanvasGradient::initRadial(double center_x,
   static_assert(sizeof(SkColor) == sizeof(int32_t),
                 "SkColor doesn't use int32_t.");
 
-  set_shader(SkGradientShader::MakeRadial(
-      SkPoint::Make(center_x, center_y), radius,
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode));
+  std::vector<uint8_t> key;
+  AppendShaderKeyValue(&key, ShaderKeyTag::kRadialGradient);
+  AppendShaderKeyValue(&key, center_x);
+  AppendShaderKeyValue(&key, center_y);
+  AppendShaderKeyValue(&key, radius);
+  AppendShaderKeyValue(&key, colors.num_elements());
+  AppendShaderKeyBytes(&key, colors.data(),
+                       colors.num_elements() * sizeof(int32_t));
+  if (color_stops.data()) {
+    AppendShaderKeyBytes(&key, color_stops.data(),
+                         color_stops.num_elements() * sizeof(float));
+  }
+  AppendShaderKeyValue(&key, tile_mode);
+
+  set_shader(ShaderCache::GetInstance().GetOrCreate(std::move(key), [&]() {
+    return SkGradientShader::MakeRadial(
+        SkPoint::Make(center_x, center_y), radius,
+        reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
+        colors.num_elements(), tile_mode);
+  }));
 }
 
 CanvasGradient::CanvasGradient() : Shader(nullptr) {}
@@ -0,0 +1,41 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/host_buffer_registry.h"
+
+namespace blink {
+
+HostBufferRegistry& HostBufferRegistry::Shared() {
+  static HostBufferRegistry* registry = new HostBufferRegistry();
+  return *registry;
+}
+
+HostBufferRegistry::HostBufferRegistry() {}
+
+HostBufferRegistry::~HostBufferRegistry() {}
+
+uint64_t HostBufferRegistry::Register(sk_sp<SkData> data) {
+  ftl::MutexLocker lock(&mutex_);
+  uint64_t id = next_id_++;
+  buffers_[id] = std::move(data);
+  return id;
+}
+
+sk_sp<SkData> HostBufferRegistry::Take(uint64_t id) {
+  ftl::MutexLocker lock(&mutex_);
+  auto it = buffers_.find(id);
+  if (it == buffers_.end()) {
+    return nullptr;
+  }
+  sk_sp<SkData> data = std::move(it->second);
+  buffers_.erase(it);
+  return data;
+}
+
+void HostBufferRegistry::Release(uint64_t id) {
+  ftl::MutexLocker lock(&mutex_);
+  buffers_.erase(id);
+}
+
+}  // namespace blink
@@ -0,0 +1,59 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_HOST_BUFFER_REGISTRY_H_
+#define FLUTTER_LIB_UI_PAINTING_HOST_BUFFER_REGISTRY_H_
+
+#include <stdint.h>
+
+#include <unordered_map>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/synchronization/mutex.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace blink {
+
+// Hands native byte buffers across the platform channel by id instead of by
+// value. The platform side registers bytes it already owns (e.g. a network
+// response body) and sends the returned id through its channel; the isolate
+// passes the id to decodeImageFromHostBuffer, which adopts the bytes
+// directly. The payload is never copied into a Dart list and never copied
+// back out of one.
+//
+// Registered on the platform thread and claimed on the UI thread, so the
+// table is locked. Each id is single-use: Take() removes the entry, and an
+// id the isolate never claims can be returned with Release() so abandoned
+// payloads do not accumulate.
+class HostBufferRegistry {
+ public:
+  static HostBufferRegistry& Shared();
+
+  // Stores |data| and returns the id to send across the channel. Ids are
+  // never reused.
+  uint64_t Register(sk_sp<SkData> data);
+
+  // Claims and removes the buffer for |id|, or null if the id is unknown
+  // or was already claimed.
+  sk_sp<SkData> Take(uint64_t id);
+
+  // Drops an unclaimed buffer, e.g. when the message carrying its id could
+  // not be delivered.
+  void Release(uint64_t id);
+
+ private:
+  HostBufferRegistry();
+
+  ~HostBufferRegistry();
+
+  ftl::Mutex mutex_;
+  uint64_t next_id_ = 1;
+  std::unordered_map<uint64_t, sk_sp<SkData>> buffers_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(HostBufferRegistry);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_PAINTING_HOST_BUFFER_REGISTRY_H_
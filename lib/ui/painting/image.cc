@@ -5,6 +5,8 @@
 #include "flutter/lib/ui/painting/image.h"
 
 #include "flutter/common/threads.h"
+#include "flutter/lib/ui/painting/image_registry.h"
+#include "flutter/lib/ui/painting/resource_context.h"
 #include "flutter/lib/ui/painting/utils.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
@@ -20,23 +22,139 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Image);
 #define FOR_EACH_BINDING(V) \
   V(Image, width)           \
   V(Image, height)          \
+  V(Image, pin)             \
+  V(Image, unpin)           \
+  V(Image, evict)           \
   V(Image, dispose)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
+namespace {
+
+void Image_setEvictionPolicy(Dart_NativeArguments args) {
+  Dart_Handle exception = nullptr;
+  int64_t max_bytes =
+      tonic::DartConverter<int64_t>::FromArguments(args, 0, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+  int64_t max_idle_frames =
+      tonic::DartConverter<int64_t>::FromArguments(args, 1, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+  ImageRegistry::Shared().SetDecodedByteBudget(
+      max_bytes < 0 ? 0 : static_cast<size_t>(max_bytes));
+  ImageRegistry::Shared().SetMaxIdleGenerations(
+      max_idle_frames < 0 ? 0 : static_cast<uint64_t>(max_idle_frames));
+}
+
+}  // namespace
+
 void CanvasImage::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->Register({
+      {"Image_setEvictionPolicy", Image_setEvictionPolicy, 2, true},
+  });
 }
 
-CanvasImage::CanvasImage() {}
+CanvasImage::CanvasImage() {
+  ImageRegistry::Shared().Register(this);
+}
 
 CanvasImage::~CanvasImage() {
+  ImageRegistry::Shared().Unregister(this);
+  if (pinned_) {
+    const uint32_t pinned_image_id = pinned_image_id_;
+    Threads::IO()->PostTask([pinned_image_id]() {
+      ResourceContext::UnpinImage(pinned_image_id);
+    });
+  }
+  // Skia objects must be deleted on the IO thread so that any associated GL
+  // objects will be cleaned up through the IO thread's GL context.
+  SkiaUnrefOnIOThread(&image_);
+}
+
+void CanvasImage::pin() {
+  if (pinned_ || !image_) {
+    return;
+  }
+  pinned_ = true;
+  pinned_image_id_ = image_->uniqueID();
+
+  // Upload on the IO thread, where the resource context is current, then
+  // swap the texture-backed image in on the UI thread so subsequent draws
+  // record it instead of re-uploading per draw.
+  ftl::RefPtr<CanvasImage> self(this);
+  sk_sp<SkImage> image = image_;
+  const uint32_t pinned_image_id = pinned_image_id_;
+  Threads::IO()->PostTask([self, image, pinned_image_id]() {
+    sk_sp<SkImage> texture_image = ResourceContext::PinImage(image);
+    if (!texture_image) {
+      return;
+    }
+    Threads::UI()->PostTask([self, texture_image, pinned_image_id]() {
+      // Ignore stale uploads: the image may have been unpinned, re-pinned,
+      // or replaced while the upload was in flight.
+      if (self->pinned_ && self->pinned_image_id_ == pinned_image_id) {
+        self->ReplaceImage(texture_image);
+      }
+    });
+  });
+}
+
+void CanvasImage::unpin() {
+  if (!pinned_) {
+    return;
+  }
+  pinned_ = false;
+  const uint32_t pinned_image_id = pinned_image_id_;
+  Threads::IO()->PostTask([pinned_image_id]() {
+    ResourceContext::UnpinImage(pinned_image_id);
+  });
+}
+
+const sk_sp<SkImage>& CanvasImage::image() const {
+  last_used_generation_ = ImageRegistry::Shared().generation();
+  return image_;
+}
+
+size_t CanvasImage::DecodedByteSize() const {
+  if (!image_) {
+    return 0;
+  }
+  // N32 estimate; compressed texture-backed images overestimate, which only
+  // makes the budget conservative.
+  return static_cast<size_t>(image_->width()) * image_->height() * 4;
+}
+
+void CanvasImage::Evict() {
+  if (pinned_) {
+    unpin();
+  }
+  // Skia objects must be deleted on the IO thread so that any associated GL
+  // objects will be cleaned up through the IO thread's GL context.
+  SkiaUnrefOnIOThread(&image_);
+}
+
+void CanvasImage::evict() {
+  Evict();
+}
+
+void CanvasImage::ReplaceImage(sk_sp<SkImage> image) {
   // Skia objects must be deleted on the IO thread so that any associated GL
   // objects will be cleaned up through the IO thread's GL context.
   SkiaUnrefOnIOThread(&image_);
+  image_ = std::move(image);
 }
 
 void CanvasImage::dispose() {
+  // Release the pixels now rather than when the GC gets around to the
+  // wrapper; disposal is the application's statement that the image will
+  // not be drawn again.
+  Evict();
   ClearDartWrapper();
 }
 
@@ -25,19 +25,47 @@ class CanvasImage final : public ftl::RefCountedThreadSafe<CanvasImage>,
     return ftl::MakeRefCounted<CanvasImage>();
   }
 
-  int width() { return image_->width(); }
-  int height() { return image_->height(); }
+  int width() { return image_ ? image_->width() : 0; }
+  int height() { return image_ ? image_->height() : 0; }
+  void pin();
+  void unpin();
+  void evict();
   void dispose();
 
-  const sk_sp<SkImage>& image() const { return image_; }
+  // Drops the decoded pixels now instead of waiting for the wrapper's
+  // finalizer. The image stays a valid object; drawing it is a no-op.
+  void Evict();
+
+  // Stamps the image as used in the current frame so the registry's idle
+  // and LRU eviction see it as hot.
+  const sk_sp<SkImage>& image() const;
   void set_image(sk_sp<SkImage> image) { image_ = std::move(image); }
 
+  bool is_pinned() const { return pinned_; }
+
+  // An estimate of the heap or GPU memory held by the decoded pixels; zero
+  // once evicted.
+  size_t DecodedByteSize() const;
+
+  uint64_t last_used_generation() const { return last_used_generation_; }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   CanvasImage();
 
+  // Swaps in a replacement image, sending the previous one to the IO thread
+  // for deletion.
+  void ReplaceImage(sk_sp<SkImage> image);
+
   sk_sp<SkImage> image_;
+  // Whether a pin is outstanding; the registered id is the uniqueID the
+  // image had when the pin was requested.
+  bool pinned_ = false;
+  uint32_t pinned_image_id_ = 0;
+  // The registry generation current when this image was last used; see
+  // ImageRegistry.
+  mutable uint64_t last_used_generation_ = 0;
 };
 
 }  // namespace blink
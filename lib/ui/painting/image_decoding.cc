@@ -4,21 +4,31 @@
 
 #include "flutter/lib/ui/painting/image_decoding.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+#include "flutter/common/performance_profile.h"
 #include "flutter/common/threads.h"
+#include "flutter/fml/thread_pool.h"
 #include "flutter/glue/trace_event.h"
+#include "flutter/lib/ui/painting/host_buffer_registry.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/resource_context.h"
-#include "lib/ftl/build_config.h"
 #include "lib/ftl/functional/make_copyable.h"
+#include "lib/ftl/logging.h"
+#include "lib/ftl/synchronization/mutex.h"
+#include "lib/ftl/time/time_point.h"
 #include "lib/tonic/dart_persistent_value.h"
 #include "lib/tonic/dart_state.h"
 #include "lib/tonic/logging/dart_invoke.h"
 #include "lib/tonic/typed_data/uint8_list.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
-
-#ifdef OS_ANDROID
-#include <GLES2/gl2.h>
-#endif
+#include "third_party/skia/include/gpu/GrContext.h"
+#include "third_party/skia/include/gpu/GrTexture.h"
 
 using tonic::DartInvoke;
 using tonic::DartPersistentValue;
@@ -27,6 +37,85 @@ using tonic::ToDart;
 namespace blink {
 namespace {
 
+// ETC1 payloads arrive in PKM containers (the format the Android tooling
+// emits): a 16 byte big-endian header followed by the compressed blocks.
+const size_t kPKMHeaderSize = 16;
+
+uint16_t ReadBigEndianUint16(const uint8_t* data) {
+  return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+bool IsPKMData(const SkData& buffer) {
+  static const uint8_t kPKMMagic[] = {'P', 'K', 'M', ' ', '1', '0'};
+  return buffer.size() > kPKMHeaderSize &&
+         memcmp(buffer.bytes(), kPKMMagic, sizeof(kPKMMagic)) == 0;
+}
+
+// Upload an ETC1 payload as a compressed texture without ever expanding it
+// to RGBA on the CPU. The texture stays compressed on the GPU as well,
+// which is 8x smaller than the raster equivalent. Returns nullptr when no
+// GPU context is available or the upload fails, in which case the caller
+// falls back to the raster decode path.
+sk_sp<SkImage> UploadCompressedETC1Image(const sk_sp<SkData>& buffer) {
+  TRACE_EVENT0("blink", "UploadCompressedETC1Image");
+
+  GrContext* context = ResourceContext::Get();
+  if (context == nullptr) {
+    return nullptr;
+  }
+
+  const uint8_t* header = buffer->bytes();
+  const uint16_t width = ReadBigEndianUint16(header + 12);
+  const uint16_t height = ReadBigEndianUint16(header + 14);
+
+  if (width == 0 || height == 0) {
+    return nullptr;
+  }
+
+  GrSurfaceDesc desc;
+  desc.fFlags = kNone_GrSurfaceFlags;
+  desc.fOrigin = kTopLeft_GrSurfaceOrigin;
+  desc.fWidth = width;
+  desc.fHeight = height;
+  desc.fConfig = kETC1_GrPixelConfig;
+  desc.fSampleCnt = 0;
+
+  GrTexture* texture = context->textureProvider()->createTexture(
+      desc, SkBudgeted::kYes, buffer->bytes() + kPKMHeaderSize, 0);
+
+  if (texture == nullptr) {
+    return nullptr;
+  }
+
+  GrBackendTextureDesc backend_desc;
+  backend_desc.fFlags = kNone_GrBackendTextureFlag;
+  backend_desc.fOrigin = kTopLeft_GrSurfaceOrigin;
+  backend_desc.fWidth = width;
+  backend_desc.fHeight = height;
+  backend_desc.fConfig = kETC1_GrPixelConfig;
+  backend_desc.fSampleCnt = 0;
+  backend_desc.fTextureHandle = texture->getTextureHandle();
+
+  auto image = SkImage::MakeFromTexture(
+      context, backend_desc, kOpaque_SkAlphaType,
+      [](void* release_context) {
+        reinterpret_cast<GrTexture*>(release_context)->unref();
+      },
+      texture);
+
+  if (image == nullptr) {
+    texture->unref();
+    return nullptr;
+  }
+
+  // The GPU thread draws this texture from a different context in the same
+  // share group. Submit the upload now so the texture is resident by the
+  // time the first frame that references it is rasterized.
+  context->flush();
+
+  return image;
+}
+
 sk_sp<SkImage> DecodeImage(sk_sp<SkData> buffer) {
   TRACE_EVENT0("blink", "DecodeImage");
 
@@ -34,6 +123,12 @@ sk_sp<SkImage> DecodeImage(sk_sp<SkData> buffer) {
     return nullptr;
   }
 
+  if (IsPKMData(*buffer)) {
+    if (auto compressed_image = UploadCompressedETC1Image(buffer)) {
+      return compressed_image;
+    }
+  }
+
   auto raster_image = SkImage::MakeFromEncoded(std::move(buffer));
 
   if (raster_image == nullptr) {
@@ -44,9 +139,9 @@ sk_sp<SkImage> DecodeImage(sk_sp<SkData> buffer) {
     // TODO: Supply actual destination color space once available
     if (auto texture_image =
             raster_image->makeTextureImage(context, nullptr)) {
-#ifdef OS_ANDROID
-      glFlush();
-#endif
+      // Make the upload visible to the GPU thread's context; see
+      // UploadCompressedETC1Image.
+      context->flush();
       return texture_image;
     }
   }
@@ -69,17 +164,311 @@ void InvokeImageCallback(sk_sp<SkImage> image,
   }
 }
 
-void DecodeImageAndInvokeImageCallback(
+// Decode scheduling ----------------------------------------------------------
+
+// Decodes are pulled from the visible lane first, then near-viewport, then
+// prefetch, so a burst of speculative work never delays the image the user
+// is actually looking at. The lane indices match the ImageDecodePriority
+// enum on the Dart side.
+enum : int {
+  kDecodePriorityVisible = 0,
+  kDecodePriorityNearViewport = 1,
+  kDecodePriorityPrefetch = 2,
+  kDecodePriorityCount = 3,
+};
+
+// Default cap on decodes running concurrently on the shared worker pool so
+// image bursts do not crowd out its other users. The active performance
+// profile may lower or restore it at runtime.
+const size_t kDefaultMaxConcurrentDecodes = 2;
+
+struct DecodeTask {
+  std::unique_ptr<DartPersistentValue> callback;
+  sk_sp<SkData> buffer;
+  // The dimensions the image will be displayed at, or zero to decode at the
+  // image's native size.
+  int target_width = 0;
+  int target_height = 0;
+};
+
+// Decode durations bucketed by how badly they would have blown a frame
+// budget, plus the decodes skipped because their isolate went away while
+// they were still queued. Logged periodically.
+struct DecodeStatistics {
+  size_t completed = 0;
+  size_t canceled = 0;
+  size_t duration_buckets[4] = {0, 0, 0, 0};  // <8ms, <32ms, <128ms, rest.
+};
+
+struct DecodeQueueState {
+  ftl::Mutex mutex;
+  // Guarded by |mutex|.
+  std::deque<DecodeTask> lanes[kDecodePriorityCount];
+  size_t active_decodes = 0;
+  size_t max_concurrent_decodes = kDefaultMaxConcurrentDecodes;
+  DecodeStatistics statistics;
+};
+
+DecodeQueueState& QueueState() {
+  // Deliberately leaked: decodes may be in flight at shutdown.
+  static auto* state = new DecodeQueueState();
+  return *state;
+}
+
+void RecordDecodeDuration(ftl::TimeDelta duration) {
+  int64_t millis = duration.ToMilliseconds();
+  size_t bucket = millis < 8 ? 0 : millis < 32 ? 1 : millis < 128 ? 2 : 3;
+
+  DecodeQueueState& state = QueueState();
+  ftl::MutexLocker lock(&state.mutex);
+  state.statistics.duration_buckets[bucket]++;
+  state.statistics.completed++;
+  if (state.statistics.completed % 128 == 0) {
+    const auto& stats = state.statistics;
+    FTL_DLOG(INFO) << "Image decode times: " << stats.completed
+                   << " completed (<8ms: " << stats.duration_buckets[0]
+                   << ", <32ms: " << stats.duration_buckets[1]
+                   << ", <128ms: " << stats.duration_buckets[2]
+                   << ", slower: " << stats.duration_buckets[3] << "), "
+                   << stats.canceled << " canceled.";
+  }
+}
+
+// Decode the image at the smallest size the codec supports that still
+// covers |target_width| x |target_height|, so memory and decode time scale
+// with what is displayed rather than with the file. JPEGs use
+// libjpeg-turbo's fractional scaled decode underneath. Returns nullptr when
+// the image is already no larger than the target or the codec cannot
+// subsample it, in which case the caller decodes at native size.
+sk_sp<SkImage> DecodeScaledRasterImage(const sk_sp<SkData>& buffer,
+                                       int target_width,
+                                       int target_height) {
+  TRACE_EVENT0("blink", "DecodeScaledRasterImage");
+
+  std::unique_ptr<SkCodec> codec(SkCodec::NewFromData(buffer));
+
+  if (codec == nullptr) {
+    return nullptr;
+  }
+
+  const SkImageInfo& native_info = codec->getInfo();
+
+  if (native_info.width() <= target_width ||
+      native_info.height() <= target_height) {
+    return nullptr;
+  }
+
+  // The larger of the two ratios, so the decoded image covers the target
+  // box in both dimensions while keeping its aspect ratio.
+  float scale = std::max(
+      target_width / static_cast<float>(native_info.width()),
+      target_height / static_cast<float>(native_info.height()));
+
+  SkISize scaled_size = codec->getScaledDimensions(scale);
+  SkImageInfo info =
+      native_info.makeWH(scaled_size.width(), scaled_size.height());
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) {
+    return nullptr;
+  }
+
+  if (codec->getPixels(info, bitmap.getPixels(), bitmap.rowBytes()) !=
+      SkCodec::kSuccess) {
+    return nullptr;
+  }
+
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+// Decode the image to a raster bitmap on the calling (worker) thread. The
+// GPU upload cannot happen here; that is the IO thread's job.
+sk_sp<SkImage> DecodeRasterImage(const sk_sp<SkData>& buffer) {
+  TRACE_EVENT0("blink", "DecodeRasterImage");
+
+  std::unique_ptr<SkImageGenerator> generator(
+      SkImageGenerator::NewFromEncoded(buffer.get()));
+
+  if (generator == nullptr) {
+    return nullptr;
+  }
+
+  const SkImageInfo info = generator->getInfo();
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) {
+    return nullptr;
+  }
+
+  if (!generator->getPixels(info, bitmap.getPixels(), bitmap.rowBytes())) {
+    return nullptr;
+  }
+
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+// Runs on the IO thread, where the resource context lives.
+void UploadImageAndInvokeImageCallback(
     std::unique_ptr<DartPersistentValue> callback,
-    sk_sp<SkData> buffer) {
-  sk_sp<SkImage> image = DecodeImage(std::move(buffer));
+    sk_sp<SkData> buffer,
+    sk_sp<SkImage> raster_image) {
+  sk_sp<SkImage> image;
+
+  if (raster_image == nullptr) {
+    // Compressed payloads and raster decode failures take the full
+    // IO-thread decode path.
+    image = DecodeImage(std::move(buffer));
+  } else {
+    image = raster_image;
+    if (auto context = ResourceContext::Get()) {
+      // TODO: Supply actual destination color space once available
+      if (auto texture_image = raster_image->makeTextureImage(context,
+                                                              nullptr)) {
+        // Make the upload visible to the GPU thread's context; see
+        // UploadCompressedETC1Image.
+        context->flush();
+        image = texture_image;
+      }
+    }
+  }
+
   Threads::UI()->PostTask(
       ftl::MakeCopyable([ callback = std::move(callback), image ]() mutable {
         InvokeImageCallback(image, std::move(callback));
       }));
 }
 
-void DecodeImageFromList(Dart_NativeArguments args) {
+void PumpDecodeQueue();
+
+// Runs on a worker from the shared pool.
+void RunDecodeTask(DecodeTask task) {
+  // If the callback's isolate died while this task sat in the queue, the
+  // result could never be delivered; skip the decode entirely. The callback
+  // is still shipped to the UI thread so it is collected where it was
+  // created.
+  if (task.callback->dart_state().get() == nullptr) {
+    DecodeQueueState& state = QueueState();
+    {
+      ftl::MutexLocker lock(&state.mutex);
+      state.statistics.canceled++;
+    }
+    Threads::UI()->PostTask(
+        ftl::MakeCopyable([callback = std::move(task.callback)]() mutable {
+          InvokeImageCallback(nullptr, std::move(callback));
+        }));
+  } else {
+    sk_sp<SkImage> raster_image;
+
+    ftl::TimePoint decode_start = ftl::TimePoint::Now();
+    if (!IsPKMData(*task.buffer)) {
+      if (task.target_width > 0 && task.target_height > 0) {
+        raster_image = DecodeScaledRasterImage(task.buffer, task.target_width,
+                                               task.target_height);
+      }
+      if (raster_image == nullptr) {
+        raster_image = DecodeRasterImage(task.buffer);
+      }
+    }
+    RecordDecodeDuration(ftl::TimePoint::Now() - decode_start);
+
+    Threads::IO()->PostTask(ftl::MakeCopyable([
+      callback = std::move(task.callback), buffer = std::move(task.buffer),
+      raster_image
+    ]() mutable {
+      UploadImageAndInvokeImageCallback(std::move(callback),
+                                        std::move(buffer),
+                                        std::move(raster_image));
+    }));
+  }
+
+  {
+    ftl::MutexLocker lock(&QueueState().mutex);
+    QueueState().active_decodes--;
+  }
+  PumpDecodeQueue();
+}
+
+void PumpDecodeQueue() {
+  DecodeQueueState& state = QueueState();
+
+  while (true) {
+    DecodeTask task;
+
+    {
+      ftl::MutexLocker lock(&state.mutex);
+
+      if (state.active_decodes >= state.max_concurrent_decodes) {
+        return;
+      }
+
+      int lane = 0;
+      while (lane < kDecodePriorityCount && state.lanes[lane].empty()) {
+        lane++;
+      }
+
+      if (lane == kDecodePriorityCount) {
+        return;
+      }
+
+      task = std::move(state.lanes[lane].front());
+      state.lanes[lane].pop_front();
+      state.active_decodes++;
+    }
+
+    fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+        ftl::MakeCopyable([task = std::move(task)]() mutable {
+          RunDecodeTask(std::move(task));
+        }));
+  }
+}
+
+// Keeps the decode concurrency cap in sync with the active performance
+// profile. Registered lazily because the registry posts to the IO thread,
+// which does not exist until the shell is up.
+void EnsureProfileObserver() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    PerformanceProfileObserverRegistry::AddObserver(
+        Threads::IO(), [](const PerformanceProfile& profile) {
+          {
+            ftl::MutexLocker lock(&QueueState().mutex);
+            QueueState().max_concurrent_decodes =
+                std::max<size_t>(1, profile.max_concurrent_decodes);
+          }
+          // A raised cap may unblock queued decodes immediately.
+          PumpDecodeQueue();
+        });
+  });
+}
+
+void EnqueueDecode(int priority,
+                   std::unique_ptr<DartPersistentValue> callback,
+                   sk_sp<SkData> buffer,
+                   int target_width,
+                   int target_height) {
+  EnsureProfileObserver();
+
+  if (priority < 0 || priority >= kDecodePriorityCount) {
+    priority = kDecodePriorityVisible;
+  }
+
+  {
+    DecodeQueueState& state = QueueState();
+    ftl::MutexLocker lock(&state.mutex);
+    state.lanes[priority].push_back({std::move(callback), std::move(buffer),
+                                     target_width, target_height});
+  }
+
+  PumpDecodeQueue();
+}
+
+void DecodeImageFromListImpl(Dart_NativeArguments args,
+                             int priority,
+                             int target_width,
+                             int target_height,
+                             int callback_index) {
   Dart_Handle exception = nullptr;
 
   tonic::Uint8List list =
@@ -89,7 +478,7 @@ void DecodeImageFromList(Dart_NativeArguments args) {
     return;
   }
 
-  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 1);
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, callback_index);
   if (!Dart_IsClosure(callback_handle)) {
     Dart_ThrowException(ToDart("Callback must be a function"));
     return;
@@ -97,20 +486,89 @@ void DecodeImageFromList(Dart_NativeArguments args) {
 
   auto buffer = SkData::MakeWithCopy(list.data(), list.num_elements());
 
-  Threads::IO()->PostTask(ftl::MakeCopyable([
-    callback = std::make_unique<DartPersistentValue>(
-        tonic::DartState::Current(), callback_handle),
-    buffer = std::move(buffer)
-  ]() mutable {
-    DecodeImageAndInvokeImageCallback(std::move(callback), std::move(buffer));
-  }));
+  EnqueueDecode(priority,
+                std::make_unique<DartPersistentValue>(
+                    tonic::DartState::Current(), callback_handle),
+                std::move(buffer), target_width, target_height);
+}
+
+void DecodeImageFromList(Dart_NativeArguments args) {
+  DecodeImageFromListImpl(args, kDecodePriorityVisible, 0, 0, 1);
+}
+
+void DecodeImageFromHostBuffer(Dart_NativeArguments args) {
+  Dart_Handle exception = nullptr;
+
+  int64_t buffer_id =
+      tonic::DartConverter<int64_t>::FromArguments(args, 0, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 1);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_ThrowException(ToDart("Callback must be a function"));
+    return;
+  }
+
+  // The bytes were registered by the platform side and only their id
+  // crossed the channel; adopting them here is the first and last time
+  // this isolate touches them.
+  sk_sp<SkData> buffer = HostBufferRegistry::Shared().Take(buffer_id);
+  if (!buffer) {
+    Dart_ThrowException(ToDart("Unknown or already claimed host buffer"));
+    return;
+  }
+
+  EnqueueDecode(kDecodePriorityVisible,
+                std::make_unique<DartPersistentValue>(
+                    tonic::DartState::Current(), callback_handle),
+                std::move(buffer), 0, 0);
+}
+
+void DecodeImageFromListAtPriority(Dart_NativeArguments args) {
+  Dart_Handle exception = nullptr;
+
+  int priority = tonic::DartConverter<int>::FromArguments(args, 1, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  DecodeImageFromListImpl(args, priority, 0, 0, 2);
+}
+
+void DecodeImageFromListWithTargetSize(Dart_NativeArguments args) {
+  Dart_Handle exception = nullptr;
+
+  int target_width =
+      tonic::DartConverter<int>::FromArguments(args, 1, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  int target_height =
+      tonic::DartConverter<int>::FromArguments(args, 2, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  DecodeImageFromListImpl(args, kDecodePriorityVisible, target_width,
+                          target_height, 3);
 }
 
 }  // namespace
 
 void ImageDecoding::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({
+      {"decodeImageFromHostBuffer", DecodeImageFromHostBuffer, 2, true},
       {"decodeImageFromList", DecodeImageFromList, 2, true},
+      {"decodeImageFromListAtPriority", DecodeImageFromListAtPriority, 3, true},
+      {"decodeImageFromListWithTargetSize", DecodeImageFromListWithTargetSize,
+       4, true},
   });
 }
 
@@ -0,0 +1,93 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_registry.h"
+
+#include <algorithm>
+
+#include "flutter/lib/ui/painting/image.h"
+
+namespace blink {
+
+ImageRegistry& ImageRegistry::Shared() {
+  static ImageRegistry* registry = new ImageRegistry();
+  return *registry;
+}
+
+ImageRegistry::ImageRegistry()
+    : generation_(1), decoded_byte_budget_(0), max_idle_generations_(0) {}
+
+ImageRegistry::~ImageRegistry() = default;
+
+void ImageRegistry::Register(CanvasImage* image) {
+  images_.push_back(image);
+}
+
+void ImageRegistry::Unregister(CanvasImage* image) {
+  auto found = std::find(images_.begin(), images_.end(), image);
+  if (found != images_.end()) {
+    images_.erase(found);
+  }
+}
+
+void ImageRegistry::SetDecodedByteBudget(size_t bytes) {
+  decoded_byte_budget_ = bytes;
+}
+
+void ImageRegistry::SetMaxIdleGenerations(uint64_t generations) {
+  max_idle_generations_ = generations;
+}
+
+void ImageRegistry::AdvanceGeneration() {
+  generation_++;
+
+  if (max_idle_generations_ == 0 && decoded_byte_budget_ == 0) {
+    return;
+  }
+
+  // Evictable: holds pixels and is not pinned to the GPU. Images used this
+  // frame have last_used_generation() == generation_ - 1 (the stamp is
+  // taken before the advance).
+  std::vector<CanvasImage*> candidates;
+  size_t total_bytes = 0;
+  for (CanvasImage* image : images_) {
+    if (image->DecodedByteSize() == 0 || image->is_pinned()) {
+      continue;
+    }
+    total_bytes += image->DecodedByteSize();
+    candidates.push_back(image);
+  }
+
+  if (max_idle_generations_ > 0) {
+    for (CanvasImage* image : candidates) {
+      if (generation_ - image->last_used_generation() > max_idle_generations_) {
+        total_bytes -= image->DecodedByteSize();
+        image->Evict();
+      }
+    }
+  }
+
+  if (decoded_byte_budget_ == 0 || total_bytes <= decoded_byte_budget_) {
+    return;
+  }
+
+  // Over budget: drop the least recently used images first.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const CanvasImage* a, const CanvasImage* b) {
+              return a->last_used_generation() < b->last_used_generation();
+            });
+  for (CanvasImage* image : candidates) {
+    if (total_bytes <= decoded_byte_budget_) {
+      break;
+    }
+    if (image->DecodedByteSize() == 0) {
+      // Already evicted by the idle pass.
+      continue;
+    }
+    total_bytes -= image->DecodedByteSize();
+    image->Evict();
+  }
+}
+
+}  // namespace blink
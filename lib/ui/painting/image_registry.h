@@ -0,0 +1,72 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_REGISTRY_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_REGISTRY_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+class CanvasImage;
+
+// Registry of the live decoded images in the UI isolate, giving their
+// pixels deterministic lifetime instead of leaving it to GC timing. Images
+// register on creation and unregister on destruction (weak registration:
+// the registry never extends an image's life). Once per frame the sweep
+// drops the decoded pixels of images that have not been used for the
+// configured number of frames, then evicts least-recently-used images
+// until the total decoded bytes fit the configured budget. Pinned images
+// and images already evicted are exempt.
+//
+// Both limits default to disabled, so nothing is dropped behind an
+// application's back unless it opts in via Image.setEvictionPolicy.
+// Explicit Image.evict and Image.dispose release pixels immediately
+// regardless of policy.
+//
+// Used only on the UI thread.
+class ImageRegistry {
+ public:
+  static ImageRegistry& Shared();
+
+  void Register(CanvasImage* image);
+
+  void Unregister(CanvasImage* image);
+
+  // The current frame generation; images stamp this on use so the sweep
+  // can tell how long ago each one was painted.
+  uint64_t generation() const { return generation_; }
+
+  // Advances the generation and applies the eviction policy. Called once
+  // per frame at the start of the frame build.
+  void AdvanceGeneration();
+
+  // Caps the total decoded bytes held by unpinned images; zero disables
+  // the bound.
+  void SetDecodedByteBudget(size_t bytes);
+
+  // Drops images not used for this many frames; zero disables idle
+  // eviction.
+  void SetMaxIdleGenerations(uint64_t generations);
+
+ private:
+  ImageRegistry();
+
+  ~ImageRegistry();
+
+  std::vector<CanvasImage*> images_;
+  uint64_t generation_;
+  size_t decoded_byte_budget_;
+  uint64_t max_idle_generations_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ImageRegistry);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_REGISTRY_H_
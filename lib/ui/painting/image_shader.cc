@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_shader.h"
 
+#include "flutter/lib/ui/painting/shader_cache.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -37,7 +38,22 @@ void ImageShader::initWithImage(CanvasImage* image,
                                 const tonic::Float64List& matrix4) {
   FTL_DCHECK(image != NULL);
   SkMatrix sk_matrix = ToSkMatrix(matrix4);
-  set_shader(image->image()->makeShader(tmx, tmy, &sk_matrix));
+
+  // Keyed by the SkImage's uniqueID, so interning only merges shaders built
+  // from the same decoded image instance.
+  SkScalar matrix_values[9];
+  sk_matrix.get9(matrix_values);
+  std::vector<uint8_t> key;
+  AppendShaderKeyValue(&key, ShaderKeyTag::kImageShader);
+  AppendShaderKeyValue(&key, image->image()->uniqueID());
+  AppendShaderKeyValue(&key, tmx);
+  AppendShaderKeyValue(&key, tmy);
+  AppendShaderKeyBytes(&key, matrix_values, sizeof(matrix_values));
+
+  sk_sp<SkImage> sk_image = image->image();
+  set_shader(ShaderCache::GetInstance().GetOrCreate(std::move(key), [&]() {
+    return sk_image->makeShader(tmx, tmy, &sk_matrix);
+  }));
 }
 
 ImageShader::ImageShader() : Shader(nullptr) {}
@@ -15,7 +15,8 @@
 
 using namespace blink;
 
-namespace tonic {
+namespace blink {
+namespace {
 
 constexpr int kIsAntiAliasIndex = 0;
 constexpr int kColorIndex = 1;
@@ -33,15 +34,9 @@ constexpr int kMaskFilterIndex = 0;
 constexpr int kShaderIndex = 1;
 constexpr int kObjectCount = 2;  // Must be one larger than the largest index
 
-Paint DartConverter<Paint>::FromArguments(Dart_NativeArguments args,
-                                          int index,
-                                          Dart_Handle& exception) {
-  Dart_Handle paint_objects = Dart_GetNativeArgument(args, index);
-  FTL_DCHECK(!LogIfError(paint_objects));
-
-  Dart_Handle paint_data = Dart_GetNativeArgument(args, index + 1);
-  FTL_DCHECK(!LogIfError(paint_data));
+}  // namespace
 
+Paint DecodePaint(Dart_Handle paint_objects, Dart_Handle paint_data) {
   Paint result;
   SkPaint& paint = result.paint_;
 
@@ -57,13 +52,14 @@ Paint DartConverter<Paint>::FromArguments(Dart_NativeArguments args,
 
     Dart_Handle mask_filter = values[kMaskFilterIndex];
     if (!Dart_IsNull(mask_filter)) {
-      MaskFilter* decoded = DartConverter<MaskFilter*>::FromDart(mask_filter);
+      MaskFilter* decoded =
+          tonic::DartConverter<MaskFilter*>::FromDart(mask_filter);
       paint.setMaskFilter(decoded->filter());
     }
 
     Dart_Handle shader = values[kShaderIndex];
     if (!Dart_IsNull(shader)) {
-      Shader* decoded = DartConverter<Shader*>::FromDart(shader);
+      Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader);
       paint.setShader(decoded->shader());
     }
   }
@@ -116,6 +112,22 @@ Paint DartConverter<Paint>::FromArguments(Dart_NativeArguments args,
   return result;
 }
 
+}  // namespace blink
+
+namespace tonic {
+
+Paint DartConverter<Paint>::FromArguments(Dart_NativeArguments args,
+                                          int index,
+                                          Dart_Handle& exception) {
+  Dart_Handle paint_objects = Dart_GetNativeArgument(args, index);
+  FTL_DCHECK(!LogIfError(paint_objects));
+
+  Dart_Handle paint_data = Dart_GetNativeArgument(args, index + 1);
+  FTL_DCHECK(!LogIfError(paint_data));
+
+  return DecodePaint(paint_objects, paint_data);
+}
+
 PaintData DartConverter<PaintData>::FromArguments(Dart_NativeArguments args,
                                                   int index,
                                                   Dart_Handle& exception) {
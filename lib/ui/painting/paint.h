@@ -16,11 +16,18 @@ class Paint {
 
  private:
   friend struct tonic::DartConverter<Paint>;
+  friend Paint DecodePaint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
   SkPaint paint_;
   bool is_null_;
 };
 
+// Decodes the encoding produced by Paint._objects and Paint._data in
+// painting.dart. Used by DartConverter<Paint>, which reads the two halves
+// from adjacent native arguments, and by callers that receive them some
+// other way (e.g. Canvas op buffer replay).
+Paint DecodePaint(Dart_Handle paint_objects, Dart_Handle paint_data);
+
 // The PaintData argument is a placeholder to receive encoded data for Paint
 // objects. The data is actually processed by DartConverter<Paint>, which reads
 // both at the given index and at the next index (which it assumes is a byte
@@ -35,6 +35,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Path);
   V(Path, relativeCubicTo)           \
   V(Path, conicTo)                   \
   V(Path, relativeConicTo)           \
+  V(Path, addCommands)               \
   V(Path, arcTo)                     \
   V(Path, addRect)                   \
   V(Path, addOval)                   \
@@ -125,6 +126,103 @@ void CanvasPath::relativeConicTo(float x1,
   path_.rConicTo(x1, y1, x2, y2, w);
 }
 
+void CanvasPath::addCommands(const tonic::Float32List& commands) {
+  // Op codes and argument counts must match Path.addCommands in
+  // painting.dart.
+  enum PathCommand {
+    kMoveTo = 0,
+    kRelativeMoveTo = 1,
+    kLineTo = 2,
+    kRelativeLineTo = 3,
+    kQuadraticBezierTo = 4,
+    kRelativeQuadraticBezierTo = 5,
+    kCubicTo = 6,
+    kRelativeCubicTo = 7,
+    kConicTo = 8,
+    kRelativeConicTo = 9,
+    kClose = 10,
+  };
+  const float* data = commands.data();
+  const int length = commands.num_elements();
+  int i = 0;
+  while (i < length) {
+    const int command = static_cast<int>(data[i++]);
+    switch (command) {
+      case kMoveTo:
+        if (length - i < 2)
+          return;
+        path_.moveTo(data[i], data[i + 1]);
+        i += 2;
+        break;
+      case kRelativeMoveTo:
+        if (length - i < 2)
+          return;
+        path_.rMoveTo(data[i], data[i + 1]);
+        i += 2;
+        break;
+      case kLineTo:
+        if (length - i < 2)
+          return;
+        path_.lineTo(data[i], data[i + 1]);
+        i += 2;
+        break;
+      case kRelativeLineTo:
+        if (length - i < 2)
+          return;
+        path_.rLineTo(data[i], data[i + 1]);
+        i += 2;
+        break;
+      case kQuadraticBezierTo:
+        if (length - i < 4)
+          return;
+        path_.quadTo(data[i], data[i + 1], data[i + 2], data[i + 3]);
+        i += 4;
+        break;
+      case kRelativeQuadraticBezierTo:
+        if (length - i < 4)
+          return;
+        path_.rQuadTo(data[i], data[i + 1], data[i + 2], data[i + 3]);
+        i += 4;
+        break;
+      case kCubicTo:
+        if (length - i < 6)
+          return;
+        path_.cubicTo(data[i], data[i + 1], data[i + 2], data[i + 3],
+                      data[i + 4], data[i + 5]);
+        i += 6;
+        break;
+      case kRelativeCubicTo:
+        if (length - i < 6)
+          return;
+        path_.rCubicTo(data[i], data[i + 1], data[i + 2], data[i + 3],
+                       data[i + 4], data[i + 5]);
+        i += 6;
+        break;
+      case kConicTo:
+        if (length - i < 5)
+          return;
+        path_.conicTo(data[i], data[i + 1], data[i + 2], data[i + 3],
+                      data[i + 4]);
+        i += 5;
+        break;
+      case kRelativeConicTo:
+        if (length - i < 5)
+          return;
+        path_.rConicTo(data[i], data[i + 1], data[i + 2], data[i + 3],
+                       data[i + 4]);
+        i += 5;
+        break;
+      case kClose:
+        path_.close();
+        break;
+      default:
+        // An unknown op makes the rest of the buffer unparseable; stop
+        // rather than misinterpret coordinates as commands.
+        return;
+    }
+  }
+}
+
 void CanvasPath::arcTo(float left,
                        float top,
                        float right,
@@ -46,6 +46,7 @@ class CanvasPath : public ftl::RefCountedThreadSafe<CanvasPath>,
                        float y3);
   void conicTo(float x1, float y1, float x2, float y2, float w);
   void relativeConicTo(float x1, float y1, float x2, float y2, float w);
+  void addCommands(const tonic::Float32List& commands);
   void arcTo(float left,
              float top,
              float right,
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/picture.h"
 
 #include "flutter/common/threads.h"
+#include "flutter/flow/picture_registry.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/utils.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -23,13 +24,25 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Picture);
 
 DART_BIND_ALL(Picture, FOR_EACH_BINDING)
 
-ftl::RefPtr<Picture> Picture::Create(sk_sp<SkPicture> picture) {
-  return ftl::MakeRefCounted<Picture>(std::move(picture));
+ftl::RefPtr<Picture> Picture::Create(sk_sp<SkPicture> picture,
+                                     const flow::PictureMetadata& metadata) {
+  return ftl::MakeRefCounted<Picture>(std::move(picture), metadata);
 }
 
-Picture::Picture(sk_sp<SkPicture> picture) : picture_(std::move(picture)) {}
+Picture::Picture(sk_sp<SkPicture> picture,
+                 const flow::PictureMetadata& metadata)
+    : picture_(std::move(picture)), metadata_(metadata) {
+  if (picture_) {
+    flow::PictureRegistry::Shared().AddPictureRef(picture_->uniqueID());
+  }
+}
 
 Picture::~Picture() {
+  if (picture_) {
+    // The raster cache entries this picture backed are released once the
+    // registry sees its last wrapper die.
+    flow::PictureRegistry::Shared().ReleasePictureRef(picture_->uniqueID());
+  }
   // Skia objects must be deleted on the IO thread so that any associated GL
   // objects will be cleaned up through the IO thread's GL context.
   SkiaUnrefOnIOThread(&picture_);
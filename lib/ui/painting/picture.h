@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include "flutter/flow/picture_raster_cost.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "lib/tonic/dart_wrappable.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -23,10 +24,14 @@ class Picture : public ftl::RefCountedThreadSafe<Picture>,
 
  public:
   ~Picture() override;
-  static ftl::RefPtr<Picture> Create(sk_sp<SkPicture> picture);
+  static ftl::RefPtr<Picture> Create(sk_sp<SkPicture> picture,
+                                     const flow::PictureMetadata& metadata);
 
   const sk_sp<SkPicture>& picture() const { return picture_; }
 
+  // Content statistics computed when recording ended.
+  const flow::PictureMetadata& metadata() const { return metadata_; }
+
   ftl::RefPtr<CanvasImage> toImage(int width, int height);
 
   void dispose();
@@ -34,9 +39,10 @@ class Picture : public ftl::RefCountedThreadSafe<Picture>,
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
-  explicit Picture(sk_sp<SkPicture> picture);
+  Picture(sk_sp<SkPicture> picture, const flow::PictureMetadata& metadata);
 
   sk_sp<SkPicture> picture_;
+  flow::PictureMetadata metadata_;
 };
 
 }  // namespace blink
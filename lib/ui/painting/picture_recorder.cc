@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/picture_recorder.h"
 
+#include "flutter/flow/picture_identity.h"
+#include "flutter/flow/picture_raster_cost.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "lib/tonic/dart_args.h"
@@ -50,8 +52,17 @@ SkCanvas* PictureRecorder::BeginRecording(SkRect bounds) {
 ftl::RefPtr<Picture> PictureRecorder::endRecording() {
   if (!isRecording())
     return nullptr;
+  sk_sp<SkPicture> sk_picture = picture_recorder_.finishRecordingAsPicture();
+  // Analyze on the UI thread, while the picture is warm, so the raster cache
+  // never has to replay the picture on the GPU thread to size it up.
+  flow::PictureMetadata metadata = flow::AnalyzePicture(sk_picture.get());
+  // The framework re-records unchanged widgets byte-for-byte; adopting the
+  // canonical instance gives such content a stable uniqueID, which is what
+  // the raster cache, scene comparison, and damage tracking key on.
+  sk_picture = flow::PictureIdentityTable::Shared().Canonicalize(
+      std::move(sk_picture), metadata);
   ftl::RefPtr<Picture> picture =
-      Picture::Create(picture_recorder_.finishRecordingAsPicture());
+      Picture::Create(std::move(sk_picture), metadata);
   canvas_->Clear();
   canvas_->ClearDartWrapper();
   canvas_ = nullptr;
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/resource_context.h"
 
+#include <unordered_map>
+
 #include "lib/ftl/logging.h"
 
 namespace blink {
@@ -11,6 +13,11 @@ namespace {
 
 static GrContext* g_context = nullptr;
 
+// Texture-backed images held resident on behalf of Image.pin() callers,
+// keyed by the uniqueID of the image that was pinned. Touched only on the
+// IO thread.
+std::unordered_map<uint32_t, sk_sp<SkImage>>* g_pinned_images = nullptr;
+
 }  // namespace
 
 void ResourceContext::Set(GrContext* context) {
@@ -22,4 +29,32 @@ GrContext* ResourceContext::Get() {
   return g_context;
 }
 
+sk_sp<SkImage> ResourceContext::PinImage(sk_sp<SkImage> image) {
+  if (!image || g_context == nullptr) {
+    return nullptr;
+  }
+
+  // TODO: Supply actual destination color space once available
+  sk_sp<SkImage> texture_image = image->makeTextureImage(g_context, nullptr);
+  if (!texture_image) {
+    return nullptr;
+  }
+  // Submit the upload so the GPU thread's share-group context sees the
+  // texture contents before the pinned image is first drawn.
+  g_context->flush();
+
+  if (g_pinned_images == nullptr) {
+    g_pinned_images = new std::unordered_map<uint32_t, sk_sp<SkImage>>();
+  }
+  (*g_pinned_images)[image->uniqueID()] = texture_image;
+  return texture_image;
+}
+
+void ResourceContext::UnpinImage(uint32_t unique_id) {
+  if (g_pinned_images == nullptr) {
+    return;
+  }
+  g_pinned_images->erase(unique_id);
+}
+
 }  // namespace blink
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_RESOURCE_CONTEXT_H_
 #define FLUTTER_LIB_UI_PAINTING_RESOURCE_CONTEXT_H_
 
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 
 namespace blink {
@@ -13,6 +14,17 @@ class ResourceContext {
  public:
   static void Set(GrContext* context);
   static GrContext* Get();
+
+  // Uploads |image| to the GPU through the resource context and registers
+  // the texture-backed result under |image|'s uniqueID so it stays resident
+  // until UnpinImage is called with that id. Returns the texture-backed
+  // image, or null if there is no GPU context to upload through. Must be
+  // called on the IO thread, where the resource context is current.
+  static sk_sp<SkImage> PinImage(sk_sp<SkImage> image);
+
+  // Releases the registration made by PinImage. The texture lives on for as
+  // long as other references to it remain. Must be called on the IO thread.
+  static void UnpinImage(uint32_t unique_id);
 };
 
 }  // namespace blink
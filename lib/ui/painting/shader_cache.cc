@@ -0,0 +1,89 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/shader_cache.h"
+
+#include "flutter/lib/ui/painting/utils.h"
+
+namespace blink {
+
+namespace {
+
+// Enough for every distinct gradient a typical theme produces, small enough
+// that the key vectors and shader handles are a negligible share of UI
+// isolate memory.
+const size_t kMaxEntries = 128;
+
+}  // namespace
+
+void AppendShaderKeyBytes(std::vector<uint8_t>* key,
+                          const void* data,
+                          size_t length) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  key->insert(key->end(), bytes, bytes + length);
+}
+
+ShaderCache& ShaderCache::GetInstance() {
+  static ShaderCache* cache = new ShaderCache();
+  return *cache;
+}
+
+ShaderCache::ShaderCache() {}
+
+ShaderCache::~ShaderCache() {}
+
+size_t ShaderCache::KeyHash::operator()(
+    const std::vector<uint8_t>& key) const {
+  // FNV-1a.
+  size_t hash = 0xcbf29ce484222325ull;
+  for (uint8_t byte : key) {
+    hash ^= byte;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+sk_sp<SkShader> ShaderCache::GetOrCreate(
+    std::vector<uint8_t> key,
+    const std::function<sk_sp<SkShader>()>& factory) {
+  auto found = cache_.find(key);
+  if (found != cache_.end()) {
+    Entry& entry = found->second;
+    if (entry.lru_position != lru_.begin()) {
+      lru_.splice(lru_.begin(), lru_, entry.lru_position);
+    }
+    return entry.shader;
+  }
+
+  sk_sp<SkShader> shader = factory();
+  if (!shader) {
+    return shader;
+  }
+
+  Entry entry;
+  entry.shader = shader;
+  entry.lru_position = lru_.insert(lru_.begin(), key);
+  cache_.emplace(std::move(key), std::move(entry));
+
+  while (cache_.size() > kMaxEntries) {
+    auto evicted = cache_.find(lru_.back());
+    // Skia objects must be deleted on the IO thread so that any associated
+    // GL objects will be cleaned up through the IO thread's GL context.
+    SkiaUnrefOnIOThread(&evicted->second.shader);
+    cache_.erase(evicted);
+    lru_.pop_back();
+  }
+
+  return shader;
+}
+
+void ShaderCache::Clear() {
+  for (auto& it : cache_) {
+    SkiaUnrefOnIOThread(&it.second.shader);
+  }
+  cache_.clear();
+  lru_.clear();
+}
+
+}  // namespace blink
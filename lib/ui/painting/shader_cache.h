@@ -0,0 +1,83 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_SHADER_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_SHADER_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkShader.h"
+
+namespace blink {
+
+// Distinguishes the key spaces of the different shader factories so keys
+// built from different parameter lists can never collide.
+enum class ShaderKeyTag : uint8_t {
+  kLinearGradient = 1,
+  kRadialGradient = 2,
+  kImageShader = 3,
+};
+
+// Appends raw parameter bytes to a shader cache key. Callers must append a
+// length or count before any variable-length run so keys stay unambiguous.
+void AppendShaderKeyBytes(std::vector<uint8_t>* key,
+                          const void* data,
+                          size_t length);
+
+template <typename T>
+void AppendShaderKeyValue(std::vector<uint8_t>* key, const T& value) {
+  AppendShaderKeyBytes(key, &value, sizeof(value));
+}
+
+// Interns immutable SkShaders by their construction parameters so that
+// rebuilding an identical gradient or image shader every frame hands Skia
+// the same shader instance instead of a fresh one. Stable shader pointers
+// keep Skia's GPU program cache from churning.
+//
+// Used only on the UI thread, like the bindings that populate it, so it
+// needs no locking. Bounded by entry count with least-recently-used
+// eviction; evicted shaders stay alive for as long as paints reference
+// them.
+class ShaderCache {
+ public:
+  static ShaderCache& GetInstance();
+
+  // Returns the cached shader for |key|, or inserts and returns the shader
+  // produced by |factory|. A null factory result is not cached.
+  sk_sp<SkShader> GetOrCreate(std::vector<uint8_t> key,
+                              const std::function<sk_sp<SkShader>()>& factory);
+
+  void Clear();
+
+  size_t size() const { return cache_.size(); }
+
+ private:
+  ShaderCache();
+  ~ShaderCache();
+
+  struct KeyHash {
+    size_t operator()(const std::vector<uint8_t>& key) const;
+  };
+
+  struct Entry {
+    sk_sp<SkShader> shader;
+    // Position of this entry within |lru_|. Most recently used entries are
+    // at the front of the list.
+    std::list<std::vector<uint8_t>>::iterator lru_position;
+  };
+
+  std::unordered_map<std::vector<uint8_t>, Entry, KeyHash> cache_;
+  // Access-ordered list of keys; the back holds the eviction candidate.
+  std::list<std::vector<uint8_t>> lru_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ShaderCache);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_PAINTING_SHADER_CACHE_H_
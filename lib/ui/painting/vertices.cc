@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/vertices.h"
 
+#include <string.h>
+
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/dart_library_natives.h"
 
@@ -11,11 +13,14 @@ namespace blink {
 
 namespace {
 
-void DecodePoints(const tonic::Float32List& coords,
-                  SkPoint* points) {
-  for (int i = 0; i < coords.num_elements(); i += 2)
-    points[i / 2] = SkPoint::Make(coords[i], coords[i + 1]);
-}
+// Positions and texture coordinates arrive in exactly the SkPoint layout,
+// and Dart colors are 32-bit values like SkColor, so those arrays are
+// adopted with a bulk copy. Only indices need converting (int32 to the
+// uint16 SkVertices stores).
+static_assert(sizeof(SkPoint) == sizeof(float) * 2,
+              "SkPoint doesn't use floats.");
+static_assert(sizeof(SkColor) == sizeof(int32_t),
+              "SkColor doesn't use int32_t.");
 
 template <typename T> void DecodeInts(const tonic::Int32List& ints,
                                       T* out) {
@@ -64,15 +69,24 @@ void Vertices::init(SkVertices::VertexMode vertex_mode,
                               positions.num_elements() / 2,
                               indices.num_elements(),
                               builderFlags);
-  if (positions.data())
-    DecodePoints(positions, builder.positions());
-  if (texture_coordinates.data())
-    DecodePoints(texture_coordinates, builder.texCoords());
-  if (colors.data())
-    DecodeInts<SkColor>(colors, builder.colors());
+  if (positions.data()) {
+    memcpy(builder.positions(), positions.data(),
+           positions.num_elements() * sizeof(float));
+  }
+  if (texture_coordinates.data()) {
+    memcpy(builder.texCoords(), texture_coordinates.data(),
+           texture_coordinates.num_elements() * sizeof(float));
+  }
+  if (colors.data()) {
+    memcpy(builder.colors(), colors.data(),
+           colors.num_elements() * sizeof(int32_t));
+  }
   if (indices.data())
     DecodeInts<uint16_t>(indices, builder.indices());
 
+  // SkVertices owns its storage: the GPU thread may still be reading the
+  // previous frame's data while the next frame records, so the Dart-owned
+  // typed data cannot be adopted in place.
   vertices_ = builder.detach();
 }
 
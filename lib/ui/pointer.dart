@@ -73,7 +73,8 @@ class PointerData {
     this.radiusMin: 0.0,
     this.radiusMax: 0.0,
     this.orientation: 0.0,
-    this.tilt: 0.0
+    this.tilt: 0.0,
+    this.history: const <PointerDataHistorySample>[]
   });
 
   /// Time of event dispatch, relative to an arbitrary timeline.
@@ -187,6 +188,16 @@ class PointerData {
   /// the stylus is flat on that surface).
   final double tilt;
 
+  /// Earlier reports of this pointer that were coalesced into this one,
+  /// oldest first.
+  ///
+  /// When successive move or hover reports of a pointer are merged so that
+  /// only one event is dispatched per frame, the positions that were
+  /// skipped over are preserved here (like the historical samples of an
+  /// Android MotionEvent) so that velocity tracking and gesture recognition
+  /// still see every platform sample. Empty for discrete changes.
+  final List<PointerDataHistorySample> history;
+
   @override
   String toString() => '$runtimeType(x: $physicalX, y: $physicalY)';
 
@@ -215,6 +226,35 @@ class PointerData {
   }
 }
 
+/// An earlier report of a pointer position that was coalesced into a
+/// single [PointerData] report.
+class PointerDataHistorySample {
+  /// Creates an object that represents a coalesced pointer report.
+  const PointerDataHistorySample({
+    this.timeStamp: Duration.ZERO,
+    this.physicalX: 0.0,
+    this.physicalY: 0.0,
+    this.pressure: 0.0
+  });
+
+  /// Time of the original report, relative to an arbitrary timeline.
+  final Duration timeStamp;
+
+  /// X coordinate of the position of the pointer, in physical pixels in the
+  /// global coordinate space.
+  final double physicalX;
+
+  /// Y coordinate of the position of the pointer, in physical pixels in the
+  /// global coordinate space.
+  final double physicalY;
+
+  /// The pressure of the touch at the time of the original report.
+  final double pressure;
+
+  @override
+  String toString() => '$runtimeType(x: $physicalX, y: $physicalY)';
+}
+
 /// A sequence of reports about the state of pointers.
 class PointerDataPacket {
   /// Creates a packet of pointer data reports.
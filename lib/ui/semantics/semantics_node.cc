@@ -20,4 +20,10 @@ bool SemanticsNode::HasFlag(SemanticsFlags flag) {
   return (flags & static_cast<int32_t>(flag)) != 0;
 }
 
+bool SemanticsNode::operator==(const SemanticsNode& other) const {
+  return id == other.id && flags == other.flags && actions == other.actions &&
+         label == other.label && rect == other.rect &&
+         transform == other.transform && children == other.children;
+}
+
 }  // namespace blink
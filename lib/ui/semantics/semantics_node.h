@@ -40,6 +40,9 @@ struct SemanticsNode {
   bool HasAction(SemanticsAction action);
   bool HasFlag(SemanticsFlags flag);
 
+  bool operator==(const SemanticsNode& other) const;
+  bool operator!=(const SemanticsNode& other) const { return !(*this == other); }
+
   int32_t id = 0;
   int32_t flags = 0;
   int32_t actions = 0;
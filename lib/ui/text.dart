@@ -747,6 +747,15 @@ abstract class Paragraph extends NativeFieldWrapperClass2 {
   void layout(ParagraphConstraints constraints) => _layout(constraints.width);
   void _layout(double width) native "Paragraph_layout";
 
+  /// Computes the size and position of each glyph in the paragraph, like
+  /// [layout], but without blocking the caller: returns immediately and
+  /// invokes [callback] once the metrics are available. The paragraph must
+  /// not be painted or queried until the callback has run.
+  void layoutAsync(ParagraphConstraints constraints, VoidCallback callback) =>
+      _layoutAsync(constraints.width, callback);
+  void _layoutAsync(double width, VoidCallback callback)
+      native "Paragraph_layoutAsync";
+
   /// Returns a list of text boxes that enclose the given text range.
   List<TextBox> getBoxesForRange(int start, int end) native "Paragraph_getRectsForRange";
 
@@ -780,7 +789,7 @@ abstract class Paragraph extends NativeFieldWrapperClass2 {
 /// text to the object.
 ///
 /// Finally, call [build] to obtain the constructed [Paragraph] object. After
-/// this point, the builder is no longer usable.
+/// this point, the builder is no longer usable until [reset] is called.
 ///
 /// After constructing a [Paragraph], call [Paragraph.layout] on it and then
 /// paint it with [Canvas.drawParagraph].
@@ -813,6 +822,15 @@ class ParagraphBuilder extends NativeFieldWrapperClass2 {
   /// added text and associated styling.
   ///
   /// After calling this function, the paragraph builder object is invalid and
-  /// cannot be used further.
+  /// cannot be used further until [reset] is called.
   Paragraph build() native "ParagraphBuilder_build";
+
+  /// Makes the builder usable again, ready to build a new paragraph with the
+  /// given style.
+  ///
+  /// Any text and styles added so far are discarded. Callers that build many
+  /// paragraphs — for example a scrolling list — can reset and reuse a single
+  /// builder instead of allocating a new one per paragraph.
+  void reset(ParagraphStyle style) => _reset(style._encoded, style._fontFamily, style._fontSize, style._lineHeight, style._ellipsis);
+  void _reset(Int32List encoded, String fontFamily, double fontSize, double lineHeight, String ellipsis) native "ParagraphBuilder_reset";
 }
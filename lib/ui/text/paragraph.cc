@@ -12,11 +12,15 @@
 #include "flutter/sky/engine/platform/fonts/FontCache.h"
 #include "flutter/sky/engine/platform/graphics/GraphicsContext.h"
 #include "flutter/sky/engine/platform/text/TextBoundaries.h"
+#include "lib/ftl/functional/make_copyable.h"
 #include "lib/ftl/tasks/task_runner.h"
 #include "lib/tonic/converter/dart_converter.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/dart_library_natives.h"
+#include "lib/tonic/dart_persistent_value.h"
+#include "lib/tonic/logging/dart_invoke.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 using tonic::ToDart;
 
@@ -33,6 +37,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
   V(Paragraph, ideographicBaseline) \
   V(Paragraph, didExceedMaxLines) \
   V(Paragraph, layout)              \
+  V(Paragraph, layoutAsync)         \
   V(Paragraph, paint)               \
   V(Paragraph, getWordBoundary)     \
   V(Paragraph, getRectsForRange)    \
@@ -40,8 +45,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
 
 DART_BIND_ALL(Paragraph, FOR_EACH_BINDING)
 
-Paragraph::Paragraph(PassOwnPtr<RenderView> renderView)
-    : m_renderView(renderView) {}
+Paragraph::Paragraph(PassOwnPtr<RenderView> renderView, uint64_t contentHash)
+    : m_renderView(renderView), m_contentHash(contentHash) {}
 
 Paragraph::~Paragraph() {
   if (m_renderView) {
@@ -52,32 +57,46 @@ Paragraph::~Paragraph() {
 }
 
 double Paragraph::width() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.width;
   return firstChildBox()->width();
 }
 
 double Paragraph::height() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.height;
   return firstChildBox()->height();
 }
 
 double Paragraph::minIntrinsicWidth() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.minIntrinsicWidth;
   return firstChildBox()->minPreferredLogicalWidth();
 }
 
 double Paragraph::maxIntrinsicWidth() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.maxIntrinsicWidth;
   return firstChildBox()->maxPreferredLogicalWidth();
 }
 
 double Paragraph::alphabeticBaseline() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.alphabeticBaseline;
   return firstChildBox()->firstLineBoxBaseline(
       FontBaselineOrAuto(AlphabeticBaseline));
 }
 
 double Paragraph::ideographicBaseline() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.ideographicBaseline;
   return firstChildBox()->firstLineBoxBaseline(
       FontBaselineOrAuto(IdeographicBaseline));
 }
 
 bool Paragraph::didExceedMaxLines() {
+  if (m_hasCachedMetrics)
+    return m_cachedMetrics.didExceedMaxLines;
   RenderBox* box = firstChildBox();
   ASSERT(box->isRenderParagraph());
   RenderParagraph* paragraph = static_cast<RenderParagraph*>(box);
@@ -85,38 +104,121 @@ bool Paragraph::didExceedMaxLines() {
 }
 
 void Paragraph::layout(double width) {
+  if (m_hasLaidOut && width == m_lastLayoutWidth && !m_hasPendingLayout)
+    return;
+
+  if (m_contentHash != 0) {
+    CachedParagraphMetrics metrics;
+    if (ParagraphLayoutCache::Shared().lookup(m_contentHash, width,
+                                              &metrics)) {
+      // Identical content was laid out at this width before. Adopt its
+      // metrics and defer the line-breaking pass until the render tree is
+      // actually needed for painting or hit testing.
+      m_cachedMetrics = metrics;
+      m_hasCachedMetrics = true;
+      m_hasPendingLayout = true;
+      m_hasLaidOut = true;
+      m_lastLayoutWidth = width;
+      return;
+    }
+  }
+
+  performLayout(width);
+}
+
+void Paragraph::performLayout(double width) {
   FontCachePurgePreventer fontCachePurgePreventer;
 
   int maxWidth = LayoutUnit(width);  // Handles infinity properly.
   m_renderView->setFrameViewSize(IntSize(maxWidth, intMaxForLayoutUnit));
   m_renderView->layout();
+
+  m_hasLaidOut = true;
+  m_hasPendingLayout = false;
+  m_hasCachedMetrics = false;
+  m_hasCachedPosition = false;
+  m_lastLayoutWidth = width;
+  m_paintRecord = nullptr;
+
+  if (m_contentHash != 0) {
+    ParagraphLayoutCache::Shared().insert(
+        m_contentHash, width,
+        {this->width(), height(), minIntrinsicWidth(), maxIntrinsicWidth(),
+         alphabeticBaseline(), ideographicBaseline(), didExceedMaxLines()});
+  }
+}
+
+void Paragraph::ensureLayout() {
+  if (!m_hasPendingLayout)
+    return;
+  performLayout(m_lastLayoutWidth);
+}
+
+void Paragraph::layoutAsync(double width, Dart_Handle callback) {
+  if (!Dart_IsClosure(callback)) {
+    Dart_ThrowException(ToDart("Callback must be a function"));
+    return;
+  }
+
+  // The render tree, the font cache, and the string tables underneath them
+  // are all single-threaded, so the layout itself cannot leave this thread.
+  // Running it as its own task still decouples it from whatever frame is
+  // being built right now, and layout cache hits make it trivial for
+  // repeated content.
+  Threads::UI()->PostTask(ftl::MakeCopyable([
+    self = ftl::RefPtr<Paragraph>(this), width,
+    callback = std::make_unique<tonic::DartPersistentValue>(
+        tonic::DartState::Current(), callback)
+  ]() mutable {
+    self->layout(width);
+
+    tonic::DartState* dart_state = callback->dart_state().get();
+    if (!dart_state)
+      return;
+    tonic::DartState::Scope scope(dart_state);
+    tonic::DartInvoke(callback->value(), {});
+  }));
 }
 
 void Paragraph::paint(Canvas* canvas, double x, double y) {
+  ensureLayout();
+
   SkCanvas* skCanvas = canvas->canvas();
   if (!skCanvas)
     return;
 
-  FontCachePurgePreventer fontCachePurgePreventer;
+  if (!m_paintRecord) {
+    // Record the paint commands once per layout. Subsequent paints of the
+    // same layout — including at a different offset — replay the recording
+    // instead of walking the render tree again.
+    FontCachePurgePreventer fontCachePurgePreventer;
+
+    // Very simplified painting to allow painting an arbitrary (layer-less)
+    // subtree.
+    RenderBox* box = firstChildBox();
+    LayoutRect bounds = box->absoluteBoundingBoxRect();
+    FTL_DCHECK(bounds.x() == 0 && bounds.y() == 0);
+    IntRect paintBounds = enclosingIntRect(bounds);
+
+    SkPictureRecorder recorder;
+    GraphicsContext context(recorder.beginRecording(paintBounds));
+    Vector<RenderBox*> layers;
+    PaintInfo paintInfo(&context, paintBounds, box);
+    box->paint(paintInfo, LayoutPoint(), layers);
+    // Note we're ignoring any layers encountered.
+    // TODO(abarth): Remove the concept of RenderLayers.
+    m_paintRecord = recorder.finishRecordingAsPicture();
+  }
 
-  // Very simplified painting to allow painting an arbitrary (layer-less)
-  // subtree.
-  RenderBox* box = firstChildBox();
+  skCanvas->save();
   skCanvas->translate(x, y);
-
-  GraphicsContext context(skCanvas);
-  Vector<RenderBox*> layers;
-  LayoutRect bounds = box->absoluteBoundingBoxRect();
-  FTL_DCHECK(bounds.x() == 0 && bounds.y() == 0);
-  PaintInfo paintInfo(&context, enclosingIntRect(bounds), box);
-  box->paint(paintInfo, LayoutPoint(), layers);
-  // Note we're ignoring any layers encountered.
-  // TODO(abarth): Remove the concept of RenderLayers.
-
-  skCanvas->translate(-x, -y);
+  skCanvas->drawPicture(m_paintRecord.get());
+  skCanvas->restore();
 }
 
 std::vector<TextBox> Paragraph::getRectsForRange(unsigned start, unsigned end) {
+  ensureLayout();
+
   if (end <= start || start == end)
     return std::vector<TextBox>();
 
@@ -158,11 +260,23 @@ int Paragraph::absoluteOffsetForPosition(const PositionWithAffinity& position) {
 }
 
 Dart_Handle Paragraph::getPositionForOffset(double dx, double dy) {
+  ensureLayout();
+
+  // Selection drags re-query the same point whenever the pointer pauses,
+  // and each query walks the render tree twice (positionForPoint plus the
+  // pre-order offset scan). Repeats of the last point are answered from the
+  // cached answer; layout invalidates it.
   LayoutPoint point(dx, dy);
-  PositionWithAffinity position = m_renderView->positionForPoint(point);
+  if (!m_hasCachedPosition || point != m_cachedPositionPoint) {
+    PositionWithAffinity position = m_renderView->positionForPoint(point);
+    m_hasCachedPosition = true;
+    m_cachedPositionPoint = point;
+    m_cachedPositionOffset = absoluteOffsetForPosition(position);
+    m_cachedPositionAffinity = static_cast<int>(position.affinity());
+  }
   Dart_Handle result = Dart_NewList(2);
-  Dart_ListSetAt(result, 0, ToDart(absoluteOffsetForPosition(position)));
-  Dart_ListSetAt(result, 1, ToDart(static_cast<int>(position.affinity())));
+  Dart_ListSetAt(result, 0, ToDart(m_cachedPositionOffset));
+  Dart_ListSetAt(result, 1, ToDart(m_cachedPositionAffinity));
   return result;
 }
 
@@ -6,9 +6,11 @@
 #define FLUTTER_LIB_UI_TEXT_PARAGRAPH_H_
 
 #include "flutter/lib/ui/painting/canvas.h"
+#include "flutter/lib/ui/text/paragraph_layout_cache.h"
 #include "flutter/lib/ui/text/text_box.h"
 #include "flutter/sky/engine/core/rendering/RenderView.h"
 #include "lib/tonic/dart_wrappable.h"
+#include "third_party/skia/include/core/SkPicture.h"
 
 namespace tonic {
 class DartLibraryNatives;
@@ -22,8 +24,11 @@ class Paragraph : public ftl::RefCountedThreadSafe<Paragraph>,
   FRIEND_MAKE_REF_COUNTED(Paragraph);
 
  public:
-  static ftl::RefPtr<Paragraph> create(PassOwnPtr<RenderView> renderView) {
-    return ftl::MakeRefCounted<Paragraph>(renderView);
+  // |contentHash| identifies the text and styles this paragraph was built
+  // from, for the layout cache. Zero means the paragraph is not cacheable.
+  static ftl::RefPtr<Paragraph> create(PassOwnPtr<RenderView> renderView,
+                                       uint64_t contentHash = 0) {
+    return ftl::MakeRefCounted<Paragraph>(renderView, contentHash);
   }
 
   ~Paragraph() override;
@@ -37,6 +42,7 @@ class Paragraph : public ftl::RefCountedThreadSafe<Paragraph>,
   bool didExceedMaxLines();
 
   void layout(double width);
+  void layoutAsync(double width, Dart_Handle callback);
   void paint(Canvas* canvas, double x, double y);
 
   std::vector<TextBox> getRectsForRange(unsigned start, unsigned end);
@@ -52,9 +58,37 @@ class Paragraph : public ftl::RefCountedThreadSafe<Paragraph>,
 
   int absoluteOffsetForPosition(const PositionWithAffinity& position);
 
-  explicit Paragraph(PassOwnPtr<RenderView> renderView);
+  explicit Paragraph(PassOwnPtr<RenderView> renderView,
+                     uint64_t contentHash = 0);
+
+  // Run the real layout pass at |width|.
+  void performLayout(double width);
+
+  // Flush a layout deferred by a cache hit before the render tree is used
+  // for painting or hit testing.
+  void ensureLayout();
 
   OwnPtr<RenderView> m_renderView;
+  uint64_t m_contentHash;
+  double m_lastLayoutWidth = 0;
+  bool m_hasLaidOut = false;
+  // When true, layout() satisfied its caller from the cache and the render
+  // tree has not been laid out at m_lastLayoutWidth yet.
+  bool m_hasPendingLayout = false;
+  bool m_hasCachedMetrics = false;
+  CachedParagraphMetrics m_cachedMetrics;
+
+  // Last getPositionForOffset() query and its answer, invalidated by
+  // layout. Selection drags re-query the same point whenever the pointer
+  // pauses, and each miss walks the render tree twice.
+  bool m_hasCachedPosition = false;
+  LayoutPoint m_cachedPositionPoint;
+  int m_cachedPositionOffset = 0;
+  int m_cachedPositionAffinity = 0;
+  // Recording of the render tree's paint commands, made on the first paint
+  // after a layout and replayed on every subsequent paint. Reset whenever the
+  // tree is laid out again, since that is the only way its output changes.
+  sk_sp<SkPicture> m_paintRecord;
 };
 
 }  // namespace blink
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/text/paragraph_builder.h"
 
 #include "flutter/common/threads.h"
+#include "flutter/lib/ui/text/text_style_interner.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/sky/engine/core/rendering/RenderInline.h"
 #include "flutter/sky/engine/core/rendering/RenderParagraph.h"
@@ -68,6 +69,11 @@ const int psFontSizeMask = 1 << psFontSizeIndex;
 const int psLineHeightMask = 1 << psLineHeightIndex;
 const int psEllipsisMask = 1 << psEllipsisIndex;
 
+Color getColorFromARGB(int argb) {
+  return Color((argb & 0x00FF0000) >> 16, (argb & 0x0000FF00) >> 8,
+               (argb & 0x000000FF) >> 0, (argb & 0xFF000000) >> 24);
+}
+
 float getComputedSizeFromSpecifiedSize(float specifiedSize) {
   if (specifiedSize < std::numeric_limits<float>::epsilon())
     return 0.0f;
@@ -154,9 +160,121 @@ PassRefPtr<RenderStyle> decodeParagraphStyle(
   return style.release();
 }
 
-Color getColorFromARGB(int argb) {
-  return Color((argb & 0x00FF0000) >> 16, (argb & 0x0000FF00) >> 8,
-               (argb & 0x000000FF) >> 0, (argb & 0xFF000000) >> 24);
+PassRefPtr<RenderStyle> decodeTextStyle(RenderStyle* parentStyle,
+                                        tonic::Int32List& encoded,
+                                        const std::string& fontFamily,
+                                        double fontSize,
+                                        double letterSpacing,
+                                        double wordSpacing,
+                                        double height) {
+  RefPtr<RenderStyle> style = RenderStyle::create();
+  style->inheritFrom(parentStyle);
+
+  int32_t mask = encoded[0];
+
+  if (mask & tsColorMask)
+    style->setColor(getColorFromARGB(encoded[tsColorIndex]));
+
+  if (mask & tsTextDecorationMask) {
+    style->setTextDecoration(
+        static_cast<TextDecoration>(encoded[tsTextDecorationIndex]));
+    style->applyTextDecorations();
+  }
+
+  if (mask & tsTextDecorationColorMask)
+    style->setTextDecorationColor(
+        StyleColor(getColorFromARGB(encoded[tsTextDecorationColorIndex])));
+
+  if (mask & tsTextDecorationStyleMask)
+    style->setTextDecorationStyle(
+        static_cast<TextDecorationStyle>(encoded[tsTextDecorationStyleIndex]));
+
+  if (mask & tsTextBaselineMask) {
+    // TODO(abarth): Implement TextBaseline. The CSS version of this
+    // property wasn't wired up either.
+  }
+
+  if (mask & (tsFontWeightMask | tsFontStyleMask | tsFontFamilyMask |
+              tsFontSizeMask | tsLetterSpacingMask | tsWordSpacingMask)) {
+    FontDescription fontDescription = style->fontDescription();
+
+    if (mask & tsFontWeightMask)
+      fontDescription.setWeight(
+          static_cast<FontWeight>(encoded[tsFontWeightIndex]));
+
+    if (mask & tsFontStyleMask)
+      fontDescription.setStyle(
+          static_cast<FontStyle>(encoded[tsFontStyleIndex]));
+
+    if (mask & tsFontFamilyMask) {
+      FontFamily family;
+      family.setFamily(String::fromUTF8(fontFamily));
+      fontDescription.setFamily(family);
+    }
+
+    if (mask & tsFontSizeMask) {
+      fontDescription.setSpecifiedSize(fontSize);
+      fontDescription.setIsAbsoluteSize(true);
+      fontDescription.setComputedSize(
+          getComputedSizeFromSpecifiedSize(fontSize));
+    }
+
+    if (mask & tsLetterSpacingMask)
+      fontDescription.setLetterSpacing(letterSpacing);
+
+    if (mask & tsWordSpacingMask)
+      fontDescription.setWordSpacing(wordSpacing);
+
+    style->setFontDescription(fontDescription);
+    style->font().update(UIDartState::Current()->font_selector());
+  }
+
+  if (mask & tsHeightMask) {
+    style->setLineHeight(Length(height * 100.0, Percent));
+  }
+
+  return style.release();
+}
+
+// FNV-1a, folded over everything that influences the paragraph's layout so
+// identical content hashes identically across builders.
+const uint64_t kContentHashOffsetBasis = 0xcbf29ce484222325ull;
+const uint64_t kContentHashPrime = 0x100000001b3ull;
+
+uint64_t hashBytes(uint64_t hash, const void* bytes, size_t size) {
+  const uint8_t* data = static_cast<const uint8_t*>(bytes);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * kContentHashPrime;
+  }
+  return hash;
+}
+
+uint64_t hashDouble(uint64_t hash, double value) {
+  return hashBytes(hash, &value, sizeof(value));
+}
+
+uint64_t hashInt32List(uint64_t hash, const tonic::Int32List& encoded) {
+  for (intptr_t i = 0; i < encoded.num_elements(); i++) {
+    int32_t value = encoded[i];
+    hash = hashBytes(hash, &value, sizeof(value));
+  }
+  return hash;
+}
+
+uint64_t hashString(uint64_t hash, const std::string& value) {
+  // Include the length so adjacent strings cannot alias each other.
+  size_t size = value.size();
+  hash = hashBytes(hash, &size, sizeof(size));
+  return hashBytes(hash, value.data(), value.size());
+}
+
+// Seed of the style interning key chain. Folding in the isolate's font
+// selector keeps styles computed against different font registries from
+// aliasing in the shared interner.
+uint64_t styleKeySeed() {
+  RefPtr<FontSelector> selector = UIDartState::Current()->font_selector();
+  FontSelector* raw = selector.get();
+  return hashBytes(kContentHashOffsetBasis, &raw, sizeof(raw));
 }
 
 }  // namespace
@@ -171,7 +289,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, ParagraphBuilder);
   V(ParagraphBuilder, pushStyle) \
   V(ParagraphBuilder, pop)       \
   V(ParagraphBuilder, addText)   \
-  V(ParagraphBuilder, build)
+  V(ParagraphBuilder, build)     \
+  V(ParagraphBuilder, reset)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
@@ -196,10 +315,38 @@ ParagraphBuilder::ParagraphBuilder(tonic::Int32List& encoded,
                                    double fontSize,
                                    double lineHeight,
                                    const std::string& ellipsis) {
+  initialize(encoded, fontFamily, fontSize, lineHeight, ellipsis);
+}
+
+void ParagraphBuilder::initialize(tonic::Int32List& encoded,
+                                  const std::string& fontFamily,
+                                  double fontSize,
+                                  double lineHeight,
+                                  const std::string& ellipsis) {
   createRenderView();
 
-  RefPtr<RenderStyle> paragraphStyle = decodeParagraphStyle(
-      m_renderView->style(), encoded, fontFamily, fontSize, lineHeight, ellipsis);
+  m_contentHash = kContentHashOffsetBasis;
+  m_contentHash = hashInt32List(m_contentHash, encoded);
+  m_contentHash = hashString(m_contentHash, fontFamily);
+  m_contentHash = hashDouble(m_contentHash, fontSize);
+  m_contentHash = hashDouble(m_contentHash, lineHeight);
+  m_contentHash = hashString(m_contentHash, ellipsis);
+
+  uint64_t paragraphKey = hashBytes(m_styleKeyStack.back(), "paragraph", 9);
+  paragraphKey = hashInt32List(paragraphKey, encoded);
+  paragraphKey = hashString(paragraphKey, fontFamily);
+  paragraphKey = hashDouble(paragraphKey, fontSize);
+  paragraphKey = hashDouble(paragraphKey, lineHeight);
+  paragraphKey = hashString(paragraphKey, ellipsis);
+
+  RefPtr<RenderStyle> paragraphStyle =
+      TextStyleInterner::Shared().lookup(paragraphKey);
+  if (!paragraphStyle) {
+    paragraphStyle = decodeParagraphStyle(m_renderView->style(), encoded,
+                                          fontFamily, fontSize, lineHeight,
+                                          ellipsis);
+    TextStyleInterner::Shared().insert(paragraphKey, paragraphStyle);
+  }
   encoded.Release();
 
   m_renderParagraph = new RenderParagraph();
@@ -207,6 +354,7 @@ ParagraphBuilder::ParagraphBuilder(tonic::Int32List& encoded,
 
   m_currentRenderObject = m_renderParagraph;
   m_renderView->addChild(m_currentRenderObject);
+  m_styleKeyStack.push_back(paragraphKey);
 }
 
 ParagraphBuilder::~ParagraphBuilder() {
@@ -224,109 +372,107 @@ void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
                                  double wordSpacing,
                                  double height) {
   FTL_DCHECK(encoded.num_elements() == 8);
-  RefPtr<RenderStyle> style = RenderStyle::create();
-  style->inheritFrom(m_currentRenderObject->style());
-
-  int32_t mask = encoded[0];
-
-  if (mask & tsColorMask)
-    style->setColor(getColorFromARGB(encoded[tsColorIndex]));
-
-  if (mask & tsTextDecorationMask) {
-    style->setTextDecoration(
-        static_cast<TextDecoration>(encoded[tsTextDecorationIndex]));
-    style->applyTextDecorations();
-  }
-
-  if (mask & tsTextDecorationColorMask)
-    style->setTextDecorationColor(
-        StyleColor(getColorFromARGB(encoded[tsTextDecorationColorIndex])));
 
-  if (mask & tsTextDecorationStyleMask)
-    style->setTextDecorationStyle(
-        static_cast<TextDecorationStyle>(encoded[tsTextDecorationStyleIndex]));
-
-  if (mask & tsTextBaselineMask) {
-    // TODO(abarth): Implement TextBaseline. The CSS version of this
-    // property wasn't wired up either.
+  m_contentHash = hashBytes(m_contentHash, "push", 4);
+  m_contentHash = hashInt32List(m_contentHash, encoded);
+  m_contentHash = hashString(m_contentHash, fontFamily);
+  m_contentHash = hashDouble(m_contentHash, fontSize);
+  m_contentHash = hashDouble(m_contentHash, letterSpacing);
+  m_contentHash = hashDouble(m_contentHash, wordSpacing);
+  m_contentHash = hashDouble(m_contentHash, height);
+
+  uint64_t spanKey = hashBytes(m_styleKeyStack.back(), "push", 4);
+  spanKey = hashInt32List(spanKey, encoded);
+  spanKey = hashString(spanKey, fontFamily);
+  spanKey = hashDouble(spanKey, fontSize);
+  spanKey = hashDouble(spanKey, letterSpacing);
+  spanKey = hashDouble(spanKey, wordSpacing);
+  spanKey = hashDouble(spanKey, height);
+
+  RefPtr<RenderStyle> style = TextStyleInterner::Shared().lookup(spanKey);
+  if (!style) {
+    style = decodeTextStyle(m_currentRenderObject->style(), encoded,
+                            fontFamily, fontSize, letterSpacing, wordSpacing,
+                            height);
+    TextStyleInterner::Shared().insert(spanKey, style);
   }
-
-  if (mask & (tsFontWeightMask | tsFontStyleMask | tsFontFamilyMask |
-              tsFontSizeMask | tsLetterSpacingMask | tsWordSpacingMask)) {
-    FontDescription fontDescription = style->fontDescription();
-
-    if (mask & tsFontWeightMask)
-      fontDescription.setWeight(
-          static_cast<FontWeight>(encoded[tsFontWeightIndex]));
-
-    if (mask & tsFontStyleMask)
-      fontDescription.setStyle(
-          static_cast<FontStyle>(encoded[tsFontStyleIndex]));
-
-    if (mask & tsFontFamilyMask) {
-      FontFamily family;
-      family.setFamily(String::fromUTF8(fontFamily));
-      fontDescription.setFamily(family);
-    }
-
-    if (mask & tsFontSizeMask) {
-      fontDescription.setSpecifiedSize(fontSize);
-      fontDescription.setIsAbsoluteSize(true);
-      fontDescription.setComputedSize(
-          getComputedSizeFromSpecifiedSize(fontSize));
-    }
-
-    if (mask & tsLetterSpacingMask)
-      fontDescription.setLetterSpacing(letterSpacing);
-
-    if (mask & tsWordSpacingMask)
-      fontDescription.setWordSpacing(wordSpacing);
-
-    style->setFontDescription(fontDescription);
-    style->font().update(UIDartState::Current()->font_selector());
-  }
-
-  if (mask & tsHeightMask) {
-    style->setLineHeight(Length(height * 100.0, Percent));
-  }
-
   encoded.Release();
 
   RenderObject* span = new RenderInline();
   span->setStyle(style.release());
   m_currentRenderObject->addChild(span);
   m_currentRenderObject = span;
+  m_styleKeyStack.push_back(spanKey);
 }
 
 void ParagraphBuilder::pop() {
-  if (m_currentRenderObject)
+  m_contentHash = hashBytes(m_contentHash, "pop", 3);
+  if (m_currentRenderObject) {
     m_currentRenderObject = m_currentRenderObject->parent();
+    if (m_styleKeyStack.size() > 1)
+      m_styleKeyStack.pop_back();
+  }
 }
 
 void ParagraphBuilder::addText(const std::string& text) {
   if (!m_currentRenderObject)
     return;
+  m_contentHash = hashString(m_contentHash, text);
   RenderText* renderText = new RenderText(String::fromUTF8(text).impl());
-  RefPtr<RenderStyle> style = RenderStyle::create();
-  style->inheritFrom(m_currentRenderObject->style());
+
+  // A text node's style is a pure inherit of its parent's, so its key is
+  // the parent's key plus a marker.
+  const uint64_t textKey = hashBytes(m_styleKeyStack.back(), "text", 4);
+  RefPtr<RenderStyle> style = TextStyleInterner::Shared().lookup(textKey);
+  if (!style) {
+    style = RenderStyle::create();
+    style->inheritFrom(m_currentRenderObject->style());
+    TextStyleInterner::Shared().insert(textKey, style);
+  }
+
   renderText->setStyle(style.release());
   m_currentRenderObject->addChild(renderText);
 }
 
 ftl::RefPtr<Paragraph> ParagraphBuilder::build() {
   m_currentRenderObject = nullptr;
-  return Paragraph::create(m_renderView.release());
+  return Paragraph::create(m_renderView.release(), m_contentHash);
+}
+
+void ParagraphBuilder::reset(tonic::Int32List& encoded,
+                             const std::string& fontFamily,
+                             double fontSize,
+                             double lineHeight,
+                             const std::string& ellipsis) {
+  if (m_renderView) {
+    // Builder natives run on the UI thread, so a tree that was never built
+    // can be torn down in place instead of through the task the destructor
+    // posts.
+    m_renderView.leakPtr()->destroy();
+  }
+  initialize(encoded, fontFamily, fontSize, lineHeight, ellipsis);
 }
 
 void ParagraphBuilder::createRenderView() {
-  RefPtr<RenderStyle> style = RenderStyle::create();
-  style->setRTLOrdering(LogicalOrder);
-  style->setZIndex(0);
-  style->setUserModify(READ_ONLY);
-  createFontForDocument(style.get());
+  // Every paragraph shares one document style per font registry, so intern
+  // it like the span styles; building it runs font selection.
+  const uint64_t viewKey = hashBytes(styleKeySeed(), "view", 4);
+
+  RefPtr<RenderStyle> style = TextStyleInterner::Shared().lookup(viewKey);
+  if (!style) {
+    style = RenderStyle::create();
+    style->setRTLOrdering(LogicalOrder);
+    style->setZIndex(0);
+    style->setUserModify(READ_ONLY);
+    createFontForDocument(style.get());
+    TextStyleInterner::Shared().insert(viewKey, style);
+  }
 
   m_renderView = adoptPtr(new RenderView());
   m_renderView->setStyle(style.release());
+
+  m_styleKeyStack.clear();
+  m_styleKeyStack.push_back(viewKey);
 }
 
 }  // namespace blink
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_TEXT_PARAGRAPH_BUILDER_H_
 #define FLUTTER_LIB_UI_TEXT_PARAGRAPH_BUILDER_H_
 
+#include <vector>
+
 #include "flutter/lib/ui/text/paragraph.h"
 #include "lib/tonic/dart_wrappable.h"
 #include "lib/tonic/typed_data/int32_list.h"
@@ -41,6 +43,15 @@ class ParagraphBuilder : public ftl::RefCountedThreadSafe<ParagraphBuilder>,
 
   ftl::RefPtr<Paragraph> build();
 
+  // Makes the builder usable again for a new paragraph with the given
+  // paragraph style, so callers building many paragraphs can reuse one
+  // builder instead of allocating one per paragraph.
+  void reset(tonic::Int32List& encoded,
+             const std::string& fontFamily,
+             double fontSize,
+             double lineHeight,
+             const std::string& ellipsis);
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
@@ -50,11 +61,27 @@ class ParagraphBuilder : public ftl::RefCountedThreadSafe<ParagraphBuilder>,
                             double lineHeight,
                             const std::string& ellipsis);
 
+  // Builds the render view and paragraph for a new paragraph; shared by the
+  // constructor and reset.
+  void initialize(tonic::Int32List& encoded,
+                  const std::string& fontFamily,
+                  double fontSize,
+                  double lineHeight,
+                  const std::string& ellipsis);
+
   void createRenderView();
 
   OwnPtr<RenderView> m_renderView;
   RenderObject* m_renderParagraph;
   RenderObject* m_currentRenderObject;
+  // A running hash of everything that shapes the layout of this paragraph —
+  // the paragraph style, each pushed span style, and the text itself — used
+  // as the key of the paragraph layout cache.
+  uint64_t m_contentHash;
+  // Interning keys for the ancestor chain of m_currentRenderObject's style,
+  // innermost last; each level folds its style tuple into its parent's key.
+  // See TextStyleInterner.
+  std::vector<uint64_t> m_styleKeyStack;
 };
 
 }  // namespace blink
@@ -0,0 +1,76 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/text/paragraph_layout_cache.h"
+
+#include <cstring>
+
+namespace blink {
+namespace {
+
+// The bytes the cache may hold. Each entry costs roughly the metrics plus
+// the map and list bookkeeping around them.
+const size_t kCacheBudgetBytes = 256 * 1024;
+const size_t kApproxEntryBytes =
+    sizeof(CachedParagraphMetrics) + 2 * sizeof(void*) + 6 * sizeof(uint64_t);
+const size_t kMaxEntries = kCacheBudgetBytes / kApproxEntryBytes;
+
+}  // namespace
+
+ParagraphLayoutCache& ParagraphLayoutCache::Shared() {
+  // Deliberately leaked to match the process-lifetime font caches.
+  static auto* cache = new ParagraphLayoutCache();
+  return *cache;
+}
+
+ParagraphLayoutCache::ParagraphLayoutCache() = default;
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+uint64_t ParagraphLayoutCache::makeKey(uint64_t contentHash, double width) {
+  uint64_t width_bits = 0;
+  memcpy(&width_bits, &width, sizeof(width_bits));
+  // Mix the width into the content hash with the usual combine constant so
+  // the same content at different widths lands in distinct slots.
+  return contentHash ^
+         (width_bits + 0x9e3779b97f4a7c15ull + (contentHash << 6) +
+          (contentHash >> 2));
+}
+
+bool ParagraphLayoutCache::lookup(uint64_t contentHash,
+                                  double width,
+                                  CachedParagraphMetrics* metrics) {
+  auto found = m_entries.find(makeKey(contentHash, width));
+
+  if (found == m_entries.end()) {
+    return false;
+  }
+
+  m_lru.splice(m_lru.begin(), m_lru, found->second.lruPosition);
+  *metrics = found->second.metrics;
+  return true;
+}
+
+void ParagraphLayoutCache::insert(uint64_t contentHash,
+                                  double width,
+                                  const CachedParagraphMetrics& metrics) {
+  const uint64_t key = makeKey(contentHash, width);
+
+  auto found = m_entries.find(key);
+  if (found != m_entries.end()) {
+    found->second.metrics = metrics;
+    m_lru.splice(m_lru.begin(), m_lru, found->second.lruPosition);
+    return;
+  }
+
+  m_lru.push_front(key);
+  m_entries[key] = {metrics, m_lru.begin()};
+
+  while (m_entries.size() > kMaxEntries) {
+    m_entries.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+}  // namespace blink
@@ -0,0 +1,71 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_TEXT_PARAGRAPH_LAYOUT_CACHE_H_
+#define FLUTTER_LIB_UI_TEXT_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <unordered_map>
+
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+// The metrics a paragraph layout produces. The render tree itself cannot be
+// shared between paragraphs, so this is what a cache hit can supply; the
+// real layout is deferred until the tree is needed for painting or hit
+// testing.
+struct CachedParagraphMetrics {
+  double width = 0;
+  double height = 0;
+  double minIntrinsicWidth = 0;
+  double maxIntrinsicWidth = 0;
+  double alphabeticBaseline = 0;
+  double ideographicBaseline = 0;
+  bool didExceedMaxLines = false;
+};
+
+// An LRU of paragraph layout metrics keyed by the content hash accumulated
+// by ParagraphBuilder plus the layout width, so re-laying-out identical
+// content (a chat list rebuilding its message bubbles) costs a hash lookup
+// instead of a line-breaking pass.
+class ParagraphLayoutCache {
+ public:
+  // UI thread only, like the font caches this sits beside.
+  static ParagraphLayoutCache& Shared();
+
+  // Copy the metrics recorded for this content at this width into |metrics|
+  // and return true, or return false on a miss.
+  bool lookup(uint64_t contentHash,
+              double width,
+              CachedParagraphMetrics* metrics);
+
+  void insert(uint64_t contentHash,
+              double width,
+              const CachedParagraphMetrics& metrics);
+
+ private:
+  struct Entry {
+    CachedParagraphMetrics metrics;
+    std::list<uint64_t>::iterator lruPosition;
+  };
+
+  ParagraphLayoutCache();
+
+  ~ParagraphLayoutCache();
+
+  static uint64_t makeKey(uint64_t contentHash, double width);
+
+  // Most recently used keys at the front.
+  std::list<uint64_t> m_lru;
+  std::unordered_map<uint64_t, Entry> m_entries;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_TEXT_PARAGRAPH_LAYOUT_CACHE_H_
@@ -0,0 +1,55 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/text/text_style_interner.h"
+
+namespace blink {
+namespace {
+
+// An application rarely uses more than a few dozen distinct text styles,
+// so a count cap is enough; each entry is one RenderStyle plus the map and
+// list bookkeeping around it.
+const size_t kMaxEntries = 512;
+
+}  // namespace
+
+TextStyleInterner& TextStyleInterner::Shared() {
+  // Deliberately leaked to match the process-lifetime font caches.
+  static auto* interner = new TextStyleInterner();
+  return *interner;
+}
+
+TextStyleInterner::TextStyleInterner() = default;
+
+TextStyleInterner::~TextStyleInterner() = default;
+
+PassRefPtr<RenderStyle> TextStyleInterner::lookup(uint64_t key) {
+  auto found = m_entries.find(key);
+
+  if (found == m_entries.end()) {
+    return nullptr;
+  }
+
+  m_lru.splice(m_lru.begin(), m_lru, found->second.lruPosition);
+  return found->second.style;
+}
+
+void TextStyleInterner::insert(uint64_t key, PassRefPtr<RenderStyle> style) {
+  auto found = m_entries.find(key);
+  if (found != m_entries.end()) {
+    found->second.style = style;
+    m_lru.splice(m_lru.begin(), m_lru, found->second.lruPosition);
+    return;
+  }
+
+  m_lru.push_front(key);
+  m_entries[key] = {style, m_lru.begin()};
+
+  while (m_entries.size() > kMaxEntries) {
+    m_entries.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+}  // namespace blink
@@ -0,0 +1,59 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_TEXT_TEXT_STYLE_INTERNER_H_
+#define FLUTTER_LIB_UI_TEXT_TEXT_STYLE_INTERNER_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <unordered_map>
+
+#include "flutter/sky/engine/core/rendering/style/RenderStyle.h"
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+// An LRU of computed RenderStyles keyed by the style tuple that produced
+// them. ParagraphBuilder derives a fresh style per span by inheriting from
+// its parent and re-running font selection; a list full of identically
+// styled rows repeats that work thousands of times per second for the same
+// handful of styles. Interned styles are shared by reference and must never
+// be mutated after insertion — render objects take them via setStyle and
+// treat them as immutable, which is the same contract WebKit style sharing
+// relies on.
+//
+// The key folds in the parent style's key and the isolate's font selector,
+// so styles computed against different ancestors or different font
+// registries never alias.
+class TextStyleInterner {
+ public:
+  // UI thread only, like the paragraph layout cache this sits beside.
+  static TextStyleInterner& Shared();
+
+  // The style interned under this key, or null on a miss.
+  PassRefPtr<RenderStyle> lookup(uint64_t key);
+
+  void insert(uint64_t key, PassRefPtr<RenderStyle> style);
+
+ private:
+  struct Entry {
+    RefPtr<RenderStyle> style;
+    std::list<uint64_t>::iterator lruPosition;
+  };
+
+  TextStyleInterner();
+
+  ~TextStyleInterner();
+
+  // Most recently used keys at the front.
+  std::list<uint64_t> m_lru;
+  std::unordered_map<uint64_t, Entry> m_entries;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(TextStyleInterner);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_TEXT_TEXT_STYLE_INTERNER_H_
@@ -0,0 +1,37 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.ui;
+
+int _internTimelineLabel(String label) native "Timeline_internLabel";
+void _timelineBeginMark(int labelId) native "Timeline_beginMark";
+void _timelineEndMark(int labelId) native "Timeline_endMark";
+void _timelineInstantMark(int labelId) native "Timeline_instantMark";
+
+/// A pre-interned label for low-overhead engine timeline markers.
+///
+/// The label string is copied into the engine once, when the object is
+/// created; marking with it afterwards allocates nothing on either side.
+/// Markers land in the engine's always-on flight recorder and, while tracing
+/// is active, in the timeline alongside the engine's own events - cheap
+/// enough to leave in production code, unlike `dart:developer`'s [Timeline].
+///
+/// The engine interns a bounded number of distinct labels; create labels
+/// once and reuse them rather than constructing them per event. Marking with
+/// a label that failed to intern is silently ignored.
+class TimelineLabel {
+  /// Interns [label] and returns a handle for marking with it.
+  TimelineLabel(String label) : _id = _internTimelineLabel(label);
+
+  final int _id;
+
+  /// Opens a duration span. Must be balanced by a matching [end].
+  void begin() => _timelineBeginMark(_id);
+
+  /// Closes the span opened by the matching [begin].
+  void end() => _timelineEndMark(_id);
+
+  /// Records a zero-duration event.
+  void instant() => _timelineInstantMark(_id);
+}
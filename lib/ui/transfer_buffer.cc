@@ -0,0 +1,85 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/transfer_buffer.h"
+
+#include <cstring>
+#include <memory>
+
+#include "flutter/common/buffer_transfer_service.h"
+#include "lib/tonic/converter/dart_converter.h"
+#include "lib/tonic/typed_data/uint8_list.h"
+
+using tonic::ToDart;
+
+namespace blink {
+namespace {
+
+void FreeTransferredMapping(void* isolate_callback_data,
+                            Dart_WeakPersistentHandle handle,
+                            void* peer) {
+  delete reinterpret_cast<fml::Mapping*>(peer);
+}
+
+void TransferBuffer_register(Dart_NativeArguments args) {
+  Dart_Handle exception = nullptr;
+  tonic::Uint8List list =
+      tonic::DartConverter<tonic::Uint8List>::FromArguments(args, 0, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  // The one copy in the whole transfer: the bytes leave the sender's VM heap
+  // for an engine-owned buffer. The receiver takes that buffer by reference.
+  size_t size = list.num_elements();
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[size]);
+  memcpy(buffer.get(), list.data(), size);
+
+  int64_t handle = BufferTransferService::Shared().Register(
+      std::make_unique<HeapBufferMapping>(std::move(buffer), size));
+  Dart_SetReturnValue(args, ToDart(handle));
+}
+
+void TransferBuffer_claim(Dart_NativeArguments args) {
+  Dart_Handle exception = nullptr;
+  int64_t handle =
+      tonic::DartConverter<int64_t>::FromArguments(args, 0, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  auto mapping = BufferTransferService::Shared().Take(handle);
+  if (mapping == nullptr) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+
+  // Materialize the buffer as external typed data: the receiving isolate's
+  // garbage collector now owns it and frees it through the finalizer.
+  fml::Mapping* peer = mapping.release();
+  Dart_Handle data_handle = Dart_NewExternalTypedData(
+      Dart_TypedData_kUint8, const_cast<uint8_t*>(peer->GetMapping()),
+      peer->GetSize());
+  if (Dart_IsError(data_handle)) {
+    delete peer;
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+  Dart_NewWeakPersistentHandle(data_handle, peer, peer->GetSize(),
+                               FreeTransferredMapping);
+  Dart_SetReturnValue(args, data_handle);
+}
+
+}  // namespace
+
+void TransferBuffer::RegisterNatives(tonic::DartLibraryNatives* natives) {
+  natives->Register({
+      {"TransferBuffer_register", TransferBuffer_register, 1, true},
+      {"TransferBuffer_claim", TransferBuffer_claim, 1, true},
+  });
+}
+
+}  // namespace blink
@@ -0,0 +1,38 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.ui;
+
+int _registerTransferBuffer(Uint8List buffer) native "TransferBuffer_register";
+Uint8List _claimTransferBuffer(int handle) native "TransferBuffer_claim";
+
+/// Moves large byte buffers between isolates without copying them through
+/// the VM.
+///
+/// Sending a multi-megabyte [Uint8List] through a [SendPort] copies it into
+/// the receiving isolate's heap. [TransferableBuffer.register] instead parks
+/// the bytes in an engine-owned buffer and returns a small integer handle;
+/// send the handle through the port and call [TransferableBuffer.claim] in
+/// the receiving isolate to materialize the same buffer as external typed
+/// data. The bytes are copied out of the sender's heap once, at
+/// registration, and never again.
+///
+/// Each handle can be claimed exactly once; claiming transfers ownership of
+/// the buffer to the receiving isolate, whose garbage collector frees it.
+/// A registered buffer that is never claimed is not reclaimed until the
+/// process exits, so only register buffers a live receiver is waiting for.
+class TransferableBuffer {
+  TransferableBuffer._();
+
+  /// Registers [bytes] with the engine and returns the handle to send
+  /// through a [SendPort].
+  static int register(Uint8List bytes) => _registerTransferBuffer(bytes);
+
+  /// Claims the buffer behind [handle], transferring ownership to this
+  /// isolate.
+  ///
+  /// Returns null if [handle] was never registered or has already been
+  /// claimed.
+  static Uint8List claim(int handle) => _claimTransferBuffer(handle);
+}
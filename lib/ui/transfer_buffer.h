@@ -0,0 +1,26 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_TRANSFER_BUFFER_H_
+#define FLUTTER_LIB_UI_TRANSFER_BUFFER_H_
+
+#include "lib/ftl/macros.h"
+#include "lib/tonic/dart_library_natives.h"
+
+namespace blink {
+
+// Bindings for the buffer transfer service: registering a buffer from one
+// isolate and claiming it in another as external typed data without the
+// bytes ever being copied through a SendPort.
+class TransferBuffer {
+ public:
+  static void RegisterNatives(tonic::DartLibraryNatives* natives);
+
+ private:
+  FTL_DISALLOW_IMPLICIT_CONSTRUCTORS(TransferBuffer);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_TRANSFER_BUFFER_H_
@@ -29,4 +29,6 @@ part 'painting.dart';
 part 'pointer.dart';
 part 'semantics.dart';
 part 'text.dart';
+part 'timeline.dart';
+part 'transfer_buffer.dart';
 part 'window.dart';
@@ -6,12 +6,21 @@
 
 #include "flutter/lib/ui/window/window.h"
 #include "flutter/sky/engine/platform/fonts/FontSelector.h"
+#include "lib/ftl/logging.h"
+#include "lib/ftl/time/time_point.h"
 #include "lib/tonic/converter/dart_converter.h"
+#include "lib/tonic/logging/dart_invoke.h"
 
 using tonic::ToDart;
 
 namespace blink {
 
+// The isolate state currently capturing microtasks, if any. Only written on
+// the thread that owns that isolate, and capture is only active while the
+// isolate is current, so the pointer comparison in
+// CurrentIfCapturingMicrotasks fails benignly on every other thread.
+static UIDartState* g_capturing_microtasks = nullptr;
+
 IsolateClient::~IsolateClient() {}
 
 UIDartState::UIDartState(IsolateClient* isolate_client,
@@ -54,4 +63,53 @@ PassRefPtr<FontSelector> UIDartState::font_selector() {
   return font_selector_;
 }
 
+UIDartState* UIDartState::CurrentIfCapturingMicrotasks() {
+  UIDartState* capturing = g_capturing_microtasks;
+  if (capturing && capturing == DartState::Current())
+    return capturing;
+  return nullptr;
+}
+
+void UIDartState::BeginCapturingMicrotasks() {
+  FTL_DCHECK(DartState::Current() == this);
+  FTL_DCHECK(!g_capturing_microtasks);
+  g_capturing_microtasks = this;
+}
+
+void UIDartState::CaptureMicrotask(Dart_Handle closure) {
+  FTL_DCHECK(g_capturing_microtasks == this);
+  captured_microtasks_.emplace_back(this, closure);
+}
+
+size_t UIDartState::RunCapturedMicrotasks(ftl::TimeDelta budget) {
+  FTL_DCHECK(DartState::Current() == this);
+  FTL_DCHECK(g_capturing_microtasks == this);
+  const ftl::TimePoint deadline = ftl::TimePoint::Now() + budget;
+  // Running a microtask may capture further microtasks, so index rather than
+  // iterate: the vector can grow (and reallocate) during the invoke.
+  size_t ran = 0;
+  while (ran < captured_microtasks_.size()) {
+    Dart_Handle closure = captured_microtasks_[ran].value();
+    ++ran;
+    tonic::DartInvoke(closure, {});
+    if (ftl::TimePoint::Now() >= deadline)
+      break;
+  }
+  captured_microtasks_.erase(captured_microtasks_.begin(),
+                             captured_microtasks_.begin() + ran);
+  return captured_microtasks_.size();
+}
+
+void UIDartState::EndCapturingMicrotasks() {
+  FTL_DCHECK(DartState::Current() == this);
+  FTL_DCHECK(g_capturing_microtasks == this);
+  while (!captured_microtasks_.empty()) {
+    std::vector<tonic::DartPersistentValue> local;
+    local.swap(captured_microtasks_);
+    for (auto& callback : local)
+      tonic::DartInvoke(callback.value(), {});
+  }
+  g_capturing_microtasks = nullptr;
+}
+
 }  // namespace blink
@@ -6,10 +6,12 @@
 #define FLUTTER_LIB_UI_UI_DART_STATE_H_
 
 #include <utility>
+#include <vector>
 
 #include "dart/runtime/include/dart_api.h"
 #include "flutter/sky/engine/wtf/RefPtr.h"
 #include "lib/ftl/build_config.h"
+#include "lib/ftl/time/time_delta.h"
 #include "lib/tonic/dart_persistent_value.h"
 #include "lib/tonic/dart_state.h"
 
@@ -42,6 +44,25 @@ class UIDartState : public tonic::DartState {
   void set_font_selector(PassRefPtr<FontSelector> selector);
   PassRefPtr<FontSelector> font_selector();
 
+  // Frame microtask budgeting. While capturing is active, microtasks
+  // scheduled on this isolate are diverted into a deferred list instead of
+  // the thread's microtask queue, so the drain between the frame callbacks
+  // and the frame build can stop at a deadline instead of running a
+  // microtask storm to completion.
+  //
+  // Returns this isolate's state if it is current on the calling thread and
+  // capturing; null otherwise. Safe to call from any isolate's thread.
+  static UIDartState* CurrentIfCapturingMicrotasks();
+  void BeginCapturingMicrotasks();
+  void CaptureMicrotask(Dart_Handle closure);
+  // Runs captured microtasks in order until the list is empty or |budget|
+  // has elapsed. Returns the number of microtasks still deferred. The
+  // isolate must be current.
+  size_t RunCapturedMicrotasks(ftl::TimeDelta budget);
+  // Runs the remaining captured microtasks (and any they schedule) to
+  // completion, then stops capturing. The isolate must be current.
+  void EndCapturingMicrotasks();
+
  private:
   void DidSetIsolate() override;
 
@@ -50,6 +71,7 @@ class UIDartState : public tonic::DartState {
   std::string debug_name_;
   std::unique_ptr<Window> window_;
   RefPtr<FontSelector> font_selector_;
+  std::vector<tonic::DartPersistentValue> captured_microtasks_;
 };
 
 }  // namespace blink
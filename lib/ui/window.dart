@@ -10,6 +10,9 @@ typedef void VoidCallback();
 /// Signature for [Window.onBeginFrame].
 typedef void FrameCallback(Duration duration);
 
+/// Signature for [Window.onFrameTimings].
+typedef void FrameTimingsCallback(List<FrameTiming> timings);
+
 /// Signature for [Window.onPointerDataPacket].
 typedef void PointerDataPacketCallback(PointerDataPacket packet);
 
@@ -61,6 +64,42 @@ class WindowPadding {
   static const WindowPadding zero = const WindowPadding._(left: 0.0, top: 0.0, right: 0.0, bottom: 0.0);
 }
 
+/// Timing information for a single frame produced by the engine.
+///
+/// All timestamps are [Duration]s since the same arbitrary epoch as the
+/// timestamp passed to [Window.onBeginFrame], so they can be compared with
+/// each other and across frames.
+class FrameTiming {
+  const FrameTiming._({
+    this.vsyncTarget,
+    this.buildStart,
+    this.buildEnd,
+    this.rasterStart,
+    this.rasterEnd
+  });
+
+  /// The vsync this frame was produced for.
+  final Duration vsyncTarget;
+
+  /// When the engine invoked [Window.onBeginFrame] for this frame.
+  final Duration buildStart;
+
+  /// When the frame's scene was handed to the rasterizer.
+  final Duration buildEnd;
+
+  /// When the rasterizer started drawing the frame's scene.
+  final Duration rasterStart;
+
+  /// When the rasterizer finished submitting the frame.
+  final Duration rasterEnd;
+
+  /// How long the framework spent building the frame's scene.
+  Duration get buildDuration => buildEnd - buildStart;
+
+  /// How long the engine spent rasterizing the frame's scene.
+  Duration get rasterDuration => rasterEnd - rasterStart;
+}
+
 /// An identifier used to select a user's language and formatting preferences,
 /// consisting of a language and a country. This is a subset of locale
 /// identifiers as defined by BCP 47.
@@ -155,6 +194,15 @@ class Window {
   /// after any deferred work queued by the onBeginFrame phase.
   VoidCallback onDrawFrame;
 
+  /// A callback that is invoked with the timings of recently presented
+  /// frames.
+  ///
+  /// The engine batches several frames' worth of [FrameTiming] records
+  /// before invoking this callback, so records arrive with a small delay.
+  /// Frames whose scenes were identical to what was already on screen are
+  /// not rasterized and produce no record.
+  FrameTimingsCallback onFrameTimings;
+
   /// A callback that is invoked when pointer data is available.
   PointerDataPacketCallback onPointerDataPacket;
 
@@ -5,9 +5,11 @@
 #ifndef FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_H_
 #define FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
 #include "lib/ftl/memory/ref_counted.h"
 #include "lib/ftl/memory/ref_ptr.h"
@@ -23,6 +25,15 @@ class PlatformMessage : public ftl::RefCountedThreadSafe<PlatformMessage> {
   const std::vector<uint8_t>& data() const { return data_; }
   bool hasData() { return hasData_; }
 
+  // The payload, regardless of whether it is vector- or mapping-backed.
+  const uint8_t* GetData() const;
+  size_t GetDataSize() const;
+
+  // Transfers ownership of the payload's backing mapping out of the
+  // message, or null for vector-backed payloads. Used to hand large
+  // payloads to Dart as external typed data without a copy.
+  std::unique_ptr<fml::Mapping> ReleaseMapping();
+
   const ftl::RefPtr<PlatformMessageResponse>& response() const {
     return response_;
   }
@@ -31,12 +42,19 @@ class PlatformMessage : public ftl::RefCountedThreadSafe<PlatformMessage> {
   PlatformMessage(std::string name,
                   std::vector<uint8_t> data,
                   ftl::RefPtr<PlatformMessageResponse> response);
+  // A zero-copy payload: the message references the mapping's bytes in
+  // place instead of copying them into a vector. Embedders should prefer
+  // this for large payloads.
+  PlatformMessage(std::string name,
+                  std::unique_ptr<fml::Mapping> mapping,
+                  ftl::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string name,
                   ftl::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
   std::string channel_;
   std::vector<uint8_t> data_;
+  std::unique_ptr<fml::Mapping> mapping_;
   bool hasData_;
   ftl::RefPtr<PlatformMessageResponse> response_;
 };
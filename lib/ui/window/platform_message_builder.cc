@@ -0,0 +1,89 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_builder.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace blink {
+
+namespace {
+
+// Big enough that per-block bookkeeping vanishes next to the payload,
+// small enough that the partial tail block wastes little.
+const size_t kBlockSize = 32 * 1024;
+
+}  // namespace
+
+PlatformMessageBuilder::PlatformMessageBuilder() = default;
+
+PlatformMessageBuilder::~PlatformMessageBuilder() = default;
+
+void PlatformMessageBuilder::Append(const uint8_t* data, size_t length) {
+  while (length > 0) {
+    if (blocks_.empty() || blocks_.back().size() == kBlockSize) {
+      blocks_.emplace_back();
+      blocks_.back().reserve(kBlockSize);
+    }
+    std::vector<uint8_t>& block = blocks_.back();
+    size_t copied = std::min(kBlockSize - block.size(), length);
+    block.insert(block.end(), data, data + copied);
+    data += copied;
+    length -= copied;
+    size_ += copied;
+  }
+}
+
+ftl::RefPtr<PlatformMessage> PlatformMessageBuilder::Complete(
+    std::string channel,
+    ftl::RefPtr<PlatformMessageResponse> response) {
+  std::vector<uint8_t> payload;
+  payload.reserve(size_);
+  for (const std::vector<uint8_t>& block : blocks_)
+    payload.insert(payload.end(), block.begin(), block.end());
+  blocks_.clear();
+  size_ = 0;
+  return ftl::MakeRefCounted<PlatformMessage>(
+      std::move(channel), std::move(payload), std::move(response));
+}
+
+ftl::RefPtr<PlatformMessage> PlatformMessageBuilder::Gather(
+    std::string channel,
+    const std::vector<Span>& spans,
+    ftl::RefPtr<PlatformMessageResponse> response) {
+  size_t total = 0;
+  for (const Span& span : spans)
+    total += span.length;
+  std::vector<uint8_t> payload;
+  payload.reserve(total);
+  for (const Span& span : spans)
+    payload.insert(payload.end(), span.data, span.data + span.length);
+  return ftl::MakeRefCounted<PlatformMessage>(
+      std::move(channel), std::move(payload), std::move(response));
+}
+
+PlatformMessageChunkIterator::PlatformMessageChunkIterator(
+    const PlatformMessage& message)
+    : PlatformMessageChunkIterator(message, kBlockSize) {}
+
+PlatformMessageChunkIterator::PlatformMessageChunkIterator(
+    const PlatformMessage& message,
+    size_t chunk_size)
+    : data_(message.GetData()),
+      remaining_(message.GetDataSize()),
+      chunk_size_(chunk_size) {}
+
+bool PlatformMessageChunkIterator::Next(const uint8_t** data,
+                                        size_t* length) {
+  if (remaining_ == 0)
+    return false;
+  *data = data_;
+  *length = std::min(chunk_size_, remaining_);
+  data_ += *length;
+  remaining_ -= *length;
+  return true;
+}
+
+}  // namespace blink
@@ -0,0 +1,88 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_BUILDER_H_
+#define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_BUILDER_H_
+
+#include <string>
+#include <vector>
+
+#include "flutter/lib/ui/window/platform_message.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_ptr.h"
+
+namespace blink {
+
+// Builds a platform message payload incrementally. Appended bytes land in
+// fixed-size blocks, so constructing a large message never reallocates or
+// re-copies what was already appended the way growing a monolithic vector
+// does; peak overhead is one block regardless of message size. The chunks
+// are gathered into the message's contiguous payload exactly once at
+// Complete, since every embedder boundary (JNI byte arrays, NSData, FIDL
+// buffers, Dart ByteData) ultimately requires contiguous bytes.
+class PlatformMessageBuilder {
+ public:
+  // A view into caller-owned bytes, used for scatter-gather sends.
+  struct Span {
+    const uint8_t* data;
+    size_t length;
+  };
+
+  PlatformMessageBuilder();
+
+  ~PlatformMessageBuilder();
+
+  // Appends a copy of |length| bytes to the message under construction.
+  void Append(const uint8_t* data, size_t length);
+
+  size_t size() const { return size_; }
+
+  // Assembles the accumulated chunks into a message with a single
+  // exact-size gather and resets the builder for reuse. The message is
+  // dispatched like any other, e.g. through
+  // PlatformView::DispatchPlatformMessage.
+  ftl::RefPtr<PlatformMessage> Complete(
+      std::string channel,
+      ftl::RefPtr<PlatformMessageResponse> response);
+
+  // Gathers caller-owned spans straight into a message's payload with one
+  // exact-size copy, skipping the builder's block storage entirely.
+  static ftl::RefPtr<PlatformMessage> Gather(
+      std::string channel,
+      const std::vector<Span>& spans,
+      ftl::RefPtr<PlatformMessageResponse> response);
+
+ private:
+  // Full blocks plus one partial tail block. Growing the outer vector
+  // moves only the inner vectors' pointers, never their bytes.
+  std::vector<std::vector<uint8_t>> blocks_;
+  size_t size_ = 0;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PlatformMessageBuilder);
+};
+
+// Walks a received message's payload as successive bounded-size views
+// without copying, so a consumer of a large streamed message never needs
+// more than one chunk's worth of working memory. The views alias the
+// message's payload and stay valid only as long as the message does.
+class PlatformMessageChunkIterator {
+ public:
+  explicit PlatformMessageChunkIterator(const PlatformMessage& message);
+
+  PlatformMessageChunkIterator(const PlatformMessage& message,
+                               size_t chunk_size);
+
+  // Points |data|/|length| at the next chunk. Returns false once the
+  // payload is exhausted.
+  bool Next(const uint8_t** data, size_t* length);
+
+ private:
+  const uint8_t* data_;
+  size_t remaining_;
+  size_t chunk_size_;
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_BUILDER_H_
@@ -13,6 +13,27 @@
 
 namespace blink {
 
+namespace {
+
+Dart_Handle ToByteData(const std::vector<uint8_t>& data) {
+  Dart_Handle byte_buffer =
+      Dart_NewTypedData(Dart_TypedData_kByteData, data.size());
+  DART_CHECK_VALID(byte_buffer);
+
+  void* buffer;
+  intptr_t length;
+  Dart_TypedData_Type type;
+  DART_CHECK_VALID(
+      Dart_TypedDataAcquireData(byte_buffer, &type, &buffer, &length));
+  FTL_CHECK(type == Dart_TypedData_kByteData);
+  FTL_CHECK(static_cast<size_t>(length) == data.size());
+  memcpy(buffer, data.data(), length);
+  Dart_TypedDataReleaseData(byte_buffer);
+  return byte_buffer;
+}
+
+}  // namespace
+
 PlatformMessageResponseDart::PlatformMessageResponseDart(
     tonic::DartPersistentValue callback)
     : callback_(std::move(callback)) {}
@@ -26,32 +47,50 @@ PlatformMessageResponseDart::~PlatformMessageResponseDart() {
   }
 }
 
+bool PlatformMessageResponseDart::TryCompleteInline(
+    const std::vector<uint8_t>* data) {
+  if (!Threads::UI()->RunsTasksOnCurrentThread())
+    return false;
+  tonic::DartState* dart_state = callback_.dart_state().get();
+  if (!dart_state)
+    return false;
+  if (Dart_CurrentIsolate() == dart_state->isolate()) {
+    // Same stack as the dispatch: the handler answered before returning and
+    // the isolate is already entered.
+    InvokeCallback(data);
+    return true;
+  }
+  if (Dart_CurrentIsolate() == nullptr) {
+    tonic::DartState::Scope scope(dart_state);
+    InvokeCallback(data);
+    return true;
+  }
+  // A different isolate is active on this thread; deliver asynchronously.
+  return false;
+}
+
+void PlatformMessageResponseDart::InvokeCallback(
+    const std::vector<uint8_t>* data) {
+  tonic::DartInvoke(callback_.Release(),
+                    {data ? ToByteData(*data) : Dart_Null()});
+}
+
 void PlatformMessageResponseDart::Complete(std::vector<uint8_t> data) {
   if (callback_.is_empty())
     return;
   FTL_DCHECK(!is_complete_);
   is_complete_ = true;
+
+  if (TryCompleteInline(&data))
+    return;
+
   Threads::UI()->PostTask(ftl::MakeCopyable(
       [ callback = std::move(callback_), data = std::move(data) ]() mutable {
         tonic::DartState* dart_state = callback.dart_state().get();
         if (!dart_state)
           return;
         tonic::DartState::Scope scope(dart_state);
-
-        Dart_Handle byte_buffer = Dart_NewTypedData(
-            Dart_TypedData_kByteData, data.size());
-        DART_CHECK_VALID(byte_buffer);
-
-        void* buffer;
-        intptr_t length;
-        Dart_TypedData_Type type;
-        DART_CHECK_VALID(
-            Dart_TypedDataAcquireData(byte_buffer, &type, &buffer, &length));
-        FTL_CHECK(type == Dart_TypedData_kByteData);
-        FTL_CHECK(static_cast<size_t>(length) == data.size());
-        memcpy(buffer, data.data(), length);
-        Dart_TypedDataReleaseData(byte_buffer);
-        tonic::DartInvoke(callback.Release(), {byte_buffer});
+        tonic::DartInvoke(callback.Release(), {ToByteData(data)});
       }));
 }
 
@@ -60,6 +99,10 @@ void PlatformMessageResponseDart::CompleteEmpty() {
     return;
   FTL_DCHECK(!is_complete_);
   is_complete_ = true;
+
+  if (TryCompleteInline(nullptr))
+    return;
+
   Threads::UI()->PostTask(ftl::MakeCopyable(
       [ callback = std::move(callback_) ]() mutable {
         tonic::DartState* dart_state = callback.dart_state().get();
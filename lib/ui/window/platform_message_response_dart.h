@@ -22,6 +22,20 @@ class PlatformMessageResponseDart : public PlatformMessageResponse {
   explicit PlatformMessageResponseDart(tonic::DartPersistentValue callback);
   ~PlatformMessageResponseDart() override;
 
+ private:
+  // Same-stack fast path: when a handler answers before the dispatch
+  // returns and we are already on the UI thread, the callback can be
+  // invoked directly instead of round-tripping through a task post — the
+  // hop otherwise costs replies to synchronous-capable handlers (keyboard
+  // height queries and the like) up to a frame of latency. |data| is null
+  // for an empty completion. Returns false when inline delivery is not
+  // safe, in which case the caller takes the async path.
+  bool TryCompleteInline(const std::vector<uint8_t>* data);
+
+  // Builds the response argument and invokes the callback. Must be called
+  // on the UI thread with the callback's isolate current.
+  void InvokeCallback(const std::vector<uint8_t>* data);
+
   tonic::DartPersistentValue callback_;
 };
 
@@ -8,12 +8,18 @@
 
 namespace blink {
 
-// If this value changes, update the pointer data unpacking code in hooks.dart.
-static constexpr int kPointerDataFieldCount = 19;
+// If these values change, update the pointer data unpacking code in
+// hooks.dart.
+static constexpr int kPointerDataFieldCount = 20;
+static constexpr int kPointerDataHistoryFieldCount = 4;
 
 static_assert(sizeof(PointerData) == sizeof(int64_t) * kPointerDataFieldCount,
               "PointerData has the wrong size");
 
+static_assert(sizeof(PointerDataHistorySample) ==
+                  sizeof(int64_t) * kPointerDataHistoryFieldCount,
+              "PointerDataHistorySample has the wrong size");
+
 void PointerData::Clear() {
   memset(this, 0, sizeof(PointerData));
 }
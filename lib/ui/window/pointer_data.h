@@ -49,10 +49,23 @@ struct alignas(8) PointerData {
   double radius_max;
   double orientation;
   double tilt;
+  // Number of PointerDataHistorySample records that immediately follow this
+  // record in a packet.
+  int64_t history_count;
 
   void Clear();
 };
 
+// An earlier report of a pointer that was coalesced into a single
+// PointerData record; samples trail the record they belong to, oldest
+// first. This structure is unpacked by hooks.dart.
+struct alignas(8) PointerDataHistorySample {
+  int64_t time_stamp;
+  double physical_x;
+  double physical_y;
+  double pressure;
+};
+
 }  // namespace blink
 
 #endif  // FLUTTER_LIB_UI_WINDOW_POINTER_DATA_H_
@@ -6,18 +6,136 @@
 
 #include <string.h>
 
+#include <mutex>
+#include <vector>
+
 namespace blink {
 
-PointerDataPacket::PointerDataPacket(size_t count)
-    : data_(count * sizeof(PointerData)) {}
+namespace {
+
+// Slab size: room for a frame's worth of events with history even at
+// stylus report rates. Packets beyond this spill to the heap.
+const size_t kSlabCapacity = 4096;
+
+// Slabs kept for reuse. Packets are built on the platform thread and
+// destroyed on the UI thread once Dart has consumed them, so the free
+// list is mutex-guarded; at input rates the lock is uncontended.
+const size_t kMaxPooledSlabs = 16;
+
+class SlabPool {
+ public:
+  uint8_t* Acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_slabs_.empty()) {
+        uint8_t* slab = free_slabs_.back();
+        free_slabs_.pop_back();
+        return slab;
+      }
+    }
+    return new uint8_t[kSlabCapacity];
+  }
+
+  void Release(uint8_t* slab) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (free_slabs_.size() < kMaxPooledSlabs) {
+        free_slabs_.push_back(slab);
+        return;
+      }
+    }
+    delete[] slab;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint8_t*> free_slabs_;
+};
+
+SlabPool& Pool() {
+  static SlabPool* pool = new SlabPool();
+  return *pool;
+}
+
+}  // namespace
+
+PointerDataPacket::PointerDataPacket()
+    : buffer_(nullptr), size_(0), capacity_(0), pooled_(false) {}
+
+PointerDataPacket::PointerDataPacket(size_t count) : PointerDataPacket() {
+  size_t bytes = count * sizeof(PointerData);
+  memset(Reserve(bytes), 0, bytes);
+  size_ = bytes;
+}
 
 PointerDataPacket::PointerDataPacket(uint8_t* data, size_t num_bytes)
-    : data_(data, data + num_bytes) {}
+    : PointerDataPacket() {
+  memcpy(Reserve(num_bytes), data, num_bytes);
+  size_ = num_bytes;
+}
+
+PointerDataPacket::~PointerDataPacket() {
+  ReleaseBuffer();
+}
 
-PointerDataPacket::~PointerDataPacket() = default;
+uint8_t* PointerDataPacket::Reserve(size_t bytes) {
+  size_t required = size_ + bytes;
+  if (required > capacity_) {
+    if (buffer_ == nullptr && required <= kSlabCapacity) {
+      buffer_ = Pool().Acquire();
+      capacity_ = kSlabCapacity;
+      pooled_ = true;
+    } else {
+      size_t new_capacity = capacity_ == 0 ? kSlabCapacity : capacity_ * 2;
+      while (new_capacity < required) {
+        new_capacity *= 2;
+      }
+      uint8_t* new_buffer = new uint8_t[new_capacity];
+      memcpy(new_buffer, buffer_, size_);
+      ReleaseBuffer();
+      buffer_ = new_buffer;
+      capacity_ = new_capacity;
+      pooled_ = false;
+    }
+  }
+  return buffer_ + size_;
+}
+
+void PointerDataPacket::ReleaseBuffer() {
+  if (buffer_ == nullptr) {
+    return;
+  }
+  if (pooled_) {
+    Pool().Release(buffer_);
+  } else {
+    delete[] buffer_;
+  }
+  buffer_ = nullptr;
+  capacity_ = 0;
+  pooled_ = false;
+}
 
 void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
-  memcpy(&data_[i * sizeof(PointerData)], &data, sizeof(PointerData));
+  memcpy(&buffer_[i * sizeof(PointerData)], &data, sizeof(PointerData));
+}
+
+void PointerDataPacket::AppendPointerData(const PointerData& data) {
+  memcpy(Reserve(sizeof(PointerData)), &data, sizeof(PointerData));
+  size_ += sizeof(PointerData);
+}
+
+void PointerDataPacket::AppendHistorySample(
+    const PointerDataHistorySample& sample) {
+  memcpy(Reserve(sizeof(PointerDataHistorySample)), &sample,
+         sizeof(PointerDataHistorySample));
+  size_ += sizeof(PointerDataHistorySample);
+}
+
+PointerData* PointerDataPacket::AppendUninitializedPointerData() {
+  uint8_t* slot = Reserve(sizeof(PointerData));
+  memset(slot, 0, sizeof(PointerData));
+  size_ += sizeof(PointerData);
+  return reinterpret_cast<PointerData*>(slot);
 }
 
 }  // namespace blink
@@ -7,24 +7,54 @@
 
 #include <string.h>
 
-#include <vector>
-
 #include "flutter/lib/ui/window/pointer_data.h"
 #include "lib/ftl/macros.h"
 
 namespace blink {
 
+// A serialized run of pointer events. Packet storage comes from a
+// process-wide pool of fixed-capacity slabs recycled when packets are
+// destroyed after Dart consumes them, so steady-state input delivery —
+// even at stylus report rates — allocates nothing; packets larger than a
+// slab transparently fall back to the heap.
 class PointerDataPacket {
  public:
+  // Creates an empty packet to be filled with the append methods below.
+  PointerDataPacket();
   explicit PointerDataPacket(size_t count);
   PointerDataPacket(uint8_t* data, size_t num_bytes);
   ~PointerDataPacket();
 
   void SetPointerData(size_t i, const PointerData& data);
-  const std::vector<uint8_t>& data() const { return data_; }
+
+  // Appends |data| to the packet. Its history samples, if any, must be
+  // appended immediately afterwards and |data.history_count| must match
+  // their number.
+  void AppendPointerData(const PointerData& data);
+  void AppendHistorySample(const PointerDataHistorySample& sample);
+
+  // Reserves space for one PointerData in the packet's buffer and returns
+  // it for in-place construction, zero-initialized. Writers filling the
+  // fields directly skip the build-on-stack-then-copy of
+  // AppendPointerData().
+  PointerData* AppendUninitializedPointerData();
+
+  const uint8_t* data() const { return buffer_; }
+  size_t size() const { return size_; }
 
  private:
-  std::vector<uint8_t> data_;
+  // Grows the buffer so it can hold |bytes| more and returns the write
+  // position, acquiring a pooled slab first and moving to the heap only
+  // past slab capacity.
+  uint8_t* Reserve(size_t bytes);
+
+  void ReleaseBuffer();
+
+  uint8_t* buffer_;
+  size_t size_;
+  size_t capacity_;
+  // True while |buffer_| is a pooled slab rather than a heap block.
+  bool pooled_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(PointerDataPacket);
 };
@@ -4,7 +4,9 @@
 
 #include "flutter/lib/ui/window/window.h"
 
+#include "flutter/glue/trace_event.h"
 #include "flutter/lib/ui/compositing/scene.h"
+#include "flutter/lib/ui/painting/image_registry.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -22,9 +24,38 @@ using tonic::ToDart;
 namespace blink {
 namespace {
 
-Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
+// How long microtasks scheduled during the frame callbacks may run before
+// the remainder is deferred until after the frame has been built and
+// rendered. Small relative to the frame interval so a microtask storm
+// cannot push _drawFrame past the deadline.
+const int64_t kMicrotaskBudgetMicroseconds = 1000;
+
+void FreeMessageMapping(void* isolate_callback_data,
+                        Dart_WeakPersistentHandle handle,
+                        void* peer) {
+  delete reinterpret_cast<fml::Mapping*>(peer);
+}
+
+// Wraps a mapping-backed payload as external typed data, transferring
+// ownership to the Dart garbage collector instead of copying the bytes.
+Dart_Handle ToExternalByteData(std::unique_ptr<fml::Mapping> mapping) {
+  fml::Mapping* peer = mapping.release();
+  Dart_Handle data_handle = Dart_NewExternalTypedData(
+      Dart_TypedData_kByteData,
+      const_cast<uint8_t*>(peer->GetMapping()),
+      peer->GetSize());
+  if (Dart_IsError(data_handle)) {
+    delete peer;
+    return data_handle;
+  }
+  Dart_NewWeakPersistentHandle(data_handle, peer, peer->GetSize(),
+                               FreeMessageMapping);
+  return data_handle;
+}
+
+Dart_Handle ToByteData(const uint8_t* bytes, size_t size) {
   Dart_Handle data_handle =
-      Dart_NewTypedData(Dart_TypedData_kByteData, buffer.size());
+      Dart_NewTypedData(Dart_TypedData_kByteData, size);
   if (Dart_IsError(data_handle))
     return data_handle;
 
@@ -34,11 +65,15 @@ Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
   FTL_CHECK(!Dart_IsError(
       Dart_TypedDataAcquireData(data_handle, &type, &data, &num_bytes)));
 
-  memcpy(data, buffer.data(), num_bytes);
+  memcpy(data, bytes, num_bytes);
   Dart_TypedDataReleaseData(data_handle);
   return data_handle;
 }
 
+Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
+  return ToByteData(buffer.data(), buffer.size());
+}
+
 void ScheduleFrame(Dart_NativeArguments args) {
   UIDartState::Current()->window()->client()->ScheduleFrame();
 }
@@ -170,9 +205,14 @@ void Window::DispatchPlatformMessage(ftl::RefPtr<PlatformMessage> message) {
   if (!dart_state)
     return;
   tonic::DartState::Scope scope(dart_state);
-  Dart_Handle data_handle = (message->hasData())
-      ? ToByteData(message->data())
-      : Dart_Null();
+  Dart_Handle data_handle = Dart_Null();
+  if (message->hasData()) {
+    if (auto mapping = message->ReleaseMapping()) {
+      data_handle = ToExternalByteData(std::move(mapping));
+    } else {
+      data_handle = ToByteData(message->data());
+    }
+  }
   if (Dart_IsError(data_handle))
     return;
 
@@ -193,7 +233,7 @@ void Window::DispatchPointerDataPacket(const PointerDataPacket& packet) {
     return;
   tonic::DartState::Scope scope(dart_state);
 
-  Dart_Handle data_handle = ToByteData(packet.data());
+  Dart_Handle data_handle = ToByteData(packet.data(), packet.size());
   if (Dart_IsError(data_handle))
     return;
   DartInvokeField(library_.value(), "_dispatchPointerDataPacket",
@@ -218,14 +258,61 @@ void Window::BeginFrame(ftl::TimePoint frameTime) {
 
   int64_t microseconds = (frameTime - ftl::TimePoint()).ToMicroseconds();
 
+  // Capture microtasks scheduled while the frame is being produced so the
+  // pre-build drain below can be cut off at a budget. A misbehaving stream
+  // can otherwise stall _drawFrame for the rest of the frame interval.
+  UIDartState* ui_state = UIDartState::Current();
+  ui_state->BeginCapturingMicrotasks();
+
+  // Age the decoded-image working set and apply its eviction policy before
+  // the frame build stamps images as used again.
+  ImageRegistry::Shared().AdvanceGeneration();
+
   DartInvokeField(library_.value(), "_beginFrame",
                   {
                       Dart_NewInteger(microseconds),
                   });
 
+  // Run anything left in the thread's queue from before the frame began.
   tonic::DartMicrotaskQueue::GetForCurrentThread()->RunMicrotasks();
 
+  size_t deferred = ui_state->RunCapturedMicrotasks(
+      ftl::TimeDelta::FromMicroseconds(kMicrotaskBudgetMicroseconds));
+  if (deferred > 0) {
+    char deferred_count[32];
+    snprintf(deferred_count, sizeof(deferred_count), "%zu", deferred);
+    TRACE_EVENT_INSTANT1("flutter", "DeferredFrameMicrotasks", "count",
+                         deferred_count);
+  }
+
   DartInvokeField(library_.value(), "_drawFrame", {});
+
+  // The layer tree has been handed to the rasterizer; let the remainder of
+  // the storm (and anything scheduled during the build) run now.
+  ui_state->EndCapturingMicrotasks();
+}
+
+void Window::ReportFrameTimings(std::vector<int64_t> timings) {
+  tonic::DartState* dart_state = library_.dart_state().get();
+  if (!dart_state)
+    return;
+  tonic::DartState::Scope scope(dart_state);
+
+  Dart_Handle data_handle =
+      Dart_NewTypedData(Dart_TypedData_kInt64, timings.size());
+  if (Dart_IsError(data_handle))
+    return;
+
+  Dart_TypedData_Type type;
+  void* data = nullptr;
+  intptr_t num_elements = 0;
+  FTL_CHECK(!Dart_IsError(
+      Dart_TypedDataAcquireData(data_handle, &type, &data, &num_elements)));
+
+  memcpy(data, timings.data(), num_elements * sizeof(int64_t));
+  Dart_TypedDataReleaseData(data_handle);
+
+  DartInvokeField(library_.value(), "_reportFrameTimings", {data_handle});
 }
 
 void Window::CompletePlatformMessageEmptyResponse(int response_id) {
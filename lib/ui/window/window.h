@@ -49,6 +49,12 @@ class Window {
   void DispatchSemanticsAction(int32_t id, SemanticsAction action);
   void BeginFrame(ftl::TimePoint frameTime);
 
+  // Delivers a batch of frame timing records to the framework as one Int64
+  // typed-data block. |timings| is a multiple of the record size; the field
+  // order within a record is defined next to _reportFrameTimings in
+  // hooks.dart.
+  void ReportFrameTimings(std::vector<int64_t> timings);
+
   void CompletePlatformMessageResponse(int response_id,
                                        std::vector<uint8_t> data);
   void CompletePlatformMessageEmptyResponse(int response_id);
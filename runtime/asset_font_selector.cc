@@ -4,16 +4,18 @@
 
 #include "flutter/runtime/asset_font_selector.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include "flutter/assets/zip_asset_store.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/runtime/typeface_registry.h"
 #include "flutter/sky/engine/platform/fonts/FontData.h"
 #include "flutter/sky/engine/platform/fonts/FontFaceCreationParams.h"
 #include "flutter/sky/engine/platform/fonts/SimpleFontData.h"
 #include "lib/ftl/arraysize.h"
 #include "third_party/rapidjson/rapidjson/document.h"
-#include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkTypeface.h"
-#include "third_party/skia/include/ports/SkFontMgr.h"
 
 namespace blink {
 
@@ -26,17 +28,44 @@ struct AssetFontSelector::FlutterFontAttributes {
   FontStyle style;
 };
 
-// A Skia typeface along with a buffer holding the raw typeface asset data.
+// A Skia typeface along with the interned data backing it. Both come from
+// the process-wide TypefaceRegistry, so engine instances loading the same
+// font asset share one copy.
 struct AssetFontSelector::TypefaceAsset {
   TypefaceAsset();
   ~TypefaceAsset();
   sk_sp<SkTypeface> typeface;
-  std::vector<uint8_t> data;
+  sk_sp<SkData> data;
 };
 
 namespace {
 const char kFontManifestAssetPath[] = "FontManifest.json";
 
+// Typefaces carried across hot restarts, keyed by asset path and validated
+// against the content fingerprint from the bundle manifest. A restart with
+// an updated bundle misses only for assets whose content actually changed;
+// unchanged fonts skip decompression and typeface creation entirely. Stale
+// entries are replaced on the next load, so no explicit invalidation pass
+// is needed. Guarded by a mutex because each isolate's selector lives on
+// its own UI thread.
+struct PersistentTypefaceEntry {
+  uint64_t fingerprint;
+  sk_sp<SkData> data;
+  sk_sp<SkTypeface> typeface;
+};
+
+std::mutex& PersistentTypefaceMutex() {
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+std::unordered_map<std::string, PersistentTypefaceEntry>&
+PersistentTypefaceCache() {
+  static auto* cache =
+      new std::unordered_map<std::string, PersistentTypefaceEntry>();
+  return *cache;
+}
+
 // Weight values corresponding to the members of the FontWeight enum.
 const int kFontWeightValue[] = {100, 200, 300, 400, 500, 600, 700, 800, 900};
 
@@ -219,22 +248,48 @@ sk_sp<SkTypeface> AssetFontSelector::getTypefaceAsset(
     return cache_asset ? cache_asset->typeface : nullptr;
   }
 
+  uint64_t fingerprint = 0;
+  bool has_fingerprint =
+      asset_store_->GetEntryFingerprint(asset_path, &fingerprint);
+
   std::unique_ptr<TypefaceAsset> typeface_asset(new TypefaceAsset);
-  if (!asset_store_->GetAsBuffer(asset_path, &typeface_asset->data)) {
+
+  if (has_fingerprint) {
+    std::lock_guard<std::mutex> lock(PersistentTypefaceMutex());
+    auto persistent_iter = PersistentTypefaceCache().find(asset_path);
+    if (persistent_iter != PersistentTypefaceCache().end() &&
+        persistent_iter->second.fingerprint == fingerprint) {
+      typeface_asset->typeface = persistent_iter->second.typeface;
+      typeface_asset->data = persistent_iter->second.data;
+      sk_sp<SkTypeface> result = typeface_asset->typeface;
+      typeface_cache_.insert(
+          std::make_pair(asset_path, std::move(typeface_asset)));
+      return result;
+    }
+  }
+
+  std::vector<uint8_t> buffer;
+  if (!asset_store_->GetAsBuffer(asset_path, &buffer)) {
     typeface_cache_.insert(std::make_pair(asset_path, nullptr));
     return nullptr;
   }
 
-  sk_sp<SkFontMgr> font_mgr(SkFontMgr::RefDefault());
-  SkMemoryStream* typeface_stream = new SkMemoryStream(
-      typeface_asset->data.data(), typeface_asset->data.size());
-  typeface_asset->typeface =
-      sk_sp<SkTypeface>(font_mgr->createFromStream(typeface_stream));
+  // Intern through the process-wide registry: another engine instance (or
+  // another family entry pointing at the same bytes) that already loaded
+  // this font shares its data and typeface instead of duplicating them.
+  typeface_asset->typeface = TypefaceRegistry::Shared().InternTypeface(
+      buffer.data(), buffer.size(), &typeface_asset->data);
   if (typeface_asset->typeface == nullptr) {
     typeface_cache_.insert(std::make_pair(asset_path, nullptr));
     return nullptr;
   }
 
+  if (has_fingerprint) {
+    std::lock_guard<std::mutex> lock(PersistentTypefaceMutex());
+    PersistentTypefaceCache()[asset_path] = {fingerprint, typeface_asset->data,
+                                             typeface_asset->typeface};
+  }
+
   sk_sp<SkTypeface> result = typeface_asset->typeface;
   typeface_cache_.insert(std::make_pair(asset_path, std::move(typeface_asset)));
 
@@ -5,8 +5,10 @@
 #include "flutter/runtime/dart_controller.h"
 
 #include <utility>
+#include <vector>
 
 #include "dart/runtime/include/dart_tools_api.h"
+#include "flutter/assets/zip_asset_store.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
 #include "flutter/glue/trace_event.h"
@@ -16,6 +18,7 @@
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/runtime/dart_service_isolate.h"
+#include "flutter/runtime/start_up.h"
 #include "lib/ftl/files/directory.h"
 #include "lib/ftl/files/path.h"
 #include "lib/tonic/dart_class_library.h"
@@ -144,21 +147,66 @@ tonic::DartErrorHandleType DartController::RunFromSource(
   Dart_Handle result = loader.LoadScript(main);
   LogIfError(result);
   tonic::DartErrorHandleType error = tonic::GetErrorHandleType(result);
+  if (!Dart_IsError(result)) {
+    // Capture the loaded state so Isolate.spawn clones this isolate from a
+    // script snapshot in memory instead of re-parsing the source.
+    uint8_t* snapshot_buffer = nullptr;
+    intptr_t snapshot_size = 0;
+    Dart_Handle snapshot_result =
+        Dart_CreateScriptSnapshot(&snapshot_buffer, &snapshot_size);
+    if (!LogIfError(snapshot_result) && snapshot_buffer && snapshot_size > 0) {
+      CacheIsolateSpawnTemplate(
+          script_uri_, IsolateSpawnTemplateKind::ScriptSnapshot,
+          std::vector<uint8_t>(snapshot_buffer,
+                               snapshot_buffer + snapshot_size));
+    }
+  }
   if (SendStartMessage(Dart_RootLibrary())) {
     return tonic::kCompilationErrorType;
   }
   return error;
 }
 
+tonic::DartErrorHandleType DartController::LoadDeferredLibraryFromAssets(
+    ZipAssetStore& store,
+    const std::string& asset_name,
+    const std::string& library_url) {
+  TRACE_EVENT0("flutter", "DartController::LoadDeferredLibraryFromAssets");
+  std::vector<uint8_t> source;
+  if (!store.GetAsBuffer(asset_name, &source)) {
+    FTL_LOG(WARNING) << "Deferred library asset not found: " << asset_name;
+    return tonic::kUnknownErrorType;
+  }
+
+  tonic::DartState::Scope scope(dart_state());
+  Dart_Handle source_handle =
+      Dart_NewStringFromUTF8(source.data(), source.size());
+  if (LogIfError(source_handle))
+    return tonic::GetErrorHandleType(source_handle);
+
+  Dart_Handle library =
+      Dart_LoadLibrary(ToDart(library_url), Dart_Null(), source_handle, 0, 0);
+  if (LogIfError(library))
+    return tonic::GetErrorHandleType(library);
+
+  // Finalize and complete outstanding loadLibrary() futures so Dart code
+  // waiting on the deferred import resumes.
+  Dart_Handle result = Dart_FinalizeLoading(true);
+  LogIfError(result);
+  return tonic::GetErrorHandleType(result);
+}
+
 void DartController::CreateIsolateFor(const std::string& script_uri,
                                       const uint8_t* isolate_snapshot_data,
                                       const uint8_t* isolate_snapshot_instr,
                                       std::unique_ptr<UIDartState> state) {
+  script_uri_ = script_uri;
   char* error = nullptr;
   Dart_Isolate isolate = Dart_CreateIsolate(
       script_uri.c_str(), "main", isolate_snapshot_data, isolate_snapshot_instr,
       nullptr, static_cast<tonic::DartState*>(state.get()), &error);
   FTL_CHECK(isolate) << error;
+  RecordStartupMilestone(kStartupMilestoneIsolateCreated);
   ui_dart_state_ = state.release();
   dart_state()->message_handler().Initialize(blink::Threads::UI());
 
@@ -6,6 +6,7 @@
 #define FLUTTER_RUNTIME_DART_CONTROLLER_H_
 
 #include <memory>
+#include <string>
 
 #include "dart/runtime/include/dart_api.h"
 #include "lib/ftl/macros.h"
@@ -13,6 +14,7 @@
 
 namespace blink {
 class UIDartState;
+class ZipAssetStore;
 
 class DartController {
  public:
@@ -26,6 +28,18 @@ class DartController {
   tonic::DartErrorHandleType RunFromSource(const std::string& main,
                                            const std::string& packages);
 
+  // Loads a deferred library unit stored as Dart source in the asset bundle
+  // into the running isolate and completes any pending loadLibrary()
+  // futures. |asset_name| names the entry inside |store|; |library_url| is
+  // the URL the library was imported as. This VM has no split script
+  // snapshots, so deferred units ship as source and pay a parse on first
+  // load -- which is still only paid when (and if) the flow is reached
+  // instead of at startup.
+  tonic::DartErrorHandleType LoadDeferredLibraryFromAssets(
+      ZipAssetStore& store,
+      const std::string& asset_name,
+      const std::string& library_url);
+
   void CreateIsolateFor(const std::string& script_uri,
                         const uint8_t* isolate_snapshot_data,
                         const uint8_t* isolate_snapshot_instr,
@@ -40,6 +54,10 @@ class DartController {
   // during isolate shutdown.
   UIDartState* ui_dart_state_;
 
+  // The URI this controller's isolate was created for; used as the key when
+  // registering a spawn template for secondary isolates.
+  std::string script_uri_;
+
   FTL_DISALLOW_COPY_AND_ASSIGN(DartController);
 };
 }
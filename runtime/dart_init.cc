@@ -9,7 +9,9 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +27,7 @@
 #include "flutter/lib/ui/dart_ui.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/runtime/dart_service_isolate.h"
+#include "flutter/runtime/snapshot_preload.h"
 #include "flutter/runtime/start_up.h"
 #include "lib/ftl/arraysize.h"
 #include "lib/ftl/build_config.h"
@@ -117,6 +120,28 @@ static ServiceIsolateHook g_service_isolate_hook = nullptr;
 static RegisterNativeServiceProtocolExtensionHook
     g_register_native_service_protocol_extensions_hook = nullptr;
 
+// Loaded-script state captured when a script is first loaded, keyed by script
+// URI. IsolateCreateCallback consults this before going back to the asset
+// bundle, which turns a secondary-isolate spawn into a pure from-memory
+// operation. Entries are never erased, so pointers into the map stay valid.
+struct IsolateSpawnTemplate {
+  IsolateSpawnTemplateKind kind;
+  std::vector<uint8_t> bytes;
+};
+
+// Guards g_spawn_templates; isolates can be spawned from any thread.
+std::mutex g_spawn_template_mutex;
+std::map<std::string, IsolateSpawnTemplate>* g_spawn_templates = nullptr;
+
+const IsolateSpawnTemplate* GetIsolateSpawnTemplate(
+    const std::string& script_uri) {
+  std::lock_guard<std::mutex> lock(g_spawn_template_mutex);
+  if (!g_spawn_templates)
+    return nullptr;
+  auto it = g_spawn_templates->find(script_uri);
+  return it == g_spawn_templates->end() ? nullptr : &it->second;
+}
+
 void IsolateShutdownCallback(void* callback_data) {
   if (tonic::DartStickyError::IsSet()) {
     tonic::DartApiScope api_scope;
@@ -180,6 +205,14 @@ Dart_Isolate ServiceIsolateCreateCallback(const char* script_uri,
   // No VM-service in release mode.
   return nullptr;
 #else  // FLUTTER_RUNTIME_MODE
+  const Settings& settings = Settings::Get();
+  if (!settings.enable_observatory && !settings.enable_diagnostic) {
+    // Nothing can ever connect to this isolate: Observatory is off and the
+    // diagnostic server is off. Skip booting it instead of keeping an idle
+    // isolate resident for the life of the process. The VM only asks once,
+    // during Dart_Initialize, so this cannot be deferred to first use.
+    return nullptr;
+  }
   tonic::DartState* dart_state = new tonic::DartState();
   Dart_Isolate isolate = Dart_CreateIsolate(
       script_uri, "main", g_default_isolate_snapshot_data,
@@ -194,8 +227,9 @@ Dart_Isolate ServiceIsolateCreateCallback(const char* script_uri,
     DartIO::InitForIsolate();
     DartUI::InitForIsolate();
     DartRuntimeHooks::Install(DartRuntimeHooks::SecondaryIsolate, script_uri);
-    const Settings& settings = Settings::Get();
     if (settings.enable_observatory) {
+      // The HTTP server runs on this isolate (and the VM's IO event handler
+      // threads), never on the UI or platform threads.
       std::string ip = settings.ipv6 ? "::1" : "127.0.0.1";
       const intptr_t port = settings.observatory_port;
       const bool disable_websocket_origin_check = false;
@@ -238,8 +272,8 @@ Dart_Isolate IsolateCreateCallback(const char* script_uri,
   // Are we running from a Dart source file?
   const bool running_from_source = StringEndsWith(entry_uri, ".dart");
 
-  std::vector<uint8_t> kernel_data;
-  std::vector<uint8_t> snapshot_data;
+  const std::vector<uint8_t>* kernel_data = nullptr;
+  const std::vector<uint8_t>* snapshot_data = nullptr;
   std::string entry_path;
   if (!IsRunningPrecompiledCode()) {
     // Check that the entry script URI starts with file://
@@ -249,14 +283,33 @@ Dart_Isolate IsolateCreateCallback(const char* script_uri,
     }
     // Entry script path (file:// is stripped).
     entry_path = std::string(script_uri + strlen(kFileUriPrefix));
-    if (!running_from_source) {
+
+    // A previous load of this script may have left a spawn template; clone
+    // from memory instead of going back to the bundle or the source.
+    const IsolateSpawnTemplate* spawn_template =
+        GetIsolateSpawnTemplate(entry_uri);
+    if (spawn_template) {
+      if (spawn_template->kind == IsolateSpawnTemplateKind::Kernel)
+        kernel_data = &spawn_template->bytes;
+      else
+        snapshot_data = &spawn_template->bytes;
+    } else if (!running_from_source) {
       // Attempt to copy the snapshot from the asset bundle.
       const std::string& bundle_path = entry_path;
       ftl::RefPtr<ZipAssetStore> zip_asset_store =
           ftl::MakeRefCounted<ZipAssetStore>(
-              GetUnzipperProviderForPath(std::move(bundle_path)));
-      zip_asset_store->GetAsBuffer(kKernelAssetKey, &kernel_data);
-      zip_asset_store->GetAsBuffer(kSnapshotAssetKey, &snapshot_data);
+              GetUnzipperProviderForPath(bundle_path), bundle_path);
+      std::vector<uint8_t> bundle_data;
+      if (zip_asset_store->GetAsBuffer(kKernelAssetKey, &bundle_data)) {
+        kernel_data = CacheIsolateSpawnTemplate(
+            entry_uri, IsolateSpawnTemplateKind::Kernel,
+            std::move(bundle_data));
+      } else if (zip_asset_store->GetAsBuffer(kSnapshotAssetKey,
+                                              &bundle_data)) {
+        snapshot_data = CacheIsolateSpawnTemplate(
+            entry_uri, IsolateSpawnTemplateKind::ScriptSnapshot,
+            std::move(bundle_data));
+      }
     }
   }
 
@@ -282,14 +335,14 @@ Dart_Isolate IsolateCreateCallback(const char* script_uri,
     dart_state->class_library().add_provider("ui",
                                              std::move(ui_class_provider));
 
-    if (!kernel_data.empty()) {
+    if (kernel_data) {
       // We are running kernel code.
-      FTL_CHECK(!LogIfError(Dart_LoadKernel(Dart_ReadKernelBinary(kernel_data.data(),
-                                                                  kernel_data.size()))));
-    } else if (!snapshot_data.empty()) {
+      FTL_CHECK(!LogIfError(Dart_LoadKernel(Dart_ReadKernelBinary(
+          kernel_data->data(), kernel_data->size()))));
+    } else if (snapshot_data) {
       // We are running from a script snapshot.
-      FTL_CHECK(!LogIfError(Dart_LoadScriptFromSnapshot(snapshot_data.data(),
-                                                        snapshot_data.size())));
+      FTL_CHECK(!LogIfError(Dart_LoadScriptFromSnapshot(
+          snapshot_data->data(), snapshot_data->size())));
     } else if (running_from_source) {
       // We are running from source.
       // Forward the .packages configuration from the parent isolate to the
@@ -351,6 +404,22 @@ bool IsRunningPrecompiledCode() {
   return Dart_IsPrecompiledRuntime();
 }
 
+const std::vector<uint8_t>* CacheIsolateSpawnTemplate(
+    const std::string& script_uri,
+    IsolateSpawnTemplateKind kind,
+    std::vector<uint8_t> bytes) {
+  std::lock_guard<std::mutex> lock(g_spawn_template_mutex);
+  if (!g_spawn_templates)
+    g_spawn_templates = new std::map<std::string, IsolateSpawnTemplate>();
+  auto it = g_spawn_templates->find(script_uri);
+  if (it == g_spawn_templates->end()) {
+    it = g_spawn_templates
+             ->emplace(script_uri, IsolateSpawnTemplate{kind, std::move(bytes)})
+             .first;
+  }
+  return &it->second.bytes;
+}
+
 EmbedderTracingCallbacks* g_tracing_callbacks = nullptr;
 
 EmbedderTracingCallbacks::EmbedderTracingCallbacks(
@@ -426,6 +495,14 @@ void InitDartVM(const uint8_t* vm_snapshot_data,
   g_default_isolate_snapshot_instructions =
       default_isolate_snapshot_instructions;
 
+  if (IsRunningPrecompiledCode()) {
+    // Fault the AOT instruction regions in ahead of the VM's first execution
+    // of them; cold starts otherwise stall on first-touch page faults
+    // scattered across startup.
+    PreloadSnapshotRegions(vm_snapshot_instructions,
+                           default_isolate_snapshot_instructions);
+  }
+
   const Settings& settings = Settings::Get();
 
   {
@@ -529,6 +606,8 @@ void InitDartVM(const uint8_t* vm_snapshot_data,
       FTL_LOG(FATAL) << "Error while initializing the Dart VM: " << init_error;
     free(init_error);
 
+    blink::RecordStartupMilestone(blink::kStartupMilestoneVmInitialized);
+
     // Send the earliest available timestamp in the application lifecycle to
     // timeline. The difference between this timestamp and the time we render
     // the very first frame gives us a good idea about Flutter's startup time.
@@ -11,6 +11,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace blink {
 
@@ -52,6 +53,22 @@ void SetServiceIsolateHook(ServiceIsolateHook hook);
 void SetRegisterNativeServiceProtocolExtensionHook(
     RegisterNativeServiceProtocolExtensionHook hook);
 
+// The kind of loaded-script bytes held by an isolate spawn template.
+enum class IsolateSpawnTemplateKind {
+  Kernel,
+  ScriptSnapshot,
+};
+
+// Caches the loaded-state bytes for |script_uri| so that subsequent isolates
+// spawned for the same script are created from memory instead of re-reading
+// the asset bundle or re-parsing source. The first template registered for a
+// given URI wins. Returns the stored bytes, which stay valid for the life of
+// the process. Callable from any thread.
+const std::vector<uint8_t>* CacheIsolateSpawnTemplate(
+    const std::string& script_uri,
+    IsolateSpawnTemplateKind kind,
+    std::vector<uint8_t> bytes);
+
 }  // namespace blink
 
 #endif  // FLUTTER_RUNTIME_DART_INIT_H_
@@ -0,0 +1,194 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/discardable_memory.h"
+
+#include "lib/ftl/build_config.h"
+#include "lib/ftl/logging.h"
+
+#if defined(OS_ANDROID)
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace blink {
+namespace {
+
+// The ashmem ioctl interface is stable kernel ABI but its header is not part
+// of the NDK sysroot, so the constants are defined here the same way the
+// kernel's uapi header does.
+struct ashmem_pin {
+  uint32_t offset;
+  uint32_t len;
+};
+
+#define __ASHMEMIOC 0x77
+#define ASHMEM_SET_NAME _IOW(__ASHMEMIOC, 1, char[256])
+#define ASHMEM_SET_SIZE _IOW(__ASHMEMIOC, 3, size_t)
+#define ASHMEM_PIN _IOW(__ASHMEMIOC, 7, struct ashmem_pin)
+#define ASHMEM_UNPIN _IOW(__ASHMEMIOC, 8, struct ashmem_pin)
+#define ASHMEM_NOT_PURGED 0
+
+const char kAshmemDevice[] = "/dev/ashmem";
+const char kAllocationName[] = "flutter-discardable";
+
+// An ashmem region is created pinned; unpinning it lets the kernel's shrinker
+// reclaim the pages under pressure, and repinning reports whether it did.
+class AshmemDiscardableMemory : public WebDiscardableMemory {
+ public:
+  static AshmemDiscardableMemory* Create(size_t bytes) {
+    int fd = open(kAshmemDevice, O_RDWR);
+    if (fd < 0)
+      return nullptr;
+
+    char name[256] = {};
+    strncpy(name, kAllocationName, sizeof(name) - 1);
+    if (ioctl(fd, ASHMEM_SET_NAME, name) < 0 ||
+        ioctl(fd, ASHMEM_SET_SIZE, bytes) < 0) {
+      close(fd);
+      return nullptr;
+    }
+
+    void* address =
+        mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      close(fd);
+      return nullptr;
+    }
+
+    return new AshmemDiscardableMemory(fd, address, bytes);
+  }
+
+  ~AshmemDiscardableMemory() override {
+    FTL_DCHECK(!locked_);
+    munmap(address_, bytes_);
+    close(fd_);
+  }
+
+  bool lock() override {
+    FTL_DCHECK(!locked_);
+    locked_ = true;
+    // Offset and length of zero pin the whole region.
+    struct ashmem_pin pin = {0, 0};
+    return ioctl(fd_, ASHMEM_PIN, &pin) == ASHMEM_NOT_PURGED;
+  }
+
+  void* data() override {
+    FTL_DCHECK(locked_);
+    return address_;
+  }
+
+  void unlock() override {
+    FTL_DCHECK(locked_);
+    locked_ = false;
+    struct ashmem_pin pin = {0, 0};
+    ioctl(fd_, ASHMEM_UNPIN, &pin);
+  }
+
+ private:
+  AshmemDiscardableMemory(int fd, void* address, size_t bytes)
+      : fd_(fd), address_(address), bytes_(bytes), locked_(true) {}
+
+  const int fd_;
+  void* const address_;
+  const size_t bytes_;
+  bool locked_;
+};
+
+}  // namespace
+
+WebDiscardableMemory* AllocateAndLockDiscardableMemory(size_t bytes) {
+  return AshmemDiscardableMemory::Create(bytes);
+}
+
+}  // namespace blink
+
+#elif defined(OS_MACOSX) || defined(OS_IOS)
+
+#include <mach/mach.h>
+
+namespace blink {
+namespace {
+
+// Purgeable mach VM: marking the region volatile on unlock lets the kernel
+// reclaim it under pressure, and marking it nonvolatile again reports through
+// VM_PURGABLE_EMPTY whether the contents were thrown away.
+class MachDiscardableMemory : public WebDiscardableMemory {
+ public:
+  static MachDiscardableMemory* Create(size_t bytes) {
+    vm_address_t address = 0;
+    kern_return_t result =
+        vm_allocate(mach_task_self(), &address, bytes,
+                    VM_FLAGS_PURGABLE | VM_FLAGS_ANYWHERE);
+    if (result != KERN_SUCCESS)
+      return nullptr;
+    return new MachDiscardableMemory(address, bytes);
+  }
+
+  ~MachDiscardableMemory() override {
+    FTL_DCHECK(!locked_);
+    vm_deallocate(mach_task_self(), address_, bytes_);
+  }
+
+  bool lock() override {
+    FTL_DCHECK(!locked_);
+    locked_ = true;
+    int state = VM_PURGABLE_NONVOLATILE;
+    kern_return_t result = vm_purgable_control(
+        mach_task_self(), address_, VM_PURGABLE_SET_STATE, &state);
+    // |state| now holds the previous state; EMPTY means the kernel reclaimed
+    // the pages while the region was volatile.
+    return result == KERN_SUCCESS && !(state & VM_PURGABLE_EMPTY);
+  }
+
+  void* data() override {
+    FTL_DCHECK(locked_);
+    return reinterpret_cast<void*>(address_);
+  }
+
+  void unlock() override {
+    FTL_DCHECK(locked_);
+    locked_ = false;
+    int state = VM_PURGABLE_VOLATILE | VM_VOLATILE_GROUP_DEFAULT;
+    vm_purgable_control(mach_task_self(), address_, VM_PURGABLE_SET_STATE,
+                        &state);
+  }
+
+ private:
+  MachDiscardableMemory(vm_address_t address, size_t bytes)
+      : address_(address), bytes_(bytes), locked_(true) {}
+
+  const vm_address_t address_;
+  const size_t bytes_;
+  bool locked_;
+};
+
+}  // namespace
+
+WebDiscardableMemory* AllocateAndLockDiscardableMemory(size_t bytes) {
+  return MachDiscardableMemory::Create(bytes);
+}
+
+}  // namespace blink
+
+#else
+
+namespace blink {
+
+// madvise(MADV_FREE) would let the kernel reclaim unlocked pages here too,
+// but it gives the caller no way to find out whether it did: reclaimed pages
+// read back as zeroes, which WebDiscardableMemory clients would treat as
+// valid decoded data. Without a facility that reports reclamation, callers
+// are better served by ordinary heap memory.
+WebDiscardableMemory* AllocateAndLockDiscardableMemory(size_t bytes) {
+  return nullptr;
+}
+
+}  // namespace blink
+
+#endif
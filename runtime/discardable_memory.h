@@ -0,0 +1,26 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_DISCARDABLE_MEMORY_H_
+#define FLUTTER_RUNTIME_DISCARDABLE_MEMORY_H_
+
+#include <stddef.h>
+
+#include "flutter/sky/engine/public/platform/WebDiscardableMemory.h"
+
+namespace blink {
+
+// Allocates memory the operating system may reclaim while the allocation is
+// unlocked: ashmem on Android, purgeable mach VM on Darwin. Both backings
+// report on lock() whether the contents survived, which is what lets callers
+// re-decode instead of crashing on reclaimed data. Platforms without a kernel
+// facility that can report reclamation return null and callers keep using
+// ordinary heap memory.
+//
+// The allocation is returned in a locked state. Returns null on failure.
+WebDiscardableMemory* AllocateAndLockDiscardableMemory(size_t bytes);
+
+}  // namespace blink
+
+#endif  // FLUTTER_RUNTIME_DISCARDABLE_MEMORY_H_
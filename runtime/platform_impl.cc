@@ -4,12 +4,19 @@
 
 #include "flutter/runtime/platform_impl.h"
 
+#include "flutter/runtime/discardable_memory.h"
+
 namespace blink {
 
 PlatformImpl::PlatformImpl() {}
 
 PlatformImpl::~PlatformImpl() {}
 
+WebDiscardableMemory* PlatformImpl::allocateAndLockDiscardableMemory(
+    size_t bytes) {
+  return AllocateAndLockDiscardableMemory(bytes);
+}
+
 std::string PlatformImpl::defaultLocale() {
   return "en-US";
 }
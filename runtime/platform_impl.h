@@ -16,6 +16,7 @@ class PlatformImpl : public Platform {
   ~PlatformImpl() override;
 
   // blink::Platform methods:
+  WebDiscardableMemory* allocateAndLockDiscardableMemory(size_t bytes) override;
   std::string defaultLocale() override;
 
  private:
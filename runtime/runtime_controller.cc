@@ -4,6 +4,8 @@
 
 #include "flutter/runtime/runtime_controller.h"
 
+#include "flutter/common/settings.h"
+#include "flutter/common/threads.h"
 #include "flutter/glue/trace_event.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -22,7 +24,11 @@ std::unique_ptr<RuntimeController> RuntimeController::Create(
 }
 
 RuntimeController::RuntimeController(RuntimeDelegate* client)
-    : client_(client) {}
+    : client_(client),
+      metrics_settle_window_(ftl::TimeDelta::FromMilliseconds(
+          Settings::Get().metrics_settle_window_ms)),
+      speculative_rotation_layout_(Settings::Get().speculative_rotation_layout),
+      weak_factory_(this) {}
 
 RuntimeController::~RuntimeController() {}
 
@@ -51,10 +57,89 @@ void RuntimeController::CreateDartController(
 }
 
 void RuntimeController::SetViewportMetrics(const ViewportMetrics& metrics) {
+  if (metrics_settle_window_ == ftl::TimeDelta::Zero()) {
+    DispatchViewportMetrics(metrics);
+    return;
+  }
+
+  const ftl::TimePoint now = ftl::TimePoint::Now();
+  const bool in_burst = now - last_metrics_change_time_ < metrics_settle_window_;
+  last_metrics_change_time_ = now;
+
+  if (!in_burst) {
+    // An isolated change pays no added latency. Its predecessor is what the
+    // rotation predictor works from should a burst follow.
+    burst_base_metrics_ = viewport_metrics_;
+    has_pending_metrics_ = false;
+    speculated_this_burst_ = false;
+    DispatchViewportMetrics(metrics);
+    return;
+  }
+
+  // Mid-burst: hold the intermediate metrics and deliver only the last of
+  // them once the burst settles, so each intermediate size of a rotation
+  // does not trigger a full relayout.
+  pending_metrics_ = metrics;
+  has_pending_metrics_ = true;
+
+  if (speculative_rotation_layout_ && !speculated_this_burst_ &&
+      burst_base_metrics_.physical_width !=
+          burst_base_metrics_.physical_height &&
+      (metrics.physical_width != burst_base_metrics_.physical_width ||
+       metrics.physical_height != burst_base_metrics_.physical_height)) {
+    // A size burst is almost always a rotation; lay out at the predicted
+    // final size — the pre-burst dimensions swapped — while the transition
+    // animation plays. If the prediction holds, the settled dispatch is a
+    // no-op and the relayout has already happened off the critical path.
+    ViewportMetrics predicted = metrics;
+    predicted.physical_width = burst_base_metrics_.physical_height;
+    predicted.physical_height = burst_base_metrics_.physical_width;
+    speculated_this_burst_ = true;
+    DispatchViewportMetrics(predicted);
+  }
+
+  ArmMetricsSettleTimer();
+}
+
+void RuntimeController::DispatchViewportMetrics(const ViewportMetrics& metrics) {
   viewport_metrics_ = metrics;
   GetWindow()->UpdateWindowMetrics(viewport_metrics_);
 }
 
+void RuntimeController::ArmMetricsSettleTimer() {
+  const uint64_t generation = ++metrics_timer_generation_;
+  Threads::UI()->PostDelayedTask(
+      [ weak = weak_factory_.GetWeakPtr(), generation ]() {
+        if (weak && weak->metrics_timer_generation_ == generation) {
+          weak->OnMetricsSettled();
+        }
+      },
+      metrics_settle_window_);
+}
+
+void RuntimeController::OnMetricsSettled() {
+  if (!has_pending_metrics_) {
+    return;
+  }
+  has_pending_metrics_ = false;
+  speculated_this_burst_ = false;
+  const ViewportMetrics& settled = pending_metrics_;
+  if (settled.device_pixel_ratio == viewport_metrics_.device_pixel_ratio &&
+      settled.physical_width == viewport_metrics_.physical_width &&
+      settled.physical_height == viewport_metrics_.physical_height &&
+      settled.physical_padding_top == viewport_metrics_.physical_padding_top &&
+      settled.physical_padding_right ==
+          viewport_metrics_.physical_padding_right &&
+      settled.physical_padding_bottom ==
+          viewport_metrics_.physical_padding_bottom &&
+      settled.physical_padding_left ==
+          viewport_metrics_.physical_padding_left) {
+    // The speculation already matches the settled state.
+    return;
+  }
+  DispatchViewportMetrics(settled);
+}
+
 void RuntimeController::SetLocale(const std::string& language_code,
                                   const std::string& country_code) {
   if (language_code_ == language_code && country_code_ == country_code)
@@ -76,6 +161,23 @@ void RuntimeController::BeginFrame(ftl::TimePoint frame_time) {
   GetWindow()->BeginFrame(frame_time);
 }
 
+void RuntimeController::ReportFrameTimings(std::vector<int64_t> timings) {
+  GetWindow()->ReportFrameTimings(std::move(timings));
+}
+
+void RuntimeController::NotifyIdle(ftl::TimeDelta budget) {
+  if (!dart_controller_) {
+    return;
+  }
+  UIDartState* dart_state = dart_controller_->dart_state();
+  if (!dart_state) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "RuntimeController::NotifyIdle");
+  DartState::Scope scope(dart_state);
+  Dart_NotifyIdle(Dart_TimelineGetMicros() + budget.ToMicroseconds());
+}
+
 void RuntimeController::DispatchPlatformMessage(
     ftl::RefPtr<PlatformMessage> message) {
   TRACE_EVENT0("flutter", "RuntimeController::DispatchPlatformMessage");
@@ -12,6 +12,9 @@
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/lib/ui/window/window.h"
 #include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
 
 namespace blink {
 class DartController;
@@ -38,6 +41,17 @@ class RuntimeController : public WindowClient, public IsolateClient {
 
   void BeginFrame(ftl::TimePoint frame_time);
 
+  // Offers the VM a window of |budget| in which to do garbage collection
+  // work. The deadline bounds what the VM will attempt: the short windows
+  // left inside an animating frame only admit minor collections, which is
+  // what keeps major pauses from landing mid-frame. Called on the UI
+  // thread.
+  void NotifyIdle(ftl::TimeDelta budget);
+
+  // Forwards a batch of presented-frame timing records to the framework.
+  // Called on the UI thread.
+  void ReportFrameTimings(std::vector<int64_t> timings);
+
   void DispatchPlatformMessage(ftl::RefPtr<PlatformMessage> message);
   void DispatchPointerDataPacket(const PointerDataPacket& packet);
   void DispatchSemanticsAction(int32_t id, SemanticsAction action);
@@ -52,6 +66,16 @@ class RuntimeController : public WindowClient, public IsolateClient {
 
   Window* GetWindow();
 
+  // Delivers |metrics| to Dart and remembers it as the settled state.
+  void DispatchViewportMetrics(const ViewportMetrics& metrics);
+
+  // Posts the timer that declares the current metrics burst settled if no
+  // further change arrives within the settle window. Each change re-arms it;
+  // stale timers recognize themselves by generation and do nothing.
+  void ArmMetricsSettleTimer();
+
+  void OnMetricsSettled();
+
   void ScheduleFrame() override;
   void Render(Scene* scene) override;
   void UpdateSemantics(SemanticsUpdate* update) override;
@@ -66,6 +90,18 @@ class RuntimeController : public WindowClient, public IsolateClient {
   bool semantics_enabled_ = false;
   std::unique_ptr<DartController> dart_controller_;
 
+  // Metrics burst coalescing (see Settings::metrics_settle_window_ms).
+  ftl::TimeDelta metrics_settle_window_;
+  bool speculative_rotation_layout_ = false;
+  bool has_pending_metrics_ = false;
+  bool speculated_this_burst_ = false;
+  ViewportMetrics pending_metrics_;
+  ViewportMetrics burst_base_metrics_;
+  ftl::TimePoint last_metrics_change_time_;
+  uint64_t metrics_timer_generation_ = 0;
+
+  ftl::WeakPtrFactory<RuntimeController> weak_factory_;
+
   FTL_DISALLOW_COPY_AND_ASSIGN(RuntimeController);
 };
 
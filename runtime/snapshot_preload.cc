@@ -0,0 +1,127 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_preload.h"
+
+#include "lib/ftl/build_config.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "flutter/fml/thread_pool.h"
+#include "flutter/glue/trace_event.h"
+#include "lib/ftl/logging.h"
+
+namespace blink {
+namespace {
+
+// Upper bound on the pinned prefix of each instruction region: enough to
+// cover the code exercised during startup without noticeably raising
+// resident memory. mlock failures (RLIMIT_MEMLOCK) are harmless and only
+// forfeit the eviction guarantee, not the read-ahead.
+const size_t kMaxLockedBytes = 2 * 1024 * 1024;
+
+// Recovers from /proc/self/maps the extent of the mapping containing
+// |address|. The snapshot symbols carry no lengths, so this is the only
+// handle we have on how much there is to preload.
+bool FindMappingContaining(const void* address,
+                           uintptr_t* start,
+                           uintptr_t* end) {
+  FILE* maps = fopen("/proc/self/maps", "r");
+  if (maps == nullptr) {
+    return false;
+  }
+  const uintptr_t needle = reinterpret_cast<uintptr_t>(address);
+  bool found = false;
+  char line[512];
+  while (fgets(line, sizeof(line), maps) != nullptr) {
+    uintptr_t mapping_start = 0;
+    uintptr_t mapping_end = 0;
+    if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &mapping_start, &mapping_end) !=
+        2) {
+      continue;
+    }
+    if (needle >= mapping_start && needle < mapping_end) {
+      *start = mapping_start;
+      *end = mapping_end;
+      found = true;
+      break;
+    }
+  }
+  fclose(maps);
+  return found;
+}
+
+// Reads one byte per page so the faults are taken here, on a worker, rather
+// than by the VM on its first execution of the code.
+void TouchPages(uintptr_t start, size_t length) {
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  volatile const uint8_t* pages =
+      reinterpret_cast<volatile const uint8_t*>(start);
+  for (size_t offset = 0; offset < length; offset += page_size) {
+    (void)pages[offset];
+  }
+}
+
+void PreloadRegion(const char* trace_name, const uint8_t* region, bool pin) {
+  if (region == nullptr) {
+    return;
+  }
+  uintptr_t mapping_start = 0;
+  uintptr_t mapping_end = 0;
+  if (!FindMappingContaining(region, &mapping_start, &mapping_end)) {
+    return;
+  }
+
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  // The symbol rarely sits at the head of its mapping; advise from the
+  // containing page through the end of the mapping.
+  const uintptr_t aligned_start =
+      reinterpret_cast<uintptr_t>(region) & ~(page_size - 1);
+  const size_t length = mapping_end - aligned_start;
+
+  void* aligned = reinterpret_cast<void*>(aligned_start);
+  if (madvise(aligned, length, MADV_WILLNEED) != 0) {
+    FTL_DLOG(INFO) << "Could not advise read-ahead of the " << trace_name
+                   << " snapshot region.";
+  }
+  if (pin && mlock(aligned, std::min(kMaxLockedBytes, length)) != 0) {
+    FTL_DLOG(INFO) << "Could not pin the " << trace_name
+                   << " snapshot region prefix.";
+  }
+
+  fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+      [aligned_start, length]() {
+        TRACE_EVENT0("flutter", "SnapshotRegionReadAhead");
+        TouchPages(aligned_start, length);
+      });
+}
+
+}  // namespace
+
+void PreloadSnapshotRegions(const uint8_t* vm_instructions,
+                            const uint8_t* isolate_instructions) {
+  TRACE_EVENT0("flutter", "PreloadSnapshotRegions");
+  PreloadRegion("VM instruction", vm_instructions, true /* pin */);
+  PreloadRegion("isolate instruction", isolate_instructions, true /* pin */);
+}
+
+}  // namespace blink
+
+#else  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+namespace blink {
+
+void PreloadSnapshotRegions(const uint8_t* vm_instructions,
+                            const uint8_t* isolate_instructions) {}
+
+}  // namespace blink
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
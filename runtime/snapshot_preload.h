@@ -0,0 +1,29 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_PRELOAD_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_PRELOAD_H_
+
+#include <stdint.h>
+
+namespace blink {
+
+// Warms the memory behind a precompiled snapshot region before the VM's
+// first touch of it. The embedder hands us raw symbol addresses with no
+// lengths, so the extent of each region is recovered from the mapping that
+// contains it (/proc/self/maps). For each region this advises the kernel to
+// read it ahead (MADV_WILLNEED), pins a bounded prefix of the instruction
+// region so the hot entry paths cannot be evicted mid-startup, and touches
+// the remaining pages sequentially on a shared worker so faults are taken
+// off the critical path. No-op on platforms without the required
+// introspection.
+//
+// |vm_instructions| and |isolate_instructions| may be null (e.g. when
+// running from a script snapshot); null regions are skipped.
+void PreloadSnapshotRegions(const uint8_t* vm_instructions,
+                            const uint8_t* isolate_instructions);
+
+}  // namespace blink
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_PRELOAD_H_
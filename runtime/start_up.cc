@@ -4,8 +4,76 @@
 
 #include "flutter/runtime/start_up.h"
 
+#include <stdio.h>
+
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "dart/runtime/include/dart_tools_api.h"
+
 namespace blink {
 
 int64_t engine_main_enter_ts = 0;
 
+const char kStartupMilestoneVmInitialized[] = "vm_initialized";
+const char kStartupMilestoneIsolateCreated[] = "isolate_created";
+const char kStartupMilestoneRunBundleComplete[] = "run_bundle_complete";
+const char kStartupMilestoneFirstBeginFrame[] = "first_begin_frame";
+const char kStartupMilestoneFirstFramePresented[] = "first_frame_presented";
+
+namespace {
+
+std::mutex& MilestonesMutex() {
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+std::vector<std::pair<std::string, int64_t>>& Milestones() {
+  static auto* milestones = new std::vector<std::pair<std::string, int64_t>>();
+  return *milestones;
+}
+
+}  // namespace
+
+void RecordStartupMilestone(const char* name) {
+  // Taken before the clock read so a racing second caller cannot record an
+  // earlier timestamp under the same name and lose.
+  std::lock_guard<std::mutex> lock(MilestonesMutex());
+  for (const auto& milestone : Milestones()) {
+    if (milestone.first == name)
+      return;
+  }
+  Milestones().emplace_back(name, Dart_TimelineGetMicros());
+}
+
+std::string StartupMilestonesAsJSON() {
+  std::stringstream stream;
+  stream << "{";
+  bool first = true;
+  if (engine_main_enter_ts != 0) {
+    stream << "\"engine_main_enter\":" << engine_main_enter_ts;
+    first = false;
+  }
+  std::lock_guard<std::mutex> lock(MilestonesMutex());
+  for (const auto& milestone : Milestones()) {
+    if (!first)
+      stream << ",";
+    stream << "\"" << milestone.first << "\":" << milestone.second;
+    first = false;
+  }
+  stream << "}";
+  return stream.str();
+}
+
+bool WriteStartupMilestones(const std::string& path) {
+  FILE* file = fopen(path.c_str(), "w");
+  if (file == nullptr)
+    return false;
+  const std::string json = StartupMilestonesAsJSON();
+  const bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return fclose(file) == 0 && written;
+}
+
 }  // namespace blink
@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 namespace blink {
 
 // The earliest available timestamp in the application's lifecycle. The
@@ -19,6 +21,29 @@ namespace blink {
 // user code prior to initializing Flutter.
 extern int64_t engine_main_enter_ts;
 
+// Well-known startup milestones, recorded where each event first happens on
+// the startup path. See RecordStartupMilestone.
+extern const char kStartupMilestoneVmInitialized[];
+extern const char kStartupMilestoneIsolateCreated[];
+extern const char kStartupMilestoneRunBundleComplete[];
+extern const char kStartupMilestoneFirstBeginFrame[];
+extern const char kStartupMilestoneFirstFramePresented[];
+
+// Records |name| against the Dart timeline clock (the same clock as
+// engine_main_enter_ts). Only the first recording of a given name sticks;
+// later calls are ignored. Safe to call from any thread.
+void RecordStartupMilestone(const char* name);
+
+// The recorded milestones as a JSON object of microsecond timestamps, e.g.
+//   {"engine_main_enter": 123, "vm_initialized": 456, ...}
+// engine_main_enter is included when the embedder recorded it, so consumers
+// can compute each phase as an offset from process entry.
+std::string StartupMilestonesAsJSON();
+
+// Writes StartupMilestonesAsJSON to |path|. Returns false if the file could
+// not be written.
+bool WriteStartupMilestones(const std::string& path);
+
 }  // namespace blink
 
 #endif  // FLUTTER_RUNTIME_START_UP_H_
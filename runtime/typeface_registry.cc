@@ -0,0 +1,99 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/typeface_registry.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/ports/SkFontMgr.h"
+
+namespace blink {
+
+namespace {
+
+// 64-bit FNV-1a over the content.
+uint64_t HashBytes(const uint8_t* bytes, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+TypefaceRegistry& TypefaceRegistry::Shared() {
+  static TypefaceRegistry* registry = new TypefaceRegistry();
+  return *registry;
+}
+
+TypefaceRegistry::TypefaceRegistry() {}
+
+TypefaceRegistry::~TypefaceRegistry() {}
+
+TypefaceRegistry::Entry* TypefaceRegistry::GetEntryLocked(const uint8_t* bytes,
+                                                          size_t size) {
+  std::vector<Entry>& bucket = entries_[HashBytes(bytes, size)];
+  for (Entry& entry : bucket) {
+    if (entry.data->size() == size &&
+        memcmp(entry.data->data(), bytes, size) == 0) {
+      return &entry;
+    }
+  }
+  Entry entry;
+  entry.data = SkData::MakeWithCopy(bytes, size);
+  bucket.push_back(std::move(entry));
+  return &bucket.back();
+}
+
+void TypefaceRegistry::SweepUnreferencedLocked() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    std::vector<Entry>& bucket = it->second;
+    bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                [](const Entry& entry) {
+                                  return entry.data->unique() &&
+                                         (!entry.typeface ||
+                                          entry.typeface->unique());
+                                }),
+                 bucket.end());
+    if (bucket.empty()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+sk_sp<SkData> TypefaceRegistry::InternData(const uint8_t* bytes, size_t size) {
+  if (bytes == nullptr || size == 0)
+    return nullptr;
+  std::lock_guard<std::mutex> lock(mutex_);
+  SweepUnreferencedLocked();
+  return GetEntryLocked(bytes, size)->data;
+}
+
+sk_sp<SkTypeface> TypefaceRegistry::InternTypeface(
+    const uint8_t* bytes,
+    size_t size,
+    sk_sp<SkData>* interned_data) {
+  if (bytes == nullptr || size == 0)
+    return nullptr;
+  std::lock_guard<std::mutex> lock(mutex_);
+  SweepUnreferencedLocked();
+  Entry* entry = GetEntryLocked(bytes, size);
+  if (!entry->typeface_attempted) {
+    entry->typeface_attempted = true;
+    sk_sp<SkFontMgr> font_mgr(SkFontMgr::RefDefault());
+    entry->typeface = sk_sp<SkTypeface>(
+        font_mgr->createFromStream(new SkMemoryStream(entry->data)));
+  }
+  if (interned_data != nullptr)
+    *interned_data = entry->data;
+  return entry->typeface;
+}
+
+}  // namespace blink
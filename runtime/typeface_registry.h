@@ -0,0 +1,78 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_TYPEFACE_REGISTRY_H_
+#define FLUTTER_RUNTIME_TYPEFACE_REGISTRY_H_
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace blink {
+
+// Process-wide interning registry for font data and the typefaces created
+// from it, keyed by content hash. Each engine instance in a multi-engine
+// process loads its fonts through its own AssetFontSelector; without
+// interning, three instances of the same app hold three copies of every
+// font asset and three SkTypefaces per font. The registry hands every
+// caller the same SkData and SkTypeface for identical bytes, so duplicate
+// font memory collapses to refcounts.
+//
+// Entries are retained only while someone outside the registry holds a
+// reference: each interning call sweeps entries whose data and typeface
+// are referenced by the registry alone, so tearing down the last engine
+// releases the font memory.
+//
+// All methods are safe to call from any thread.
+class TypefaceRegistry {
+ public:
+  static TypefaceRegistry& Shared();
+
+  // Returns the interned immutable data for |bytes|, copying them in only
+  // when this content has not been seen before.
+  sk_sp<SkData> InternData(const uint8_t* bytes, size_t size);
+
+  // Returns the process-wide typeface for the font at |bytes|, creating it
+  // on first use. Optionally returns the interned backing data through
+  // |interned_data|. Returns null if Skia cannot parse the font.
+  sk_sp<SkTypeface> InternTypeface(const uint8_t* bytes,
+                                   size_t size,
+                                   sk_sp<SkData>* interned_data);
+
+ private:
+  struct Entry {
+    sk_sp<SkData> data;
+    // Created lazily by InternTypeface; null for entries interned as plain
+    // data or for bytes Skia rejected.
+    sk_sp<SkTypeface> typeface;
+    bool typeface_attempted = false;
+  };
+
+  TypefaceRegistry();
+
+  ~TypefaceRegistry();
+
+  // Returns the entry for the content, creating it if needed. Requires
+  // |mutex_| to be held.
+  Entry* GetEntryLocked(const uint8_t* bytes, size_t size);
+
+  // Drops entries no longer referenced outside the registry. Requires
+  // |mutex_| to be held.
+  void SweepUnreferencedLocked();
+
+  std::mutex mutex_;
+  // Content hash to entries; the vector resolves hash collisions by byte
+  // comparison.
+  std::unordered_map<uint64_t, std::vector<Entry>> entries_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(TypefaceRegistry);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_RUNTIME_TYPEFACE_REGISTRY_H_
@@ -4,12 +4,48 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
+#include "flutter/common/performance_profile.h"
 #include "flutter/common/threads.h"
+#include "flutter/shell/common/event_replay.h"
+#include "flutter/shell/common/rasterizer_scheduler.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/runtime/start_up.h"
 #include "lib/ftl/time/stopwatch.h"
 
 namespace shell {
 
+namespace {
+
+// Margin subtracted from the computed phase offset so frame builds that run
+// slightly longer than estimated still make the deadline.
+const ftl::TimeDelta kDeadlineSchedulingSlack =
+    ftl::TimeDelta::FromMilliseconds(3);
+
+// Phase offsets smaller than this are not worth a delayed task.
+const ftl::TimeDelta kMinimumPhaseOffset = ftl::TimeDelta::FromMilliseconds(2);
+
+const ftl::TimeDelta kDefaultFrameInterval =
+    ftl::TimeDelta::FromMicroseconds(16667);
+
+// Idle windows shorter than this are not worth announcing to the VM; a
+// minor collection would not fit anyway.
+const ftl::TimeDelta kMinimumIdleWindow = ftl::TimeDelta::FromMilliseconds(2);
+
+// Held back from the end of each announced idle window so VM work that runs
+// right up to its deadline still finishes before the vsync.
+const ftl::TimeDelta kIdleWindowSlack = ftl::TimeDelta::FromMilliseconds(1);
+
+// Consecutive unchanged scenes before the idle detector halves the frame
+// rate, then quarters it. Roughly 100ms and 300ms on a 60Hz display, long
+// enough that animation pauses between effects do not trip it.
+const int kIdleHalfRateSceneCount = 6;
+const int kIdleQuarterRateSceneCount = 18;
+
+}  // namespace
+
 Animator::Animator(ftl::WeakPtr<Rasterizer> rasterizer,
                    VsyncWaiter* waiter,
                    Engine* engine)
@@ -17,17 +53,113 @@ Animator::Animator(ftl::WeakPtr<Rasterizer> rasterizer,
       waiter_(waiter),
       engine_(engine),
       layer_tree_pipeline_(ftl::MakeRefCounted<LayerTreePipeline>(3)),
-      pending_frame_semaphore_(1),
+      frame_interval_(kDefaultFrameInterval),
+      deadline_scheduling_enabled_(false),
+      frame_rate_divisor_(1),
+      adaptive_frame_rate_enabled_(false),
+      idle_divisor_(1),
+      unchanged_scene_count_(0),
+      vsync_count_(0),
       frame_number_(1),
       paused_(false),
-      weak_factory_(this) {}
+      first_begin_frame_recorded_(false),
+      pending_frame_semaphore_(1),
+      weak_factory_(this) {
+  // The observer runs on the UI thread, where this object is also
+  // destroyed, so |this| cannot dangle in the callback.
+  profile_observer_id_ = blink::PerformanceProfileObserverRegistry::AddObserver(
+      blink::Threads::UI(), [this](const blink::PerformanceProfile& profile) {
+        SetFrameRateDivisor(profile.frame_rate_divisor);
+      });
+
+  // Route the rasterizer's unchanged-scene reports from the GPU thread back
+  // here for the idle detector. The callback holds only a weak pointer, so
+  // it outliving this animator is harmless.
+  blink::Threads::Gpu()->PostTask(
+      [ rasterizer = rasterizer_, self = weak_factory_.GetWeakPtr() ]() {
+        if (!rasterizer.get()) {
+          return;
+        }
+        rasterizer->SetSceneChangeCallback([self](bool scene_unchanged) {
+          blink::Threads::UI()->PostTask([self, scene_unchanged]() {
+            if (self.get()) {
+              self->OnSceneReport(scene_unchanged);
+            }
+          });
+        });
+        // Presented-frame timing records travel the same GPU-to-UI route to
+        // the engine, which batches them for the framework's timing stream.
+        rasterizer->SetFrameTimingCallback(
+            [self](const Rasterizer::FrameTimingRecord& timing) {
+              blink::Threads::UI()->PostTask([self, timing]() {
+                if (self.get()) {
+                  self->engine_->ReportFrameTiming(timing);
+                }
+              });
+            });
+      });
+}
 
-Animator::~Animator() = default;
+Animator::~Animator() {
+  blink::PerformanceProfileObserverRegistry::RemoveObserver(
+      profile_observer_id_);
+}
 
 void Animator::Stop() {
   paused_ = true;
 }
 
+void Animator::SetPipelineMode(PipelineMode mode) {
+  switch (mode) {
+    case PipelineMode::LowLatency:
+      layer_tree_pipeline_->SetDepth(1);
+      break;
+    case PipelineMode::HighThroughput:
+      layer_tree_pipeline_->SetDepth(3);
+      break;
+  }
+}
+
+ftl::TimeDelta Animator::GetLastFrameLatency() const {
+  return layer_tree_pipeline_->GetLastConsumeLatency();
+}
+
+void Animator::SetDeadlineSchedulingEnabled(bool enabled) {
+  deadline_scheduling_enabled_ = enabled;
+}
+
+void Animator::SetFrameRateDivisor(int divisor) {
+  frame_rate_divisor_ = divisor < 1 ? 1 : divisor;
+}
+
+void Animator::SetAdaptiveFrameRateEnabled(bool enabled) {
+  adaptive_frame_rate_enabled_ = enabled;
+  if (!enabled) {
+    ResetIdleFrameRate();
+  }
+}
+
+void Animator::ResetIdleFrameRate() {
+  unchanged_scene_count_ = 0;
+  idle_divisor_ = 1;
+}
+
+void Animator::OnSceneReport(bool scene_unchanged) {
+  if (!adaptive_frame_rate_enabled_) {
+    return;
+  }
+  if (!scene_unchanged) {
+    ResetIdleFrameRate();
+    return;
+  }
+  unchanged_scene_count_++;
+  if (unchanged_scene_count_ >= kIdleQuarterRateSceneCount) {
+    idle_divisor_ = 4;
+  } else if (unchanged_scene_count_ >= kIdleHalfRateSceneCount) {
+    idle_divisor_ = 2;
+  }
+}
+
 void Animator::Start() {
   if (!paused_) {
     return;
@@ -37,11 +169,94 @@ void Animator::Start() {
   RequestFrame();
 }
 
+void Animator::SetFramePending(bool pending) {
+  if (fml::MessageLoop::IsInitializedForCurrentThread()) {
+    fml::MessageLoop::GetCurrent().SetFramePending(pending);
+  }
+}
+
 void Animator::BeginFrame(ftl::TimePoint frame_time) {
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending", frame_number_++);
 
+  // Hold back idle-lane tasks until this frame has been handed to the
+  // engine (or we decide to sit the vsync out).
+  SetFramePending(true);
+
+  // Every vsync source funnels through here, so this is the one place the
+  // event recorder sees them all.
+  EventRecorder::Shared().RecordVsync(frame_time);
+
+  if (!first_begin_frame_recorded_) {
+    first_begin_frame_recorded_ = true;
+    blink::RecordStartupMilestone(blink::kStartupMilestoneFirstBeginFrame);
+  }
+
   pending_frame_semaphore_.Signal();
 
+  // Keep a running estimate of the vsync interval; displays are not
+  // universally 60Hz. A waiter that has measured the display refresh
+  // directly is authoritative; otherwise fall back to the cadence of the
+  // callbacks, which folds in task scheduling jitter.
+  auto now = ftl::TimePoint::Now();
+  auto measured_interval = waiter_->GetDisplayRefreshInterval();
+  if (measured_interval > ftl::TimeDelta::Zero()) {
+    frame_interval_ = measured_interval;
+  } else if (last_vsync_time_ != ftl::TimePoint()) {
+    auto interval = now - last_vsync_time_;
+    if (interval > ftl::TimeDelta::Zero() &&
+        interval.ToMicroseconds() < kDefaultFrameInterval.ToMicroseconds() * 3) {
+      frame_interval_ = interval;
+    }
+  }
+  last_vsync_time_ = now;
+
+  // At a reduced frame rate — whether from the profile's divisor or the
+  // idle detector — sit out the vsyncs between produced frames but keep
+  // listening to them so the interval estimate stays current and the
+  // produced frames stay phase-aligned with the display.
+  vsync_count_++;
+  int divisor = std::max(frame_rate_divisor_, idle_divisor_);
+  if (divisor > 1 && (vsync_count_ % divisor) != 0) {
+    TRACE_EVENT_INSTANT0("flutter", "FrameRateDivisorSkip");
+    SetFramePending(false);
+    RequestFrame();
+    return;
+  }
+
+  if (deadline_scheduling_enabled_) {
+    // Start frame production as late as the build time estimate allows, so
+    // the frame picks up the freshest input while still making the next
+    // vsync.
+    int64_t phase_offset_micros = frame_interval_.ToMicroseconds() -
+                                  frame_build_estimate_.ToMicroseconds() -
+                                  kDeadlineSchedulingSlack.ToMicroseconds();
+    if (phase_offset_micros > frame_interval_.ToMicroseconds() / 2) {
+      phase_offset_micros = frame_interval_.ToMicroseconds() / 2;
+    }
+    ftl::TimeDelta phase_offset =
+        ftl::TimeDelta::FromMicroseconds(phase_offset_micros);
+    if (phase_offset >= kMinimumPhaseOffset) {
+      TRACE_EVENT_INSTANT0("flutter", "DeadlineSchedulerDefer");
+      // The frame stays pending across the deferral. If the animator dies
+      // before the deferred task runs, clear the flag here — nothing else
+      // will.
+      blink::Threads::UI()->PostDelayedTask(
+          [ self = weak_factory_.GetWeakPtr(), frame_time ]() {
+            if (self.get()) {
+              self->ProduceFrame(frame_time);
+            } else {
+              SetFramePending(false);
+            }
+          },
+          phase_offset);
+      return;
+    }
+  }
+
+  ProduceFrame(frame_time);
+}
+
+void Animator::ProduceFrame(ftl::TimePoint frame_time) {
   if (!producer_continuation_) {
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animation::Render. Simply reuse that
@@ -53,6 +268,7 @@ void Animator::BeginFrame(ftl::TimePoint frame_time) {
       // full because the consumer is being too slow. Try again at the next
       // frame interval.
       TRACE_EVENT_INSTANT0("flutter", "ConsumerSlowDefer");
+      SetFramePending(false);
       RequestFrame();
       return;
     }
@@ -64,15 +280,30 @@ void Animator::BeginFrame(ftl::TimePoint frame_time) {
 
   // TODO(abarth): We should use |frame_time| instead, but the frame time we get
   // on Android appears to be unstable.
+  last_frame_target_time_ = frame_time;
   last_begin_frame_time_ = ftl::TimePoint::Now();
   engine_->BeginFrame(last_begin_frame_time_);
+  SetFramePending(false);
 }
 
 void Animator::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
   if (layer_tree) {
     // Note the frame time for instrumentation.
-    layer_tree->set_construction_time(ftl::TimePoint::Now() -
-                                      last_begin_frame_time_);
+    auto construction_time = ftl::TimePoint::Now() - last_begin_frame_time_;
+    layer_tree->set_construction_time(construction_time);
+    layer_tree->set_frame_target_time(last_frame_target_time_);
+    layer_tree->set_frame_build_start(last_begin_frame_time_);
+
+    // Track the build time for the deadline scheduler: react immediately to
+    // slowdowns, decay slowly when frames get cheaper.
+    if (construction_time > frame_build_estimate_) {
+      frame_build_estimate_ = construction_time;
+    } else {
+      frame_build_estimate_ = ftl::TimeDelta::FromMicroseconds(
+          (frame_build_estimate_.ToMicroseconds() * 7 +
+           construction_time.ToMicroseconds()) /
+          8);
+    }
   }
 
   // Commit the pending continuation.
@@ -80,10 +311,31 @@ void Animator::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
 
   blink::Threads::Gpu()->PostTask(
       [ rasterizer = rasterizer_, pipeline = layer_tree_pipeline_ ]() {
-        if (!rasterizer.get())
-          return;
-        rasterizer->Draw(pipeline);
+        RasterizerScheduler::Shared().ScheduleDraw(rasterizer, pipeline);
       });
+
+  // Once the current turn — and with it the frame's remaining microtasks —
+  // finishes, the UI thread is idle until the next vsync. Hand whatever is
+  // left of the interval to the VM so minor collections run in that window
+  // instead of pausing the middle of a frame build; during animations the
+  // window is short, which also keeps major collections from starting.
+  blink::Threads::UI()->PostTask([self = weak_factory_.GetWeakPtr()]() {
+    if (!self.get()) {
+      return;
+    }
+    ftl::TimeDelta remaining =
+        (self->last_vsync_time_ + self->frame_interval_ - kIdleWindowSlack) -
+        ftl::TimePoint::Now();
+    if (remaining >= kMinimumIdleWindow) {
+      self->engine_->NotifyIdle(remaining);
+    }
+  });
+}
+
+void Animator::SetRasterizerDrawPriority(int priority) {
+  blink::Threads::Gpu()->PostTask([ rasterizer = rasterizer_, priority ]() {
+    RasterizerScheduler::Shared().SetDrawPriority(rasterizer, priority);
+  });
 }
 
 void Animator::RequestFrame() {
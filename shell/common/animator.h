@@ -8,7 +8,7 @@
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
-#include "flutter/synchronization/pipeline.h"
+#include "flutter/synchronization/spsc_pipeline.h"
 #include "flutter/synchronization/semaphore.h"
 #include "lib/ftl/memory/ref_ptr.h"
 #include "lib/ftl/memory/weak_ptr.h"
@@ -32,11 +32,65 @@ class Animator {
 
   void Stop();
 
+  enum class PipelineMode {
+    // Depth 1: a frame is only produced once the previous one has been
+    // consumed, minimizing input-to-present latency.
+    LowLatency,
+    // Depth 3: keeps the GPU thread fed at the cost of added latency.
+    HighThroughput,
+  };
+
+  // Switches the layer tree pipeline between latency- and
+  // throughput-optimized depths at runtime.
+  void SetPipelineMode(PipelineMode mode);
+
+  // The enqueue-to-rasterize latency of the most recently consumed layer
+  // tree.
+  ftl::TimeDelta GetLastFrameLatency() const;
+
+  // When enabled, frame production is delayed within each vsync interval by
+  // an adaptive phase offset derived from recent frame build times, so that
+  // input arriving shortly after vsync is reflected in the current frame
+  // instead of waiting out a full interval.
+  void SetDeadlineSchedulingEnabled(bool enabled);
+
+  // Produce a frame on every Nth vsync. A divisor of 1 renders at the
+  // display rate; 2 halves it. Driven by the active performance profile.
+  // Called on the UI thread.
+  void SetFrameRateDivisor(int divisor);
+
+  // When enabled, the animator watches the rasterizer's scene reports and
+  // drops to half rate after a run of frames whose layer trees were
+  // identical to what is on screen, then to quarter rate as the run grows.
+  // The first changed scene or input restores the full rate. Called on the
+  // UI thread.
+  void SetAdaptiveFrameRateEnabled(bool enabled);
+
+  // Restores the full frame rate immediately, so the first frame of a
+  // response to input is not produced at the reduced idle rate. Called on
+  // the UI thread when input arrives.
+  void ResetIdleFrameRate();
+
+  // Sets this view's surface priority in the shared GPU draw scheduler.
+  // When several platform views render on the one GPU thread, higher
+  // priority surfaces are drawn first within each vsync's batch. Called on
+  // the UI thread.
+  void SetRasterizerDrawPriority(int priority);
+
  private:
-  using LayerTreePipeline = flutter::Pipeline<flow::LayerTree>;
+  using LayerTreePipeline = flutter::SPSCPipeline<flow::LayerTree>;
 
   void BeginFrame(ftl::TimePoint frame_time);
 
+  // Tells the UI thread's message loop whether a frame is in production, so
+  // idle-lane tasks are held back while it is. Safe to call before the loop
+  // exists (e.g. in tests).
+  static void SetFramePending(bool pending);
+
+  void OnSceneReport(bool scene_unchanged);
+
+  void ProduceFrame(ftl::TimePoint frame_time);
+
   void AwaitVSync();
 
   ftl::WeakPtr<Rasterizer> rasterizer_;
@@ -44,11 +98,23 @@ class Animator {
   Engine* engine_;
 
   ftl::TimePoint last_begin_frame_time_;
+  ftl::TimePoint last_frame_target_time_;
+  ftl::TimePoint last_vsync_time_;
+  ftl::TimeDelta frame_interval_;
+  ftl::TimeDelta frame_build_estimate_;
+  bool deadline_scheduling_enabled_;
+  int frame_rate_divisor_;
+  bool adaptive_frame_rate_enabled_;
+  int idle_divisor_;
+  int unchanged_scene_count_;
+  int64_t vsync_count_;
+  size_t profile_observer_id_;
   ftl::RefPtr<LayerTreePipeline> layer_tree_pipeline_;
   flutter::Semaphore pending_frame_semaphore_;
   LayerTreePipeline::ProducerContinuation producer_continuation_;
   int64_t frame_number_;
   bool paused_;
+  bool first_begin_frame_recorded_;
 
   ftl::WeakPtrFactory<Animator> weak_factory_;
 
@@ -17,14 +17,18 @@
 #include "flutter/assets/zip_asset_store.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
+#include "flutter/fml/thread_pool.h"
 #include "flutter/glue/trace_event.h"
 #include "flutter/lib/snapshot/snapshot.h"
 #include "flutter/runtime/asset_font_selector.h"
 #include "flutter/runtime/dart_controller.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/runtime/runtime_init.h"
+#include "flutter/runtime/start_up.h"
 #include "flutter/runtime/test_font_selector.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/event_replay.h"
+#include "flutter/shell/common/layer_tree_snapshot.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/sky/engine/public/web/Sky.h"
 #include "lib/ftl/files/eintr_wrapper.h"
@@ -68,11 +72,13 @@ std::string GetScriptUriFromPath(const std::string& path) {
 
 Engine::Engine(PlatformView* platform_view)
     : platform_view_(platform_view->GetWeakPtr()),
+      rasterizer_(platform_view->rasterizer().GetWeakRasterizerPtr()),
       animator_(std::make_unique<Animator>(
           platform_view->rasterizer().GetWeakRasterizerPtr(),
           platform_view->GetVsyncWaiter(),
           this)),
       load_script_error_(tonic::kNoError),
+      semantics_differ_(ftl::MakeRefCounted<SemanticsDiffer>()),
       activity_running_(false),
       have_surface_(false),
       weak_factory_(this) {}
@@ -188,6 +194,7 @@ void Engine::RunBundle(const std::string& bundle_path) {
     std::vector<uint8_t> kernel;
     if (GetAssetAsBuffer(blink::kKernelAssetKey, &kernel)) {
       runtime_->dart_controller()->RunFromKernel(kernel.data(), kernel.size());
+      blink::RecordStartupMilestone(blink::kStartupMilestoneRunBundleComplete);
       return;
     }
     std::vector<uint8_t> snapshot;
@@ -196,6 +203,7 @@ void Engine::RunBundle(const std::string& bundle_path) {
     runtime_->dart_controller()->RunFromScriptSnapshot(snapshot.data(),
                                                        snapshot.size());
   }
+  blink::RecordStartupMilestone(blink::kStartupMilestoneRunBundleComplete);
 }
 
 void Engine::RunBundleAndSnapshot(const std::string& bundle_path,
@@ -216,6 +224,7 @@ void Engine::RunBundleAndSnapshot(const std::string& bundle_path,
     runtime_->dart_controller()->RunFromScriptSnapshot(snapshot.data(),
                                                        snapshot.size());
   }
+  blink::RecordStartupMilestone(blink::kStartupMilestoneRunBundleComplete);
 }
 
 void Engine::RunBundleAndSource(const std::string& bundle_path,
@@ -232,12 +241,47 @@ void Engine::RunBundleAndSource(const std::string& bundle_path,
   ConfigureRuntime(GetScriptUriFromPath(main));
   load_script_error_ =
       runtime_->dart_controller()->RunFromSource(main, packages_path);
+  blink::RecordStartupMilestone(blink::kStartupMilestoneRunBundleComplete);
 }
 
+// How far behind frame time resampled input is taken. A sample point a few
+// milliseconds back keeps the interpolation bracketed by delivered platform
+// samples at typical touch scan rates, avoiding extrapolation overshoot.
+static const ftl::TimeDelta kPointerSampleSlack =
+    ftl::TimeDelta::FromMilliseconds(5);
+
 void Engine::BeginFrame(ftl::TimePoint frame_time) {
   TRACE_EVENT0("flutter", "Engine::BeginFrame");
-  if (runtime_)
-    runtime_->BeginFrame(frame_time);
+  if (!runtime_)
+    return;
+  if (pointer_resampling_enabled_) {
+    if (auto packet =
+            pointer_data_resampler_.Sample(frame_time - kPointerSampleSlack)) {
+      runtime_->DispatchPointerDataPacket(*packet);
+    }
+  }
+  runtime_->BeginFrame(frame_time);
+}
+
+void Engine::NotifyIdle(ftl::TimeDelta budget) {
+  if (!runtime_)
+    return;
+  runtime_->NotifyIdle(budget);
+}
+
+// Presented frames batched per Window.onFrameTimings delivery. A batch is
+// roughly a quarter second of smooth 60Hz animation: frequent enough for
+// production SLO monitors, infrequent enough that the Dart call is noise.
+static const size_t kFrameTimingsBatchSize = 15;
+
+void Engine::ReportFrameTiming(const Rasterizer::FrameTimingRecord& timing) {
+  if (!runtime_)
+    return;
+  frame_timings_.insert(frame_timings_.end(), timing.begin(), timing.end());
+  if (frame_timings_.size() >= kFrameTimingsBatchSize * timing.size()) {
+    runtime_->ReportFrameTimings(std::move(frame_timings_));
+    frame_timings_.clear();
+  }
 }
 
 void Engine::RunFromSource(const std::string& main,
@@ -275,8 +319,61 @@ tonic::DartErrorHandleType Engine::GetLoadScriptError() {
   return load_script_error_;
 }
 
+void Engine::SetWarmUpPictures(std::vector<sk_sp<SkPicture>> pictures) {
+  warm_up_pictures_ = std::move(pictures);
+  if (have_surface_) {
+    ScheduleWarmUp();
+  }
+}
+
+void Engine::ScheduleWarmUp() {
+  if (warm_up_pictures_.empty()) {
+    return;
+  }
+  blink::Threads::Gpu()->PostTask(
+      [ rasterizer = rasterizer_, pictures = warm_up_pictures_ ]() {
+        if (rasterizer) {
+          rasterizer->DrawWarmUpPictures(std::move(pictures));
+        }
+      });
+  warm_up_pictures_.clear();
+}
+
+void Engine::PresentSceneSnapshot() {
+  const std::string path = blink::Settings::Get().scene_snapshot_path;
+  if (path.empty() || scene_snapshot_attempted_) {
+    return;
+  }
+  // One attempt per process: after the first surface the snapshot is either
+  // on screen or already stale.
+  scene_snapshot_attempted_ = true;
+
+  // The file read and deserialization happen on the worker pool; only the
+  // raster and present touch the GPU thread.
+  fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+      [ path, rasterizer = rasterizer_ ]() {
+        auto tree = LoadLayerTreeSnapshot(path);
+        if (tree == nullptr) {
+          return;
+        }
+        blink::Threads::Gpu()->PostTask(ftl::MakeCopyable(
+            [ rasterizer, tree = std::move(tree) ]() mutable {
+              // If a real frame won the race, presenting the snapshot now
+              // would replace fresh content with last session's.
+              if (rasterizer && rasterizer->GetLastLayerTree() == nullptr) {
+                rasterizer->PreRenderLayerTree(std::move(tree));
+                rasterizer->PresentPreRenderedFrame();
+              }
+            }));
+      });
+}
+
 void Engine::OnOutputSurfaceCreated(const ftl::Closure& gpu_continuation) {
   blink::Threads::Gpu()->PostTask(gpu_continuation);
+  // The snapshot and warm-up draws are queued behind the rasterizer setup
+  // continuation, so both run as soon as the surface exists.
+  PresentSceneSnapshot();
+  ScheduleWarmUp();
   have_surface_ = true;
   StartAnimatorIfPossible();
   if (runtime_)
@@ -303,6 +400,10 @@ void Engine::DispatchPlatformMessage(
   } else if (message->channel() == kLocalizationChannel) {
     if (HandleLocalizationPlatformMessage(std::move(message)))
       return;
+  } else if (message->channel() == kNavigationChannel) {
+    // The message still goes to the isolate; the route name is only peeked
+    // at so cache hints learned from here on are filed under this screen.
+    ForwardRouteToRasterizer(message.get());
   }
 
   if (runtime_) {
@@ -316,13 +417,34 @@ void Engine::DispatchPlatformMessage(
 }
 
 bool Engine::HandleLifecyclePlatformMessage(blink::PlatformMessage* message) {
-  const auto& data = message->data();
-  std::string state(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string state(reinterpret_cast<const char*>(message->GetData()),
+                    message->GetDataSize());
   if (state == "AppLifecycleState.paused") {
     activity_running_ = false;
     StopAnimator();
+    // No frames are coming while invisible, so hand the GPU caches back.
+    // Any layer trees still in the pipeline have already been queued for
+    // the GPU thread and drain ahead of this task.
+    blink::Threads::Gpu()->PostTask([rasterizer = rasterizer_]() {
+      if (rasterizer) {
+        // The pause is the moment to snapshot: the tree on screen now is
+        // the content the next launch should open on. Recording happens
+        // before the purge so the caches it bypasses are still coherent.
+        rasterizer->SnapshotLastLayerTree(
+            blink::Settings::Get().scene_snapshot_path);
+        rasterizer->PurgeResourceCache();
+      }
+    });
   } else if (state == "AppLifecycleState.resumed") {
     activity_running_ = true;
+    // Refill what the pause dropped before the animator produces the first
+    // visible frame; the prewarm runs ahead of that frame's rasterization
+    // on the GPU thread.
+    blink::Threads::Gpu()->PostTask([rasterizer = rasterizer_]() {
+      if (rasterizer) {
+        rasterizer->PrewarmSurface();
+      }
+    });
     StartAnimatorIfPossible();
   }
   return false;
@@ -331,10 +453,10 @@ bool Engine::HandleLifecyclePlatformMessage(blink::PlatformMessage* message) {
 bool Engine::HandleNavigationPlatformMessage(
     ftl::RefPtr<blink::PlatformMessage> message) {
   FTL_DCHECK(!runtime_);
-  const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(message->GetData()),
+                 message->GetDataSize());
   if (document.HasParseError() || !document.IsObject())
     return false;
   auto root = document.GetObject();
@@ -346,12 +468,34 @@ bool Engine::HandleNavigationPlatformMessage(
   return true;
 }
 
+void Engine::ForwardRouteToRasterizer(blink::PlatformMessage* message) {
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(message->GetData()),
+                 message->GetDataSize());
+  if (document.HasParseError() || !document.IsObject())
+    return;
+  auto root = document.GetObject();
+  auto method = root.FindMember("method");
+  if (method == root.MemberEnd() || !method->value.IsString())
+    return;
+  if (method->value != "pushRoute" && method->value != "setInitialRoute")
+    return;
+  auto args = root.FindMember("args");
+  if (args == root.MemberEnd() || !args->value.IsArray() ||
+      args->value.Size() < 1 || !args->value[0].IsString())
+    return;
+  std::string route = args->value[0].GetString();
+  blink::Threads::Gpu()->PostTask([rasterizer = rasterizer_, route]() {
+    if (rasterizer)
+      rasterizer->SetCacheHintRoute(route);
+  });
+}
+
 bool Engine::HandleLocalizationPlatformMessage(
     ftl::RefPtr<blink::PlatformMessage> message) {
-  const auto& data = message->data();
-
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(message->GetData()),
+                 message->GetDataSize());
   if (document.HasParseError() || !document.IsObject())
     return false;
   auto root = document.GetObject();
@@ -377,10 +521,24 @@ bool Engine::HandleLocalizationPlatformMessage(
 }
 
 void Engine::DispatchPointerDataPacket(const PointerDataPacket& packet) {
+  EventRecorder::Shared().RecordPointerPacket(packet);
+  // Input means the scene is about to change; leave the idle frame rate
+  // before the response frame is produced.
+  animator_->ResetIdleFrameRate();
+  if (pointer_resampling_enabled_) {
+    pointer_data_resampler_.Enqueue(packet);
+    // Make sure a frame is on its way to consume the buffered input.
+    ScheduleFrame();
+    return;
+  }
   if (runtime_)
     runtime_->DispatchPointerDataPacket(packet);
 }
 
+void Engine::SetPointerDataResamplingEnabled(bool enabled) {
+  pointer_resampling_enabled_ = enabled;
+}
+
 void Engine::DispatchSemanticsAction(int id, blink::SemanticsAction action) {
   if (runtime_)
     runtime_->DispatchSemanticsAction(id, action);
@@ -388,6 +546,13 @@ void Engine::DispatchSemanticsAction(int id, blink::SemanticsAction action) {
 
 void Engine::SetSemanticsEnabled(bool enabled) {
   semantics_enabled_ = enabled;
+  if (!semantics_enabled_) {
+    // The platform accessibility bridges discard their state when semantics
+    // are turned off; forget ours too so the next enable ships the full
+    // tree again instead of filtering it as unchanged.
+    blink::Threads::IO()->PostTask(
+        [differ = semantics_differ_]() { differ->Reset(); });
+  }
   if (runtime_)
     runtime_->SetSemanticsEnabled(semantics_enabled_);
 }
@@ -411,8 +576,22 @@ void Engine::ConfigureAssetBundle(const std::string& path) {
   }
 
   if (S_ISREG(stat_result.st_mode)) {
-    asset_store_ = ftl::MakeRefCounted<blink::ZipAssetStore>(
-        blink::GetUnzipperProviderForPath(path));
+    auto asset_store = ftl::MakeRefCounted<blink::ZipAssetStore>(
+        blink::GetUnzipperProviderForPath(path), path);
+    if (asset_store_) {
+      // On hot restart, diff the new bundle's manifest against the old one.
+      // Downstream caches keyed by asset name and content fingerprint (the
+      // font selector's cross-restart typeface cache) stay valid for the
+      // unchanged entries, so restart cost scales with the delta.
+      std::vector<std::string> updated_assets =
+          asset_store->GetUpdatedAssets(*asset_store_);
+      char updated_count[32];
+      snprintf(updated_count, sizeof(updated_count), "%zu",
+               updated_assets.size());
+      TRACE_EVENT1("flutter", "Engine::ConfigureAssetBundle::ManifestDiff",
+                   "updatedAssets", updated_count);
+    }
+    asset_store_ = std::move(asset_store);
     return;
   }
 }
@@ -466,11 +645,16 @@ void Engine::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
 }
 
 void Engine::UpdateSemantics(std::vector<blink::SemanticsNode> update) {
-  blink::Threads::Platform()->PostTask(ftl::MakeCopyable(
-      [ platform_view = platform_view_, update = std::move(update) ]() mutable {
-        if (platform_view)
-          platform_view->UpdateSemantics(std::move(update));
-      }));
+  // The diff against the last-shipped tree walks the full node set, so it
+  // runs on the IO thread; this thread only pays for the hop and stays
+  // free to start the next frame while the GPU thread rasterizes the one
+  // that carried this update.
+  blink::Threads::IO()->PostTask(ftl::MakeCopyable([
+    differ = semantics_differ_, platform_view = platform_view_,
+    update = std::move(update)
+  ]() mutable {
+    differ->ProcessUpdate(std::move(update), std::move(platform_view));
+  }));
 }
 
 void Engine::HandlePlatformMessage(
@@ -492,9 +676,8 @@ void Engine::HandleAssetPlatformMessage(
   ftl::RefPtr<blink::PlatformMessageResponse> response = message->response();
   if (!response)
     return;
-  const auto& data = message->data();
-  std::string asset_name(reinterpret_cast<const char*>(data.data()),
-                         data.size());
+  std::string asset_name(reinterpret_cast<const char*>(message->GetData()),
+                         message->GetDataSize());
   std::vector<uint8_t> asset_data;
   if (GetAssetAsBuffer(asset_name, &asset_data)) {
     response->Complete(std::move(asset_data));
@@ -5,12 +5,16 @@
 #ifndef SHELL_COMMON_ENGINE_H_
 #define SHELL_COMMON_ENGINE_H_
 
+#include <vector>
+
 #include "flutter/assets/zip_asset_store.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/runtime/runtime_delegate.h"
+#include "flutter/shell/common/pointer_data_resampler.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/semantics_differ.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -51,6 +55,15 @@ class Engine : public blink::RuntimeDelegate {
 
   void BeginFrame(ftl::TimePoint frame_time);
 
+  // Offers the VM a garbage collection window of |budget|. Called by the
+  // animator on the UI thread with the slack left before the next vsync.
+  void NotifyIdle(ftl::TimeDelta budget);
+
+  // Accumulates one presented frame's timing record from the rasterizer and
+  // flushes the batch to the framework's Window.onFrameTimings stream every
+  // few frames. Called on the UI thread.
+  void ReportFrameTiming(const Rasterizer::FrameTimingRecord& timing);
+
   void RunFromSource(const std::string& main,
                      const std::string& packages,
                      const std::string& bundle);
@@ -61,6 +74,12 @@ class Engine : public blink::RuntimeDelegate {
   tonic::DartErrorHandleType GetUIIsolateLastError();
   tonic::DartErrorHandleType GetLoadScriptError();
 
+  // Registers representative pictures to rasterize into a scratch offscreen
+  // target as soon as the output surface is set up, so driver shader
+  // compilation happens behind the splash screen instead of during the
+  // first user interaction.
+  void SetWarmUpPictures(std::vector<sk_sp<SkPicture>> pictures);
+
   void OnOutputSurfaceCreated(const ftl::Closure& gpu_continuation);
   void OnOutputSurfaceDestroyed(const ftl::Closure& gpu_continuation);
   void SetViewportMetrics(const blink::ViewportMetrics& metrics);
@@ -69,6 +88,12 @@ class Engine : public blink::RuntimeDelegate {
   void DispatchSemanticsAction(int id, blink::SemanticsAction action);
   void SetSemanticsEnabled(bool enabled);
 
+  // When enabled, pointer packets are buffered as they arrive and delivered
+  // once per frame from BeginFrame, interpolated to a sample point just
+  // behind frame time, instead of being dispatched with up to a frame
+  // interval of staleness. Disabled by default.
+  void SetPointerDataResamplingEnabled(bool enabled);
+
  private:
   // RuntimeDelegate methods:
   void ScheduleFrame() override;
@@ -82,12 +107,22 @@ class Engine : public blink::RuntimeDelegate {
   void StopAnimator();
   void StartAnimatorIfPossible();
 
+  void ScheduleWarmUp();
+
+  // Loads the scene snapshot the previous run serialized on pause, if any,
+  // and presents it as a stopgap first frame while the isolate starts.
+  void PresentSceneSnapshot();
+
   void ConfigureAssetBundle(const std::string& path);
   void ConfigureRuntime(const std::string& script_uri);
 
   bool HandleLifecyclePlatformMessage(blink::PlatformMessage* message);
   bool HandleNavigationPlatformMessage(
       ftl::RefPtr<blink::PlatformMessage> message);
+  // Extracts the route name from a navigation message (without consuming
+  // the message) and forwards it to the rasterizer so raster cache hints
+  // are keyed per screen.
+  void ForwardRouteToRasterizer(blink::PlatformMessage* message);
   bool HandleLocalizationPlatformMessage(
       ftl::RefPtr<blink::PlatformMessage> message);
 
@@ -95,6 +130,8 @@ class Engine : public blink::RuntimeDelegate {
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
   ftl::WeakPtr<PlatformView> platform_view_;
+  ftl::WeakPtr<Rasterizer> rasterizer_;
+  std::vector<sk_sp<SkPicture>> warm_up_pictures_;
   std::unique_ptr<Animator> animator_;
   std::unique_ptr<blink::RuntimeController> runtime_;
   tonic::DartErrorHandleType load_script_error_;
@@ -103,6 +140,16 @@ class Engine : public blink::RuntimeDelegate {
   std::string language_code_;
   std::string country_code_;
   bool semantics_enabled_ = false;
+  // Diffs semantics updates on the IO thread so that work never competes
+  // with frame production here on the UI thread. Refcounted because
+  // in-flight IO tasks may outlive this engine.
+  ftl::RefPtr<SemanticsDiffer> semantics_differ_;
+  bool pointer_resampling_enabled_ = false;
+  bool scene_snapshot_attempted_ = false;
+  PointerDataResampler pointer_data_resampler_;
+  // Flattened frame timing records awaiting the next batched flush to the
+  // framework.
+  std::vector<int64_t> frame_timings_;
   // TODO(abarth): Unify these two behind a common interface.
   ftl::RefPtr<blink::ZipAssetStore> asset_store_;
   std::unique_ptr<blink::DirectoryAssetBundle> directory_asset_bundle_;
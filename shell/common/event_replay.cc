@@ -0,0 +1,104 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/event_replay.h"
+
+#include "lib/ftl/logging.h"
+
+namespace shell {
+
+EventRecorder& EventRecorder::Shared() {
+  static EventRecorder* recorder = new EventRecorder();
+  return *recorder;
+}
+
+EventRecorder::EventRecorder() : recording_(false) {}
+
+EventRecorder::~EventRecorder() = default;
+
+void EventRecorder::StartRecording(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FTL_DCHECK(file_ == nullptr);
+  file_ = fopen(path.c_str(), "wb");
+  if (file_ == nullptr) {
+    FTL_LOG(ERROR) << "Could not open event log for recording: " << path;
+    return;
+  }
+  start_ = ftl::TimePoint::Now();
+  recording_.store(true, std::memory_order_release);
+}
+
+void EventRecorder::RecordVsync(ftl::TimePoint frame_time) {
+  if (!recording_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  AppendLocked(kEventLogKindVsync, (frame_time - start_).ToMicroseconds(),
+               nullptr, 0);
+}
+
+void EventRecorder::RecordPointerPacket(
+    const blink::PointerDataPacket& packet) {
+  if (!recording_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  AppendLocked(kEventLogKindPointerPacket,
+               (ftl::TimePoint::Now() - start_).ToMicroseconds(),
+               packet.data(), packet.size());
+}
+
+void EventRecorder::AppendLocked(uint32_t kind,
+                                 int64_t offset_micros,
+                                 const uint8_t* payload,
+                                 size_t size) {
+  if (file_ == nullptr) {
+    return;
+  }
+  EventLogRecordHeader header;
+  header.kind = kind;
+  header.offset_micros = offset_micros;
+  header.payload_bytes = size;
+  fwrite(&header, sizeof(header), 1, file_);
+  if (size > 0) {
+    fwrite(payload, 1, size, file_);
+  }
+  // Input rates make this a few hundred small writes per second at worst;
+  // flushing each record keeps the log usable after an unclean exit.
+  fflush(file_);
+}
+
+bool ReplayLog::Load(const std::string& path, ReplayLog* log) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    FTL_LOG(ERROR) << "Could not open event log for replay: " << path;
+    return false;
+  }
+
+  EventLogRecordHeader header;
+  while (fread(&header, sizeof(header), 1, file) == 1) {
+    std::vector<uint8_t> payload(header.payload_bytes);
+    if (header.payload_bytes > 0 &&
+        fread(payload.data(), 1, payload.size(), file) != payload.size()) {
+      // Truncated final record from an unclean exit; keep what we have.
+      break;
+    }
+    switch (header.kind) {
+      case kEventLogKindVsync:
+        log->vsync_offsets_micros.push_back(header.offset_micros);
+        break;
+      case kEventLogKindPointerPacket:
+        log->packets.push_back({header.offset_micros, std::move(payload)});
+        break;
+      default:
+        // A record kind from a newer log version; skip it.
+        break;
+    }
+  }
+  fclose(file);
+
+  return !log->vsync_offsets_micros.empty();
+}
+
+}  // namespace shell
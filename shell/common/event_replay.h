@@ -0,0 +1,87 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_EVENT_REPLAY_H_
+#define FLUTTER_SHELL_COMMON_EVENT_REPLAY_H_
+
+#include <stdio.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_point.h"
+
+namespace shell {
+
+// The event log is a sequence of records, each a fixed header followed by
+// |payload_bytes| of payload. Vsync records carry no payload; pointer
+// records carry the packet's serialized bytes. Offsets are microseconds
+// since the start of the recording, so a replay can rebase the whole
+// timeline onto its own clock.
+struct EventLogRecordHeader {
+  uint32_t kind;
+  int64_t offset_micros;
+  uint32_t payload_bytes;
+};
+
+const uint32_t kEventLogKindVsync = 1;
+const uint32_t kEventLogKindPointerPacket = 2;
+
+// Appends vsync timestamps and pointer packets to an event log as they
+// pass through the engine, so a benchmark run can later be replayed with
+// identical timing. Armed once at startup via --record-events-file; the
+// per-event cost when disarmed is one relaxed atomic load.
+class EventRecorder {
+ public:
+  static EventRecorder& Shared();
+
+  // Begins recording to |path|, truncating any existing file. Records are
+  // flushed as they are written, so a run killed without a clean shutdown
+  // still leaves a usable log.
+  void StartRecording(const std::string& path);
+
+  void RecordVsync(ftl::TimePoint frame_time);
+
+  void RecordPointerPacket(const blink::PointerDataPacket& packet);
+
+ private:
+  EventRecorder();
+
+  ~EventRecorder();
+
+  void AppendLocked(uint32_t kind,
+                    int64_t offset_micros,
+                    const uint8_t* payload,
+                    size_t size);
+
+  std::atomic<bool> recording_;
+  std::mutex mutex_;
+  FILE* file_ = nullptr;
+  ftl::TimePoint start_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(EventRecorder);
+};
+
+// An event log loaded back into memory for replay.
+struct ReplayLog {
+  struct Packet {
+    int64_t offset_micros;
+    std::vector<uint8_t> bytes;
+  };
+
+  std::vector<int64_t> vsync_offsets_micros;
+  std::vector<Packet> packets;
+
+  // Loads |path|, tolerating a truncated final record. Returns false when
+  // the file cannot be opened or contains no vsync records.
+  static bool Load(const std::string& path, ReplayLog* log);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_EVENT_REPLAY_H_
@@ -0,0 +1,28 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_catchup_policy.h"
+
+namespace shell {
+
+namespace {
+
+const ftl::TimeDelta kFrameInterval = ftl::TimeDelta::FromMicroseconds(16667);
+
+}  // namespace
+
+FrameCatchUpPolicy::FrameCatchUpPolicy() : dropped_frame_count_(0) {}
+
+FrameCatchUpPolicy::~FrameCatchUpPolicy() = default;
+
+bool FrameCatchUpPolicy::ShouldCatchUp(
+    ftl::TimeDelta last_consume_latency) const {
+  return last_consume_latency > kFrameInterval;
+}
+
+void FrameCatchUpPolicy::RecordDroppedFrames(size_t count) {
+  dropped_frame_count_ += count;
+}
+
+}  // namespace shell
@@ -0,0 +1,40 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_CATCHUP_POLICY_H_
+#define FLUTTER_SHELL_COMMON_FRAME_CATCHUP_POLICY_H_
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+
+namespace shell {
+
+// Decides when the GPU thread, having fallen behind the UI thread, should
+// catch back up by skipping stale frames instead of rendering every pending
+// layer tree back-to-back. Keeping only the newest pending tree bounds
+// latency under load instead of letting it snowball.
+class FrameCatchUpPolicy {
+ public:
+  FrameCatchUpPolicy();
+
+  ~FrameCatchUpPolicy();
+
+  // True when the last consumed frame spent more than one vsync interval in
+  // the pipeline, meaning everything but the newest pending tree is already
+  // stale on arrival.
+  bool ShouldCatchUp(ftl::TimeDelta last_consume_latency) const;
+
+  void RecordDroppedFrames(size_t count);
+
+  size_t dropped_frame_count() const { return dropped_frame_count_; }
+
+ private:
+  size_t dropped_frame_count_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(FrameCatchUpPolicy);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_CATCHUP_POLICY_H_
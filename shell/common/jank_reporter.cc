@@ -0,0 +1,107 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/jank_reporter.h"
+
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include "flutter/fml/trace_recorder.h"
+#include "flutter/shell/common/metrics_registry.h"
+
+namespace shell {
+
+namespace {
+
+const uint32_t kReportMagic = 0x31524a46;  // 'FJR1', little-endian.
+const uint32_t kReportVersion = 1;
+
+// The vsync interval the engine runs against everywhere else. A frame is
+// janky when build plus raster exceed twice this.
+const ftl::TimeDelta kFrameBudget = ftl::TimeDelta::FromMicroseconds(16667);
+
+// Minimum spacing between captures. The trace dump is the expensive part
+// of a capture; a sustained stall should cost one dump, not one per frame.
+const ftl::TimeDelta kMinCaptureInterval = ftl::TimeDelta::FromSeconds(5);
+
+}  // namespace
+
+JankReporter& JankReporter::Shared() {
+  static JankReporter* reporter = new JankReporter();
+  return *reporter;
+}
+
+JankReporter::JankReporter() = default;
+
+JankReporter::~JankReporter() = default;
+
+void JankReporter::OnFrameEnd(
+    ftl::TimeDelta build_time,
+    ftl::TimeDelta raster_time,
+    const flow::RasterCache::FrameStatistics& cache_statistics) {
+  if (build_time + raster_time < kFrameBudget + kFrameBudget) {
+    return;
+  }
+
+  ftl::TimePoint now = ftl::TimePoint::Now();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!last_report_.empty() && now - last_capture_time_ < kMinCaptureInterval) {
+    return;
+  }
+  last_capture_time_ = now;
+
+  static MetricsRegistry::Counter* reports_captured =
+      MetricsRegistry::Shared().RegisterCounter("jank.reports_captured");
+  reports_captured->Increment();
+
+  std::string trace_json =
+      fml::tracing::TraceRecorder::GetProcessRecorder()
+          .DumpAsChromeTraceJSON();
+
+  ReportHeader header = {};
+  header.magic = kReportMagic;
+  header.version = kReportVersion;
+  header.capture_time_micros = now.ToEpochDelta().ToMicroseconds();
+  header.build_micros = build_time.ToMicroseconds();
+  header.raster_micros = raster_time.ToMicroseconds();
+  header.budget_micros = kFrameBudget.ToMicroseconds();
+  if (has_slow_ui_task_) {
+    header.last_slow_ui_task_micros =
+        last_slow_ui_task_duration_.ToMicroseconds();
+    header.last_slow_ui_task_age_micros =
+        (now - last_slow_ui_task_time_).ToMicroseconds();
+  } else {
+    header.last_slow_ui_task_micros = -1;
+    header.last_slow_ui_task_age_micros = -1;
+  }
+  header.raster_cache_hits = cache_statistics.hits;
+  header.raster_cache_misses = cache_statistics.misses;
+  header.raster_cache_evictions = cache_statistics.evictions;
+  header.raster_cache_deferred_fills = cache_statistics.deferred_fills;
+  header.raster_cache_fill_micros =
+      cache_statistics.rasterization_microseconds;
+  header.trace_json_bytes = trace_json.size();
+
+  last_report_.resize(sizeof(ReportHeader) + trace_json.size());
+  memcpy(last_report_.data(), &header, sizeof(ReportHeader));
+  memcpy(last_report_.data() + sizeof(ReportHeader), trace_json.data(),
+         trace_json.size());
+}
+
+void JankReporter::OnSlowUITask(ftl::TimeDelta duration) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  last_slow_ui_task_duration_ = duration;
+  last_slow_ui_task_time_ = ftl::TimePoint::Now();
+  has_slow_ui_task_ = true;
+}
+
+std::vector<uint8_t> JankReporter::CopyLastReport() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return last_report_;
+}
+
+}  // namespace shell
@@ -0,0 +1,88 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_JANK_REPORTER_H_
+#define FLUTTER_SHELL_COMMON_JANK_REPORTER_H_
+
+#include <mutex>
+#include <vector>
+
+#include "flutter/flow/raster_cache.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
+
+namespace shell {
+
+// Captures forensics when a frame blows past twice its budget: the
+// engine/raster split of the janky frame, the raster cache's statistics
+// for it, the most recent UI task overrun reported by the message loop,
+// and a dump of the always-on trace ring covering the window leading up
+// to the miss. Reports are compact binary blobs that embedders fetch
+// through PlatformView::GetLastJankReport() and attach to their crash or
+// feedback uploads. Captures are rate limited, so a sustained stall
+// produces one report, not one per frame.
+class JankReporter {
+ public:
+  // Fixed-size prelude of a report. The trace dump, as Chrome trace JSON,
+  // immediately follows the header and is |trace_json_bytes| long. All
+  // fields are little-endian on the architectures this engine targets.
+  struct ReportHeader {
+    // 'FJR1'.
+    uint32_t magic;
+    uint32_t version;
+    // Microseconds since the monotonic clock's epoch at capture.
+    int64_t capture_time_micros;
+    // The janky frame's layer tree construction time on the UI thread.
+    int64_t build_micros;
+    // Time spent rasterizing and submitting the frame on the GPU thread.
+    int64_t raster_micros;
+    int64_t budget_micros;
+    // Duration and age of the last UI task that exceeded the message
+    // loop's slow-task threshold, or -1 when none has been seen.
+    int64_t last_slow_ui_task_micros;
+    int64_t last_slow_ui_task_age_micros;
+    uint64_t raster_cache_hits;
+    uint64_t raster_cache_misses;
+    uint64_t raster_cache_evictions;
+    uint64_t raster_cache_deferred_fills;
+    int64_t raster_cache_fill_micros;
+    uint64_t trace_json_bytes;
+  };
+
+  static JankReporter& Shared();
+
+  // Called by the rasterizer at the end of every drawn frame. Cheap when
+  // the frame made its budget. Runs on the GPU thread.
+  void OnFrameEnd(ftl::TimeDelta build_time,
+                  ftl::TimeDelta raster_time,
+                  const flow::RasterCache::FrameStatistics& cache_statistics);
+
+  // Fed from the UI message loop's slow-task callback so a report can name
+  // how long the task running closest to the miss overran. Runs on the UI
+  // thread.
+  void OnSlowUITask(ftl::TimeDelta duration);
+
+  // Returns a copy of the most recent report, or an empty vector when no
+  // jank has been captured. May be called from the platform thread.
+  std::vector<uint8_t> CopyLastReport();
+
+ private:
+  JankReporter();
+
+  ~JankReporter();
+
+  std::mutex mutex_;
+  std::vector<uint8_t> last_report_;
+  ftl::TimePoint last_capture_time_;
+  ftl::TimeDelta last_slow_ui_task_duration_;
+  ftl::TimePoint last_slow_ui_task_time_;
+  bool has_slow_ui_task_ = false;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(JankReporter);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_JANK_REPORTER_H_
@@ -0,0 +1,73 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/layer_tree_snapshot.h"
+
+#include <utility>
+
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/fml/thread_pool.h"
+#include "flutter/shell/common/picture_stream.h"
+#include "lib/ftl/functional/make_copyable.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace shell {
+
+void SnapshotLayerTree(flow::LayerTree& tree,
+                       flow::CompositorContext& context,
+                       const std::string& path) {
+  const SkISize& size = tree.frame_size();
+  if (size.isEmpty()) {
+    return;
+  }
+
+  // Replay the tree into one picture. Prerolling with the raster cache
+  // ignored keeps GPU-backed cache images out of the recording, so every
+  // draw the picture holds serializes; the picture's cull rect carries the
+  // frame size through the stream.
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(size.width(), size.height());
+  auto frame =
+      context.AcquireFrame(nullptr, canvas, false /* instrumentation */);
+  tree.set_damage(SkRect::MakeIWH(size.width(), size.height()));
+  tree.Preroll(frame, true /* ignore_raster_cache */);
+  tree.Paint(frame);
+  sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+  // The picture is immutable from here on; serialization and the file write
+  // happen off the GPU thread. The writer's own thread winds down before
+  // the worker task returns, so the file is complete when the task ends.
+  fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+      ftl::MakeCopyable([ picture = std::move(picture), path ]() mutable {
+        PictureStreamWriter writer(path);
+        writer.WritePicture(std::move(picture));
+      }));
+}
+
+std::unique_ptr<flow::LayerTree> LoadLayerTreeSnapshot(
+    const std::string& path) {
+  std::vector<sk_sp<SkPicture>> pictures = ReadPictureStream(path);
+  if (pictures.empty() || pictures.front() == nullptr) {
+    return nullptr;
+  }
+  sk_sp<SkPicture> picture = std::move(pictures.front());
+
+  const SkRect cull_rect = picture->cullRect();
+  const SkISize frame_size = SkISize::Make(SkScalarCeilToInt(cull_rect.width()),
+                                           SkScalarCeilToInt(cull_rect.height()));
+  if (frame_size.isEmpty()) {
+    return nullptr;
+  }
+
+  auto layer = std::make_unique<flow::PictureLayer>();
+  layer->set_offset(SkPoint::Make(0, 0));
+  layer->set_picture(std::move(picture));
+
+  auto tree = std::make_unique<flow::LayerTree>();
+  tree->set_frame_size(frame_size);
+  tree->set_root_layer(std::move(layer));
+  return tree;
+}
+
+}  // namespace shell
@@ -0,0 +1,35 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_LAYER_TREE_SNAPSHOT_H_
+#define SHELL_COMMON_LAYER_TREE_SNAPSHOT_H_
+
+#include <memory>
+#include <string>
+
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/layer_tree.h"
+
+namespace shell {
+
+// Serializes |tree| to a snapshot file at |path| so the next launch can
+// present it as a stopgap first frame while the Dart isolate is still
+// starting. The tree is replayed into a single picture on the calling (GPU)
+// thread — raster cache images are bypassed, so only serializable picture
+// content is recorded — and the picture is written as a one-frame picture
+// stream (see picture_stream.h) on the shared worker pool.
+void SnapshotLayerTree(flow::LayerTree& tree,
+                       flow::CompositorContext& context,
+                       const std::string& path);
+
+// Loads a snapshot written by SnapshotLayerTree into a layer tree holding
+// the replayed frame as a single picture layer, suitable for
+// Rasterizer::PreRenderLayerTree. Returns null if the file cannot be read
+// or is not a snapshot.
+std::unique_ptr<flow::LayerTree> LoadLayerTreeSnapshot(
+    const std::string& path);
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_LAYER_TREE_SNAPSHOT_H_
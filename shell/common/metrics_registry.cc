@@ -0,0 +1,163 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/metrics_registry.h"
+
+#include <sstream>
+
+#include "flutter/common/threads.h"
+
+namespace shell {
+
+void MetricsRegistry::Histogram::Record(int64_t sample) {
+  if (sample < 0) {
+    sample = 0;
+  }
+  size_t bucket = 0;
+  while (bucket + 1 < kBucketCount && (int64_t(1) << bucket) < sample) {
+    bucket++;
+  }
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(sample, std::memory_order_relaxed);
+}
+
+MetricsRegistry::Histogram::Histogram() : count_(0), sum_(0) {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+MetricsRegistry& MetricsRegistry::Shared() {
+  static MetricsRegistry* registry = new MetricsRegistry();
+  return *registry;
+}
+
+MetricsRegistry::MetricsRegistry() {}
+
+MetricsRegistry::~MetricsRegistry() {}
+
+MetricsRegistry::Counter* MetricsRegistry::RegisterCounter(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lock(registration_mutex_);
+  std::unique_ptr<Counter>& counter = counters_[name];
+  if (!counter) {
+    counter.reset(new Counter());
+  }
+  return counter.get();
+}
+
+MetricsRegistry::Gauge* MetricsRegistry::RegisterGauge(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lock(registration_mutex_);
+  std::unique_ptr<Gauge>& gauge = gauges_[name];
+  if (!gauge) {
+    gauge.reset(new Gauge());
+  }
+  return gauge.get();
+}
+
+MetricsRegistry::Histogram* MetricsRegistry::RegisterHistogram(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lock(registration_mutex_);
+  std::unique_ptr<Histogram>& histogram = histograms_[name];
+  if (!histogram) {
+    histogram.reset(new Histogram());
+  }
+  return histogram.get();
+}
+
+std::string MetricsRegistry::DumpAsJSON() const {
+  // The lock only orders this dump against concurrent registration; the
+  // instrument values themselves are relaxed atomics that updaters write
+  // without ever taking it.
+  std::lock_guard<std::mutex> lock(registration_mutex_);
+  std::stringstream stream;
+  stream << "{\"counters\":{";
+  bool first = true;
+  for (const auto& entry : counters_) {
+    if (!first)
+      stream << ",";
+    first = false;
+    stream << "\"" << entry.first << "\":" << entry.second->value();
+  }
+  stream << "},\"gauges\":{";
+  first = true;
+  for (const auto& entry : gauges_) {
+    if (!first)
+      stream << ",";
+    first = false;
+    stream << "\"" << entry.first << "\":" << entry.second->value();
+  }
+  stream << "},\"histograms\":{";
+  first = true;
+  for (const auto& entry : histograms_) {
+    if (!first)
+      stream << ",";
+    first = false;
+    const Histogram& histogram = *entry.second;
+    stream << "\"" << entry.first << "\":{\"count\":" << histogram.count()
+           << ",\"sum\":" << histogram.sum() << ",\"buckets\":[";
+    // Trailing empty buckets are elided to keep snapshots small.
+    size_t last_used = 0;
+    for (size_t i = 0; i < Histogram::kBucketCount; i++) {
+      if (histogram.bucket(i) != 0)
+        last_used = i;
+    }
+    for (size_t i = 0; i <= last_used; i++) {
+      if (i != 0)
+        stream << ",";
+      stream << histogram.bucket(i);
+    }
+    stream << "]}";
+  }
+  stream << "}}";
+  return stream.str();
+}
+
+void MetricsRegistry::StartPeriodicPush(PushHandler handler,
+                                        ftl::TimeDelta interval) {
+  {
+    std::lock_guard<std::mutex> lock(push_mutex_);
+    push_handler_ = std::move(handler);
+    push_interval_ = interval;
+    push_generation_++;
+  }
+  SchedulePush();
+}
+
+void MetricsRegistry::StopPeriodicPush() {
+  std::lock_guard<std::mutex> lock(push_mutex_);
+  push_handler_ = nullptr;
+  push_generation_++;
+}
+
+void MetricsRegistry::SchedulePush() {
+  uint64_t generation;
+  ftl::TimeDelta interval;
+  {
+    std::lock_guard<std::mutex> lock(push_mutex_);
+    if (!push_handler_) {
+      return;
+    }
+    generation = push_generation_;
+    interval = push_interval_;
+  }
+  blink::Threads::IO()->PostDelayedTask(
+    [this, generation]() {
+      PushHandler handler;
+      {
+        std::lock_guard<std::mutex> lock(push_mutex_);
+        if (generation != push_generation_ || !push_handler_) {
+          return;
+        }
+        handler = push_handler_;
+      }
+      handler(DumpAsJSON());
+      SchedulePush();
+    },
+    interval);
+}
+
+}  // namespace shell
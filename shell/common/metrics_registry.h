@@ -0,0 +1,137 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_METRICS_REGISTRY_H_
+#define SHELL_COMMON_METRICS_REGISTRY_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+
+namespace shell {
+
+// Process-wide registry of engine performance metrics: named counters,
+// gauges, and histograms that any subsystem can register once and update
+// from its hot path. Updates are single relaxed atomic operations, so
+// instruments can stay enabled in production; snapshots read the same
+// atomics without taking any lock that updaters contend on.
+//
+// Snapshots are exported as JSON through the service protocol
+// (_flutter.getMetrics) and, optionally, pushed periodically to an
+// embedder-supplied handler for fleet telemetry.
+class MetricsRegistry {
+ public:
+  class Counter {
+   public:
+    void Increment(int64_t delta = 1) {
+      value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+   private:
+    friend class MetricsRegistry;
+
+    Counter() : value_(0) {}
+
+    std::atomic<int64_t> value_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(Counter);
+  };
+
+  class Gauge {
+   public:
+    void Set(int64_t value) {
+      value_.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+   private:
+    friend class MetricsRegistry;
+
+    Gauge() : value_(0) {}
+
+    std::atomic<int64_t> value_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(Gauge);
+  };
+
+  // Power-of-two bucketed histogram of non-negative samples. Bucket i
+  // counts samples in [2^(i-1), 2^i); bucket 0 counts zero and one.
+  class Histogram {
+   public:
+    static const size_t kBucketCount = 32;
+
+    void Record(int64_t sample);
+
+    int64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    int64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+
+    int64_t bucket(size_t index) const {
+      return buckets_[index].load(std::memory_order_relaxed);
+    }
+
+   private:
+    friend class MetricsRegistry;
+
+    Histogram();
+
+    std::atomic<int64_t> count_;
+    std::atomic<int64_t> sum_;
+    std::atomic<int64_t> buckets_[kBucketCount];
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(Histogram);
+  };
+
+  static MetricsRegistry& Shared();
+
+  // Registration is idempotent per name and returns a pointer that stays
+  // valid for the life of the process. Register once at setup and keep the
+  // pointer; registration takes a lock, updates do not.
+  Counter* RegisterCounter(const std::string& name);
+  Gauge* RegisterGauge(const std::string& name);
+  Histogram* RegisterHistogram(const std::string& name);
+
+  // Serializes all instruments as one JSON object.
+  std::string DumpAsJSON() const;
+
+  // Fleet telemetry push: delivers a JSON snapshot to |handler| every
+  // |interval| on the IO thread until stopped. Setting a new handler or
+  // interval restarts the cadence.
+  using PushHandler = std::function<void(const std::string& metrics_json)>;
+  void StartPeriodicPush(PushHandler handler, ftl::TimeDelta interval);
+  void StopPeriodicPush();
+
+ private:
+  MetricsRegistry();
+
+  ~MetricsRegistry();
+
+  void SchedulePush();
+
+  mutable std::mutex registration_mutex_;
+  std::map<std::string, std::unique_ptr<Counter>> counters_;
+  std::map<std::string, std::unique_ptr<Gauge>> gauges_;
+  std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+
+  std::mutex push_mutex_;
+  PushHandler push_handler_;
+  ftl::TimeDelta push_interval_;
+  // Bumped to invalidate scheduled pushes from an earlier configuration.
+  uint64_t push_generation_ = 0;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(MetricsRegistry);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_METRICS_REGISTRY_H_
@@ -38,8 +38,58 @@ void NullRasterizer::Clear(SkColor color, const SkISize& size) {
 }
 
 void NullRasterizer::Draw(
-    ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) {
+    ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline) {
   // Null rasterizer. Nothing to do.
 }
 
+void NullRasterizer::DrawWarmUpPictures(
+    std::vector<sk_sp<SkPicture>> pictures) {
+  // Null rasterizer. Nothing to do.
+}
+
+void NullRasterizer::SetResourceCacheLimits(int max_resource_count,
+                                            size_t max_resource_bytes) {
+  // Null rasterizer. Nothing to do.
+}
+
+void NullRasterizer::PurgeResourceCache() {
+  // Null rasterizer. Nothing to do.
+}
+
+void NullRasterizer::SetSceneChangeCallback(SceneChangeCallback callback) {
+  // Null rasterizer. There will never be a scene to report.
+}
+
+void NullRasterizer::SetFrameTimingCallback(FrameTimingCallback callback) {
+  // Null rasterizer. No frames are drawn, so there are no timings to report.
+}
+
+void NullRasterizer::PrewarmSurface() {
+  // Null rasterizer. Nothing to do.
+}
+
+void NullRasterizer::PreRenderLayerTree(
+    std::unique_ptr<flow::LayerTree> layer_tree) {
+  // Null rasterizer. Nothing to do.
+}
+
+void NullRasterizer::PresentPreRenderedFrame() {
+  // Null rasterizer. Nothing to do.
+}
+
+void NullRasterizer::SnapshotLastLayerTree(const std::string& path) {
+  // Null rasterizer. There is never a presented tree to snapshot.
+}
+
+void NullRasterizer::SetCacheHintRoute(const std::string& route) {
+  // Null rasterizer. There is no raster cache to hint.
+}
+
+void NullRasterizer::CaptureNextFrame(ScreenshotCallback callback) {
+  // Null rasterizer. There will never be a frame to capture.
+  if (callback) {
+    callback(nullptr);
+  }
+}
+
 }  // namespace shell
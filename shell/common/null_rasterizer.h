@@ -28,7 +28,30 @@ class NullRasterizer : public Rasterizer {
 
   flow::LayerTree* GetLastLayerTree() override;
 
-  void Draw(ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) override;
+  void Draw(ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline) override;
+
+  void DrawWarmUpPictures(std::vector<sk_sp<SkPicture>> pictures) override;
+
+  void CaptureNextFrame(ScreenshotCallback callback) override;
+
+  void SetSceneChangeCallback(SceneChangeCallback callback) override;
+
+  void SetFrameTimingCallback(FrameTimingCallback callback) override;
+
+  void SetResourceCacheLimits(int max_resource_count,
+                              size_t max_resource_bytes) override;
+
+  void PurgeResourceCache() override;
+
+  void PrewarmSurface() override;
+
+  void PreRenderLayerTree(std::unique_ptr<flow::LayerTree> layer_tree) override;
+
+  void PresentPreRenderedFrame() override;
+
+  void SnapshotLastLayerTree(const std::string& path) override;
+
+  void SetCacheHintRoute(const std::string& route) override;
 
  private:
   ftl::WeakPtrFactory<NullRasterizer> weak_factory_;
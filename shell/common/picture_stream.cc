@@ -0,0 +1,525 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/picture_stream.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "lib/ftl/logging.h"
+#include "lib/ftl/synchronization/waitable_event.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageDeserializer.h"
+#include "third_party/skia/include/core/SkPixelSerializer.h"
+
+namespace shell {
+
+namespace {
+
+// Stream layout:
+//   "FLPS" magic, u32 version.
+//   Records, each introduced by a u8 type:
+//     kImagePayloadRecord: u64 content hash, u32 width, u32 height,
+//       u32 color type, u32 alpha type, u64 row bytes, u32 raw size,
+//       u32 stored size, stored bytes.
+//     kPictureRecord: u32 raw size, u32 stored size, stored bytes.
+//   A record's bytes are LZ compressed when stored size < raw size and
+//   raw otherwise. Payload records always precede the first picture that
+//   references them, so a loader can build its payload table in one pass.
+const char kStreamMagic[4] = {'F', 'L', 'P', 'S'};
+const uint32_t kStreamVersion = 1;
+
+const uint8_t kImagePayloadRecord = 0;
+const uint8_t kPictureRecord = 1;
+
+// Marker embedded in a picture's image data slots in place of the pixels;
+// resolved against payload records when the stream is loaded.
+const char kImageReferenceMagic[8] = {'F', 'L', 'P', 'S', 'I', 'R', 'E', 'F'};
+const size_t kImageReferenceSize = sizeof(kImageReferenceMagic) + 8;
+
+uint64_t Fnv1a64(const uint8_t* data, size_t size, uint64_t hash) {
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+const uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+
+// ---------------------------------------------------------------------------
+// A small LZ77 block codec in the style of LZ4: token with literal and
+// match length nibbles (255-extended), raw literals, 16-bit match offsets
+// within a 64KB window. Self-contained so the stream format introduces no
+// new dependency; greedy matching keeps compression fast enough for the
+// writer thread to keep up with capture.
+// ---------------------------------------------------------------------------
+
+const size_t kMinMatchLength = 4;
+const size_t kHashBits = 13;
+const size_t kMaxMatchOffset = 65535;
+
+uint32_t ReadUnaligned32(const uint8_t* ptr) {
+  uint32_t value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void PutExtendedLength(std::vector<uint8_t>* out, size_t value) {
+  while (value >= 255) {
+    out->push_back(255);
+    value -= 255;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+// Returns an empty vector when the input does not shrink; callers store
+// such blocks raw.
+std::vector<uint8_t> LZCompress(const uint8_t* data, size_t size) {
+  std::vector<uint8_t> out;
+  if (size < 16) {
+    return out;
+  }
+  out.reserve(size);
+
+  // Positions are stored offset by one so zero means an empty entry.
+  std::vector<uint32_t> table(1 << kHashBits, 0);
+
+  const size_t match_limit = size - 5;
+  size_t anchor = 0;
+  size_t ip = 0;
+
+  while (ip + kMinMatchLength <= match_limit) {
+    const uint32_t sequence = ReadUnaligned32(data + ip);
+    const uint32_t slot = HashSequence(sequence);
+    const uint32_t candidate = table[slot];
+    table[slot] = static_cast<uint32_t>(ip + 1);
+
+    if (candidate == 0 || ip - (candidate - 1) > kMaxMatchOffset ||
+        ReadUnaligned32(data + candidate - 1) != sequence) {
+      ip++;
+      continue;
+    }
+
+    const size_t match_pos = candidate - 1;
+    size_t match_length = kMinMatchLength;
+    while (ip + match_length < match_limit &&
+           data[match_pos + match_length] == data[ip + match_length]) {
+      match_length++;
+    }
+
+    const size_t literal_length = ip - anchor;
+    const uint8_t token =
+        static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4 |
+                             std::min<size_t>(match_length - kMinMatchLength,
+                                              15));
+    out.push_back(token);
+    if (literal_length >= 15) {
+      PutExtendedLength(&out, literal_length - 15);
+    }
+    out.insert(out.end(), data + anchor, data + ip);
+    const uint16_t offset = static_cast<uint16_t>(ip - match_pos);
+    out.push_back(offset & 0xff);
+    out.push_back(offset >> 8);
+    if (match_length - kMinMatchLength >= 15) {
+      PutExtendedLength(&out, match_length - kMinMatchLength - 15);
+    }
+
+    ip += match_length;
+    anchor = ip;
+
+    if (out.size() >= size) {
+      return std::vector<uint8_t>();
+    }
+  }
+
+  const size_t literal_length = size - anchor;
+  out.push_back(static_cast<uint8_t>(std::min<size_t>(literal_length, 15))
+                << 4);
+  if (literal_length >= 15) {
+    PutExtendedLength(&out, literal_length - 15);
+  }
+  out.insert(out.end(), data + anchor, data + size);
+
+  if (out.size() >= size) {
+    return std::vector<uint8_t>();
+  }
+  return out;
+}
+
+bool LZDecompress(const uint8_t* in,
+                  size_t in_size,
+                  uint8_t* out,
+                  size_t out_size) {
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < in_size) {
+    const uint8_t token = in[ip++];
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      uint8_t byte;
+      do {
+        if (ip >= in_size) {
+          return false;
+        }
+        byte = in[ip++];
+        literal_length += byte;
+      } while (byte == 255);
+    }
+    if (ip + literal_length > in_size || op + literal_length > out_size) {
+      return false;
+    }
+    memcpy(out + op, in + ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip >= in_size) {
+      // The final sequence carries literals only.
+      break;
+    }
+
+    if (ip + 2 > in_size) {
+      return false;
+    }
+    const size_t offset = in[ip] | (in[ip + 1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return false;
+    }
+
+    size_t match_length = token & 15;
+    if (match_length == 15) {
+      uint8_t byte;
+      do {
+        if (ip >= in_size) {
+          return false;
+        }
+        byte = in[ip++];
+        match_length += byte;
+      } while (byte == 255);
+    }
+    match_length += kMinMatchLength;
+    if (op + match_length > out_size) {
+      return false;
+    }
+    // Matches may overlap their own output; copy bytewise.
+    for (size_t i = 0; i < match_length; i++) {
+      out[op] = out[op - offset];
+      op++;
+    }
+  }
+  return op == out_size;
+}
+
+// ---------------------------------------------------------------------------
+// Writing
+// ---------------------------------------------------------------------------
+
+void WriteU32(SkWStream* stream, uint32_t value) {
+  stream->write(&value, sizeof(value));
+}
+
+void WriteU64(SkWStream* stream, uint64_t value) {
+  stream->write(&value, sizeof(value));
+}
+
+void WriteBlock(SkWStream* stream, const uint8_t* data, size_t size) {
+  std::vector<uint8_t> compressed = LZCompress(data, size);
+  WriteU32(stream, size);
+  if (compressed.empty()) {
+    WriteU32(stream, size);
+    stream->write(data, size);
+  } else {
+    WriteU32(stream, compressed.size());
+    stream->write(compressed.data(), compressed.size());
+  }
+}
+
+struct PendingPayload {
+  uint64_t hash;
+  SkImageInfo info;
+  size_t row_bytes;
+  std::vector<uint8_t> pixels;
+};
+
+// Replaces raster image pixels with a content-hash reference while the
+// picture serializes, collecting each payload seen for the first time so
+// the writer can emit it once ahead of the picture record. Images that
+// already carry encoded data (typically unique photos) are embedded
+// inline as-is: re-encoding them would force a decode for no size win.
+class DedupingPixelSerializer : public SkPixelSerializer {
+ public:
+  DedupingPixelSerializer(std::unordered_set<uint64_t>* written_payloads,
+                          std::vector<PendingPayload>* new_payloads)
+      : written_payloads_(written_payloads), new_payloads_(new_payloads) {}
+
+ protected:
+  bool onUseEncodedData(const void*, size_t) override { return true; }
+
+  SkData* onEncode(const SkPixmap& pixmap) override {
+    const uint8_t* pixels = static_cast<const uint8_t*>(pixmap.addr());
+    if (pixels == nullptr) {
+      return nullptr;
+    }
+    const size_t byte_size = pixmap.rowBytes() * pixmap.height();
+
+    uint64_t hash = kFnvOffsetBasis;
+    const int32_t dimensions[] = {
+        pixmap.width(), pixmap.height(),
+        static_cast<int32_t>(pixmap.colorType()),
+        static_cast<int32_t>(pixmap.alphaType()),
+        static_cast<int32_t>(pixmap.rowBytes())};
+    hash = Fnv1a64(reinterpret_cast<const uint8_t*>(dimensions),
+                   sizeof(dimensions), hash);
+    hash = Fnv1a64(pixels, byte_size, hash);
+
+    if (written_payloads_->insert(hash).second) {
+      PendingPayload payload;
+      payload.hash = hash;
+      payload.info = pixmap.info();
+      payload.row_bytes = pixmap.rowBytes();
+      payload.pixels.assign(pixels, pixels + byte_size);
+      new_payloads_->push_back(std::move(payload));
+    }
+
+    uint8_t reference[kImageReferenceSize];
+    memcpy(reference, kImageReferenceMagic, sizeof(kImageReferenceMagic));
+    memcpy(reference + sizeof(kImageReferenceMagic), &hash, sizeof(hash));
+    return SkData::MakeWithCopy(reference, sizeof(reference)).release();
+  }
+
+ private:
+  std::unordered_set<uint64_t>* written_payloads_;
+  std::vector<PendingPayload>* new_payloads_;
+};
+
+// ---------------------------------------------------------------------------
+// Loading
+// ---------------------------------------------------------------------------
+
+class StreamReader {
+ public:
+  StreamReader(const uint8_t* data, size_t size)
+      : data_(data), size_(size), position_(0) {}
+
+  bool ReadU32(uint32_t* value) { return ReadBytes(value, sizeof(*value)); }
+
+  bool ReadU64(uint64_t* value) { return ReadBytes(value, sizeof(*value)); }
+
+  bool ReadBlock(std::vector<uint8_t>* block) {
+    uint32_t raw_size = 0;
+    uint32_t stored_size = 0;
+    if (!ReadU32(&raw_size) || !ReadU32(&stored_size) ||
+        position_ + stored_size > size_) {
+      return false;
+    }
+    block->resize(raw_size);
+    bool ok;
+    if (stored_size == raw_size) {
+      memcpy(block->data(), data_ + position_, raw_size);
+      ok = true;
+    } else {
+      ok = LZDecompress(data_ + position_, stored_size, block->data(),
+                        raw_size);
+    }
+    position_ += stored_size;
+    return ok;
+  }
+
+  bool ReadBytes(void* destination, size_t size) {
+    if (position_ + size > size_) {
+      return false;
+    }
+    memcpy(destination, data_ + position_, size);
+    position_ += size;
+    return true;
+  }
+
+  bool AtEnd() const { return position_ >= size_; }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t position_;
+};
+
+class ReferenceImageDeserializer : public SkImageDeserializer {
+ public:
+  explicit ReferenceImageDeserializer(
+      const std::unordered_map<uint64_t, sk_sp<SkImage>>* payloads)
+      : payloads_(payloads) {}
+
+  sk_sp<SkImage> makeFromData(SkData* data, const SkIRect* subset) override {
+    return makeFromMemory(data->data(), data->size(), subset);
+  }
+
+  sk_sp<SkImage> makeFromMemory(const void* data,
+                                size_t length,
+                                const SkIRect* subset) override {
+    if (length == kImageReferenceSize &&
+        memcmp(data, kImageReferenceMagic, sizeof(kImageReferenceMagic)) ==
+            0) {
+      uint64_t hash;
+      memcpy(&hash,
+             static_cast<const uint8_t*>(data) + sizeof(kImageReferenceMagic),
+             sizeof(hash));
+      auto found = payloads_->find(hash);
+      return found != payloads_->end() ? found->second : nullptr;
+    }
+    // Inline encoded data, embedded as-is by the writer.
+    return SkImage::MakeFromEncoded(SkData::MakeWithCopy(data, length),
+                                    subset);
+  }
+
+ private:
+  const std::unordered_map<uint64_t, sk_sp<SkImage>>* payloads_;
+};
+
+}  // namespace
+
+PictureStreamWriter::PictureStreamWriter(std::string path)
+    : path_(std::move(path)), thread_("io.flutter.picture_stream") {
+  thread_.GetTaskRunner()->PostTask([this]() { OpenOnWriterThread(); });
+}
+
+PictureStreamWriter::~PictureStreamWriter() {
+  ftl::AutoResetWaitableEvent latch;
+  thread_.GetTaskRunner()->PostTask([this, &latch]() {
+    if (stream_) {
+      stream_->flush();
+      stream_.reset();
+    }
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+void PictureStreamWriter::WritePicture(sk_sp<SkPicture> picture) {
+  if (picture == nullptr) {
+    return;
+  }
+  thread_.GetTaskRunner()->PostTask([ this, picture = std::move(picture) ]() {
+    WritePictureOnWriterThread(std::move(picture));
+  });
+}
+
+void PictureStreamWriter::OpenOnWriterThread() {
+  stream_ = std::make_unique<SkFILEWStream>(path_.c_str());
+  if (!stream_->isValid()) {
+    FTL_LOG(ERROR) << "Could not open picture stream for writing: " << path_;
+    stream_.reset();
+    return;
+  }
+  stream_->write(kStreamMagic, sizeof(kStreamMagic));
+  WriteU32(stream_.get(), kStreamVersion);
+}
+
+void PictureStreamWriter::WritePictureOnWriterThread(
+    sk_sp<SkPicture> picture) {
+  if (stream_ == nullptr) {
+    return;
+  }
+
+  std::vector<PendingPayload> new_payloads;
+  DedupingPixelSerializer serializer(&written_payloads_, &new_payloads);
+
+  SkDynamicMemoryWStream picture_stream;
+  picture->serialize(&picture_stream, &serializer);
+  sk_sp<SkData> picture_data = picture_stream.detachAsData();
+
+  // Payloads first, so the loader's single pass resolves every reference.
+  for (const auto& payload : new_payloads) {
+    stream_->write(&kImagePayloadRecord, sizeof(kImagePayloadRecord));
+    WriteU64(stream_.get(), payload.hash);
+    WriteU32(stream_.get(), payload.info.width());
+    WriteU32(stream_.get(), payload.info.height());
+    WriteU32(stream_.get(), static_cast<uint32_t>(payload.info.colorType()));
+    WriteU32(stream_.get(), static_cast<uint32_t>(payload.info.alphaType()));
+    WriteU64(stream_.get(), payload.row_bytes);
+    WriteBlock(stream_.get(), payload.pixels.data(), payload.pixels.size());
+  }
+
+  stream_->write(&kPictureRecord, sizeof(kPictureRecord));
+  WriteBlock(stream_.get(),
+             static_cast<const uint8_t*>(picture_data->data()),
+             picture_data->size());
+}
+
+std::vector<sk_sp<SkPicture>> ReadPictureStream(const std::string& path) {
+  std::vector<sk_sp<SkPicture>> pictures;
+
+  sk_sp<SkData> file = SkData::MakeFromFileName(path.c_str());
+  if (file == nullptr) {
+    return pictures;
+  }
+
+  StreamReader reader(static_cast<const uint8_t*>(file->data()),
+                      file->size());
+
+  char magic[sizeof(kStreamMagic)];
+  uint32_t version = 0;
+  if (!reader.ReadBytes(magic, sizeof(magic)) ||
+      memcmp(magic, kStreamMagic, sizeof(kStreamMagic)) != 0 ||
+      !reader.ReadU32(&version) || version != kStreamVersion) {
+    return pictures;
+  }
+
+  std::unordered_map<uint64_t, sk_sp<SkImage>> payloads;
+  ReferenceImageDeserializer deserializer(&payloads);
+
+  while (!reader.AtEnd()) {
+    uint8_t record_type;
+    if (!reader.ReadBytes(&record_type, sizeof(record_type))) {
+      break;
+    }
+    if (record_type == kImagePayloadRecord) {
+      uint64_t hash = 0;
+      uint32_t width = 0;
+      uint32_t height = 0;
+      uint32_t color_type = 0;
+      uint32_t alpha_type = 0;
+      uint64_t row_bytes = 0;
+      std::vector<uint8_t> pixels;
+      if (!reader.ReadU64(&hash) || !reader.ReadU32(&width) ||
+          !reader.ReadU32(&height) || !reader.ReadU32(&color_type) ||
+          !reader.ReadU32(&alpha_type) || !reader.ReadU64(&row_bytes) ||
+          !reader.ReadBlock(&pixels)) {
+        break;
+      }
+      SkImageInfo info = SkImageInfo::Make(
+          width, height, static_cast<SkColorType>(color_type),
+          static_cast<SkAlphaType>(alpha_type));
+      if (pixels.size() < info.getSafeSize(row_bytes)) {
+        break;
+      }
+      payloads[hash] = SkImage::MakeRasterCopy(
+          SkPixmap(info, pixels.data(), row_bytes));
+    } else if (record_type == kPictureRecord) {
+      std::vector<uint8_t> picture_data;
+      if (!reader.ReadBlock(&picture_data)) {
+        break;
+      }
+      SkMemoryStream picture_stream(picture_data.data(), picture_data.size(),
+                                    false);
+      sk_sp<SkPicture> picture =
+          SkPicture::MakeFromStream(&picture_stream, &deserializer);
+      if (picture) {
+        pictures.push_back(std::move(picture));
+      }
+    } else {
+      break;
+    }
+  }
+
+  return pictures;
+}
+
+}  // namespace shell
@@ -0,0 +1,59 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_PICTURE_STREAM_H_
+#define SHELL_COMMON_PICTURE_STREAM_H_
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/thread.h"
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace shell {
+
+// Writes captured SkPictures to a file in a compact framed binary format,
+// replacing the PNG-per-image serialization of SerializePicture for frame
+// dumps. Raster image payloads are deduplicated by content hash across the
+// whole stream (a static background is stored once per session, not once
+// per frame) and stored raw behind a fast LZ block codec instead of being
+// PNG encoded. Pictures are serialized and written incrementally on a
+// dedicated background thread; WritePicture may be called from any thread
+// and returns immediately.
+class PictureStreamWriter {
+ public:
+  explicit PictureStreamWriter(std::string path);
+
+  // Flushes and closes the stream, blocking until queued frames are
+  // written.
+  ~PictureStreamWriter();
+
+  // Appends one frame to the stream.
+  void WritePicture(sk_sp<SkPicture> picture);
+
+ private:
+  void OpenOnWriterThread();
+  void WritePictureOnWriterThread(sk_sp<SkPicture> picture);
+
+  const std::string path_;
+  fml::Thread thread_;
+  // Used exclusively on the writer thread.
+  std::unique_ptr<SkFILEWStream> stream_;
+  std::unordered_set<uint64_t> written_payloads_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PictureStreamWriter);
+};
+
+// Loads every frame of a stream written by PictureStreamWriter so captured
+// production frames can be replayed in a bench harness. Returns an empty
+// vector if the file cannot be read or is not a picture stream.
+std::vector<sk_sp<SkPicture>> ReadPictureStream(const std::string& path);
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_PICTURE_STREAM_H_
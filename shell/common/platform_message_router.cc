@@ -0,0 +1,146 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/platform_message_router.h"
+
+#include <utility>
+
+#include "flutter/common/threads.h"
+#include "flutter/fml/thread_pool.h"
+#include "flutter/shell/common/engine.h"
+
+namespace shell {
+
+namespace {
+
+void CompleteEmpty(const ftl::RefPtr<blink::PlatformMessage>& message) {
+  if (auto response = message->response()) {
+    response->CompleteEmpty();
+  }
+}
+
+}  // namespace
+
+PlatformMessageRouter::PlatformMessageRouter()
+    : next_sequence_(0), drain_pending_(false) {}
+
+PlatformMessageRouter::~PlatformMessageRouter() = default;
+
+void PlatformMessageRouter::SetChannelPolicy(const std::string& channel,
+                                             ChannelPolicy policy) {
+  ftl::MutexLocker lock(&mutex_);
+  queues_[channel].policy = policy;
+}
+
+void PlatformMessageRouter::SetBackgroundHandler(const std::string& channel,
+                                                 BackgroundHandler handler) {
+  ftl::MutexLocker lock(&mutex_);
+  if (handler) {
+    background_handlers_[channel] = std::move(handler);
+  } else {
+    background_handlers_.erase(channel);
+  }
+}
+
+void PlatformMessageRouter::CancelPending(const std::string& channel) {
+  std::deque<PendingMessage> canceled;
+  {
+    ftl::MutexLocker lock(&mutex_);
+    auto found = queues_.find(channel);
+    if (found == queues_.end()) {
+      return;
+    }
+    canceled.swap(found->second.pending);
+  }
+  // Responses are completed outside the lock: CompleteEmpty posts back to
+  // the platform thread and there is no reason to hold the queues hostage
+  // while it does.
+  for (const auto& entry : canceled) {
+    CompleteEmpty(entry.message);
+  }
+}
+
+void PlatformMessageRouter::Dispatch(ftl::RefPtr<blink::PlatformMessage> message,
+                                     ftl::WeakPtr<Engine> engine) {
+  ftl::RefPtr<blink::PlatformMessage> superseded;
+  bool schedule_drain = false;
+  {
+    ftl::MutexLocker lock(&mutex_);
+
+    auto handler = background_handlers_.find(message->channel());
+    if (handler != background_handlers_.end()) {
+      fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+          [ handler = handler->second, message = std::move(message) ] {
+            handler(message);
+          });
+      return;
+    }
+
+    ChannelQueue& queue = queues_[message->channel()];
+    if (queue.policy.coalesce && !queue.pending.empty()) {
+      superseded = std::move(queue.pending.back().message);
+      queue.pending.back().message = std::move(message);
+    } else {
+      queue.pending.push_back({std::move(message), next_sequence_++});
+    }
+
+    if (!drain_pending_) {
+      drain_pending_ = true;
+      schedule_drain = true;
+    }
+  }
+
+  if (superseded) {
+    CompleteEmpty(superseded);
+  }
+
+  if (schedule_drain) {
+    blink::Threads::UI()->PostTask([ this, engine = std::move(engine) ] {
+      DrainOnUIThread(std::move(engine));
+    });
+  }
+}
+
+ftl::RefPtr<blink::PlatformMessage> PlatformMessageRouter::TakeNextLocked() {
+  ChannelQueue* best = nullptr;
+  for (auto& entry : queues_) {
+    ChannelQueue& queue = entry.second;
+    if (queue.pending.empty()) {
+      continue;
+    }
+    if (best == nullptr ||
+        queue.policy.priority < best->policy.priority ||
+        (queue.policy.priority == best->policy.priority &&
+         queue.pending.front().sequence < best->pending.front().sequence)) {
+      best = &queue;
+    }
+  }
+  if (best == nullptr) {
+    return nullptr;
+  }
+  auto message = std::move(best->pending.front().message);
+  best->pending.pop_front();
+  return message;
+}
+
+void PlatformMessageRouter::DrainOnUIThread(ftl::WeakPtr<Engine> engine) {
+  while (true) {
+    ftl::RefPtr<blink::PlatformMessage> message;
+    {
+      ftl::MutexLocker lock(&mutex_);
+      message = TakeNextLocked();
+      if (!message) {
+        drain_pending_ = false;
+        return;
+      }
+    }
+    if (engine) {
+      engine->DispatchPlatformMessage(std::move(message));
+    } else {
+      CompleteEmpty(message);
+    }
+  }
+}
+
+}  // namespace shell
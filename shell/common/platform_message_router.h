@@ -0,0 +1,102 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_PLATFORM_MESSAGE_ROUTER_H_
+#define SHELL_COMMON_PLATFORM_MESSAGE_ROUTER_H_
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/lib/ui/window/platform_message.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_ptr.h"
+#include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/synchronization/mutex.h"
+
+namespace shell {
+
+class Engine;
+
+// Routes platform messages from the platform thread to their consumers.
+// Messages used to be posted to the UI thread one task per message, so a
+// burst on a high-rate channel (sensors, telemetry) could queue ahead of
+// input. The router instead keeps one queue per channel and drains them on
+// the UI thread in priority order, optionally coalescing sensor-style
+// channels down to their newest undelivered message. Channels that never
+// need to reach Dart can be handed to a background handler and bypass the
+// UI thread entirely.
+class PlatformMessageRouter {
+ public:
+  enum class ChannelPriority {
+    // Drained before everything else; for input and gesture channels.
+    kInput,
+    kNormal,
+    // Drained only once no higher-priority channel has pending messages.
+    kLow,
+  };
+
+  struct ChannelPolicy {
+    ChannelPriority priority = ChannelPriority::kNormal;
+    // Keep only the newest undelivered message for the channel. Responses
+    // of superseded messages are completed empty.
+    bool coalesce = false;
+  };
+
+  using BackgroundHandler =
+      std::function<void(ftl::RefPtr<blink::PlatformMessage>)>;
+
+  PlatformMessageRouter();
+
+  ~PlatformMessageRouter();
+
+  // May be called from any thread. Applies to messages dispatched after the
+  // call; channels without an explicit policy are kNormal and uncoalesced.
+  void SetChannelPolicy(const std::string& channel, ChannelPolicy policy);
+
+  // Handles every message on the channel by invoking the handler on the
+  // shared worker pool. Such messages never reach the UI thread or Dart.
+  void SetBackgroundHandler(const std::string& channel,
+                            BackgroundHandler handler);
+
+  // Drops all undelivered messages for the channel, completing their
+  // responses empty. May be called from any thread.
+  void CancelPending(const std::string& channel);
+
+  // Called on the platform thread.
+  void Dispatch(ftl::RefPtr<blink::PlatformMessage> message,
+                ftl::WeakPtr<Engine> engine);
+
+ private:
+  struct PendingMessage {
+    ftl::RefPtr<blink::PlatformMessage> message;
+    // Arrival order, used to keep delivery FIFO within a priority level.
+    uint64_t sequence;
+  };
+
+  struct ChannelQueue {
+    ChannelPolicy policy;
+    std::deque<PendingMessage> pending;
+  };
+
+  void DrainOnUIThread(ftl::WeakPtr<Engine> engine);
+
+  ftl::RefPtr<blink::PlatformMessage> TakeNextLocked();
+
+  // Guards everything below it.
+  ftl::Mutex mutex_;
+  std::unordered_map<std::string, ChannelQueue> queues_;
+  std::unordered_map<std::string, BackgroundHandler> background_handlers_;
+  uint64_t next_sequence_;
+  // Whether a drain task is already on its way to the UI thread. At most one
+  // is in flight regardless of how many messages arrive.
+  bool drain_pending_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PlatformMessageRouter);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_PLATFORM_MESSAGE_ROUTER_H_
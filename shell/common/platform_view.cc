@@ -6,8 +6,11 @@
 
 #include <utility>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
 #include "flutter/lib/ui/painting/resource_context.h"
+#include "flutter/shell/common/jank_reporter.h"
+#include "flutter/shell/common/vsync_waiter_replay.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter_fallback.h"
 #include "lib/ftl/functional/make_copyable.h"
@@ -44,12 +47,21 @@ void PlatformView::PostAddToShellTask() {
 
 void PlatformView::DispatchPlatformMessage(
     ftl::RefPtr<blink::PlatformMessage> message) {
-  blink::Threads::UI()->PostTask(
-      [ engine = engine_->GetWeakPtr(), message = std::move(message) ] {
-        if (engine) {
-          engine->DispatchPlatformMessage(message);
-        }
-      });
+  message_router_.Dispatch(std::move(message), engine_->GetWeakPtr());
+}
+
+void PlatformView::NotifyMemoryPressure(blink::MemoryPressureLevel level) {
+  blink::MemoryPressureListenerRegistry::Notify(level);
+}
+
+void PlatformView::SetPerformanceProfileMode(
+    blink::PerformanceProfileMode mode) {
+  blink::PerformanceProfileObserverRegistry::SetProfile(
+      blink::PerformanceProfile::ForMode(mode));
+}
+
+std::vector<uint8_t> PlatformView::GetLastJankReport() {
+  return JankReporter::Shared().CopyLastReport();
 }
 
 void PlatformView::DispatchSemanticsAction(int32_t id,
@@ -123,8 +135,22 @@ ftl::WeakPtr<PlatformView> PlatformView::GetWeakPtr() {
 }
 
 VsyncWaiter* PlatformView::GetVsyncWaiter() {
-  if (!vsync_waiter_)
+  if (!vsync_waiter_) {
+    // A replay log takes over vsync and input delivery entirely. Platform
+    // views that override this with a native vsync source keep real timing;
+    // the test and benchmark shells all land here.
+    const std::string& replay_path =
+        blink::Settings::Get().replay_events_path;
+    if (!replay_path.empty()) {
+      ReplayLog log;
+      if (ReplayLog::Load(replay_path, &log)) {
+        vsync_waiter_ = std::make_unique<VsyncWaiterReplay>(
+            std::move(log), engine_->GetWeakPtr());
+        return vsync_waiter_.get();
+      }
+    }
     vsync_waiter_ = std::make_unique<VsyncWaiterFallback>();
+  }
   return vsync_waiter_.get();
 }
 
@@ -6,9 +6,13 @@
 #define COMMON_PLATFORM_VIEW_H_
 
 #include <memory>
+#include <vector>
 
+#include "flutter/common/memory_pressure_listener.h"
+#include "flutter/common/performance_profile.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/platform_message_router.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/surface.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -41,6 +45,22 @@ class PlatformView {
   void DispatchSemanticsAction(int32_t id, blink::SemanticsAction action);
   void SetSemanticsEnabled(bool enabled);
 
+  // Broadcasts an OS memory pressure signal to every cache registered with
+  // the MemoryPressureListenerRegistry, each on its owning thread. May be
+  // called from the platform thread.
+  void NotifyMemoryPressure(blink::MemoryPressureLevel level);
+
+  // Applies a performance profile preset engine-wide without a restart:
+  // the animator, raster cache, and image decode queue pick up their new
+  // budgets on their own threads. May be called from the platform thread.
+  void SetPerformanceProfileMode(blink::PerformanceProfileMode mode);
+
+  // Returns the most recent jank forensics report captured by the engine —
+  // see JankReporter for the format — or an empty vector when no jank has
+  // been captured. Embedders attach it to their feedback or crash uploads.
+  // May be called from the platform thread.
+  std::vector<uint8_t> GetLastJankReport();
+
   void NotifyCreated(std::unique_ptr<Surface> surface);
 
   void NotifyCreated(std::unique_ptr<Surface> surface,
@@ -61,6 +81,7 @@ class PlatformView {
 
   Rasterizer& rasterizer() { return *rasterizer_; }
   Engine& engine() { return *engine_; }
+  PlatformMessageRouter& message_router() { return message_router_; }
 
   virtual void RunFromSource(const std::string& assets_directory,
                              const std::string& main,
@@ -76,6 +97,7 @@ class PlatformView {
       ftl::AutoResetWaitableEvent* event);
 
   SurfaceConfig surface_config_;
+  PlatformMessageRouter message_router_;
   std::unique_ptr<Rasterizer> rasterizer_;
   std::unique_ptr<Engine> engine_;
   std::unique_ptr<VsyncWaiter> vsync_waiter_;
@@ -6,13 +6,17 @@
 
 #include <string.h>
 
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "flutter/common/threads.h"
+#include "flutter/fml/trace_recorder.h"
+#include "flutter/shell/common/metrics_registry.h"
 #include "flutter/shell/common/picture_serializer.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell.h"
+#include "flutter/sky/engine/wtf/WTF.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/src/utils/SkBase64.h"
@@ -122,6 +126,15 @@ void PlatformViewServiceProtocol::RegisterHook(bool running_precompiled_code) {
   // Screenshot.
   Dart_RegisterRootServiceRequestCallback(kScreenshotExtensionName, &Screenshot,
                                           nullptr);
+  // Dump of the in-process trace recorder.
+  Dart_RegisterRootServiceRequestCallback(kGetRecentTraceExtensionName,
+                                          &GetRecentTrace, nullptr);
+  // Native allocator telemetry.
+  Dart_RegisterRootServiceRequestCallback(kGetAllocationStatsExtensionName,
+                                          &GetAllocationStats, nullptr);
+  // Snapshot of the engine metrics registry.
+  Dart_RegisterRootServiceRequestCallback(kGetMetricsExtensionName,
+                                          &GetMetrics, nullptr);
   // The following set of service protocol extensions require debug build
   if (running_precompiled_code) {
     return;
@@ -232,6 +245,71 @@ bool PlatformViewServiceProtocol::ListViews(const char* method,
   return true;
 }
 
+const char* PlatformViewServiceProtocol::kGetRecentTraceExtensionName =
+    "_flutter.getRecentTrace";
+
+bool PlatformViewServiceProtocol::GetRecentTrace(const char* method,
+                                                 const char** param_keys,
+                                                 const char** param_values,
+                                                 intptr_t num_params,
+                                                 void* user_data,
+                                                 const char** json_object) {
+  std::stringstream response;
+  response << "{\"type\":\"RecentTrace\",\"traceEvents\":"
+           << fml::tracing::TraceRecorder::GetProcessRecorder()
+                  .DumpAsChromeTraceJSON()
+           << "}";
+  *json_object = strdup(response.str().c_str());
+  return true;
+}
+
+const char* PlatformViewServiceProtocol::kGetMetricsExtensionName =
+    "_flutter.getMetrics";
+
+bool PlatformViewServiceProtocol::GetMetrics(const char* method,
+                                             const char** param_keys,
+                                             const char** param_values,
+                                             intptr_t num_params,
+                                             void* user_data,
+                                             const char** json_object) {
+  std::stringstream response;
+  response << "{\"type\":\"EngineMetrics\",\"metrics\":"
+           << MetricsRegistry::Shared().DumpAsJSON() << "}";
+  *json_object = strdup(response.str().c_str());
+  return true;
+}
+
+const char* PlatformViewServiceProtocol::kGetAllocationStatsExtensionName =
+    "_flutter.getAllocationStats";
+
+static void AppendPartitionStats(std::stringstream* stream,
+                                 const char* name,
+                                 WTF::PartitionRootGeneric* partition) {
+  WTF::PartitionAllocStats stats;
+  WTF::partitionGetStats(partition, &stats);
+  *stream << "{\"name\":\"" << name << "\","
+          << "\"committedBytes\":" << stats.totalCommittedBytes << ","
+          << "\"allocatedBytes\":" << stats.totalAllocatedBytes << ","
+          << "\"allocationCount\":" << stats.totalAllocationCount << ","
+          << "\"freeCount\":" << stats.totalFreeCount << "}";
+}
+
+bool PlatformViewServiceProtocol::GetAllocationStats(
+    const char* method,
+    const char** param_keys,
+    const char** param_values,
+    intptr_t num_params,
+    void* user_data,
+    const char** json_object) {
+  std::stringstream response;
+  response << "{\"type\":\"AllocationStats\",\"partitions\":[";
+  AppendPartitionStats(&response, "buffer",
+                       WTF::Partitions::getBufferPartition());
+  response << "]}";
+  *json_object = strdup(response.str().c_str());
+  return true;
+}
+
 const char* PlatformViewServiceProtocol::kScreenshotExtensionName =
     "_flutter.screenshot";
 
@@ -35,6 +35,30 @@ class PlatformViewServiceProtocol {
                         void* user_data,
                         const char** json_object);
 
+  static const char* kGetRecentTraceExtensionName;
+  static bool GetRecentTrace(const char* method,
+                             const char** param_keys,
+                             const char** param_values,
+                             intptr_t num_params,
+                             void* user_data,
+                             const char** json_object);
+
+  static const char* kGetAllocationStatsExtensionName;
+  static bool GetAllocationStats(const char* method,
+                                 const char** param_keys,
+                                 const char** param_values,
+                                 intptr_t num_params,
+                                 void* user_data,
+                                 const char** json_object);
+
+  static const char* kGetMetricsExtensionName;
+  static bool GetMetrics(const char* method,
+                         const char** param_keys,
+                         const char** param_values,
+                         intptr_t num_params,
+                         void* user_data,
+                         const char** json_object);
+
   static const char* kScreenshotExtensionName;
   static bool Screenshot(const char* method,
                          const char** param_keys,
@@ -0,0 +1,134 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_resampler.h"
+
+#include <string.h>
+
+#include <vector>
+
+namespace shell {
+
+namespace {
+
+bool IsResampledChange(blink::PointerData::Change change) {
+  return change == blink::PointerData::Change::kMove ||
+         change == blink::PointerData::Change::kHover;
+}
+
+}  // namespace
+
+PointerDataResampler::PointerDataResampler() = default;
+
+PointerDataResampler::~PointerDataResampler() = default;
+
+void PointerDataResampler::Enqueue(const blink::PointerDataPacket& packet) {
+  const uint8_t* bytes = packet.data();
+  size_t offset = 0;
+  while (offset + sizeof(blink::PointerData) <= packet.size()) {
+    blink::PointerData data;
+    memcpy(&data, bytes + offset, sizeof(blink::PointerData));
+    offset += sizeof(blink::PointerData) +
+              data.history_count * sizeof(blink::PointerDataHistorySample);
+    // Platform packets carry no history; coalescing happens in Sample().
+    data.history_count = 0;
+    devices_[data.device].queue.push_back(data);
+  }
+}
+
+std::unique_ptr<blink::PointerDataPacket> PointerDataResampler::Sample(
+    ftl::TimePoint sample_time) {
+  // Platform event timestamps and ftl::TimePoint both count from the
+  // monotonic clock on the platforms that feed this path.
+  const int64_t sample_micros =
+      sample_time.ToEpochDelta().ToMicroseconds();
+
+  struct OutputEvent {
+    blink::PointerData data;
+    std::vector<blink::PointerDataHistorySample> history;
+  };
+  std::vector<OutputEvent> output;
+
+  for (auto it = devices_.begin(); it != devices_.end();) {
+    DeviceState& state = it->second;
+
+    blink::PointerData last_move;
+    bool has_last_move = false;
+    std::vector<blink::PointerDataHistorySample> history;
+
+    auto flush_last_move = [&output, &last_move, &history]() {
+      last_move.history_count = history.size();
+      output.push_back({last_move, std::move(history)});
+      history.clear();
+    };
+
+    while (!state.queue.empty() &&
+           state.queue.front().time_stamp <= sample_micros) {
+      blink::PointerData data = state.queue.front();
+      state.queue.pop_front();
+      if (IsResampledChange(data.change)) {
+        // Only the latest due move is delivered as an event; earlier ones
+        // are folded into its history so velocity trackers and the like
+        // still see every platform sample.
+        if (has_last_move) {
+          history.push_back({last_move.time_stamp, last_move.physical_x,
+                             last_move.physical_y, last_move.pressure});
+        }
+        last_move = data;
+        has_last_move = true;
+      } else {
+        if (has_last_move) {
+          flush_last_move();
+          has_last_move = false;
+        }
+        output.push_back({data, {}});
+      }
+    }
+
+    if (has_last_move) {
+      // Interpolate towards the first not-yet-due sample, if there is one,
+      // so the delivered position corresponds to the sample point instead
+      // of whenever the platform happened to report it.
+      if (!state.queue.empty() &&
+          IsResampledChange(state.queue.front().change) &&
+          state.queue.front().time_stamp > last_move.time_stamp) {
+        const blink::PointerData& next = state.queue.front();
+        // Keep the real platform sample in the history; the delivered
+        // position below is synthetic.
+        history.push_back({last_move.time_stamp, last_move.physical_x,
+                           last_move.physical_y, last_move.pressure});
+        double t =
+            static_cast<double>(sample_micros - last_move.time_stamp) /
+            static_cast<double>(next.time_stamp - last_move.time_stamp);
+        t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+        last_move.physical_x +=
+            (next.physical_x - last_move.physical_x) * t;
+        last_move.physical_y +=
+            (next.physical_y - last_move.physical_y) * t;
+        last_move.time_stamp = sample_micros;
+      }
+      flush_last_move();
+    }
+
+    if (state.queue.empty()) {
+      it = devices_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (output.empty()) {
+    return nullptr;
+  }
+
+  auto packet = std::make_unique<blink::PointerDataPacket>();
+  for (const auto& event : output) {
+    packet->AppendPointerData(event.data);
+    for (const auto& sample : event.history)
+      packet->AppendHistorySample(sample);
+  }
+  return packet;
+}
+
+}  // namespace shell
@@ -0,0 +1,53 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_POINTER_DATA_RESAMPLER_H_
+#define SHELL_COMMON_POINTER_DATA_RESAMPLER_H_
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_point.h"
+
+namespace shell {
+
+// Aligns pointer input with the frame clock. Packets arriving from the
+// platform thread are buffered instead of being dispatched immediately;
+// once per frame, Sample() interpolates each device's move events to a
+// sample point just behind frame time and returns one coherent packet.
+// Every frame then consumes input with a consistent age instead of input
+// that is anywhere from zero to a full interval stale, which is what makes
+// scrolling track the finger smoothly.
+class PointerDataResampler {
+ public:
+  PointerDataResampler();
+
+  ~PointerDataResampler();
+
+  // Buffers the events of |packet|.
+  void Enqueue(const blink::PointerDataPacket& packet);
+
+  // Returns the events due at |sample_time|, or null if none are. Discrete
+  // events (down, up, add, remove, cancel) are delivered unmodified in
+  // arrival order; consecutive due move and hover events of a device are
+  // coalesced into a single event whose position is interpolated between
+  // the samples straddling |sample_time|.
+  std::unique_ptr<blink::PointerDataPacket> Sample(ftl::TimePoint sample_time);
+
+ private:
+  struct DeviceState {
+    std::deque<blink::PointerData> queue;
+  };
+
+  std::unordered_map<int64_t, DeviceState> devices_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PointerDataResampler);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_POINTER_DATA_RESAMPLER_H_
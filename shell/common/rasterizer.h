@@ -5,14 +5,18 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <array>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/shell/common/surface.h"
-#include "flutter/synchronization/pipeline.h"
+#include "flutter/synchronization/spsc_pipeline.h"
 #include "lib/ftl/functional/closure.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "lib/ftl/synchronization/waitable_event.h"
+#include "third_party/skia/include/core/SkData.h"
 
 namespace shell {
 
@@ -34,7 +38,81 @@ class Rasterizer {
   virtual flow::LayerTree* GetLastLayerTree() = 0;
 
   virtual void Draw(
-      ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) = 0;
+      ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline) = 0;
+
+  // Rasterizes representative pictures into a scratch offscreen target so
+  // the driver compiles their shaders before the first real frame.
+  virtual void DrawWarmUpPictures(std::vector<sk_sp<SkPicture>> pictures) = 0;
+
+  // Sizes the GPU resource cache of the surface's GrContext. Limits are
+  // remembered and re-applied whenever a surface is set up, so they may be
+  // configured before the first surface exists. Called on the GPU thread.
+  virtual void SetResourceCacheLimits(int max_resource_count,
+                                      size_t max_resource_bytes) = 0;
+
+  // Invoked on the GPU thread after each layer tree consumed from the
+  // pipeline, with whether the scene was identical to the one already on
+  // screen and therefore skipped. Feeds the animator's idle detector.
+  using SceneChangeCallback = std::function<void(bool scene_unchanged)>;
+  virtual void SetSceneChangeCallback(SceneChangeCallback callback) = 0;
+
+  // One presented frame's timing record: microsecond timestamps, on the same
+  // epoch the framework's frame callbacks use, in the order vsync target,
+  // build start, build end, raster start, raster end. The field order must
+  // match _reportFrameTimings in hooks.dart.
+  using FrameTimingRecord = std::array<int64_t, 5>;
+
+  // Invoked on the GPU thread after each frame drawn to the surface with the
+  // frame's timing record. Unchanged scenes are skipped, not drawn, and thus
+  // produce no record. Feeds the framework's frame timing stream.
+  using FrameTimingCallback = std::function<void(const FrameTimingRecord&)>;
+  virtual void SetFrameTimingCallback(FrameTimingCallback callback) = 0;
+
+  // Frees every GPU resource not locked by an in-flight frame without
+  // destroying the context; cached textures and compiled shader state are
+  // rebuilt on demand. Called on the GPU thread.
+  virtual void PurgeResourceCache() = 0;
+
+  // Refills the caches a backgrounded purge dropped by prerolling the last
+  // presented layer tree against the surface — without presenting anything —
+  // so the first visible frame after a resume rasterizes at full speed.
+  // Called on the GPU thread.
+  virtual void PrewarmSurface() = 0;
+
+  // Rasterizes |layer_tree| into a retained offscreen image without
+  // presenting anything. Intended for content the embedder expects to show
+  // soon — the incoming page of a tab switch — rasterized during an idle
+  // frame so the switch itself does not pay for a cold first raster. Each
+  // call replaces the previously retained image. Called on the GPU thread.
+  virtual void PreRenderLayerTree(
+      std::unique_ptr<flow::LayerTree> layer_tree) = 0;
+
+  // Presents the image retained by the last PreRenderLayerTree call, if
+  // any, as a stopgap frame. The live tree for the new content replaces it
+  // through the normal pipeline on the next frame. Called on the GPU
+  // thread.
+  virtual void PresentPreRenderedFrame() = 0;
+
+  // Serializes the last presented layer tree to a snapshot file at |path|
+  // (see layer_tree_snapshot.h) so the next launch can present real content
+  // while the Dart isolate is still starting. Called on the GPU thread.
+  virtual void SnapshotLastLayerTree(const std::string& path) = 0;
+
+  // Names the route the application is currently showing, so raster cache
+  // hints learned this session are keyed per screen (see
+  // flow/raster_cache_hints.h). Called on the GPU thread.
+  virtual void SetCacheHintRoute(const std::string& route) = 0;
+
+  // Invoked on the shared worker pool with the PNG-encoded pixels of a
+  // captured frame, or null if the capture failed.
+  using ScreenshotCallback = std::function<void(sk_sp<SkData> png_data)>;
+
+  // Queues a readback of the next frame drawn to the surface. The pixels
+  // are read on the GPU thread right after the frame is rasterized — no
+  // separate software re-rasterization of the layer tree — and encoding
+  // and delivery happen on the shared worker pool, keeping periodic frame
+  // capture cheap enough for production use. Called on the GPU thread.
+  virtual void CaptureNextFrame(ScreenshotCallback callback) = 0;
 };
 
 }  // namespace shell
@@ -0,0 +1,102 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/rasterizer_scheduler.h"
+
+#include <algorithm>
+
+#include "flutter/common/threads.h"
+#include "flutter/glue/trace_event.h"
+
+namespace shell {
+
+RasterizerScheduler& RasterizerScheduler::Shared() {
+  // Leaked: lives as long as the GPU thread it services.
+  static RasterizerScheduler* scheduler = new RasterizerScheduler();
+  return *scheduler;
+}
+
+RasterizerScheduler::RasterizerScheduler() : drain_scheduled_(false) {}
+
+RasterizerScheduler::~RasterizerScheduler() = default;
+
+void RasterizerScheduler::SetDrawPriority(ftl::WeakPtr<Rasterizer> rasterizer,
+                                          int priority) {
+  Rasterizer* key = rasterizer.get();
+  if (key == nullptr) {
+    return;
+  }
+  Entry& entry = known_rasterizers_[key];
+  entry.rasterizer = std::move(rasterizer);
+  entry.priority = priority;
+}
+
+void RasterizerScheduler::ScheduleDraw(
+    ftl::WeakPtr<Rasterizer> rasterizer,
+    ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline) {
+  Rasterizer* key = rasterizer.get();
+  if (key == nullptr) {
+    return;
+  }
+
+  Entry& entry = known_rasterizers_[key];
+  entry.rasterizer = rasterizer;
+
+  if (PruneDeadRasterizers() <= 1 && pending_.empty()) {
+    // Single surface: behave exactly as if the animator had posted the draw
+    // itself.
+    key->Draw(std::move(pipeline));
+    return;
+  }
+
+  // Coalesce repeat requests: Draw() drains the rasterizer's pipeline, so
+  // one entry per rasterizer covers everything produced up to the drain.
+  for (Request& request : pending_) {
+    if (request.rasterizer.get() == key) {
+      request.pipeline = std::move(pipeline);
+      return;
+    }
+  }
+  pending_.push_back(
+      {std::move(rasterizer), std::move(pipeline), entry.priority});
+
+  if (!drain_scheduled_) {
+    drain_scheduled_ = true;
+    // Drain in a fresh task rather than inline so sibling surfaces whose
+    // draw requests are already queued behind this one on the GPU thread
+    // join the same batch.
+    blink::Threads::Gpu()->PostTask([this]() { Drain(); });
+  }
+}
+
+void RasterizerScheduler::Drain() {
+  TRACE_EVENT0("flutter", "RasterizerScheduler::Drain");
+  drain_scheduled_ = false;
+
+  std::vector<Request> batch;
+  batch.swap(pending_);
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](const Request& a, const Request& b) {
+                     return a.priority > b.priority;
+                   });
+
+  for (Request& request : batch) {
+    if (Rasterizer* rasterizer = request.rasterizer.get()) {
+      rasterizer->Draw(std::move(request.pipeline));
+    }
+  }
+}
+
+size_t RasterizerScheduler::PruneDeadRasterizers() {
+  for (auto it = known_rasterizers_.begin(); it != known_rasterizers_.end();) {
+    if (it->second.rasterizer.get() == nullptr) {
+      it = known_rasterizers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return known_rasterizers_.size();
+}
+
+}  // namespace shell
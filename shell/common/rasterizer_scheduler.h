@@ -0,0 +1,75 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_RASTERIZER_SCHEDULER_H_
+#define SHELL_COMMON_RASTERIZER_SCHEDULER_H_
+
+#include <map>
+#include <vector>
+
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/shell/common/rasterizer.h"
+#include "flutter/synchronization/spsc_pipeline.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
+
+namespace shell {
+
+// Multiplexes Rasterizer::Draw calls from multiple platform views onto the
+// shared GPU thread. Each view's animator requests draws independently, so
+// with several surfaces alive the requests interleave arbitrarily with other
+// GPU thread work and with each other; a surface can be drawn, preempted by
+// unrelated tasks, and then the sibling display's draw rebinds the context
+// all over again. The scheduler coalesces the requests that arrive for the
+// same vsync and drains them back to back, highest priority surface first,
+// so both displays of a multi-window product are serviced in one wake of the
+// GPU thread.
+//
+// With a single live rasterizer — the common case — requests are forwarded
+// immediately and no extra task hop is added.
+//
+// All methods must be called on the GPU thread.
+class RasterizerScheduler {
+ public:
+  static RasterizerScheduler& Shared();
+
+  // Higher priority surfaces draw first within a batch. The default is 0;
+  // ties drain in request order.
+  void SetDrawPriority(ftl::WeakPtr<Rasterizer> rasterizer, int priority);
+
+  void ScheduleDraw(
+      ftl::WeakPtr<Rasterizer> rasterizer,
+      ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline);
+
+ private:
+  struct Entry {
+    ftl::WeakPtr<Rasterizer> rasterizer;
+    int priority = 0;
+  };
+
+  struct Request {
+    ftl::WeakPtr<Rasterizer> rasterizer;
+    ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline;
+    int priority = 0;
+  };
+
+  RasterizerScheduler();
+  ~RasterizerScheduler();
+
+  void Drain();
+
+  // Drops entries whose rasterizers have been torn down and returns the
+  // number of live ones.
+  size_t PruneDeadRasterizers();
+
+  std::map<const Rasterizer*, Entry> known_rasterizers_;
+  std::vector<Request> pending_;
+  bool drain_scheduled_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(RasterizerScheduler);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_RASTERIZER_SCHEDULER_H_
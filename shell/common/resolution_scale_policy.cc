@@ -0,0 +1,84 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resolution_scale_policy.h"
+
+namespace shell {
+
+namespace {
+
+// The scale ladder. Steps below 0.8 read as visibly soft on high density
+// displays, so the policy never leaves the 0.8-0.9 band.
+const double kScaleSteps[] = {1.0, 0.9, 0.8};
+const size_t kScaleStepCount = sizeof(kScaleSteps) / sizeof(kScaleSteps[0]);
+
+const double kFrameBudgetMS = 16.667;
+
+// Step down when the smoothed GPU time crosses this share of the budget.
+const double kStepDownFraction = 0.9;
+
+// Headroom required of the predicted GPU time at the larger step before
+// scaling back up; stricter than the step-down threshold so the two
+// decisions cannot ping-pong on the same scene.
+const double kStepUpFraction = 0.75;
+
+// Minimum samples between scale changes, about half a second at 60 Hz
+// since timing queries complete once per presented frame.
+const size_t kHoldFrames = 30;
+
+// Smoothing factor for the exponential average: small enough to ride out
+// single-frame spikes, large enough to track a thermal trend within tens
+// of frames.
+const double kSmoothing = 0.25;
+
+}  // namespace
+
+ResolutionScalePolicy::ResolutionScalePolicy()
+    : smoothed_ms_(0.0),
+      has_sample_(false),
+      step_(0),
+      hold_frames_remaining_(0) {}
+
+ResolutionScalePolicy::~ResolutionScalePolicy() = default;
+
+void ResolutionScalePolicy::AddGpuFrameTime(ftl::TimeDelta gpu_time) {
+  double sample_ms = gpu_time.ToMicroseconds() / 1000.0;
+  if (!has_sample_) {
+    smoothed_ms_ = sample_ms;
+    has_sample_ = true;
+  } else {
+    smoothed_ms_ += kSmoothing * (sample_ms - smoothed_ms_);
+  }
+
+  if (hold_frames_remaining_ > 0) {
+    hold_frames_remaining_--;
+    return;
+  }
+
+  if (step_ + 1 < kScaleStepCount &&
+      smoothed_ms_ > kStepDownFraction * kFrameBudgetMS) {
+    step_++;
+    hold_frames_remaining_ = kHoldFrames;
+    return;
+  }
+
+  if (step_ > 0) {
+    // GPU cost tracks the rendered pixel count, so predict what this scene
+    // would cost at the next larger step before committing to it.
+    double current = kScaleSteps[step_];
+    double larger = kScaleSteps[step_ - 1];
+    double predicted_ms =
+        smoothed_ms_ * (larger * larger) / (current * current);
+    if (predicted_ms < kStepUpFraction * kFrameBudgetMS) {
+      step_--;
+      hold_frames_remaining_ = kHoldFrames;
+    }
+  }
+}
+
+double ResolutionScalePolicy::scale() const {
+  return kScaleSteps[step_];
+}
+
+}  // namespace shell
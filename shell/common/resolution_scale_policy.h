@@ -0,0 +1,51 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_RESOLUTION_SCALE_POLICY_H_
+#define FLUTTER_SHELL_COMMON_RESOLUTION_SCALE_POLICY_H_
+
+#include <stddef.h>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+
+namespace shell {
+
+// Decides the resolution scale the rasterizer should render at. When the
+// harvested GPU frame times trend over the frame budget — sustained scene
+// load or thermal throttling — the scene renders at reduced scale and is
+// upscaled at present, trading a little sharpness for staying at refresh
+// rate. The scale steps back up only when the measured GPU time, corrected
+// for the extra pixels the larger step would render, fits the budget with
+// headroom.
+class ResolutionScalePolicy {
+ public:
+  ResolutionScalePolicy();
+
+  ~ResolutionScalePolicy();
+
+  // Feeds one completed GPU timing query. Called on the GPU thread; the
+  // results describe frames a few presents back, which is fine for a policy
+  // reacting to trends rather than single frames.
+  void AddGpuFrameTime(ftl::TimeDelta gpu_time);
+
+  // The scale the next frame should render at: 1.0, 0.9 or 0.8.
+  double scale() const;
+
+ private:
+  // Exponentially smoothed GPU frame time, in milliseconds.
+  double smoothed_ms_;
+  bool has_sample_;
+  // Index into the scale ladder; 0 is full resolution.
+  size_t step_;
+  // Samples left before the scale may change again; keeps the policy from
+  // oscillating around a threshold.
+  size_t hold_frames_remaining_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ResolutionScalePolicy);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_RESOLUTION_SCALE_POLICY_H_
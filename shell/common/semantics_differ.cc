@@ -0,0 +1,73 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/semantics_differ.h"
+
+#include <unordered_set>
+#include <utility>
+
+#include "flutter/common/threads.h"
+#include "flutter/shell/common/platform_view.h"
+#include "lib/ftl/functional/make_copyable.h"
+
+namespace shell {
+
+SemanticsDiffer::SemanticsDiffer() = default;
+
+SemanticsDiffer::~SemanticsDiffer() = default;
+
+void SemanticsDiffer::ProcessUpdate(std::vector<blink::SemanticsNode> update,
+                                    ftl::WeakPtr<PlatformView> platform_view) {
+  std::vector<blink::SemanticsNode> changed;
+  changed.reserve(update.size());
+  for (blink::SemanticsNode& node : update) {
+    auto known = semantics_nodes_.find(node.id);
+    if (known != semantics_nodes_.end() && known->second == node)
+      continue;
+    semantics_nodes_[node.id] = node;
+    changed.push_back(std::move(node));
+  }
+
+  // Prune mirror entries no longer reachable from the root. The bridges
+  // detach removed subtrees the same way; without this, a node removed and
+  // later re-added with identical content would be filtered out above and
+  // never reach them.
+  if (!changed.empty()) {
+    std::unordered_set<int32_t> reachable;
+    std::vector<int32_t> worklist;
+    worklist.push_back(0);  // The root node always has id 0.
+    while (!worklist.empty()) {
+      int32_t id = worklist.back();
+      worklist.pop_back();
+      if (!reachable.insert(id).second)
+        continue;
+      auto node = semantics_nodes_.find(id);
+      if (node == semantics_nodes_.end())
+        continue;
+      for (int32_t child : node->second.children)
+        worklist.push_back(child);
+    }
+    for (auto it = semantics_nodes_.begin(); it != semantics_nodes_.end();) {
+      if (reachable.count(it->first) == 0)
+        it = semantics_nodes_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  if (changed.empty())
+    return;
+
+  blink::Threads::Platform()->PostTask(ftl::MakeCopyable(
+      [ platform_view, update = std::move(changed) ]() mutable {
+        if (platform_view)
+          platform_view->UpdateSemantics(std::move(update));
+      }));
+}
+
+void SemanticsDiffer::Reset() {
+  semantics_nodes_.clear();
+}
+
+}  // namespace shell
@@ -0,0 +1,60 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_SEMANTICS_DIFFER_H_
+#define SHELL_COMMON_SEMANTICS_DIFFER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_counted.h"
+#include "lib/ftl/memory/weak_ptr.h"
+
+namespace shell {
+class PlatformView;
+
+// Diffs each semantics update against a mirror of the nodes last shipped to
+// the platform view, so the thread hop and per-node serialization beyond
+// this point scale with the number of changes instead of the size of the
+// semantics tree.
+//
+// The diff is proportional to the full node set, so it runs on the IO
+// thread: the UI thread only pays for posting the raw update here and is
+// free to start producing the next frame while the GPU thread rasterizes
+// the one that carried this update. Every method must be called on the IO
+// thread, which serializes updates and keeps the mirror consistent.
+class SemanticsDiffer : public ftl::RefCountedThreadSafe<SemanticsDiffer> {
+ public:
+  // Filters |update| down to the nodes that differ from the mirror and
+  // posts the result to the platform thread for delivery to
+  // |platform_view|. The accessibility bridges apply updates incrementally
+  // by node id, so a filtered update is indistinguishable from a sparse
+  // one.
+  void ProcessUpdate(std::vector<blink::SemanticsNode> update,
+                     ftl::WeakPtr<PlatformView> platform_view);
+
+  // Forgets the mirrored nodes so the next update ships in full. Called
+  // when semantics are disabled, since the platform accessibility bridges
+  // discard their state at the same time.
+  void Reset();
+
+ private:
+  // Mirror of the semantics nodes last shipped to the platform view, keyed
+  // by id. Pruned to the nodes reachable from the root.
+  std::unordered_map<int32_t, blink::SemanticsNode> semantics_nodes_;
+
+  SemanticsDiffer();
+
+  ~SemanticsDiffer();
+
+  FRIEND_MAKE_REF_COUNTED(SemanticsDiffer);
+  FRIEND_REF_COUNTED_THREAD_SAFE(SemanticsDiffer);
+  FTL_DISALLOW_COPY_AND_ASSIGN(SemanticsDiffer);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_SEMANTICS_DIFFER_H_
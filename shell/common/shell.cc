@@ -6,23 +6,32 @@
 
 #include <fcntl.h>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
 #include "dart/runtime/include/dart_tools_api.h"
+#include "flutter/common/memory_pressure_listener.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/thread_pool.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/shell/common/diagnostic/diagnostic_server.h"
+#include "flutter/lib/ui/painting/resource_context.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/event_replay.h"
+#include "flutter/shell/common/jank_reporter.h"
 #include "flutter/shell/common/platform_view_service_protocol.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
+#include "flutter/sky/engine/platform/fonts/FontCache.h"
+#include "flutter/sky/engine/platform/fonts/FontDescription.h"
 #include "lib/ftl/files/unique_fd.h"
 #include "third_party/skia/include/core/SkGraphics.h"
+#include "third_party/skia/include/ports/SkFontMgr.h"
 
 namespace shell {
 namespace {
@@ -57,6 +66,50 @@ bool GetSwitchValue(const ftl::CommandLine& command_line,
   return false;
 }
 
+// Bounds of completed startup phases. These run before the Dart timeline
+// recorder exists, so they are captured with Dart_TimelineGetMicros and
+// replayed onto the timeline once the VM is up, next to the
+// FlutterEngineMainEnter event that dart_init emits from
+// blink::engine_main_enter_ts. The offset of each phase from that event is
+// what release-over-release startup tracking compares.
+struct StartupPhase {
+  const char* name;
+  int64_t start_micros;
+  int64_t end_micros;
+};
+
+std::mutex& StartupPhasesMutex() {
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+std::vector<StartupPhase>& StartupPhases() {
+  static std::vector<StartupPhase>* phases = new std::vector<StartupPhase>();
+  return *phases;
+}
+
+void RecordStartupPhase(const char* name,
+                        int64_t start_micros,
+                        int64_t end_micros) {
+  std::lock_guard<std::mutex> lock(StartupPhasesMutex());
+  StartupPhases().push_back({name, start_micros, end_micros});
+}
+
+void FlushStartupPhasesToTimeline() {
+  std::lock_guard<std::mutex> lock(StartupPhasesMutex());
+  for (const auto& phase : StartupPhases()) {
+    Dart_TimelineEvent(phase.name,              // label
+                       phase.start_micros,      // timestamp0
+                       phase.end_micros,        // timestamp1_or_async_id
+                       Dart_Timeline_Event_Duration,  // event type
+                       0,                       // argument_count
+                       nullptr,                 // argument_names
+                       nullptr                  // argument_values
+                       );
+  }
+  StartupPhases().clear();
+}
+
 void ServiceIsolateHook(bool running_precompiled) {
   if (!running_precompiled) {
     const blink::Settings& settings = blink::Settings::Get();
@@ -83,10 +136,31 @@ Shell::Shell(ftl::CommandLine command_line)
                          ui_thread_->GetTaskRunner(),
                          io_thread_->GetTaskRunner());
   blink::Threads::Set(threads);
+  blink::Threads::ApplyThreadPriorities();
 
   blink::Threads::Gpu()->PostTask([this]() { InitGpuThread(); });
   blink::Threads::UI()->PostTask([this]() { InitUIThread(); });
 
+  // Process-wide caches shed memory on their owning threads off one platform
+  // signal; per-rasterizer caches register themselves on construction. These
+  // live as long as the process, so the ids are never removed.
+  blink::MemoryPressureListenerRegistry::AddListener(
+      blink::Threads::UI(), [](blink::MemoryPressureLevel level) {
+        // Glyphs are hot and cheap relative to their paint cost; only a
+        // critical signal is worth dropping them for.
+        if (level == blink::MemoryPressureLevel::kCritical) {
+          blink::FontCache::fontCache()->purge(blink::FontCache::ForcePurge);
+        }
+      });
+  blink::MemoryPressureListenerRegistry::AddListener(
+      blink::Threads::IO(), [](blink::MemoryPressureLevel level) {
+        // The IO context keeps its cache budget at zero, but resources still
+        // referenced by in-flight decodes pin transient GPU memory.
+        if (GrContext* context = blink::ResourceContext::Get()) {
+          context->freeGpuResources();
+        }
+      });
+
   blink::SetServiceIsolateHook(ServiceIsolateHook);
   blink::SetRegisterNativeServiceProtocolExtensionHook(
       PlatformViewServiceProtocol::RegisterHook);
@@ -99,9 +173,38 @@ void Shell::InitStandalone(ftl::CommandLine command_line,
                            std::string application_library_path) {
   TRACE_EVENT0("flutter", "Shell::InitStandalone");
 
-  fml::icu::InitializeICU(icu_data_path);
-
+  // The ICU data mapping has no dependency on anything below; let it
+  // proceed on a worker while this thread warms up Skia and parses the
+  // command line, and join it before Init() needs ICU for the VM.
+  ftl::AutoResetWaitableEvent icu_latch;
+  const int64_t icu_start_micros = Dart_TimelineGetMicros();
+  fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(
+      [icu_data_path, icu_start_micros, &icu_latch]() {
+        fml::icu::InitializeICU(icu_data_path);
+        RecordStartupPhase("StartupInitializeICU", icu_start_micros,
+                           Dart_TimelineGetMicros());
+        icu_latch.Signal();
+      });
+
+  const int64_t skia_start_micros = Dart_TimelineGetMicros();
   SkGraphics::Init();
+  RecordStartupPhase("StartupSkiaInit", skia_start_micros,
+                     Dart_TimelineGetMicros());
+
+  // Opening and mmapping the default platform font is pure file I/O and can
+  // proceed on a worker; Skia's typeface cache is thread-safe, so the font
+  // cache warm-up on the UI thread later finds the SkTypeface already
+  // resident.
+  fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask([]() {
+    const int64_t font_start_micros = Dart_TimelineGetMicros();
+    sk_sp<SkFontMgr> font_manager(SkFontMgr::RefDefault());
+    sk_sp<SkTypeface> typeface(
+        font_manager->matchFamilyStyle(nullptr, SkFontStyle()));
+    RecordStartupPhase("StartupFontPrefetch", font_start_micros,
+                       Dart_TimelineGetMicros());
+  });
+
+  const int64_t settings_start_micros = Dart_TimelineGetMicros();
 
   blink::Settings settings;
   settings.application_library_path = application_library_path;
@@ -142,9 +245,27 @@ void Shell::InitStandalone(ftl::CommandLine command_line,
   settings.start_paused =
       command_line.HasOption(FlagForSwitch(Switch::StartPaused));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::StartupMetricsFile),
+                              &settings.startup_metrics_path);
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::RecordEventsFile),
+                              &settings.record_events_path);
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::ReplayEventsFile),
+                              &settings.replay_events_path);
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::SceneSnapshotFile),
+                              &settings.scene_snapshot_path);
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheHintsFile),
+                              &settings.raster_cache_hints_path);
+
   settings.enable_dart_profiling =
       command_line.HasOption(FlagForSwitch(Switch::EnableDartProfiling));
 
+  settings.enable_dynamic_resolution =
+      command_line.HasOption(FlagForSwitch(Switch::EnableDynamicResolution));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -173,6 +294,18 @@ void Shell::InitStandalone(ftl::CommandLine command_line,
   settings.use_test_fonts =
       command_line.HasOption(FlagForSwitch(Switch::UseTestFonts));
 
+  if (command_line.HasOption(FlagForSwitch(Switch::MetricsSettleWindow))) {
+    if (!GetSwitchValue(command_line, Switch::MetricsSettleWindow,
+                        &settings.metrics_settle_window_ms)) {
+      FTL_LOG(INFO)
+          << "Metrics settle window specified was malformed. Will default to "
+          << settings.metrics_settle_window_ms;
+    }
+  }
+
+  settings.speculative_rotation_layout =
+      command_line.HasOption(FlagForSwitch(Switch::SpeculativeRotationLayout));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -186,7 +319,31 @@ void Shell::InitStandalone(ftl::CommandLine command_line,
 
   blink::Settings::Set(settings);
 
+  if (!settings.record_events_path.empty()) {
+    EventRecorder::Shared().StartRecording(settings.record_events_path);
+  }
+
+  RecordStartupPhase("StartupSettings", settings_start_micros,
+                     Dart_TimelineGetMicros());
+
+  icu_latch.Wait();
+
   Init(std::move(command_line));
+
+  // Queued behind the Engine::Init task above, so the blink font machinery is
+  // up by the time this runs. The cache is confined to the UI thread, which
+  // is why this is a UI task rather than part of the worker prefetch; the
+  // expensive file work already happened there.
+  blink::Threads::UI()->PostTask([]() {
+    const int64_t font_start_micros = Dart_TimelineGetMicros();
+    blink::FontDescription description;
+    description.setComputedSize(14);  // The default Flutter text size.
+    WTF::Vector<AtomicString> families;
+    families.append(AtomicString());  // The platform default font.
+    blink::FontCache::fontCache()->warmUp(description, families);
+    RecordStartupPhase("StartupFontCacheWarmUp", font_start_micros,
+                       Dart_TimelineGetMicros());
+  });
 }
 
 void Shell::Init(ftl::CommandLine command_line) {
@@ -196,7 +353,15 @@ void Shell::Init(ftl::CommandLine command_line) {
 
   FTL_DCHECK(!g_shell);
   g_shell = new Shell(std::move(command_line));
-  blink::Threads::UI()->PostTask(Engine::Init);
+  blink::Threads::UI()->PostTask([]() {
+    const int64_t start_micros = Dart_TimelineGetMicros();
+    Engine::Init();
+    RecordStartupPhase("StartupEngineInit", start_micros,
+                       Dart_TimelineGetMicros());
+    // The VM is up now; replay the phases gathered before its timeline
+    // recorder existed.
+    FlushStartupPhasesToTimeline();
+  });
 }
 
 Shell& Shell::Shared() {
@@ -218,6 +383,12 @@ void Shell::InitGpuThread() {
 
 void Shell::InitUIThread() {
   ui_thread_checker_.reset(new ftl::ThreadChecker());
+  // Feed UI task overruns to the jank reporter so a captured report can
+  // say how long the task nearest the deadline miss ran.
+  fml::MessageLoop::GetCurrent().SetSlowTaskCallback(
+      [](ftl::TimeDelta duration) {
+        JankReporter::Shared().OnSlowUITask(duration);
+      });
 }
 
 void Shell::AddRasterizer(const ftl::WeakPtr<Rasterizer>& rasterizer) {
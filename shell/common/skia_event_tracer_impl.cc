@@ -7,6 +7,8 @@
 #define TRACE_EVENT_HIDE_MACROS
 #include "flutter/fml/trace_event.h"
 
+#include <atomic>
+#include <cstring>
 #include <vector>
 
 #include "lib/ftl/logging.h"
@@ -19,7 +21,7 @@ class FlutterEventTracer : public SkEventTracer {
  public:
   static constexpr const char* kSkiaTag = "skia";
 
-  FlutterEventTracer() = default;
+  FlutterEventTracer() { RefreshCategoryFlags(); }
 
   SkEventTracer::Handle addTraceEvent(char phase,
                                       const uint8_t* category_enabled_flag,
@@ -30,6 +32,30 @@ class FlutterEventTracer : public SkEventTracer {
                                       const uint8_t* p_arg_types,
                                       const uint64_t* p_arg_values,
                                       uint8_t flags) override {
+    // Skia's trace macros test the category flag byte before calling in, so
+    // events in disabled categories never reach this point; the check here
+    // only covers macro expansions that cached the byte across a refresh.
+    if (!*category_enabled_flag) {
+      return kSkippedHandle;
+    }
+
+    // Sampled mode for the GPU stream: forward one in N scoped ops. Only
+    // complete (scoped) events are sampled — their handle tells
+    // updateTraceEventDuration whether the begin was forwarded, so begins
+    // and ends stay balanced — and asynchronous or unscoped phases always
+    // forward.
+    if (category_enabled_flag == &gpu_enabled_ &&
+        phase == TRACE_EVENT_PHASE_COMPLETE) {
+      const int interval =
+          gpu_sample_interval_.load(std::memory_order_relaxed);
+      if (interval > 1 &&
+          gpu_sample_counter_.fetch_add(1, std::memory_order_relaxed) %
+                  interval !=
+              0) {
+        return kSkippedHandle;
+      }
+    }
+
     switch (phase) {
       case TRACE_EVENT_PHASE_BEGIN:
       case TRACE_EVENT_PHASE_COMPLETE:
@@ -50,35 +76,111 @@ class FlutterEventTracer : public SkEventTracer {
       default:
         break;
     }
-    return 0;
+    return kForwardedHandle;
   }
 
   void updateTraceEventDuration(const uint8_t* category_enabled_flag,
                                 const char* name,
                                 SkEventTracer::Handle handle) override {
-    // This is only ever called from a scoped trace event so we will just end
-    // the section.
-    fml::tracing::TraceEventEnd(name);
+    // This is only ever called from a scoped trace event; end the section
+    // unless the matching begin was filtered or sampled out.
+    if (handle == kForwardedHandle) {
+      fml::tracing::TraceEventEnd(name);
+    }
   }
 
   const uint8_t* getCategoryGroupEnabled(const char* name) override {
-    static const uint8_t kYes = 1;
-    return &kYes;
+    // Skia asks once per macro site and caches the pointer, so the byte it
+    // receives must stay valid and reflect later mask changes; hand out the
+    // per-category bytes RefreshCategoryFlags() maintains.
+    if (!strncmp(name, "disabled-by-default-", 20)) {
+      return &kNo;
+    }
+    if (!strcmp(name, "skia.gpu")) {
+      return &gpu_enabled_;
+    }
+    if (!strcmp(name, "skia.objects")) {
+      return &objects_enabled_;
+    }
+    return &skia_enabled_;
   }
 
   const char* getCategoryGroupName(
       const uint8_t* category_enabled_flag) override {
+    if (category_enabled_flag == &gpu_enabled_) {
+      return "skia.gpu";
+    }
+    if (category_enabled_flag == &objects_enabled_) {
+      return "skia.objects";
+    }
     return kSkiaTag;
   }
 
+  // Re-reads the shared fml category mask into the flag bytes Skia's macro
+  // sites load, making a mask change take effect at those sites without any
+  // per-event cost.
+  void RefreshCategoryFlags() {
+    skia_enabled_ =
+        fml::tracing::TraceCategoryEnabled(fml::tracing::kTraceCategorySkia)
+            ? 1
+            : 0;
+    gpu_enabled_ =
+        fml::tracing::TraceCategoryEnabled(fml::tracing::kTraceCategorySkiaGpu)
+            ? 1
+            : 0;
+    objects_enabled_ = fml::tracing::TraceCategoryEnabled(
+                           fml::tracing::kTraceCategorySkiaObjects)
+                           ? 1
+                           : 0;
+  }
+
+  void SetGpuSampleInterval(int interval) {
+    gpu_sample_interval_.store(interval < 1 ? 1 : interval,
+                               std::memory_order_relaxed);
+  }
+
  private:
+  static constexpr SkEventTracer::Handle kSkippedHandle = 0;
+  static constexpr SkEventTracer::Handle kForwardedHandle = 1;
+
+  static const uint8_t kNo;
+
+  uint8_t skia_enabled_ = 1;
+  uint8_t gpu_enabled_ = 1;
+  uint8_t objects_enabled_ = 1;
+  // Defaults to 1-in-8: enough GPU ops to see what the frame did without
+  // the observer effect of forwarding every GrContext event.
+  std::atomic<int> gpu_sample_interval_{8};
+  std::atomic<uint64_t> gpu_sample_counter_{0};
+
   FTL_DISALLOW_COPY_AND_ASSIGN(FlutterEventTracer);
 };
 
+const uint8_t FlutterEventTracer::kNo = 0;
+
+namespace {
+
+FlutterEventTracer* g_tracer = nullptr;
+
+}  // namespace
+
 }  // namespace skia
 
 void InitSkiaEventTracer() {
   // Initialize the binding to Skia's tracing events. Skia will
   // take ownership of and clean up the memory allocated here.
-  SkEventTracer::SetInstance(new skia::FlutterEventTracer());
+  skia::g_tracer = new skia::FlutterEventTracer();
+  SkEventTracer::SetInstance(skia::g_tracer);
+}
+
+void RefreshSkiaEventTracerCategories() {
+  if (skia::g_tracer) {
+    skia::g_tracer->RefreshCategoryFlags();
+  }
+}
+
+void SetSkiaGpuTraceSampleInterval(int interval) {
+  if (skia::g_tracer) {
+    skia::g_tracer->SetGpuSampleInterval(interval);
+  }
 }
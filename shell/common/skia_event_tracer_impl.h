@@ -7,4 +7,13 @@
 
 void InitSkiaEventTracer();
 
+// Re-reads fml::tracing::TraceGetEnabledCategories() into the flag bytes
+// Skia's trace macro sites test, so a mask change takes effect without any
+// per-event cost.
+void RefreshSkiaEventTracerCategories();
+
+// Forward one in |interval| scoped skia.gpu events; 1 forwards them all.
+// Unscoped and asynchronous phases are never sampled.
+void SetSkiaGpuTraceSampleInterval(int interval);
+
 #endif  // FLUTTER_SHELL_COMMON_SKIA_EVENT_TRACER_IMPL_H_
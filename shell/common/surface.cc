@@ -10,7 +10,18 @@ namespace shell {
 
 SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
                            SubmitCallback submit_callback)
-    : submitted_(false), surface_(surface), submit_callback_(submit_callback) {
+    : SurfaceFrame(std::move(surface), nullptr, std::move(submit_callback)) {}
+
+SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
+                           SkCanvas* canvas,
+                           SubmitCallback submit_callback)
+    : submitted_(false),
+      has_submit_damage_(false),
+      submit_damage_(SkRect::MakeEmpty()),
+      buffer_age_(1),
+      surface_(surface),
+      canvas_(canvas),
+      submit_callback_(submit_callback) {
   FTL_DCHECK(submit_callback_);
 }
 
@@ -31,7 +42,15 @@ bool SurfaceFrame::Submit() {
   return submitted_;
 }
 
+void SurfaceFrame::set_submit_damage(const SkRect& damage) {
+  has_submit_damage_ = true;
+  submit_damage_ = damage;
+}
+
 SkCanvas* SurfaceFrame::SkiaCanvas() {
+  if (canvas_ != nullptr) {
+    return canvas_;
+  }
   return surface_ != nullptr ? surface_->getCanvas() : nullptr;
 }
 
@@ -55,6 +74,10 @@ Surface::Surface() : scale_(1.0) {}
 
 Surface::~Surface() = default;
 
+bool Surface::GetNextGpuFrameTime(ftl::TimeDelta* elapsed) {
+  return false;
+}
+
 bool Surface::SupportsScaling() const {
   return false;
 }
@@ -9,6 +9,7 @@
 
 #include "lib/ftl/compiler_specific.h"
 #include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace shell {
@@ -22,17 +23,46 @@ class SurfaceFrame {
 
   SurfaceFrame(sk_sp<SkSurface> surface, SubmitCallback submit_callback);
 
+  // For surfaces that paint through an intermediate canvas (e.g. a picture
+  // recorder whose replay is deferred to the submit callback) rather than
+  // directly into the backing store. |canvas| must outlive the frame.
+  SurfaceFrame(sk_sp<SkSurface> surface,
+               SkCanvas* canvas,
+               SubmitCallback submit_callback);
+
   ~SurfaceFrame();
 
   bool Submit();
 
   SkCanvas* SkiaCanvas();
 
+  // Optional hint describing the region of the frame that actually changed.
+  // Platform surfaces that support presentation with damage (e.g.
+  // EGL_KHR_swap_buffers_with_damage) may consult this in their submit
+  // callbacks to avoid full-surface swaps.
+  void set_submit_damage(const SkRect& damage);
+
+  bool has_submit_damage() const { return has_submit_damage_; }
+
+  const SkRect& submit_damage() const { return submit_damage_; }
+
+  // The number of presents since the buffer backing this frame last held
+  // contents: 1 means it still holds the previous frame, 0 means its
+  // contents are undefined. Defaults to 1, matching surfaces whose contents
+  // are preserved across presents.
+  void set_buffer_age(int age) { buffer_age_ = age; }
+
+  int buffer_age() const { return buffer_age_; }
+
   sk_sp<SkSurface> SkiaSurface() const;
 
  private:
   bool submitted_;
+  bool has_submit_damage_;
+  SkRect submit_damage_;
+  int buffer_age_;
   sk_sp<SkSurface> surface_;
+  SkCanvas* canvas_;
   SubmitCallback submit_callback_;
 
   bool PerformSubmit();
@@ -54,6 +84,12 @@ class Surface {
 
   virtual GrContext* GetContext() = 0;
 
+  // Pops the GPU elapsed time of the oldest submitted frame whose timing
+  // query has completed, if the surface measures GPU time at all. Results
+  // trail submission by a few frames so the GPU is never stalled; callers
+  // should drain in a loop. The default implementation reports nothing.
+  virtual bool GetNextGpuFrameTime(ftl::TimeDelta* elapsed);
+
   virtual bool SupportsScaling() const;
 
   double GetScale() const;
@@ -52,6 +52,11 @@ DEF_SWITCH(EnableDartProfiling,
            "enable-dart-profiling",
            "Enable Dart profiling. Profiling information can be viewed from "
            "the observatory.")
+DEF_SWITCH(EnableDynamicResolution,
+           "enable-dynamic-resolution",
+           "Render at 0.9x or 0.8x resolution (upscaled at present) while "
+           "GPU frame times trend over budget, restoring full resolution "
+           "when headroom returns.")
 DEF_SWITCH(EndlessTraceBuffer,
            "endless-trace-buffer",
            "Enable an endless trace buffer. The default is a ring buffer. "
@@ -62,6 +67,12 @@ DEF_SWITCH(FLX, "flx", "Specify the the FLX path.")
 DEF_SWITCH(Help, "help", "Display this help text.")
 DEF_SWITCH(LogTag, "log-tag", "Tag associated with log messages.")
 DEF_SWITCH(MainDartFile, "dart-main", "The path to the main Dart file.")
+DEF_SWITCH(MetricsSettleWindow,
+           "metrics-settle-window",
+           "Milliseconds of quiet before a burst of window metrics changes "
+           "(e.g. the intermediate sizes of a rotation) is considered "
+           "settled; only the final metrics of the burst are dispatched to "
+           "Dart. The default of 0 dispatches every change immediately.")
 DEF_SWITCH(NonInteractive,
            "non-interactive",
            "Make the shell non-interactive. By default, the shell attempts "
@@ -72,9 +83,43 @@ DEF_SWITCH(NoRedirectToSyslog,
            "This is used by the tools to read device logs. However, this can "
            "cause logs to not show up when launched from Xcode.")
 DEF_SWITCH(Packages, "packages", "Specify the path to the packages.")
+DEF_SWITCH(RasterCacheHintsFile,
+           "raster-cache-hints-file",
+           "Persist raster cache admission decisions to the given file at "
+           "session end, keyed by route name, and preload them on the next "
+           "launch so each screen's cache warms on its first frame instead "
+           "of after the usual warmup.")
+DEF_SWITCH(RecordEventsFile,
+           "record-events-file",
+           "Append vsync timestamps and pointer packets to an event log at "
+           "the given path as they pass through the engine, for later replay "
+           "with --replay-events-file.")
+DEF_SWITCH(ReplayEventsFile,
+           "replay-events-file",
+           "Drive the engine from the event log at the given path instead of "
+           "the display and real input, making benchmark runs reproducible "
+           "to the frame. Frames are delivered back to back without "
+           "real-time pacing.")
+DEF_SWITCH(SceneSnapshotFile,
+           "scene-snapshot-file",
+           "Serialize the last presented scene to the given file when the "
+           "application is paused, and present it as a stopgap first frame "
+           "on the next launch before the Dart isolate starts, so perceived "
+           "startup shows real content instead of a static splash.")
+DEF_SWITCH(SpeculativeRotationLayout,
+           "speculative-rotation-layout",
+           "During a coalesced window metrics burst, dispatch the predicted "
+           "final size (the pre-burst dimensions swapped) once up front so "
+           "layout at the new orientation overlaps the transition animation. "
+           "Only meaningful with a non-zero --metrics-settle-window.")
 DEF_SWITCH(StartPaused,
            "start-paused",
            "Start the application paused in the Dart debugger.")
+DEF_SWITCH(StartupMetricsFile,
+           "startup-metrics-file",
+           "Write a JSON object of startup milestone timestamps (VM "
+           "initialization, isolate creation, bundle run completion, first "
+           "frame) to the given file after the first frame is presented.")
 DEF_SWITCH(TraceStartup,
            "trace-startup",
            "Trace early application lifecycle. Automatically switches to an "
@@ -8,6 +8,7 @@
 
 #include "dart/runtime/include/dart_tools_api.h"
 #include "flutter/common/threads.h"
+#include "flutter/fml/sampling_profiler.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/shell/common/shell.h"
@@ -38,6 +39,12 @@ void TracingController::StartTracing() {
   if (tracing_active_)
     return;
   tracing_active_ = true;
+  // Open the per-site gate in the trace macros so events start reaching the
+  // Dart timeline.
+  fml::tracing::TraceSetTimelineEnabled(true);
+  // While a trace is being collected, also sample program counters so the
+  // capture ranks engine hot functions by CPU time.
+  fml::SamplingProfiler::GetProcessProfiler().Start();
   AddTraceMetadata();
 }
 
@@ -46,6 +53,8 @@ void TracingController::StopTracing() {
     return;
   }
   tracing_active_ = false;
+  fml::SamplingProfiler::GetProcessProfiler().Stop();
+  fml::tracing::TraceSetTimelineEnabled(false);
 }
 
 }  // namespace shell
@@ -6,6 +6,10 @@
 
 namespace shell {
 
+ftl::TimeDelta VsyncWaiter::GetDisplayRefreshInterval() const {
+  return ftl::TimeDelta::Zero();
+}
+
 VsyncWaiter::~VsyncWaiter() = default;
 
 }  // namespace shell
@@ -7,6 +7,7 @@
 
 #include <functional>
 
+#include "lib/ftl/time/time_delta.h"
 #include "lib/ftl/time/time_point.h"
 
 namespace shell {
@@ -17,6 +18,12 @@ class VsyncWaiter {
 
   virtual void AsyncWaitForVsync(Callback callback) = 0;
 
+  // The display refresh interval this waiter has measured, or zero when it
+  // has no better estimate than the cadence of its own callbacks. Callers
+  // should prefer a non-zero value over inferring the interval from
+  // callback arrival times, which fold in task scheduling jitter.
+  virtual ftl::TimeDelta GetDisplayRefreshInterval() const;
+
   virtual ~VsyncWaiter();
 };
 
@@ -4,12 +4,30 @@
 
 #include "flutter/shell/common/vsync_waiter_fallback.h"
 
+#include <atomic>
+
 #include "lib/ftl/logging.h"
 #include "flutter/common/threads.h"
 
 namespace shell {
 namespace {
 
+// The display cadence last reported by a presentation backend, in
+// microseconds. Zero until a backend reports one. Written from the GPU
+// thread, read on the UI thread.
+std::atomic<int64_t> g_observed_frame_interval_micros(0);
+
+// A reference point of the phase-locked tick grid, in microseconds since
+// the ftl::TimePoint epoch: synthetic vsyncs fall at this time plus whole
+// multiples of the observed interval. Zero until the first present report.
+// Written from the GPU thread, read on the UI thread.
+std::atomic<int64_t> g_locked_phase_micros(0);
+
+// Fraction of each present's residual phase error applied as correction.
+// Small enough to average out present-time jitter, large enough to track
+// display clock drift within a couple dozen frames.
+const int64_t kPhaseGainDivisor = 8;
+
 ftl::TimePoint SnapToNextTick(ftl::TimePoint value,
                               ftl::TimePoint tick_phase,
                               ftl::TimeDelta tick_interval) {
@@ -21,6 +39,49 @@ ftl::TimePoint SnapToNextTick(ftl::TimePoint value,
 
 }  // namespace
 
+void VsyncWaiterFallback::SetObservedFrameInterval(ftl::TimeDelta interval) {
+  if (interval <= ftl::TimeDelta::Zero()) {
+    return;
+  }
+  g_observed_frame_interval_micros = interval.ToMicroseconds();
+}
+
+void VsyncWaiterFallback::NotifyFramePresented(ftl::TimePoint present_time) {
+  const int64_t interval = g_observed_frame_interval_micros;
+  if (interval <= 0) {
+    return;
+  }
+
+  const int64_t present_micros =
+      (present_time - ftl::TimePoint()).ToMicroseconds();
+  int64_t phase = g_locked_phase_micros;
+  if (phase == 0) {
+    g_locked_phase_micros = present_micros;
+    return;
+  }
+
+  // Residual of the present time against the tick grid, mapped to
+  // [-interval/2, interval/2). Presents land a stable latency after true
+  // vsync, so driving this residual to zero locks the grid to the
+  // display's phase; the constant latency only shifts which tick a frame
+  // targets, not the cadence.
+  int64_t residual = (present_micros - phase) % interval;
+  if (residual < 0) {
+    residual += interval;
+  }
+  if (residual >= interval / 2) {
+    residual -= interval;
+  }
+
+  phase += residual / kPhaseGainDivisor;
+
+  // Keep the reference point near the present time so the modulo above
+  // never operates on an ever-growing distance.
+  phase += ((present_micros - phase) / interval) * interval;
+
+  g_locked_phase_micros = phase;
+}
+
 VsyncWaiterFallback::VsyncWaiterFallback()
     : phase_(ftl::TimePoint::Now()), weak_factory_(this) {}
 
@@ -30,10 +91,23 @@ void VsyncWaiterFallback::AsyncWaitForVsync(Callback callback) {
   FTL_DCHECK(!callback_);
   callback_ = std::move(callback);
 
-  constexpr ftl::TimeDelta interval = ftl::TimeDelta::FromSecondsF(1.0 / 60.0);
+  ftl::TimeDelta interval = ftl::TimeDelta::FromSecondsF(1.0 / 60.0);
+  const int64_t observed_micros = g_observed_frame_interval_micros;
+  if (observed_micros > 0) {
+    interval = ftl::TimeDelta::FromMicroseconds(observed_micros);
+  }
+
+  // Prefer the phase-locked grid once present reports have established
+  // one; the construction-time phase only seeds the first frames.
+  ftl::TimePoint phase = phase_;
+  const int64_t locked_phase_micros = g_locked_phase_micros;
+  if (locked_phase_micros != 0) {
+    phase =
+        ftl::TimePoint() + ftl::TimeDelta::FromMicroseconds(locked_phase_micros);
+  }
 
   ftl::TimePoint now = ftl::TimePoint::Now();
-  ftl::TimePoint next = SnapToNextTick(now, phase_, interval);
+  ftl::TimePoint next = SnapToNextTick(now, phase, interval);
 
   blink::Threads::UI()->PostDelayedTask(
       [self = weak_factory_.GetWeakPtr()] {
@@ -47,4 +121,8 @@ void VsyncWaiterFallback::AsyncWaitForVsync(Callback callback) {
       next - now);
 }
 
+ftl::TimeDelta VsyncWaiterFallback::GetDisplayRefreshInterval() const {
+  return ftl::TimeDelta::FromMicroseconds(g_observed_frame_interval_micros);
+}
+
 }  // namespace shell
@@ -8,6 +8,7 @@
 #include "flutter/shell/common/vsync_waiter.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/time/time_delta.h"
 #include "lib/ftl/time/time_point.h"
 
 namespace shell {
@@ -17,8 +18,27 @@ class VsyncWaiterFallback : public VsyncWaiter {
   VsyncWaiterFallback();
   ~VsyncWaiterFallback() override;
 
+  // Report the display cadence observed by a presentation backend (for
+  // example, the Vulkan swapchain measuring the spacing of its present
+  // operations). Fallback waiters tick at the reported interval instead of
+  // assuming 60Hz, letting the frame scheduler lock onto the true refresh
+  // rate on platforms without a native vsync source. May be called from any
+  // thread.
+  static void SetObservedFrameInterval(ftl::TimeDelta interval);
+
+  // Report the timestamp of an actual present operation. A phase-locked
+  // loop nudges the synthetic tick grid toward the reported times, so the
+  // fallback clock tracks the display's phase as well as its period and
+  // cannot drift the way a free-running timer does. May be called from any
+  // thread.
+  static void NotifyFramePresented(ftl::TimePoint present_time);
+
   void AsyncWaitForVsync(Callback callback) override;
 
+  // The interval last reported through SetObservedFrameInterval, or zero
+  // before any backend has reported one.
+  ftl::TimeDelta GetDisplayRefreshInterval() const override;
+
  private:
   ftl::TimePoint phase_;
   Callback callback_;
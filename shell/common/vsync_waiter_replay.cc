@@ -0,0 +1,78 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/vsync_waiter_replay.h"
+
+#include <utility>
+
+#include "flutter/common/threads.h"
+#include "flutter/shell/common/engine.h"
+
+namespace shell {
+
+namespace {
+
+const int64_t kDefaultIntervalMicros = 16667;
+
+}  // namespace
+
+VsyncWaiterReplay::VsyncWaiterReplay(ReplayLog log, ftl::WeakPtr<Engine> engine)
+    : log_(std::move(log)),
+      engine_(std::move(engine)),
+      tail_interval_micros_(kDefaultIntervalMicros),
+      weak_factory_(this) {
+  size_t count = log_.vsync_offsets_micros.size();
+  if (count >= 2) {
+    tail_interval_micros_ = log_.vsync_offsets_micros[count - 1] -
+                            log_.vsync_offsets_micros[count - 2];
+    if (tail_interval_micros_ <= 0) {
+      tail_interval_micros_ = kDefaultIntervalMicros;
+    }
+  }
+}
+
+VsyncWaiterReplay::~VsyncWaiterReplay() = default;
+
+void VsyncWaiterReplay::AsyncWaitForVsync(Callback callback) {
+  if (!started_) {
+    started_ = true;
+    replay_start_ = ftl::TimePoint::Now();
+  }
+
+  int64_t offset_micros;
+  if (next_vsync_ < log_.vsync_offsets_micros.size()) {
+    offset_micros = log_.vsync_offsets_micros[next_vsync_++];
+  } else {
+    offset_micros = last_offset_micros_ + tail_interval_micros_;
+  }
+  last_offset_micros_ = offset_micros;
+
+  // Hand the recorded input due by this vsync to the engine, then fire the
+  // frame callback with the virtualized frame time. Both run on the UI
+  // thread, where this waiter also lives, so member access is unsynchronized
+  // by construction.
+  ftl::TimePoint frame_time =
+      replay_start_ + ftl::TimeDelta::FromMicroseconds(offset_micros);
+  blink::Threads::UI()->PostTask([
+    self = weak_factory_.GetWeakPtr(), offset_micros, frame_time,
+    callback = std::move(callback)
+  ]() {
+    if (!self) {
+      return;
+    }
+    while (self->next_packet_ < self->log_.packets.size() &&
+           self->log_.packets[self->next_packet_].offset_micros <=
+               offset_micros) {
+      ReplayLog::Packet& packet = self->log_.packets[self->next_packet_++];
+      if (self->engine_) {
+        blink::PointerDataPacket pointer_packet(packet.bytes.data(),
+                                                packet.bytes.size());
+        self->engine_->DispatchPointerDataPacket(pointer_packet);
+      }
+    }
+    callback(frame_time);
+  });
+}
+
+}  // namespace shell
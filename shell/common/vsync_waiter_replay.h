@@ -0,0 +1,54 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_VSYNC_WAITER_REPLAY_H_
+#define FLUTTER_SHELL_COMMON_VSYNC_WAITER_REPLAY_H_
+
+#include <string>
+
+#include "flutter/shell/common/event_replay.h"
+#include "flutter/shell/common/vsync_waiter.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
+
+namespace shell {
+
+class Engine;
+
+// A vsync source driven by a recorded event log instead of the display.
+// Each wait is satisfied immediately with the next recorded vsync
+// timestamp, rebased onto a clock that starts when replay starts, and the
+// pointer packets recorded before that vsync are dispatched to the engine
+// first — so a benchmark run sees exactly the frame and input sequence of
+// the recording, back to back, without real-time pacing or input
+// nondeterminism. Once the log is exhausted, synthetic vsyncs continue at
+// the recording's final cadence so the application keeps running.
+class VsyncWaiterReplay : public VsyncWaiter {
+ public:
+  // |log| must have been loaded successfully by ReplayLog::Load.
+  VsyncWaiterReplay(ReplayLog log, ftl::WeakPtr<Engine> engine);
+
+  ~VsyncWaiterReplay() override;
+
+  void AsyncWaitForVsync(Callback callback) override;
+
+ private:
+  ReplayLog log_;
+  ftl::WeakPtr<Engine> engine_;
+  size_t next_vsync_ = 0;
+  size_t next_packet_ = 0;
+  // Cadence of the tail of the recording, used once the log runs out.
+  int64_t tail_interval_micros_;
+  int64_t last_offset_micros_ = 0;
+  ftl::TimePoint replay_start_;
+  bool started_ = false;
+
+  ftl::WeakPtrFactory<VsyncWaiterReplay> weak_factory_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterReplay);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_VSYNC_WAITER_REPLAY_H_
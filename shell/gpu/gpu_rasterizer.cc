@@ -4,26 +4,82 @@
 
 #include "gpu_rasterizer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <utility>
 
+#include "flutter/common/memory_pressure_listener.h"
+#include "flutter/common/performance_profile.h"
+#include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
+#include "flutter/fml/thread_pool.h"
 #include "flutter/glue/trace_event.h"
+#include "flutter/runtime/start_up.h"
+#include "flutter/shell/common/jank_reporter.h"
+#include "flutter/shell/common/layer_tree_snapshot.h"
+#include "flutter/shell/common/metrics_registry.h"
 #include "flutter/shell/common/picture_serializer.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell.h"
+#include "lib/ftl/functional/make_copyable.h"
+#include "lib/ftl/logging.h"
+#include "lib/ftl/time/time_point.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace shell {
 
 GPURasterizer::GPURasterizer(std::unique_ptr<flow::ProcessInfo> info)
-    : compositor_context_(std::move(info)), weak_factory_(this) {
+    : compositor_context_(std::move(info)),
+      dynamic_resolution_enabled_(
+          blink::Settings::Get().enable_dynamic_resolution),
+      has_resource_cache_limits_(false),
+      max_resource_count_(0),
+      max_resource_bytes_(0),
+      weak_factory_(this) {
   auto weak_ptr = weak_factory_.GetWeakPtr();
   blink::Threads::Gpu()->PostTask(
       [weak_ptr]() { Shell::Shared().AddRasterizer(weak_ptr); });
+  // Trims run on the GPU thread; removal in the destructor happens on the
+  // same thread, so |this| cannot dangle in the listener.
+  memory_pressure_listener_id_ =
+      blink::MemoryPressureListenerRegistry::AddListener(
+          blink::Threads::Gpu(), [this](blink::MemoryPressureLevel level) {
+            if (level == blink::MemoryPressureLevel::kCritical) {
+              // Drop the resource cache budget to zero so nothing is
+              // retained. Embedders restore their budget via
+              // SetResourceCacheLimits on resume.
+              SetResourceCacheLimits(0, 0);
+            }
+            PurgeResourceCache();
+            compositor_context_.raster_cache().Clear();
+          });
+  const std::string& hints_path = blink::Settings::Get().raster_cache_hints_path;
+  if (!hints_path.empty()) {
+    cache_hints_ = std::make_unique<flow::RasterCacheHints>();
+    cache_hints_->Load(hints_path);
+    compositor_context_.raster_cache().SetHints(cache_hints_.get());
+  }
+  profile_observer_id_ =
+      blink::PerformanceProfileObserverRegistry::AddObserver(
+          blink::Threads::Gpu(), [this](const blink::PerformanceProfile& profile) {
+            compositor_context_.raster_cache().SetCacheByteBudget(
+                profile.raster_cache_byte_budget);
+          });
 }
 
 GPURasterizer::~GPURasterizer() {
+  if (cache_hints_) {
+    cache_hints_->Save(blink::Settings::Get().raster_cache_hints_path);
+  }
+  blink::PerformanceProfileObserverRegistry::RemoveObserver(
+      profile_observer_id_);
+  blink::MemoryPressureListenerRegistry::RemoveListener(
+      memory_pressure_listener_id_);
   weak_factory_.InvalidateWeakPtrs();
   Shell::Shared().PurgeRasterizers();
 }
@@ -37,11 +93,187 @@ void GPURasterizer::Setup(std::unique_ptr<Surface> surface,
                           ftl::AutoResetWaitableEvent* setup_completion_event) {
   surface_ = std::move(surface);
 
+  // Limits configured before (or across) surfaces apply to this one too.
+  if (has_resource_cache_limits_ && surface_ != nullptr &&
+      surface_->GetContext() != nullptr) {
+    surface_->GetContext()->setResourceCacheLimits(max_resource_count_,
+                                                   max_resource_bytes_);
+  }
+
   continuation();
 
   setup_completion_event->Signal();
 }
 
+void GPURasterizer::DrawWarmUpPictures(
+    std::vector<sk_sp<SkPicture>> pictures) {
+  TRACE_EVENT0("flutter", "GPURasterizer::DrawWarmUpPictures");
+
+  if (surface_ == nullptr || pictures.empty()) {
+    return;
+  }
+
+  GrContext* gr_context = surface_->GetContext();
+
+  if (gr_context == nullptr) {
+    // Nothing to warm up without a GPU context.
+    return;
+  }
+
+  // A small scratch target is enough: shader compilation depends on the
+  // draw ops and paints, not the render target dimensions.
+  sk_sp<SkSurface> scratch_surface = SkSurface::MakeRenderTarget(
+      gr_context, SkBudgeted::kNo, SkImageInfo::MakeN32Premul(64, 64));
+
+  if (scratch_surface == nullptr) {
+    return;
+  }
+
+  SkCanvas* canvas = scratch_surface->getCanvas();
+  for (const auto& picture : pictures) {
+    if (picture) {
+      canvas->drawPicture(picture.get());
+    }
+  }
+  canvas->flush();
+}
+
+void GPURasterizer::SetResourceCacheLimits(int max_resource_count,
+                                           size_t max_resource_bytes) {
+  has_resource_cache_limits_ = true;
+  max_resource_count_ = max_resource_count;
+  max_resource_bytes_ = max_resource_bytes;
+  if (surface_ != nullptr && surface_->GetContext() != nullptr) {
+    surface_->GetContext()->setResourceCacheLimits(max_resource_count_,
+                                                   max_resource_bytes_);
+  }
+}
+
+void GPURasterizer::SetSceneChangeCallback(SceneChangeCallback callback) {
+  scene_change_callback_ = std::move(callback);
+}
+
+void GPURasterizer::SetFrameTimingCallback(FrameTimingCallback callback) {
+  frame_timing_callback_ = std::move(callback);
+}
+
+void GPURasterizer::PurgeResourceCache() {
+  TRACE_EVENT0("flutter", "GPURasterizer::PurgeResourceCache");
+  if (surface_ != nullptr && surface_->GetContext() != nullptr) {
+    surface_->GetContext()->freeGpuResources();
+  }
+  // The purge runs when the application pauses, which may be the last thing
+  // this process does; persist what the session learned while we can.
+  if (cache_hints_) {
+    cache_hints_->Save(blink::Settings::Get().raster_cache_hints_path);
+  }
+}
+
+void GPURasterizer::SetCacheHintRoute(const std::string& route) {
+  if (cache_hints_) {
+    cache_hints_->SetCurrentRoute(route);
+  }
+}
+
+void GPURasterizer::PrewarmSurface() {
+  if (surface_ == nullptr || last_layer_tree_ == nullptr) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "GPURasterizer::PrewarmSurface");
+
+  auto frame = surface_->AcquireFrame(last_layer_tree_->frame_size());
+  if (frame == nullptr) {
+    return;
+  }
+  auto canvas = frame->SkiaCanvas();
+  if (canvas == nullptr) {
+    return;
+  }
+
+  // Prerolling the last presented tree refills the raster cache and texture
+  // uploads a backgrounded purge dropped. The frame is then deliberately
+  // dropped without submitting: nothing may be presented here, the point is
+  // only that the first visible frame after a resume finds warm caches.
+  auto compositor_frame = compositor_context_.AcquireFrame(
+      surface_->GetContext(), canvas, false /* instrumentation */);
+  last_layer_tree_->Preroll(compositor_frame);
+}
+
+void GPURasterizer::PreRenderLayerTree(
+    std::unique_ptr<flow::LayerTree> layer_tree) {
+  if (surface_ == nullptr || layer_tree == nullptr ||
+      layer_tree->frame_size().isEmpty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "GPURasterizer::PreRenderLayerTree");
+
+  const SkISize& size = layer_tree->frame_size();
+  SkImageInfo info = SkImageInfo::MakeN32Premul(size.width(), size.height());
+
+  GrContext* gr_context = surface_->GetContext();
+  sk_sp<SkSurface> offscreen_surface =
+      gr_context != nullptr
+          ? SkSurface::MakeRenderTarget(gr_context, SkBudgeted::kYes, info)
+          : SkSurface::MakeRaster(info);
+  if (offscreen_surface == nullptr) {
+    return;
+  }
+
+  SkCanvas* canvas = offscreen_surface->getCanvas();
+  auto compositor_frame = compositor_context_.AcquireFrame(
+      gr_context, canvas, false /* instrumentation */);
+  layer_tree->Preroll(compositor_frame);
+  canvas->clear(SK_ColorBLACK);
+  layer_tree->Paint(compositor_frame);
+  canvas->flush();
+
+  // The snapshot is all that is retained; the tree itself is only needed
+  // again if its content changes, in which case the embedder pre-renders
+  // anew.
+  pre_rendered_image_ = offscreen_surface->makeImageSnapshot();
+}
+
+void GPURasterizer::PresentPreRenderedFrame() {
+  if (surface_ == nullptr || pre_rendered_image_ == nullptr) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "GPURasterizer::PresentPreRenderedFrame");
+
+  auto frame = surface_->AcquireFrame(
+      SkISize::Make(pre_rendered_image_->width(),
+                    pre_rendered_image_->height()));
+  if (frame == nullptr) {
+    return;
+  }
+  auto canvas = frame->SkiaCanvas();
+  if (canvas == nullptr) {
+    return;
+  }
+
+  canvas->clear(SK_ColorBLACK);
+  canvas->drawImage(pre_rendered_image_.get(), 0, 0);
+  frame->Submit();
+
+  // The surface no longer shows the last consumed layer tree, so neither
+  // the unchanged-scene comparison nor the damage history may be applied to
+  // the next frame.
+  last_layer_tree_.reset();
+  damage_history_.clear();
+}
+
+void GPURasterizer::SnapshotLastLayerTree(const std::string& path) {
+  if (last_layer_tree_ == nullptr || path.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "GPURasterizer::SnapshotLastLayerTree");
+  SnapshotLayerTree(*last_layer_tree_, compositor_context_, path);
+}
+
+void GPURasterizer::SetFrameRasterBudget(ftl::TimeDelta budget) {
+  compositor_context_.raster_cache().SetFrameFillBudget(
+      budget.ToMicroseconds());
+}
+
 void GPURasterizer::Clear(SkColor color, const SkISize& size) {
   if (surface_ == nullptr) {
     return;
@@ -70,6 +302,8 @@ void GPURasterizer::Teardown(
     surface_.reset();
   }
   last_layer_tree_.reset();
+  pre_rendered_image_.reset();
+  scaled_surface_.reset();
   compositor_context_.OnGrContextDestroyed();
   teardown_completion_event->Signal();
 }
@@ -79,16 +313,28 @@ flow::LayerTree* GPURasterizer::GetLastLayerTree() {
 }
 
 void GPURasterizer::Draw(
-    ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) {
+    ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline) {
   TRACE_EVENT0("flutter", "GPURasterizer::Draw");
 
-  flutter::Pipeline<flow::LayerTree>::Consumer consumer =
+  // If we have fallen more than an interval behind, everything pending but
+  // the newest tree is stale; drop those instead of rendering them
+  // back-to-back.
+  if (catchup_policy_.ShouldCatchUp(pipeline->GetLastConsumeLatency())) {
+    size_t dropped = pipeline->DropAllButNewest();
+    if (dropped > 0) {
+      TRACE_EVENT_INSTANT0("flutter", "FramesDropped");
+      catchup_policy_.RecordDroppedFrames(dropped);
+      compositor_context_.frames_dropped().Increment(dropped);
+    }
+  }
+
+  flutter::SPSCPipeline<flow::LayerTree>::Consumer consumer =
       std::bind(&GPURasterizer::DoDraw, this, std::placeholders::_1);
 
   // Consume as many pipeline items as possible. But yield the event loop
   // between successive tries.
   switch (pipeline->Consume(consumer)) {
-    case flutter::PipelineConsumeResult::MoreAvailable: {
+    case flutter::SPSCPipelineConsumeResult::MoreAvailable: {
       auto weak_this = weak_factory_.GetWeakPtr();
       blink::Threads::Gpu()->PostTask([weak_this, pipeline]() {
         if (weak_this) {
@@ -112,12 +358,67 @@ void GPURasterizer::DoDraw(std::unique_ptr<flow::LayerTree> layer_tree) {
   // for instrumentation.
   compositor_context_.engine_time().SetLapTime(layer_tree->construction_time());
 
+  // Registered once; updates from here on are single atomic adds.
+  static MetricsRegistry::Counter* frames_drawn =
+      MetricsRegistry::Shared().RegisterCounter("rasterizer.frames_drawn");
+  static MetricsRegistry::Counter* frames_unchanged =
+      MetricsRegistry::Shared().RegisterCounter("rasterizer.frames_unchanged");
+  static MetricsRegistry::Histogram* frame_micros =
+      MetricsRegistry::Shared().RegisterHistogram("rasterizer.frame_micros");
+
+  // A scene identical to the one already on screen does not need to be
+  // rasterized or presented again.
+  if (last_layer_tree_ != nullptr && layer_tree->Compare(*last_layer_tree_)) {
+    TRACE_EVENT0("flutter", "GPURasterizer::DoDraw (unchanged scene)");
+    frames_unchanged->Increment();
+    last_layer_tree_ = std::move(layer_tree);
+    if (scene_change_callback_) {
+      scene_change_callback_(true);
+    }
+    return;
+  }
+
+  auto draw_start = ftl::TimePoint::Now();
   DrawToSurface(*layer_tree);
+  auto draw_end = ftl::TimePoint::Now();
+  auto raster_time = draw_end - draw_start;
+  frames_drawn->Increment();
+  frame_micros->Record(raster_time.ToMicroseconds());
+  JankReporter::Shared().OnFrameEnd(
+      layer_tree->construction_time(), raster_time,
+      compositor_context_.raster_cache().frame_statistics());
+
+  if (frame_timing_callback_) {
+    auto build_start = layer_tree->frame_build_start();
+    auto build_end = build_start + layer_tree->construction_time();
+    FrameTimingRecord timing = {{
+        (layer_tree->frame_target_time() - ftl::TimePoint()).ToMicroseconds(),
+        (build_start - ftl::TimePoint()).ToMicroseconds(),
+        (build_end - ftl::TimePoint()).ToMicroseconds(),
+        (draw_start - ftl::TimePoint()).ToMicroseconds(),
+        (draw_end - ftl::TimePoint()).ToMicroseconds(),
+    }};
+    frame_timing_callback_(timing);
+  }
 
   last_layer_tree_ = std::move(layer_tree);
+
+  if (scene_change_callback_) {
+    scene_change_callback_(false);
+  }
 }
 
 void GPURasterizer::DrawToSurface(flow::LayerTree& layer_tree) {
+  if (dynamic_resolution_enabled_) {
+    double scale = scale_policy_.scale();
+    if (scale < 1.0 && DrawScaledToSurface(layer_tree, scale)) {
+      return;
+    }
+    // Full resolution: the smaller target is not needed until the policy
+    // steps down again.
+    scaled_surface_.reset();
+  }
+
   auto frame = surface_->AcquireFrame(layer_tree.frame_size());
 
   if (frame == nullptr) {
@@ -133,11 +434,197 @@ void GPURasterizer::DrawToSurface(flow::LayerTree& layer_tree) {
   auto compositor_frame =
       compositor_context_.AcquireFrame(surface_->GetContext(), canvas);
 
-  canvas->clear(SK_ColorBLACK);
+  layer_tree.Preroll(compositor_frame);
+
+  // Once both trees have been prerolled, the new tree can be diffed against
+  // the previous frame to restrict painting (and the buffer swap) to the
+  // region that actually changed.
+  if (last_layer_tree_ != nullptr &&
+      last_layer_tree_->frame_size() == layer_tree.frame_size()) {
+    flow::DamageArea damage = layer_tree.ComputeDamage(*last_layer_tree_);
+
+    // The buffer backing this frame may be several presents old, so the
+    // repaint region must also cover the damage of every frame that buffer
+    // missed. An age of zero (or one exceeding the recorded history) means
+    // the buffer contents are unknown and the whole frame repaints.
+    int buffer_age = frame->buffer_age();
+    bool partial_repaint =
+        buffer_age > 0 &&
+        static_cast<size_t>(buffer_age - 1) <= damage_history_.size();
+    flow::DamageArea repaint = damage;
+    if (partial_repaint) {
+      for (int i = 0; i < buffer_age - 1; i++)
+        repaint.Join(damage_history_[i]);
+    }
+
+    damage_history_.push_front(std::move(damage));
+    constexpr size_t kMaxDamageHistory = 8;
+    if (damage_history_.size() > kMaxDamageHistory)
+      damage_history_.pop_back();
+
+    if (partial_repaint) {
+      frame->set_submit_damage(repaint.Bounds());
+      // Clear each damaged rect; pixels between them keep the previous
+      // frame's content and stay untouched through the paint clip.
+      for (const SkRect& rect : repaint.rects()) {
+        canvas->save();
+        canvas->clipRect(rect);
+        canvas->clear(SK_ColorBLACK);
+        canvas->restore();
+      }
+      layer_tree.set_damage(repaint);
+    } else {
+      canvas->clear(SK_ColorBLACK);
+    }
+  } else {
+    damage_history_.clear();
+    canvas->clear(SK_ColorBLACK);
+  }
+
+  layer_tree.Paint(compositor_frame);
+
+  if (!pending_captures_.empty()) {
+    ServicePendingCaptures(canvas, layer_tree.frame_size());
+  }
+
+  frame->Submit();
+
+  if (!first_frame_presented_) {
+    first_frame_presented_ = true;
+    blink::RecordStartupMilestone(blink::kStartupMilestoneFirstFramePresented);
+    // The first present is the last startup milestone, so the metrics file
+    // (when requested) is complete now and written exactly once.
+    const std::string& metrics_path =
+        blink::Settings::Get().startup_metrics_path;
+    if (!metrics_path.empty() &&
+        !blink::WriteStartupMilestones(metrics_path)) {
+      FTL_LOG(ERROR) << "Could not write startup metrics to '" << metrics_path
+                     << "'.";
+    }
+  }
+
+  HarvestGpuFrameTimes();
+}
+
+bool GPURasterizer::DrawScaledToSurface(flow::LayerTree& layer_tree,
+                                        double scale) {
+  TRACE_EVENT0("flutter", "GPURasterizer::DrawScaledToSurface");
+
+  GrContext* gr_context = surface_->GetContext();
+  if (gr_context == nullptr) {
+    // Without a GPU context there is no offscreen render target and no
+    // fragment work to save.
+    return false;
+  }
+
+  const SkISize& frame_size = layer_tree.frame_size();
+  SkISize scaled_size = SkISize::Make(
+      std::max(1, static_cast<int>(std::ceil(frame_size.width() * scale))),
+      std::max(1, static_cast<int>(std::ceil(frame_size.height() * scale))));
+
+  if (scaled_surface_ == nullptr ||
+      scaled_surface_->width() != scaled_size.width() ||
+      scaled_surface_->height() != scaled_size.height()) {
+    scaled_surface_ = SkSurface::MakeRenderTarget(
+        gr_context, SkBudgeted::kYes,
+        SkImageInfo::MakeN32Premul(scaled_size.width(),
+                                   scaled_size.height()));
+    if (scaled_surface_ == nullptr) {
+      return false;
+    }
+  }
+
+  auto frame = surface_->AcquireFrame(frame_size);
+  if (frame == nullptr) {
+    return true;
+  }
+  SkCanvas* canvas = frame->SkiaCanvas();
+  if (canvas == nullptr) {
+    return true;
+  }
+
+  // The partial repaint diff is only valid between consecutive frames
+  // rendered at the same resolution; scaled frames repaint fully, and the
+  // first frame back at full resolution does too.
+  damage_history_.clear();
+
+  SkCanvas* scaled_canvas = scaled_surface_->getCanvas();
+  scaled_canvas->save();
+  scaled_canvas->scale(scale, scale);
+  scaled_canvas->clear(SK_ColorBLACK);
 
-  layer_tree.Raster(compositor_frame);
+  auto compositor_frame =
+      compositor_context_.AcquireFrame(gr_context, scaled_canvas);
+
+  layer_tree.Preroll(compositor_frame);
+  layer_tree.Paint(compositor_frame);
+  scaled_canvas->restore();
+
+  // Upscale into the full-resolution buffer. Bilinear filtering is enough
+  // for the 0.8-0.9x band and costs a fraction of the fragment work saved.
+  SkPaint paint;
+  paint.setFilterQuality(kLow_SkFilterQuality);
+  canvas->drawImageRect(
+      scaled_surface_->makeImageSnapshot().get(),
+      SkRect::MakeIWH(frame_size.width(), frame_size.height()), &paint);
+
+  if (!pending_captures_.empty()) {
+    ServicePendingCaptures(canvas, frame_size);
+  }
 
   frame->Submit();
+
+  HarvestGpuFrameTimes();
+  return true;
+}
+
+void GPURasterizer::HarvestGpuFrameTimes() {
+  // Each completed timing query describes a frame a few presents back,
+  // which is fine for the overlay, for telling CPU-bound from GPU-bound
+  // jank in the field, and for a scale policy reacting to trends.
+  ftl::TimeDelta gpu_time;
+  while (surface_->GetNextGpuFrameTime(&gpu_time)) {
+    compositor_context_.gpu_time().SetLapTime(gpu_time);
+    if (dynamic_resolution_enabled_) {
+      scale_policy_.AddGpuFrameTime(gpu_time);
+    }
+  }
+}
+
+void GPURasterizer::CaptureNextFrame(ScreenshotCallback callback) {
+  if (callback) {
+    pending_captures_.push_back(std::move(callback));
+  }
+}
+
+void GPURasterizer::ServicePendingCaptures(SkCanvas* canvas,
+                                           const SkISize& frame_size) {
+  TRACE_EVENT0("flutter", "GPURasterizer::ServicePendingCaptures");
+
+  std::vector<ScreenshotCallback> callbacks;
+  callbacks.swap(pending_captures_);
+
+  // Only the readback itself runs here: the frame was just rasterized so
+  // its pixels are still resident and no software re-rasterization of the
+  // layer tree is needed. Encoding and callback delivery move off to the
+  // worker pool.
+  SkBitmap bitmap;
+  const bool read =
+      bitmap.tryAllocN32Pixels(frame_size.width(), frame_size.height()) &&
+      canvas->readPixels(&bitmap, 0, 0);
+
+  fml::ThreadPool::GetSharedWorkerPool().PostWorkerTask(ftl::MakeCopyable(
+      [ callbacks = std::move(callbacks), bitmap, read ]() mutable {
+        sk_sp<SkData> png;
+        SkPixmap pixmap;
+        if (read && bitmap.peekPixels(&pixmap)) {
+          PngPixelSerializer serializer;
+          png.reset(serializer.encode(pixmap));
+        }
+        for (const auto& callback : callbacks) {
+          callback(png);
+        }
+      }));
 }
 
 }  // namespace shell
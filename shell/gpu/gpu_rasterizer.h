@@ -5,10 +5,19 @@
 #ifndef SHELL_GPU_DIRECT_GPU_RASTERIZER_H_
 #define SHELL_GPU_DIRECT_GPU_RASTERIZER_H_
 
+#include <deque>
+
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/damage_area.h"
+#include "flutter/flow/raster_cache_hints.h"
+#include "flutter/shell/common/frame_catchup_policy.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/resolution_scale_policy.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "lib/ftl/synchronization/waitable_event.h"
+#include "lib/ftl/time/time_delta.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace shell {
 
@@ -33,18 +42,89 @@ class GPURasterizer : public Rasterizer {
 
   flow::LayerTree* GetLastLayerTree() override;
 
-  void Draw(ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) override;
+  void Draw(ftl::RefPtr<flutter::SPSCPipeline<flow::LayerTree>> pipeline) override;
+
+  void DrawWarmUpPictures(std::vector<sk_sp<SkPicture>> pictures) override;
+
+  // Caps the synchronous raster cache fill time spent per frame so a
+  // heavyweight scene commits its cheap content on time while expensive
+  // cacheable subtrees are filled progressively over the following frames.
+  // A zero budget (the default) restores eager filling. Called on the GPU
+  // thread.
+  void SetFrameRasterBudget(ftl::TimeDelta budget);
+
+  void CaptureNextFrame(ScreenshotCallback callback) override;
+
+  void SetResourceCacheLimits(int max_resource_count,
+                              size_t max_resource_bytes) override;
+
+  void SetSceneChangeCallback(SceneChangeCallback callback) override;
+
+  void SetFrameTimingCallback(FrameTimingCallback callback) override;
+
+  void PurgeResourceCache() override;
+
+  void PrewarmSurface() override;
+
+  void PreRenderLayerTree(std::unique_ptr<flow::LayerTree> layer_tree) override;
+
+  void PresentPreRenderedFrame() override;
+
+  void SnapshotLastLayerTree(const std::string& path) override;
+
+  void SetCacheHintRoute(const std::string& route) override;
 
  private:
   std::unique_ptr<Surface> surface_;
   flow::CompositorContext compositor_context_;
+  FrameCatchUpPolicy catchup_policy_;
   std::unique_ptr<flow::LayerTree> last_layer_tree_;
+  // Damage painted by recent frames, most recent first, so a frame drawn
+  // into an aged swapchain buffer can repaint everything that buffer
+  // missed.
+  std::deque<flow::DamageArea> damage_history_;
+  // Per-route cache admission decisions, loaded at construction and saved
+  // when the application pauses, so the next session warms its caches on
+  // each screen's first frame. Null when no hints path is configured.
+  std::unique_ptr<flow::RasterCacheHints> cache_hints_;
+  // Dynamic resolution scaling, enabled by the enable-dynamic-resolution
+  // switch: the policy watches harvested GPU frame times and the scaled
+  // surface is the smaller offscreen target frames render into while the
+  // scale is below 1.0. Dropped whenever full resolution resumes.
+  bool dynamic_resolution_enabled_;
+  ResolutionScalePolicy scale_policy_;
+  sk_sp<SkSurface> scaled_surface_;
+  std::vector<ScreenshotCallback> pending_captures_;
+  // Offscreen rasterization of content expected to be shown soon; presented
+  // by PresentPreRenderedFrame as a stopgap while the live tree warms up.
+  sk_sp<SkImage> pre_rendered_image_;
+  SceneChangeCallback scene_change_callback_;
+  FrameTimingCallback frame_timing_callback_;
+  bool first_frame_presented_ = false;
+  bool has_resource_cache_limits_;
+  int max_resource_count_;
+  size_t max_resource_bytes_;
+  size_t memory_pressure_listener_id_;
+  size_t profile_observer_id_;
   ftl::WeakPtrFactory<GPURasterizer> weak_factory_;
 
   void DoDraw(std::unique_ptr<flow::LayerTree> layer_tree);
 
   void DrawToSurface(flow::LayerTree& layer_tree);
 
+  // Renders the tree at |scale| into the smaller offscreen target and
+  // upscales it into the acquired frame. Returns false when no offscreen
+  // target could be created, in which case the caller renders normally.
+  bool DrawScaledToSurface(flow::LayerTree& layer_tree, double scale);
+
+  // Collects completed GPU timing queries into the instrumentation
+  // stopwatch and, when dynamic resolution is enabled, the scale policy.
+  void HarvestGpuFrameTimes();
+
+  // Reads the just-rasterized frame back on the GPU thread and hands the
+  // pixels to the worker pool for encoding and delivery.
+  void ServicePendingCaptures(SkCanvas* canvas, const SkISize& frame_size);
+
   FTL_DISALLOW_COPY_AND_ASSIGN(GPURasterizer);
 };
 
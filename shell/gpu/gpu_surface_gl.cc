@@ -4,14 +4,160 @@
 
 #include "gpu_surface_gl.h"
 
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/glue/trace_event.h"
 #include "lib/ftl/arraysize.h"
+#include "lib/ftl/build_config.h"
 #include "lib/ftl/logging.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
+#if defined(OS_ANDROID)
+#include <EGL/egl.h>
+#include <GLES2/gl2.h>
+#endif
+
 namespace shell {
 
+#if defined(OS_ANDROID)
+
+// Measures GPU-side frame time with EXT_disjoint_timer_query. A query
+// brackets each frame's GL commands; results are harvested several frames
+// later so the GPU is never stalled waiting for one. All calls must be made
+// with the onscreen context current on the GPU thread.
+class GLFrameTimer {
+ public:
+  GLFrameTimer() {
+    gen_queries_ = reinterpret_cast<GenQueriesProc>(
+        eglGetProcAddress("glGenQueriesEXT"));
+    begin_query_ = reinterpret_cast<BeginQueryProc>(
+        eglGetProcAddress("glBeginQueryEXT"));
+    end_query_ =
+        reinterpret_cast<EndQueryProc>(eglGetProcAddress("glEndQueryEXT"));
+    get_query_uiv_ = reinterpret_cast<GetQueryObjectuivProc>(
+        eglGetProcAddress("glGetQueryObjectuivEXT"));
+    get_query_ui64v_ = reinterpret_cast<GetQueryObjectui64vProc>(
+        eglGetProcAddress("glGetQueryObjectui64vEXT"));
+    supported_ = gen_queries_ && begin_query_ && end_query_ &&
+                 get_query_uiv_ && get_query_ui64v_;
+  }
+
+  void BeginFrame() {
+    if (!supported_) {
+      return;
+    }
+    if (frame_active_) {
+      // The previous frame was dropped without presenting; discard its
+      // query rather than let it span the gap to this frame.
+      end_query_(kTimeElapsedEXT);
+      free_queries_.push_back(active_query_);
+      frame_active_ = false;
+    }
+    if (pending_queries_.size() >= kMaxPendingQueries) {
+      return;
+    }
+    if (free_queries_.empty()) {
+      GLuint query = 0;
+      gen_queries_(1, &query);
+      if (query == 0) {
+        return;
+      }
+      free_queries_.push_back(query);
+    }
+    active_query_ = free_queries_.back();
+    free_queries_.pop_back();
+    begin_query_(kTimeElapsedEXT, active_query_);
+    frame_active_ = true;
+  }
+
+  void EndFrame() {
+    if (!frame_active_) {
+      return;
+    }
+    end_query_(kTimeElapsedEXT);
+    pending_queries_.push_back(active_query_);
+    frame_active_ = false;
+  }
+
+  bool GetNextResult(ftl::TimeDelta* elapsed) {
+    if (!supported_ || pending_queries_.empty()) {
+      return false;
+    }
+    GLuint query = pending_queries_.front();
+    GLuint available = 0;
+    get_query_uiv_(query, kQueryResultAvailableEXT, &available);
+    if (!available) {
+      return false;
+    }
+    pending_queries_.pop_front();
+    uint64_t nanoseconds = 0;
+    get_query_ui64v_(query, kQueryResultEXT, &nanoseconds);
+    free_queries_.push_back(query);
+    // A disjoint event (GPU clock change, context switch) invalidates every
+    // in-flight measurement; drop this sample rather than report garbage.
+    GLint disjoint = 0;
+    glGetIntegerv(kGpuDisjointEXT, &disjoint);
+    if (disjoint) {
+      return false;
+    }
+    *elapsed = ftl::TimeDelta::FromNanoseconds(nanoseconds);
+    return true;
+  }
+
+ private:
+  // From EXT_disjoint_timer_query; not present in the GLES2 headers this
+  // file builds against.
+  static constexpr GLenum kTimeElapsedEXT = 0x88BF;
+  static constexpr GLenum kQueryResultEXT = 0x8866;
+  static constexpr GLenum kQueryResultAvailableEXT = 0x8867;
+  static constexpr GLenum kGpuDisjointEXT = 0x8FBB;
+
+  // If results stop being harvested (e.g. the app is backgrounded mid
+  // frame), stop issuing queries instead of growing without bound.
+  static constexpr size_t kMaxPendingQueries = 8;
+
+  typedef void (*GenQueriesProc)(GLsizei n, GLuint* ids);
+  typedef void (*BeginQueryProc)(GLenum target, GLuint id);
+  typedef void (*EndQueryProc)(GLenum target);
+  typedef void (*GetQueryObjectuivProc)(GLuint id, GLenum pname, GLuint* params);
+  typedef void (*GetQueryObjectui64vProc)(GLuint id,
+                                          GLenum pname,
+                                          uint64_t* params);
+
+  GenQueriesProc gen_queries_ = nullptr;
+  BeginQueryProc begin_query_ = nullptr;
+  EndQueryProc end_query_ = nullptr;
+  GetQueryObjectuivProc get_query_uiv_ = nullptr;
+  GetQueryObjectui64vProc get_query_ui64v_ = nullptr;
+  bool supported_ = false;
+  bool frame_active_ = false;
+  GLuint active_query_ = 0;
+  std::vector<GLuint> free_queries_;
+  std::deque<GLuint> pending_queries_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(GLFrameTimer);
+};
+
+#else  // defined(OS_ANDROID)
+
+// Platforms without a GL extension loader the engine can reach get no GPU
+// frame timing; the surface then reports nothing.
+class GLFrameTimer {
+ public:
+  GLFrameTimer() = default;
+  void BeginFrame() {}
+  void EndFrame() {}
+  bool GetNextResult(ftl::TimeDelta* elapsed) { return false; }
+
+ private:
+  FTL_DISALLOW_COPY_AND_ASSIGN(GLFrameTimer);
+};
+
+#endif  // defined(OS_ANDROID)
+
 // Default maximum number of budgeted resources in the cache.
 static const int kGrCacheMaxCount = 8192;
 
@@ -19,10 +165,29 @@ static const int kGrCacheMaxCount = 8192;
 // cache.
 static const size_t kGrCacheMaxByteSize = 512 * (1 << 20);
 
+// GrContexts parked by surfaces whose delegate keeps its GL context alive
+// across surface recreation, keyed by that delegate. Touched only on the
+// GPU thread. Deliberately leaked: a parked context may be revived at any
+// point in the process lifetime.
+static std::unordered_map<GPUSurfaceGLDelegate*, sk_sp<GrContext>>&
+ParkedGrContexts() {
+  static auto* contexts =
+      new std::unordered_map<GPUSurfaceGLDelegate*, sk_sp<GrContext>>();
+  return *contexts;
+}
+
 GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate)
     : delegate_(delegate), weak_factory_(this) {}
 
-GPUSurfaceGL::~GPUSurfaceGL() = default;
+GPUSurfaceGL::~GPUSurfaceGL() {
+  if (context_ != nullptr && delegate_ != nullptr &&
+      delegate_->GLContextPersistsAcrossSurfaces()) {
+    // Only the window or framebuffer is going away; park the context so
+    // the delegate's next surface skips the GPU cache rebuild.
+    cached_surface_ = nullptr;
+    ParkedGrContexts()[delegate_] = std::move(context_);
+  }
+}
 
 bool GPUSurfaceGL::Setup() {
   if (delegate_ == nullptr) {
@@ -40,6 +205,22 @@ bool GPUSurfaceGL::Setup() {
     return false;
   }
 
+  if (delegate_->GLContextPersistsAcrossSurfaces()) {
+    auto parked = ParkedGrContexts().find(delegate_);
+    if (parked != ParkedGrContexts().end()) {
+      // The GL context survived the previous surface teardown; revive its
+      // GrContext instead of rebuilding compiled shaders and the texture
+      // cache. The new framebuffer is picked up from the delegate when the
+      // first frame is acquired.
+      context_ = std::move(parked->second);
+      ParkedGrContexts().erase(parked);
+      // Arbitrary GL may have run since the context was parked.
+      context_->resetContext();
+      delegate_->GLContextClearCurrent();
+      return true;
+    }
+  }
+
   // Create the native interface.
   auto backend_context =
       reinterpret_cast<GrBackendContext>(GrGLCreateNativeInterface());
@@ -72,6 +253,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
     return nullptr;
   }
 
+  if (frame_timer_ == nullptr) {
+    frame_timer_ = std::make_unique<GLFrameTimer>();
+  }
+  frame_timer_->BeginFrame();
+
   sk_sp<SkSurface> surface = AcquireSurface(size);
 
   if (surface == nullptr) {
@@ -82,13 +268,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
 
   SurfaceFrame::SubmitCallback submit_callback = [weak_this](
       const SurfaceFrame& surface_frame, SkCanvas* canvas) {
-    return weak_this ? weak_this->PresentSurface(canvas) : false;
+    return weak_this ? weak_this->PresentSurface(surface_frame, canvas) : false;
   };
 
-  return std::make_unique<SurfaceFrame>(surface, submit_callback);
+  auto frame = std::make_unique<SurfaceFrame>(surface, submit_callback);
+  frame->set_buffer_age(delegate_->GLContextBufferAge());
+  return frame;
 }
 
-bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
+bool GPUSurfaceGL::PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas) {
   if (delegate_ == nullptr || canvas == nullptr) {
     return false;
   }
@@ -98,7 +286,15 @@ bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
     canvas->flush();
   }
 
-  delegate_->GLContextPresent();
+  if (frame_timer_ != nullptr) {
+    frame_timer_->EndFrame();
+  }
+
+  if (frame.has_submit_damage()) {
+    delegate_->GLContextPresentDamaged(frame.submit_damage());
+  } else {
+    delegate_->GLContextPresent();
+  }
 
   return true;
 }
@@ -155,6 +351,13 @@ sk_sp<SkSurface> GPUSurfaceGL::AcquireSurface(const SkISize& size) {
   return cached_surface_;
 }
 
+bool GPUSurfaceGL::GetNextGpuFrameTime(ftl::TimeDelta* elapsed) {
+  if (frame_timer_ == nullptr) {
+    return false;
+  }
+  return frame_timer_->GetNextResult(elapsed);
+}
+
 GrContext* GPUSurfaceGL::GetContext() {
   return context_.get();
 }
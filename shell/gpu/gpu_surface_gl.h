@@ -22,8 +22,31 @@ class GPUSurfaceGLDelegate {
   virtual bool GLContextPresent() = 0;
 
   virtual intptr_t GLContextFBO() const = 0;
+
+  // The age of the backbuffer made current, in presents: 1 means it still
+  // holds the previous frame's contents, 0 means its contents are
+  // undefined. The default matches contexts whose backbuffer is preserved
+  // across presents.
+  virtual int GLContextBufferAge() { return 1; }
+
+  // Presents with a hint describing the region that changed relative to the
+  // previous frame, for platforms with swap-with-damage support. The
+  // default ignores the hint.
+  virtual bool GLContextPresentDamaged(const SkRect& damage) {
+    return GLContextPresent();
+  }
+
+  // Whether the GL context this delegate makes current outlives any one
+  // surface, so that recreating the surface (rotation, resize, fold) only
+  // changes the window or framebuffer. When true, the GrContext — and with
+  // it compiled shaders and the texture cache — is parked when the surface
+  // is torn down and revived by the delegate's next surface instead of
+  // being rebuilt from scratch.
+  virtual bool GLContextPersistsAcrossSurfaces() const { return false; }
 };
 
+class GLFrameTimer;
+
 class GPUSurfaceGL : public Surface {
  public:
   GPUSurfaceGL(GPUSurfaceGLDelegate* delegate);
@@ -38,17 +61,20 @@ class GPUSurfaceGL : public Surface {
 
   GrContext* GetContext() override;
 
+  bool GetNextGpuFrameTime(ftl::TimeDelta* elapsed) override;
+
  private:
   GPUSurfaceGLDelegate* delegate_;
   sk_sp<GrContext> context_;
   sk_sp<SkSurface> cached_surface_;
+  std::unique_ptr<GLFrameTimer> frame_timer_;
   ftl::WeakPtrFactory<GPUSurfaceGL> weak_factory_;
 
   sk_sp<SkSurface> CreateSurface(const SkISize& size);
 
   sk_sp<SkSurface> AcquireSurface(const SkISize& size);
 
-  bool PresentSurface(SkCanvas* canvas);
+  bool PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas);
 
   bool SelectPixelConfig(GrPixelConfig* config);
 
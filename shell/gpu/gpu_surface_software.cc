@@ -5,6 +5,8 @@
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
 #include <memory>
+
+#include "flutter/flow/tiled_raster.h"
 #include "lib/ftl/logging.h"
 
 namespace shell {
@@ -47,11 +49,16 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  // Paint into a picture recording instead of the backing store itself. The
+  // submit callback replays the picture into the backing store in parallel
+  // tiles on the shared worker pool, falling back to a single-threaded replay
+  // when tiling does not apply.
+  SkCanvas* canvas =
+      recorder_.beginRecording(SkRect::MakeIWH(size.width(), size.height()));
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
-  SkCanvas* canvas = backing_store->getCanvas();
-  canvas->resetMatrix();
   canvas->scale(scale, scale);
 
   SurfaceFrame::SubmitCallback
@@ -63,12 +70,24 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
       return false;
     }
 
-    canvas->flush();
-
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    sk_sp<SkPicture> picture = self->recorder_.finishRecordingAsPicture();
+    sk_sp<SkSurface> backing_store = surface_frame.SkiaSurface();
+    if (!flow::RasterPictureTiled(picture.get(), backing_store.get())) {
+      picture->playback(backing_store->getCanvas());
+    }
+    backing_store->getCanvas()->flush();
+
+    // When the rasterizer restricted painting to the damage region, pass
+    // that region on so the delegate's copy to the display can be equally
+    // restricted.
+    if (surface_frame.has_submit_damage()) {
+      return self->delegate_->PresentBackingStoreWithDamage(
+          backing_store, surface_frame.submit_damage());
+    }
+    return self->delegate_->PresentBackingStore(backing_store);
   };
 
-  return std::make_unique<SurfaceFrame>(backing_store, on_submit);
+  return std::make_unique<SurfaceFrame>(backing_store, canvas, on_submit);
 }
 
 GrContext* GPUSurfaceSoftware::GetContext() {
@@ -8,6 +8,7 @@
 #include "flutter/shell/common/surface.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace shell {
@@ -15,7 +16,17 @@ namespace shell {
 class GPUSurfaceSoftwareDelegate {
  public:
   virtual sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) = 0;
+
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  // Presents a frame in which only |damage| changed relative to the frame
+  // presented before it. Delegates that copy or upload the backing store can
+  // restrict themselves to that region. The default forwards to the
+  // full-frame present.
+  virtual bool PresentBackingStoreWithDamage(sk_sp<SkSurface> backing_store,
+                                             const SkRect& damage) {
+    return PresentBackingStore(std::move(backing_store));
+  }
 };
 
 class GPUSurfaceSoftware : public Surface {
@@ -37,6 +48,10 @@ class GPUSurfaceSoftware : public Surface {
  private:
   GPUSurfaceSoftwareDelegate* delegate_;
 
+  // Frames are recorded into a picture and replayed into the backing store in
+  // parallel tiles at submit time. See AcquireFrame.
+  SkPictureRecorder recorder_;
+
   ftl::WeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
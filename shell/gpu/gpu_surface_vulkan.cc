@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/gpu/gpu_surface_vulkan.h"
+#include "flutter/shell/common/vsync_waiter_fallback.h"
 #include "lib/ftl/logging.h"
 
 namespace shell {
@@ -43,7 +44,23 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
     if (canvas == nullptr || !weak_this) {
       return false;
     }
-    return weak_this->window_.SwapBuffers();
+    if (!weak_this->window_.SwapBuffers()) {
+      return false;
+    }
+    // Feed the measured present cadence back to the frame scheduler so it
+    // can lock onto the true display refresh instead of assuming 60Hz.
+    auto present_interval = weak_this->window_.GetObservedPresentInterval();
+    if (present_interval != ftl::TimeDelta::Zero()) {
+      VsyncWaiterFallback::SetObservedFrameInterval(present_interval);
+      // The phase matters as much as the period: present timestamps keep
+      // the fallback waiter's synthetic ticks aligned with the display
+      // clock instead of merely matching its rate.
+      auto present_time = weak_this->window_.GetLastPresentTime();
+      if (present_time != ftl::TimePoint()) {
+        VsyncWaiterFallback::NotifyFramePresented(present_time);
+      }
+    }
+    return true;
   };
   return std::make_unique<SurfaceFrame>(std::move(surface),
                                         std::move(callback));
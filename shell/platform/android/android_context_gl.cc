@@ -247,6 +247,60 @@ bool AndroidContextGL::SwapBuffers() {
   return eglSwapBuffers(environment_->Display(), surface_);
 }
 
+bool AndroidContextGL::SwapBuffersWithDamage(const SkRect& damage) {
+  TRACE_EVENT0("flutter", "AndroidContextGL::SwapBuffersWithDamage");
+
+  typedef EGLBoolean (*SwapBuffersWithDamageProc)(EGLDisplay display,
+                                                  EGLSurface surface,
+                                                  EGLint* rects,
+                                                  EGLint n_rects);
+  static SwapBuffersWithDamageProc swap_proc =
+      reinterpret_cast<SwapBuffersWithDamageProc>(
+          eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+
+  if (swap_proc == nullptr) {
+    return eglSwapBuffers(environment_->Display(), surface_);
+  }
+
+  // EGL damage rectangles have a bottom-left origin.
+  const SkIRect bounds = damage.roundOut();
+  EGLint rect[4] = {bounds.left(), GetSize().height() - bounds.bottom(),
+                    bounds.width(), bounds.height()};
+  return swap_proc(environment_->Display(), surface_, rect, 1) == EGL_TRUE;
+}
+
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
+int AndroidContextGL::BufferAge() {
+  EGLint age = 0;
+  if (eglQuerySurface(environment_->Display(), surface_, EGL_BUFFER_AGE_EXT,
+                      &age) != EGL_TRUE) {
+    return 0;
+  }
+  return age;
+}
+
+bool AndroidContextGL::SetPresentationTime(int64_t time_nanos) {
+  // The extension entry point is not declared in the EGL headers this tree
+  // builds against, so it is resolved through eglGetProcAddress. The loader
+  // returns nullptr when EGL_ANDROID_presentation_time is unsupported.
+  typedef EGLBoolean (*PresentationTimeProc)(EGLDisplay display,
+                                             EGLSurface surface,
+                                             int64_t time_nanos);
+  static PresentationTimeProc present_proc =
+      reinterpret_cast<PresentationTimeProc>(
+          eglGetProcAddress("eglPresentationTimeANDROID"));
+
+  if (present_proc == nullptr) {
+    return false;
+  }
+
+  return present_proc(environment_->Display(), surface_, time_nanos) ==
+         EGL_TRUE;
+}
+
 SkISize AndroidContextGL::GetSize() {
   EGLint width = 0;
   EGLint height = 0;
@@ -11,6 +11,7 @@
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/ref_counted.h"
 #include "lib/ftl/memory/ref_ptr.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace shell {
@@ -27,6 +28,22 @@ class AndroidContextGL : public ftl::RefCountedThreadSafe<AndroidContextGL> {
 
   bool SwapBuffers();
 
+  /// Swaps, passing the changed region to the compositor via
+  /// EGL_KHR_swap_buffers_with_damage. Falls back to a plain swap when the
+  /// extension is unavailable.
+  bool SwapBuffersWithDamage(const SkRect& damage);
+
+  /// The age of the current back buffer in presents, per
+  /// EGL_EXT_buffer_age: 1 means it still holds the previous frame's
+  /// contents. Returns 0 (contents undefined) when the extension is
+  /// unsupported.
+  int BufferAge();
+
+  /// Tells SurfaceFlinger not to latch the next swapped frame before the
+  /// given CLOCK_MONOTONIC time via EGL_ANDROID_presentation_time. Returns
+  /// false (and swaps remain unpaced) when the extension is unavailable.
+  bool SetPresentationTime(int64_t time_nanos);
+
   SkISize GetSize();
 
   bool Resize(const SkISize& size);
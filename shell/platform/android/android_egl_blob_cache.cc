@@ -0,0 +1,45 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_egl_blob_cache.h"
+
+#include <dlfcn.h>
+
+#include "lib/ftl/logging.h"
+
+namespace shell {
+namespace {
+
+// android::egl_set_cache_filename(const char*). Not part of the NDK, so the
+// mangled symbol is looked up in the already loaded libEGL.
+constexpr char kSetCacheFilenameSymbol[] =
+    "_ZN7android21egl_set_cache_filenameEPKc";
+
+typedef void (*SetCacheFilenameProc)(const char* filename);
+
+}  // namespace
+
+void ConfigureEGLBlobCache(const std::string& cache_directory) {
+  if (cache_directory.empty()) {
+    return;
+  }
+
+  void* libegl = dlopen("libEGL.so", RTLD_NOW | RTLD_NOLOAD);
+  if (libegl == nullptr) {
+    return;
+  }
+
+  auto set_cache_filename = reinterpret_cast<SetCacheFilenameProc>(
+      dlsym(libegl, kSetCacheFilenameSymbol));
+  if (set_cache_filename == nullptr) {
+    FTL_DLOG(INFO) << "EGL blob cache entry point unavailable; shader "
+                      "binaries will not persist across launches.";
+    return;
+  }
+
+  std::string cache_file = cache_directory + "/flutter_egl_blob_cache.bin";
+  set_cache_filename(cache_file.c_str());
+}
+
+}  // namespace shell
@@ -0,0 +1,27 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_EGL_BLOB_CACHE_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_EGL_BLOB_CACHE_H_
+
+#include <string>
+
+namespace shell {
+
+// Points the Android EGL loader's driver blob cache at a file inside the
+// application cache directory so that compiled shader program binaries
+// survive process restarts. The loader implements EGL_ANDROID_blob_cache on
+// behalf of the driver and keys entries by driver build, but only persists
+// them once it has been given a backing file. The entry point that supplies
+// the file is private to libEGL, so it is resolved dynamically; on devices
+// where it is unavailable this is a no-op and the cache stays in memory as
+// before.
+//
+// Must be called before the display is initialized for the loader to pick
+// the file up on first use.
+void ConfigureEGLBlobCache(const std::string& cache_directory);
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_EGL_BLOB_CACHE_H_
@@ -4,10 +4,18 @@
 
 #include "flutter/shell/platform/android/android_environment_gl.h"
 
+#include "flutter/common/settings.h"
+#include "flutter/shell/platform/android/android_egl_blob_cache.h"
+
 namespace shell {
 
 AndroidEnvironmentGL::AndroidEnvironmentGL()
     : display_(EGL_NO_DISPLAY), valid_(false) {
+  // Give the EGL loader a backing file for its driver blob cache before the
+  // display connection is initialized so shader program binaries compiled
+  // this launch are available to the next one.
+  ConfigureEGLBlobCache(blink::Settings::Get().temp_directory_path);
+
   // Get the display.
   display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
 
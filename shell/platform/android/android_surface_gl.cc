@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/common/threads.h"
+#include "flutter/shell/platform/android/vsync_waiter_android.h"
 #include "lib/ftl/logging.h"
 #include "lib/ftl/memory/ref_ptr.h"
 
@@ -138,11 +139,37 @@ bool AndroidSurfaceGL::GLContextClearCurrent() {
   return onscreen_context_->ClearCurrent();
 }
 
+// Asks SurfaceFlinger to present the next swapped frame at the vsync after
+// the one that started it. Without an explicit target, a frame finishing
+// near a vsync boundary may latch a refresh late and show up as judder.
+// Pacing is best effort: if the presentation time extension or a vsync
+// timestamp is unavailable, the swap proceeds unpaced as before.
+static void ScheduleFramePresentationTime(
+    const ftl::RefPtr<AndroidContextGL>& context) {
+  int64_t last_vsync = VsyncWaiterAndroid::LastFrameTimeNanos();
+  if (last_vsync != 0) {
+    int64_t interval = VsyncWaiterAndroid::FrameIntervalNanos();
+    context->SetPresentationTime(last_vsync + 2 * interval);
+  }
+}
+
 bool AndroidSurfaceGL::GLContextPresent() {
   FTL_DCHECK(onscreen_context_ && onscreen_context_->IsValid());
+  ScheduleFramePresentationTime(onscreen_context_);
   return onscreen_context_->SwapBuffers();
 }
 
+bool AndroidSurfaceGL::GLContextPresentDamaged(const SkRect& damage) {
+  FTL_DCHECK(onscreen_context_ && onscreen_context_->IsValid());
+  ScheduleFramePresentationTime(onscreen_context_);
+  return onscreen_context_->SwapBuffersWithDamage(damage);
+}
+
+int AndroidSurfaceGL::GLContextBufferAge() {
+  FTL_DCHECK(onscreen_context_ && onscreen_context_->IsValid());
+  return onscreen_context_->BufferAge();
+}
+
 intptr_t AndroidSurfaceGL::GLContextFBO() const {
   FTL_DCHECK(onscreen_context_ && onscreen_context_->IsValid());
   // The default window bound framebuffer on Android.
@@ -44,6 +44,10 @@ class AndroidSurfaceGL : public GPUSurfaceGLDelegate, public AndroidSurface {
 
   bool GLContextPresent() override;
 
+  bool GLContextPresentDamaged(const SkRect& damage) override;
+
+  int GLContextBufferAge() override;
+
   intptr_t GLContextFBO() const override;
 
  private:
@@ -218,8 +218,11 @@ public class FlutterActivity extends Activity implements PluginRegistry {
     public void onTrimMemory(int level) {
         // Use a trim level delivered while the application is running so the
         // framework has a chance to react to the notification.
-        if (level == TRIM_MEMORY_RUNNING_LOW)
-            flutterView.onMemoryPressure();
+        if (level == TRIM_MEMORY_RUNNING_CRITICAL) {
+            flutterView.onMemoryPressure(true);
+        } else if (level == TRIM_MEMORY_RUNNING_LOW) {
+            flutterView.onMemoryPressure(false);
+        }
     }
 
     private class FlutterRegistrar implements Registrar  {
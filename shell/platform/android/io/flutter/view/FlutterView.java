@@ -36,6 +36,7 @@ import io.flutter.plugin.platform.PlatformPlugin;
 import org.json.JSONException;
 import org.json.JSONObject;
 
+import java.io.UnsupportedEncodingException;
 import java.net.URI;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
@@ -82,6 +83,20 @@ public class FlutterView extends SurfaceView
     private final List<ActivityLifecycleListener> mActivityLifecycleListeners;
     private long mNativePlatformView;
 
+    // Outbound platform messages are appended to this direct buffer and
+    // dispatched across JNI in one batch per looper iteration, instead of one
+    // transition and byte[] copy per message.
+    private static final int MESSAGE_BATCH_CAPACITY = 64 * 1024;
+    private ByteBuffer mMessageBatch;
+    private boolean mMessageBatchFlushScheduled = false;
+    private final Runnable mMessageBatchFlusher = new Runnable() {
+        @Override
+        public void run() {
+            mMessageBatchFlushScheduled = false;
+            flushMessageBatch();
+        }
+    };
+
     public FlutterView(Context context) {
         this(context, null);
     }
@@ -213,10 +228,11 @@ public class FlutterView extends SurfaceView
         mFlutterLifecycleChannel.send("AppLifecycleState.resumed");
     }
 
-    public void onMemoryPressure() {
+    public void onMemoryPressure(boolean critical) {
         Map<String, Object> message = new HashMap<>(1);
         message.put("type", "memoryPressure");
         mFlutterSystemChannel.send(message);
+        nativeNotifyMemoryPressure(mNativePlatformView, critical);
     }
 
     public void pushRoute(String route) {
@@ -248,6 +264,7 @@ public class FlutterView extends SurfaceView
         }
 
         getHolder().removeCallback(mSurfaceCallback);
+        flushMessageBatch();
         nativeDetach(mNativePlatformView);
         mNativePlatformView = 0;
     }
@@ -376,6 +393,9 @@ public class FlutterView extends SurfaceView
         } else {
             packet.putDouble(0.0); // tilt
         }
+
+        // Coalesced move history is attached on the engine side.
+        packet.putLong(0); // history_count
     }
 
     @Override
@@ -394,7 +414,7 @@ public class FlutterView extends SurfaceView
         }
 
         // These values must match the unpacking code in hooks.dart.
-        final int kPointerDataFieldCount = 19;
+        final int kPointerDataFieldCount = 20;
         final int kBytePerField = 8;
 
         int pointerCount = event.getPointerCount();
@@ -572,12 +592,20 @@ public class FlutterView extends SurfaceView
     private static native void nativeDispatchEmptyPlatformMessage(long nativePlatformViewAndroid,
         String channel, int responseId);
 
+    // Send a batch of platform messages to Dart in one JNI transition. See
+    // appendToMessageBatch for the record format.
+    private static native void nativeDispatchPlatformMessageBatch(long nativePlatformViewAndroid,
+        ByteBuffer buffer, int position);
+
     private static native void nativeDispatchPointerDataPacket(long nativePlatformViewAndroid,
         ByteBuffer buffer, int position);
 
     private static native void nativeDispatchSemanticsAction(long nativePlatformViewAndroid, int id,
         int action);
 
+    private static native void nativeNotifyMemoryPressure(long nativePlatformViewAndroid,
+        boolean critical);
+
     private static native void nativeSetSemanticsEnabled(long nativePlatformViewAndroid,
         boolean enabled);
 
@@ -614,6 +642,9 @@ public class FlutterView extends SurfaceView
                             if (done.getAndSet(true)) {
                                 throw new IllegalStateException("Reply already submitted");
                             }
+                            // Messages the handler sent before replying must
+                            // arrive before the reply does.
+                            flushMessageBatch();
                             if (reply == null) {
                                 nativeInvokePlatformMessageEmptyResponseCallback(mNativePlatformView,
                                     replyId);
@@ -777,12 +808,70 @@ public class FlutterView extends SurfaceView
             replyId = mNextReplyId++;
             mPendingReplies.put(replyId, callback);
         }
+        if (!appendToMessageBatch(channel, message, replyId)) {
+            // Messages too large for the batch buffer take the direct path;
+            // flush first so per-channel ordering is preserved.
+            flushMessageBatch();
+            if (message == null) {
+                nativeDispatchEmptyPlatformMessage(mNativePlatformView, channel, replyId);
+            } else {
+                nativeDispatchPlatformMessage(mNativePlatformView, channel, message,
+                    message.position(), replyId);
+            }
+        }
+    }
+
+    // Each batch record is the channel length, the channel's UTF-8 bytes, the
+    // reply id, and the payload length (-1 for an empty message) followed by
+    // the payload bytes, all in the platform byte order. Must be kept in sync
+    // with PlatformViewAndroid::DispatchPlatformMessageBatch.
+    private boolean appendToMessageBatch(String channel, ByteBuffer message, int replyId) {
+        byte[] channelBytes;
+        try {
+            channelBytes = channel.getBytes("UTF-8");
+        } catch (UnsupportedEncodingException e) {
+            throw new AssertionError(e);
+        }
+        int payloadLength = (message == null) ? 0 : message.position();
+        int recordLength = 12 + channelBytes.length + payloadLength;
+        if (recordLength > MESSAGE_BATCH_CAPACITY) {
+            return false;
+        }
+        if (mMessageBatch == null) {
+            mMessageBatch = ByteBuffer.allocateDirect(MESSAGE_BATCH_CAPACITY);
+            mMessageBatch.order(ByteOrder.nativeOrder());
+        }
+        if (mMessageBatch.remaining() < recordLength) {
+            flushMessageBatch();
+        }
+        mMessageBatch.putInt(channelBytes.length);
+        mMessageBatch.put(channelBytes);
+        mMessageBatch.putInt(replyId);
         if (message == null) {
-            nativeDispatchEmptyPlatformMessage(mNativePlatformView, channel, replyId);
+            mMessageBatch.putInt(-1);
         } else {
-            nativeDispatchPlatformMessage(mNativePlatformView, channel, message,
-                message.position(), replyId);
+            mMessageBatch.putInt(payloadLength);
+            ByteBuffer payload = message.duplicate();
+            payload.flip();
+            mMessageBatch.put(payload);
+        }
+        if (!mMessageBatchFlushScheduled) {
+            mMessageBatchFlushScheduled = true;
+            post(mMessageBatchFlusher);
+        }
+        return true;
+    }
+
+    private void flushMessageBatch() {
+        if (mMessageBatch == null || mMessageBatch.position() == 0
+                || mNativePlatformView == 0) {
+            return;
         }
+        // The native side copies every record out during this call, so the
+        // buffer can be reused immediately.
+        nativeDispatchPlatformMessageBatch(mNativePlatformView, mMessageBatch,
+            mMessageBatch.position());
+        mMessageBatch.clear();
     }
 
     @Override
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/android/platform_view_android.h"
 
 #include <android/native_window_jni.h>
+#include <string.h>
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -106,7 +107,10 @@ static std::unique_ptr<AndroidSurface> InitializePlatformSurface() {
 
 PlatformViewAndroid::PlatformViewAndroid()
     : PlatformView(std::make_unique<GPURasterizer>(nullptr)),
-      android_surface_(InitializePlatformSurface()) {
+      android_surface_(InitializePlatformSurface()),
+      pending_pointer_packets_(
+          ftl::MakeRefCounted<
+              flutter::MPSCTakeAllQueue<blink::PointerDataPacket>>()) {
   CreateEngine();
 
   // Eagerly setup the IO thread context. We have already setup the surface.
@@ -256,18 +260,82 @@ void PlatformViewAndroid::DispatchEmptyPlatformMessage(JNIEnv* env,
           std::move(name), std::move(response)));
 }
 
+void PlatformViewAndroid::DispatchPlatformMessageBatch(JNIEnv* env,
+                                                       jobject buffer,
+                                                       jint position) {
+  const uint8_t* data =
+      static_cast<const uint8_t*>(env->GetDirectBufferAddress(buffer));
+  const uint8_t* end = data + position;
+  const uint8_t* cursor = data;
+
+  // Each record is the channel length, the channel's UTF-8 bytes, the
+  // response id, and the payload length (-1 for an empty message) followed
+  // by the payload bytes, all in the platform byte order. Must be kept in
+  // sync with FlutterView.appendToMessageBatch. Every record is copied out
+  // before this call returns so the Java side can reuse the buffer.
+  auto read_int32 = [&cursor]() {
+    int32_t value;
+    memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return value;
+  };
+
+  while (cursor + sizeof(int32_t) <= end) {
+    int32_t channel_length = read_int32();
+    if (channel_length < 0 || channel_length > end - cursor)
+      break;
+    std::string name(reinterpret_cast<const char*>(cursor), channel_length);
+    cursor += channel_length;
+
+    if (end - cursor < static_cast<ptrdiff_t>(2 * sizeof(int32_t)))
+      break;
+    int32_t response_id = read_int32();
+    int32_t payload_length = read_int32();
+
+    ftl::RefPtr<blink::PlatformMessageResponse> response;
+    if (response_id) {
+      response = ftl::MakeRefCounted<PlatformMessageResponseAndroid>(
+          response_id, GetWeakPtr());
+    }
+
+    if (payload_length < 0) {
+      PlatformView::DispatchPlatformMessage(
+          ftl::MakeRefCounted<blink::PlatformMessage>(std::move(name),
+                                                      std::move(response)));
+      continue;
+    }
+
+    if (payload_length > end - cursor)
+      break;
+    std::vector<uint8_t> message(cursor, cursor + payload_length);
+    cursor += payload_length;
+
+    PlatformView::DispatchPlatformMessage(
+        ftl::MakeRefCounted<blink::PlatformMessage>(
+            std::move(name), std::move(message), std::move(response)));
+  }
+}
+
 void PlatformViewAndroid::DispatchPointerDataPacket(JNIEnv* env,
                                                     jobject buffer,
                                                     jint position) {
   uint8_t* data = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
 
-  blink::Threads::UI()->PostTask(ftl::MakeCopyable([
-    engine = engine_->GetWeakPtr(),
-    packet = std::make_unique<PointerDataPacket>(data, position)
-  ] {
-    if (engine.get())
-      engine->DispatchPointerDataPacket(*packet);
-  }));
+  // Queue the packet with a single atomic push and wake the UI thread only on
+  // the empty-to-non-empty transition, so a burst of events costs one posted
+  // task instead of one per event.
+  if (!pending_pointer_packets_->Enqueue(
+          std::make_unique<PointerDataPacket>(data, position)))
+    return;
+
+  blink::Threads::UI()->PostTask(
+      [ engine = engine_->GetWeakPtr(), packets = pending_pointer_packets_ ] {
+        auto drained = packets->TakeAll();
+        if (!engine.get())
+          return;
+        for (const auto& packet : drained)
+          engine->DispatchPointerDataPacket(*packet);
+      });
 }
 
 void PlatformViewAndroid::InvokePlatformMessageResponseCallback(
@@ -317,10 +385,10 @@ void PlatformViewAndroid::HandlePlatformMessage(
   auto java_channel = fml::jni::StringToJavaString(env, message->channel());
   if (message->hasData()) {
     fml::jni::ScopedJavaLocalRef<jbyteArray> message_array(env,
-        env->NewByteArray(message->data().size()));
+        env->NewByteArray(message->GetDataSize()));
     env->SetByteArrayRegion(
-        message_array.obj(), 0, message->data().size(),
-        reinterpret_cast<const jbyte*>(message->data().data()));
+        message_array.obj(), 0, message->GetDataSize(),
+        reinterpret_cast<const jbyte*>(message->GetData()));
     message = nullptr;
 
     // This call can re-enter in InvokePlatformMessageXxxResponseCallback.
@@ -13,9 +13,11 @@
 #include "flutter/fml/platform/android/jni_weak_ref.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/platform/android/android_native_window.h"
 #include "flutter/shell/platform/android/android_surface.h"
+#include "flutter/synchronization/mpsc_take_all_queue.h"
 #include "lib/ftl/memory/weak_ptr.h"
 
 namespace shell {
@@ -61,6 +63,8 @@ class PlatformViewAndroid : public PlatformView {
                                     std::string name,
                                     jint response_id);
 
+  void DispatchPlatformMessageBatch(JNIEnv* env, jobject buffer, jint position);
+
   void DispatchPointerDataPacket(JNIEnv* env, jobject buffer, jint position);
 
   void InvokePlatformMessageResponseCallback(JNIEnv* env,
@@ -102,6 +106,9 @@ class PlatformViewAndroid : public PlatformView {
  private:
   const std::unique_ptr<AndroidSurface> android_surface_;
   fml::jni::JavaObjectWeakGlobalRef flutter_view_;
+  // Shared with UI-thread drain tasks, which may outlive this view.
+  ftl::RefPtr<flutter::MPSCTakeAllQueue<blink::PointerDataPacket>>
+      pending_pointer_packets_;
   // We use id 0 to mean that no response is expected.
   int next_response_id_ = 1;
   std::unordered_map<int, ftl::RefPtr<blink::PlatformMessageResponse>>
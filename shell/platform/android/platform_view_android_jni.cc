@@ -156,6 +156,14 @@ static void DispatchEmptyPlatformMessage(JNIEnv* env,
       env, fml::jni::JavaStringToString(env, channel), responseId);
 }
 
+static void DispatchPlatformMessageBatch(JNIEnv* env,
+                                         jobject jcaller,
+                                         jlong platform_view,
+                                         jobject buffer,
+                                         jint position) {
+  return PLATFORM_VIEW->DispatchPlatformMessageBatch(env, buffer, position);
+}
+
 static void DispatchPointerDataPacket(JNIEnv* env,
                                       jobject jcaller,
                                       jlong platform_view,
@@ -172,6 +180,15 @@ static void DispatchSemanticsAction(JNIEnv* env,
   return PLATFORM_VIEW->DispatchSemanticsAction(id, action);
 }
 
+static void NotifyMemoryPressure(JNIEnv* env,
+                                 jobject jcaller,
+                                 jlong platform_view,
+                                 jboolean critical) {
+  return PLATFORM_VIEW->NotifyMemoryPressure(
+      critical ? blink::MemoryPressureLevel::kCritical
+               : blink::MemoryPressureLevel::kModerate);
+}
+
 static void SetSemanticsEnabled(JNIEnv* env,
                                 jobject jcaller,
                                 jlong platform_view,
@@ -271,6 +288,11 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
           .signature = "(JLjava/lang/String;I)V",
           .fnPtr = reinterpret_cast<void*>(&shell::DispatchEmptyPlatformMessage),
       },
+      {
+          .name = "nativeDispatchPlatformMessageBatch",
+          .signature = "(JLjava/nio/ByteBuffer;I)V",
+          .fnPtr = reinterpret_cast<void*>(&shell::DispatchPlatformMessageBatch),
+      },
       {
           .name = "nativeDispatchPointerDataPacket",
           .signature = "(JLjava/nio/ByteBuffer;I)V",
@@ -281,6 +303,11 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
           .signature = "(JII)V",
           .fnPtr = reinterpret_cast<void*>(&shell::DispatchSemanticsAction),
       },
+      {
+          .name = "nativeNotifyMemoryPressure",
+          .signature = "(JZ)V",
+          .fnPtr = reinterpret_cast<void*>(&shell::NotifyMemoryPressure),
+      },
       {
           .name = "nativeSetSemanticsEnabled",
           .signature = "(JZ)V",
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
+#include <atomic>
 #include <utility>
 
 #include "flutter/common/threads.h"
@@ -17,6 +18,11 @@ namespace shell {
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
 
+// Vsync timebase observed on the platform thread and read on the GPU thread
+// when scheduling presentation times, hence the atomics.
+static std::atomic<int64_t> g_last_frame_time_nanos(0);
+static std::atomic<int64_t> g_frame_interval_nanos(16666667);
+
 VsyncWaiterAndroid::VsyncWaiterAndroid() : weak_factory_(this) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
@@ -36,7 +42,26 @@ void VsyncWaiterAndroid::AsyncWaitForVsync(Callback callback) {
   });
 }
 
+int64_t VsyncWaiterAndroid::LastFrameTimeNanos() {
+  return g_last_frame_time_nanos.load();
+}
+
+int64_t VsyncWaiterAndroid::FrameIntervalNanos() {
+  return g_frame_interval_nanos.load();
+}
+
 void VsyncWaiterAndroid::OnVsync(long frameTimeNanos) {
+  int64_t last_frame_time_nanos = g_last_frame_time_nanos.load();
+  g_last_frame_time_nanos.store(frameTimeNanos);
+
+  // Refine the refresh interval estimate from consecutive vsyncs. Deltas
+  // outside the plausible 30Hz-240Hz range are dropped frames or the first
+  // vsync after an idle period, not a refresh rate change.
+  int64_t delta = frameTimeNanos - last_frame_time_nanos;
+  if (delta >= 4000000 && delta <= 34000000) {
+    g_frame_interval_nanos.store(delta);
+  }
+
   Callback callback = std::move(callback_);
   callback_ = Callback();
 
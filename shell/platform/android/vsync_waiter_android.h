@@ -20,6 +20,15 @@ class VsyncWaiterAndroid : public VsyncWaiter {
 
   static bool Register(JNIEnv* env);
 
+  // The timestamp of the most recently observed vsync, in the
+  // CLOCK_MONOTONIC base the choreographer reports. Zero until the first
+  // vsync arrives. Safe to call from any thread.
+  static int64_t LastFrameTimeNanos();
+
+  // The display refresh interval estimated from consecutive vsync
+  // timestamps. Safe to call from any thread.
+  static int64_t FrameIntervalNanos();
+
   void AsyncWaitForVsync(Callback callback) override;
 
   void OnVsync(long frameTimeNanos);
@@ -473,6 +473,10 @@ static inline PointerChangeMapperPhase PointerChangePhaseFromUITouchPhase(UITouc
 #pragma mark - Memory Notifications
 
 - (void)onMemoryWarning:(NSNotification*)notification {
+  // iOS does not grade its warnings and jetsam follows quickly, so treat
+  // every one as critical. The framework is notified in parallel so it can
+  // shed Dart-side caches.
+  _platformView->NotifyMemoryPressure(blink::MemoryPressureLevel::kCritical);
   [_systemChannel.get() sendMessage:@{ @"type" : @"memoryPressure" }];
 }
 
@@ -23,6 +23,16 @@ class VsyncWaiterIOS : public VsyncWaiter {
 
   void AsyncWaitForVsync(Callback callback) override;
 
+  // The timestamp of the most recently observed display link callback, in
+  // the CACurrentMediaTime base. Zero until the first callback arrives.
+  // Safe to call from any thread.
+  static double LastFrameTimeSeconds();
+
+  // The display refresh interval the display link last reported, which
+  // tracks the current refresh rate on variable-rate displays. Safe to call
+  // from any thread.
+  static double FrameIntervalSeconds();
+
  private:
   Callback callback_;
   VSyncClient* client_;
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/darwin/ios/framework/Source/vsync_waiter_ios.h"
 
+#include <atomic>
 #include <utility>
 
 #include <Foundation/Foundation.h>
@@ -14,6 +15,11 @@
 #include "flutter/glue/trace_event.h"
 #include "lib/ftl/logging.h"
 
+// Display link timebase observed on the UI thread and read on the GPU thread
+// when scheduling timed presents, hence the atomics.
+static std::atomic<double> g_last_frame_time_seconds(0.0);
+static std::atomic<double> g_frame_interval_seconds(1.0 / 60.0);
+
 @interface VSyncClient : NSObject
 
 @end
@@ -49,6 +55,13 @@
 - (void)onDisplayLink:(CADisplayLink*)link {
   _displayLink.paused = YES;
 
+  g_last_frame_time_seconds.store(link.timestamp);
+  // The reported duration follows the refresh rate, which varies on
+  // ProMotion displays.
+  if (link.duration > 0.0) {
+    g_frame_interval_seconds.store(link.duration);
+  }
+
   // Note: Even though we know we are on the UI thread already (since the
   // display link was scheduled on the UI thread in the contructor), we use
   // the PostTask mechanism because the callback may have side-effects that need
@@ -85,4 +98,12 @@ void VsyncWaiterIOS::AsyncWaitForVsync(Callback callback) {
   [client_ await:callback];
 }
 
+double VsyncWaiterIOS::LastFrameTimeSeconds() {
+  return g_last_frame_time_seconds.load();
+}
+
+double VsyncWaiterIOS::FrameIntervalSeconds() {
+  return g_frame_interval_seconds.load();
+}
+
 }  // namespace shell
@@ -4,6 +4,14 @@
 
 #include "flutter/shell/platform/darwin/ios/ios_gl_context.h"
 
+#include "flutter/shell/platform/darwin/ios/framework/Source/vsync_waiter_ios.h"
+
+// Declared here so this file still compiles against SDKs that predate the
+// timed-present API (iOS 10.3); availability is checked at runtime.
+@interface EAGLContext (FlutterTimedPresent)
+- (BOOL)presentRenderbuffer:(NSUInteger)target atTime:(CFTimeInterval)presentationTime;
+@end
+
 namespace shell {
 
 #define VERIFY(x)                     \
@@ -138,7 +146,23 @@ bool IOSGLContext::PresentRenderBuffer() const {
   glDiscardFramebufferEXT(GL_FRAMEBUFFER, sizeof(discards) / sizeof(GLenum), discards);
 
   glBindRenderbuffer(GL_RENDERBUFFER, colorbuffer_);
-  return [[EAGLContext currentContext] presentRenderbuffer:GL_RENDERBUFFER];
+
+  EAGLContext* context = [EAGLContext currentContext];
+
+  // Target the vsync after the one that started this frame. An explicit
+  // presentation time keeps Core Animation from latching a frame that
+  // finishes near a refresh boundary a vsync late, and follows the display
+  // link interval on variable-rate (ProMotion) displays. Falls back to an
+  // unpaced present on SDKs or devices without the timed-present API.
+  static BOOL supports_timed_present =
+      [context respondsToSelector:@selector(presentRenderbuffer:atTime:)];
+  double last_vsync = VsyncWaiterIOS::LastFrameTimeSeconds();
+  if (supports_timed_present && last_vsync > 0.0) {
+    double interval = VsyncWaiterIOS::FrameIntervalSeconds();
+    return [context presentRenderbuffer:GL_RENDERBUFFER atTime:last_vsync + 2 * interval];
+  }
+
+  return [context presentRenderbuffer:GL_RENDERBUFFER];
 }
 
 bool IOSGLContext::UpdateStorageSizeIfNecessary() {
@@ -36,6 +36,8 @@ class IOSSurfaceGL : public IOSSurface, public GPUSurfaceGLDelegate {
 
   intptr_t GLContextFBO() const override;
 
+  bool GLContextPersistsAcrossSurfaces() const override;
+
  private:
   IOSGLContext context_;
 
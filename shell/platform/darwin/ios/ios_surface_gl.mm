@@ -36,6 +36,12 @@ intptr_t IOSSurfaceGL::GLContextFBO() const {
   return IsValid() ? context_.framebuffer() : GL_NONE;
 }
 
+bool IOSSurfaceGL::GLContextPersistsAcrossSurfaces() const {
+  // The EAGLContext lives in |context_| for the lifetime of this object,
+  // spanning the GPU surfaces created and destroyed around it.
+  return true;
+}
+
 bool IOSSurfaceGL::GLContextMakeCurrent() {
   return IsValid() ? context_.MakeCurrent() : false;
 }
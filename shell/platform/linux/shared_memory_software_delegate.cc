@@ -0,0 +1,195 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/shared_memory_software_delegate.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+
+#include "lib/ftl/logging.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace shell {
+
+namespace {
+
+const uint32_t kSharedFrameMagic = 0x42534c46;  // 'FLSB'
+const uint32_t kSharedFrameVersion = 1;
+
+// The pixel buffers start page-aligned so the display process can map them
+// with whatever granularity its compositor prefers.
+size_t PageAlign(size_t size) {
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  return (size + page_size - 1) & ~(page_size - 1);
+}
+
+}  // namespace
+
+SharedMemorySoftwareDelegate::SharedMemorySoftwareDelegate(std::string name)
+    : name_(std::move(name)) {}
+
+SharedMemorySoftwareDelegate::~SharedMemorySoftwareDelegate() {
+  DestroyRegion();
+}
+
+bool SharedMemorySoftwareDelegate::IsValid() const {
+  return region_ != nullptr && !size_.isEmpty();
+}
+
+SharedFrameHeader* SharedMemorySoftwareDelegate::header() const {
+  return reinterpret_cast<SharedFrameHeader*>(region_);
+}
+
+void SharedMemorySoftwareDelegate::DestroyRegion() {
+  if (region_ != nullptr) {
+    munmap(region_, region_size_);
+    region_ = nullptr;
+    region_size_ = 0;
+  }
+  if (shm_fd_ >= 0) {
+    close(shm_fd_);
+    shm_fd_ = -1;
+    shm_unlink(name_.c_str());
+  }
+  size_ = SkISize::Make(0, 0);
+  backing_store_ = nullptr;
+  previous_damage_ = SkIRect::MakeEmpty();
+  buffer_initialized_[0] = buffer_initialized_[1] = false;
+}
+
+bool SharedMemorySoftwareDelegate::ResizeRegion(const SkISize& size) {
+  DestroyRegion();
+
+  const size_t row_bytes = size.width() * 4;
+  const size_t buffer_size = PageAlign(row_bytes * size.height());
+  const size_t header_size = PageAlign(sizeof(SharedFrameHeader));
+  const size_t region_size = header_size + 2 * buffer_size;
+
+  shm_fd_ = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0600);
+  if (shm_fd_ < 0) {
+    FTL_LOG(ERROR) << "Could not open shared memory '" << name_ << "'.";
+    return false;
+  }
+  if (ftruncate(shm_fd_, region_size) != 0) {
+    FTL_LOG(ERROR) << "Could not size shared memory '" << name_ << "'.";
+    DestroyRegion();
+    return false;
+  }
+  void* mapping = mmap(nullptr, region_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, shm_fd_, 0);
+  if (mapping == MAP_FAILED) {
+    FTL_LOG(ERROR) << "Could not map shared memory '" << name_ << "'.";
+    DestroyRegion();
+    return false;
+  }
+
+  region_ = static_cast<uint8_t*>(mapping);
+  region_size_ = region_size;
+  size_ = size;
+
+  SharedFrameHeader* frame_header = header();
+  memset(frame_header, 0, sizeof(SharedFrameHeader));
+  frame_header->magic = kSharedFrameMagic;
+  frame_header->version = kSharedFrameVersion;
+  frame_header->width = size.width();
+  frame_header->height = size.height();
+  frame_header->row_bytes = row_bytes;
+  frame_header->buffer_offset[0] = header_size;
+  frame_header->buffer_offset[1] = header_size + buffer_size;
+  return true;
+}
+
+sk_sp<SkSurface> SharedMemorySoftwareDelegate::AcquireBackingStore(
+    const SkISize& size) {
+  if (size.isEmpty()) {
+    return nullptr;
+  }
+  if (size != size_ || region_ == nullptr) {
+    if (!ResizeRegion(size)) {
+      return nullptr;
+    }
+    backing_store_ = nullptr;
+  }
+  // The engine rasterizes into a private store rather than the shared
+  // buffers: the store always holds a complete frame, so each present only
+  // has to copy the damaged rows into shared memory.
+  if (backing_store_ == nullptr) {
+    backing_store_ =
+        SkSurface::MakeRasterN32Premul(size.width(), size.height());
+  }
+  return backing_store_;
+}
+
+bool SharedMemorySoftwareDelegate::PresentBackingStore(
+    sk_sp<SkSurface> backing_store) {
+  return Publish(backing_store.get(),
+                 SkIRect::MakeWH(size_.width(), size_.height()));
+}
+
+bool SharedMemorySoftwareDelegate::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const SkRect& damage) {
+  SkIRect damage_rect;
+  damage.roundOut(&damage_rect);
+  return Publish(backing_store.get(), damage_rect);
+}
+
+bool SharedMemorySoftwareDelegate::Publish(SkSurface* backing_store,
+                                           const SkIRect& damage) {
+  if (!IsValid() || backing_store == nullptr) {
+    return false;
+  }
+
+  SkPixmap pixels;
+  if (!backing_store->peekPixels(&pixels)) {
+    return false;
+  }
+
+  SharedFrameHeader* frame_header = header();
+  const uint32_t back = frame_header->front_buffer == 0 ? 1 : 0;
+
+  // The back buffer was front while the previous frame was published, so it
+  // also misses that frame's damage; a buffer never written needs all of its
+  // rows. This is the double-buffered analogue of the swapchain buffer-age
+  // repaint in the rasterizer.
+  SkIRect copy_rect = damage;
+  copy_rect.join(previous_damage_);
+  if (!buffer_initialized_[back]) {
+    copy_rect = SkIRect::MakeWH(size_.width(), size_.height());
+  }
+  if (!copy_rect.intersect(SkIRect::MakeWH(size_.width(), size_.height()))) {
+    copy_rect = SkIRect::MakeEmpty();
+  }
+
+  uint8_t* destination = region_ + frame_header->buffer_offset[back];
+  const size_t row_bytes = frame_header->row_bytes;
+  const size_t copy_bytes = copy_rect.width() * 4;
+  const uint8_t* source = static_cast<const uint8_t*>(pixels.addr());
+  for (int y = copy_rect.top(); y < copy_rect.bottom(); y++) {
+    memcpy(destination + y * row_bytes + copy_rect.left() * 4,
+           source + y * pixels.rowBytes() + copy_rect.left() * 4, copy_bytes);
+  }
+  buffer_initialized_[back] = true;
+
+  // Seqlock publication: readers that observe an odd sequence, or a sequence
+  // that changed while they read, retry.
+  frame_header->sequence++;
+  __sync_synchronize();
+  frame_header->front_buffer = back;
+  frame_header->damage_left = damage.left();
+  frame_header->damage_top = damage.top();
+  frame_header->damage_right = damage.right();
+  frame_header->damage_bottom = damage.bottom();
+  __sync_synchronize();
+  frame_header->sequence++;
+
+  previous_damage_ = damage;
+  return true;
+}
+
+}  // namespace shell
@@ -0,0 +1,100 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_SHARED_MEMORY_SOFTWARE_DELEGATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_SHARED_MEMORY_SOFTWARE_DELEGATE_H_
+
+#include <string>
+
+#include "flutter/shell/gpu/gpu_surface_software.h"
+#include "lib/ftl/macros.h"
+
+namespace shell {
+
+// Layout of the shared memory region a SharedMemorySoftwareDelegate
+// publishes frames into. The display process maps the same region read-only
+// and composites from the front buffer.
+//
+// Publication uses a seqlock: |sequence| is incremented to an odd value
+// before the header fields are updated and to the next even value after.
+// A reader that sees an odd value, or a value that changed across its read,
+// retries.
+struct SharedFrameHeader {
+  // 'F' 'L' 'S' 'B' in ascending addresses.
+  uint32_t magic;
+  uint32_t version;
+  uint32_t width;
+  uint32_t height;
+  uint32_t row_bytes;
+  // Offsets of the two pixel buffers from the start of the region.
+  uint32_t buffer_offset[2];
+  volatile uint32_t sequence;
+  // Index of the buffer holding the newest published frame.
+  uint32_t front_buffer;
+  // The region of the newest frame that differs from the one before it, so
+  // a display process that retains its own copy can blit minimally too.
+  int32_t damage_left;
+  int32_t damage_top;
+  int32_t damage_right;
+  int32_t damage_bottom;
+};
+
+// A software surface delegate that presents through a double-buffered
+// shared memory region instead of handing the embedder a full-size surface
+// to blit. The engine rasterizes into a private backing store; on present,
+// only the damaged region (widened with what the back buffer missed while
+// it was front) is copied into shared memory, cutting memory bandwidth on
+// displays driven by a separate process with no GPU.
+//
+// All methods run on the GPU thread.
+class SharedMemorySoftwareDelegate : public GPUSurfaceSoftwareDelegate {
+ public:
+  // |name| is the shm_open name the display process maps, e.g.
+  // "/flutter-frames".
+  explicit SharedMemorySoftwareDelegate(std::string name);
+
+  ~SharedMemorySoftwareDelegate() override;
+
+  // Whether the shared memory region exists and matches the last acquired
+  // size.
+  bool IsValid() const;
+
+  // |GPUSurfaceSoftwareDelegate| implementation:
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override;
+
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
+
+  bool PresentBackingStoreWithDamage(sk_sp<SkSurface> backing_store,
+                                     const SkRect& damage) override;
+
+ private:
+  std::string name_;
+  int shm_fd_ = -1;
+  uint8_t* region_ = nullptr;
+  size_t region_size_ = 0;
+  SkISize size_ = SkISize::Make(0, 0);
+  sk_sp<SkSurface> backing_store_;
+  // Damage of the previously published frame; the buffer being written now
+  // was front at the time and missed it.
+  SkIRect previous_damage_ = SkIRect::MakeEmpty();
+  // Buffers that have never been fully written must receive a full copy
+  // regardless of damage.
+  bool buffer_initialized_[2] = {false, false};
+
+  SharedFrameHeader* header() const;
+
+  // Tears down and recreates the region for |size|. Returns false when the
+  // shared memory cannot be created or mapped.
+  bool ResizeRegion(const SkISize& size);
+
+  void DestroyRegion();
+
+  bool Publish(SkSurface* backing_store, const SkIRect& damage);
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(SharedMemorySoftwareDelegate);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_SHARED_MEMORY_SOFTWARE_DELEGATE_H_
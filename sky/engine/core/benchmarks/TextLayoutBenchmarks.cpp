@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures text layout, shaping, and paint through the real rendering
+// pipeline (the same RenderView/RenderParagraph/RenderText trees
+// ParagraphBuilder creates from Dart), over a small corpus chosen so each
+// script family that takes a different shaping path is reported
+// separately: simple Latin, CJK, Arabic with embedded Latin (bidi), and
+// emoji-mixed text. Layout is benchmarked at several widths because line
+// breaking dominates differently in narrow and wide paragraphs.
+//
+// Fonts resolve through FontCache against the host's platform fonts; a
+// host without coverage for a script falls back to boxes, which still
+// exercises the layout and shaping code paths these numbers gate.
+
+#include <stdio.h>
+#include <algorithm>
+
+#include "flutter/fml/message_loop.h"
+#include "flutter/sky/engine/core/rendering/PaintInfo.h"
+#include "flutter/sky/engine/core/rendering/RenderParagraph.h"
+#include "flutter/sky/engine/core/rendering/RenderText.h"
+#include "flutter/sky/engine/core/rendering/RenderView.h"
+#include "flutter/sky/engine/core/rendering/style/RenderStyle.h"
+#include "flutter/sky/engine/platform/fonts/FontCache.h"
+#include "flutter/sky/engine/platform/graphics/GraphicsContext.h"
+#include "flutter/sky/engine/platform/text/TextRun.h"
+#include "flutter/sky/engine/public/platform/Platform.h"
+#include "flutter/sky/engine/public/web/Sky.h"
+#include "flutter/sky/engine/wtf/OwnPtr.h"
+#include "flutter/sky/engine/wtf/PassOwnPtr.h"
+#include "flutter/sky/engine/wtf/benchmarks/BenchmarkHarness.h"
+#include "flutter/sky/engine/wtf/text/WTFString.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace {
+
+using namespace blink;
+using WTF::benchmarking::consume;
+
+// Each corpus entry is a few sentences so a paragraph breaks into multiple
+// lines at the benchmarked widths.
+const char kLatinText[] =
+    "The quick brown fox jumps over the lazy dog. Pack my box with five "
+    "dozen liquor jugs. How vexingly quick daft zebras jump! The five "
+    "boxing wizards jump quickly over the sleeping guard dog tonight.";
+
+const char kCJKText[] =
+    "永和九年，歲在癸丑，暮春之初，會于會稽山陰之蘭亭，修禊事也。"
+    "群賢畢至，少長咸集。此地有崇山峻嶺，茂林修竹，又有清流激湍，"
+    "映帶左右，引以為流觴曲水，列坐其次。";
+
+// Arabic with embedded Latin words and digits forces bidi reordering on
+// every line.
+const char kArabicBidiText[] =
+    "القراءة هي عملية معرفية معقدة تتطلب فك الرموز، راجع الفصل Chapter 4 "
+    "صفحة 128 للمزيد من التفاصيل حول HarfBuzz والتشكيل، ثم أعد المحاولة "
+    "بعد تحديث الخطوط المثبتة على الجهاز المستخدم في الاختبار.";
+
+const char kEmojiMixedText[] =
+    "Launch day 🚀 went well 🎉 except the perf graphs 📉 which need "
+    "attention 🔧 before the next release 🗓️ ships to everyone 🌍 with "
+    "the new renderer 🖼️ enabled by default 👍.";
+
+class Corpus {
+public:
+    explicit Corpus(const char* utf8Text)
+        : m_text(String::fromUTF8(utf8Text))
+    {
+        RefPtr<RenderStyle> viewStyle = RenderStyle::create();
+        viewStyle->setRTLOrdering(LogicalOrder);
+        viewStyle->setZIndex(0);
+        viewStyle->setUserModify(READ_ONLY);
+
+        FontDescription fontDescription;
+        fontDescription.setSpecifiedSize(14);
+        fontDescription.setComputedSize(14);
+        fontDescription.setOrientation(Horizontal);
+        viewStyle->setFontDescription(fontDescription);
+        // No font selector: families resolve straight through FontCache to
+        // the host's platform fonts, like a paragraph with no custom fonts.
+        viewStyle->font().update(nullptr);
+
+        m_renderView = adoptPtr(new RenderView());
+        m_renderView->setStyle(viewStyle.release());
+
+        RefPtr<RenderStyle> paragraphStyle = RenderStyle::create();
+        paragraphStyle->inheritFrom(m_renderView->style());
+        paragraphStyle->setDisplay(PARAGRAPH);
+        RenderParagraph* paragraph = new RenderParagraph();
+        paragraph->setStyle(paragraphStyle.release());
+        m_renderView->addChild(paragraph);
+
+        RenderText* renderText = new RenderText(m_text.impl());
+        RefPtr<RenderStyle> textStyle = RenderStyle::create();
+        textStyle->inheritFrom(paragraph->style());
+        renderText->setStyle(textStyle.release());
+        paragraph->addChild(renderText);
+    }
+
+    ~Corpus()
+    {
+        if (m_renderView)
+            m_renderView.leakPtr()->destroy();
+    }
+
+    void layoutAt(int width)
+    {
+        m_renderView->setFrameViewSize(IntSize(width, intMaxForLayoutUnit));
+        m_renderView->layout();
+    }
+
+    // Layout |iterations| times near |width|. The width is wobbled by one
+    // pixel between iterations because an unchanged frame view size makes
+    // RenderView::layout a no-op.
+    void benchmarkLayout(size_t iterations, int width)
+    {
+        FontCachePurgePreventer purgePreventer;
+        for (size_t i = 0; i < iterations; ++i) {
+            layoutAt(width + static_cast<int>(i & 1));
+            consume(m_renderView.get());
+        }
+    }
+
+    // The shaping path in isolation: measuring a run shapes it without any
+    // line breaking or box construction on top.
+    void benchmarkShape(size_t iterations)
+    {
+        FontCachePurgePreventer purgePreventer;
+        const Font& font = m_renderView->style()->font();
+        for (size_t i = 0; i < iterations; ++i) {
+            TextRun run(m_text);
+            float width = font.width(run);
+            consume(&width);
+        }
+    }
+
+    void benchmarkPaint(size_t iterations, int width)
+    {
+        FontCachePurgePreventer purgePreventer;
+        layoutAt(width);
+
+        RenderBox* box = m_renderView->firstChildBox();
+        LayoutRect bounds = box->absoluteBoundingBoxRect();
+        sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(
+            width, std::max(1, enclosingIntRect(bounds).height()));
+        if (!surface)
+            return;
+        SkCanvas* canvas = surface->getCanvas();
+
+        // The same layer-less subtree paint Paragraph::paint performs.
+        for (size_t i = 0; i < iterations; ++i) {
+            canvas->clear(SK_ColorWHITE);
+            GraphicsContext context(canvas);
+            PaintInfo paintInfo(&context, enclosingIntRect(bounds), box);
+            Vector<RenderBox*> layers;
+            box->paint(paintInfo, LayoutPoint(), layers);
+            consume(canvas);
+        }
+    }
+
+private:
+    String m_text;
+    OwnPtr<RenderView> m_renderView;
+};
+
+// Corpora are built lazily so construction happens after InitEngine, not
+// during static initialization.
+Corpus& latin() { static Corpus corpus(kLatinText); return corpus; }
+Corpus& cjk() { static Corpus corpus(kCJKText); return corpus; }
+Corpus& arabicBidi() { static Corpus corpus(kArabicBidiText); return corpus; }
+Corpus& emojiMixed() { static Corpus corpus(kEmojiMixedText); return corpus; }
+
+WTF_BENCHMARK(TextLayoutLatinW120) { latin().benchmarkLayout(iterations, 120); }
+WTF_BENCHMARK(TextLayoutLatinW360) { latin().benchmarkLayout(iterations, 360); }
+WTF_BENCHMARK(TextLayoutLatinW1000) { latin().benchmarkLayout(iterations, 1000); }
+WTF_BENCHMARK(TextLayoutCJKW120) { cjk().benchmarkLayout(iterations, 120); }
+WTF_BENCHMARK(TextLayoutCJKW360) { cjk().benchmarkLayout(iterations, 360); }
+WTF_BENCHMARK(TextLayoutCJKW1000) { cjk().benchmarkLayout(iterations, 1000); }
+WTF_BENCHMARK(TextLayoutArabicBidiW120) { arabicBidi().benchmarkLayout(iterations, 120); }
+WTF_BENCHMARK(TextLayoutArabicBidiW360) { arabicBidi().benchmarkLayout(iterations, 360); }
+WTF_BENCHMARK(TextLayoutArabicBidiW1000) { arabicBidi().benchmarkLayout(iterations, 1000); }
+WTF_BENCHMARK(TextLayoutEmojiMixedW120) { emojiMixed().benchmarkLayout(iterations, 120); }
+WTF_BENCHMARK(TextLayoutEmojiMixedW360) { emojiMixed().benchmarkLayout(iterations, 360); }
+WTF_BENCHMARK(TextLayoutEmojiMixedW1000) { emojiMixed().benchmarkLayout(iterations, 1000); }
+
+WTF_BENCHMARK(TextShapeLatin) { latin().benchmarkShape(iterations); }
+WTF_BENCHMARK(TextShapeCJK) { cjk().benchmarkShape(iterations); }
+WTF_BENCHMARK(TextShapeArabicBidi) { arabicBidi().benchmarkShape(iterations); }
+WTF_BENCHMARK(TextShapeEmojiMixed) { emojiMixed().benchmarkShape(iterations); }
+
+WTF_BENCHMARK(TextPaintLatinW360) { latin().benchmarkPaint(iterations, 360); }
+WTF_BENCHMARK(TextPaintCJKW360) { cjk().benchmarkPaint(iterations, 360); }
+WTF_BENCHMARK(TextPaintArabicBidiW360) { arabicBidi().benchmarkPaint(iterations, 360); }
+WTF_BENCHMARK(TextPaintEmojiMixedW360) { emojiMixed().benchmarkPaint(iterations, 360); }
+
+class BenchmarkPlatform : public blink::Platform {
+public:
+    std::string defaultLocale() override { return "en-US"; }
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // InitEngine installs a message loop observer, so a loop must exist
+    // even though the benchmarks never run it.
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    blink::InitEngine(new BenchmarkPlatform());
+    return WTF::benchmarking::runAllBenchmarks(argc, argv);
+}
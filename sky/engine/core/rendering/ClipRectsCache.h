@@ -26,11 +26,24 @@ public:
     struct Entry {
         Entry()
             : root(0)
+            , selfEpoch(0)
+            , parentGeneration(0)
+            , generation(0)
         {
         }
 
         const RenderLayer* root;
         RefPtr<ClipRects> clipRects;
+
+        // Validity tags: the owning clipper's mutation epoch and the
+        // generation of the parent entry these rects were derived from.
+        // See RenderLayerClipper::clipRectsIfCached.
+        unsigned selfEpoch;
+        unsigned parentGeneration;
+
+        // Bumped every time this entry is rebuilt; child entries record it
+        // so a stale ancestor is noticed lazily, on the next query.
+        unsigned generation;
     };
 
     Entry& get(ClipRectsCacheSlot slot)
@@ -39,12 +52,6 @@ public:
         return m_entries[slot];
     }
 
-    void clear(ClipRectsCacheSlot slot)
-    {
-        ASSERT(slot < NumberOfClipRectsCacheSlots);
-        m_entries[slot] = Entry();
-    }
-
 private:
     Entry m_entries[NumberOfClipRectsCacheSlots];
 };
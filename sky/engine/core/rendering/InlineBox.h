@@ -93,6 +93,11 @@ public:
     virtual void paint(PaintInfo&, const LayoutPoint&, LayoutUnit lineTop, LayoutUnit lineBottom, Vector<RenderBox*>& layers);
     virtual bool nodeAtPoint(const HitTestRequest&, HitTestResult&, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, LayoutUnit lineTop, LayoutUnit lineBottom);
 
+    // Pre-pass run by RenderLineBoxList::paint before any line paints, so
+    // that selection highlights across all lines can be flushed as one
+    // batched fill behind the text. See InlinePaintBatch.
+    virtual void collectSelectionRects(PaintInfo&, const LayoutPoint&) { }
+
     // InlineBoxes are allocated out of the rendering partition.
     void* operator new(size_t);
     void operator delete(void*);
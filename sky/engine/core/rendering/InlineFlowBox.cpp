@@ -974,6 +974,14 @@ void InlineFlowBox::paint(PaintInfo& paintInfo, const LayoutPoint& paintOffset,
     }
 }
 
+void InlineFlowBox::collectSelectionRects(PaintInfo& paintInfo, const LayoutPoint& paintOffset)
+{
+    for (InlineBox* curr = firstChild(); curr; curr = curr->nextOnLine()) {
+        if (curr->renderer().isText() || !hasSelfPaintingLayer(curr))
+            curr->collectSelectionRects(paintInfo, paintOffset);
+    }
+}
+
 void InlineFlowBox::paintFillLayers(const PaintInfo& paintInfo, const Color& c, const FillLayer& fillLayer, const LayoutRect& rect)
 {
     if (fillLayer.next())
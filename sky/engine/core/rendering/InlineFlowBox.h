@@ -117,6 +117,7 @@ public:
 
     virtual void paint(PaintInfo&, const LayoutPoint&, LayoutUnit lineTop, LayoutUnit lineBottom, Vector<RenderBox*>& layers) override;
     virtual bool nodeAtPoint(const HitTestRequest&, HitTestResult&, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, LayoutUnit lineTop, LayoutUnit lineBottom) override;
+    virtual void collectSelectionRects(PaintInfo&, const LayoutPoint&) override;
 
     bool boxShadowCanBeAppliedToBackground(const FillLayer&) const;
 
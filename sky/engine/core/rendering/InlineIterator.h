@@ -724,6 +724,51 @@ inline void InlineBidiResolver::appendRun(BidiRunList<BidiRun>& runs)
     m_status.eor = WTF::Unicode::OtherNeutral;
 }
 
+template <>
+inline void InlineBidiResolver::createRunsForUnidirectionalLine(const InlineIterator& end, bool hardLineBreak)
+{
+    ASSERT(m_direction == WTF::Unicode::OtherNeutral);
+    ASSERT(!inIsolate());
+
+    m_trailingSpaceRun = 0;
+    m_endOfLine = end;
+    m_endOfRunAtEndOfLine = InlineIterator();
+
+    // appendRun stops either at m_eor (inclusively) or at m_endOfLine when its
+    // offset is zero, so park m_eor on the last character of the line. A line
+    // that runs to the end of the block leaves no iterator to stand on; walk
+    // to the last object instead, stepping the same way appendRun does.
+    if (end.atEnd()) {
+        RenderObject* last = m_current.object();
+        for (RenderObject* next = last; next; next = bidiNextSkippingEmptyInlines(m_current.root(), next))
+            last = next;
+        m_eor = InlineIterator(m_current.root(), last, last && last->length() ? last->length() - 1 : 0);
+    } else {
+        m_eor = InlineIterator(end.root(), end.object(), end.offset() ? end.offset() - 1 : 0);
+    }
+
+    m_sor = m_current;
+    m_emptyRun = false;
+    m_reachedEndOfLine = false;
+    m_direction = context()->dir();
+    appendRun(m_runs);
+
+    m_runs.setLogicallyLastRun(m_runs.lastRun());
+    if (!hardLineBreak && m_runs.runCount())
+        applyL1Rule(m_runs);
+
+    // Leave the resolver positioned at the end of the line with a status
+    // matching the base direction, the state a unidirectional line ends in.
+    WTF::Unicode::Direction baseDirection = context()->dir();
+    setEorDir(baseDirection);
+    setLastDir(baseDirection);
+    setLastStrongDir(baseDirection);
+    m_current = end;
+    m_reachedEndOfLine = false;
+    m_endOfRunAtEndOfLine = InlineIterator();
+    m_endOfLine = InlineIterator();
+}
+
 }
 
 #endif  // SKY_ENGINE_CORE_RENDERING_INLINEITERATOR_H_
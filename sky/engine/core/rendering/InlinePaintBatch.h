@@ -0,0 +1,52 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_RENDERING_INLINEPAINTBATCH_H_
+#define SKY_ENGINE_CORE_RENDERING_INLINEPAINTBATCH_H_
+
+#include "flutter/sky/engine/platform/geometry/FloatRect.h"
+#include "flutter/sky/engine/platform/graphics/Color.h"
+#include "flutter/sky/engine/wtf/Vector.h"
+
+namespace blink {
+
+class GraphicsContext;
+
+// Accumulates the tiny axis-aligned quads that selection highlights and
+// solid text decorations produce across a RenderLineBoxList, so that each
+// paint phase reaches Skia as one filled path per color instead of one
+// draw call per box per line. Selecting all in a long document otherwise
+// floods the canvas with thousands of two-triangle draws.
+class InlinePaintBatch {
+public:
+    InlinePaintBatch();
+    ~InlinePaintBatch();
+
+    void addSelectionRect(const FloatRect&, const Color&);
+
+    // A solid decoration segment. The stroke is widened into a quad with
+    // the same pixel snapping GraphicsContext::drawLineForText applies, so
+    // the batched fill is indistinguishable from the per-box stroke.
+    void addDecorationLine(const FloatPoint& start, float width, float thickness, const Color&);
+
+    // Each of these emits one filled path per distinct color and clears
+    // that phase's quads.
+    void paintSelectionRects(GraphicsContext*);
+    void paintDecorationLines(GraphicsContext*);
+
+private:
+    struct ColoredRect {
+        FloatRect rect;
+        Color color;
+    };
+
+    static void paintRects(GraphicsContext*, Vector<ColoredRect>&);
+
+    Vector<ColoredRect> m_selectionRects;
+    Vector<ColoredRect> m_decorationRects;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_RENDERING_INLINEPAINTBATCH_H_
@@ -25,6 +25,7 @@
 #include "flutter/sky/engine/core/editing/CompositionUnderline.h"
 #include "flutter/sky/engine/core/editing/CompositionUnderlineRangeFilter.h"
 #include "flutter/sky/engine/core/rendering/HitTestResult.h"
+#include "flutter/sky/engine/core/rendering/InlinePaintBatch.h"
 #include "flutter/sky/engine/core/rendering/PaintInfo.h"
 #include "flutter/sky/engine/core/rendering/RenderBlock.h"
 #include "flutter/sky/engine/core/rendering/RenderTheme.h"
@@ -64,9 +65,28 @@ void InlineTextBox::markDirty()
 {
     m_len = 0;
     m_start = 0;
+    m_cachedTextBlobs.clear();
     InlineBox::markDirty();
 }
 
+TextBlobPtr* InlineTextBox::TextBlobCache::slotFor(int from, int to)
+{
+    for (size_t i = 0; i < m_fragments.size(); ++i) {
+        if (m_fragments[i].from == from && m_fragments[i].to == to)
+            return &m_fragments[i].blob;
+    }
+    // A moving selection endpoint produces a fresh range every paint; keep
+    // the cache from accumulating fragments for ranges that will never be
+    // painted again.
+    const size_t maxFragments = 4;
+    if (m_fragments.size() >= maxFragments)
+        m_fragments.clear();
+    m_fragments.append(Fragment());
+    m_fragments.last().from = from;
+    m_fragments.last().to = to;
+    return &m_fragments.last().blob;
+}
+
 LayoutRect InlineTextBox::logicalOverflowRect() const
 {
     if (knownToHaveNoOverflow() || !gTextBoxesWithOverflow)
@@ -319,15 +339,14 @@ void paintText(GraphicsContext* context,
     const AtomicString& emphasisMark, int emphasisMarkOffset,
     int startOffset, int endOffset, int truncationPoint,
     const FloatPoint& textOrigin, const FloatRect& boxRect,
-    TextBlobPtr* cachedTextBlob = 0)
+    InlineTextBox::TextBlobCache* textBlobCache = 0)
 {
     TextRunPaintInfo textRunPaintInfo(textRun);
     textRunPaintInfo.bounds = boxRect;
     if (startOffset <= endOffset) {
         textRunPaintInfo.from = startOffset;
         textRunPaintInfo.to = endOffset;
-        // FIXME: We should be able to use cachedTextBlob in more cases.
-        textRunPaintInfo.cachedTextBlob = cachedTextBlob;
+        textRunPaintInfo.cachedTextBlob = textBlobCache ? textBlobCache->slotFor(startOffset, endOffset) : 0;
         if (emphasisMark.isEmpty())
             context->drawText(font, textRunPaintInfo, textOrigin);
         else
@@ -336,6 +355,7 @@ void paintText(GraphicsContext* context,
         if (endOffset > 0) {
             textRunPaintInfo.from = 0;
             textRunPaintInfo.to = endOffset;
+            textRunPaintInfo.cachedTextBlob = textBlobCache ? textBlobCache->slotFor(0, endOffset) : 0;
             if (emphasisMark.isEmpty())
                 context->drawText(font, textRunPaintInfo, textOrigin);
             else
@@ -344,6 +364,7 @@ void paintText(GraphicsContext* context,
         if (startOffset < truncationPoint) {
             textRunPaintInfo.from = startOffset;
             textRunPaintInfo.to = truncationPoint;
+            textRunPaintInfo.cachedTextBlob = textBlobCache ? textBlobCache->slotFor(startOffset, truncationPoint) : 0;
             if (emphasisMark.isEmpty())
                 context->drawText(font, textRunPaintInfo, textOrigin);
             else
@@ -365,11 +386,11 @@ inline void paintEmphasisMark(GraphicsContext* context,
 void paintTextWithEmphasisMark(
     GraphicsContext* context, const Font& font, const TextPaintingStyle& textStyle, const TextRun& textRun,
     const AtomicString& emphasisMark, int emphasisMarkOffset, int startOffset, int endOffset, int length,
-    const FloatPoint& textOrigin, const FloatRect& boxRect, TextBlobPtr* cachedTextBlob = 0)
+    const FloatPoint& textOrigin, const FloatRect& boxRect, InlineTextBox::TextBlobCache* textBlobCache = 0)
 {
     GraphicsContextStateSaver stateSaver(*context, false);
     updateGraphicsContext(context, textStyle, stateSaver);
-    paintText(context, font, textRun, nullAtom, 0, startOffset, endOffset, length, textOrigin, boxRect, cachedTextBlob);
+    paintText(context, font, textRun, nullAtom, 0, startOffset, endOffset, length, textOrigin, boxRect, textBlobCache);
 
     if (!emphasisMark.isEmpty()) {
         if (textStyle.emphasisMarkColor != textStyle.fillColor)
@@ -439,7 +460,9 @@ void InlineTextBox::paint(PaintInfo& paintInfo, const LayoutPoint& paintOffset,
     FloatPoint textOrigin = FloatPoint(boxOrigin.x(), boxOrigin.y() + font.fontMetrics().ascent());
 
     // 1. Paint backgrounds behind text if needed. Examples of such backgrounds include selection.
-    if (haveSelection)
+    // When a paint batch is installed, the selection highlight was already
+    // collected and filled by RenderLineBoxList::paint's pre-pass.
+    if (haveSelection && !paintInfo.inlinePaintBatch)
         paintSelection(context, boxOrigin, styleToUse, font, selectionStyle.fillColor);
 
     // 2. Now paint the foreground, including text and decorations like underline/overline (in quirks mode only).
@@ -494,18 +517,14 @@ void InlineTextBox::paint(PaintInfo& paintInfo, const LayoutPoint& paintOffset,
         startOffset = ePos;
         endOffset = sPos;
     }
-    // FIXME: This cache should probably ultimately be held somewhere else.
-    // A hashmap is convenient to avoid a memory hit when the
-    // RuntimeEnabledFeature is off.
-    bool textBlobIsCacheable = startOffset == 0 && endOffset == length;
-    TextBlobPtr* cachedTextBlob = textBlobIsCacheable ? &m_cachedTextBlob : nullptr;
-    paintTextWithEmphasisMark(context, font, textStyle, textRun, emphasisMark, emphasisMarkOffset, startOffset, endOffset, length, textOrigin, boxRect, cachedTextBlob);
+    // The blob geometry only depends on the text, style and layout of the
+    // box, all of which invalidate the cache when they change, so every
+    // range painted here can be served from it on repaint.
+    paintTextWithEmphasisMark(context, font, textStyle, textRun, emphasisMark, emphasisMarkOffset, startOffset, endOffset, length, textOrigin, boxRect, &m_cachedTextBlobs);
 
     if (paintSelectedTextSeparately && sPos < ePos) {
         // paint only the text that is selected
-        bool textBlobIsCacheable = sPos == 0 && ePos == length;
-        TextBlobPtr* cachedTextBlob = textBlobIsCacheable ? &m_cachedTextBlob : nullptr;
-        paintTextWithEmphasisMark(context, font, selectionStyle, textRun, emphasisMark, emphasisMarkOffset, sPos, ePos, length, textOrigin, boxRect, cachedTextBlob);
+        paintTextWithEmphasisMark(context, font, selectionStyle, textRun, emphasisMark, emphasisMarkOffset, sPos, ePos, length, textOrigin, boxRect, &m_cachedTextBlobs);
     }
 
     // Paint decorations
@@ -513,7 +532,7 @@ void InlineTextBox::paint(PaintInfo& paintInfo, const LayoutPoint& paintOffset,
     if (textDecorations != TextDecorationNone) {
         GraphicsContextStateSaver stateSaver(*context, false);
         updateGraphicsContext(context, textStyle, stateSaver);
-        paintDecoration(context, boxOrigin, textDecorations);
+        paintDecoration(context, boxOrigin, textDecorations, paintInfo.inlinePaintBatch);
     }
 }
 
@@ -580,6 +599,76 @@ void InlineTextBox::paintSelection(GraphicsContext* context, const FloatPoint& b
     context->drawHighlightForText(font, textRun, localOrigin, selHeight, c, sPos, ePos);
 }
 
+void InlineTextBox::collectSelectionRects(PaintInfo& paintInfo, const LayoutPoint& paintOffset)
+{
+    if (!paintInfo.inlinePaintBatch)
+        return;
+    if (isLineBreak() || m_truncation == cFullTruncation || !m_len)
+        return;
+    if (selectionState() == RenderObject::SelectionNone)
+        return;
+
+    // The same horizontal culling paint() applies.
+    LayoutRect logicalVisualOverflow = logicalOverflowRect();
+    LayoutUnit logicalStart = logicalVisualOverflow.x() + paintOffset.x();
+    LayoutUnit logicalExtent = logicalVisualOverflow.width();
+    if (logicalStart >= paintInfo.rect.maxX() || logicalStart + logicalExtent <= paintInfo.rect.x())
+        return;
+
+    int sPos, ePos;
+    selectionStartEnd(sPos, ePos);
+    if (sPos >= ePos)
+        return;
+
+    Color c = renderer().selectionBackgroundColor();
+    if (!c.alpha())
+        return;
+
+    RenderStyle* styleToUse = renderer().style(isFirstLineStyle());
+    const Font& font = styleToUse->font();
+
+    // Match paintSelection: invert a background that would hide the text.
+    TextPaintingStyle textStyle = textPaintingStyle(renderer(), styleToUse);
+    TextPaintingStyle selectionStyle = selectionPaintingStyle(renderer(), true, textStyle);
+    if (selectionStyle.fillColor == c)
+        c = Color(0xff - c.red(), 0xff - c.green(), 0xff - c.blue());
+
+    // The same origin adjustment paint() computes, including the origin
+    // shift for a truncated fragment in a mixed-direction run.
+    LayoutPoint adjustedPaintOffset = LayoutPoint(paintOffset.x(), paintOffset.y().round());
+    if (m_truncation != cNoTruncation && renderer().containingBlock()->style()->isLeftToRightDirection() != isLeftToRightDirection()) {
+        LayoutUnit widthOfVisibleText = renderer().width(m_start, m_truncation, textPos(), isLeftToRightDirection() ? LTR : RTL, isFirstLineStyle());
+        LayoutUnit widthOfHiddenText = m_logicalWidth - widthOfVisibleText;
+        adjustedPaintOffset.move(LayoutSize(isLeftToRightDirection() ? widthOfHiddenText : -widthOfHiddenText, 0));
+    }
+    FloatPoint boxOrigin = locationIncludingFlipping();
+    boxOrigin.move(adjustedPaintOffset.x().toFloat(), adjustedPaintOffset.y().toFloat());
+
+    int length = m_truncation != cNoTruncation ? m_truncation : m_len;
+    StringView string = renderer().text().createView();
+    if (string.length() != static_cast<unsigned>(length) || m_start)
+        string.narrow(m_start, length);
+
+    StringBuilder charactersWithHyphen;
+    bool respectHyphen = ePos == length && hasHyphen();
+    TextRun textRun = constructTextRun(styleToUse, font, string, renderer().textLength() - m_start, respectHyphen ? &charactersWithHyphen : 0);
+    if (respectHyphen)
+        ePos = textRun.length();
+
+    LayoutUnit selectionBottom = root().selectionBottom();
+    LayoutUnit selectionTop = root().selectionTopAdjustedForPrecedingBlock();
+
+    int deltaY = roundToInt(logicalTop() - selectionTop);
+    int selHeight = std::max(0, roundToInt(selectionBottom - selectionTop));
+
+    FloatPoint localOrigin(boxOrigin.x(), boxOrigin.y() - deltaY);
+    FloatRect selectionRect = font.selectionRectForText(textRun, localOrigin, selHeight, sPos, ePos);
+    // Intersecting with the box's extent replaces the clip paintSelection
+    // pushes around its highlight draw.
+    selectionRect.intersect(FloatRect(localOrigin, FloatSize(m_logicalWidth, selHeight)));
+    paintInfo.inlinePaintBatch->addSelectionRect(selectionRect, c);
+}
+
 unsigned InlineTextBox::underlinePaintStart(const CompositionUnderline& underline)
 {
     return std::max(static_cast<unsigned>(m_start), underline.startOffset);
@@ -795,9 +884,19 @@ static bool shouldSetDecorationAntialias(TextDecorationStyle underline, TextDeco
     return shouldSetDecorationAntialias(underline) || shouldSetDecorationAntialias(overline) || shouldSetDecorationAntialias(linethrough);
 }
 
-static void paintAppliedDecoration(GraphicsContext* context, FloatPoint start, float width, float doubleOffset, int wavyOffsetFactor,
+static void paintAppliedDecoration(GraphicsContext* context, InlinePaintBatch* paintBatch, FloatPoint start, float width, float doubleOffset, int wavyOffsetFactor,
     RenderObject::AppliedTextDecoration decoration, float thickness, bool antialiasDecoration)
 {
+    // Solid strokes become axis-aligned quads that the batch fills in one
+    // path with their siblings across the line box list. Dotted, dashed and
+    // wavy styles keep the per-box stroking path.
+    if (paintBatch && (decoration.style == TextDecorationStyleSolid || decoration.style == TextDecorationStyleDouble)) {
+        paintBatch->addDecorationLine(start, width, thickness, decoration.color);
+        if (decoration.style == TextDecorationStyleDouble)
+            paintBatch->addDecorationLine(start + FloatPoint(0, doubleOffset), width, thickness, decoration.color);
+        return;
+    }
+
     context->setStrokeStyle(textDecorationStyleToStrokeStyle(decoration.style));
     context->setStrokeColor(decoration.color);
 
@@ -817,7 +916,7 @@ static void paintAppliedDecoration(GraphicsContext* context, FloatPoint start, f
     }
 }
 
-void InlineTextBox::paintDecoration(GraphicsContext* context, const FloatPoint& boxOrigin, TextDecoration deco)
+void InlineTextBox::paintDecoration(GraphicsContext* context, const FloatPoint& boxOrigin, TextDecoration deco, InlinePaintBatch* paintBatch)
 {
     GraphicsContextStateSaver stateSaver(*context);
 
@@ -862,14 +961,14 @@ void InlineTextBox::paintDecoration(GraphicsContext* context, const FloatPoint&
 
     if (deco & TextDecorationUnderline) {
         const int underlineOffset = computeUnderlineOffset(styleToUse->textUnderlinePosition(), styleToUse->fontMetrics(), this, textDecorationThickness);
-        paintAppliedDecoration(context, localOrigin + FloatPoint(0, underlineOffset), width, doubleOffset, 1, underline, textDecorationThickness, antialiasDecoration);
+        paintAppliedDecoration(context, paintBatch, localOrigin + FloatPoint(0, underlineOffset), width, doubleOffset, 1, underline, textDecorationThickness, antialiasDecoration);
     }
     if (deco & TextDecorationOverline) {
-        paintAppliedDecoration(context, localOrigin, width, -doubleOffset, 1, overline, textDecorationThickness, antialiasDecoration);
+        paintAppliedDecoration(context, paintBatch, localOrigin, width, -doubleOffset, 1, overline, textDecorationThickness, antialiasDecoration);
     }
     if (deco & TextDecorationLineThrough) {
         const float lineThroughOffset = 2 * baseline / 3;
-        paintAppliedDecoration(context, localOrigin + FloatPoint(0, lineThroughOffset), width, doubleOffset, 0, linethrough, textDecorationThickness, antialiasDecoration);
+        paintAppliedDecoration(context, paintBatch, localOrigin + FloatPoint(0, lineThroughOffset), width, doubleOffset, 0, linethrough, textDecorationThickness, antialiasDecoration);
     }
 }
 
@@ -35,6 +35,7 @@ namespace blink {
 struct CompositionUnderline;
 class DocumentMarker;
 class GraphicsContext;
+class InlinePaintBatch;
 
 const unsigned short cNoTruncation = USHRT_MAX;
 const unsigned short cFullTruncation = USHRT_MAX - 1;
@@ -99,6 +100,26 @@ public:
 
     enum RotationDirection { Counterclockwise, Clockwise };
     static AffineTransform rotation(const FloatRect& boxRect, RotationDirection);
+
+    // Text blobs built during paint and retained for reuse, keyed by the range
+    // of the run they cover. The full run paints as a single fragment; a
+    // selection split paints as up to three. A fragment whose range no longer
+    // matches is simply not found, and the cache is dropped whenever the text,
+    // style or layout of the box changes, so a stale blob is never drawn.
+    class TextBlobCache {
+    public:
+        TextBlobPtr* slotFor(int from, int to);
+        void clear() { m_fragments.clear(); }
+
+    private:
+        struct Fragment {
+            int from;
+            int to;
+            TextBlobPtr blob;
+        };
+        Vector<Fragment, 1> m_fragments;
+    };
+
 private:
     LayoutUnit selectionTop();
     LayoutUnit selectionBottom();
@@ -119,6 +140,7 @@ public:
 protected:
     virtual void paint(PaintInfo&, const LayoutPoint&, LayoutUnit lineTop, LayoutUnit lineBottom, Vector<RenderBox*>& layers) override;
     virtual bool nodeAtPoint(const HitTestRequest&, HitTestResult&, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, LayoutUnit lineTop, LayoutUnit lineBottom) override;
+    virtual void collectSelectionRects(PaintInfo&, const LayoutPoint&) override;
 
 private:
     virtual void deleteLine() override final;
@@ -129,7 +151,11 @@ public:
     virtual RenderObject::SelectionState selectionState() override final;
 
 private:
-    virtual void clearTruncation() override final { m_truncation = cNoTruncation; }
+    virtual void clearTruncation() override final
+    {
+        m_truncation = cNoTruncation;
+        m_cachedTextBlobs.clear();
+    }
 
 public:
     virtual bool isLineBreak() const override final;
@@ -139,6 +165,9 @@ public:
         m_logicalWidth -= expansion();
         InlineBox::setExpansion(newExpansion);
         m_logicalWidth += newExpansion;
+        // Expansion stretches the glyph advances, so any blobs built from the
+        // old justification are no longer valid.
+        m_cachedTextBlobs.clear();
     }
 
 private:
@@ -163,7 +192,7 @@ public:
 private:
     InlineTextBox* m_prevTextBox; // The previous box that also uses our RenderObject
     InlineTextBox* m_nextTextBox; // The next box that also uses our RenderObject
-    TextBlobPtr m_cachedTextBlob;
+    TextBlobCache m_cachedTextBlobs;
 
     int m_start;
     unsigned short m_len;
@@ -180,7 +209,7 @@ protected:
     void paintCompositionUnderline(GraphicsContext*, const FloatPoint& boxOrigin, const CompositionUnderline&);
 
 private:
-    void paintDecoration(GraphicsContext*, const FloatPoint& boxOrigin, TextDecoration);
+    void paintDecoration(GraphicsContext*, const FloatPoint& boxOrigin, TextDecoration, InlinePaintBatch*);
     void paintSelection(GraphicsContext*, const FloatPoint& boxOrigin, RenderStyle*, const Font&, Color textColor);
 
     TextRun::ExpansionBehavior expansionBehavior() const
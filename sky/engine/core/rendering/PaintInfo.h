@@ -36,6 +36,7 @@
 
 namespace blink {
 
+class InlinePaintBatch;
 class RenderBox;
 class RenderInline;
 class RenderObject;
@@ -49,6 +50,7 @@ struct PaintInfo {
         const RenderBox* newPaintContainer)
         : context(newContext)
         , rect(newRect)
+        , inlinePaintBatch(nullptr)
         , m_paintContainer(newPaintContainer)
     {
     }
@@ -75,6 +77,9 @@ struct PaintInfo {
     // FIXME: Introduce setters/getters at some point. Requires a lot of changes throughout rendering/.
     GraphicsContext* context;
     IntRect rect;
+    // When set by RenderLineBoxList::paint, selection highlights and solid
+    // text decorations accumulate here instead of issuing per-box draws.
+    InlinePaintBatch* inlinePaintBatch;
 
 private:
     const RenderBox* m_paintContainer; // the layer object that originates the current painting
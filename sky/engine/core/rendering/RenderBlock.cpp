@@ -968,29 +968,36 @@ PositionWithAffinity RenderBlock::positionForPointWithInlineChildren(const Layou
     if (!firstRootBox())
         return createPositionWithAffinity(0, DOWNSTREAM);
 
+    // Lines stack in block direction, so selection bottoms are monotone down
+    // the line list and the first root line box located at the passed-in y
+    // coordinate can be found with a binary search instead of a walk over
+    // every line above it.
+    const Vector<InlineFlowBox*>& lineBoxes = m_lineBoxes.orderedLineBoxes();
+    size_t low = 0;
+    size_t high = lineBoxes.size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (pointInLogicalContents.y() < static_cast<RootInlineBox*>(lineBoxes[mid])->selectionBottom())
+            high = mid;
+        else
+            low = mid + 1;
+    }
+
     // look for the closest line box in the root box which is at the passed-in y coordinate
     InlineBox* closestBox = 0;
-    RootInlineBox* firstRootBoxWithChildren = 0;
-    RootInlineBox* lastRootBoxWithChildren = 0;
-    for (RootInlineBox* root = firstRootBox(); root; root = root->nextRootBox()) {
-        if (!root->firstLeafChild())
-            continue;
-        if (!firstRootBoxWithChildren)
-            firstRootBoxWithChildren = root;
-
-        lastRootBoxWithChildren = root;
-
-        // check if this root line box is located at this y coordinate
-        if (pointInLogicalContents.y() < root->selectionBottom()) {
+    for (size_t i = low; i < lineBoxes.size() && !closestBox; ++i) {
+        RootInlineBox* root = static_cast<RootInlineBox*>(lineBoxes[i]);
+        if (root->firstLeafChild())
             closestBox = root->closestLeafChildForLogicalLeftPosition(pointInLogicalContents.x());
-            if (closestBox)
-                break;
-        }
     }
 
-    if (!closestBox && lastRootBoxWithChildren) {
+    if (!closestBox) {
         // y coordinate is below last root line box, pretend we hit it
-        closestBox = lastRootBoxWithChildren->closestLeafChildForLogicalLeftPosition(pointInLogicalContents.x());
+        for (size_t i = lineBoxes.size(); i > 0 && !closestBox; --i) {
+            RootInlineBox* root = static_cast<RootInlineBox*>(lineBoxes[i - 1]);
+            if (root->firstLeafChild())
+                closestBox = root->closestLeafChildForLogicalLeftPosition(pointInLogicalContents.x());
+        }
     }
 
     if (closestBox) {
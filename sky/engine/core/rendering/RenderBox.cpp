@@ -102,7 +102,7 @@ void RenderBox::styleWillChange(StyleDifference diff, const RenderStyle& newStyl
 
         if (oldStyle->hasAutoClip() != newStyle.hasAutoClip()
             || oldStyle->clip() != newStyle.clip())
-            layer()->clipper().clearClipRectsIncludingDescendants();
+            layer()->clipper().invalidateClipRectsIncludingDescendants();
     }
 
     RenderBoxModelObject::styleWillChange(diff, newStyle);
@@ -174,7 +174,7 @@ void RenderBox::updateTransform(const RenderStyle* oldStyle)
 
         // Layers with transforms act as clip rects roots, so clear the cached clip rects here.
         if (layer())
-            layer()->clipper().clearClipRectsIncludingDescendants();
+            layer()->clipper().invalidateClipRectsIncludingDescendants();
     }
 
     updateTransformationMatrix();
@@ -635,16 +635,14 @@ bool RenderBox::hitTestLayer(RenderLayer* rootLayer, RenderLayer* containerLayer
         zOffsetForContentsPtr = zOffset;
     }
 
-    Vector<RenderBox*> layers;
-    collectSelfPaintingLayers(layers);
-    // Hit testing needs to walk in the backwards direction from paint.
-    // Forward compare and then reverse instead of just reverse comparing
-    // so that elements with the same z-index are walked in reverse tree order.
-    std::stable_sort(layers.begin(), layers.end(), forwardCompareZIndex);
-    layers.reverse();
+    // Hit testing needs to walk in the backwards direction from paint. The
+    // cached list is forward sorted, so iterate it in reverse; that also walks
+    // elements with the same z-index in reverse tree order.
+    const Vector<RenderBox*>& childLayers = layer()->selfPaintingLayerList();
 
     bool hitLayer = false;
-    for (auto& currentLayer : layers) {
+    for (size_t i = childLayers.size(); i > 0; --i) {
+        RenderBox* currentLayer = childLayers[i - 1];
         HitTestResult tempResult(result.hitTestLocation());
         bool localHitLayer = currentLayer->hitTestLayer(rootLayer, layer(), request, tempResult,
             localHitTestRect, localHitTestLocation, localTransformState.get(), zOffsetForDescendantsPtr);
@@ -845,7 +843,13 @@ void RenderBox::paintLayerContents(GraphicsContext* context, const LayerPainting
     PaintInfo paintInfo(context, pixelSnappedIntRect(contentRect.rect()), localPaintingInfo.rootLayer->renderer());
     paint(paintInfo, layerLocation, layers);
 
-    std::stable_sort(layers.begin(), layers.end(), forwardCompareZIndex);
+    // We can't use the cached selfPaintingLayerList() here: paintChildren
+    // culls children against the dirty rect, so |layers| is generally a
+    // subset of it. Most trees have no z-indices at all though, in which
+    // case the vector is collected in paint order already and the per-paint
+    // sort (and its temporary buffer) can be skipped.
+    if (!std::is_sorted(layers.begin(), layers.end(), forwardCompareZIndex))
+        std::stable_sort(layers.begin(), layers.end(), forwardCompareZIndex);
     for (auto& box : layers) {
         box->paintLayer(context, paintingInfo);
     }
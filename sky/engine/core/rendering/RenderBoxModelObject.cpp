@@ -1976,21 +1976,6 @@ const RenderObject* RenderBoxModelObject::pushMappingToContainer(const RenderBox
     return ancestorSkipped ? ancestorToStopAt : container;
 }
 
-void RenderBoxModelObject::collectSelfPaintingLayers(Vector<RenderBox*>& layers)
-{
-    for (RenderObject* child = slowFirstChild(); child; child = child->nextSibling()) {
-        if (child->isBox()) {
-            RenderBox* childBox = toRenderBox(child);
-            if (childBox->hasSelfPaintingLayer())
-                layers.append(childBox);
-            else
-                childBox->collectSelfPaintingLayers(layers);
-        } else if (child->isBoxModelObject()) {
-            toRenderBoxModelObject(child)->collectSelfPaintingLayers(layers);
-        }
-    }
-}
-
 void RenderBoxModelObject::moveChildTo(RenderBoxModelObject* toBoxModelObject, RenderObject* child, RenderObject* beforeChild, bool fullRemoveInsert)
 {
     // We assume that callers have cleared their positioned objects list for child moves (!fullRemoveInsert) so the
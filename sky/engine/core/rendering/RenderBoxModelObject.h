@@ -159,8 +159,6 @@ public:
     virtual void mapAbsoluteToLocalPoint(MapCoordinatesFlags, TransformState&) const override;
     virtual const RenderObject* pushMappingToContainer(const RenderBox* ancestorToStopAt, RenderGeometryMap&) const override;
 
-    void collectSelfPaintingLayers(Vector<RenderBox*>& layers);
-
     virtual void setSelectionState(SelectionState) override;
 
 protected:
@@ -43,6 +43,7 @@
 
 #include "flutter/sky/engine/core/rendering/RenderLayer.h"
 
+#include <algorithm>
 #include "flutter/sky/engine/core/rendering/HitTestRequest.h"
 #include "flutter/sky/engine/core/rendering/HitTestResult.h"
 #include "flutter/sky/engine/core/rendering/HitTestingTransformState.h"
@@ -70,6 +71,7 @@ RenderLayer::RenderLayer(RenderBox* renderer, LayerType type)
     , m_isRootLayer(renderer->isRenderView())
     , m_3DTransformedDescendantStatusDirty(true)
     , m_has3DTransformedDescendant(false)
+    , m_selfPaintingLayerListDirty(true)
     , m_renderer(renderer)
     , m_parent(0)
     , m_previous(0)
@@ -88,7 +90,7 @@ RenderLayer::~RenderLayer()
 
 void RenderLayer::updateLayerPositionsAfterLayout()
 {
-    m_clipper.clearClipRectsIncludingDescendants();
+    m_clipper.invalidateClipRectsIncludingDescendants();
 }
 
 
@@ -133,6 +135,59 @@ bool RenderLayer::update3DTransformedDescendantStatus()
     return renderer()->has3DTransform();
 }
 
+// Matches the ordering the painting and hit testing code expects: ascending
+// z-index, with ties left in tree order by the stable sort.
+static inline bool compareBoxZIndex(RenderBox* first, RenderBox* second)
+{
+    return first->style()->zIndex() < second->style()->zIndex();
+}
+
+const Vector<RenderBox*>& RenderLayer::selfPaintingLayerList()
+{
+    if (m_selfPaintingLayerListDirty) {
+        if (!m_selfPaintingLayerList)
+            m_selfPaintingLayerList = adoptPtr(new Vector<RenderBox*>);
+        for (RenderLayer* child = firstChild(); child; child = child->nextSibling())
+            child->collectSelfPaintingLayers(*m_selfPaintingLayerList);
+        std::stable_sort(m_selfPaintingLayerList->begin(), m_selfPaintingLayerList->end(), compareBoxZIndex);
+        m_selfPaintingLayerListDirty = false;
+    }
+    return *m_selfPaintingLayerList;
+}
+
+void RenderLayer::collectSelfPaintingLayers(Vector<RenderBox*>& layers)
+{
+    // An overflow-only layer doesn't paint itself, so its self-painting
+    // descendants belong to the enclosing self-painting layer's list.
+    if (isSelfPaintingLayer()) {
+        layers.append(renderer());
+        return;
+    }
+    for (RenderLayer* child = firstChild(); child; child = child->nextSibling())
+        child->collectSelfPaintingLayers(layers);
+}
+
+void RenderLayer::dirtySelfPaintingLayerList()
+{
+    // Clear eagerly rather than on rebuild so a stale list can never hold on
+    // to boxes that have since been destroyed.
+    if (m_selfPaintingLayerList)
+        m_selfPaintingLayerList->clear();
+    m_selfPaintingLayerListDirty = true;
+}
+
+void RenderLayer::dirtyEnclosingSelfPaintingLayerList()
+{
+    // The first self-painting ancestor (inclusive) owns the list this subtree
+    // is collected into; the overflow-only layers on the way up don't own
+    // lists, but dirty them too so they never go stale.
+    for (RenderLayer* curr = this; curr; curr = curr->parent()) {
+        curr->dirtySelfPaintingLayerList();
+        if (curr->isSelfPaintingLayer())
+            return;
+    }
+}
+
 IntSize RenderLayer::size() const
 {
     // FIXME: Is snapping the size really needed here?
@@ -221,6 +276,13 @@ void RenderLayer::addChild(RenderLayer* child, RenderLayer* beforeChild)
 
     child->m_parent = this;
 
+    // Generations are per-clipper counters, so an entry the child derived
+    // from its old parent must not be compared against ours; force the child
+    // (and lazily its descendants) to rebuild.
+    child->m_clipper.invalidateClipRectsIncludingDescendants();
+
+    dirtyEnclosingSelfPaintingLayerList();
+
     if (child->stackingNode()->isNormalFlowOnly())
         m_stackingNode->dirtyNormalFlowList();
 
@@ -244,6 +306,8 @@ RenderLayer* RenderLayer::removeChild(RenderLayer* oldChild)
     if (m_last == oldChild)
         m_last = oldChild->previousSibling();
 
+    dirtyEnclosingSelfPaintingLayerList();
+
     if (oldChild->stackingNode()->isNormalFlowOnly())
         m_stackingNode->dirtyNormalFlowList();
     if (!oldChild->stackingNode()->isNormalFlowOnly() || oldChild->firstChild()) {
@@ -266,7 +330,7 @@ void RenderLayer::removeOnlyThisLayer()
     if (!m_parent)
         return;
 
-    m_clipper.clearClipRectsIncludingDescendants();
+    m_clipper.invalidateClipRectsIncludingDescendants();
 
     RenderLayer* nextSib = nextSibling();
 
@@ -303,7 +367,7 @@ void RenderLayer::insertOnlyThisLayer()
         curr->moveLayers(m_parent, this);
 
     // Clear out all the clip rects.
-    m_clipper.clearClipRectsIncludingDescendants();
+    m_clipper.invalidateClipRectsIncludingDescendants();
 }
 
 // Returns the layer reached on the walk up towards the ancestor.
@@ -512,7 +576,19 @@ void RenderLayer::styleChanged(StyleDifference diff, const RenderStyle* oldStyle
 
     // Overlay scrollbars can make this layer self-painting so we need
     // to recompute the bit once scrollbars have been updated.
-    m_isSelfPaintingLayer = shouldBeSelfPaintingLayer();
+    bool isSelfPaintingLayer = shouldBeSelfPaintingLayer();
+    if (m_isSelfPaintingLayer != isSelfPaintingLayer) {
+        m_isSelfPaintingLayer = isSelfPaintingLayer;
+        // This layer starts (or stops) painting the self-painting layers
+        // below it, so its list and the enclosing one are both stale.
+        dirtySelfPaintingLayerList();
+        if (parent())
+            parent()->dirtyEnclosingSelfPaintingLayerList();
+    }
+
+    // A z-index change reorders this layer within the enclosing list.
+    if (oldStyle && parent() && oldStyle->zIndex() != renderer()->style()->zIndex())
+        parent()->dirtyEnclosingSelfPaintingLayerList();
 }
 
 } // namespace blink
@@ -102,6 +102,13 @@ public:
     RenderLayerStackingNode* stackingNode() { return m_stackingNode.get(); }
     const RenderLayerStackingNode* stackingNode() const { return m_stackingNode.get(); }
 
+    // The self-painting layers painted (and hit tested) as children of this
+    // layer, sorted by z-index. The list is cached: layer tree mutations and
+    // z-index changes dirty it, and it is rebuilt on demand, so repeated hit
+    // tests of an unchanged tree don't re-collect and re-sort the layers.
+    const Vector<RenderBox*>& selfPaintingLayerList();
+    void dirtySelfPaintingLayerList();
+
     // Gets the nearest enclosing positioned ancestor layer (also includes
     // the <html> layer and the root layer).
     RenderLayer* enclosingPositionedAncestor() const;
@@ -152,6 +159,9 @@ public:
     void dirty3DTransformedDescendantStatus();
 
 private:
+    void dirtyEnclosingSelfPaintingLayerList();
+    void collectSelfPaintingLayers(Vector<RenderBox*>&);
+
     LayerType m_layerType;
 
     // Self-painting layer is an optimization where we avoid the heavy RenderLayer painting
@@ -166,6 +176,8 @@ private:
     // in a preserves3D hierarchy. Hint to do 3D-aware hit testing.
     unsigned m_has3DTransformedDescendant : 1;
 
+    unsigned m_selfPaintingLayerListDirty : 1;
+
     RenderBox* m_renderer;
 
     RenderLayer* m_parent;
@@ -176,6 +188,7 @@ private:
 
     RenderLayerClipper m_clipper; // FIXME: Lazily allocate?
     OwnPtr<RenderLayerStackingNode> m_stackingNode;
+    OwnPtr<Vector<RenderBox*> > m_selfPaintingLayerList;
 };
 
 } // namespace blink
@@ -48,12 +48,16 @@
 
 namespace blink {
 
+unsigned RenderLayerClipper::s_cacheHitCount = 0;
+unsigned RenderLayerClipper::s_cacheMissCount = 0;
+
 RenderLayerClipper::RenderLayerClipper(RenderBox& renderer)
     : m_renderer(renderer)
+    , m_clipRectsEpoch(0)
 {
 }
 
-ClipRects* RenderLayerClipper::clipRectsIfCached(const ClipRectsContext& context) const
+ClipRects* RenderLayerClipper::clipRectsIfCached(const ClipRectsContext& context, unsigned parentGeneration) const
 {
     ASSERT(context.usesCache());
     if (!m_cache)
@@ -65,6 +69,12 @@ ClipRects* RenderLayerClipper::clipRectsIfCached(const ClipRectsContext& context
     if (context.rootLayer != entry.root)
         return 0;
 
+    // Epoch tags replace eager cache clearing: a mutation on this layer bumps
+    // m_clipRectsEpoch, and an ancestor rebuild shows up as a new parent
+    // generation. Either mismatch means these rects are stale.
+    if (entry.selfEpoch != m_clipRectsEpoch || entry.parentGeneration != parentGeneration)
+        return 0;
+
 #ifdef CHECK_CACHED_CLIP_RECTS
     // This code is useful to check cached clip rects, but is too expensive to leave enabled in debug builds by default.
     ClipRectsContext tempContext(context);
@@ -77,10 +87,16 @@ ClipRects* RenderLayerClipper::clipRectsIfCached(const ClipRectsContext& context
     return entry.clipRects.get();
 }
 
-ClipRects* RenderLayerClipper::storeClipRectsInCache(const ClipRectsContext& context, ClipRects* parentClipRects, const ClipRects& clipRects) const
+ClipRects* RenderLayerClipper::storeClipRectsInCache(const ClipRectsContext& context, ClipRects* parentClipRects, const ClipRects& clipRects, unsigned parentGeneration) const
 {
     ClipRectsCache::Entry& entry = cache().get(context.cacheSlot);
     entry.root = context.rootLayer;
+    entry.selfEpoch = m_clipRectsEpoch;
+    entry.parentGeneration = parentGeneration;
+    // A rebuild can change our rects even when nothing about this layer
+    // itself changed (e.g. an ancestor moved), so always advance the
+    // generation to make entries derived from ours revalidate.
+    entry.generation++;
 
     if (parentClipRects) {
         // If our clip rects match the clip rects of our parent, we share storage.
@@ -96,36 +112,29 @@ ClipRects* RenderLayerClipper::storeClipRectsInCache(const ClipRectsContext& con
 
 ClipRects* RenderLayerClipper::getClipRects(const ClipRectsContext& context) const
 {
-    if (ClipRects* result = clipRectsIfCached(context))
-        return result;
-
-    // Note that it's important that we call getClipRects on our parent
-    // before we call calculateClipRects so that calculateClipRects will hit
-    // the cache.
+    // Validate (or rebuild) the parent's entry first. A rebuild advances the
+    // parent entry's generation, which is how entries below a mutated
+    // ancestor are noticed as stale without any eager descendant walk. Note
+    // that it's also important that we call getClipRects on our parent before
+    // we call calculateClipRects so that calculateClipRects will hit the
+    // cache.
     ClipRects* parentClipRects = 0;
-    if (context.rootLayer != m_renderer.layer() && m_renderer.layer()->parent())
-        parentClipRects = m_renderer.layer()->parent()->clipper().getClipRects(context);
+    unsigned parentGeneration = 0;
+    if (context.rootLayer != m_renderer.layer() && m_renderer.layer()->parent()) {
+        RenderLayerClipper& parentClipper = m_renderer.layer()->parent()->clipper();
+        parentClipRects = parentClipper.getClipRects(context);
+        parentGeneration = parentClipper.cache().get(context.cacheSlot).generation;
+    }
+
+    if (ClipRects* result = clipRectsIfCached(context, parentGeneration)) {
+        ++s_cacheHitCount;
+        return result;
+    }
+    ++s_cacheMissCount;
 
     ClipRects clipRects;
     calculateClipRects(context, clipRects);
-    return storeClipRectsInCache(context, parentClipRects, clipRects);
-}
-
-void RenderLayerClipper::clearClipRectsIncludingDescendants()
-{
-    m_cache = nullptr;
-
-    for (RenderLayer* layer = m_renderer.layer()->firstChild(); layer; layer = layer->nextSibling())
-        layer->clipper().clearClipRectsIncludingDescendants();
-}
-
-void RenderLayerClipper::clearClipRectsIncludingDescendants(ClipRectsCacheSlot cacheSlot)
-{
-    if (m_cache)
-        m_cache->clear(cacheSlot);
-
-    for (RenderLayer* layer = m_renderer.layer()->firstChild(); layer; layer = layer->nextSibling())
-        layer->clipper().clearClipRectsIncludingDescendants(cacheSlot);
+    return storeClipRectsInCache(context, parentClipRects, clipRects, parentGeneration);
 }
 
 LayoutRect RenderLayerClipper::localClipRect() const
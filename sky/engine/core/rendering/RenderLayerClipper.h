@@ -80,8 +80,16 @@ class RenderLayerClipper {
 public:
     explicit RenderLayerClipper(RenderBox&);
 
-    void clearClipRectsIncludingDescendants();
-    void clearClipRectsIncludingDescendants(ClipRectsCacheSlot);
+    // Marks this layer's cached clip rects (and, transitively, those of every
+    // layer that derived its rects from ours) as stale. O(1): rather than
+    // walking descendants, this bumps an epoch that cache lookups compare
+    // against, so unrelated subtrees keep their entries and stale ones are
+    // rebuilt only when next queried.
+    void invalidateClipRectsIncludingDescendants() { m_clipRectsEpoch++; }
+
+    // Cumulative cache statistics for performance diagnostics.
+    static unsigned cacheHitCount() { return s_cacheHitCount; }
+    static unsigned cacheMissCount() { return s_cacheMissCount; }
 
     LayoutRect localClipRect() const; // Returns the background clip rect of the layer in the local coordinate space.
 
@@ -97,8 +105,8 @@ public:
 private:
     void calculateClipRects(const ClipRectsContext&, ClipRects&) const;
 
-    ClipRects* clipRectsIfCached(const ClipRectsContext&) const;
-    ClipRects* storeClipRectsInCache(const ClipRectsContext&, ClipRects* parentClipRects, const ClipRects&) const;
+    ClipRects* clipRectsIfCached(const ClipRectsContext&, unsigned parentGeneration) const;
+    ClipRects* storeClipRectsInCache(const ClipRectsContext&, ClipRects* parentClipRects, const ClipRects&, unsigned parentGeneration) const;
 
     // cachedClipRects looks buggy: It doesn't check whether context.rootLayer and entry.root match.
     // FIXME: Move callers to clipRectsIfCached, which does the proper checks.
@@ -121,6 +129,13 @@ private:
     // FIXME: Could this be a RenderBox?
     RenderBox& m_renderer;
     mutable OwnPtr<ClipRectsCache> m_cache;
+
+    // Bumped by invalidateClipRectsIncludingDescendants. Cache entries store
+    // the epoch they were built at; a mismatch means the entry is stale.
+    unsigned m_clipRectsEpoch;
+
+    static unsigned s_cacheHitCount;
+    static unsigned s_cacheMissCount;
 };
 
 } // namespace blink
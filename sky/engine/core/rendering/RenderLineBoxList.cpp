@@ -29,6 +29,7 @@
 #include "flutter/sky/engine/core/rendering/RenderLineBoxList.h"
 
 #include "flutter/sky/engine/core/rendering/HitTestResult.h"
+#include "flutter/sky/engine/core/rendering/InlinePaintBatch.h"
 #include "flutter/sky/engine/core/rendering/InlineTextBox.h"
 #include "flutter/sky/engine/core/rendering/PaintInfo.h"
 #include "flutter/sky/engine/core/rendering/RenderInline.h"
@@ -48,6 +49,7 @@ RenderLineBoxList::~RenderLineBoxList()
 void RenderLineBoxList::appendLineBox(InlineFlowBox* box)
 {
     checkConsistency();
+    invalidateOrderedLineBoxes();
 
     if (!m_firstLineBox)
         m_firstLineBox = m_lastLineBox = box;
@@ -62,6 +64,7 @@ void RenderLineBoxList::appendLineBox(InlineFlowBox* box)
 
 void RenderLineBoxList::deleteLineBoxTree()
 {
+    invalidateOrderedLineBoxes();
     InlineFlowBox* line = m_firstLineBox;
     InlineFlowBox* nextLine;
     while (line) {
@@ -75,6 +78,7 @@ void RenderLineBoxList::deleteLineBoxTree()
 void RenderLineBoxList::extractLineBox(InlineFlowBox* box)
 {
     checkConsistency();
+    invalidateOrderedLineBoxes();
 
     m_lastLineBox = box->prevLineBox();
     if (box == m_firstLineBox)
@@ -91,6 +95,7 @@ void RenderLineBoxList::extractLineBox(InlineFlowBox* box)
 void RenderLineBoxList::attachLineBox(InlineFlowBox* box)
 {
     checkConsistency();
+    invalidateOrderedLineBoxes();
 
     if (m_lastLineBox) {
         m_lastLineBox->setNextLineBox(box);
@@ -110,6 +115,7 @@ void RenderLineBoxList::attachLineBox(InlineFlowBox* box)
 void RenderLineBoxList::removeLineBox(InlineFlowBox* box)
 {
     checkConsistency();
+    invalidateOrderedLineBoxes();
 
     if (box == m_firstLineBox)
         m_firstLineBox = box->nextLineBox();
@@ -126,6 +132,7 @@ void RenderLineBoxList::removeLineBox(InlineFlowBox* box)
 void RenderLineBoxList::deleteLineBoxes()
 {
     if (m_firstLineBox) {
+        invalidateOrderedLineBoxes();
         InlineFlowBox* next;
         for (InlineFlowBox* curr = m_firstLineBox; curr; curr = next) {
             next = curr->nextLineBox();
@@ -136,6 +143,25 @@ void RenderLineBoxList::deleteLineBoxes()
     }
 }
 
+void RenderLineBoxList::invalidateOrderedLineBoxes()
+{
+    // Clear eagerly rather than at rebuild time so the vector never holds
+    // pointers to boxes that have since been destroyed.
+    m_orderedLineBoxes.clear();
+    m_orderedLineBoxesDirty = true;
+}
+
+const Vector<InlineFlowBox*>& RenderLineBoxList::orderedLineBoxes() const
+{
+    if (m_orderedLineBoxesDirty) {
+        ASSERT(m_orderedLineBoxes.isEmpty());
+        for (InlineFlowBox* curr = m_firstLineBox; curr; curr = curr->nextLineBox())
+            m_orderedLineBoxes.append(curr);
+        m_orderedLineBoxesDirty = false;
+    }
+    return m_orderedLineBoxes;
+}
+
 void RenderLineBoxList::dirtyLineBoxes()
 {
     for (InlineFlowBox* curr = firstLineBox(); curr; curr = curr->nextLineBox())
@@ -192,6 +218,20 @@ void RenderLineBoxList::paint(RenderBoxModelObject* renderer, PaintInfo& paintIn
 
     PaintInfo info(paintInfo);
 
+    // Batch the tiny quads selection highlights and solid decorations
+    // produce, so each paint phase reaches the canvas as one filled path
+    // per color rather than one draw per box per line.
+    InlinePaintBatch paintBatch;
+    info.inlinePaintBatch = &paintBatch;
+
+    // Selection highlights paint behind the text of every line, so collect
+    // them in a pre-pass and flush them before any text goes down.
+    for (InlineFlowBox* curr = firstLineBox(); curr; curr = curr->nextLineBox()) {
+        if (lineIntersectsDirtyRect(renderer, curr, info, paintOffset))
+            curr->collectSelectionRects(info, paintOffset);
+    }
+    paintBatch.paintSelectionRects(info.context);
+
     // See if our root lines intersect with the dirty rect.  If so, then we paint
     // them.  Note that boxes can easily overlap, so we can't make any assumptions
     // based off positions of our first line box or our last line box.
@@ -201,6 +241,10 @@ void RenderLineBoxList::paint(RenderBoxModelObject* renderer, PaintInfo& paintIn
             curr->paint(info, paintOffset, root.lineTop(), root.lineBottom(), layers);
         }
     }
+
+    // Solid decorations accumulated during the walk above; they draw over
+    // the text, like the per-box strokes they replace.
+    paintBatch.paintDecorationLines(info.context);
 }
 
 bool RenderLineBoxList::hitTest(RenderBoxModelObject* renderer, const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset) const
@@ -39,6 +39,7 @@ public:
     RenderLineBoxList()
         : m_firstLineBox(0)
         , m_lastLineBox(0)
+        , m_orderedLineBoxesDirty(true)
     {
     }
 
@@ -49,6 +50,11 @@ public:
     InlineFlowBox* firstLineBox() const { return m_firstLineBox; }
     InlineFlowBox* lastLineBox() const { return m_lastLineBox; }
 
+    // The boxes in list order as a contiguous vector, so callers can binary
+    // search lines by position. The vector mirrors the linked list: every
+    // list mutation invalidates it and it is rebuilt on demand.
+    const Vector<InlineFlowBox*>& orderedLineBoxes() const;
+
     void checkConsistency() const;
 
     void appendLineBox(InlineFlowBox*);
@@ -67,6 +73,7 @@ public:
     bool hitTest(RenderBoxModelObject*, const HitTestRequest&, HitTestResult&, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset) const;
 
 private:
+    void invalidateOrderedLineBoxes();
     bool anyLineIntersectsRect(RenderBoxModelObject*, const LayoutRect&, const LayoutPoint&) const;
     bool lineIntersectsDirtyRect(RenderBoxModelObject*, InlineFlowBox*, const PaintInfo&, const LayoutPoint&) const;
     bool rangeIntersectsRect(RenderBoxModelObject*, LayoutUnit logicalTop, LayoutUnit logicalBottom, const LayoutRect&, const LayoutPoint&) const;
@@ -76,6 +83,9 @@ private:
     // For inline flows, each box represents a portion of that inline.
     InlineFlowBox* m_firstLineBox;
     InlineFlowBox* m_lastLineBox;
+
+    mutable Vector<InlineFlowBox*> m_orderedLineBoxes;
+    mutable bool m_orderedLineBoxesDirty;
 };
 
 
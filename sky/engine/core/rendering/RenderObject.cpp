@@ -1371,6 +1371,15 @@ void RenderObject::willBeRemovedFromTree()
 {
     // FIXME: We should ASSERT(isRooted()) but we have some out-of-order removals which would need to be fixed first.
 
+    // Any pending relayout boundary in this subtree is about to become
+    // unreachable from the view; drop the registrations while the parent
+    // chain still leads there.
+    RenderObject* root = this;
+    while (root->parent())
+        root = root->parent();
+    if (root->isRenderView() && root != this)
+        toRenderView(root)->removeRelayoutBoundariesInSubtree(this);
+
     // Keep our layer hierarchy updated.
     if (slowFirstChild() || hasLayer())
         removeLayers(parent()->enclosingLayer());
@@ -1424,6 +1433,25 @@ bool RenderObject::nodeAtPoint(const HitTestRequest&, HitTestResult&, const HitT
 
 void RenderObject::scheduleRelayout()
 {
+    // Sky drives layout externally through RenderView::layout(); there is no
+    // scheduler to poke. When the containing block walk stopped early at a
+    // relayout boundary, though, the dirty bits never reach the view, so the
+    // boundary has to be recorded there or its subtree would never get laid
+    // out again.
+    if (isRenderView())
+        return;
+
+    // A dashboard invalidating hundreds of boundaries per tick would climb
+    // the whole ancestor chain once per boundary; after the first climb
+    // registers us, repeats are answered by the bit alone.
+    if (isRegisteredRelayoutBoundary())
+        return;
+
+    RenderObject* root = this;
+    while (root->parent())
+        root = root->parent();
+    if (root->isRenderView())
+        toRenderView(root)->addRelayoutBoundary(this);
 }
 
 void RenderObject::forceLayout()
@@ -371,6 +371,13 @@ public:
 
     void scheduleRelayout();
 
+    // True while this object sits in the RenderView's relayout boundary list.
+    // Lets scheduleRelayout() skip the walk to the root for every marking
+    // after the first; hundreds of cells invalidated per tick would otherwise
+    // each climb the whole ancestor chain just to re-register themselves.
+    bool isRegisteredRelayoutBoundary() const { return m_bitfields.isRegisteredRelayoutBoundary(); }
+    void setIsRegisteredRelayoutBoundary(bool b) { m_bitfields.setIsRegisteredRelayoutBoundary(b); }
+
     void updateFillImages(const FillLayer* oldLayers, const FillLayer& newLayers);
     void updateImage(StyleImage*, StyleImage*);
 
@@ -647,13 +654,14 @@ private:
             , m_hasBoxDecorationBackground(false)
             , m_everHadLayout(false)
             , m_ancestorLineBoxDirty(false)
+            , m_isRegisteredRelayoutBoundary(false)
             , m_alwaysCreateLineBoxesForRenderInline(false)
             , m_positionedState(IsStaticallyPositioned)
             , m_selectionState(SelectionNone)
         {
         }
 
-        // 32 bits have been used in the first word, and 11 in the second.
+        // 32 bits have been used in the first word, and 12 in the second.
         ADD_BOOLEAN_BITFIELD(selfNeedsLayout, SelfNeedsLayout);
         ADD_BOOLEAN_BITFIELD(onlyNeededPositionedMovementLayout, OnlyNeededPositionedMovementLayout);
         ADD_BOOLEAN_BITFIELD(neededLayoutBecauseOfChildren, NeededLayoutBecauseOfChildren);
@@ -678,6 +686,7 @@ private:
 
         ADD_BOOLEAN_BITFIELD(everHadLayout, EverHadLayout);
         ADD_BOOLEAN_BITFIELD(ancestorLineBoxDirty, AncestorLineBoxDirty);
+        ADD_BOOLEAN_BITFIELD(isRegisteredRelayoutBoundary, IsRegisteredRelayoutBoundary);
 
         // from RenderInline
         ADD_BOOLEAN_BITFIELD(alwaysCreateLineBoxesForRenderInline, AlwaysCreateLineBoxesForRenderInline);
@@ -159,11 +159,19 @@ GapRects RenderParagraph::inlineSelectionGaps(RenderBlock* rootBlock, const Layo
 void RenderParagraph::addOverflowFromChildren()
 {
     LayoutUnit endPadding = hasOverflowClip() ? paddingEnd() : LayoutUnit();
+    // Gather the per-line rects and unite each set in one pass of the batch
+    // kernels, folding the result into the overflow bookkeeping once instead
+    // of reconstructing the overflow rects line by line.
+    Vector<LayoutRect, 32> paddedLayoutOverflowRects;
+    Vector<LayoutRect, 32> visualOverflowRects;
     for (RootInlineBox* curr = firstRootBox(); curr; curr = curr->nextRootBox()) {
-        addLayoutOverflow(curr->paddedLayoutOverflowRect(endPadding));
-        LayoutRect visualOverflow = curr->visualOverflowRect(curr->lineTop(), curr->lineBottom());
-        addContentsVisualOverflow(visualOverflow);
+        paddedLayoutOverflowRects.append(curr->paddedLayoutOverflowRect(endPadding));
+        visualOverflowRects.append(curr->visualOverflowRect(curr->lineTop(), curr->lineBottom()));
     }
+    if (paddedLayoutOverflowRects.isEmpty())
+        return;
+    addLayoutOverflow(unionRect(paddedLayoutOverflowRects.data(), paddedLayoutOverflowRects.size()));
+    addContentsVisualOverflow(unionRect(visualOverflowRects.data(), visualOverflowRects.size()));
 }
 
 void RenderParagraph::simplifiedNormalFlowLayout()
@@ -846,6 +854,33 @@ void RenderParagraph::layoutRunsAndFloats(LineLayoutState& layoutState)
     linkToEndLineIfNeeded(layoutState);
 }
 
+static bool contentRequiresBidiResolution(const RenderObject* parent)
+{
+    for (RenderObject* child = parent->slowFirstChild(); child; child = child->nextSibling()) {
+        if (child->isText()) {
+            if (toRenderText(child)->requiresBidiResolution())
+                return true;
+            continue;
+        }
+        if (child->isRenderInline()
+            && (child->style()->unicodeBidi() != UBNormal || contentRequiresBidiResolution(child)))
+            return true;
+    }
+    return false;
+}
+
+// Returns true when every line in this paragraph is guaranteed to resolve to
+// a single left-to-right run, letting layout skip the per-character Unicode
+// Bidi Algorithm. The expensive part of the answer, classifying the text, is
+// cached on each RenderText and recomputed only when its text changes, so
+// re-wrapping the paragraph at a new width reuses the previous analysis.
+bool RenderParagraph::lineContentsAreUnidirectional() const
+{
+    if (!style()->isLeftToRightDirection() || style()->unicodeBidi() != UBNormal)
+        return false;
+    return !contentRequiresBidiResolution(this);
+}
+
 void RenderParagraph::layoutRunsAndFloatsInRange(LineLayoutState& layoutState,
     InlineBidiResolver& resolver, const InlineIterator& cleanLineStart,
     const BidiStatus& cleanLineBidiStatus)
@@ -857,6 +892,8 @@ void RenderParagraph::layoutRunsAndFloatsInRange(LineLayoutState& layoutState,
     RenderTextInfo renderTextInfo;
     VerticalPositionCache verticalPositionCache;
     LineBreaker lineBreaker(this);
+    bool contentIsUnidirectional = styleToUse->rtlOrdering() == LogicalOrder
+        && lineContentsAreUnidirectional();
 
     m_didExceedMaxLines = false;
 
@@ -899,14 +936,18 @@ void RenderParagraph::layoutRunsAndFloatsInRange(LineLayoutState& layoutState,
             if (lastRootBox())
                 lastRootBox()->setLineBreakInfo(endOfLine.object(), endOfLine.offset(), resolver.status());
         } else {
-            VisualDirectionOverride override = (styleToUse->rtlOrdering() == VisualOrder ? (styleToUse->direction() == LTR ? VisualLeftToRightOverride : VisualRightToLeftOverride) : NoVisualOverride);
-            if (isNewUBAParagraph && styleToUse->unicodeBidi() == Plaintext && !resolver.context()->parent()) {
-                TextDirection direction = determinePlaintextDirectionality(resolver.position().root(), resolver.position().object(), resolver.position().offset());
-                resolver.setStatus(BidiStatus(direction, isOverride(styleToUse->unicodeBidi())));
-            }
             // FIXME: This ownership is reversed. We should own the BidiRunList and pass it to createBidiRunsForLine.
             BidiRunList<BidiRun>& bidiRuns = resolver.runs();
-            constructBidiRunsForLine(resolver, bidiRuns, endOfLine, override, layoutState.lineInfo().previousLineBrokeCleanly(), isNewUBAParagraph);
+            if (contentIsUnidirectional) {
+                resolver.createRunsForUnidirectionalLine(endOfLine, layoutState.lineInfo().previousLineBrokeCleanly());
+            } else {
+                VisualDirectionOverride override = (styleToUse->rtlOrdering() == VisualOrder ? (styleToUse->direction() == LTR ? VisualLeftToRightOverride : VisualRightToLeftOverride) : NoVisualOverride);
+                if (isNewUBAParagraph && styleToUse->unicodeBidi() == Plaintext && !resolver.context()->parent()) {
+                    TextDirection direction = determinePlaintextDirectionality(resolver.position().root(), resolver.position().object(), resolver.position().offset());
+                    resolver.setStatus(BidiStatus(direction, isOverride(styleToUse->unicodeBidi())));
+                }
+                constructBidiRunsForLine(resolver, bidiRuns, endOfLine, override, layoutState.lineInfo().previousLineBrokeCleanly(), isNewUBAParagraph);
+            }
             ASSERT(resolver.position() == endOfLine);
 
             BidiRun* trailingSpaceRun = resolver.trailingSpaceRun();
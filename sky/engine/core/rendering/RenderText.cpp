@@ -72,6 +72,7 @@ RenderText::RenderText(PassRefPtr<StringImpl> str)
 
   m_isAllASCII = m_text.containsOnlyASCII();
   m_canUseSimpleFontCodePath = computeCanUseSimpleFontCodePath();
+  m_requiresBidiResolution = computeRequiresBidiResolution();
   setIsText();
 }
 
@@ -1228,6 +1229,7 @@ void RenderText::setTextInternal(PassRefPtr<StringImpl> text) {
 
   m_isAllASCII = m_text.containsOnlyASCII();
   m_canUseSimpleFontCodePath = computeCanUseSimpleFontCodePath();
+  m_requiresBidiResolution = computeRequiresBidiResolution();
 }
 
 void RenderText::setText(PassRefPtr<StringImpl> text, bool force) {
@@ -1629,6 +1631,44 @@ bool RenderText::computeCanUseSimpleFontCodePath() const {
          SimplePath;
 }
 
+bool RenderText::computeRequiresBidiResolution() const {
+  // Latin-1 has no strong right-to-left characters, arabic numbers or
+  // explicit embedding controls.
+  if (m_text.is8Bit())
+    return false;
+
+  const UChar* characters = characters16();
+  unsigned length = textLength();
+  for (unsigned i = 0; i < length; ++i) {
+    UChar c = characters[i];
+    // Everything below the Hebrew block resolves to the embedding direction
+    // in a left-to-right paragraph.
+    if (c < 0x0590)
+      continue;
+    // Conservatively treat surrogates as bidirectional; the supplementary
+    // planes contain right-to-left scripts.
+    if (U16_IS_SURROGATE(c))
+      return true;
+    switch (WTF::Unicode::direction(c)) {
+      case WTF::Unicode::LeftToRight:
+      case WTF::Unicode::EuropeanNumber:
+      case WTF::Unicode::EuropeanNumberSeparator:
+      case WTF::Unicode::EuropeanNumberTerminator:
+      case WTF::Unicode::CommonNumberSeparator:
+      case WTF::Unicode::BlockSeparator:
+      case WTF::Unicode::SegmentSeparator:
+      case WTF::Unicode::WhiteSpaceNeutral:
+      case WTF::Unicode::OtherNeutral:
+      case WTF::Unicode::NonSpacingMark:
+      case WTF::Unicode::BoundaryNeutral:
+        break;
+      default:
+        return true;
+    }
+  }
+  return false;
+}
+
 #if ENABLE(ASSERT)
 
 void RenderText::checkConsistency() const {
@@ -128,6 +128,12 @@ public:
 
     bool canUseSimpleFontCodePath() const { return m_canUseSimpleFontCodePath; }
 
+    // True when the text contains a character that can introduce a second
+    // bidi level in a left-to-right paragraph: a strong right-to-left
+    // character, an arabic number, an explicit embedding control or a
+    // surrogate. Recomputed only when the text changes.
+    bool requiresBidiResolution() const { return m_requiresBidiResolution; }
+
     void removeAndDestroyTextBoxes();
 
 protected:
@@ -146,6 +152,7 @@ private:
     void computePreferredLogicalWidths(float leadWidth, HashSet<const SimpleFontData*>& fallbackFonts, GlyphOverflow&);
 
     bool computeCanUseSimpleFontCodePath() const;
+    bool computeRequiresBidiResolution() const;
 
     // Make length() private so that callers that have a RenderText*
     // will use the more efficient textLength() instead, while
@@ -177,6 +184,7 @@ private:
     bool m_containsReversedText : 1;
     bool m_isAllASCII : 1;
     bool m_canUseSimpleFontCodePath : 1;
+    bool m_requiresBidiResolution : 1;
     mutable bool m_knownToHaveNoOverflowAndNoFallbackFonts : 1;
 
     float m_minWidth;
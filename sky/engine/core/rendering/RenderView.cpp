@@ -36,6 +36,11 @@ RenderView::RenderView()
     , m_selectionEndPos(-1)
     , m_renderCounterCount(0)
     , m_hitTestCount(0)
+    , m_layoutEpoch(0)
+    , m_hasCachedHitTest(false)
+    , m_cachedHitTestInside(false)
+    , m_cachedHitTestEpoch(0)
+    , m_cachedHitTestType(0)
 {
     // init RenderObject attributes
     setInline(false);
@@ -61,6 +66,19 @@ bool RenderView::hitTest(const HitTestRequest& request, const HitTestLocation& l
 {
     m_hitTestCount++;
 
+    // A repeat of the exact point against an unchanged tree is answered from
+    // the last result. The cache is keyed on the exact point rather than a
+    // movement threshold: a hit resolves to the nearest boundary, so even a
+    // small delta can legitimately change the answer.
+    if (!location.isRectBasedTest()
+        && m_hasCachedHitTest
+        && m_cachedHitTestEpoch == m_layoutEpoch
+        && m_cachedHitTestType == request.type()
+        && m_cachedHitTestPoint == location.point()) {
+        result = m_cachedHitTestResult;
+        return m_cachedHitTestInside;
+    }
+
     // TODO(ojan): Does any of this intersection stuff make sense for Sky?
     LayoutRect hitTestArea;
     hitTestArea.setSize(m_frameViewSize);
@@ -77,6 +95,16 @@ bool RenderView::hitTest(const HitTestRequest& request, const HitTestLocation& l
             insideLayer = true;
         }
     }
+
+    if (!location.isRectBasedTest()) {
+        m_hasCachedHitTest = true;
+        m_cachedHitTestInside = insideLayer;
+        m_cachedHitTestEpoch = m_layoutEpoch;
+        m_cachedHitTestType = request.type();
+        m_cachedHitTestPoint = location.point();
+        m_cachedHitTestResult = result;
+    }
+
     return insideLayer;
 }
 
@@ -111,11 +139,66 @@ void RenderView::layout()
         }
     }
 
-    if (!needsLayout())
+    if (needsLayout()) {
+        RenderFlexibleBox::layout();
+        clearNeedsLayout();
+        // A full layout can move any box, so no clip rects computed against
+        // the old geometry may survive. The epoch bump is O(1); stale entries
+        // are rebuilt lazily as they are queried.
+        layer()->clipper().invalidateClipRectsIncludingDescendants();
+        m_layoutEpoch++;
+    }
+
+    // Subtrees behind relayout boundaries are laid out here without the
+    // invalidation ever having escalated to the root. Boundaries the full
+    // layout above happened to reach are clean again and drop out for free.
+    layoutRelayoutBoundaries();
+}
+
+void RenderView::addRelayoutBoundary(RenderObject* renderer)
+{
+    // The registered bit both dedupes the list (so no linear find here) and
+    // lets scheduleRelayout() skip its walk to the root on re-invalidation.
+    if (renderer->isRegisteredRelayoutBoundary())
+        return;
+    renderer->setIsRegisteredRelayoutBoundary(true);
+    m_relayoutBoundaries.append(renderer);
+}
+
+void RenderView::removeRelayoutBoundariesInSubtree(RenderObject* subtreeRoot)
+{
+    for (size_t i = m_relayoutBoundaries.size(); i > 0; --i) {
+        RenderObject* boundary = m_relayoutBoundaries[i - 1];
+        if (boundary == subtreeRoot || boundary->isDescendantOf(subtreeRoot)) {
+            boundary->setIsRegisteredRelayoutBoundary(false);
+            m_relayoutBoundaries.remove(i - 1);
+        }
+    }
+}
+
+void RenderView::layoutRelayoutBoundaries()
+{
+    if (m_relayoutBoundaries.isEmpty())
         return;
 
-    RenderFlexibleBox::layout();
-    clearNeedsLayout();
+    // Laying out a boundary cannot dirty anything outside its subtree, but
+    // swap the list out anyway so a registration during the drain (which
+    // would indicate a marking bug) cannot invalidate the iterator.
+    Vector<RenderObject*> boundaries;
+    boundaries.swap(m_relayoutBoundaries);
+    for (size_t i = 0; i < boundaries.size(); ++i) {
+        RenderObject* boundary = boundaries[i];
+        boundary->setIsRegisteredRelayoutBoundary(false);
+        if (!boundary->needsLayout())
+            continue;
+        boundary->layoutIfNeeded();
+        m_layoutEpoch++;
+        // Boxes inside the boundary may have moved; clip rects cached at or
+        // below its nearest layer are stale. Layers in other subtrees keep
+        // their entries, which is the point of laying out at a boundary.
+        if (RenderLayer* enclosing = boundary->enclosingLayer())
+            enclosing->clipper().invalidateClipRectsIncludingDescendants();
+    }
 }
 
 void RenderView::mapLocalToContainer(const RenderBox* paintInvalidationContainer, TransformState& transformState, MapCoordinatesFlags mode) const
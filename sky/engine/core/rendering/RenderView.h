@@ -22,6 +22,8 @@
 #ifndef SKY_ENGINE_CORE_RENDERING_RENDERVIEW_H_
 #define SKY_ENGINE_CORE_RENDERING_RENDERVIEW_H_
 
+#include "flutter/sky/engine/core/rendering/HitTestRequest.h"
+#include "flutter/sky/engine/core/rendering/HitTestResult.h"
 #include "flutter/sky/engine/core/rendering/RenderFlexibleBox.h"
 #include "flutter/sky/engine/wtf/OwnPtr.h"
 
@@ -75,6 +77,15 @@ public:
 
     void setFrameViewSize(const IntSize& frameViewSize) { m_frameViewSize = frameViewSize; }
 
+    // Relayout boundaries are boxes with a fixed width and height (and an
+    // overflow clip), so laying out their subtree cannot change anything
+    // outside it; the box's own size is effectively the cached measurement.
+    // markContainingBlocksForLayout stops marking at such a box and records it
+    // here, and the next layout() lays the subtree out on its own instead of
+    // escalating to the whole tree.
+    void addRelayoutBoundary(RenderObject*);
+    void removeRelayoutBoundariesInSubtree(RenderObject* subtreeRoot);
+
     IntRect unscaledDocumentRect() const;
     LayoutRect backgroundRect(RenderBox* backgroundRenderer) const;
 
@@ -91,8 +102,12 @@ private:
     void positionDialog(RenderBox*);
     void positionDialogs();
 
+    void layoutRelayoutBoundaries();
+
     IntSize m_frameViewSize;
 
+    Vector<RenderObject*> m_relayoutBoundaries;
+
     RawPtr<RenderObject> m_selectionStart;
     RawPtr<RenderObject> m_selectionEnd;
 
@@ -102,6 +117,21 @@ private:
     unsigned m_renderCounterCount;
 
     unsigned m_hitTestCount;
+
+    // Bumped whenever layout changes any geometry; validates the hit test
+    // cache below.
+    unsigned m_layoutEpoch;
+
+    // Last-result cache for hitTest(). Hover and move streams query nearly
+    // identical points hundreds of times per second, and repeats of the
+    // exact point against an unchanged tree are answered without descending
+    // the tree.
+    bool m_hasCachedHitTest;
+    bool m_cachedHitTestInside;
+    unsigned m_cachedHitTestEpoch;
+    HitTestRequest::HitTestRequestType m_cachedHitTestType;
+    LayoutPoint m_cachedHitTestPoint;
+    HitTestResult m_cachedHitTestResult;
 };
 
 DEFINE_RENDER_OBJECT_TYPE_CASTS(RenderView, isRenderView());
@@ -142,6 +142,20 @@ inline bool needsLineBreakIterator(UChar ch)
     return ch > asciiLineBreakTableLastChar && ch != noBreakSpace;
 }
 
+// Finds the end of the ASCII alphanumeric run starting at |pos|. No break
+// opportunity can occur inside such a run: alphanumerics are not breakable
+// spaces, their rows in asciiLineBreakTable are empty, the '-'-digit rule
+// only fires after a '-', and they never require the break iterator. The
+// loop is branch-free enough for the compiler to vectorize the 8-bit case.
+template<typename CharacterType>
+static inline int endOfAlphanumericRun(const CharacterType* str, int len, int pos)
+{
+    int i = pos;
+    while (i < len && isASCIIAlphanumeric(str[i]))
+        i++;
+    return i;
+}
+
 template<typename CharacterType, bool treatNoBreakSpaceAsBreak>
 static inline int nextBreakablePosition(LazyLineBreakIterator& lazyBreakIterator, const CharacterType* str, unsigned length, int pos)
 {
@@ -154,6 +168,21 @@ static inline int nextBreakablePosition(LazyLineBreakIterator& lazyBreakIterator
     for (int i = pos; i < len; i++) {
         CharacterType ch = str[i];
 
+        // Fast path: skip over the rest of an alphanumeric run wholesale.
+        // This needs an alphanumeric predecessor too, since the character
+        // before the run ('-' in particular) can create an opportunity
+        // before the run's first character.
+        if (isASCIIAlphanumeric(ch) && isASCIIAlphanumeric(lastCh)) {
+            int runEnd = endOfAlphanumericRun(str, len, i);
+            // Position at the last character of the run; the loop re-enters
+            // the slow path for the first character after it with the
+            // context characters maintained below.
+            lastLastCh = runEnd - 2 >= i ? str[runEnd - 2] : lastCh;
+            lastCh = str[runEnd - 1];
+            i = runEnd - 1;
+            continue;
+        }
+
         if (isBreakableSpace<treatNoBreakSpaceAsBreak>(ch) || shouldBreakAfter(lastLastCh, lastCh, ch))
             return i;
 
@@ -8,6 +8,14 @@
 
 namespace blink {
 
+void TimingFunction::evaluateBatch(const double* fractions, double* results, size_t count, double accuracy) const
+{
+    // Subclasses whose per-sample math is cheap override this with a loop
+    // that skips the per-sample virtual dispatch.
+    for (size_t i = 0; i < count; ++i)
+        results[i] = evaluate(fractions[i], accuracy);
+}
+
 String LinearTimingFunction::toString() const
 {
     return "linear";
@@ -18,6 +26,11 @@ double LinearTimingFunction::evaluate(double fraction, double) const
     return fraction;
 }
 
+void LinearTimingFunction::evaluateBatch(const double* fractions, double* results, size_t count, double) const
+{
+    std::copy(fractions, fractions + count, results);
+}
+
 void LinearTimingFunction::range(double* minValue, double* maxValue) const
 {
 }
@@ -45,9 +58,15 @@ String CubicBezierTimingFunction::toString() const
 
 double CubicBezierTimingFunction::evaluate(double fraction, double accuracy) const
 {
-    if (!m_bezier)
-        m_bezier = adoptPtr(new UnitBezier(m_x1, m_y1, m_x2, m_y2));
-    return m_bezier->solve(fraction, accuracy);
+    return m_bezier.solve(fraction, accuracy);
+}
+
+void CubicBezierTimingFunction::evaluateBatch(const double* fractions, double* results, size_t count, double accuracy) const
+{
+    // The solver runs straight over the coefficients computed at
+    // construction; nothing here is virtual or allocates.
+    for (size_t i = 0; i < count; ++i)
+        results[i] = m_bezier.solve(fractions[i], accuracy);
 }
 
 // This works by taking taking the derivative of the cubic bezier, on the y
@@ -88,22 +107,20 @@ void CubicBezierTimingFunction::range(double* minValue, double* maxValue) const
 
     // If the solution is in the range [0,1] then we include it, otherwise we
     // ignore it.
-    if (!m_bezier)
-        m_bezier = adoptPtr(new UnitBezier(m_x1, m_y1, m_x2, m_y2));
 
     // An interesting fact about these beziers is that they are only
     // actually evaluated in [0,1]. After that we take the tangent at that point
     // and linearly project it out.
     if (0 < t1 && t1 < 1)
-        solution1= m_bezier->sampleCurveY(t1);
+        solution1= m_bezier.sampleCurveY(t1);
 
     if (0 < t2 && t2 < 1)
-        solution2 = m_bezier->sampleCurveY(t2);
+        solution2 = m_bezier.sampleCurveY(t2);
 
     // Since our input values can be out of the range 0->1 so we must also
     // consider the minimum and maximum points.
-    double solutionMin = m_bezier->solve(*minValue, std::numeric_limits<double>::epsilon());
-    double solutionMax = m_bezier->solve(*maxValue, std::numeric_limits<double>::epsilon());
+    double solutionMin = m_bezier.solve(*minValue, std::numeric_limits<double>::epsilon());
+    double solutionMax = m_bezier.solve(*maxValue, std::numeric_limits<double>::epsilon());
     *minValue = std::min(std::min(solutionMin, solutionMax), 0.0);
     *maxValue = std::max(std::max(solutionMin, solutionMax), 1.0);
     *minValue = std::min(std::min(*minValue, solution1), solution2);
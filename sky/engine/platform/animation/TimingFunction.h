@@ -55,6 +55,13 @@ public:
     // accuracy and is not guaranteed.
     virtual double evaluate(double fraction, double accuracy) const = 0;
 
+    // Evaluates the timing function at each of the |count| fractions, writing
+    // the results through |results|. Equivalent to calling evaluate() once per
+    // fraction, but with a single virtual dispatch for the whole batch and a
+    // tight loop over the curve's cached coefficients, for callers animating
+    // many properties from the same curve each frame.
+    virtual void evaluateBatch(const double* fractions, double* results, size_t count, double accuracy) const;
+
     // This function returns the minimum and maximum values obtainable when
     // calling evaluate();
     virtual void range(double* minValue, double* maxValue) const = 0;
@@ -82,6 +89,7 @@ public:
     virtual String toString() const override;
 
     virtual double evaluate(double fraction, double) const override;
+    virtual void evaluateBatch(const double* fractions, double* results, size_t count, double accuracy) const override;
 
     virtual void range(double* minValue, double* maxValue) const override;
 private:
@@ -140,6 +148,7 @@ public:
     virtual String toString() const override;
 
     virtual double evaluate(double fraction, double accuracy) const override;
+    virtual void evaluateBatch(const double* fractions, double* results, size_t count, double accuracy) const override;
     virtual void range(double* minValue, double* maxValue) const override;
 
     double x1() const { return m_x1; }
@@ -157,6 +166,7 @@ private:
         , m_x2(x2)
         , m_y2(y2)
         , m_subType(subType)
+        , m_bezier(x1, y1, x2, y2)
     {
     }
 
@@ -165,7 +175,8 @@ private:
     double m_x2;
     double m_y2;
     SubType m_subType;
-    mutable OwnPtr<UnitBezier> m_bezier;
+    // The polynomial coefficients, computed once at construction.
+    UnitBezier m_bezier;
 };
 
 class PLATFORM_EXPORT StepsTimingFunction final : public TimingFunction {
@@ -413,6 +413,26 @@ TEST_F(TimingFunctionTest, StepsEvaluate)
     EXPECT_EQ(1.00, stepsTimingCustomEnd->evaluate(2.00, 0));
 }
 
+TEST_F(TimingFunctionTest, EvaluateBatchMatchesEvaluate)
+{
+    double tolerance = 0.01;
+    RefPtr<TimingFunction> functions[] = {
+        LinearTimingFunction::shared(),
+        CubicBezierTimingFunction::preset(CubicBezierTimingFunction::EaseInOut),
+        CubicBezierTimingFunction::create(0.17, 0.67, 1, -1.73),
+        StepsTimingFunction::create(4, StepsTimingFunction::StepAtStart),
+    };
+    double fractions[] = { -0.5, 0.0, 0.25, 0.5, 0.75, 1.0, 1.5 };
+    const size_t fractionCount = sizeof(fractions) / sizeof(fractions[0]);
+
+    for (size_t i = 0; i < sizeof(functions) / sizeof(functions[0]); ++i) {
+        double results[fractionCount];
+        functions[i]->evaluateBatch(fractions, results, fractionCount, tolerance);
+        for (size_t j = 0; j < fractionCount; ++j)
+            EXPECT_EQ(functions[i]->evaluate(fractions[j], tolerance), results[j]);
+    }
+}
+
 } // namespace
 
 } // namespace blink
@@ -75,24 +75,24 @@ struct UnitBezier {
             m_endGradient = 0;
     }
 
-    double sampleCurveX(double t)
+    double sampleCurveX(double t) const
     {
         // `ax t^3 + bx t^2 + cx t' expanded using Horner's rule.
         return ((ax * t + bx) * t + cx) * t;
     }
 
-    double sampleCurveY(double t)
+    double sampleCurveY(double t) const
     {
         return ((ay * t + by) * t + cy) * t;
     }
 
-    double sampleCurveDerivativeX(double t)
+    double sampleCurveDerivativeX(double t) const
     {
         return (3.0 * ax * t + 2.0 * bx) * t + cx;
     }
 
     // Given an x value, find a parametric value it came from.
-    double solveCurveX(double x, double epsilon)
+    double solveCurveX(double x, double epsilon) const
     {
         ASSERT(x >= 0.0);
         ASSERT(x <= 1.0);
@@ -137,7 +137,7 @@ struct UnitBezier {
 
     // Evaluates y at the given x. The epsilon parameter provides a hint as to the required
     // accuracy and is not guaranteed.
-    double solve(double x, double epsilon)
+    double solve(double x, double epsilon) const
     {
         if (x < 0.0)
             return 0.0 + m_startGradient * x;
@@ -70,56 +70,158 @@ bool valueInIntervalList(const T (&intervalList)[size], const T& value)
     return bound > intervalList && *(bound - 1) == value;
 }
 
+static const UChar32 complexCodePathRanges[] = {
+    // U+02E5 through U+02E9 (Modifier Letters : Tone letters)
+    0x2E5, 0x2E9,
+    // U+0300 through U+036F Combining diacritical marks
+    0x300, 0x36F,
+    // U+0591 through U+05CF excluding U+05BE Hebrew combining marks, ...
+    0x0591, 0x05BD,
+    // ... Hebrew punctuation Paseq, Sof Pasuq and Nun Hafukha
+    0x05BF, 0x05CF,
+    // U+0600 through U+109F Arabic, Syriac, Thaana, NKo, Samaritan, Mandaic,
+    // Devanagari, Bengali, Gurmukhi, Gujarati, Oriya, Tamil, Telugu, Kannada,
+    // Malayalam, Sinhala, Thai, Lao, Tibetan, Myanmar
+    0x0600, 0x109F,
+    // U+1100 through U+11FF Hangul Jamo (only Ancient Korean should be left
+    // here if you precompose; Modern Korean will be precomposed as a result of step A)
+    0x1100, 0x11FF,
+    // U+135D through U+135F Ethiopic combining marks
+    0x135D, 0x135F,
+    // U+1780 through U+18AF Tagalog, Hanunoo, Buhid, Taghanwa,Khmer, Mongolian
+    0x1700, 0x18AF,
+    // U+1900 through U+194F Limbu (Unicode 4.0)
+    0x1900, 0x194F,
+    // U+1980 through U+19DF New Tai Lue
+    0x1980, 0x19DF,
+    // U+1A00 through U+1CFF Buginese, Tai Tham, Balinese, Batak, Lepcha, Vedic
+    0x1A00, 0x1CFF,
+    // U+1DC0 through U+1DFF Comining diacritical mark supplement
+    0x1DC0, 0x1DFF,
+    // U+20D0 through U+20FF Combining marks for symbols
+    0x20D0, 0x20FF,
+    // U+2CEF through U+2CF1 Combining marks for Coptic
+    0x2CEF, 0x2CF1,
+    // U+302A through U+302F Ideographic and Hangul Tone marks
+    0x302A, 0x302F,
+    // U+A67C through U+A67D Combining marks for old Cyrillic
+    0xA67C, 0xA67D,
+    // U+A6F0 through U+A6F1 Combining mark for Bamum
+    0xA6F0, 0xA6F1,
+    // U+A800 through U+ABFF Nagri, Phags-pa, Saurashtra, Devanagari Extended,
+    // Hangul Jamo Ext. A, Javanese, Myanmar Extended A, Tai Viet, Meetei Mayek
+    0xA800, 0xABFF,
+    // U+D7B0 through U+D7FF Hangul Jamo Ext. B
+    0xD7B0, 0xD7FF,
+    // U+FE00 through U+FE0F Unicode variation selectors
+    0xFE00, 0xFE0F,
+    // U+FE20 through U+FE2F Combining half marks
+    0xFE20, 0xFE2F
+};
+
+static const UChar32 cjkIdeographRanges[] = {
+    // CJK Radicals Supplement and Kangxi Radicals.
+    0x2E80, 0x2FDF,
+    // CJK Strokes.
+    0x31C0, 0x31EF,
+    // CJK Unified Ideographs Extension A.
+    0x3400, 0x4DBF,
+    // The basic CJK Unified Ideographs block.
+    0x4E00, 0x9FFF,
+    // CJK Compatibility Ideographs.
+    0xF900, 0xFAFF,
+    // CJK Unified Ideographs Extension B.
+    0x20000, 0x2A6DF,
+    // CJK Unified Ideographs Extension C.
+    // CJK Unified Ideographs Extension D.
+    0x2A700, 0x2B81F,
+    // CJK Compatibility Ideographs Supplement.
+    0x2F800, 0x2FA1F
+};
+
+static const UChar32 cjkSymbolRanges[] = {
+    0x2156, 0x215A,
+    0x2160, 0x216B,
+    0x2170, 0x217B,
+    0x23BE, 0x23CC,
+    0x2460, 0x2492,
+    0x249C, 0x24FF,
+    0x25CE, 0x25D3,
+    0x25E2, 0x25E6,
+    0x2600, 0x2603,
+    0x2660, 0x266F,
+    0x2672, 0x267D,
+    0x2776, 0x277F,
+    // Ideographic Description Characters, with CJK Symbols and Punctuation, excluding 0x3030.
+    // Then Hiragana 0x3040 .. 0x309F, Katakana 0x30A0 .. 0x30FF, Bopomofo 0x3100 .. 0x312F
+    0x2FF0, 0x302F,
+    0x3031, 0x312F,
+    // More Bopomofo and Bopomofo Extended 0x31A0 .. 0x31BF
+    0x3190, 0x31BF,
+    // Enclosed CJK Letters and Months (0x3200 .. 0x32FF).
+    // CJK Compatibility (0x3300 .. 0x33FF).
+    0x3200, 0x33FF,
+    0xF860, 0xF862,
+    // CJK Compatibility Forms.
+    0xFE30, 0xFE4F,
+    // Halfwidth and Fullwidth Forms
+    // Usually only used in CJK
+    0xFF00, 0xFF0C,
+    0xFF0E, 0xFF1A,
+    0xFF1F, 0xFFEF,
+    // Emoji.
+    0x1F110, 0x1F129,
+    0x1F130, 0x1F149,
+    0x1F150, 0x1F169,
+    0x1F170, 0x1F189,
+    0x1F200, 0x1F6FF
+};
+
+// Property bits for the per-code-unit table below.
+static const uint8_t cComplexPathProperty = 1 << 0;
+// U+1E00 through U+2000 characters with diacritics and stacked diacritics.
+static const uint8_t cGlyphOverflowPathProperty = 1 << 1;
+static const uint8_t cCJKIdeographProperty = 1 << 2;
+static const uint8_t cCJKIdeographOrSymbolProperty = 1 << 3;
+
+static void markPropertyRanges(uint8_t* table, const UChar32* rangeList, size_t size, uint8_t property)
+{
+    for (size_t i = 0; i < size; i += 2) {
+        if (rangeList[i] > 0xFFFF)
+            break;
+        UChar32 last = std::min<UChar32>(rangeList[i + 1], 0xFFFF);
+        for (UChar32 c = rangeList[i]; c <= last; ++c)
+            table[c] |= property;
+    }
+}
+
+// One byte per Basic Multilingual Plane code unit, recording every property
+// the font path asks about per character. Built once from the range lists
+// above, so the hot classification loops are a single array load instead of
+// a binary search per character; characters outside the BMP only reach the
+// range lists after a surrogate pair has been decoded, which is rare enough
+// to leave on the slow path.
+static const uint8_t* characterPropertyTable()
+{
+    static uint8_t* table = 0;
+    if (!table) {
+        table = new uint8_t[0x10000]();
+        markPropertyRanges(table, complexCodePathRanges, WTF_ARRAY_LENGTH(complexCodePathRanges), cComplexPathProperty);
+        static const UChar32 glyphOverflowPathRange[] = { 0x1E00, 0x2000 };
+        markPropertyRanges(table, glyphOverflowPathRange, WTF_ARRAY_LENGTH(glyphOverflowPathRange), cGlyphOverflowPathProperty);
+        markPropertyRanges(table, cjkIdeographRanges, WTF_ARRAY_LENGTH(cjkIdeographRanges), cCJKIdeographProperty | cCJKIdeographOrSymbolProperty);
+        markPropertyRanges(table, cjkSymbolRanges, WTF_ARRAY_LENGTH(cjkSymbolRanges), cCJKIdeographOrSymbolProperty);
+        for (size_t i = 0; i < WTF_ARRAY_LENGTH(cjkIsolatedSymbolsArray); ++i) {
+            if (cjkIsolatedSymbolsArray[i] <= 0xFFFF)
+                table[cjkIsolatedSymbolsArray[i]] |= cCJKIdeographOrSymbolProperty;
+        }
+    }
+    return table;
+}
+
 CodePath Character::characterRangeCodePath(const UChar* characters, unsigned len)
 {
-    static const UChar complexCodePathRanges[] = {
-        // U+02E5 through U+02E9 (Modifier Letters : Tone letters)
-        0x2E5, 0x2E9,
-        // U+0300 through U+036F Combining diacritical marks
-        0x300, 0x36F,
-        // U+0591 through U+05CF excluding U+05BE Hebrew combining marks, ...
-        0x0591, 0x05BD,
-        // ... Hebrew punctuation Paseq, Sof Pasuq and Nun Hafukha
-        0x05BF, 0x05CF,
-        // U+0600 through U+109F Arabic, Syriac, Thaana, NKo, Samaritan, Mandaic,
-        // Devanagari, Bengali, Gurmukhi, Gujarati, Oriya, Tamil, Telugu, Kannada,
-        // Malayalam, Sinhala, Thai, Lao, Tibetan, Myanmar
-        0x0600, 0x109F,
-        // U+1100 through U+11FF Hangul Jamo (only Ancient Korean should be left
-        // here if you precompose; Modern Korean will be precomposed as a result of step A)
-        0x1100, 0x11FF,
-        // U+135D through U+135F Ethiopic combining marks
-        0x135D, 0x135F,
-        // U+1780 through U+18AF Tagalog, Hanunoo, Buhid, Taghanwa,Khmer, Mongolian
-        0x1700, 0x18AF,
-        // U+1900 through U+194F Limbu (Unicode 4.0)
-        0x1900, 0x194F,
-        // U+1980 through U+19DF New Tai Lue
-        0x1980, 0x19DF,
-        // U+1A00 through U+1CFF Buginese, Tai Tham, Balinese, Batak, Lepcha, Vedic
-        0x1A00, 0x1CFF,
-        // U+1DC0 through U+1DFF Comining diacritical mark supplement
-        0x1DC0, 0x1DFF,
-        // U+20D0 through U+20FF Combining marks for symbols
-        0x20D0, 0x20FF,
-        // U+2CEF through U+2CF1 Combining marks for Coptic
-        0x2CEF, 0x2CF1,
-        // U+302A through U+302F Ideographic and Hangul Tone marks
-        0x302A, 0x302F,
-        // U+A67C through U+A67D Combining marks for old Cyrillic
-        0xA67C, 0xA67D,
-        // U+A6F0 through U+A6F1 Combining mark for Bamum
-        0xA6F0, 0xA6F1,
-        // U+A800 through U+ABFF Nagri, Phags-pa, Saurashtra, Devanagari Extended,
-        // Hangul Jamo Ext. A, Javanese, Myanmar Extended A, Tai Viet, Meetei Mayek
-        0xA800, 0xABFF,
-        // U+D7B0 through U+D7FF Hangul Jamo Ext. B
-        0xD7B0, 0xD7FF,
-        // U+FE00 through U+FE0F Unicode variation selectors
-        0xFE00, 0xFE0F,
-        // U+FE20 through U+FE2F Combining half marks
-        0xFE20, 0xFE2F
-    };
+    const uint8_t* propertyTable = characterPropertyTable();
 
     CodePath result = SimplePath;
     for (unsigned i = 0; i < len; i++) {
@@ -129,12 +231,6 @@ CodePath Character::characterRangeCodePath(const UChar* characters, unsigned len
         if (c < 0x2E5)
             continue;
 
-        // U+1E00 through U+2000 characters with diacritics and stacked diacritics
-        if (c >= 0x1E00 && c <= 0x2000) {
-            result = SimpleWithGlyphOverflowPath;
-            continue;
-        }
-
         // Surrogate pairs
         if (c > 0xD7FF && c <= 0xDBFF) {
             if (i == len - 1)
@@ -162,9 +258,11 @@ CodePath Character::characterRangeCodePath(const UChar* characters, unsigned len
             continue;
         }
 
-        // Search for other Complex cases
-        if (valueInIntervalList(complexCodePathRanges, c))
+        uint8_t properties = propertyTable[c];
+        if (properties & cComplexPathProperty)
             return ComplexPath;
+        if (properties & cGlyphOverflowPathProperty)
+            result = SimpleWithGlyphOverflowPath;
     }
 
     return result;
@@ -172,30 +270,8 @@ CodePath Character::characterRangeCodePath(const UChar* characters, unsigned len
 
 bool Character::isCJKIdeograph(UChar32 c)
 {
-    static const UChar32 cjkIdeographRanges[] = {
-        // CJK Radicals Supplement and Kangxi Radicals.
-        0x2E80, 0x2FDF,
-        // CJK Strokes.
-        0x31C0, 0x31EF,
-        // CJK Unified Ideographs Extension A.
-        0x3400, 0x4DBF,
-        // The basic CJK Unified Ideographs block.
-        0x4E00, 0x9FFF,
-        // CJK Compatibility Ideographs.
-        0xF900, 0xFAFF,
-        // CJK Unified Ideographs Extension B.
-        0x20000, 0x2A6DF,
-        // CJK Unified Ideographs Extension C.
-        // CJK Unified Ideographs Extension D.
-        0x2A700, 0x2B81F,
-        // CJK Compatibility Ideographs Supplement.
-        0x2F800, 0x2FA1F
-    };
-    static size_t cjkIdeographRangesCount = WTF_ARRAY_LENGTH(cjkIdeographRanges);
-
-    // Early out
-    if (c < cjkIdeographRanges[0] || c > cjkIdeographRanges[cjkIdeographRangesCount - 1])
-        return false;
+    if (c <= 0xFFFF)
+        return characterPropertyTable()[c] & cCJKIdeographProperty;
 
     return valueInIntervalList(cjkIdeographRanges, c);
 }
@@ -206,58 +282,14 @@ bool Character::isCJKIdeographOrSymbol(UChar32 c)
     if (c < 0x2C7)
         return false;
 
-    // Hash lookup for isolated symbols (those not part of a contiguous range)
-    static HashSet<UChar32>* cjkIsolatedSymbols = 0;
-    if (!cjkIsolatedSymbols) {
-        cjkIsolatedSymbols = new HashSet<UChar32>();
-        for (size_t i = 0; i < WTF_ARRAY_LENGTH(cjkIsolatedSymbolsArray); ++i)
-            cjkIsolatedSymbols->add(cjkIsolatedSymbolsArray[i]);
-    }
-    if (cjkIsolatedSymbols->contains(c))
-        return true;
+    if (c <= 0xFFFF)
+        return characterPropertyTable()[c] & cCJKIdeographOrSymbolProperty;
 
-    if (isCJKIdeograph(c))
+    // 0x1F100 is the only isolated symbol outside the BMP.
+    if (c == 0x1F100)
         return true;
 
-    static const UChar32 cjkSymbolRanges[] = {
-        0x2156, 0x215A,
-        0x2160, 0x216B,
-        0x2170, 0x217B,
-        0x23BE, 0x23CC,
-        0x2460, 0x2492,
-        0x249C, 0x24FF,
-        0x25CE, 0x25D3,
-        0x25E2, 0x25E6,
-        0x2600, 0x2603,
-        0x2660, 0x266F,
-        0x2672, 0x267D,
-        0x2776, 0x277F,
-        // Ideographic Description Characters, with CJK Symbols and Punctuation, excluding 0x3030.
-        // Then Hiragana 0x3040 .. 0x309F, Katakana 0x30A0 .. 0x30FF, Bopomofo 0x3100 .. 0x312F
-        0x2FF0, 0x302F,
-        0x3031, 0x312F,
-        // More Bopomofo and Bopomofo Extended 0x31A0 .. 0x31BF
-        0x3190, 0x31BF,
-        // Enclosed CJK Letters and Months (0x3200 .. 0x32FF).
-        // CJK Compatibility (0x3300 .. 0x33FF).
-        0x3200, 0x33FF,
-        0xF860, 0xF862,
-        // CJK Compatibility Forms.
-        0xFE30, 0xFE4F,
-        // Halfwidth and Fullwidth Forms
-        // Usually only used in CJK
-        0xFF00, 0xFF0C,
-        0xFF0E, 0xFF1A,
-        0xFF1F, 0xFFEF,
-        // Emoji.
-        0x1F110, 0x1F129,
-        0x1F130, 0x1F149,
-        0x1F150, 0x1F169,
-        0x1F170, 0x1F189,
-        0x1F200, 0x1F6FF
-    };
-
-    return valueInIntervalList(cjkSymbolRanges, c);
+    return valueInIntervalList(cjkIdeographRanges, c) || valueInIntervalList(cjkSymbolRanges, c);
 }
 
 unsigned Character::expansionOpportunityCount(const LChar* characters, size_t length, TextDirection direction, bool& isAfterExpansion)
@@ -106,10 +106,32 @@ float Font::buildGlyphBuffer(const TextRunPaintInfo& runInfo, GlyphBuffer& glyph
     ForTextEmphasisOrNot forTextEmphasis) const
 {
     if (codePath(runInfo.run) == ComplexPath) {
+        // Whole runs whose shape cannot depend on their position on the line
+        // are cached, so paragraphs of mostly-repeated words only invoke
+        // HarfBuzz for novel ones.
+        bool isWholeRun = !runInfo.from && runInfo.to == runInfo.run.length();
+        ShapeCacheEntry* cacheEntry = (forTextEmphasis == NotForTextEmphasis
+                && isWholeRun
+                && runInfo.run.length() > 0
+                && !runInfo.run.allowTabs() // A tab's width depends on the run's position on the line.
+                && !runInfo.run.expansion() // Justification padding is distributed per run.
+                && !runInfo.run.directionalOverride())
+            ? m_fontFallbackList->shapeCache().add(runInfo.run)
+            : 0;
+        if (cacheEntry && cacheEntry->isShaped()) {
+            cacheEntry->replay(glyphBuffer);
+            return 0;
+        }
+
         HarfBuzzShaper shaper(this, runInfo.run, (forTextEmphasis == ForTextEmphasis)
             ? HarfBuzzShaper::ForTextEmphasis : HarfBuzzShaper::NotForTextEmphasis);
         shaper.setDrawRange(runInfo.from, runInfo.to);
-        shaper.shape(&glyphBuffer);
+        bool shaped = shaper.shape(&glyphBuffer);
+
+        if (cacheEntry && shaped && !glyphBuffer.isEmpty()) {
+            cacheEntry->set(glyphBuffer);
+            m_fontFallbackList->shapeCache().didShape(*cacheEntry);
+        }
 
         return 0;
     }
@@ -228,14 +250,16 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
     }
 
     bool hasWordSpacingOrLetterSpacing = fontDescription().wordSpacing() || fontDescription().letterSpacing();
-    bool isCacheable = codePathToUse == ComplexPath
-        && !hasWordSpacingOrLetterSpacing // Word spacing and letter spacing can change the width of a word.
+    // Simple path runs are cached alongside complex path runs so that a
+    // relayout at a new width only redoes line breaking instead of remeasuring
+    // every word.
+    bool isCacheable = !hasWordSpacingOrLetterSpacing // Word spacing and letter spacing can change the width of a word.
         && !run.allowTabs(); // If we allow tabs and a tab occurs inside a word, the width of the word varies based on its position on the line.
 
     WidthCacheEntry* cacheEntry = isCacheable
         ? m_fontFallbackList->widthCache().add(run, WidthCacheEntry())
         : 0;
-    if (cacheEntry && cacheEntry->isValid()) {
+    if (cacheEntry && cacheEntry->isValid() && (!glyphOverflow || cacheEntry->hasGlyphBounds)) {
         if (glyphOverflow)
             updateGlyphOverflowFromBounds(cacheEntry->glyphBounds, fontMetrics(), glyphOverflow);
         return cacheEntry->width;
@@ -243,16 +267,22 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
 
     float result;
     IntRectExtent glyphBounds;
+    bool hasGlyphBounds;
     if (codePathToUse == ComplexPath) {
         result = floatWidthForComplexText(run, fallbackFonts, &glyphBounds);
+        hasGlyphBounds = true;
     } else {
-        ASSERT(!isCacheable);
         result = floatWidthForSimpleText(run, fallbackFonts, glyphOverflow ? &glyphBounds : 0);
+        hasGlyphBounds = glyphOverflow;
     }
 
     if (cacheEntry && (!fallbackFonts || fallbackFonts->isEmpty())) {
-        cacheEntry->glyphBounds = glyphBounds;
-        cacheEntry->width = result;
+        // Don't let a measurement without bounds clobber an entry that has them.
+        if (hasGlyphBounds || !cacheEntry->isValid()) {
+            cacheEntry->width = result;
+            cacheEntry->hasGlyphBounds = hasGlyphBounds;
+            cacheEntry->glyphBounds = glyphBounds;
+        }
     }
 
     if (glyphOverflow)
@@ -560,8 +590,17 @@ std::pair<GlyphData, GlyphPage*> Font::glyphDataAndPageForCharacter(UChar32 c, b
     UChar32 characterToRender = c;
     if (characterToRender <=  0xFFFF)
         characterToRender = Character::normalizeSpaces(characterToRender);
-    const SimpleFontData* fontDataToSubstitute = fontDataAt(0)->fontDataForCharacter(characterToRender);
-    RefPtr<SimpleFontData> characterFontData = FontCache::fontCache()->fallbackFontForCharacter(m_fontDescription, characterToRender, fontDataToSubstitute);
+    RefPtr<SimpleFontData> characterFontData;
+    SimpleFontData* cachedFallbackFontData = 0;
+    if (m_fontFallbackList->lookupFallbackFontForCharacter(characterToRender, cachedFallbackFontData)) {
+        characterFontData = cachedFallbackFontData;
+    } else {
+        const SimpleFontData* fontDataToSubstitute = fontDataAt(0)->fontDataForCharacter(characterToRender);
+        characterFontData = FontCache::fontCache()->fallbackFontForCharacter(m_fontDescription, characterToRender, fontDataToSubstitute);
+        // Remember the resolution (or its failure) so neighboring characters
+        // from the same block skip the FontCache next time.
+        m_fontFallbackList->cacheFallbackFontForCharacter(characterToRender, characterFontData);
+    }
     if (characterFontData) {
         if (characterFontData->platformData().orientation() == Vertical && !characterFontData->hasVerticalGlyphs() && Character::isCJKIdeographOrSymbol(c))
             variant = BrokenIdeographVariant;
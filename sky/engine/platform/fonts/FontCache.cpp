@@ -37,6 +37,7 @@
 #include "flutter/sky/engine/platform/fonts/FontFallbackList.h"
 #include "flutter/sky/engine/platform/fonts/FontPlatformData.h"
 #include "flutter/sky/engine/platform/fonts/FontSmoothingMode.h"
+#include "flutter/sky/engine/platform/fonts/GlyphPageTreeNode.h"
 #include "flutter/sky/engine/platform/fonts/TextRenderingMode.h"
 #include "flutter/sky/engine/platform/fonts/opentype/OpenTypeVerticalData.h"
 #include "flutter/sky/engine/wtf/HashMap.h"
@@ -159,6 +160,23 @@ SimpleFontData* FontCache::getNonRetainedLastResortFallbackFont(const FontDescri
     return getLastResortFallbackFont(fontDescription, DoNotRetain).leakRef();
 }
 
+void FontCache::warmUp(const FontDescription& fontDescription, const Vector<AtomicString>& families)
+{
+    FontCachePurgePreventer purgePreventer;
+    for (size_t i = 0; i < families.size(); ++i) {
+        RefPtr<SimpleFontData> fontData = families[i].isEmpty()
+            ? getLastResortFallbackFont(fontDescription, DoNotRetain)
+            : getFontData(fontDescription, families[i], false, DoNotRetain);
+        if (!fontData)
+            continue;
+        // Realizing page zero faults in the typeface's cmap and horizontal
+        // metrics while we are still off the critical path of the first
+        // frame; the SimpleFontData itself stays resident in the inactive
+        // list of FontDataCache.
+        GlyphPageTreeNode::getRootChild(fontData.get(), 0)->page();
+    }
+}
+
 void FontCache::releaseFontData(const SimpleFontData* fontData)
 {
     ASSERT(gFontDataCache);
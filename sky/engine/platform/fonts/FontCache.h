@@ -81,6 +81,12 @@ public:
     SimpleFontData* getNonRetainedLastResortFallbackFont(const FontDescription&);
     bool isPlatformFontAvailable(const FontDescription&, const AtomicString&);
 
+    // Resolves and parses the platform fonts for the given families ahead of
+    // first use so the first text paint finds them hot in FontDataCache. An
+    // empty family name warms the platform default (last resort) font. Must
+    // be called on the thread that performs text layout.
+    void warmUp(const FontDescription&, const Vector<AtomicString>& families);
+
     void addClient(FontCacheClient*);
 #if !ENABLE(OILPAN)
     void removeClient(FontCacheClient*);
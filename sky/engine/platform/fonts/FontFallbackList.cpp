@@ -63,6 +63,65 @@ void FontFallbackList::invalidate(PassRefPtr<FontSelector> fontSelector)
     m_fontSelectorVersion = m_fontSelector ? m_fontSelector->version() : 0;
     m_generation = FontCache::fontCache()->generation();
     m_widthCache.clear();
+    m_shapeCache.clear();
+    m_fallbackCoverage.clear();
+}
+
+size_t FontFallbackList::fallbackCoverageIndexForCharacter(UChar32 c) const
+{
+    // Index of the first range whose |to| is not below |c|, which is the only
+    // range that can contain it; m_fallbackCoverage.size() if there is none.
+    size_t low = 0;
+    size_t high = m_fallbackCoverage.size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (m_fallbackCoverage[mid].to < c)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+bool FontFallbackList::lookupFallbackFontForCharacter(UChar32 c, SimpleFontData*& fontData) const
+{
+    size_t index = fallbackCoverageIndexForCharacter(c);
+    if (index == m_fallbackCoverage.size() || m_fallbackCoverage[index].from > c)
+        return false;
+    fontData = m_fallbackCoverage[index].fontData.get();
+    return true;
+}
+
+void FontFallbackList::cacheFallbackFontForCharacter(UChar32 c, PassRefPtr<SimpleFontData> passedFontData) const
+{
+    RefPtr<SimpleFontData> fontData = passedFontData;
+    size_t index = fallbackCoverageIndexForCharacter(c);
+    size_t count = m_fallbackCoverage.size();
+    if (index < count && m_fallbackCoverage[index].from <= c)
+        return; // Already covered.
+
+    // Fallback fonts cover contiguous blocks of codepoints, so most inserts
+    // extend a neighboring range instead of growing the vector.
+    bool extendsPrevious = index > 0
+        && m_fallbackCoverage[index - 1].to == c - 1
+        && m_fallbackCoverage[index - 1].fontData == fontData;
+    bool extendsNext = index < count
+        && m_fallbackCoverage[index].from == c + 1
+        && m_fallbackCoverage[index].fontData == fontData;
+    if (extendsPrevious && extendsNext) {
+        m_fallbackCoverage[index - 1].to = m_fallbackCoverage[index].to;
+        m_fallbackCoverage.remove(index);
+    } else if (extendsPrevious) {
+        m_fallbackCoverage[index - 1].to = c;
+    } else if (extendsNext) {
+        m_fallbackCoverage[index].from = c;
+    } else {
+        FallbackCoverageRange range;
+        range.from = c;
+        range.to = c;
+        range.fontData = fontData;
+        m_fallbackCoverage.insert(index, range);
+    }
 }
 
 void FontFallbackList::releaseFontData()
@@ -22,6 +22,7 @@
 #define SKY_ENGINE_PLATFORM_FONTS_FONTFALLBACKLIST_H_
 
 #include "flutter/sky/engine/platform/fonts/FontSelector.h"
+#include "flutter/sky/engine/platform/fonts/ShapeCache.h"
 #include "flutter/sky/engine/platform/fonts/SimpleFontData.h"
 #include "flutter/sky/engine/platform/fonts/WidthCache.h"
 #include "flutter/sky/engine/wtf/Forward.h"
@@ -82,6 +83,7 @@ public:
     unsigned generation() const { return m_generation; }
 
     WidthCache& widthCache() const { return m_widthCache; }
+    ShapeCache& shapeCache() const { return m_shapeCache; }
 
     const SimpleFontData* primarySimpleFontData(const FontDescription& fontDescription)
     {
@@ -92,6 +94,13 @@ public:
     }
     const FontData* fontDataAt(const FontDescription&, unsigned index) const;
 
+    // Lazily built map from codepoint ranges to the system fallback font that
+    // covers them, so mixed-script text resolves each range against the
+    // FontCache only once per fallback list. A cached null means system
+    // fallback already failed for the range. Returns false on a cache miss.
+    bool lookupFallbackFontForCharacter(UChar32, SimpleFontData*&) const;
+    void cacheFallbackFontForCharacter(UChar32, PassRefPtr<SimpleFontData>) const;
+
     GlyphPageTreeNode* getPageNode(unsigned pageNumber) const
     {
         return pageNumber ? m_pages.get(pageNumber) : m_pageZero;
@@ -114,12 +123,21 @@ private:
 
     void releaseFontData();
 
+    struct FallbackCoverageRange {
+        UChar32 from;
+        UChar32 to;
+        RefPtr<SimpleFontData> fontData; // Null when no font covers the range.
+    };
+    size_t fallbackCoverageIndexForCharacter(UChar32) const;
+
     mutable Vector<RefPtr<FontData>, 1> m_fontList;
     GlyphPages m_pages;
     GlyphPageTreeNode* m_pageZero;
     mutable const SimpleFontData* m_cachedPrimarySimpleFontData;
     RefPtr<FontSelector> m_fontSelector;
     mutable WidthCache m_widthCache;
+    mutable ShapeCache m_shapeCache;
+    mutable Vector<FallbackCoverageRange, 4> m_fallbackCoverage; // Sorted by |from|.
     unsigned m_fontSelectorVersion;
     mutable int m_familyIndex;
     unsigned short m_generation;
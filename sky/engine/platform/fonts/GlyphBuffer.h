@@ -51,11 +51,18 @@ public:
         m_fontData.clear();
         m_glyphs.clear();
         m_advances.clear();
+        m_positions.clear();
         m_offsets.clear();
+        m_totalAdvance = 0;
     }
 
     const Glyph* glyphs(unsigned from) const { return m_glyphs.data() + from; }
     const float* advances(unsigned from) const { return m_advances.data() + from; }
+    // Pen x position of each glyph relative to the start of the buffer: the
+    // prefix sum of the advances, maintained as glyphs are added so the
+    // paint paths can fill Skia's parallel position arrays with a constant
+    // offset per glyph instead of re-summing advances on every paint.
+    const float* positions(unsigned from) const { return m_positions.data() + from; }
     const FloatSize* offsets(unsigned from) const { return m_offsets.data() + from; }
 
     const SimpleFontData* fontDataAt(unsigned index) const { return m_fontData[index]; }
@@ -70,6 +77,11 @@ public:
         return m_advances[index];
     }
 
+    float positionAt(unsigned index) const
+    {
+        return m_positions[index];
+    }
+
     void add(Glyph glyph, const SimpleFontData* font, float width)
     {
         // should not mix offset/advance-only glyphs
@@ -78,6 +90,8 @@ public:
         m_fontData.append(font);
         m_glyphs.append(glyph);
         m_advances.append(width);
+        m_positions.append(m_totalAdvance);
+        m_totalAdvance += width;
     }
 
     void add(Glyph glyph, const SimpleFontData* font, const FloatSize& offset, float advance)
@@ -89,6 +103,8 @@ public:
         m_glyphs.append(glyph);
         m_offsets.append(offset);
         m_advances.append(advance);
+        m_positions.append(m_totalAdvance);
+        m_totalAdvance += advance;
     }
 
     void reverse()
@@ -96,6 +112,14 @@ public:
         m_fontData.reverse();
         m_glyphs.reverse();
         m_advances.reverse();
+
+        // One pass here at build time keeps every later paint free of the
+        // advance summation.
+        float position = 0;
+        for (size_t i = 0; i < m_positions.size(); ++i) {
+            m_positions[i] = position;
+            position += m_advances[i];
+        }
     }
 
     void expandLastAdvance(float width)
@@ -103,13 +127,16 @@ public:
         ASSERT(!isEmpty());
         float& lastAdvance = m_advances.last();
         lastAdvance += width;
+        m_totalAdvance += width;
     }
 
 private:
     Vector<const SimpleFontData*, 2048> m_fontData;
     Vector<Glyph, 2048> m_glyphs;
     Vector<float, 2048> m_advances;
+    Vector<float, 2048> m_positions;
     Vector<FloatSize, 1024> m_offsets;
+    float m_totalAdvance = 0;
 };
 
 } // namespace blink
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2006, 2007, 2008, 2013 Apple Inc. All rights reserved.
+ * Copyright (C) Research In Motion Limited 2011. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of Apple Computer, Inc. ("Apple") nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "flutter/sky/engine/platform/fonts/GlyphPage.h"
+
+#include "flutter/sky/engine/wtf/HashMap.h"
+#include "flutter/sky/engine/wtf/StdLibExtras.h"
+#include "flutter/sky/engine/wtf/StringHasher.h"
+
+namespace blink {
+
+GlyphIndexPage* GlyphIndexPage::zeroPage()
+{
+    DEFINE_STATIC_REF(GlyphIndexPage, zeroPage, (create()));
+    return zeroPage;
+}
+
+PassRefPtr<GlyphIndexPage> GlyphIndexPage::sharedIfIdentical(PassRefPtr<GlyphIndexPage> passedPage)
+{
+    RefPtr<GlyphIndexPage> page = passedPage;
+    if (page == zeroPage())
+        return page.release();
+
+    typedef HashMap<unsigned, RefPtr<GlyphIndexPage> > GlyphIndexPagePool;
+    DEFINE_STATIC_LOCAL(GlyphIndexPagePool, pool, ());
+
+    // Keep the hash clear of the hash table's empty and deleted sentinels.
+    unsigned hash = StringHasher::hashMemory(page->m_glyphs, sizeof(page->m_glyphs)) & 0x7fffffff;
+    if (!hash)
+        hash = 1;
+
+    GlyphIndexPagePool::AddResult result = pool.add(hash, page);
+    if (!result.isNewEntry) {
+        GlyphIndexPage* pooled = result.storedValue->value.get();
+        // On the rare hash collision between different contents, keep the
+        // pooled table and give up on sharing this one.
+        if (memcmp(pooled->m_glyphs, page->m_glyphs, sizeof(page->m_glyphs)))
+            return page.release();
+        return pooled;
+    }
+    return page.release();
+}
+
+} // namespace blink
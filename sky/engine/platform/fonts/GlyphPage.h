@@ -56,6 +56,45 @@ struct GlyphData {
     const SimpleFontData* fontData;
 };
 
+// The character-to-glyph-index half of a page, shared copy-on-write between
+// GlyphPages. Glyph indices depend only on the typeface, never on the rendered
+// size, so the SimpleFontData for each size of a face fills an identical
+// table; filled tables are pooled by content so every distinct table is
+// stored only once.
+class PLATFORM_EXPORT GlyphIndexPage : public RefCounted<GlyphIndexPage> {
+public:
+    static const unsigned char sizeBits = 8;
+    static const size_t size = (1 << sizeBits);
+
+    static PassRefPtr<GlyphIndexPage> create()
+    {
+        return adoptRef(new GlyphIndexPage);
+    }
+
+    // The all-zero table every page starts out with. Sharing it means a page
+    // owns no table of its own until a glyph is actually set.
+    static GlyphIndexPage* zeroPage();
+
+    // Returns a pooled table with the same contents, registering this one in
+    // the pool if no identical table is known yet.
+    static PassRefPtr<GlyphIndexPage> sharedIfIdentical(PassRefPtr<GlyphIndexPage>);
+
+    PassRefPtr<GlyphIndexPage> copy() const
+    {
+        RefPtr<GlyphIndexPage> page = create();
+        memcpy(page->m_glyphs, m_glyphs, sizeof(m_glyphs));
+        return page.release();
+    }
+
+    Glyph at(unsigned index) const { return m_glyphs[index]; }
+    void set(unsigned index, Glyph glyph) { m_glyphs[index] = glyph; }
+
+private:
+    GlyphIndexPage() { memset(m_glyphs, 0, sizeof(m_glyphs)); }
+
+    Glyph m_glyphs[size];
+};
+
 // A GlyphPage contains a fixed-size set of GlyphData mappings for a contiguous
 // range of characters in the Unicode code space. GlyphPages are indexed
 // starting from 0 and incrementing for each 256 glyphs.
@@ -81,12 +120,13 @@ public:
     PassRefPtr<GlyphPage> createCopiedSystemFallbackPage(GlyphPageTreeNode* owner) const
     {
         RefPtr<GlyphPage> page = GlyphPage::createForMixedFontData(owner);
-        memcpy(page->m_glyphs, m_glyphs, sizeof(m_glyphs));
+        // The index table is copied lazily, on the first write.
+        page->m_glyphIndexes = m_glyphIndexes;
         if (hasPerGlyphFontData())
             memcpy(page->m_perGlyphFontData, m_perGlyphFontData, sizeof(SimpleFontData*) * GlyphPage::size);
         else {
             for (size_t i = 0; i < GlyphPage::size; ++i) {
-                page->m_perGlyphFontData[i] = m_glyphs[i] ? m_fontDataForAllGlyphs : 0;
+                page->m_perGlyphFontData[i] = m_glyphIndexes->at(i) ? m_fontDataForAllGlyphs : 0;
             }
         }
         page->m_customFontToLoad = m_customFontToLoad;
@@ -95,8 +135,8 @@ public:
 
     ~GlyphPage() { }
 
-    static const unsigned char sizeBits = 8;
-    static const size_t size = (1 << GlyphPage::sizeBits); // Covers Latin-1 in a single page.
+    static const unsigned char sizeBits = GlyphIndexPage::sizeBits;
+    static const size_t size = GlyphIndexPage::size; // Covers Latin-1 in a single page.
     static unsigned indexForCharacter(UChar32 c) { return c & 0xFF; }
 
     ALWAYS_INLINE GlyphData glyphDataForCharacter(UChar32 c) const
@@ -110,7 +150,7 @@ public:
     ALWAYS_INLINE GlyphData glyphDataForIndex(unsigned index) const
     {
         ASSERT_WITH_SECURITY_IMPLICATION(index < size);
-        Glyph glyph = m_glyphs[index];
+        Glyph glyph = m_glyphIndexes->at(index);
         if (hasPerGlyphFontData())
             return GlyphData(glyph, m_perGlyphFontData[index]);
         return GlyphData(glyph, glyph ? m_fontDataForAllGlyphs : 0);
@@ -124,7 +164,7 @@ public:
     ALWAYS_INLINE Glyph glyphAt(unsigned index) const
     {
         ASSERT_WITH_SECURITY_IMPLICATION(index < size);
-        return m_glyphs[index];
+        return m_glyphIndexes->at(index);
     }
 
     void setGlyphDataForCharacter(UChar32 c, Glyph g, const SimpleFontData* f)
@@ -135,7 +175,7 @@ public:
     void setGlyphDataForIndex(unsigned index, Glyph glyph, const SimpleFontData* fontData)
     {
         ASSERT_WITH_SECURITY_IMPLICATION(index < size);
-        m_glyphs[index] = glyph;
+        setGlyphIndex(index, glyph);
         setCustomFontToLoad(index, 0);
 
         if (hasPerGlyphFontData()) {
@@ -174,12 +214,19 @@ public:
         ASSERT(hasPerGlyphFontData());
         for (size_t i = 0; i < size; ++i) {
             if (m_perGlyphFontData[i] == fontData) {
-                m_glyphs[i] = 0;
+                setGlyphIndex(i, 0);
                 m_perGlyphFontData[i] = 0;
             }
         }
     }
 
+    // Hands this page's fully-filled index table to the shared pool, adopting
+    // an existing identical table if another font data already produced one.
+    void shareIdenticalGlyphIndexes()
+    {
+        m_glyphIndexes = GlyphIndexPage::sharedIfIdentical(m_glyphIndexes.release());
+    }
+
     GlyphPageTreeNode* owner() const { return m_owner; }
 
 private:
@@ -187,11 +234,20 @@ private:
         : m_fontDataForAllGlyphs(fontDataForAllGlyphs)
         , m_owner(owner)
     {
-        memset(m_glyphs, 0, sizeof(m_glyphs));
+        m_glyphIndexes = GlyphIndexPage::zeroPage();
         if (hasPerGlyphFontData())
             memset(m_perGlyphFontData, 0, sizeof(SimpleFontData*) * GlyphPage::size);
     }
 
+    void setGlyphIndex(unsigned index, Glyph glyph)
+    {
+        // The index table may be shared (the zero page, a pooled table, or a
+        // copied system fallback page); copy before the first write.
+        if (!m_glyphIndexes->hasOneRef())
+            m_glyphIndexes = m_glyphIndexes->copy();
+        m_glyphIndexes->set(index, glyph);
+    }
+
     bool hasPerGlyphFontData() const { return !m_fontDataForAllGlyphs; }
 
     class CustomDataPage : public RefCounted<CustomDataPage> {
@@ -207,7 +263,7 @@ private:
     const SimpleFontData* m_fontDataForAllGlyphs;
     GlyphPageTreeNode* m_owner;
     RefPtr<CustomDataPage> m_customFontToLoad;
-    Glyph m_glyphs[size];
+    RefPtr<GlyphIndexPage> m_glyphIndexes;
 
     // NOTE: This array has (GlyphPage::size) elements if m_fontDataForAllGlyphs is null.
     const SimpleFontData* m_perGlyphFontData[0];
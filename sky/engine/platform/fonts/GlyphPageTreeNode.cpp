@@ -229,8 +229,13 @@ void GlyphPageTreeNode::initializePage(const FontData* fontData, unsigned pageNu
                 }
             }
 
-            if (!haveGlyphs)
+            if (!haveGlyphs) {
                 m_page = nullptr;
+            } else if (!fontData->isSegmented()) {
+                // Every size of a typeface fills an identical index table;
+                // keep one copy shared across all of them.
+                m_page->shareIdenticalGlyphIndexes();
+            }
         } else if (parentPage && parentPage->owner() != m_parent) {
             // The page we're overriding may not be owned by our parent node.
             // This happens when our parent node provides no useful overrides
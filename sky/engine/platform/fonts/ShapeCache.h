@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1.  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SKY_ENGINE_PLATFORM_FONTS_SHAPECACHE_H_
+#define SKY_ENGINE_PLATFORM_FONTS_SHAPECACHE_H_
+
+#include "flutter/sky/engine/platform/fonts/GlyphBuffer.h"
+#include "flutter/sky/engine/platform/fonts/SmallStringKey.h"
+#include "flutter/sky/engine/platform/text/TextRun.h"
+#include "flutter/sky/engine/wtf/HashMap.h"
+#include "flutter/sky/engine/wtf/Vector.h"
+
+namespace blink {
+
+// The positioned-glyph output of the complex path shaper for one short run,
+// ready to be replayed into a GlyphBuffer without invoking HarfBuzz again.
+struct ShapeCacheEntry {
+    ShapeCacheEntry()
+        : shaped(false)
+    {
+    }
+
+    bool isShaped() const { return shaped; }
+
+    void set(const GlyphBuffer& glyphBuffer)
+    {
+        shaped = true;
+        unsigned count = glyphBuffer.size();
+        bool hasOffsets = glyphBuffer.hasOffsets();
+        fontData.reserveInitialCapacity(count);
+        glyphs.reserveInitialCapacity(count);
+        advances.reserveInitialCapacity(count);
+        if (hasOffsets)
+            offsets.reserveInitialCapacity(count);
+        for (unsigned i = 0; i < count; ++i) {
+            fontData.uncheckedAppend(glyphBuffer.fontDataAt(i));
+            glyphs.uncheckedAppend(glyphBuffer.glyphAt(i));
+            advances.uncheckedAppend(glyphBuffer.advanceAt(i));
+            if (hasOffsets)
+                offsets.uncheckedAppend(glyphBuffer.offsets(0)[i]);
+        }
+    }
+
+    void replay(GlyphBuffer& glyphBuffer) const
+    {
+        ASSERT(shaped);
+        unsigned count = glyphs.size();
+        bool hasOffsets = !offsets.isEmpty();
+        for (unsigned i = 0; i < count; ++i) {
+            if (hasOffsets)
+                glyphBuffer.add(glyphs[i], fontData[i], offsets[i], advances[i]);
+            else
+                glyphBuffer.add(glyphs[i], fontData[i], advances[i]);
+        }
+    }
+
+    size_t byteSize() const
+    {
+        return sizeof(ShapeCacheEntry)
+            + glyphs.size() * (sizeof(const SimpleFontData*) + sizeof(Glyph) + sizeof(float))
+            + offsets.size() * sizeof(FloatSize);
+    }
+
+    bool shaped;
+    Vector<const SimpleFontData*> fontData;
+    Vector<Glyph> glyphs;
+    Vector<float> advances;
+    Vector<FloatSize> offsets;
+};
+
+// Caches shaped runs keyed by their characters and direction so that typical
+// paragraphs, which repeat most of their words, only pay for HarfBuzz on
+// novel words. The font description is part of the key implicitly: the cache
+// hangs off a FontFallbackList, which is invalidated whenever the font
+// changes.
+class ShapeCache {
+public:
+    ShapeCache()
+        : m_bytes(0)
+    {
+    }
+
+    // Returns the entry for this run, creating an unshaped one on first
+    // sight, or 0 if the run is too long to be used as a key.
+    ShapeCacheEntry* add(const TextRun& run)
+    {
+        if (static_cast<unsigned>(run.length()) > SmallStringKey::capacity())
+            return 0;
+
+        SmallStringKey key;
+        if (run.is8Bit())
+            key = SmallStringKey(run.characters8(), run.length());
+        else
+            key = SmallStringKey(run.characters16(), run.length());
+
+        Map::AddResult addResult = m_map[run.rtl()].add(key, ShapeCacheEntry());
+        return &addResult.storedValue->value;
+    }
+
+    // Called after a miss entry has been populated, to keep the cache within
+    // its byte budget. May invalidate outstanding entry pointers.
+    void didShape(const ShapeCacheEntry& entry)
+    {
+        m_bytes += entry.byteSize();
+        if (m_bytes <= s_maxBytes)
+            return;
+        // No need for precise eviction: this only bounds pathological growth,
+        // and the working set rebuilds within a paragraph or two.
+        clear();
+    }
+
+    void clear()
+    {
+        m_map[0].clear();
+        m_map[1].clear();
+        m_bytes = 0;
+    }
+
+private:
+    typedef HashMap<SmallStringKey, ShapeCacheEntry, SmallStringKeyHash, SmallStringKeyHashTraits> Map;
+
+    // Bounds the positioned-glyph payloads, not the hash table backing store.
+    static const size_t s_maxBytes = 2 * 1024 * 1024;
+
+    size_t m_bytes;
+    Map m_map[2]; // Indexed by rtl().
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_FONTS_SHAPECACHE_H_
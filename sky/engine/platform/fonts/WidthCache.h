@@ -26,6 +26,7 @@
 #ifndef SKY_ENGINE_PLATFORM_FONTS_WIDTHCACHE_H_
 #define SKY_ENGINE_PLATFORM_FONTS_WIDTHCACHE_H_
 
+#include "flutter/sky/engine/platform/fonts/SmallStringKey.h"
 #include "flutter/sky/engine/platform/geometry/IntRectExtent.h"
 #include "flutter/sky/engine/platform/text/TextRun.h"
 #include "flutter/sky/engine/wtf/Forward.h"
@@ -40,87 +41,17 @@ struct WidthCacheEntry {
     WidthCacheEntry()
     {
         width = std::numeric_limits<float>::quiet_NaN();
+        hasGlyphBounds = false;
     }
     bool isValid() const { return !std::isnan(width); }
     float width;
+    // The simple code path only computes glyph bounds on demand, so an entry
+    // may hold a valid width without valid bounds.
+    bool hasGlyphBounds;
     IntRectExtent glyphBounds;
 };
 
 class WidthCache {
-private:
-    // Used to optimize small strings as hash table keys. Avoids malloc'ing an out-of-line StringImpl.
-    class SmallStringKey {
-    public:
-        static unsigned capacity() { return s_capacity; }
-
-        SmallStringKey()
-            : m_length(s_emptyValueLength)
-        {
-        }
-
-        SmallStringKey(WTF::HashTableDeletedValueType)
-            : m_length(s_deletedValueLength)
-        {
-        }
-
-        template<typename CharacterType> SmallStringKey(CharacterType* characters, unsigned short length)
-            : m_length(length)
-        {
-            ASSERT(length <= s_capacity);
-
-            StringHasher hasher;
-
-            bool remainder = length & 1;
-            length >>= 1;
-
-            unsigned i = 0;
-            while (length--) {
-                m_characters[i] = characters[i];
-                m_characters[i + 1] = characters[i + 1];
-                hasher.addCharactersAssumingAligned(characters[i], characters[i + 1]);
-                i += 2;
-            }
-
-            if (remainder) {
-                m_characters[i] = characters[i];
-                hasher.addCharacter(characters[i]);
-            }
-
-            m_hash = hasher.hash();
-        }
-
-        const UChar* characters() const { return m_characters; }
-        unsigned short length() const { return m_length; }
-        unsigned hash() const { return m_hash; }
-
-        bool isHashTableDeletedValue() const { return m_length == s_deletedValueLength; }
-        bool isHashTableEmptyValue() const { return m_length == s_emptyValueLength; }
-
-    private:
-        static const unsigned s_capacity = 15;
-        static const unsigned s_emptyValueLength = s_capacity + 1;
-        static const unsigned s_deletedValueLength = s_capacity + 2;
-
-        unsigned m_hash;
-        unsigned short m_length;
-        UChar m_characters[s_capacity];
-    };
-
-    struct SmallStringKeyHash {
-        static unsigned hash(const SmallStringKey& key) { return key.hash(); }
-        static bool equal(const SmallStringKey& a, const SmallStringKey& b) { return a == b; }
-        static const bool safeToCompareToEmptyOrDeleted = true; // Empty and deleted values have lengths that are not equal to any valid length.
-    };
-
-    struct SmallStringKeyHashTraits : WTF::SimpleClassHashTraits<SmallStringKey> {
-        static const bool hasIsEmptyValueFunction = true;
-        static bool isEmptyValue(const SmallStringKey& key) { return key.isHashTableEmptyValue(); }
-        static const bool needsDestruction = false;
-        static const unsigned minimumTableSize = 16;
-    };
-
-    friend bool operator==(const SmallStringKey&, const SmallStringKey&);
-
 public:
     WidthCache()
         : m_interval(s_maxInterval)
@@ -201,13 +132,6 @@ private:
     Map m_map;
 };
 
-inline bool operator==(const WidthCache::SmallStringKey& a, const WidthCache::SmallStringKey& b)
-{
-    if (a.length() != b.length())
-        return false;
-    return WTF::equal(a.characters(), b.characters(), a.length());
-}
-
 } // namespace blink
 
 #endif  // SKY_ENGINE_PLATFORM_FONTS_WIDTHCACHE_H_
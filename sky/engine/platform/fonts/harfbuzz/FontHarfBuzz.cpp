@@ -171,11 +171,13 @@ void Font::drawGlyphs(GraphicsContext* gc, const SimpleFontData* font,
     if (!glyphBuffer.hasOffsets()) {
         SkAutoSTMalloc<64, SkScalar> storage(numGlyphs);
         SkScalar* xpos = storage.get();
-        const float* adv = glyphBuffer.advances(from);
-        for (unsigned i = 0; i < numGlyphs; i++) {
-            xpos[i] = x;
-            x += SkFloatToScalar(adv[i]);
-        }
+        // The buffer's positions are prefix sums computed when it was
+        // filled, so each x is a constant offset rather than a summation
+        // carried across the loop.
+        const float* positions = glyphBuffer.positions(from);
+        const float segmentStart = positions[0];
+        for (unsigned i = 0; i < numGlyphs; i++)
+            xpos[i] = x + SkFloatToScalar(positions[i] - segmentStart);
         const Glyph* glyphs = glyphBuffer.glyphs(from);
         paintGlyphsHorizontal(gc, font, glyphs, numGlyphs, xpos, SkFloatToScalar(y), textRect);
         return;
@@ -190,13 +192,12 @@ void Font::drawGlyphs(GraphicsContext* gc, const SimpleFontData* font,
     SkAutoSTMalloc<32, SkPoint> storage(numGlyphs);
     SkPoint* pos = storage.get();
     const FloatSize* offsets = glyphBuffer.offsets(from);
-    const float* advances = glyphBuffer.advances(from);
-    SkScalar advanceSoFar = SkFloatToScalar(0);
+    const float* positions = glyphBuffer.positions(from);
+    const float segmentStart = positions[0];
     for (unsigned i = 0; i < numGlyphs; i++) {
         pos[i].set(
-            x + SkFloatToScalar(offsets[i].width()) + advanceSoFar,
+            x + SkFloatToScalar(offsets[i].width() + positions[i] - segmentStart),
             y + SkFloatToScalar(offsets[i].height()));
-        advanceSoFar += SkFloatToScalar(advances[i]);
     }
 
     const Glyph* glyphs = glyphBuffer.glyphs(from);
@@ -293,17 +294,19 @@ bool buildTextBlobInternal(const GlyphBuffer& glyphBuffer, SkScalar initialAdvan
         const uint16_t* glyphs = glyphBuffer.glyphs(start);
         std::copy(glyphs, glyphs + count, buffer.glyphs);
 
-        const float* advances = glyphBuffer.advances(start);
+        // The buffer's prefix-summed positions drop straight into the
+        // builder's parallel position array; x only carries the initial
+        // advance, so there is no loop-carried summation.
+        const float* positions = glyphBuffer.positions(start);
         const FloatSize* offsets = glyphBuffer.offsets(start);
         for (unsigned j = 0; j < count; j++) {
             if (hasOffsets) {
                 const FloatSize& offset = offsets[j];
-                buffer.pos[2 * j] = x + offset.width();
+                buffer.pos[2 * j] = x + SkFloatToScalar(positions[j]) + offset.width();
                 buffer.pos[2 * j + 1] = offset.height();
             } else {
-                buffer.pos[j] = x;
+                buffer.pos[j] = x + SkFloatToScalar(positions[j]);
             }
-            x += SkFloatToScalar(advances[j]);
         }
     }
     return true;
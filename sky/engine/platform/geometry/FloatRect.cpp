@@ -154,15 +154,34 @@ void FloatRect::scale(float sx, float sy)
     m_size.setHeight(height() * sy);
 }
 
-FloatRect unionRect(const Vector<FloatRect>& rects)
+FloatRect unionRect(const FloatRect* rects, size_t count)
 {
-    FloatRect result;
+    // Empty rects do not contribute, matching unite().
+    size_t i = 0;
+    while (i < count && rects[i].isEmpty())
+        ++i;
+    if (i == count)
+        return FloatRect();
 
-    size_t count = rects.size();
-    for (size_t i = 0; i < count; ++i)
-        result.unite(rects[i]);
+    float minX = rects[i].x();
+    float minY = rects[i].y();
+    float maxX = rects[i].maxX();
+    float maxY = rects[i].maxY();
+    for (++i; i < count; ++i) {
+        const FloatRect& rect = rects[i];
+        if (rect.isEmpty())
+            continue;
+        minX = std::min(minX, rect.x());
+        minY = std::min(minY, rect.y());
+        maxX = std::max(maxX, rect.maxX());
+        maxY = std::max(maxY, rect.maxY());
+    }
+    return FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
 
-    return result;
+FloatRect unionRect(const Vector<FloatRect>& rects)
+{
+    return unionRect(rects.data(), rects.size());
 }
 
 void FloatRect::fitToPoints(const FloatPoint& p0, const FloatPoint& p1)
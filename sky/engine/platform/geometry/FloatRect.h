@@ -183,6 +183,10 @@ inline FloatRect unionRect(const FloatRect& a, const FloatRect& b)
 
 FloatRect unionRect(const Vector<FloatRect>&);
 
+// Batch kernel over a contiguous span of rects: one pass accumulating the
+// four edges, building the result rect only at the end.
+FloatRect unionRect(const FloatRect*, size_t count);
+
 inline FloatRect& operator+=(FloatRect& a, const FloatRect& b)
 {
     a.move(b.x(), b.y());
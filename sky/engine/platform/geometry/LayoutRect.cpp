@@ -128,15 +128,34 @@ void LayoutRect::show(bool showRawValue) const
 }
 #endif
 
-LayoutRect unionRect(const Vector<LayoutRect>& rects)
+LayoutRect unionRect(const LayoutRect* rects, size_t count)
 {
-    LayoutRect result;
-
-    size_t count = rects.size();
-    for (size_t i = 0; i < count; ++i)
-        result.unite(rects[i]);
+    // Empty rects do not contribute, matching unite().
+    size_t i = 0;
+    while (i < count && rects[i].isEmpty())
+        ++i;
+    if (i == count)
+        return LayoutRect();
+
+    LayoutUnit minX = rects[i].x();
+    LayoutUnit minY = rects[i].y();
+    LayoutUnit maxX = rects[i].maxX();
+    LayoutUnit maxY = rects[i].maxY();
+    for (++i; i < count; ++i) {
+        const LayoutRect& rect = rects[i];
+        if (rect.isEmpty())
+            continue;
+        minX = std::min(minX, rect.x());
+        minY = std::min(minY, rect.y());
+        maxX = std::max(maxX, rect.maxX());
+        maxY = std::max(maxY, rect.maxY());
+    }
+    return LayoutRect(minX, minY, maxX - minX, maxY - minY);
+}
 
-    return result;
+LayoutRect unionRect(const Vector<LayoutRect>& rects)
+{
+    return unionRect(rects.data(), rects.size());
 }
 
 IntRect enclosingIntRect(const LayoutRect& rect)
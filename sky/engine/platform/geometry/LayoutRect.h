@@ -195,6 +195,11 @@ inline LayoutRect unionRect(const LayoutRect& a, const LayoutRect& b)
 
 PLATFORM_EXPORT LayoutRect unionRect(const Vector<LayoutRect>&);
 
+// Batch kernel over a contiguous span of rects: one pass accumulating the
+// four edges, building the result rect once at the end instead of
+// reconstructing it per element as repeated unite() calls do.
+PLATFORM_EXPORT LayoutRect unionRect(const LayoutRect*, size_t count);
+
 ALWAYS_INLINE bool operator==(const LayoutRect& a, const LayoutRect& b)
 {
     return a.location() == b.location() && a.size() == b.size();
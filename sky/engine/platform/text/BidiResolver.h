@@ -246,6 +246,13 @@ public:
 
     void createBidiRunsForLine(const Iterator& end, VisualDirectionOverride = NoVisualOverride, bool hardLineBreak = false, bool reorderRuns = true);
 
+    // Fast path for lines known ahead of time to resolve to a single run in
+    // the base direction: builds the runs for one line without walking the
+    // Unicode Bidi Algorithm state machine over every character. Only valid
+    // when the caller has verified that neither the characters nor the styles
+    // on the line can introduce a second bidi level.
+    void createRunsForUnidirectionalLine(const Iterator& end, bool hardLineBreak = false);
+
     BidiRunList<Run>& runs() { return m_runs; }
 
     // FIXME: This used to be part of deleteRuns() but was a layering violation.
@@ -1068,6 +1075,15 @@ void BidiResolver<Iterator, Run>::createBidiRunsForLine(const Iterator& end, Vis
         applyL1Rule(m_runs);
 }
 
+template <class Iterator, class Run>
+void BidiResolver<Iterator, Run>::createRunsForUnidirectionalLine(const Iterator& end, bool hardLineBreak)
+{
+    // A generic Iterator gives us no cheaper way to find the last position on
+    // the line than stepping there, so fall back to the full algorithm.
+    // InlineBidiResolver specializes this with a real fast path.
+    createBidiRunsForLine(end, NoVisualOverride, hardLineBreak);
+}
+
 template <class Iterator, class Run>
 void BidiResolver<Iterator, Run>::setMidpointStateForIsolatedRun(Run* run, const MidpointState<Iterator>& midpoint)
 {
@@ -1267,6 +1267,20 @@ TransformationMatrix& TransformationMatrix::multiply(const TransformationMatrix&
 
 void TransformationMatrix::multVecMatrix(double x, double y, double& resultX, double& resultY) const
 {
+#if defined(TRANSFORMATION_MATRIX_USE_X86_64_SSE2)
+    // Two result lanes computed at once. The additions associate exactly as in
+    // the scalar path below, so the results are bit-identical to it.
+    __m128d vx = _mm_set1_pd(x);
+    __m128d vy = _mm_set1_pd(y);
+    __m128d result = _mm_add_pd(_mm_add_pd(_mm_load_pd(&m_matrix[3][0]),
+                                           _mm_mul_pd(vx, _mm_load_pd(&m_matrix[0][0]))),
+                                _mm_mul_pd(vy, _mm_load_pd(&m_matrix[1][0])));
+    double w = m_matrix[3][3] + x * m_matrix[0][3] + y * m_matrix[1][3];
+    if (w != 1 && w != 0)
+        result = _mm_div_pd(result, _mm_set1_pd(w));
+    _mm_store_sd(&resultX, result);
+    _mm_storeh_pd(&resultY, result);
+#else
     resultX = m_matrix[3][0] + x * m_matrix[0][0] + y * m_matrix[1][0];
     resultY = m_matrix[3][1] + x * m_matrix[0][1] + y * m_matrix[1][1];
     double w = m_matrix[3][3] + x * m_matrix[0][3] + y * m_matrix[1][3];
@@ -1274,10 +1288,37 @@ void TransformationMatrix::multVecMatrix(double x, double y, double& resultX, do
         resultX /= w;
         resultY /= w;
     }
+#endif
 }
 
 void TransformationMatrix::multVecMatrix(double x, double y, double z, double& resultX, double& resultY, double& resultZ) const
 {
+#if defined(TRANSFORMATION_MATRIX_USE_X86_64_SSE2)
+    // The four output components (x, y, z and the homogeneous w) are computed
+    // as two lane pairs, associating the additions exactly as the scalar path
+    // below does.
+    __m128d vx = _mm_set1_pd(x);
+    __m128d vy = _mm_set1_pd(y);
+    __m128d vz = _mm_set1_pd(z);
+    __m128d resultXY = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_load_pd(&m_matrix[3][0]),
+                                                        _mm_mul_pd(vx, _mm_load_pd(&m_matrix[0][0]))),
+                                             _mm_mul_pd(vy, _mm_load_pd(&m_matrix[1][0]))),
+                                  _mm_mul_pd(vz, _mm_load_pd(&m_matrix[2][0])));
+    __m128d resultZW = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_load_pd(&m_matrix[3][2]),
+                                                        _mm_mul_pd(vx, _mm_load_pd(&m_matrix[0][2]))),
+                                             _mm_mul_pd(vy, _mm_load_pd(&m_matrix[1][2]))),
+                                  _mm_mul_pd(vz, _mm_load_pd(&m_matrix[2][2])));
+    double w;
+    _mm_storeh_pd(&w, resultZW);
+    if (w != 1 && w != 0) {
+        __m128d vw = _mm_set1_pd(w);
+        resultXY = _mm_div_pd(resultXY, vw);
+        resultZW = _mm_div_pd(resultZW, vw);
+    }
+    _mm_store_sd(&resultX, resultXY);
+    _mm_storeh_pd(&resultY, resultXY);
+    _mm_store_sd(&resultZ, resultZW);
+#else
     resultX = m_matrix[3][0] + x * m_matrix[0][0] + y * m_matrix[1][0] + z * m_matrix[2][0];
     resultY = m_matrix[3][1] + x * m_matrix[0][1] + y * m_matrix[1][1] + z * m_matrix[2][1];
     resultZ = m_matrix[3][2] + x * m_matrix[0][2] + y * m_matrix[1][2] + z * m_matrix[2][2];
@@ -1287,6 +1328,7 @@ void TransformationMatrix::multVecMatrix(double x, double y, double z, double& r
         resultY /= w;
         resultZ /= w;
     }
+#endif
 }
 
 bool TransformationMatrix::isInvertible() const
@@ -24,4 +24,31 @@ TEST(TransformationMatrixTest, NonInvertableBlendTest)
     EXPECT_TRUE(result == to);
 }
 
+TEST(TransformationMatrixTest, MapPointTest)
+{
+    // A matrix that rotates, translates and applies perspective, so mapping
+    // exercises the full homogeneous math including the divide by w.
+    TransformationMatrix transform;
+    transform.applyPerspective(400);
+    transform.translate3d(10, -20, 100);
+    transform.rotate3d(0, 1, 0, 30);
+
+    FloatPoint3D point(50, 60, 0);
+    FloatPoint3D mapped = transform.mapPoint(point);
+
+    // Round-tripping through the inverse should return the original point.
+    ASSERT_TRUE(transform.isInvertible());
+    FloatPoint3D roundTripped = transform.inverse().mapPoint(mapped);
+    EXPECT_NEAR(point.x(), roundTripped.x(), 1e-4);
+    EXPECT_NEAR(point.y(), roundTripped.y(), 1e-4);
+    EXPECT_NEAR(point.z(), roundTripped.z(), 1e-4);
+
+    // A pure translation maps without any of that machinery.
+    TransformationMatrix translation;
+    translation.translate(7, -3);
+    FloatPoint mapped2d = translation.mapPoint(FloatPoint(1, 2));
+    EXPECT_EQ(8, mapped2d.x());
+    EXPECT_EQ(-1, mapped2d.y());
+}
+
 } // namespace
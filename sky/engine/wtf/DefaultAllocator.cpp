@@ -39,6 +39,11 @@ void* DefaultAllocator::backingAllocate(size_t size)
     return partitionAllocGeneric(Partitions::getBufferPartition(), size);
 }
 
+void* DefaultAllocator::backingReallocate(void* address, size_t size)
+{
+    return partitionReallocGeneric(Partitions::getBufferPartition(), address, size);
+}
+
 void DefaultAllocator::backingFree(void* address)
 {
     partitionFreeGeneric(Partitions::getBufferPartition(), address);
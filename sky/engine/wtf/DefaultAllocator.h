@@ -82,6 +82,11 @@ public:
         return reinterpret_cast<Return>(result);
     }
     template <typename Return, typename Metadata>
+    static Return backingRealloc(void* address, size_t size)
+    {
+        return reinterpret_cast<Return>(backingReallocate(address, size));
+    }
+    template <typename Return, typename Metadata>
     static Return malloc(size_t size)
     {
         return reinterpret_cast<Return>(fastMalloc(size));
@@ -154,6 +159,7 @@ public:
 
 private:
     WTF_EXPORT static void* backingAllocate(size_t);
+    WTF_EXPORT static void* backingReallocate(void*, size_t);
 };
 
 // The Windows compiler seems to be very eager to instantiate things it won't
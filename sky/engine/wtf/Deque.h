@@ -34,6 +34,7 @@
 // Deque doesn't actually use Vector.
 
 #include <iterator>
+#include <utility>
 #include "flutter/sky/engine/wtf/PassTraits.h"
 #include "flutter/sky/engine/wtf/Vector.h"
 
@@ -42,9 +43,12 @@ namespace WTF {
     template<typename T, size_t inlineCapacity, typename Allocator> class DequeIterator;
     template<typename T, size_t inlineCapacity, typename Allocator> class DequeConstIterator;
 
+    // The ring capacity is always zero or a power of two so every index
+    // computation is a mask instead of a capacity comparison or a modulo.
     template<typename T, size_t inlineCapacity = 0, typename Allocator = DefaultAllocator>
     class Deque : public VectorDestructorBase<Deque<T, inlineCapacity, Allocator>, T, (inlineCapacity > 0), Allocator::isGarbageCollected> {
         WTF_USE_ALLOCATOR(Deque, Allocator);
+        COMPILE_ASSERT(!(inlineCapacity & (inlineCapacity - 1)), DequeInlineCapacityMustBeAPowerOfTwo);
     public:
         typedef DequeIterator<T, inlineCapacity, Allocator> iterator;
         typedef DequeConstIterator<T, inlineCapacity, Allocator> const_iterator;
@@ -63,7 +67,7 @@ namespace WTF {
         // We hard wire the inlineCapacity to zero here, due to crbug.com/360572
         void swap(Deque<T, 0, Allocator>&);
 
-        size_t size() const { return m_start <= m_end ? m_end - m_start : m_end + m_buffer.capacity() - m_start; }
+        size_t size() const { return (m_end - m_start) & m_indexMask; }
         bool isEmpty() const { return m_start == m_end; }
 
         iterator begin() { return iterator(this, m_start); }
@@ -86,14 +90,12 @@ namespace WTF {
         T& at(size_t i)
         {
             RELEASE_ASSERT(i < size());
-            size_t right = m_buffer.capacity() - m_start;
-            return i < right ? m_buffer.buffer()[m_start + i] : m_buffer.buffer()[i - right];
+            return m_buffer.buffer()[(m_start + i) & m_indexMask];
         }
         const T& at(size_t i) const
         {
             RELEASE_ASSERT(i < size());
-            size_t right = m_buffer.capacity() - m_start;
-            return i < right ? m_buffer.buffer()[m_start + i] : m_buffer.buffer()[i - right];
+            return m_buffer.buffer()[(m_start + i) & m_indexMask];
         }
 
         T& operator[](size_t i) { return at(i); }
@@ -101,6 +103,15 @@ namespace WTF {
 
         template<typename U> void append(const U&);
         template<typename U> void prepend(const U&);
+        // Construct the new element in place from the constructor arguments,
+        // avoiding the temporary that append() and prepend() copy from.
+        template<typename... Args> void emplaceAppend(Args&&...);
+        template<typename... Args> void emplacePrepend(Args&&...);
+        // Moves the first |count| elements into |out| in order, appending
+        // after any existing contents. Releases the vacated slots with at
+        // most two bulk destruct passes and a single start-index update
+        // instead of per-element removeFirst() bookkeeping.
+        void takeFirstN(size_t count, Vector<T, 0, Allocator>& out);
         void removeFirst();
         void removeLast();
         void remove(iterator&);
@@ -123,9 +134,16 @@ namespace WTF {
         void expandCapacityIfNeeded();
         void expandCapacity();
 
+        // The number of buffer slots the ring actually uses. The underlying
+        // allocation may be larger because the allocator quantizes sizes;
+        // the slack past the ring is never touched.
+        size_t ringCapacity() const { return m_indexMask ? m_indexMask + 1 : 0; }
+
         Buffer m_buffer;
         unsigned m_start;
         unsigned m_end;
+        // ringCapacity() - 1; zero for a deque that has never allocated.
+        unsigned m_indexMask;
     };
 
     template<typename T, size_t inlineCapacity, typename Allocator>
@@ -221,21 +239,23 @@ namespace WTF {
     inline Deque<T, inlineCapacity, Allocator>::Deque()
         : m_start(0)
         , m_end(0)
+        , m_indexMask(inlineCapacity ? inlineCapacity - 1 : 0)
     {
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
     inline Deque<T, inlineCapacity, Allocator>::Deque(const Deque<T, inlineCapacity, Allocator>& other)
-        : m_buffer(other.m_buffer.capacity())
+        : m_buffer(other.ringCapacity())
         , m_start(other.m_start)
         , m_end(other.m_end)
+        , m_indexMask(other.m_indexMask)
     {
         const T* otherBuffer = other.m_buffer.buffer();
         if (m_start <= m_end)
             TypeOperations::uninitializedCopy(otherBuffer + m_start, otherBuffer + m_end, m_buffer.buffer() + m_start);
         else {
             TypeOperations::uninitializedCopy(otherBuffer, otherBuffer + m_end, m_buffer.buffer());
-            TypeOperations::uninitializedCopy(otherBuffer + m_start, otherBuffer + m_buffer.capacity(), m_buffer.buffer() + m_start);
+            TypeOperations::uninitializedCopy(otherBuffer + m_start, otherBuffer + ringCapacity(), m_buffer.buffer() + m_start);
         }
     }
 
@@ -254,7 +274,7 @@ namespace WTF {
             TypeOperations::destruct(m_buffer.buffer() + m_start, m_buffer.buffer() + m_end);
         } else {
             TypeOperations::destruct(m_buffer.buffer(), m_buffer.buffer() + m_end);
-            TypeOperations::destruct(m_buffer.buffer() + m_start, m_buffer.buffer() + m_buffer.capacity());
+            TypeOperations::destruct(m_buffer.buffer() + m_start, m_buffer.buffer() + ringCapacity());
         }
     }
 
@@ -279,6 +299,7 @@ namespace WTF {
     {
         std::swap(m_start, other.m_start);
         std::swap(m_end, other.m_end);
+        std::swap(m_indexMask, other.m_indexMask);
         m_buffer.swapVectorBuffer(other.m_buffer);
     }
 
@@ -290,6 +311,7 @@ namespace WTF {
         m_end = 0;
         m_buffer.deallocateBuffer(m_buffer.buffer());
         m_buffer.resetBufferPointer();
+        m_indexMask = inlineCapacity ? inlineCapacity - 1 : 0;
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
@@ -307,13 +329,9 @@ namespace WTF {
     template<typename T, size_t inlineCapacity, typename Allocator>
     inline void Deque<T, inlineCapacity, Allocator>::expandCapacityIfNeeded()
     {
-        if (m_start) {
-            if (m_end + 1 != m_start)
-                return;
-        } else if (m_end) {
-            if (m_end != m_buffer.capacity() - 1)
-                return;
-        } else if (m_buffer.capacity())
+        // One slot is always left empty so that a full ring (m_end just
+        // behind m_start) is distinguishable from an empty one.
+        if (m_indexMask && ((m_end + 1) & m_indexMask) != m_start)
             return;
 
         expandCapacity();
@@ -322,18 +340,22 @@ namespace WTF {
     template<typename T, size_t inlineCapacity, typename Allocator>
     void Deque<T, inlineCapacity, Allocator>::expandCapacity()
     {
-        size_t oldCapacity = m_buffer.capacity();
+        size_t oldRingCapacity = ringCapacity();
         T* oldBuffer = m_buffer.buffer();
-        m_buffer.allocateBuffer(std::max(static_cast<size_t>(16), oldCapacity + oldCapacity / 4 + 1));
+        // Doubling keeps the ring capacity a power of two, which the mask
+        // indexing throughout this class depends on.
+        size_t newRingCapacity = std::max(static_cast<size_t>(16), oldRingCapacity * 2);
+        m_buffer.allocateBuffer(newRingCapacity);
         if (m_start <= m_end)
             TypeOperations::move(oldBuffer + m_start, oldBuffer + m_end, m_buffer.buffer() + m_start);
         else {
             TypeOperations::move(oldBuffer, oldBuffer + m_end, m_buffer.buffer());
-            size_t newStart = m_buffer.capacity() - (oldCapacity - m_start);
-            TypeOperations::move(oldBuffer + m_start, oldBuffer + oldCapacity, m_buffer.buffer() + newStart);
+            size_t newStart = newRingCapacity - (oldRingCapacity - m_start);
+            TypeOperations::move(oldBuffer + m_start, oldBuffer + oldRingCapacity, m_buffer.buffer() + newStart);
             m_start = newStart;
         }
         m_buffer.deallocateBuffer(oldBuffer);
+        m_indexMask = newRingCapacity - 1;
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
@@ -357,42 +379,63 @@ namespace WTF {
     {
         expandCapacityIfNeeded();
         new (NotNull, &m_buffer.buffer()[m_end]) T(value);
-        if (m_end == m_buffer.capacity() - 1)
-            m_end = 0;
-        else
-            ++m_end;
+        m_end = (m_end + 1) & m_indexMask;
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator> template<typename U>
     inline void Deque<T, inlineCapacity, Allocator>::prepend(const U& value)
     {
         expandCapacityIfNeeded();
-        if (!m_start)
-            m_start = m_buffer.capacity() - 1;
-        else
-            --m_start;
+        m_start = (m_start - 1) & m_indexMask;
         new (NotNull, &m_buffer.buffer()[m_start]) T(value);
     }
 
+    template<typename T, size_t inlineCapacity, typename Allocator> template<typename... Args>
+    inline void Deque<T, inlineCapacity, Allocator>::emplaceAppend(Args&&... args)
+    {
+        expandCapacityIfNeeded();
+        new (NotNull, &m_buffer.buffer()[m_end]) T(std::forward<Args>(args)...);
+        m_end = (m_end + 1) & m_indexMask;
+    }
+
+    template<typename T, size_t inlineCapacity, typename Allocator> template<typename... Args>
+    inline void Deque<T, inlineCapacity, Allocator>::emplacePrepend(Args&&... args)
+    {
+        expandCapacityIfNeeded();
+        m_start = (m_start - 1) & m_indexMask;
+        new (NotNull, &m_buffer.buffer()[m_start]) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T, size_t inlineCapacity, typename Allocator>
+    inline void Deque<T, inlineCapacity, Allocator>::takeFirstN(size_t count, Vector<T, 0, Allocator>& out)
+    {
+        RELEASE_ASSERT(count <= size());
+        if (!count)
+            return;
+        T* buffer = m_buffer.buffer();
+        out.reserveCapacity(out.size() + count);
+        for (size_t i = 0; i < count; ++i)
+            out.append(Pass::transfer(buffer[(m_start + i) & m_indexMask]));
+        size_t firstRun = std::min(count, ringCapacity() - m_start);
+        TypeOperations::destruct(buffer + m_start, buffer + m_start + firstRun);
+        if (firstRun < count)
+            TypeOperations::destruct(buffer, buffer + (count - firstRun));
+        m_start = (m_start + count) & m_indexMask;
+    }
+
     template<typename T, size_t inlineCapacity, typename Allocator>
     inline void Deque<T, inlineCapacity, Allocator>::removeFirst()
     {
         ASSERT(!isEmpty());
         TypeOperations::destruct(&m_buffer.buffer()[m_start], &m_buffer.buffer()[m_start + 1]);
-        if (m_start == m_buffer.capacity() - 1)
-            m_start = 0;
-        else
-            ++m_start;
+        m_start = (m_start + 1) & m_indexMask;
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
     inline void Deque<T, inlineCapacity, Allocator>::removeLast()
     {
         ASSERT(!isEmpty());
-        if (!m_end)
-            m_end = m_buffer.capacity() - 1;
-        else
-            --m_end;
+        m_end = (m_end - 1) & m_indexMask;
         TypeOperations::destruct(&m_buffer.buffer()[m_end], &m_buffer.buffer()[m_end + 1]);
     }
 
@@ -420,10 +463,10 @@ namespace WTF {
         // Find which segment of the circular buffer contained the remove element, and only move elements in that part.
         if (position >= m_start) {
             TypeOperations::moveOverlapping(buffer + m_start, buffer + position, buffer + m_start + 1);
-            m_start = (m_start + 1) % m_buffer.capacity();
+            m_start = (m_start + 1) & m_indexMask;
         } else {
             TypeOperations::moveOverlapping(buffer + position + 1, buffer + m_end, buffer + position);
-            m_end = (m_end - 1 + m_buffer.capacity()) % m_buffer.capacity();
+            m_end = (m_end - 1) & m_indexMask;
         }
     }
 
@@ -470,22 +513,16 @@ namespace WTF {
     inline void DequeIteratorBase<T, inlineCapacity, Allocator>::increment()
     {
         ASSERT(m_index != m_deque->m_end);
-        ASSERT(m_deque->m_buffer.capacity());
-        if (m_index == m_deque->m_buffer.capacity() - 1)
-            m_index = 0;
-        else
-            ++m_index;
+        ASSERT(m_deque->ringCapacity());
+        m_index = (m_index + 1) & m_deque->m_indexMask;
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
     inline void DequeIteratorBase<T, inlineCapacity, Allocator>::decrement()
     {
         ASSERT(m_index != m_deque->m_start);
-        ASSERT(m_deque->m_buffer.capacity());
-        if (!m_index)
-            m_index = m_deque->m_buffer.capacity() - 1;
-        else
-            --m_index;
+        ASSERT(m_deque->ringCapacity());
+        m_index = (m_index - 1) & m_deque->m_indexMask;
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
@@ -499,9 +536,7 @@ namespace WTF {
     inline T* DequeIteratorBase<T, inlineCapacity, Allocator>::before() const
     {
         ASSERT(m_index != m_deque->m_start);
-        if (!m_index)
-            return &m_deque->m_buffer.buffer()[m_deque->m_buffer.capacity() - 1];
-        return &m_deque->m_buffer.buffer()[m_index - 1];
+        return &m_deque->m_buffer.buffer()[(m_index - 1) & m_deque->m_indexMask];
     }
 
     template<typename T, size_t inlineCapacity, typename Allocator>
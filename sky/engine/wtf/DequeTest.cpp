@@ -230,6 +230,73 @@ TEST(DequeTest, OwnPtr)
     EXPECT_EQ(count, static_cast<size_t>(destructNumber));
 }
 
+TEST(DequeTest, Emplace)
+{
+    int destructNumber = 0;
+    Deque<DestructCounter> deque;
+    for (int i = 0; i < 20; ++i)
+        deque.emplaceAppend(i, &destructNumber);
+    deque.emplacePrepend(-1, &destructNumber);
+
+    EXPECT_EQ(21u, deque.size());
+    EXPECT_EQ(-1, deque.first().get());
+    EXPECT_EQ(19, deque.last().get());
+    for (size_t i = 0; i < deque.size(); ++i)
+        EXPECT_EQ(static_cast<int>(i) - 1, deque[i].get());
+}
+
+TEST(DequeTest, TakeFirstN)
+{
+    Deque<int> intDeque;
+    // Rotate the ring so the taken range wraps around the buffer end.
+    for (int i = 0; i < 12; ++i)
+        intDeque.append(i);
+    for (int i = 0; i < 12; ++i)
+        intDeque.takeFirst();
+    for (int i = 0; i < 12; ++i)
+        intDeque.append(i);
+
+    Vector<int> taken;
+    intDeque.takeFirstN(0, taken);
+    EXPECT_TRUE(taken.isEmpty());
+
+    intDeque.takeFirstN(8, taken);
+    ASSERT_EQ(8u, taken.size());
+    for (int i = 0; i < 8; ++i)
+        EXPECT_EQ(i, taken[i]);
+    EXPECT_EQ(4u, intDeque.size());
+    EXPECT_EQ(8, intDeque.first());
+
+    intDeque.takeFirstN(intDeque.size(), taken);
+    ASSERT_EQ(12u, taken.size());
+    EXPECT_EQ(11, taken.last());
+    EXPECT_TRUE(intDeque.isEmpty());
+}
+
+TEST(DequeTest, TakeFirstNOwnPtr)
+{
+    int destructNumber = 0;
+    OwnPtrDeque deque;
+    for (int i = 0; i < 6; ++i)
+        deque.append(adoptPtr(new DestructCounter(i, &destructNumber)));
+
+    Vector<OwnPtr<DestructCounter> > taken;
+    deque.takeFirstN(4, taken);
+
+    // Ownership moved out of the deque without destructing any element.
+    EXPECT_EQ(0, destructNumber);
+    ASSERT_EQ(4u, taken.size());
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(i, taken[i]->get());
+    EXPECT_EQ(2u, deque.size());
+    EXPECT_EQ(4, deque.first()->get());
+
+    taken.clear();
+    EXPECT_EQ(4, destructNumber);
+    deque.clear();
+    EXPECT_EQ(6, destructNumber);
+}
+
 // WrappedInt class will fail if it was memmoved or memcpyed.
 static HashSet<void*> constructedWrappedInts;
 class WrappedInt {
@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SKY_ENGINE_WTF_FLATHASHMAP_H_
+#define SKY_ENGINE_WTF_FLATHASHMAP_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+#include "flutter/sky/engine/wtf/Alignment.h"
+#include "flutter/sky/engine/wtf/Assertions.h"
+#include "flutter/sky/engine/wtf/CPU.h"
+#include "flutter/sky/engine/wtf/DefaultAllocator.h"
+#include "flutter/sky/engine/wtf/HashFunctions.h"
+#include "flutter/sky/engine/wtf/Noncopyable.h"
+#include "flutter/sky/engine/wtf/StdLibExtras.h"
+
+#if CPU(X86) || CPU(X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace WTF {
+
+// A flat, open-addressing hash map with a separate metadata byte per slot,
+// probed a 16-byte group at a time (with SSE2 where available). Compared to
+// HashMap it needs no reserved empty or deleted key values, keeps keys and
+// values contiguous, and touches a single cache line of metadata per probe,
+// which makes it a better fit for small POD keys in hot lookup paths.
+//
+// The interface is a subset of HashMap's (add/set/get/contains/remove plus
+// iteration); the hash functor comes from DefaultHash like everywhere else,
+// so call sites can migrate without new traits. Unlike HashMap, iterators
+// are invalidated by any mutation, and the map is not copyable.
+template<typename KeyArg, typename MappedArg,
+    typename HashArg = typename DefaultHash<KeyArg>::Hash,
+    typename AllocatorArg = DefaultAllocator>
+class FlatHashMap {
+    WTF_MAKE_NONCOPYABLE(FlatHashMap);
+public:
+    typedef KeyArg KeyType;
+    typedef MappedArg MappedType;
+    typedef HashArg HashFunctions;
+    typedef AllocatorArg Allocator;
+
+    struct Slot {
+        KeyType key;
+        MappedType value;
+    };
+
+    struct AddResult {
+        Slot* storedValue;
+        bool isNewEntry;
+    };
+
+    FlatHashMap()
+        : m_metadata(0)
+        , m_slots(0)
+        , m_capacity(0)
+        , m_size(0)
+        , m_deleted(0)
+    {
+    }
+
+    ~FlatHashMap()
+    {
+        deallocate();
+    }
+
+    unsigned size() const { return m_size; }
+    unsigned capacity() const { return m_capacity; }
+    bool isEmpty() const { return !m_size; }
+
+    // Inserts only if the key is not present, like HashMap::add.
+    AddResult add(const KeyType& key, const MappedType& mapped)
+    {
+        ensureGrowth();
+        unsigned hash = HashFunctions::hash(key);
+        Slot* slot = findForAdd(key, hash);
+        if (m_metadata[slot - m_slots] >= 0) {
+            // findForAdd only returns a full slot when its key matched.
+            AddResult result = { slot, false };
+            return result;
+        }
+        constructSlot(slot, key, mapped, hash);
+        AddResult result = { slot, true };
+        return result;
+    }
+
+    // Inserts or overwrites, like HashMap::set.
+    AddResult set(const KeyType& key, const MappedType& mapped)
+    {
+        AddResult result = add(key, mapped);
+        if (!result.isNewEntry)
+            result.storedValue->value = mapped;
+        return result;
+    }
+
+    bool contains(const KeyType& key) const
+    {
+        return findSlot(key);
+    }
+
+    // Returns the mapped value, or a default-constructed one when absent,
+    // like HashMap::get.
+    MappedType get(const KeyType& key) const
+    {
+        const Slot* slot = findSlot(key);
+        return slot ? slot->value : MappedType();
+    }
+
+    Slot* find(const KeyType& key) { return const_cast<Slot*>(findSlot(key)); }
+    const Slot* find(const KeyType& key) const { return findSlot(key); }
+
+    bool remove(const KeyType& key)
+    {
+        Slot* slot = const_cast<Slot*>(findSlot(key));
+        if (!slot)
+            return false;
+        slot->~Slot();
+        m_metadata[slot - m_slots] = kDeleted;
+        --m_size;
+        ++m_deleted;
+        return true;
+    }
+
+    void clear()
+    {
+        deallocate();
+        m_metadata = 0;
+        m_slots = 0;
+        m_capacity = 0;
+        m_size = 0;
+        m_deleted = 0;
+    }
+
+    void swap(FlatHashMap& other)
+    {
+        std::swap(m_metadata, other.m_metadata);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_deleted, other.m_deleted);
+    }
+
+    class iterator {
+    public:
+        iterator(const FlatHashMap* map, unsigned index)
+            : m_map(map)
+            , m_index(index)
+        {
+            skipEmptySlots();
+        }
+
+        Slot& operator*() const { return const_cast<Slot&>(m_map->m_slots[m_index]); }
+        Slot* operator->() const { return &**this; }
+
+        iterator& operator++()
+        {
+            ++m_index;
+            skipEmptySlots();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        void skipEmptySlots()
+        {
+            while (m_index < m_map->m_capacity && m_map->m_metadata[m_index] < 0)
+                ++m_index;
+        }
+
+        const FlatHashMap* m_map;
+        unsigned m_index;
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, m_capacity); }
+
+private:
+    // Metadata bytes: negative means not occupied; a full slot stores the
+    // low 7 bits of the key's hash so group probing rejects almost all
+    // non-matching slots without touching the slot array.
+    static const int8_t kEmpty = -128;
+    static const int8_t kDeleted = -2;
+    static const unsigned kGroupWidth = 16;
+    static const unsigned kMinimumCapacity = 16;
+
+    static int8_t h2(unsigned hash) { return static_cast<int8_t>(hash & 0x7f); }
+    static unsigned h1(unsigned hash) { return hash >> 7; }
+
+    // Bit mask of positions within the group whose metadata equals value.
+    static unsigned matchInGroup(const int8_t* group, int8_t value)
+    {
+#if CPU(X86) || CPU(X86_64)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)));
+#else
+        unsigned mask = 0;
+        for (unsigned i = 0; i < kGroupWidth; ++i) {
+            if (group[i] == value)
+                mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    static unsigned lowestBitSet(unsigned mask)
+    {
+#if COMPILER(GCC)
+        return __builtin_ctz(mask);
+#else
+        unsigned index = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    const Slot* findSlot(const KeyType& key) const
+    {
+        if (!m_capacity)
+            return 0;
+        unsigned hash = HashFunctions::hash(key);
+        const int8_t matchByte = h2(hash);
+        const unsigned groupMask = (m_capacity / kGroupWidth) - 1;
+        unsigned group = h1(hash) & groupMask;
+        for (unsigned step = 0; ; ++step) {
+            const int8_t* metadata = m_metadata + group * kGroupWidth;
+            unsigned candidates = matchInGroup(metadata, matchByte);
+            while (candidates) {
+                unsigned index = group * kGroupWidth + lowestBitSet(candidates);
+                if (HashFunctions::equal(m_slots[index].key, key))
+                    return &m_slots[index];
+                candidates &= candidates - 1;
+            }
+            if (matchInGroup(metadata, kEmpty))
+                return 0;
+            ASSERT(step <= groupMask);
+            group = (group + step + 1) & groupMask;
+        }
+    }
+
+    // Returns the slot for the key if present, otherwise the first reusable
+    // slot on its probe sequence. Capacity must already be ensured.
+    Slot* findForAdd(const KeyType& key, unsigned hash)
+    {
+        const int8_t matchByte = h2(hash);
+        const unsigned groupMask = (m_capacity / kGroupWidth) - 1;
+        unsigned group = h1(hash) & groupMask;
+        Slot* firstDeleted = 0;
+        for (unsigned step = 0; ; ++step) {
+            const int8_t* metadata = m_metadata + group * kGroupWidth;
+            unsigned candidates = matchInGroup(metadata, matchByte);
+            while (candidates) {
+                unsigned index = group * kGroupWidth + lowestBitSet(candidates);
+                if (HashFunctions::equal(m_slots[index].key, key))
+                    return &m_slots[index];
+                candidates &= candidates - 1;
+            }
+            if (!firstDeleted) {
+                unsigned deleted = matchInGroup(metadata, kDeleted);
+                if (deleted)
+                    firstDeleted = &m_slots[group * kGroupWidth + lowestBitSet(deleted)];
+            }
+            unsigned empties = matchInGroup(metadata, kEmpty);
+            if (empties) {
+                if (firstDeleted)
+                    return firstDeleted;
+                return &m_slots[group * kGroupWidth + lowestBitSet(empties)];
+            }
+            ASSERT(step <= groupMask);
+            group = (group + step + 1) & groupMask;
+        }
+    }
+
+    void constructSlot(Slot* slot, const KeyType& key, const MappedType& mapped, unsigned hash)
+    {
+        unsigned index = slot - m_slots;
+        if (m_metadata[index] == kDeleted)
+            --m_deleted;
+        new (NotNull, slot) Slot();
+        slot->key = key;
+        slot->value = mapped;
+        m_metadata[index] = h2(hash);
+        ++m_size;
+    }
+
+    // Keep the table at most 7/8 full, counting tombstones, so probe
+    // sequences always terminate at an empty slot.
+    void ensureGrowth()
+    {
+        if (!m_capacity) {
+            rehash(kMinimumCapacity);
+            return;
+        }
+        if ((m_size + m_deleted + 1) * 8 > m_capacity * 7)
+            rehash(m_size * 2 >= m_capacity ? m_capacity * 2 : m_capacity);
+    }
+
+    void rehash(unsigned newCapacity)
+    {
+        ASSERT(!(newCapacity % kGroupWidth));
+        int8_t* oldMetadata = m_metadata;
+        Slot* oldSlots = m_slots;
+        unsigned oldCapacity = m_capacity;
+
+        allocate(newCapacity);
+        m_size = 0;
+        m_deleted = 0;
+
+        for (unsigned i = 0; i < oldCapacity; ++i) {
+            if (oldMetadata[i] < 0)
+                continue;
+            unsigned hash = HashFunctions::hash(oldSlots[i].key);
+            Slot* slot = findForAdd(oldSlots[i].key, hash);
+            constructSlot(slot, oldSlots[i].key, oldSlots[i].value, hash);
+            oldSlots[i].~Slot();
+        }
+        if (oldMetadata)
+            Allocator::backingFree(oldMetadata);
+    }
+
+    void allocate(unsigned capacity)
+    {
+        // One buffer: metadata first, slots after it, aligned for Slot.
+        size_t alignmentMask = WTF_ALIGN_OF(Slot) - 1;
+        size_t slotsOffset = (capacity + alignmentMask) & ~alignmentMask;
+        size_t totalSize = slotsOffset + capacity * sizeof(Slot);
+        m_metadata = Allocator::template backingMalloc<int8_t*, Slot>(totalSize);
+        m_slots = reinterpret_cast<Slot*>(reinterpret_cast<char*>(m_metadata) + slotsOffset);
+        m_capacity = capacity;
+        memset(m_metadata, kEmpty, capacity);
+    }
+
+    void deallocate()
+    {
+        if (!m_metadata)
+            return;
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (m_metadata[i] >= 0)
+                m_slots[i].~Slot();
+        }
+        Allocator::backingFree(m_metadata);
+    }
+
+    int8_t* m_metadata;
+    Slot* m_slots;
+    unsigned m_capacity;
+    unsigned m_size;
+    unsigned m_deleted;
+};
+
+} // namespace WTF
+
+using WTF::FlatHashMap;
+
+#endif  // SKY_ENGINE_WTF_FLATHASHMAP_H_
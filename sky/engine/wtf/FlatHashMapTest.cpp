@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include "flutter/sky/engine/wtf/FlatHashMap.h"
+
+namespace {
+
+typedef WTF::FlatHashMap<int, int> IntFlatHashMap;
+
+TEST(FlatHashMapTest, AddGetContains)
+{
+    IntFlatHashMap map;
+    EXPECT_TRUE(map.isEmpty());
+
+    IntFlatHashMap::AddResult result = map.add(1, 10);
+    EXPECT_TRUE(result.isNewEntry);
+    EXPECT_EQ(1u, map.size());
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_EQ(10, map.get(1));
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(0, map.get(2));
+
+    // add does not overwrite an existing entry; set does.
+    result = map.add(1, 20);
+    EXPECT_FALSE(result.isNewEntry);
+    EXPECT_EQ(10, map.get(1));
+    map.set(1, 20);
+    EXPECT_EQ(20, map.get(1));
+}
+
+TEST(FlatHashMapTest, RemoveReusesSlots)
+{
+    IntFlatHashMap map;
+    for (int i = 0; i < 100; ++i)
+        map.add(i, i * 2);
+    EXPECT_EQ(100u, map.size());
+
+    for (int i = 0; i < 100; i += 2)
+        EXPECT_TRUE(map.remove(i));
+    EXPECT_FALSE(map.remove(0));
+    EXPECT_EQ(50u, map.size());
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i % 2 == 1, map.contains(i));
+        if (i % 2 == 1)
+            EXPECT_EQ(i * 2, map.get(i));
+    }
+}
+
+TEST(FlatHashMapTest, GrowthKeepsEntries)
+{
+    IntFlatHashMap map;
+    const int count = 10000;
+    for (int i = 0; i < count; ++i)
+        map.add(i, i + 1);
+    EXPECT_EQ(static_cast<unsigned>(count), map.size());
+    for (int i = 0; i < count; ++i)
+        EXPECT_EQ(i + 1, map.get(i));
+}
+
+TEST(FlatHashMapTest, Iteration)
+{
+    IntFlatHashMap map;
+    int expectedKeySum = 0;
+    for (int i = 0; i < 64; ++i) {
+        map.add(i, -i);
+        expectedKeySum += i;
+    }
+
+    unsigned visited = 0;
+    int keySum = 0;
+    for (IntFlatHashMap::iterator it = map.begin(); it != map.end(); ++it) {
+        ++visited;
+        keySum += it->key;
+        EXPECT_EQ(-it->key, it->value);
+    }
+    EXPECT_EQ(map.size(), visited);
+    EXPECT_EQ(expectedKeySum, keySum);
+}
+
+TEST(FlatHashMapTest, Clear)
+{
+    IntFlatHashMap map;
+    for (int i = 0; i < 32; ++i)
+        map.add(i, i);
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(0));
+    map.add(5, 6);
+    EXPECT_EQ(6, map.get(5));
+}
+
+} // namespace
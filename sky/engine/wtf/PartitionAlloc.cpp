@@ -30,6 +30,8 @@
 
 #include "flutter/sky/engine/wtf/PartitionAlloc.h"
 
+#include "flutter/sky/engine/wtf/ThreadSpecific.h"
+
 #include <string.h>
 
 #ifndef NDEBUG
@@ -59,6 +61,197 @@ bool PartitionRootBase::gInitialized = false;
 PartitionPage PartitionRootBase::gSeedPage;
 PartitionBucket PartitionRootBase::gPagedBucket;
 
+static const size_t kThreadCacheNumBuckets = kGenericNumBucketedOrders * kGenericNumBucketsPerOrder;
+
+struct PartitionThreadCacheEntry {
+    void* freelistHead;
+    size_t count;
+};
+
+// Per-thread cache of free slots for the small buckets of a generic
+// partition. The cached pointers are the application pointers, with the
+// freelist link stored in the first application bytes of the slot; the
+// cookies written at allocation time therefore stay intact while a slot sits
+// in the cache. All members are only touched by the owning thread. The
+// partition lock is taken only to batch-refill a bucket on a miss, to
+// scavenge an over-full bucket, and to return everything when the thread
+// exits.
+struct PartitionThreadCache {
+    PartitionThreadCache()
+        : root(0)
+    {
+        memset(entries, 0, sizeof(entries));
+    }
+
+    ~PartitionThreadCache()
+    {
+        purge();
+    }
+
+    void purge()
+    {
+        if (!root)
+            return;
+        spinLockLock(&root->lock);
+        for (size_t i = 0; i < kThreadCacheNumBuckets; ++i)
+            scavengeLocked(&entries[i], 0);
+        spinLockUnlock(&root->lock);
+    }
+
+    // Returns slots to the partition until no more than targetCount remain
+    // cached. Called with the partition lock held.
+    void scavengeLocked(PartitionThreadCacheEntry* entry, size_t targetCount)
+    {
+        while (entry->count > targetCount) {
+            void* ptr = entry->freelistHead;
+            entry->freelistHead = *static_cast<void**>(ptr);
+            --entry->count;
+            void* slot = partitionCookieFreePointerAdjust(ptr);
+            partitionFreeWithPage(slot, partitionPointerToPage(slot));
+        }
+    }
+
+    PartitionRootGeneric* root;
+    PartitionThreadCacheEntry entries[kThreadCacheNumBuckets];
+};
+
+static ThreadSpecific<PartitionThreadCache>* s_partitionThreadCache = 0;
+
+static PartitionThreadCache* partitionThreadCacheIfAvailable(PartitionRootGeneric* root)
+{
+    if (UNLIKELY(!s_partitionThreadCache))
+        return 0;
+    PartitionThreadCache* cache = *s_partitionThreadCache;
+    if (UNLIKELY(cache->root != root)) {
+        // The cache is bound to the first generic partition that uses it on
+        // this thread; other partitions take the locked path.
+        if (cache->root)
+            return 0;
+        cache->root = root;
+    }
+    return cache;
+}
+
+void* partitionThreadCacheAlloc(PartitionRootGeneric* root, int flags, size_t size, PartitionBucket* bucket)
+{
+    ASSERT(partitionBucketIsThreadCacheable(bucket));
+    PartitionThreadCache* cache = partitionThreadCacheIfAvailable(root);
+    if (UNLIKELY(!cache)) {
+        spinLockLock(&root->lock);
+        void* ret = partitionBucketAlloc(root, flags, size, bucket);
+        spinLockUnlock(&root->lock);
+        return ret;
+    }
+
+    size_t index = bucket - root->buckets;
+    ASSERT(index < kThreadCacheNumBuckets);
+    PartitionThreadCacheEntry* entry = &cache->entries[index];
+    void* ret = entry->freelistHead;
+    if (LIKELY(ret != 0)) {
+        entry->freelistHead = *static_cast<void**>(ret);
+        --entry->count;
+#if ENABLE(ASSERT)
+        // The cookies from the original allocation are still in place; only
+        // the application bytes need the uninitialized pattern again.
+        memset(ret, kUninitializedByte, bucket->slotSize - 2 * kCookieSize);
+#endif
+        return ret;
+    }
+
+    // Miss: refill a small batch under a single lock hold so the following
+    // allocations of this size class need not take the lock at all.
+    spinLockLock(&root->lock);
+    ret = partitionBucketAlloc(root, flags, size, bucket);
+    if (LIKELY(ret != 0)) {
+        for (size_t i = 1; i < kThreadCacheBatchFill; ++i) {
+            void* extra = partitionBucketAlloc(root, flags | PartitionAllocReturnNull, size, bucket);
+            if (UNLIKELY(!extra))
+                break;
+            *static_cast<void**>(extra) = entry->freelistHead;
+            entry->freelistHead = extra;
+            ++entry->count;
+        }
+    }
+    spinLockUnlock(&root->lock);
+    return ret;
+}
+
+bool partitionThreadCacheFree(PartitionRootGeneric* root, void* ptr, PartitionPage* page)
+{
+    ASSERT(partitionBucketIsThreadCacheable(page->bucket));
+    PartitionThreadCache* cache = partitionThreadCacheIfAvailable(root);
+    if (UNLIKELY(!cache))
+        return false;
+
+    size_t index = page->bucket - root->buckets;
+    ASSERT(index < kThreadCacheNumBuckets);
+    PartitionThreadCacheEntry* entry = &cache->entries[index];
+    RELEASE_ASSERT(ptr != entry->freelistHead); // Catches an immediate double free.
+#if ENABLE(ASSERT)
+    size_t slotSize = page->bucket->slotSize;
+    void* slot = partitionCookieFreePointerAdjust(ptr);
+    partitionCookieCheckValue(slot);
+    partitionCookieCheckValue(static_cast<char*>(slot) + slotSize - kCookieSize);
+    memset(ptr, kFreedByte, slotSize - 2 * kCookieSize);
+#endif
+    *static_cast<void**>(ptr) = entry->freelistHead;
+    entry->freelistHead = ptr;
+    ++entry->count;
+
+    if (UNLIKELY(entry->count > kThreadCacheBucketLimit)) {
+        // Scavenge half of the bucket back so a thread that frees many
+        // objects of one size does not hold the memory indefinitely.
+        spinLockLock(&root->lock);
+        cache->scavengeLocked(entry, kThreadCacheBucketLimit / 2);
+        spinLockUnlock(&root->lock);
+    }
+    return true;
+}
+
+void partitionThreadCachePurge()
+{
+    if (UNLIKELY(!s_partitionThreadCache) || !s_partitionThreadCache->isSet())
+        return;
+    PartitionThreadCache* cache = *s_partitionThreadCache;
+    cache->purge();
+}
+
+void partitionGetStats(PartitionRootGeneric* root, PartitionAllocStats* stats)
+{
+    spinLockLock(&root->lock);
+    stats->totalCommittedBytes = root->totalSizeOfCommittedPages;
+    stats->totalAllocatedBytes = root->totalSizeOfAllocatedBytes;
+    stats->totalAllocationCount = root->totalAllocationCount;
+    stats->totalFreeCount = root->totalFreeCount;
+    spinLockUnlock(&root->lock);
+}
+
+size_t gPartitionAllocSampleInterval = 0;
+static PartitionAllocationSampleHook gPartitionAllocSampleHook = 0;
+static size_t gPartitionAllocSampleCountdown = 0;
+
+void partitionSetAllocationSampleHook(PartitionAllocationSampleHook hook, size_t interval)
+{
+    ASSERT(!interval || hook);
+    gPartitionAllocSampleHook = hook;
+    gPartitionAllocSampleCountdown = interval;
+    // Publish the interval last; the allocation fast path only checks this
+    // one word.
+    gPartitionAllocSampleInterval = interval;
+}
+
+void partitionSampleAllocation(void* ptr, size_t size)
+{
+    // The countdown is deliberately not atomic: a race merely shifts which
+    // allocation gets sampled.
+    if (LIKELY(--gPartitionAllocSampleCountdown != 0))
+        return;
+    gPartitionAllocSampleCountdown = gPartitionAllocSampleInterval;
+    PartitionAllocationSampleHook hook = gPartitionAllocSampleHook;
+    if (LIKELY(hook != 0))
+        hook(ptr, partitionCookieSizeAdjustSubtract(size));
+}
+
 static size_t partitionBucketNumSystemPages(size_t size)
 {
     // This works out reasonably for the current bucket sizes of the generic
@@ -113,6 +306,9 @@ static void parititonAllocBaseInit(PartitionRootBase* root)
     root->initialized = true;
     root->totalSizeOfCommittedPages = 0;
     root->totalSizeOfSuperPages = 0;
+    root->totalSizeOfAllocatedBytes = 0;
+    root->totalAllocationCount = 0;
+    root->totalFreeCount = 0;
     root->nextSuperPage = 0;
     root->nextPartitionPage = 0;
     root->nextPartitionPageEnd = 0;
@@ -157,6 +353,11 @@ void partitionAllocGenericInit(PartitionRootGeneric* root)
 
     root->lock = 0;
 
+    // Create the thread cache TLS key on first partition creation. Threads
+    // build their caches lazily on first allocation.
+    if (!s_partitionThreadCache)
+        s_partitionThreadCache = new ThreadSpecific<PartitionThreadCache>;
+
     // Precalculate some shift and mask constants used in the hot path.
     // Example: malloc(41) == 101001 binary.
     // Order is 6 (1 << 6-1)==32 is highest bit set.
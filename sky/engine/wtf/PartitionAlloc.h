@@ -198,6 +198,16 @@ static const uint32_t kCookieValue = 0xDEADBEEFu;
 static const size_t kCookieSize = 16; // Handles alignment up to XMM instructions on Intel.
 #endif
 
+// Constants for the per-thread cache of small-bucket free slots that sits in
+// front of the generic partition lock. Allocations up to
+// kThreadCacheMaxCachedSize bytes are served from the cache; a miss refills
+// kThreadCacheBatchFill slots under a single lock hold, and a bucket that
+// accumulates more than kThreadCacheBucketLimit slots is scavenged back to
+// the partition.
+static const size_t kThreadCacheMaxCachedSize = 512;
+static const size_t kThreadCacheBatchFill = 8;
+static const size_t kThreadCacheBucketLimit = 128;
+
 struct PartitionBucket;
 struct PartitionRootBase;
 
@@ -256,6 +266,11 @@ struct PartitionSuperPageExtentEntry {
 struct WTF_EXPORT PartitionRootBase {
     size_t totalSizeOfCommittedPages;
     size_t totalSizeOfSuperPages;
+    // Telemetry counters, maintained under the same synchronization as the
+    // rest of the root. Slots sitting in thread caches count as allocated.
+    size_t totalSizeOfAllocatedBytes;
+    size_t totalAllocationCount;
+    size_t totalFreeCount;
     unsigned numBuckets;
     unsigned maxAllocation;
     bool initialized;
@@ -309,6 +324,34 @@ WTF_EXPORT NEVER_INLINE void* partitionAllocSlowPath(PartitionRootBase*, int, si
 WTF_EXPORT NEVER_INLINE void partitionFreeSlowPath(PartitionPage*);
 WTF_EXPORT NEVER_INLINE void* partitionReallocGeneric(PartitionRootGeneric*, void*, size_t);
 
+WTF_EXPORT void* partitionThreadCacheAlloc(PartitionRootGeneric*, int flags, size_t size, PartitionBucket*);
+WTF_EXPORT bool partitionThreadCacheFree(PartitionRootGeneric*, void* ptr, PartitionPage*);
+// Returns every slot cached by the calling thread to its partition.
+WTF_EXPORT void partitionThreadCachePurge();
+
+// A snapshot of a partition's telemetry counters, taken under the partition
+// lock by partitionGetStats().
+struct PartitionAllocStats {
+    size_t totalCommittedBytes; // System pages currently committed.
+    size_t totalAllocatedBytes; // Bytes in slots handed out, including slots in thread caches.
+    size_t totalAllocationCount; // Cumulative number of allocations.
+    size_t totalFreeCount; // Cumulative number of frees.
+};
+
+WTF_EXPORT void partitionGetStats(PartitionRootGeneric*, PartitionAllocStats*);
+
+// Called with the application address and size for every sampled allocation
+// from a generic partition, outside the partition lock. The hook must not
+// allocate from the sampled partition.
+typedef void (*PartitionAllocationSampleHook)(void* address, size_t size);
+
+// Samples roughly every interval-th allocation; an interval of 0 disables
+// sampling. The countdown is racy across threads, which only perturbs which
+// allocations get sampled.
+WTF_EXPORT void partitionSetAllocationSampleHook(PartitionAllocationSampleHook, size_t interval);
+WTF_EXPORT extern size_t gPartitionAllocSampleInterval;
+WTF_EXPORT void partitionSampleAllocation(void*, size_t);
+
 #ifndef NDEBUG
 WTF_EXPORT void partitionDumpStats(const PartitionRoot&);
 #endif
@@ -450,8 +493,16 @@ ALWAYS_INLINE void* partitionBucketAlloc(PartitionRootBase* root, int flags, siz
         page->freelistHead = newHead;
         ASSERT(!ret || partitionPointerIsValid(ret));
         page->numAllocatedSlots++;
+        root->totalSizeOfAllocatedBytes += bucket->slotSize;
+        ++root->totalAllocationCount;
     } else {
         ret = partitionAllocSlowPath(root, flags, size, bucket);
+        if (LIKELY(ret != 0)) {
+            // The slow path may have satisfied the allocation from a
+            // different (e.g. direct mapped) bucket.
+            root->totalSizeOfAllocatedBytes += partitionPointerToPage(ret)->bucket->slotSize;
+            ++root->totalAllocationCount;
+        }
     }
 #if ENABLE(ASSERT)
     if (!ret)
@@ -494,6 +545,9 @@ ALWAYS_INLINE void partitionFreeWithPage(void* ptr, PartitionPage* page)
     partitionCookieCheckValue(reinterpret_cast<char*>(ptr) + bucketSize - kCookieSize);
     memset(ptr, kFreedByte, bucketSize);
 #endif
+    PartitionRootBase* root = partitionPageToRoot(page);
+    root->totalSizeOfAllocatedBytes -= page->bucket->slotSize;
+    ++root->totalFreeCount;
     ASSERT(page->numAllocatedSlots);
     PartitionFreelistEntry* freelistHead = page->freelistHead;
     ASSERT(!freelistHead || partitionPointerIsValid(freelistHead));
@@ -519,6 +573,22 @@ ALWAYS_INLINE void partitionFree(void* ptr)
 #endif
 }
 
+ALWAYS_INLINE bool partitionBucketIsDirectMapped(PartitionBucket* bucket)
+{
+    return !bucket->numSystemPagesPerSlotSpan;
+}
+
+ALWAYS_INLINE bool partitionBucketIsThreadCacheable(PartitionBucket* bucket)
+{
+    size_t slotSize = bucket->slotSize;
+    // The cached freelist pointer lives in the application bytes of the
+    // slot, which excludes the cookies in debug builds, so the slot must
+    // have room for it.
+    return slotSize && slotSize <= kThreadCacheMaxCachedSize
+        && partitionCookieSizeAdjustSubtract(slotSize) >= sizeof(void*)
+        && !partitionBucketIsDirectMapped(bucket);
+}
+
 ALWAYS_INLINE PartitionBucket* partitionGenericSizeToBucket(PartitionRootGeneric* root, size_t size)
 {
     size_t order = kBitsPerSizet - countLeadingZerosSizet(size);
@@ -542,9 +612,16 @@ ALWAYS_INLINE void* partitionAllocGenericFlags(PartitionRootGeneric* root, int f
     ASSERT(root->initialized);
     size = partitionCookieSizeAdjustAdd(size);
     PartitionBucket* bucket = partitionGenericSizeToBucket(root, size);
-    spinLockLock(&root->lock);
-    void* ret = partitionBucketAlloc(root, flags, size, bucket);
-    spinLockUnlock(&root->lock);
+    void* ret;
+    if (LIKELY(partitionBucketIsThreadCacheable(bucket))) {
+        ret = partitionThreadCacheAlloc(root, flags, size, bucket);
+    } else {
+        spinLockLock(&root->lock);
+        ret = partitionBucketAlloc(root, flags, size, bucket);
+        spinLockUnlock(&root->lock);
+    }
+    if (UNLIKELY(gPartitionAllocSampleInterval != 0) && LIKELY(ret != 0))
+        partitionSampleAllocation(ret, size);
     return ret;
 #endif
 }
@@ -564,20 +641,17 @@ ALWAYS_INLINE void partitionFreeGeneric(PartitionRootGeneric* root, void* ptr)
     if (UNLIKELY(!ptr))
         return;
 
-    ptr = partitionCookieFreePointerAdjust(ptr);
-    ASSERT(partitionPointerIsValid(ptr));
-    PartitionPage* page = partitionPointerToPage(ptr);
+    void* slot = partitionCookieFreePointerAdjust(ptr);
+    ASSERT(partitionPointerIsValid(slot));
+    PartitionPage* page = partitionPointerToPage(slot);
+    if (LIKELY(partitionBucketIsThreadCacheable(page->bucket)) && LIKELY(partitionThreadCacheFree(root, ptr, page)))
+        return;
     spinLockLock(&root->lock);
-    partitionFreeWithPage(ptr, page);
+    partitionFreeWithPage(slot, page);
     spinLockUnlock(&root->lock);
 #endif
 }
 
-ALWAYS_INLINE bool partitionBucketIsDirectMapped(PartitionBucket* bucket)
-{
-    return !bucket->numSystemPagesPerSlotSpan;
-}
-
 ALWAYS_INLINE size_t partitionDirectMapSize(size_t size)
 {
     // Caller must check that the size is not above the kGenericMaxDirectMapped
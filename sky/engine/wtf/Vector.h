@@ -279,6 +279,19 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
             m_capacity = sizeToAllocate / sizeof(T);
         }
 
+        // Grows the buffer in place when the allocator can extend the
+        // existing allocation, avoiding the allocate-copy-free cycle. Only
+        // valid for types that can be moved with memcpy, since the allocator
+        // moves raw bytes if it cannot extend in place.
+        void reallocateBuffer(size_t newCapacity)
+        {
+            typedef typename Allocator::template VectorBackingHelper<T, VectorTraits<T> >::Type VectorBacking;
+            ASSERT(newCapacity);
+            size_t sizeToAllocate = allocationSize(newCapacity);
+            m_buffer = Allocator::template backingRealloc<T*, VectorBacking>(m_buffer, sizeToAllocate);
+            m_capacity = sizeToAllocate / sizeof(T);
+        }
+
         size_t allocationSize(size_t capacity) const
         {
             return Allocator::Quantizer::template quantizedSize<T>(capacity);
@@ -351,6 +364,7 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
 
         using Base::allocateBuffer;
         using Base::allocationSize;
+        using Base::reallocateBuffer;
 
         using Base::buffer;
         using Base::capacity;
@@ -361,6 +375,22 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
             return buffer();
         }
 
+        T* releaseOutOfLineBuffer(size_t& bufferCapacity)
+        {
+            ASSERT(hasOutOfLineBuffer());
+            T* bufferToRelease = m_buffer;
+            bufferCapacity = m_capacity;
+            resetBufferPointer();
+            return bufferToRelease;
+        }
+
+        void adoptOutOfLineBuffer(T* bufferToAdopt, size_t bufferCapacity)
+        {
+            ASSERT(!m_buffer);
+            m_buffer = bufferToAdopt;
+            m_capacity = bufferCapacity;
+        }
+
     protected:
         using Base::m_size;
 
@@ -426,6 +456,13 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
             return Base::allocationSize(capacity);
         }
 
+        void reallocateBuffer(size_t newCapacity)
+        {
+            ASSERT(buffer() != inlineBuffer());
+            ASSERT(newCapacity > inlineCapacity);
+            Base::reallocateBuffer(newCapacity);
+        }
+
         void swapVectorBuffer(VectorBuffer<T, inlineCapacity, Allocator>& other)
         {
             typedef VectorTypeOperations<T> TypeOperations;
@@ -463,6 +500,23 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
             return buffer() && buffer() != inlineBuffer();
         }
 
+        T* releaseOutOfLineBuffer(size_t& bufferCapacity)
+        {
+            ASSERT(hasOutOfLineBuffer());
+            T* bufferToRelease = m_buffer;
+            bufferCapacity = m_capacity;
+            resetBufferPointer();
+            return bufferToRelease;
+        }
+
+        void adoptOutOfLineBuffer(T* bufferToAdopt, size_t bufferCapacity)
+        {
+            ASSERT(buffer() == inlineBuffer());
+            ASSERT(bufferCapacity > inlineCapacity);
+            m_buffer = bufferToAdopt;
+            m_capacity = bufferCapacity;
+        }
+
     protected:
         using Base::m_size;
 
@@ -587,6 +641,14 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
         Vector(Vector&&);
         Vector& operator=(Vector&&);
 
+        // Moving between vectors of differing inline capacity steals the
+        // source's heap buffer when it has one, and moves the elements
+        // otherwise.
+        template<size_t otherCapacity>
+        Vector(Vector<T, otherCapacity, Allocator>&&);
+        template<size_t otherCapacity>
+        Vector& operator=(Vector<T, otherCapacity, Allocator>&&);
+
         size_t size() const { return m_size; }
         size_t capacity() const { return Base::capacity(); }
         bool isEmpty() const { return !size(); }
@@ -689,6 +751,7 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
         template<typename U> U* expandCapacity(size_t newMinCapacity, U*);
         void shrinkCapacity(size_t newCapacity);
         template<typename U> void appendSlowCase(const U&);
+        template<size_t otherCapacity> void moveFrom(Vector<T, otherCapacity, Allocator>&);
 
         using Base::m_size;
         using Base::buffer;
@@ -696,6 +759,9 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
         using Base::swapVectorBuffer;
         using Base::allocateBuffer;
         using Base::allocationSize;
+
+        template<typename U, size_t otherCapacity, typename OtherAllocator>
+        friend class Vector;
     };
 
     template<typename T, size_t inlineCapacity, typename Allocator>
@@ -778,6 +844,52 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
         return *this;
     }
 
+    template<typename T, size_t inlineCapacity, typename Allocator>
+    template<size_t otherCapacity>
+    void Vector<T, inlineCapacity, Allocator>::moveFrom(Vector<T, otherCapacity, Allocator>& other)
+    {
+        // Return our buffer to its inline or empty state before adopting or
+        // moving into it.
+        clear();
+
+        // Only adopt a heap buffer that is larger than our inline buffer;
+        // otherwise the elements fit inline and adopting would leave us with
+        // a buffer smaller than inlineCapacity.
+        if (other.hasOutOfLineBuffer() && other.capacity() > inlineCapacity) {
+            size_t bufferCapacity = 0;
+            T* buffer = other.releaseOutOfLineBuffer(bufferCapacity);
+            Base::adoptOutOfLineBuffer(buffer, bufferCapacity);
+            m_size = other.m_size;
+            other.m_size = 0;
+            return;
+        }
+
+        if (other.size() > capacity())
+            reserveCapacity(other.size());
+        TypeOperations::move(other.begin(), other.end(), begin());
+        m_size = other.size();
+        other.m_size = 0;
+    }
+
+    template<typename T, size_t inlineCapacity, typename Allocator>
+    template<size_t otherCapacity>
+    Vector<T, inlineCapacity, Allocator>::Vector(Vector<T, otherCapacity, Allocator>&& other)
+    {
+        m_size = 0;
+        moveFrom(other);
+    }
+
+    template<typename T, size_t inlineCapacity, typename Allocator>
+    template<size_t otherCapacity>
+    Vector<T, inlineCapacity, Allocator>& Vector<T, inlineCapacity, Allocator>::operator=(Vector<T, otherCapacity, Allocator>&& other)
+    {
+        // A vector of different inline capacity is a different type; it
+        // cannot alias this one.
+        ASSERT(!typelessPointersAreEqual(&other, this));
+        moveFrom(other);
+        return *this;
+    }
+
     template<typename T, size_t inlineCapacity, typename Allocator>
     template<typename U>
     bool Vector<T, inlineCapacity, Allocator>::contains(const U& value) const
@@ -914,6 +1026,13 @@ static const size_t kInitialVectorSize = WTF_VECTOR_INITIAL_SIZE;
     {
         if (UNLIKELY(newCapacity <= capacity()))
             return;
+        // Memcpy-movable types with an out-of-line buffer grow with realloc,
+        // which lets the partition allocator extend the existing allocation
+        // in place when the following span is free.
+        if (VectorTraits<T>::canMoveWithMemcpy && this->hasOutOfLineBuffer()) {
+            Base::reallocateBuffer(newCapacity);
+            return;
+        }
         T* oldBuffer = begin();
         T* oldEnd = end();
         Base::allocateBuffer(newCapacity);
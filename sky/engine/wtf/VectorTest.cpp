@@ -283,6 +283,34 @@ TEST(VectorTest, SwapWithInlineCapacity)
     vectorB.swap(vectorA);
 }
 
+TEST(VectorTest, MoveWithDifferingInlineCapacity)
+{
+    // A source that has spilled to the heap donates its buffer instead of
+    // copying the elements.
+    Vector<int, 2> spilled;
+    for (int i = 0; i < 16; ++i)
+        spilled.append(i);
+    const int* heapBuffer = spilled.data();
+    Vector<int> adopted(std::move(spilled));
+    EXPECT_EQ(heapBuffer, adopted.data());
+    EXPECT_EQ(16u, adopted.size());
+    EXPECT_TRUE(spilled.isEmpty());
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(i, adopted[i]);
+
+    // A source still in its inline buffer moves the elements.
+    Vector<int, 4> inlineSource;
+    inlineSource.append(1);
+    inlineSource.append(2);
+    Vector<int, 8> destination;
+    destination.append(9);
+    destination = std::move(inlineSource);
+    EXPECT_EQ(2u, destination.size());
+    EXPECT_EQ(1, destination[0]);
+    EXPECT_EQ(2, destination[1]);
+    EXPECT_TRUE(inlineSource.isEmpty());
+}
+
 class Comparable {
 };
 bool operator==(const Comparable& a, const Comparable& b) { return true; }
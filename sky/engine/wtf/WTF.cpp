@@ -81,6 +81,9 @@ void Partitions::initialize()
 void Partitions::shutdown()
 {
     fastMallocShutdown();
+    // Return the slots cached by this thread so the partition does not
+    // report them as leaked.
+    partitionThreadCachePurge();
     m_bufferAllocator.shutdown();
 }
 
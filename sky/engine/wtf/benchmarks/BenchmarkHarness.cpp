@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "flutter/sky/engine/wtf/benchmarks/BenchmarkHarness.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+namespace WTF {
+namespace benchmarking {
+
+namespace {
+
+struct Registration {
+    const char* name;
+    BenchmarkFunction function;
+};
+
+// Registrations happen during static initialization, before main, so the
+// list itself must not have a dynamic initializer. A fixed capacity keeps
+// it trivial; the harness aborts loudly if it ever fills up.
+const size_t kMaxBenchmarks = 256;
+Registration g_benchmarks[kMaxBenchmarks];
+size_t g_benchmarkCount = 0;
+
+// A run must last long enough that timer resolution and loop setup are
+// noise. 100ms keeps the whole suite in the tens of seconds on a device.
+const int64_t kMinRunNanoseconds = 100 * 1000 * 1000;
+const int kMeasuredRuns = 3;
+
+int64_t nowNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t timeRun(BenchmarkFunction function, size_t iterations)
+{
+    int64_t start = nowNanoseconds();
+    function(iterations);
+    return nowNanoseconds() - start;
+}
+
+bool matchesFilter(const char* name, int argc, char** argv)
+{
+    bool sawFilter = false;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-')
+            continue;
+        sawFilter = true;
+        if (strstr(name, argv[i]))
+            return true;
+    }
+    return !sawFilter;
+}
+
+} // namespace
+
+void registerBenchmark(const char* name, BenchmarkFunction function)
+{
+    if (g_benchmarkCount >= kMaxBenchmarks) {
+        fprintf(stderr, "Too many benchmarks; raise kMaxBenchmarks.\n");
+        abort();
+    }
+    g_benchmarks[g_benchmarkCount].name = name;
+    g_benchmarks[g_benchmarkCount].function = function;
+    ++g_benchmarkCount;
+}
+
+void consume(const void* value)
+{
+    // An empty asm that claims to read |value| is enough to stop the
+    // optimizer from discarding the computation that produced it.
+    asm volatile("" : : "g"(value) : "memory");
+}
+
+int runAllBenchmarks(int argc, char** argv)
+{
+    size_t ran = 0;
+    for (size_t i = 0; i < g_benchmarkCount; ++i) {
+        const Registration& benchmark = g_benchmarks[i];
+        if (!matchesFilter(benchmark.name, argc, argv))
+            continue;
+        ++ran;
+
+        // Grow the iteration count geometrically until one run is long
+        // enough to time, warming caches and branch predictors on the way.
+        size_t iterations = 1;
+        int64_t elapsed = timeRun(benchmark.function, iterations);
+        while (elapsed < kMinRunNanoseconds && iterations < (size_t(1) << 40)) {
+            iterations *= 4;
+            elapsed = timeRun(benchmark.function, iterations);
+        }
+
+        int64_t best = elapsed;
+        for (int run = 1; run < kMeasuredRuns; ++run) {
+            int64_t nanoseconds = timeRun(benchmark.function, iterations);
+            if (nanoseconds < best)
+                best = nanoseconds;
+        }
+
+        printf("%-40s %12.2f ns/op  (%zu iterations)\n", benchmark.name,
+            static_cast<double>(best) / iterations, iterations);
+        fflush(stdout);
+    }
+
+    if (!ran) {
+        fprintf(stderr, "No benchmark matched the given filter.\n");
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace benchmarking
+} // namespace WTF
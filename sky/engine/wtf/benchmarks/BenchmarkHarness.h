@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SKY_ENGINE_WTF_BENCHMARKS_BENCHMARKHARNESS_H_
+#define SKY_ENGINE_WTF_BENCHMARKS_BENCHMARKHARNESS_H_
+
+// A deliberately tiny microbenchmark harness so container and string work
+// in WTF can be validated on target hardware without pulling a benchmarking
+// framework into the tree.
+//
+// A benchmark is a function that performs its operation |iterations| times.
+// The harness calibrates |iterations| until a run takes long enough to
+// measure reliably, repeats the measurement a few times, and reports the
+// best run in ns per iteration (the best run has the least scheduler and
+// cache noise; regressions move the best run just as they move the mean).
+//
+// Define benchmarks with WTF_BENCHMARK and link them into wtf_benchmarks:
+//
+//     WTF_BENCHMARK(VectorAppend1k)
+//     {
+//         for (size_t i = 0; i < iterations; ++i) { ... }
+//     }
+
+#include <stddef.h>
+
+namespace WTF {
+namespace benchmarking {
+
+typedef void (*BenchmarkFunction)(size_t iterations);
+
+// Registration is performed by static initializers in the benchmark files;
+// names must be unique across the binary.
+void registerBenchmark(const char* name, BenchmarkFunction);
+
+// Runs every registered benchmark whose name contains one of the argv
+// substrings (all of them when no filter is given) and prints one line per
+// benchmark. Returns a process exit code.
+int runAllBenchmarks(int argc, char** argv);
+
+// Defeats dead-code elimination of a benchmarked computation without
+// costing a memory round trip per use.
+void consume(const void* value);
+
+class BenchmarkRegistrar {
+public:
+    BenchmarkRegistrar(const char* name, BenchmarkFunction function)
+    {
+        registerBenchmark(name, function);
+    }
+};
+
+#define WTF_BENCHMARK(name) \
+    static void wtfBenchmark##name(size_t iterations); \
+    static WTF::benchmarking::BenchmarkRegistrar wtfBenchmarkRegistrar##name(#name, wtfBenchmark##name); \
+    static void wtfBenchmark##name(size_t iterations)
+
+} // namespace benchmarking
+} // namespace WTF
+
+#endif  // SKY_ENGINE_WTF_BENCHMARKS_BENCHMARKHARNESS_H_
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "flutter/sky/engine/wtf/benchmarks/BenchmarkHarness.h"
+
+#include "flutter/sky/engine/wtf/FlatHashMap.h"
+#include "flutter/sky/engine/wtf/HashMap.h"
+
+namespace {
+
+using WTF::benchmarking::consume;
+
+// Keys are multiplied out so neighbouring probes do not enjoy perfect
+// locality the way 0..n-1 keys would. Zero is avoided: it is the empty
+// bucket sentinel for integer keys.
+inline int keyForIndex(size_t index)
+{
+    return static_cast<int>(index * 7 + 1);
+}
+
+// HashMap and FlatHashMap run the same suites under parallel names so a
+// flat-map migration for a call site can be judged from one report.
+
+template<typename MapType>
+void mapInsert(size_t iterations, size_t size)
+{
+    for (size_t i = 0; i < iterations; ++i) {
+        MapType map;
+        for (size_t j = 0; j < size; ++j)
+            map.set(keyForIndex(j), static_cast<int>(j));
+        consume(&map);
+    }
+}
+
+template<typename MapType>
+void mapLookup(size_t iterations, size_t size, bool hit)
+{
+    MapType map;
+    for (size_t j = 0; j < size; ++j)
+        map.set(keyForIndex(j), static_cast<int>(j));
+    // Misses probe keys interleaved between the inserted ones.
+    const int missOffset = hit ? 0 : 3;
+    for (size_t i = 0; i < iterations; ++i) {
+        int value = map.get(keyForIndex(i % size) + missOffset);
+        consume(&value);
+    }
+}
+
+typedef WTF::HashMap<int, int> IntHashMap;
+typedef WTF::FlatHashMap<int, int> IntFlatHashMap;
+
+WTF_BENCHMARK(HashMapInsert256) { mapInsert<IntHashMap>(iterations, 256); }
+WTF_BENCHMARK(HashMapInsert4096) { mapInsert<IntHashMap>(iterations, 4096); }
+WTF_BENCHMARK(HashMapLookupHit4096) { mapLookup<IntHashMap>(iterations, 4096, true); }
+WTF_BENCHMARK(HashMapLookupMiss4096) { mapLookup<IntHashMap>(iterations, 4096, false); }
+
+WTF_BENCHMARK(FlatHashMapInsert256) { mapInsert<IntFlatHashMap>(iterations, 256); }
+WTF_BENCHMARK(FlatHashMapInsert4096) { mapInsert<IntFlatHashMap>(iterations, 4096); }
+WTF_BENCHMARK(FlatHashMapLookupHit4096) { mapLookup<IntFlatHashMap>(iterations, 4096, true); }
+WTF_BENCHMARK(FlatHashMapLookupMiss4096) { mapLookup<IntFlatHashMap>(iterations, 4096, false); }
+
+WTF_BENCHMARK(HashMapIterate4096)
+{
+    IntHashMap map;
+    for (size_t j = 0; j < 4096; ++j)
+        map.set(keyForIndex(j), static_cast<int>(j));
+    for (size_t i = 0; i < iterations; ++i) {
+        int sum = 0;
+        for (IntHashMap::const_iterator it = map.begin(); it != map.end(); ++it)
+            sum += it->value;
+        consume(&sum);
+    }
+}
+
+} // namespace
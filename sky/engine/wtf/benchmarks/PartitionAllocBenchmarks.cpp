@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "flutter/sky/engine/wtf/benchmarks/BenchmarkHarness.h"
+
+#include "flutter/sky/engine/wtf/PartitionAlloc.h"
+
+namespace {
+
+using WTF::benchmarking::consume;
+
+// One generic partition shared by all the allocator benchmarks, initialized
+// on first use so nothing runs before WTF::initialize.
+WTF::PartitionRootGeneric* allocatorRoot()
+{
+    static WTF::PartitionAllocatorGeneric* allocator = 0;
+    if (!allocator) {
+        allocator = new WTF::PartitionAllocatorGeneric;
+        allocator->init();
+    }
+    return allocator->root();
+}
+
+// Alloc immediately followed by free exercises the bucket fast paths the
+// way short-lived render objects do.
+void allocFree(size_t iterations, size_t size)
+{
+    WTF::PartitionRootGeneric* root = allocatorRoot();
+    for (size_t i = 0; i < iterations; ++i) {
+        void* ptr = WTF::partitionAllocGeneric(root, size);
+        consume(ptr);
+        WTF::partitionFreeGeneric(root, ptr);
+    }
+}
+
+WTF_BENCHMARK(PartitionAllocFree16) { allocFree(iterations, 16); }
+WTF_BENCHMARK(PartitionAllocFree64) { allocFree(iterations, 64); }
+WTF_BENCHMARK(PartitionAllocFree256) { allocFree(iterations, 256); }
+WTF_BENCHMARK(PartitionAllocFree4k) { allocFree(iterations, 4096); }
+
+// A window of live allocations freed in FIFO order defeats the
+// just-freed-slot reuse the pairwise benchmark enjoys and touches page
+// management instead.
+WTF_BENCHMARK(PartitionAllocChurn64)
+{
+    WTF::PartitionRootGeneric* root = allocatorRoot();
+    const size_t kWindow = 1024;
+    void* live[kWindow] = { 0 };
+    for (size_t i = 0; i < iterations; ++i) {
+        size_t slot = i % kWindow;
+        if (live[slot])
+            WTF::partitionFreeGeneric(root, live[slot]);
+        live[slot] = WTF::partitionAllocGeneric(root, 64);
+        consume(live[slot]);
+    }
+    for (size_t slot = 0; slot < kWindow; ++slot) {
+        if (live[slot])
+            WTF::partitionFreeGeneric(root, live[slot]);
+    }
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "flutter/sky/engine/wtf/benchmarks/BenchmarkHarness.h"
+
+#include "flutter/sky/engine/wtf/text/AtomicString.h"
+#include "flutter/sky/engine/wtf/text/StringBuilder.h"
+#include "flutter/sky/engine/wtf/text/WTFString.h"
+
+namespace {
+
+using WTF::benchmarking::consume;
+
+void builderAppendPieces(size_t iterations, size_t pieces)
+{
+    for (size_t i = 0; i < iterations; ++i) {
+        WTF::StringBuilder builder;
+        for (size_t j = 0; j < pieces; ++j)
+            builder.append("piece", 5);
+        WTF::String result = builder.toString();
+        consume(result.impl());
+    }
+}
+
+WTF_BENCHMARK(StringBuilderAppend8) { builderAppendPieces(iterations, 8); }
+WTF_BENCHMARK(StringBuilderAppend128) { builderAppendPieces(iterations, 128); }
+
+WTF_BENCHMARK(StringBuilderAppendChar256)
+{
+    for (size_t i = 0; i < iterations; ++i) {
+        WTF::StringBuilder builder;
+        for (size_t j = 0; j < 256; ++j)
+            builder.append(static_cast<LChar>('a' + (j & 15)));
+        WTF::String result = builder.toString();
+        consume(result.impl());
+    }
+}
+
+// The common case in the engine: atomizing a string whose value is already
+// in the table (attribute and property names repeat endlessly).
+WTF_BENCHMARK(AtomicStringLookupExisting)
+{
+    WTF::AtomicString existing("font-family");
+    for (size_t i = 0; i < iterations; ++i) {
+        WTF::AtomicString atom("font-family");
+        consume(atom.impl());
+    }
+}
+
+WTF_BENCHMARK(StringEqualitySameLength)
+{
+    WTF::String a("an engine benchmark string");
+    WTF::String b("an engine benchmark strinG");
+    for (size_t i = 0; i < iterations; ++i) {
+        bool equal = (a == b);
+        consume(&equal);
+    }
+}
+
+WTF_BENCHMARK(StringNumberConversion)
+{
+    for (size_t i = 0; i < iterations; ++i) {
+        WTF::String number = WTF::String::number(static_cast<int>(i & 0xffff));
+        consume(number.impl());
+    }
+}
+
+} // namespace
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "flutter/sky/engine/wtf/benchmarks/BenchmarkHarness.h"
+
+#include "flutter/sky/engine/wtf/Vector.h"
+
+namespace {
+
+using WTF::benchmarking::consume;
+
+// One iteration builds a whole vector so growth and (for the inline
+// variants) the spill from inline capacity to the heap are inside the
+// measurement, the way layout and paint code paths hit them.
+template<size_t inlineCapacity>
+void appendInts(size_t iterations, size_t size)
+{
+    for (size_t i = 0; i < iterations; ++i) {
+        WTF::Vector<int, inlineCapacity> vector;
+        for (size_t j = 0; j < size; ++j)
+            vector.append(static_cast<int>(j));
+        consume(vector.data());
+    }
+}
+
+void iterateInts(size_t iterations, size_t size)
+{
+    WTF::Vector<int> vector;
+    for (size_t j = 0; j < size; ++j)
+        vector.append(static_cast<int>(j));
+    for (size_t i = 0; i < iterations; ++i) {
+        int sum = 0;
+        for (size_t j = 0; j < vector.size(); ++j)
+            sum += vector[j];
+        consume(&sum);
+    }
+}
+
+WTF_BENCHMARK(VectorAppend16) { appendInts<0>(iterations, 16); }
+WTF_BENCHMARK(VectorAppend256) { appendInts<0>(iterations, 256); }
+WTF_BENCHMARK(VectorAppend4096) { appendInts<0>(iterations, 4096); }
+
+// Inline capacity sized to hold everything versus sized to spill after a
+// few elements, the two ways Vector<T, N> is actually used in the tree.
+WTF_BENCHMARK(VectorAppendInline16Fits) { appendInts<16>(iterations, 16); }
+WTF_BENCHMARK(VectorAppendInline16Spills) { appendInts<16>(iterations, 256); }
+
+WTF_BENCHMARK(VectorIterate256) { iterateInts(iterations, 256); }
+WTF_BENCHMARK(VectorIterate4096) { iterateInts(iterations, 4096); }
+
+WTF_BENCHMARK(VectorReserveThenAppend4096)
+{
+    for (size_t i = 0; i < iterations; ++i) {
+        WTF::Vector<int> vector;
+        vector.reserveCapacity(4096);
+        for (size_t j = 0; j < 4096; ++j)
+            vector.append(static_cast<int>(j));
+        consume(vector.data());
+    }
+}
+
+} // namespace
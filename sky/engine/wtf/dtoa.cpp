@@ -1215,8 +1215,74 @@ void dtoaRoundDP(DtoaBuffer result, double dd, int ndigits, bool& sign, int& exp
     dtoa<false, false, true, false>(result, dd, ndigits, sign, exponent, precision);
 }
 
+extern const char twoDigitDecimalDigits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes the decimal digits of |value| ending just before |end| and returns a
+// pointer to the first digit.
+static inline char* writeIntegerReversed(uint64_t value, char* end)
+{
+    char* p = end;
+    while (value >= 100) {
+        unsigned index = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--p = twoDigitDecimalDigits[index + 1];
+        *--p = twoDigitDecimalDigits[index];
+    }
+    if (value >= 10) {
+        unsigned index = static_cast<unsigned>(value) * 2;
+        *--p = twoDigitDecimalDigits[index + 1];
+        *--p = twoDigitDecimalDigits[index];
+    } else
+        *--p = static_cast<char>('0' + value);
+    return p;
+}
+
+const char* numberToIntegerString(uint64_t value, NumberToStringBuffer buffer)
+{
+    char* end = buffer + NumberToStringBufferLength - 1;
+    *end = '\0';
+    return writeIntegerReversed(value, end);
+}
+
+const char* numberToIntegerString(int64_t value, NumberToStringBuffer buffer)
+{
+    char* end = buffer + NumberToStringBufferLength - 1;
+    *end = '\0';
+    const bool negative = value < 0;
+    uint64_t unsignedValue = static_cast<uint64_t>(value);
+    if (negative)
+        unsignedValue = 0 - unsignedValue;
+    char* p = writeIntegerReversed(unsignedValue, end);
+    if (negative)
+        *--p = '-';
+    return p;
+}
+
 const char* numberToString(double d, NumberToStringBuffer buffer)
 {
+    // Integral values well inside the exactly-representable range are the
+    // common case for generated JSON; format them with the integer kernel
+    // instead of the shortest-representation digit search. The bound also
+    // keeps us far away from the converter's exponent notation cutoff, and
+    // negative zero takes this path too, matching the converter's unique
+    // zero ("0").
+    const double maxIntegerFastPath = 1e15;
+    if (d >= -maxIntegerFastPath && d <= maxIntegerFastPath) {
+        int64_t integerValue = static_cast<int64_t>(d);
+        if (static_cast<double>(integerValue) == d)
+            return numberToIntegerString(integerValue, buffer);
+    }
+
     double_conversion::StringBuilder builder(buffer, NumberToStringBufferLength);
     const double_conversion::DoubleToStringConverter& converter = double_conversion::DoubleToStringConverter::EcmaScriptConverter();
     converter.ToShortest(d, &builder);
@@ -21,6 +21,8 @@
 #ifndef SKY_ENGINE_WTF_DTOA_H_
 #define SKY_ENGINE_WTF_DTOA_H_
 
+#include <stdint.h>
+
 #include "flutter/sky/engine/wtf/ASCIICType.h"
 #include "flutter/sky/engine/wtf/WTFExport.h"
 #include "flutter/sky/engine/wtf/unicode/Unicode.h"
@@ -47,6 +49,15 @@ WTF_EXPORT const char* numberToString(double, NumberToStringBuffer);
 WTF_EXPORT const char* numberToFixedPrecisionString(double, unsigned significantFigures, NumberToStringBuffer, bool truncateTrailingZeros = false);
 WTF_EXPORT const char* numberToFixedWidthString(double, unsigned decimalPlaces, NumberToStringBuffer);
 
+// "000102...99": every two-digit decimal pair in order, for emitting integers
+// two digits per division.
+WTF_EXPORT extern const char twoDigitDecimalDigits[];
+
+// Integer formatting kernels using the two-digit table. The returned pointer
+// is into |buffer| but not necessarily its start.
+WTF_EXPORT const char* numberToIntegerString(int64_t, NumberToStringBuffer);
+WTF_EXPORT const char* numberToIntegerString(uint64_t, NumberToStringBuffer);
+
 WTF_EXPORT double parseDouble(const LChar* string, size_t length, size_t& parsedLength);
 WTF_EXPORT double parseDouble(const UChar* string, size_t length, size_t& parsedLength);
 
@@ -119,6 +119,19 @@ static inline PassRefPtr<StringImpl> addToStringTable(const T& value)
     return addResult.isNewEntry ? adoptRef(*addResult.storedValue) : *addResult.storedValue;
 }
 
+// Checks the frozen static-strings table before the per-thread dynamic
+// table. Static strings are registered in every thread's table when that
+// table is created, so a hit here names the same impl the dynamic lookup
+// would find and can be returned without touching thread-local state.
+template<typename CharacterType>
+static inline StringImpl* findStaticString(const CharacterType* characters, unsigned length, unsigned hash)
+{
+    StringImpl* staticString = StringImpl::findStaticString(hash);
+    if (staticString && equal(staticString, characters, length))
+        return staticString;
+    return 0;
+}
+
 PassRefPtr<StringImpl> AtomicString::add(const LChar* c)
 {
     if (!c)
@@ -261,6 +274,11 @@ PassRefPtr<StringImpl> AtomicString::add(const UChar* s, unsigned length)
     if (!length)
         return StringImpl::empty();
 
+    if (length <= StringImpl::highestStaticStringLength()) {
+        if (StringImpl* staticString = findStaticString(s, length, StringHasher::computeHashAndMaskTop8Bits(s, length)))
+            return staticString;
+    }
+
     UCharBuffer buffer = { s, length };
     return addToStringTable<UCharBuffer, UCharBufferTranslator>(buffer);
 }
@@ -273,6 +291,11 @@ PassRefPtr<StringImpl> AtomicString::add(const UChar* s, unsigned length, unsign
     if (!length)
         return StringImpl::empty();
 
+    if (length <= StringImpl::highestStaticStringLength()) {
+        if (StringImpl* staticString = findStaticString(s, length, existingHash))
+            return staticString;
+    }
+
     HashAndCharacters<UChar> buffer = { existingHash, s, length };
     return addToStringTable<HashAndCharacters<UChar>, HashAndCharactersTranslator<UChar> >(buffer);
 }
@@ -389,6 +412,11 @@ PassRefPtr<StringImpl> AtomicString::add(const LChar* s, unsigned length)
     if (!length)
         return StringImpl::empty();
 
+    if (length <= StringImpl::highestStaticStringLength()) {
+        if (StringImpl* staticString = findStaticString(s, length, StringHasher::computeHashAndMaskTop8Bits(s, length)))
+            return staticString;
+    }
+
     LCharBuffer buffer = { s, length };
     return addToStringTable<LCharBuffer, LCharBufferTranslator>(buffer);
 }
@@ -22,6 +22,7 @@
 #ifndef SKY_ENGINE_WTF_TEXT_INTEGERTOSTRINGCONVERSION_H_
 #define SKY_ENGINE_WTF_TEXT_INTEGERTOSTRINGCONVERSION_H_
 
+#include "flutter/sky/engine/wtf/dtoa.h"
 #include "flutter/sky/engine/wtf/text/StringBuilder.h"
 #include "flutter/sky/engine/wtf/text/StringImpl.h"
 
@@ -69,10 +70,19 @@ static typename ConversionTrait<T>::ReturnType numberToStringImpl(UnsignedIntege
     LChar* end = buf + WTF_ARRAY_LENGTH(buf);
     LChar* p = end;
 
-    do {
-        *--p = static_cast<LChar>((number % 10) + '0');
-        number /= 10;
-    } while (number);
+    // Emit two digits per division via the shared table.
+    while (number >= 100) {
+        unsigned index = static_cast<unsigned>(number % 100) * 2;
+        number /= 100;
+        *--p = static_cast<LChar>(twoDigitDecimalDigits[index + 1]);
+        *--p = static_cast<LChar>(twoDigitDecimalDigits[index]);
+    }
+    if (number >= 10) {
+        unsigned index = static_cast<unsigned>(number) * 2;
+        *--p = static_cast<LChar>(twoDigitDecimalDigits[index + 1]);
+        *--p = static_cast<LChar>(twoDigitDecimalDigits[index]);
+    } else
+        *--p = static_cast<LChar>('0' + number);
 
     if (NumberType == NegativeNumber)
         *--p = '-';
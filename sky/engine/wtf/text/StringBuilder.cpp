@@ -316,6 +316,106 @@ void StringBuilder::append(const LChar* characters, unsigned length)
     }
 }
 
+void StringBuilder::appendAll(const StringView* strings, size_t count)
+{
+    unsigned totalLength = 0;
+    bool requires16Bit = false;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned newLength = totalLength + strings[i].length();
+        RELEASE_ASSERT(newLength >= totalLength);
+        totalLength = newLength;
+        if (strings[i].length() && !strings[i].is8Bit())
+            requires16Bit = true;
+    }
+    if (!totalLength)
+        return;
+
+    unsigned requiredLength = m_length + totalLength;
+    RELEASE_ASSERT(requiredLength >= m_length);
+
+    if (m_is8Bit && requires16Bit) {
+        // Up-convert once, sized for the whole batch, rather than when the
+        // first 16 bit piece is appended.
+        if (m_buffer) {
+            ASSERT(m_buffer->length() >= m_length);
+            allocateBufferUpConvert(m_buffer->characters8(), requiredLength);
+        } else {
+            ASSERT(m_string.length() == m_length);
+            allocateBufferUpConvert(m_string.isNull() ? 0 : m_string.characters8(), requiredLength);
+        }
+    } else {
+        reserveCapacity(requiredLength);
+    }
+
+    // Every append now lands in reserved capacity, so none of them grows or
+    // converts the buffer.
+    for (size_t i = 0; i < count; ++i)
+        append(strings[i]);
+}
+
+template <typename CharType>
+static inline CharType* copyCharactersToBuffer(CharType* destination, bool is8Bit, const LChar* characters8, const UChar* characters16, unsigned length)
+{
+    if (!length)
+        return destination;
+    if (is8Bit)
+        StringImpl::copyChars(destination, characters8, length);
+    else
+        StringImpl::copyChars(destination, reinterpret_cast<const CharType*>(characters16), length);
+    return destination + length;
+}
+
+// The 8 bit instantiation only ever sees 8 bit pieces; the cast above exists
+// solely to keep it compiling and is never executed.
+template <typename CharType>
+static String joinInBuffer(const Vector<String>& strings, const StringView& separator, unsigned totalLength)
+{
+    CharType* data;
+    RefPtr<StringImpl> impl = StringImpl::createUninitialized(totalLength, data);
+    bool separatorIs8Bit = !separator.length() || separator.is8Bit();
+    const LChar* separator8 = separatorIs8Bit && separator.length() ? separator.characters8() : 0;
+    const UChar* separator16 = !separatorIs8Bit ? separator.characters16() : 0;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (i)
+            data = copyCharactersToBuffer(data, separatorIs8Bit, separator8, separator16, separator.length());
+        const String& string = strings[i];
+        if (!string.length())
+            continue;
+        data = copyCharactersToBuffer(data, string.is8Bit(),
+            string.is8Bit() ? string.characters8() : 0,
+            string.is8Bit() ? 0 : string.characters16(), string.length());
+    }
+    return String(impl.release());
+}
+
+String StringBuilder::join(const Vector<String>& strings, const StringView& separator)
+{
+    if (strings.isEmpty())
+        return emptyString();
+
+    unsigned totalLength = 0;
+    bool requires16Bit = separator.length() && !separator.is8Bit();
+    for (size_t i = 0; i < strings.size(); ++i) {
+        unsigned pieceLength = strings[i].length();
+        if (i) {
+            unsigned withSeparator = totalLength + separator.length();
+            RELEASE_ASSERT(withSeparator >= totalLength);
+            totalLength = withSeparator;
+        }
+        unsigned newLength = totalLength + pieceLength;
+        RELEASE_ASSERT(newLength >= totalLength);
+        totalLength = newLength;
+        if (pieceLength && !strings[i].is8Bit())
+            requires16Bit = true;
+    }
+    if (!totalLength)
+        return emptyString();
+
+    if (requires16Bit)
+        return joinInBuffer<UChar>(strings, separator, totalLength);
+    return joinInBuffer<LChar>(strings, separator, totalLength);
+}
+
 void StringBuilder::appendNumber(int number)
 {
     numberToStringSigned<StringBuilder>(number, this);
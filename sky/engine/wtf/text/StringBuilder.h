@@ -27,6 +27,7 @@
 #ifndef SKY_ENGINE_WTF_TEXT_STRINGBUILDER_H_
 #define SKY_ENGINE_WTF_TEXT_STRINGBUILDER_H_
 
+#include "flutter/sky/engine/wtf/Vector.h"
 #include "flutter/sky/engine/wtf/WTFExport.h"
 #include "flutter/sky/engine/wtf/text/AtomicString.h"
 #include "flutter/sky/engine/wtf/text/WTFString.h"
@@ -163,6 +164,16 @@ public:
         append(U16_TRAIL(c));
     }
 
+    // Appends every string with a single capacity check: the buffer grows at
+    // most once, sized for the whole batch, and is up-converted to 16 bit up
+    // front if any piece requires it.
+    void appendAll(const StringView*, size_t count);
+    void appendAll(const Vector<StringView>& strings) { appendAll(strings.data(), strings.size()); }
+
+    // Joins the strings with the separator into a buffer sized up front, so
+    // the result is built with a single allocation.
+    static String join(const Vector<String>&, const StringView& separator);
+
     template<unsigned charactersCount>
     ALWAYS_INLINE void appendLiteral(const char (&characters)[charactersCount]) { append(characters, charactersCount - 1); }
 
@@ -182,6 +193,19 @@ public:
         return m_string;
     }
 
+    // Like toString(), but transfers the buffer to the returned string and
+    // clears the builder. Never reallocates to fit: an over-allocated buffer
+    // the builder uniquely owns is truncated in place.
+    String takeString()
+    {
+        if (m_string.isNull())
+            reifyString();
+        String result;
+        result.swap(m_string);
+        clear();
+        return result;
+    }
+
     String substring(unsigned position, unsigned length) const
     {
         if (!m_length)
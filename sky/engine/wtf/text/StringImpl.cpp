@@ -39,6 +39,12 @@
 #include "flutter/sky/engine/wtf/text/StringHash.h"
 #include "flutter/sky/engine/wtf/unicode/CharacterNames.h"
 
+#if CPU(X86) || CPU(X86_64)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 #ifdef STRING_STATS
 #include <unistd.h>
 #include "flutter/sky/engine/wtf/DataLog.h"
@@ -343,6 +349,10 @@ static StaticStringsTable& staticStrings()
 static bool s_allowCreationOfStaticStrings = true;
 #endif
 
+// Set on the main thread before any other threads exist; once true the
+// static strings table is immutable and may be read without locking.
+static bool s_staticStringsFrozen = false;
+
 const StaticStringsTable& StringImpl::allStaticStrings()
 {
     return staticStrings();
@@ -352,11 +362,24 @@ void StringImpl::freezeStaticStrings()
 {
     ASSERT(isMainThread());
 
+    s_staticStringsFrozen = true;
 #if ENABLE(ASSERT)
     s_allowCreationOfStaticStrings = false;
 #endif
 }
 
+StringImpl* StringImpl::findStaticString(unsigned hash)
+{
+    if (!s_staticStringsFrozen)
+        return 0;
+
+    const StaticStringsTable& table = staticStrings();
+    StaticStringsTable::const_iterator it = table.find(hash);
+    if (it == table.end())
+        return 0;
+    return it->value;
+}
+
 unsigned StringImpl::m_highestStaticStringLength = 0;
 
 StringImpl* StringImpl::createStatic(const char* string, unsigned length, unsigned hash)
@@ -396,6 +419,20 @@ StringImpl* StringImpl::createStatic(const char* string, unsigned length, unsign
     return impl;
 }
 
+StringImpl* StringImpl::m_singleCharacterStrings[256] = { 0 };
+
+void StringImpl::createSingleCharacterStrings()
+{
+    ASSERT(isMainThread());
+    for (unsigned i = 0; i < 256; ++i) {
+        if (m_singleCharacterStrings[i])
+            continue;
+        LChar character = static_cast<LChar>(i);
+        unsigned hash = StringHasher::computeHashAndMaskTop8Bits(&character, 1);
+        m_singleCharacterStrings[i] = createStatic(reinterpret_cast<const char*>(&character), 1, hash);
+    }
+}
+
 PassRefPtr<StringImpl> StringImpl::create(const UChar* characters, unsigned length)
 {
     if (!characters || !length)
@@ -412,6 +449,11 @@ PassRefPtr<StringImpl> StringImpl::create(const LChar* characters, unsigned leng
     if (!characters || !length)
         return empty();
 
+    if (length == 1) {
+        if (StringImpl* cached = m_singleCharacterStrings[characters[0]])
+            return cached;
+    }
+
     LChar* data;
     RefPtr<StringImpl> string = createUninitialized(length, data);
     memcpy(data, characters, length * sizeof(LChar));
@@ -423,6 +465,11 @@ PassRefPtr<StringImpl> StringImpl::create8BitIfPossible(const UChar* characters,
     if (!characters || !length)
         return empty();
 
+    if (length == 1 && !(characters[0] & 0xff00)) {
+        if (StringImpl* cached = m_singleCharacterStrings[characters[0]])
+            return cached;
+    }
+
     LChar* data;
     RefPtr<StringImpl> string = createUninitialized(length, data);
 
@@ -494,6 +541,74 @@ UChar32 StringImpl::characterStartingAt(unsigned i)
     return 0;
 }
 
+static inline bool isLatin1Upper(LChar character)
+{
+    return character >= 0xC0 && character <= 0xDE && character != 0xD7;
+}
+
+// Latin-1 lowercasing maps [0xC0, 0xDE] except the multiplication sign down
+// by 0x20 and leaves every other character unchanged, so it never needs ICU.
+static inline LChar toLatin1Lower(LChar character)
+{
+    if (isASCIIUpper(character) || isLatin1Upper(character))
+        return character + 0x20;
+    return character;
+}
+
+// Scans an 8-bit string for ASCII uppercase letters and non-ASCII
+// characters, 16 bytes at a time where SIMD is available.
+static inline void scanForUpperAndNonASCII(const LChar* characters, unsigned length, bool& hasUpper, bool& hasNonASCII)
+{
+    const LChar* chp = characters;
+    const LChar* end = characters + length;
+    bool blockUpper = false;
+    bool blockNonASCII = false;
+
+#if CPU(X86) || CPU(X86_64)
+    __m128i upperAccumulator = _mm_setzero_si128();
+    __m128i oredAccumulator = _mm_setzero_si128();
+    const __m128i beforeA = _mm_set1_epi8('A' - 1);
+    const __m128i afterZ = _mm_set1_epi8('Z' + 1);
+    while (end - chp >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chp));
+        // Non-ASCII bytes are negative in the signed compares, fail the lower
+        // bound, and so never count as uppercase.
+        __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(chunk, beforeA), _mm_cmplt_epi8(chunk, afterZ));
+        upperAccumulator = _mm_or_si128(upperAccumulator, isUpper);
+        oredAccumulator = _mm_or_si128(oredAccumulator, chunk);
+        chp += 16;
+    }
+    blockUpper = _mm_movemask_epi8(upperAccumulator);
+    blockNonASCII = _mm_movemask_epi8(oredAccumulator);
+#elif HAVE(ARM_NEON_INTRINSICS)
+    uint8x16_t upperAccumulator = vdupq_n_u8(0);
+    uint8x16_t oredAccumulator = vdupq_n_u8(0);
+    const uint8x16_t letterA = vdupq_n_u8('A');
+    const uint8x16_t letterZ = vdupq_n_u8('Z');
+    while (end - chp >= 16) {
+        uint8x16_t chunk = vld1q_u8(chp);
+        uint8x16_t isUpper = vandq_u8(vcgeq_u8(chunk, letterA), vcleq_u8(chunk, letterZ));
+        upperAccumulator = vorrq_u8(upperAccumulator, isUpper);
+        oredAccumulator = vorrq_u8(oredAccumulator, chunk);
+        chp += 16;
+    }
+    uint8x8_t upperHalves = vorr_u8(vget_low_u8(upperAccumulator), vget_high_u8(upperAccumulator));
+    uint8x8_t oredHalves = vorr_u8(vget_low_u8(oredAccumulator), vget_high_u8(oredAccumulator));
+    blockUpper = vget_lane_u64(vreinterpret_u64_u8(upperHalves), 0);
+    blockNonASCII = vget_lane_u64(vreinterpret_u64_u8(oredHalves), 0) & 0x8080808080808080ULL;
+#endif
+
+    LChar ored = 0;
+    bool tailUpper = false;
+    for (; chp != end; ++chp) {
+        if (UNLIKELY(isASCIIUpper(*chp)))
+            tailUpper = true;
+        ored |= *chp;
+    }
+    hasUpper = blockUpper || tailUpper;
+    hasNonASCII = blockNonASCII || (ored & ~0x7F);
+}
+
 PassRefPtr<StringImpl> StringImpl::lower()
 {
     // Note: This is a hot function in the Dromaeo benchmark, specifically the
@@ -503,32 +618,47 @@ PassRefPtr<StringImpl> StringImpl::lower()
     bool noUpper = true;
     UChar ored = 0;
     if (is8Bit()) {
-        const LChar* end = characters8() + m_length;
-        for (const LChar* chp = characters8(); chp != end; ++chp) {
-            if (UNLIKELY(isASCIIUpper(*chp)))
-                noUpper = false;
-            ored |= *chp;
-        }
+        bool hasUpper;
+        bool hasNonASCII;
+        scanForUpperAndNonASCII(characters8(), m_length, hasUpper, hasNonASCII);
+
         // Nothing to do if the string is all ASCII with no uppercase.
-        if (noUpper && !(ored & ~0x7F))
+        if (!hasUpper && !hasNonASCII)
             return this;
 
         RELEASE_ASSERT(m_length <= static_cast<unsigned>(numeric_limits<int32_t>::max()));
         int32_t length = m_length;
 
-        LChar* data8;
-        RefPtr<StringImpl> newImpl = createUninitialized(length, data8);
+        if (!hasNonASCII) {
+            LChar* data8;
+            RefPtr<StringImpl> newImpl = createUninitialized(length, data8);
 
-        if (!(ored & ~0x7F)) {
             for (int32_t i = 0; i < length; ++i)
                 data8[i] = toASCIILower(characters8()[i]);
 
             return newImpl.release();
         }
 
-        // Do a slower implementation for cases that include non-ASCII Latin-1 characters.
+        // The non-ASCII characters are Latin-1, which lowercases without ICU.
+        // A string with no uppercase at all needs no new allocation either.
+        if (!hasUpper) {
+            bool hasLatin1Upper = false;
+            const LChar* end = characters8() + length;
+            for (const LChar* chp = characters8(); chp != end; ++chp) {
+                if (UNLIKELY(isLatin1Upper(*chp))) {
+                    hasLatin1Upper = true;
+                    break;
+                }
+            }
+            if (!hasLatin1Upper)
+                return this;
+        }
+
+        LChar* data8;
+        RefPtr<StringImpl> newImpl = createUninitialized(length, data8);
+
         for (int32_t i = 0; i < length; ++i)
-            data8[i] = static_cast<LChar>(Unicode::toLower(characters8()[i]));
+            data8[i] = toLatin1Lower(characters8()[i]);
 
         return newImpl.release();
     }
@@ -1083,6 +1213,32 @@ float StringImpl::toFloat(bool* ok)
 
 bool equalIgnoringCase(const LChar* a, const LChar* b, unsigned length)
 {
+    // Identical bytes compare equal under folding, so skip over bytewise
+    // equal blocks and drop to the folded per-character compare only once a
+    // block differs somewhere. Case-folded identifier compares are usually
+    // exact matches or differ early.
+#if CPU(X86) || CPU(X86_64)
+    while (length >= 16) {
+        __m128i chunkA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+        __m128i chunkB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(chunkA, chunkB)) != 0xFFFF)
+            break;
+        a += 16;
+        b += 16;
+        length -= 16;
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
+    while (length >= 16) {
+        uint8x16_t equalMask = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+        uint8x8_t halves = vand_u8(vget_low_u8(equalMask), vget_high_u8(equalMask));
+        if (vget_lane_u64(vreinterpret_u64_u8(halves), 0) != 0xFFFFFFFFFFFFFFFFULL)
+            break;
+        a += 16;
+        b += 16;
+        length -= 16;
+    }
+#endif
+
     while (length--) {
         LChar bc = *b++;
         if (foldCase(*a++) != foldCase(bc))
@@ -173,9 +173,19 @@ public:
     ~StringImpl();
 
     static StringImpl* createStatic(const char* string, unsigned length, unsigned hash);
+    // Creates canonical static strings for every one-character 8-bit string.
+    // Must run before freezeStaticStrings() so the strings reach every
+    // thread's AtomicString table; create() then hands them out instead of
+    // allocating.
+    static void createSingleCharacterStrings();
     static void freezeStaticStrings();
     static const StaticStringsTable& allStaticStrings();
     static unsigned highestStaticStringLength() { return m_highestStaticStringLength; }
+    // Returns the static string with this hash, or null. Only returns
+    // non-null after freezeStaticStrings(), when the table is immutable and
+    // safe to read from any thread without synchronization. Callers must
+    // verify the contents: the hash is not a proof of equality.
+    static StringImpl* findStaticString(unsigned hash);
 
     static PassRefPtr<StringImpl> create(const UChar*, unsigned length);
     static PassRefPtr<StringImpl> create(const LChar*, unsigned length);
@@ -411,6 +421,9 @@ private:
 
     static unsigned m_highestStaticStringLength;
 
+    // Entries are null until createSingleCharacterStrings() runs.
+    static StringImpl* m_singleCharacterStrings[256];
+
 #if ENABLE(ASSERT)
     void assertHashIsCorrect()
     {
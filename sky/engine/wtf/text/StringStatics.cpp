@@ -65,6 +65,11 @@ void StringStatics::init()
 {
     ASSERT(isMainThread());
 
+    // Create the static strings before the first AtomicString forces the
+    // main thread's table into existence, so they are registered in it like
+    // in every other thread's table.
+    StringImpl::createSingleCharacterStrings();
+
     // FIXME: These should be allocated at compile time.
     new (NotNull, (void*)&starAtom) AtomicString("*", AtomicString::ConstructFromLiteral);
 }
@@ -27,8 +27,15 @@
 #ifndef SKY_ENGINE_WTF_TEXT_TEXTCODECASCIIFASTPATH_H_
 #define SKY_ENGINE_WTF_TEXT_TEXTCODECASCIIFASTPATH_H_
 
+#include "flutter/sky/engine/wtf/OperatingSystem.h"
 #include "flutter/sky/engine/wtf/text/ASCIIFastPath.h"
 
+#if CPU(X86) || CPU(X86_64)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace WTF {
 
 template<size_t size> struct UCharByteFiller;
@@ -75,6 +82,82 @@ inline void copyASCIIMachineWord(UChar* destination, const uint8_t* source)
     UCharByteFiller<sizeof(WTF::MachineWord)>::copy(destination, source);
 }
 
+// Copies the longest all-ASCII run of whole 16-byte blocks from source to
+// destination, advancing both pointers. Stops when fewer than 16 bytes remain
+// or the next block contains a non-ASCII byte; the caller's machine-word and
+// per-byte loops pick up from there. No alignment requirements on either
+// pointer.
+#if CPU(X86) || CPU(X86_64)
+
+inline void copyASCIIBlocks(LChar*& destination, const uint8_t*& source, const uint8_t* end)
+{
+    while (end - source >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        if (_mm_movemask_epi8(chunk))
+            return;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), chunk);
+        source += 16;
+        destination += 16;
+    }
+}
+
+inline void copyASCIIBlocks(UChar*& destination, const uint8_t*& source, const uint8_t* end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    while (end - source >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        if (_mm_movemask_epi8(chunk))
+            return;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8), _mm_unpackhi_epi8(chunk, zero));
+        source += 16;
+        destination += 16;
+    }
+}
+
+#elif HAVE(ARM_NEON_INTRINSICS)
+
+inline bool isAllASCII(uint8x16_t chunk)
+{
+    uint8x8_t highBits = vorr_u8(vget_low_u8(chunk), vget_high_u8(chunk));
+    return !(vget_lane_u64(vreinterpret_u64_u8(highBits), 0) & 0x8080808080808080ULL);
+}
+
+inline void copyASCIIBlocks(LChar*& destination, const uint8_t*& source, const uint8_t* end)
+{
+    while (end - source >= 16) {
+        uint8x16_t chunk = vld1q_u8(source);
+        if (!isAllASCII(chunk))
+            return;
+        vst1q_u8(reinterpret_cast<uint8_t*>(destination), chunk);
+        source += 16;
+        destination += 16;
+    }
+}
+
+inline void copyASCIIBlocks(UChar*& destination, const uint8_t*& source, const uint8_t* end)
+{
+    while (end - source >= 16) {
+        uint8x16_t chunk = vld1q_u8(source);
+        if (!isAllASCII(chunk))
+            return;
+        vst1q_u16(reinterpret_cast<uint16_t*>(destination), vmovl_u8(vget_low_u8(chunk)));
+        vst1q_u16(reinterpret_cast<uint16_t*>(destination + 8), vmovl_u8(vget_high_u8(chunk)));
+        source += 16;
+        destination += 16;
+    }
+}
+
+#else
+
+template<typename CharacterType>
+inline void copyASCIIBlocks(CharacterType*&, const uint8_t*&, const uint8_t*)
+{
+    // No vector unit; the caller's machine-word loop handles bulk ASCII.
+}
+
+#endif
+
 } // namespace WTF
 
 #endif  // SKY_ENGINE_WTF_TEXT_TEXTCODECASCIIFASTPATH_H_
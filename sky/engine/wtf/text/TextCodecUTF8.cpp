@@ -296,6 +296,11 @@ String TextCodecUTF8::decode(const char* bytes, size_t length, FlushBehavior flu
         while (source < end) {
             if (isASCII(*source)) {
                 // Fast path for ASCII. Most UTF-8 text will be ASCII.
+                copyASCIIBlocks(destination, source, end);
+                if (source == end)
+                    break;
+                if (!isASCII(*source))
+                    continue;
                 if (isAlignedToMachineWord(source)) {
                     while (source < alignedEnd) {
                         MachineWord chunk = *reinterpret_cast_ptr<const MachineWord*>(source);
@@ -373,6 +378,11 @@ upConvertTo16Bit:
         while (source < end) {
             if (isASCII(*source)) {
                 // Fast path for ASCII. Most UTF-8 text will be ASCII.
+                copyASCIIBlocks(destination16, source, end);
+                if (source == end)
+                    break;
+                if (!isASCII(*source))
+                    continue;
                 if (isAlignedToMachineWord(source)) {
                     while (source < alignedEnd) {
                         MachineWord chunk = *reinterpret_cast_ptr<const MachineWord*>(source);
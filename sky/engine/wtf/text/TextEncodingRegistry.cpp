@@ -115,6 +115,100 @@ static TextEncodingNameMap* textEncodingNameMap;
 static TextCodecMap* textCodecMap;
 static bool didExtendTextCodecMaps;
 
+// The canonical names of the base codecs. These arrays are the atomic name
+// pointers for their encodings everywhere, including inside the dynamic maps,
+// so pointer comparisons of canonical names keep working when some lookups
+// are answered from the static table and others from the registry.
+static const char canonicalWindows1252[] = "windows-1252";
+static const char canonicalISO88591[] = "ISO-8859-1";
+static const char canonicalUSASCII[] = "US-ASCII";
+static const char canonicalUTF8[] = "UTF-8";
+static const char canonicalUTF16LE[] = "UTF-16LE";
+static const char canonicalUTF16BE[] = "UTF-16BE";
+static const char canonicalXUserDefined[] = "x-user-defined";
+
+struct StaticEncodingName {
+    const char* alias; // Lower-cased.
+    const char* atomicName;
+};
+
+// Every alias the base codecs (Latin-1, UTF-8, UTF-16, x-user-defined)
+// register, resolved at compile time. Lookups probe this table first -
+// without taking the registry mutex or building the dynamic maps - and only
+// extension codec aliases (ICU, replacement) fall through to the registry.
+// Sorted by alias for binary search; keep in sync with the codecs'
+// registerEncodingNames implementations.
+static const StaticEncodingName staticEncodingNames[] = {
+    { "ansi_x3.4-1968", canonicalUSASCII },
+    { "ansi_x3.4-1986", canonicalUSASCII },
+    { "ascii", canonicalUSASCII },
+    { "cp367", canonicalUSASCII },
+    { "cp819", canonicalISO88591 },
+    { "csascii", canonicalUSASCII },
+    { "csisolatin1", canonicalISO88591 },
+    { "csunicode", canonicalUTF16LE },
+    { "ibm-1252", canonicalWindows1252 },
+    { "ibm-1252_p100-2000", canonicalWindows1252 },
+    { "ibm-367_p100-1995", canonicalUSASCII },
+    { "ibm367", canonicalUSASCII },
+    { "ibm819", canonicalISO88591 },
+    { "iso-10646-ucs-2", canonicalUTF16LE },
+    { "iso-8859-1", canonicalISO88591 },
+    { "iso-ir-100", canonicalISO88591 },
+    { "iso-ir-6", canonicalUSASCII },
+    { "iso-ir-6-us", canonicalUSASCII },
+    { "iso646-us", canonicalUSASCII },
+    { "iso_646.irv:1991", canonicalUSASCII },
+    { "iso_8859-1:1987", canonicalISO88591 },
+    { "l1", canonicalISO88591 },
+    { "latin1", canonicalISO88591 },
+    { "ucs-2", canonicalUTF16LE },
+    { "unicode", canonicalUTF16LE },
+    { "unicode-1-1-utf-8", canonicalUTF8 },
+    { "unicode11utf8", canonicalUTF8 },
+    { "unicode20utf8", canonicalUTF8 },
+    { "unicodefeff", canonicalUTF16LE },
+    { "unicodefffe", canonicalUTF16BE },
+    { "us", canonicalUSASCII },
+    { "us-ascii", canonicalUSASCII },
+    { "utf-16", canonicalUTF16LE },
+    { "utf-16be", canonicalUTF16BE },
+    { "utf-16le", canonicalUTF16LE },
+    { "utf-8", canonicalUTF8 },
+    { "utf8", canonicalUTF8 },
+    { "windows-1252", canonicalWindows1252 },
+    { "winlatin1", canonicalWindows1252 },
+    { "x-ansi", canonicalUSASCII },
+    { "x-unicode20utf8", canonicalUTF8 },
+    { "x-user-defined", canonicalXUserDefined },
+};
+
+static const char* findStaticEncodingName(const char* name)
+{
+    char loweredName[maxEncodingNameLength + 1];
+    size_t length = 0;
+    for (; name[length]; ++length) {
+        if (length == maxEncodingNameLength)
+            return 0;
+        loweredName[length] = toASCIILower(name[length]);
+    }
+    loweredName[length] = 0;
+
+    size_t low = 0;
+    size_t high = WTF_ARRAY_LENGTH(staticEncodingNames);
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int comparison = strcmp(loweredName, staticEncodingNames[mid].alias);
+        if (!comparison)
+            return staticEncodingNames[mid].atomicName;
+        if (comparison < 0)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return 0;
+}
+
 static const char textEncodingNameBlacklist[][6] = { "UTF-7" };
 
 #if ERROR_DISABLED
@@ -159,7 +253,11 @@ static void addToTextEncodingNameMap(const char* alias, const char* name)
     ASSERT(strlen(alias) <= maxEncodingNameLength);
     if (isUndesiredAlias(alias))
         return;
-    const char* atomicName = textEncodingNameMap->get(name);
+    // Prefer the static table so base encodings keep a single atomic name
+    // pointer no matter which codec registered the alias.
+    const char* atomicName = findStaticEncodingName(name);
+    if (!atomicName)
+        atomicName = textEncodingNameMap->get(name);
     ASSERT(strcmp(alias, name) == 0 || atomicName);
     if (!atomicName)
         atomicName = name;
@@ -169,7 +267,9 @@ static void addToTextEncodingNameMap(const char* alias, const char* name)
 
 static void addToTextCodecMap(const char* name, NewTextCodecFunction function, const void* additionalData)
 {
-    const char* atomicName = textEncodingNameMap->get(name);
+    const char* atomicName = findStaticEncodingName(name);
+    if (!atomicName)
+        atomicName = textEncodingNameMap->get(name);
     ASSERT(atomicName);
     textCodecMap->add(atomicName, TextCodecFactory(function, additionalData));
 }
@@ -240,6 +340,11 @@ static void extendTextCodecMaps()
 
 PassOwnPtr<TextCodec> newTextCodec(const TextEncoding& encoding)
 {
+    // The encoding's name may have been canonicalized entirely from the
+    // static table, so the codec maps are not necessarily built yet.
+    if (!textCodecMap)
+        buildBaseTextCodecMaps();
+
     MutexLocker lock(encodingRegistryMutex());
 
     ASSERT(textCodecMap);
@@ -252,6 +357,12 @@ const char* atomicCanonicalTextEncodingName(const char* name)
 {
     if (!name || !name[0])
         return 0;
+
+    // Lock-free fast path for the base codecs' aliases; this answers nearly
+    // every lookup without building or consulting the dynamic maps.
+    if (const char* atomicName = findStaticEncodingName(name))
+        return atomicName;
+
     if (!textEncodingNameMap)
         buildBaseTextCodecMaps();
 
@@ -0,0 +1,108 @@
+#!/usr/bin/env python
+# Copyright 2017 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Run a shell binary repeatedly and aggregate its startup milestones.
+
+The engine writes a JSON object of startup milestone timestamps (see
+flutter/runtime/start_up.h) when launched with --startup-metrics-file.
+This harness launches the given shell command several times, collects
+those files, and reports the median and spread of each phase relative to
+engine_main_enter as machine-readable JSON, suitable for CI tracking and
+lab devices alike.
+
+Example:
+  startup_benchmark.py --runs 10 -- \\
+      out/Release/sky_shell --non-interactive path/to/main.dart
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+# Reported in dependency order; each value is microseconds since
+# engine_main_enter.
+PHASES = [
+    'vm_initialized',
+    'isolate_created',
+    'run_bundle_complete',
+    'first_begin_frame',
+    'first_frame_presented',
+]
+
+
+def median(values):
+  ordered = sorted(values)
+  middle = len(ordered) // 2
+  if len(ordered) % 2:
+    return ordered[middle]
+  return (ordered[middle - 1] + ordered[middle]) / 2.0
+
+
+def run_once(command):
+  handle, metrics_path = tempfile.mkstemp(suffix='.json')
+  os.close(handle)
+  try:
+    subprocess.check_call(command + ['--startup-metrics-file=%s' % metrics_path])
+    with open(metrics_path) as metrics_file:
+      return json.load(metrics_file)
+  finally:
+    os.unlink(metrics_path)
+
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Aggregate engine startup milestones over repeated runs')
+  parser.add_argument('--runs', type=int, default=5,
+                      help='number of launches to aggregate')
+  parser.add_argument('--output', help='write the report here instead of stdout')
+  parser.add_argument('command', nargs=argparse.REMAINDER,
+                      help='shell command to launch (prefix with --)')
+  args = parser.parse_args()
+
+  command = args.command
+  if command and command[0] == '--':
+    command = command[1:]
+  if not command:
+    parser.error('no shell command given')
+
+  samples = {phase: [] for phase in PHASES}
+  for _ in range(args.runs):
+    milestones = run_once(command)
+    if 'engine_main_enter' not in milestones:
+      # Without the embedder's entry timestamp the offsets below would be
+      # meaningless; the shell must record engine_main_enter_ts.
+      sys.stderr.write('run did not record engine_main_enter; skipping\n')
+      continue
+    origin = milestones['engine_main_enter']
+    for phase in PHASES:
+      if phase in milestones:
+        samples[phase].append(milestones[phase] - origin)
+
+  report = {'runs': args.runs, 'phases': {}}
+  for phase in PHASES:
+    values = samples[phase]
+    if not values:
+      continue
+    report['phases'][phase] = {
+        'median_us': median(values),
+        'min_us': min(values),
+        'max_us': max(values),
+        'samples': len(values),
+    }
+
+  text = json.dumps(report, indent=2, sort_keys=True)
+  if args.output:
+    with open(args.output, 'w') as output_file:
+      output_file.write(text + '\n')
+  else:
+    print(text)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
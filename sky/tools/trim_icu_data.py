@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# Copyright 2017 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Produce a trimmed ICU data slice for a declared set of locales.
+
+Extracts the item list from the full icudtl.dat with icupkg, drops
+locale-dependent items (locale resources, collation, break iterator and
+region data) for every locale the application did not declare, and repacks
+the remainder as icudtl_minimal.dat. The engine prefers this slice over the
+full data file when it is present next to the executable or in the resource
+bundle; see fml/icu_util.cc.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# Trees whose per-locale items can be dropped for undeclared locales. Items
+# outside these trees (converters, normalization, time zone data, the root
+# locale) are always retained.
+LOCALE_TREES = ['', 'brkitr/', 'coll/', 'curr/', 'lang/', 'rbnf/', 'region/',
+                'unit/', 'zone/']
+
+ALWAYS_KEEP = ['root', 'res_index', 'pool']
+
+
+def item_locale(item):
+  """Returns the locale of a per-locale item, or None if it is not one."""
+  for tree in LOCALE_TREES:
+    match = re.match(r'^%s([A-Za-z0-9_]+)\.res$' % re.escape(tree), item)
+    if match:
+      return match.group(1)
+  return None
+
+
+def locale_matches(locale, declared):
+  # 'en_US' is covered by a declared 'en' and vice versa.
+  parts = locale.split('_')
+  for declared_locale in declared:
+    declared_parts = declared_locale.split('_')
+    length = min(len(parts), len(declared_parts))
+    if parts[:length] == declared_parts[:length]:
+      return True
+  return False
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--icupkg', default='icupkg',
+                      help='Path to the icupkg binary from the ICU build')
+  parser.add_argument('--input', required=True,
+                      help='Path to the full icudtl.dat')
+  parser.add_argument('--output', required=True,
+                      help='Path for the trimmed icudtl_minimal.dat')
+  parser.add_argument('--locales', required=True,
+                      help='Comma-separated declared locales, e.g. "en_US,es"')
+
+  args = parser.parse_args()
+  declared = [locale.strip() for locale in args.locales.split(',') if locale]
+
+  work_dir = tempfile.mkdtemp()
+  try:
+    items = subprocess.check_output(
+        [args.icupkg, '--list', args.input]).splitlines()
+
+    remove_list = os.path.join(work_dir, 'remove.lst')
+    removed = 0
+    with open(remove_list, 'w') as remove_file:
+      for item in items:
+        item = item.strip()
+        locale = item_locale(item)
+        if locale is None or locale in ALWAYS_KEEP:
+          continue
+        if not locale_matches(locale, declared):
+          remove_file.write(item + '\n')
+          removed += 1
+
+    shutil.copyfile(args.input, args.output)
+    subprocess.check_call(
+        [args.icupkg, '--remove', remove_list, args.output])
+
+    print 'Removed %d items; %s: %d bytes, %s: %d bytes' % (
+        removed, args.input, os.path.getsize(args.input),
+        args.output, os.path.getsize(args.output))
+  finally:
+    shutil.rmtree(work_dir)
+
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
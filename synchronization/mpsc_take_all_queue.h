@@ -0,0 +1,82 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SYNCHRONIZATION_MPSC_TAKE_ALL_QUEUE_H_
+#define SYNCHRONIZATION_MPSC_TAKE_ALL_QUEUE_H_
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_counted.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace flutter {
+
+/// An unbounded multiple-producer single-consumer queue for batching
+/// cross-thread events. Producers push with a single atomic exchange and no
+/// lock or syscall; the consumer detaches the entire backlog in O(1) with
+/// TakeAll and receives the elements in enqueue order. Enqueue reports the
+/// empty-to-non-empty transition so producers can post exactly one wakeup
+/// task per burst instead of one per event.
+template <class T>
+class MPSCTakeAllQueue : public ftl::RefCountedThreadSafe<MPSCTakeAllQueue<T>> {
+ public:
+  MPSCTakeAllQueue() : head_(nullptr) {}
+
+  ~MPSCTakeAllQueue() {
+    Node* node = head_.load(std::memory_order_relaxed);
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  /// May be called from any thread. Returns true when the queue was empty,
+  /// i.e. the caller is responsible for waking the consumer.
+  bool Enqueue(std::unique_ptr<T> value) {
+    Node* node = new Node(std::move(value));
+    Node* old_head = head_.load(std::memory_order_relaxed);
+    do {
+      node->next = old_head;
+    } while (!head_.compare_exchange_weak(old_head, node,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+    return old_head == nullptr;
+  }
+
+  /// May only be called from the consumer thread. Elements enqueued after the
+  /// internal detach are left for the next call.
+  std::vector<std::unique_ptr<T>> TakeAll() {
+    std::vector<std::unique_ptr<T>> values;
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+    // The list is in push order, i.e. newest first; reverse while draining.
+    while (node != nullptr) {
+      values.push_back(std::move(node->value));
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+    std::reverse(values.begin(), values.end());
+    return values;
+  }
+
+ private:
+  struct Node {
+    explicit Node(std::unique_ptr<T> node_value)
+        : value(std::move(node_value)), next(nullptr) {}
+    std::unique_ptr<T> value;
+    Node* next;
+  };
+
+  std::atomic<Node*> head_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(MPSCTakeAllQueue);
+};
+
+}  // namespace flutter
+
+#endif  // SYNCHRONIZATION_MPSC_TAKE_ALL_QUEUE_H_
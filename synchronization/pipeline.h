@@ -12,9 +12,12 @@
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/ref_counted.h"
 #include "lib/ftl/synchronization/mutex.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
 
 #include <memory>
 #include <queue>
+#include <tuple>
 
 namespace flutter {
 
@@ -81,12 +84,52 @@ class Pipeline : public ftl::RefCountedThreadSafe<Pipeline<R>> {
   };
 
   explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), last_trace_id_(0) {}
+      : empty_(depth),
+        available_(0),
+        depth_(depth),
+        pending_depth_reductions_(0),
+        last_trace_id_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  uint32_t GetDepth() const {
+    ftl::MutexLocker lock(&queue_mutex_);
+    return depth_;
+  }
+
+  /// Adjusts the number of resources that may be in flight at once. A depth
+  /// of 1 minimizes input-to-present latency while a deeper pipeline
+  /// maximizes throughput. Reductions that cannot be absorbed immediately
+  /// (because the spots are occupied) take effect as in-flight resources
+  /// are consumed.
+  void SetDepth(uint32_t depth) {
+    if (depth == 0) {
+      return;
+    }
+    ftl::MutexLocker lock(&queue_mutex_);
+    while (depth_ < depth) {
+      empty_.Signal();
+      depth_++;
+    }
+    while (depth_ > depth) {
+      if (empty_.TryWait()) {
+        depth_--;
+      } else {
+        pending_depth_reductions_ += depth_ - depth;
+        depth_ = depth;
+        break;
+      }
+    }
+  }
+
+  /// The enqueue-to-consume latency of the most recently consumed resource.
+  ftl::TimeDelta GetLastConsumeLatency() const {
+    ftl::MutexLocker lock(&queue_mutex_);
+    return last_consume_latency_;
+  }
+
   ProducerContinuation Produce() {
     if (!empty_.TryWait()) {
       return {};
@@ -113,20 +156,32 @@ class Pipeline : public ftl::RefCountedThreadSafe<Pipeline<R>> {
     ResourcePtr resource;
     size_t trace_id = 0;
     size_t items_count = 0;
+    bool signal_empty = true;
 
     {
       ftl::MutexLocker lock(&queue_mutex_);
-      std::tie(resource, trace_id) = std::move(queue_.front());
+      ftl::TimePoint enqueue_time;
+      std::tie(resource, trace_id, enqueue_time) = std::move(queue_.front());
       queue_.pop();
       items_count = queue_.size();
+      last_consume_latency_ = ftl::TimePoint::Now() - enqueue_time;
+      // Absorb deferred depth reductions instead of reopening the spot.
+      if (pending_depth_reductions_ > 0) {
+        pending_depth_reductions_--;
+        signal_empty = false;
+      }
     }
 
+    TRACE_EVENT_ASYNC_END0("flutter", "PipelineLatency", trace_id);
+
     {
       TRACE_EVENT0("flutter", "PipelineConsume");
       consumer(std::move(resource));
     }
 
-    empty_.Signal();
+    if (signal_empty) {
+      empty_.Signal();
+    }
 
     return items_count > 0 ? PipelineConsumeResult::MoreAvailable
                            : PipelineConsumeResult::Done;
@@ -135,16 +190,21 @@ class Pipeline : public ftl::RefCountedThreadSafe<Pipeline<R>> {
  private:
   Semaphore empty_;
   Semaphore available_;
-  ftl::Mutex queue_mutex_;
-  std::queue<std::pair<ResourcePtr, size_t>> queue_;
+  mutable ftl::Mutex queue_mutex_;
+  std::queue<std::tuple<ResourcePtr, size_t, ftl::TimePoint>> queue_;
+  uint32_t depth_;
+  uint32_t pending_depth_reductions_;
+  ftl::TimeDelta last_consume_latency_;
   std::atomic_size_t last_trace_id_;
 
   void ProducerCommit(ResourcePtr resource, size_t trace_id) {
     {
       ftl::MutexLocker lock(&queue_mutex_);
-      queue_.emplace(std::move(resource), trace_id);
+      queue_.emplace(std::move(resource), trace_id, ftl::TimePoint::Now());
     }
 
+    TRACE_EVENT_ASYNC_BEGIN0("flutter", "PipelineLatency", trace_id);
+
     // Ensure the queue mutex is not held as that would be a pessimization.
     available_.Signal();
   }
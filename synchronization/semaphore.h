@@ -5,31 +5,44 @@
 #ifndef SYNCHRONIZATION_SEMAPHORE_H_
 #define SYNCHRONIZATION_SEMAPHORE_H_
 
-#include <memory>
+#include <atomic>
+#include <cstdint>
 
-#include "lib/ftl/macros.h"
-#include "lib/ftl/time/time_delta.h"
 #include "lib/ftl/compiler_specific.h"
+#include "lib/ftl/macros.h"
 
 namespace flutter {
 
-class PlatformSemaphore;
-
+// A counting semaphore without a blocking wait. Every use in the engine is
+// TryWait/Signal - the pipeline and the animator poll and reschedule via
+// their message loops instead of parking a thread - so the count is a plain
+// atomic and both operations are a few instructions with no syscall,
+// allocation, or platform handle on any OS.
 class Semaphore {
  public:
-  explicit Semaphore(uint32_t count);
+  explicit Semaphore(uint32_t count) : count_(count) {}
 
-  ~Semaphore();
+  ~Semaphore() = default;
 
-  bool IsValid() const;
+  bool IsValid() const { return true; }
 
   FTL_WARN_UNUSED_RESULT
-  bool TryWait();
-
-  void Signal();
+  bool TryWait() {
+    int64_t count = count_.load(std::memory_order_relaxed);
+    while (count > 0) {
+      if (count_.compare_exchange_weak(count, count - 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Signal() { count_.fetch_add(1, std::memory_order_release); }
 
  private:
-  std::unique_ptr<PlatformSemaphore> _impl;
+  std::atomic<int64_t> count_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(Semaphore);
 };
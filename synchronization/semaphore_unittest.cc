@@ -25,3 +25,21 @@ TEST(SemaphoreTest, WaitOnZeroSignalThenWait) {
   ASSERT_TRUE(sem.TryWait());
   ASSERT_FALSE(sem.TryWait());
 }
+
+TEST(SemaphoreTest, ConcurrentSignalsAllAccountedFor) {
+  const int kSignalsPerThread = 10000;
+  flutter::Semaphore sem(0);
+  std::thread signaler_a([&sem]() {
+    for (int i = 0; i < kSignalsPerThread; i++)
+      sem.Signal();
+  });
+  std::thread signaler_b([&sem]() {
+    for (int i = 0; i < kSignalsPerThread; i++)
+      sem.Signal();
+  });
+  signaler_a.join();
+  signaler_b.join();
+  for (int i = 0; i < 2 * kSignalsPerThread; i++)
+    ASSERT_TRUE(sem.TryWait());
+  ASSERT_FALSE(sem.TryWait());
+}
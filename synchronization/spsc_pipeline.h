@@ -0,0 +1,228 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SYNCHRONIZATION_SPSC_PIPELINE_H_
+#define SYNCHRONIZATION_SPSC_PIPELINE_H_
+
+#include "flutter/glue/trace_event.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_counted.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace flutter {
+
+enum class SPSCPipelineConsumeResult {
+  NoneAvailable,
+  Done,
+  MoreAvailable,
+};
+
+/// A single-producer single-consumer variant of flutter::Pipeline backed by a
+/// fixed-capacity ring instead of a mutex-guarded queue. Produce and Commit
+/// must be called from one thread (the UI thread) and Consume from one other
+/// thread (the GPU thread); under that contract head and tail only need
+/// acquire/release atomics and neither side ever takes a lock or makes a
+/// syscall. Since the Pipeline API is already non-blocking (producers and
+/// consumers poll and reschedule via their message loops), no blocking
+/// fallback is required.
+template <class R>
+class SPSCPipeline : public ftl::RefCountedThreadSafe<SPSCPipeline<R>> {
+ public:
+  using Resource = R;
+  using ResourcePtr = std::unique_ptr<Resource>;
+
+  /// Denotes a spot in the pipeline reserved for the producer to finish
+  /// preparing a completed pipeline resource.
+  class ProducerContinuation {
+   public:
+    ProducerContinuation() : trace_id_(0) {}
+
+    ProducerContinuation(ProducerContinuation&& other)
+        : continuation_(other.continuation_), trace_id_(other.trace_id_) {
+      other.continuation_ = nullptr;
+      other.trace_id_ = 0;
+    }
+
+    ProducerContinuation& operator=(ProducerContinuation&& other) {
+      std::swap(continuation_, other.continuation_);
+      std::swap(trace_id_, other.trace_id_);
+      return *this;
+    }
+
+    ~ProducerContinuation() {
+      if (continuation_) {
+        continuation_(nullptr, trace_id_);
+        TRACE_EVENT_ASYNC_END0("flutter", "PipelineProduce", trace_id_);
+      }
+    }
+
+    void Complete(ResourcePtr resource) {
+      if (continuation_) {
+        continuation_(std::move(resource), trace_id_);
+        continuation_ = nullptr;
+        TRACE_EVENT_ASYNC_END0("flutter", "PipelineProduce", trace_id_);
+      }
+    }
+
+    operator bool() const { return continuation_ != nullptr; }
+
+   private:
+    friend class SPSCPipeline;
+    using Continuation = std::function<void(ResourcePtr, size_t)>;
+
+    Continuation continuation_;
+    size_t trace_id_;
+
+    ProducerContinuation(Continuation continuation, size_t trace_id)
+        : continuation_(continuation), trace_id_(trace_id) {
+      TRACE_EVENT_ASYNC_BEGIN0("flutter", "PipelineProduce", trace_id_);
+    }
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
+  };
+
+  explicit SPSCPipeline(uint32_t depth)
+      : depth_(depth < kCapacity ? depth : kCapacity - 1),
+        last_consume_latency_micros_(0),
+        reserved_(0),
+        tail_(0),
+        head_(0),
+        last_trace_id_(0) {}
+
+  ~SPSCPipeline() = default;
+
+  bool IsValid() const { return true; }
+
+  uint32_t GetDepth() const { return depth_.load(std::memory_order_relaxed); }
+
+  /// Adjusts the number of resources that may be in flight at once. A depth
+  /// of 1 minimizes input-to-present latency while a deeper pipeline
+  /// maximizes throughput. Takes effect on the next Produce call; reductions
+  /// never discard resources already in flight.
+  void SetDepth(uint32_t depth) {
+    if (depth == 0 || depth >= kCapacity) {
+      return;
+    }
+    depth_.store(depth, std::memory_order_relaxed);
+  }
+
+  /// The enqueue-to-consume latency of the most recently consumed resource.
+  ftl::TimeDelta GetLastConsumeLatency() const {
+    return ftl::TimeDelta::FromMicroseconds(
+        last_consume_latency_micros_.load(std::memory_order_relaxed));
+  }
+
+  ProducerContinuation Produce() {
+    // |tail_| and |reserved_| are owned by the producer thread; only |head_|
+    // can move underneath us, and it only ever opens spots up.
+    size_t in_flight = tail_.load(std::memory_order_relaxed) + reserved_ -
+                       head_.load(std::memory_order_acquire);
+    if (in_flight >= depth_.load(std::memory_order_relaxed)) {
+      return {};
+    }
+    reserved_++;
+
+    return ProducerContinuation{
+        std::bind(&SPSCPipeline::ProducerCommit, this, std::placeholders::_1,
+                  std::placeholders::_2),  // continuation
+        ++last_trace_id_};                 // trace id
+  }
+
+  using Consumer = std::function<void(ResourcePtr)>;
+
+  FTL_WARN_UNUSED_RESULT
+  SPSCPipelineConsumeResult Consume(Consumer consumer) {
+    if (consumer == nullptr) {
+      return SPSCPipelineConsumeResult::NoneAvailable;
+    }
+
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return SPSCPipelineConsumeResult::NoneAvailable;
+    }
+
+    Slot& slot = slots_[head % kCapacity];
+    ResourcePtr resource = std::move(slot.resource);
+    size_t trace_id = slot.trace_id;
+    last_consume_latency_micros_.store(
+        (ftl::TimePoint::Now() - slot.enqueue_time).ToMicroseconds(),
+        std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+
+    TRACE_EVENT_ASYNC_END0("flutter", "PipelineLatency", trace_id);
+
+    {
+      TRACE_EVENT0("flutter", "PipelineConsume");
+      consumer(std::move(resource));
+    }
+
+    return tail - head > 1 ? SPSCPipelineConsumeResult::MoreAvailable
+                           : SPSCPipelineConsumeResult::Done;
+  }
+
+  /// Discards every pending resource except the most recently produced one.
+  /// May only be called from the consumer thread. Returns the number of
+  /// resources dropped.
+  size_t DropAllButNewest() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t dropped = 0;
+    while (tail - head > 1) {
+      Slot& slot = slots_[head % kCapacity];
+      slot.resource.reset();
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineLatency", slot.trace_id);
+      head++;
+      head_.store(head, std::memory_order_release);
+      dropped++;
+    }
+    return dropped;
+  }
+
+ private:
+  // Sized so the index arithmetic reduces to a mask while leaving headroom
+  // over any depth an embedder would configure.
+  static const size_t kCapacity = 8;
+
+  struct Slot {
+    ResourcePtr resource;
+    size_t trace_id;
+    ftl::TimePoint enqueue_time;
+  };
+
+  Slot slots_[kCapacity];
+  std::atomic<uint32_t> depth_;
+  std::atomic<int64_t> last_consume_latency_micros_;
+  // Spots handed out via Produce whose continuations have not committed yet.
+  // Only touched on the producer thread.
+  size_t reserved_;
+  // The producer publishes through |tail_|, the consumer through |head_|.
+  // Each lives on its own cache line so the two threads do not false-share.
+  alignas(64) std::atomic<size_t> tail_;
+  alignas(64) std::atomic<size_t> head_;
+  std::atomic_size_t last_trace_id_;
+
+  void ProducerCommit(ResourcePtr resource, size_t trace_id) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[tail % kCapacity];
+    slot.resource = std::move(resource);
+    slot.trace_id = trace_id;
+    slot.enqueue_time = ftl::TimePoint::Now();
+    reserved_--;
+    tail_.store(tail + 1, std::memory_order_release);
+
+    TRACE_EVENT_ASYNC_BEGIN0("flutter", "PipelineLatency", trace_id);
+  }
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(SPSCPipeline);
+};
+
+}  // namespace flutter
+
+#endif  // SYNCHRONIZATION_SPSC_PIPELINE_H_
@@ -120,6 +120,10 @@ bool VulkanBackbuffer::ResetFences() {
          VK_SUCCESS;
 }
 
+bool VulkanBackbuffer::ResetCommandBuffers() {
+  return usage_command_buffer_.Reset() && render_command_buffer_.Reset();
+}
+
 const VulkanHandle<VkFence>& VulkanBackbuffer::GetUsageFence() const {
   return use_fences_[0];
 }
@@ -32,6 +32,9 @@ class VulkanBackbuffer {
   FTL_WARN_UNUSED_RESULT
   bool ResetFences();
 
+  FTL_WARN_UNUSED_RESULT
+  bool ResetCommandBuffers();
+
   const VulkanHandle<VkFence>& GetUsageFence() const;
 
   const VulkanHandle<VkFence>& GetRenderFence() const;
@@ -48,6 +48,10 @@ VkCommandBuffer VulkanCommandBuffer::Handle() const {
   return handle_;
 }
 
+bool VulkanCommandBuffer::Reset() const {
+  return VK_CALL_LOG_ERROR(vk.ResetCommandBuffer(handle_, 0)) == VK_SUCCESS;
+}
+
 bool VulkanCommandBuffer::Begin() const {
   const VkCommandBufferBeginInfo info{
       .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
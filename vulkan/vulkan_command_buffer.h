@@ -25,6 +25,11 @@ class VulkanCommandBuffer {
 
   VkCommandBuffer Handle() const;
 
+  /// Return the command buffer to the recording-ready state, releasing any
+  /// resources it referenced, without giving its allocation back to the pool.
+  FTL_WARN_UNUSED_RESULT
+  bool Reset() const;
+
   FTL_WARN_UNUSED_RESULT
   bool Begin() const;
 
@@ -316,6 +316,7 @@ bool VulkanDevice::ChooseSurfaceFormat(const VulkanSurface& surface,
 }
 
 bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
+                                     VkPresentModeKHR preferred_mode,
                                      VkPresentModeKHR* present_mode) const {
   if (!surface.IsValid() || present_mode == nullptr) {
     return false;
@@ -328,9 +329,37 @@ bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
   // powered by Vsync pulses instead of depending the the submit to block.
   // However, for platforms that don't have VSync providers setup, it is better
   // to fall back to FIFO. For platforms that do have VSync providers, there
-  // should be little difference. In case there is a need for a mode other than
-  // FIFO, availability checks must be performed here before returning the
-  // result. FIFO is always present.
+  // should be little difference. FIFO is always present, so it is both the
+  // default preference and the fallback when the caller prefers a mode the
+  // surface does not support.
+  if (preferred_mode == VK_PRESENT_MODE_FIFO_KHR) {
+    *present_mode = VK_PRESENT_MODE_FIFO_KHR;
+    return true;
+  }
+
+  uint32_t mode_count = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, nullptr)) !=
+      VK_SUCCESS) {
+    return false;
+  }
+
+  std::vector<VkPresentModeKHR> modes;
+  modes.resize(mode_count);
+
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, modes.data())) !=
+      VK_SUCCESS) {
+    return false;
+  }
+
+  for (VkPresentModeKHR mode : modes) {
+    if (mode == preferred_mode) {
+      *present_mode = preferred_mode;
+      return true;
+    }
+  }
+
   *present_mode = VK_PRESENT_MODE_FIFO_KHR;
   return true;
 }
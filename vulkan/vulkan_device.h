@@ -54,6 +54,7 @@ class VulkanDevice {
 
   FTL_WARN_UNUSED_RESULT
   bool ChoosePresentMode(const VulkanSurface& surface,
+                         VkPresentModeKHR preferred_mode,
                          VkPresentModeKHR* present_mode) const;
 
   FTL_WARN_UNUSED_RESULT
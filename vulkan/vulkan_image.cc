@@ -66,4 +66,59 @@ bool VulkanImage::InsertImageMemoryBarrier(
   return success;
 }
 
+bool VulkanImage::InsertImageMemoryBarriers(
+    const VulkanCommandBuffer& command_buffer,
+    const std::vector<VulkanImage*>& images,
+    VkPipelineStageFlagBits src_pipline_bits,
+    VkPipelineStageFlagBits dest_pipline_bits,
+    VkAccessFlagBits dest_access_flags,
+    VkImageLayout dest_layout) {
+  if (images.size() == 0) {
+    return true;
+  }
+
+  std::vector<VkImageMemoryBarrier> barriers;
+  barriers.reserve(images.size());
+
+  for (VulkanImage* image : images) {
+    if (image == nullptr || !image->IsValid()) {
+      return false;
+    }
+
+    barriers.push_back({
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = image->access_flags_,
+        .dstAccessMask = dest_access_flags,
+        .oldLayout = image->layout_,
+        .newLayout = dest_layout,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = image->handle_,
+        .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1},
+    });
+  }
+
+  bool success = command_buffer.InsertPipelineBarrier(
+      src_pipline_bits,                        // src_stage_flags
+      dest_pipline_bits,                       // dest_stage_flags
+      0,                                       // dependency_flags
+      0,                                       // memory_barrier_count
+      nullptr,                                 // memory_barriers
+      0,                                       // buffer_memory_barrier_count
+      nullptr,                                 // buffer_memory_barriers
+      static_cast<uint32_t>(barriers.size()),  // image_memory_barrier_count
+      barriers.data()                          // image_memory_barriers
+      );
+
+  if (success) {
+    for (VulkanImage* image : images) {
+      image->access_flags_ = dest_access_flags;
+      image->layout_ = dest_layout;
+    }
+  }
+
+  return success;
+}
+
 }  // namespace vulkan
@@ -4,6 +4,9 @@
 
 #include "flutter/vulkan/vulkan_swapchain.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "flutter/vulkan/vulkan_backbuffer.h"
 #include "flutter/vulkan/vulkan_device.h"
 #include "flutter/vulkan/vulkan_image.h"
@@ -14,6 +17,25 @@
 
 namespace vulkan {
 
+// The number of present times to keep for cadence estimation.
+static const size_t kRecentPresentTimesToTrack = 16;
+
+// Process-wide swapchain preferences. These are picked up the next time a
+// swapchain is created, which makes recreation (a resize or an out-of-date
+// surface) the natural point at which a changed preference takes effect. Set
+// on the platform thread, read on the GPU thread.
+static std::atomic<uint32_t> g_desired_image_count(3);
+static std::atomic<VkPresentModeKHR> g_desired_present_mode(
+    VK_PRESENT_MODE_FIFO_KHR);
+
+void VulkanSwapchain::SetDesiredImageCount(uint32_t count) {
+  g_desired_image_count = count;
+}
+
+void VulkanSwapchain::SetDesiredPresentMode(VkPresentModeKHR present_mode) {
+  g_desired_present_mode = present_mode;
+}
+
 VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
                                  const VulkanDevice& device,
                                  const VulkanSurface& surface,
@@ -44,7 +66,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
   }
 
   VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
-  if (!device_.ChoosePresentMode(surface, &present_mode)) {
+  if (!device_.ChoosePresentMode(surface, g_desired_present_mode,
+                                 &present_mode)) {
     FTL_DLOG(INFO) << "Could not choose present mode.";
     return;
   }
@@ -74,16 +97,32 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
     old_swapchain_handle = old_swapchain->swapchain_;
     // The unique pointer to the swapchain will go out of scope here
     // and its handle collected after the appropriate device wait.
+
+    // Take over the old swapchain's backbuffer ring. The command buffers,
+    // fences and semaphores in it belong to the device, not the swapchain,
+    // and reallocating them on every recreation shows up in traces.
+    recycled_backbuffers_ = std::move(old_swapchain->backbuffers_);
   }
 
   VkSurfaceKHR surface_handle = surface.Handle();
 
+  // Ask for the preferred swapchain depth but stay within the bounds the
+  // surface reports. A maxImageCount of zero means the surface imposes no
+  // upper bound.
+  uint32_t desired_image_count =
+      std::max(static_cast<uint32_t>(g_desired_image_count),
+               capabilities_.minImageCount);
+  if (capabilities_.maxImageCount > 0 &&
+      desired_image_count > capabilities_.maxImageCount) {
+    desired_image_count = capabilities_.maxImageCount;
+  }
+
   const VkSwapchainCreateInfoKHR create_info = {
       .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
       .pNext = nullptr,
       .flags = 0,
       .surface = surface_handle,
-      .minImageCount = capabilities_.minImageCount,
+      .minImageCount = desired_image_count,
       .imageFormat = surface_format_.format,
       .imageColorSpace = surface_format_.colorSpace,
       .imageExtent = capabilities_.currentExtent,
@@ -119,6 +158,11 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
     return;
   }
 
+  if (!PrepareInitialImageLayouts()) {
+    FTL_DLOG(INFO) << "Could not prepare the initial image layouts.";
+    return;
+  }
+
   valid_ = true;
 }
 
@@ -237,9 +281,17 @@ bool VulkanSwapchain::CreateSwapchainImages(GrContext* skia_context) {
   const SkISize surface_size = GetSize();
 
   for (const VkImage& image : images) {
-    // Populate the backbuffer.
-    auto backbuffer = std::make_unique<VulkanBackbuffer>(
-        vk, device_.GetHandle(), device_.GetCommandPool());
+    // Populate the backbuffer, preferring one recycled from the old
+    // swapchain over a fresh round of allocator calls.
+    std::unique_ptr<VulkanBackbuffer> backbuffer;
+
+    if (!recycled_backbuffers_.empty()) {
+      backbuffer = std::move(recycled_backbuffers_.back());
+      recycled_backbuffers_.pop_back();
+    } else {
+      backbuffer = std::make_unique<VulkanBackbuffer>(
+          vk, device_.GetHandle(), device_.GetCommandPool());
+    }
 
     if (!backbuffer->IsValid()) {
       return false;
@@ -269,9 +321,64 @@ bool VulkanSwapchain::CreateSwapchainImages(GrContext* skia_context) {
   FTL_DCHECK(backbuffers_.size() == images_.size());
   FTL_DCHECK(images_.size() == surfaces_.size());
 
+  // The new ring may be shallower than the old one.
+  recycled_backbuffers_.clear();
+
   return true;
 }
 
+bool VulkanSwapchain::PrepareInitialImageLayouts() {
+  // Move every swapchain image out of the undefined layout in one batched
+  // barrier at creation time, so the first acquire of each image does not
+  // pay for that transition in the middle of a frame.
+  auto backbuffer = backbuffers_[0].get();
+
+  if (!backbuffer->GetUsageCommandBuffer().Reset()) {
+    return false;
+  }
+
+  if (!backbuffer->GetUsageCommandBuffer().Begin()) {
+    return false;
+  }
+
+  std::vector<VulkanImage*> images;
+  images.reserve(images_.size());
+  for (const auto& image : images_) {
+    images.push_back(image.get());
+  }
+
+  if (!VulkanImage::InsertImageMemoryBarriers(
+          backbuffer->GetUsageCommandBuffer(),         // command buffer
+          images,                                      // images
+          VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,           // src_pipeline_bits
+          VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,        // dest_pipeline_bits
+          VK_ACCESS_MEMORY_READ_BIT,                   // dest_access_flags
+          VK_IMAGE_LAYOUT_PRESENT_SRC_KHR              // dest_layout
+          )) {
+    return false;
+  }
+
+  if (!backbuffer->GetUsageCommandBuffer().End()) {
+    return false;
+  }
+
+  std::vector<VkCommandBuffer> command_buffers = {
+      backbuffer->GetUsageCommandBuffer().Handle()};
+
+  if (!device_.QueueSubmit({/* No wait stages. */},      //
+                           {/* No wait semaphores. */},  //
+                           {/* No signal semaphores. */},  //
+                           command_buffers,               //
+                           VulkanHandle<VkFence>()        // no fence
+                           )) {
+    return false;
+  }
+
+  // This is the swapchain creation path, not the frame loop. Waiting here
+  // keeps the command buffer reusable without per-slot fence juggling.
+  return device_.WaitIdle();
+}
+
 VulkanBackbuffer* VulkanSwapchain::GetNextBackbuffer() {
   auto available_backbuffers = backbuffers_.size();
 
@@ -322,13 +429,19 @@ VulkanSwapchain::AcquireResult VulkanSwapchain::AcquireSurface() {
 
   // ---------------------------------------------------------------------------
   // Step 2:
-  // Put semaphores in unsignaled state.
+  // Put semaphores in unsignaled state and recycle the command buffers for
+  // this cycle's recording.
   // ---------------------------------------------------------------------------
   if (!backbuffer->ResetFences()) {
     FTL_DLOG(INFO) << "Could not reset fences.";
     return error;
   }
 
+  if (!backbuffer->ResetCommandBuffers()) {
+    FTL_DLOG(INFO) << "Could not reset the command buffers.";
+    return error;
+  }
+
   // ---------------------------------------------------------------------------
   // Step 3:
   // Acquire the next image index.
@@ -560,7 +673,45 @@ bool VulkanSwapchain::Submit() {
     return false;
   }
 
+  // ---------------------------------------------------------------------------
+  // Step 6:
+  // Note the time of this present operation for cadence estimation.
+  // ---------------------------------------------------------------------------
+  recent_present_times_.push_back(ftl::TimePoint::Now());
+  while (recent_present_times_.size() > kRecentPresentTimesToTrack) {
+    recent_present_times_.pop_front();
+  }
+
   return true;
 }
 
+ftl::TimeDelta VulkanSwapchain::GetObservedPresentInterval() const {
+  if (recent_present_times_.size() < 2) {
+    return ftl::TimeDelta::Zero();
+  }
+
+  // Take the median of the recent present-to-present spacings. The median is
+  // robust against the occasional long frame, while the steady-state spacing
+  // tracks the display refresh when presentation is throttled by it.
+  std::vector<int64_t> deltas;
+  deltas.reserve(recent_present_times_.size() - 1);
+  for (size_t i = 1; i < recent_present_times_.size(); i++) {
+    deltas.push_back(
+        (recent_present_times_[i] - recent_present_times_[i - 1])
+            .ToMicroseconds());
+  }
+
+  auto median = deltas.begin() + deltas.size() / 2;
+  std::nth_element(deltas.begin(), median, deltas.end());
+  return ftl::TimeDelta::FromMicroseconds(*median);
+}
+
+ftl::TimePoint VulkanSwapchain::GetLastPresentTime() const {
+  if (recent_present_times_.empty()) {
+    return ftl::TimePoint();
+  }
+
+  return recent_present_times_.back();
+}
+
 }  // namespace vulkan
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_VULKAN_VULKAN_SWAPCHAIN_H_
 #define FLUTTER_VULKAN_VULKAN_SWAPCHAIN_H_
 
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -12,6 +13,8 @@
 #include "flutter/vulkan/vulkan_handle.h"
 #include "lib/ftl/compiler_specific.h"
 #include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -34,6 +37,18 @@ class VulkanSwapchain {
 
   ~VulkanSwapchain();
 
+  /// Set the number of swapchain images to ask for when the next swapchain is
+  /// created. Two images double buffer the display, three allow the rasterizer
+  /// to start on a new frame while two finished ones are still queued. The
+  /// request is clamped to the limits the surface reports.
+  static void SetDesiredImageCount(uint32_t count);
+
+  /// Set the present mode to prefer when the next swapchain is created.
+  /// MAILBOX replaces queued frames instead of blocking on them, trading
+  /// power for latency. Falls back to FIFO (which is always available) when
+  /// the surface does not support the preference.
+  static void SetDesiredPresentMode(VkPresentModeKHR present_mode);
+
   bool IsValid() const;
 
   enum class AcquireStatus {
@@ -61,6 +76,18 @@ class VulkanSwapchain {
 
   SkISize GetSize() const;
 
+  /// The interval between recent present operations on this swapchain. When
+  /// presentation is throttled by the display (FIFO), this converges on the
+  /// true refresh interval, which the frame scheduler can lock onto. Returns
+  /// zero until enough presents have been observed.
+  ftl::TimeDelta GetObservedPresentInterval() const;
+
+  /// The timestamp of the most recent present operation, or the zero time
+  /// point before anything has been presented. Together with the observed
+  /// interval this gives the frame scheduler both the period and the phase
+  /// of the display clock.
+  ftl::TimePoint GetLastPresentTime() const;
+
  private:
   const VulkanProcTable& vk;
   const VulkanDevice& device_;
@@ -68,17 +95,21 @@ class VulkanSwapchain {
   VkSurfaceFormatKHR surface_format_;
   VulkanHandle<VkSwapchainKHR> swapchain_;
   std::vector<std::unique_ptr<VulkanBackbuffer>> backbuffers_;
+  std::vector<std::unique_ptr<VulkanBackbuffer>> recycled_backbuffers_;
   std::vector<std::unique_ptr<VulkanImage>> images_;
   std::vector<sk_sp<SkSurface>> surfaces_;
   VkPipelineStageFlagBits current_pipeline_stage_;
   size_t current_backbuffer_index_;
   size_t current_image_index_;
+  std::deque<ftl::TimePoint> recent_present_times_;
   bool valid_;
 
   std::vector<VkImage> GetImages() const;
 
   bool CreateSwapchainImages(GrContext* skia_context);
 
+  bool PrepareInitialImageLayouts();
+
   sk_sp<SkSurface> CreateSkiaSurface(GrContext* skia_context,
                                      VkImage image,
                                      const SkISize& size) const;
@@ -223,6 +223,22 @@ bool VulkanWindow::SwapBuffers() {
   return swapchain_->Submit();
 }
 
+ftl::TimeDelta VulkanWindow::GetObservedPresentInterval() const {
+  if (swapchain_ == nullptr) {
+    return ftl::TimeDelta::Zero();
+  }
+
+  return swapchain_->GetObservedPresentInterval();
+}
+
+ftl::TimePoint VulkanWindow::GetLastPresentTime() const {
+  if (swapchain_ == nullptr) {
+    return ftl::TimePoint();
+  }
+
+  return swapchain_->GetLastPresentTime();
+}
+
 bool VulkanWindow::RecreateSwapchain() {
   // This way, we always lose our reference to the old swapchain. Even if we
   // cannot create a new one to replace it.
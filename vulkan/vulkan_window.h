@@ -13,6 +13,8 @@
 #include "flutter/vulkan/vulkan_proc_table.h"
 #include "lib/ftl/compiler_specific.h"
 #include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -44,6 +46,15 @@ class VulkanWindow {
 
   bool SwapBuffers();
 
+  /// The spacing of recent present operations as observed by the current
+  /// swapchain. Zero when no swapchain exists or too few frames have been
+  /// presented.
+  ftl::TimeDelta GetObservedPresentInterval() const;
+
+  /// The timestamp of the most recent present operation on the current
+  /// swapchain, or the zero time point when there is none.
+  ftl::TimePoint GetLastPresentTime() const;
+
  private:
   bool valid_;
   ftl::RefPtr<VulkanProcTable> vk;